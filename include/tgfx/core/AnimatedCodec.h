@@ -0,0 +1,243 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "tgfx/core/Buffer.h"
+#include "tgfx/core/Data.h"
+#include "tgfx/core/Image.h"
+#include "tgfx/core/ImageBuffer.h"
+#include "tgfx/core/Rect.h"
+
+namespace tgfx {
+class AnimatedDecoder;
+class Task;
+struct AnimatedTextureState;
+
+/**
+ * Defines how the area of a frame is treated before the next frame is drawn onto the canvas.
+ */
+enum class FrameDisposal {
+  /**
+   * The frame is left on the canvas, and the next frame is drawn on top of it.
+   */
+  Keep,
+  /**
+   * The area of the frame is cleared to transparent before the next frame is drawn.
+   */
+  Background,
+  /**
+   * The area of the frame is restored to what it was before the frame was drawn.
+   */
+  Previous
+};
+
+/**
+ * Defines how the pixels of a frame are combined with the canvas.
+ */
+enum class FrameBlend {
+  /**
+   * The pixels of the frame replace the pixels of the canvas, including their alpha.
+   */
+  Source,
+  /**
+   * The pixels of the frame are drawn over the canvas with SrcOver blending.
+   */
+  Over
+};
+
+/**
+ * AnimatedFrameInfo describes a single frame of an animated image.
+ */
+struct AnimatedFrameInfo {
+  /**
+   * The area of the canvas the frame draws into, clipped to the canvas bounds.
+   */
+  Rect bounds = {};
+
+  /**
+   * The display duration of the frame in microseconds.
+   */
+  int64_t duration = 0;
+
+  /**
+   * How the frame is combined with the canvas.
+   */
+  FrameBlend blend = FrameBlend::Over;
+
+  /**
+   * How the frame is disposed of before the next frame is drawn.
+   */
+  FrameDisposal disposal = FrameDisposal::Keep;
+};
+
+/**
+ * AnimatedCodec decodes the frames of an animated GIF, APNG or animated WebP image. Each frame is
+ * composited onto a canvas of width() x height() in premultiplied RGBA_8888, applying the blend and
+ * disposal rules of the previous frames. Decoded frames are kept in a small ring, and the frames
+ * following the most recently requested one are decoded ahead of time on background threads, so
+ * that playing the animation forward rarely waits for the decoder. AnimatedCodec is thread safe.
+ */
+class AnimatedCodec {
+ public:
+  /**
+   * Creates an AnimatedCodec from the file at the specified path. Returns nullptr if the file does
+   * not exist or is not a GIF, an animated PNG or an animated WebP image.
+   */
+  static std::shared_ptr<AnimatedCodec> MakeFrom(const std::string& filePath);
+
+  /**
+   * Creates an AnimatedCodec from the encoded image bytes. Returns nullptr if the bytes are not a
+   * GIF, an animated PNG or an animated WebP image.
+   */
+  static std::shared_ptr<AnimatedCodec> MakeFrom(std::shared_ptr<Data> imageBytes);
+
+  ~AnimatedCodec();
+
+  /**
+   * Returns the width of the animation canvas.
+   */
+  int width() const {
+    return _width;
+  }
+
+  /**
+   * Returns the height of the animation canvas.
+   */
+  int height() const {
+    return _height;
+  }
+
+  /**
+   * Returns the number of frames in the animation.
+   */
+  int frameCount() const {
+    return static_cast<int>(frameInfos.size());
+  }
+
+  /**
+   * Returns the number of times the animation plays, or 0 if it repeats forever.
+   */
+  int loopCount() const {
+    return _loopCount;
+  }
+
+  /**
+   * Returns the duration of one loop of the animation in microseconds.
+   */
+  int64_t duration() const {
+    return _duration;
+  }
+
+  /**
+   * Returns the information of the frame at the specified index, or a default AnimatedFrameInfo if
+   * the index is out of range.
+   */
+  AnimatedFrameInfo getFrameInfo(int index) const;
+
+  /**
+   * Returns the index of the frame displayed at the specified time in microseconds since the
+   * animation started. Once all loops have been played, the last frame stays on display.
+   */
+  int getFrameAtTime(int64_t time) const;
+
+  /**
+   * Returns the maximum number of decoded frames kept in memory, including the frames decoded ahead
+   * of time. The default value is 3.
+   */
+  int maxCachedFrames() const;
+
+  /**
+   * Sets the maximum number of decoded frames kept in memory. Each cached frame takes
+   * width() * height() * 4 bytes. A value of 1 disables decoding ahead of time.
+   */
+  void setMaxCachedFrames(int count);
+
+  /**
+   * Copies the composited pixels of the frame at the specified index into dstPixels, converting
+   * them to dstInfo if needed. Returns false if the index is out of range or decoding fails.
+   */
+  bool readFrame(int index, const ImageInfo& dstInfo, void* dstPixels) const;
+
+  /**
+   * Returns an Image showing the frame at the specified index, or nullptr if the index is out of
+   * range. All frame images of the codec share a single texture per Context, and switching to
+   * another frame only uploads the area that changed between the two frames. The frames that follow
+   * the index start decoding in the background right away.
+   */
+  std::shared_ptr<Image> makeFrameImage(int index) const;
+
+ private:
+  struct CachedFrame {
+    int index = 0;
+    std::shared_ptr<Data> pixels = nullptr;
+  };
+
+  std::unique_ptr<AnimatedDecoder> decoder;
+  int _width = 0;
+  int _height = 0;
+  int _loopCount = 0;
+  int64_t _duration = 0;
+  std::vector<AnimatedFrameInfo> frameInfos = {};
+  std::vector<int64_t> frameStartTimes = {};
+  // Guards the decoder and the compositing state below.
+  mutable std::mutex decodeLocker = {};
+  mutable Buffer canvas = {};
+  mutable Buffer restoreCanvas = {};
+  mutable Buffer framePixels = {};
+  mutable int canvasFrame = -1;
+  // Guards the frame ring and the decode-ahead task.
+  mutable std::mutex cacheLocker = {};
+  mutable std::deque<CachedFrame> cachedFrames = {};
+  mutable std::shared_ptr<Task> decodeAheadTask = nullptr;
+  int _maxCachedFrames = 3;
+  // The textures shared by all frame images, one without mipmaps and one with mipmaps, for each
+  // context the frames are drawn on, keyed by the context ID.
+  mutable std::mutex textureStateLocker = {};
+  mutable std::unordered_map<uint32_t, std::shared_ptr<AnimatedTextureState>> textureStates[2] = {};
+  std::weak_ptr<AnimatedCodec> weakThis;
+
+  explicit AnimatedCodec(std::unique_ptr<AnimatedDecoder> decoder);
+
+  std::shared_ptr<AnimatedTextureState> getTextureState(uint32_t contextID, bool mipmapped) const;
+
+  std::shared_ptr<Data> findCachedFrame(int index) const;
+
+  std::shared_ptr<Data> getFrame(int index) const;
+
+  std::shared_ptr<Data> decodeFrame(int index) const;
+
+  bool compositeNextFrame() const;
+
+  void scheduleDecodeAhead(int index) const;
+
+  Rect getDirtyBounds(int fromIndex, int toIndex) const;
+
+  std::shared_ptr<ImageBuffer> makeFrameBuffer(int index, bool tryHardware) const;
+
+  friend class AnimatedFrameGenerator;
+  friend class AnimatedFrameUploadTask;
+  friend class AnimatedImage;
+};
+}  // namespace tgfx
@@ -521,6 +521,7 @@ class Canvas {
   friend class PDFExportContext;
   friend class PDFFont;
   friend class OpaqueContext;
+  friend class RasterCanvas;
 };
 
 /**
@@ -30,10 +30,23 @@ namespace tgfx {
 class Data {
  public:
   /**
-   * Creates a Data object from the specified file path.
+   * Creates a Data object from the specified file path. The whole file is read into heap memory, so
+   * later changes to the file do not affect the returned Data. Use MakeFromFileMapping() to map a
+   * large local file instead.
    */
   static std::shared_ptr<Data> MakeFromFile(const std::string& filePath);
 
+  /**
+   * Creates a Data object by memory-mapping the specified local file as read-only. The pages of
+   * the file are loaded on demand and shared with the page cache of the OS instead of being copied
+   * into heap memory, so only the parts that are actually read take up memory. The caller must
+   * ensure the file is not truncated while the returned Data is alive: reading pages past the new
+   * end of the file raises SIGBUS, and other changes to the file may show up in the Data. Returns
+   * nullptr if the file is empty, the path uses a custom protocol, or the current platform has no
+   * memory-mapping support.
+   */
+  static std::shared_ptr<Data> MakeFromFileMapping(const std::string& filePath);
+
   /**
    * Creates a Data object by copying the specified data.
    */
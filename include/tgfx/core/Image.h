@@ -40,6 +40,7 @@ class SamplingArgs;
 class Context;
 class ImageFilter;
 class FragmentProcessor;
+class ImageCodec;
 class TextureProxy;
 class Paint;
 
@@ -78,6 +79,15 @@ class Image {
    */
   static std::shared_ptr<Image> MakeFrom(std::shared_ptr<ImageGenerator> generator);
 
+  /**
+   * Creates an Image from the image codec that decodes its pixels into YUV planes instead of RGBA
+   * pixels when the codec supports it, such as a JPEG with 4:2:0 chroma subsampling. The planes are
+   * uploaded as a planar texture and converted to RGB on the GPU, which saves the color conversion
+   * on the CPU and takes about 1.5 bytes per pixel of texture memory instead of 4. Otherwise, the
+   * image decodes RGBA pixels the same as MakeFrom(). Returns nullptr if the codec is nullptr.
+   */
+  static std::shared_ptr<Image> MakeYUVFrom(std::shared_ptr<ImageCodec> codec);
+
   /**
    * Creates an Image using the provided ImageInfo and pixel data from an immutable Data object. The
    * returned Image holds a reference to the pixel data. The caller must ensure the pixel data
@@ -233,6 +243,16 @@ class Image {
    */
   virtual std::shared_ptr<Image> makeTextureImage(Context* context) const;
 
+  /**
+   * Returns an Image backed by a GPU texture in a block-compressed format, such as ETC2 or BC1,
+   * which takes an eighth of the memory of an RGBA texture. The pixels of the Image are encoded on
+   * the CPU, which takes much longer than a regular upload and loses some quality, so it suits
+   * large opaque images that stay alive for a long time. Falls back to makeTextureImage() if the
+   * Image is not opaque, is already texture-backed, has mipmaps, or the context supports none of
+   * the compressed formats. Returns nullptr if the context is nullptr.
+   */
+  std::shared_ptr<Image> makeCompressedTextureImage(Context* context) const;
+
   /**
    * Retrieves the backend texture of the Image. Returns an invalid BackendTexture if the Image is
    * not backed by a texture. If the origin is not nullptr, the origin of the backend texture is
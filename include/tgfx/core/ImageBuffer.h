@@ -69,6 +69,17 @@ class ImageBuffer {
   static std::shared_ptr<ImageBuffer> MakeI420(
       std::shared_ptr<YUVData> yuvData, YUVColorSpace colorSpace = YUVColorSpace::BT601_LIMITED);
 
+  /**
+   * Creates an ImageBuffer in the I420 format with the specified YUVData and YUVColorSpace, whose
+   * pixels are described by the given colorSpace once converted to RGB. For example, the planes of
+   * a decoded JPEG convert to RGB in the color space of the JPEG file rather than the one implied
+   * by the yuvColorSpace. The caller must ensure the yuvData stays unchanged for the lifetime of the
+   * returned ImageBuffer. Returns nullptr if the yuvData is invalid.
+   */
+  static std::shared_ptr<ImageBuffer> MakeI420(std::shared_ptr<YUVData> yuvData,
+                                               YUVColorSpace yuvColorSpace,
+                                               std::shared_ptr<ColorSpace> colorSpace);
+
   /**
    * Creates an ImageBuffer in the NV12 format with the specified YUVData and YUVColorSpace. The
    * caller must ensure the yuvData stays unchanged for the lifetime of the returned ImageBuffer.
@@ -125,5 +136,6 @@ class ImageBuffer {
 
   friend class TextureView;
   friend class BufferImage;
+  friend class RasterImageCache;
 };
 }  // namespace tgfx
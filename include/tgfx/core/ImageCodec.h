@@ -38,7 +38,8 @@ class ImageCodec : public ImageGenerator {
  public:
   /**
    * If this file path represents an encoded image that we know how to decode, return an ImageCodec
-   * that can decode it. Otherwise, return nullptr.
+   * that can decode it. Otherwise, return nullptr. Local files are memory-mapped where supported,
+   * see Data::MakeFromFileMapping(), so the file must not be truncated while the codec is alive.
    */
   static std::shared_ptr<ImageCodec> MakeFrom(const std::string& filePath);
 
@@ -99,6 +100,27 @@ class ImageCodec : public ImageGenerator {
    */
   virtual bool readPixels(const ImageInfo& dstInfo, void* dstPixels) const;
 
+  /**
+   * Decodes the region of the image specified by srcRect into the given pixel buffer using the
+   * specified image info. srcRect is rounded out to integer bounds and must lie within the image.
+   * If the size in dstInfo is smaller than the region, the region is downscaled to fit dstInfo
+   * using a box filter algorithm. Codecs that support region decoding only decode the rows and
+   * columns the region covers, which keeps the time and memory of showing a small part of a huge
+   * image proportional to that part. Returns true if decoding succeeds, false otherwise.
+   */
+  bool readPixels(const Rect& srcRect, const ImageInfo& dstInfo, void* dstPixels) const;
+
+  /**
+   * Decodes the image straight into planar YUV data and returns it as an I420 ImageBuffer, skipping
+   * the color conversion on the CPU. The planes take about 1.5 bytes per pixel instead of the 4
+   * bytes of an RGBA buffer and are converted to RGB on the GPU when drawn. Only JPEG images with
+   * 4:2:0 chroma subsampling support this path currently. Returns nullptr if the image can not be
+   * decoded into YUV planes, in which case callers should fall back to makeBuffer().
+   */
+  virtual std::shared_ptr<ImageBuffer> makeYUVBuffer() const {
+    return nullptr;
+  }
+
  protected:
   ImageCodec(int width, int height, Orientation orientation = Orientation::TopLeft,
              std::shared_ptr<ColorSpace> colorSpace = nullptr)
@@ -110,6 +132,16 @@ class ImageCodec : public ImageGenerator {
   virtual bool onReadPixels(ColorType colorType, AlphaType alphaType, size_t dstRowBytes,
                             std::shared_ptr<ColorSpace> dstColorSpace, void* dstPixels) const = 0;
 
+  /**
+   * Decodes the region of the image specified by srcRect, which has integer bounds within the
+   * image, at its original scale. The default implementation decodes the full image into a
+   * temporary buffer and copies the region out of it. Codecs that can skip rows or columns while
+   * decoding should override this method.
+   */
+  virtual bool onReadRegion(const Rect& srcRect, ColorType colorType, AlphaType alphaType,
+                            size_t dstRowBytes, std::shared_ptr<ColorSpace> dstColorSpace,
+                            void* dstPixels) const;
+
   virtual std::shared_ptr<Data> getEncodedData() const {
     return nullptr;
   };
@@ -117,6 +149,8 @@ class ImageCodec : public ImageGenerator {
  private:
   Orientation _orientation = Orientation::TopLeft;
 
+  bool readRegionPixels(const Rect& region, const ImageInfo& dstInfo, void* dstPixels) const;
+
   /**
    * If the file path represents an encoded image that the current platform knows how to decode,
    * returns an ImageCodec that can decode it. Otherwise, returns nullptr.
@@ -132,5 +166,6 @@ class ImageCodec : public ImageGenerator {
   friend class Pixmap;
   friend class SVGExportContext;
   friend class PDFBitmap;
+  friend class PictureWriter;
 };
 }  // namespace tgfx
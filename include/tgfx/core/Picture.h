@@ -19,6 +19,8 @@
 #pragma once
 
 #include <atomic>
+#include <functional>
+#include "tgfx/core/Data.h"
 #include "tgfx/core/Matrix.h"
 
 namespace tgfx {
@@ -29,6 +31,8 @@ class ClipStack;
 class Image;
 class Brush;
 class BlockBuffer;
+class PictureReader;
+class PictureBBH;
 template <typename T>
 class PlacementPtr;
 
@@ -54,8 +58,26 @@ class Picture {
     virtual bool abort() = 0;
   };
 
+  /**
+   * Creates a Picture from the data produced by serialize(). The records are played back directly
+   * from the data without being decoded into record objects first, so the data must stay unchanged
+   * for the lifetime of the Picture. This allows loading a Picture from a memory-mapped file.
+   * Returns nullptr if the data is not a valid serialized Picture or was written by an unsupported
+   * format version.
+   */
+  static std::shared_ptr<Picture> MakeFrom(std::shared_ptr<Data> data);
+
   ~Picture();
 
+  /**
+   * Serializes the Picture into a compact, versioned binary format that can be loaded by
+   * Picture::MakeFrom(). Shared objects such as paths, images, typefaces and text blobs are written
+   * only once, even if they are referenced by nested pictures. Images are stored as their encoded
+   * data when available. Returns nullptr if the Picture contains content that cannot be
+   * serialized, such as meshes, texture-backed images, custom typefaces or runtime filters.
+   */
+  std::shared_ptr<Data> serialize() const;
+
   /**
    * Returns true if the Picture contains any drawing commands that fill an unbounded (infinite)
    * area. For example, drawing a Path with an inverse fill type or drawing a Paint to cover the
@@ -85,6 +107,8 @@ class Picture {
  private:
   std::unique_ptr<BlockBuffer> blockBuffer;
   std::vector<PlacementPtr<PictureRecord>> records;
+  std::unique_ptr<PictureReader> reader;
+  std::unique_ptr<PictureBBH> bbh;
   mutable std::atomic<Rect*> bounds = {nullptr};
   size_t drawCount = 0;
   bool _hasUnboundedFill = false;
@@ -92,8 +116,24 @@ class Picture {
   Picture(std::unique_ptr<BlockBuffer> buffer, std::vector<PlacementPtr<PictureRecord>> records,
           size_t drawCount);
 
+  Picture(std::unique_ptr<PictureReader> reader, size_t drawCount, bool hasUnboundedFill);
+
+  /**
+   * Passes each record to the visitor in order until the visitor returns false. The record may be
+   * a temporary object that is only valid during the call.
+   */
+  void forEachRecord(const std::function<bool(const PictureRecord*)>& visitor) const;
+
+  /**
+   * Plays back the records into the drawContext. If cullBounds is provided, it is the area of the
+   * device that can receive pixels, in addition to the clip. Draw records entirely outside the
+   * clip and cullBounds are skipped if the picture has a bounding-box hierarchy.
+   */
   void playback(DrawContext* drawContext, const Matrix& matrix, const ClipStack& clip,
-                AbortCallback* callback = nullptr) const;
+                AbortCallback* callback = nullptr, const Rect* cullBounds = nullptr) const;
+
+  bool getVisibleDraws(const Matrix& matrix, const ClipStack& clip, const Rect* cullBounds,
+                       std::vector<size_t>* visibleDraws) const;
 
   std::shared_ptr<Image> asImage(Point* offset, const Matrix* matrix = nullptr,
                                  const ISize* clipSize = nullptr) const;
@@ -111,5 +151,9 @@ class Picture {
   friend class PDFExportContext;
   friend class OpaqueContext;
   friend class MaskContext;
+  friend class RasterDrawContext;
+  friend class PictureLoader;
+  friend class PictureWriter;
+  friend class PictureOptimizer;
 };
 }  // namespace tgfx
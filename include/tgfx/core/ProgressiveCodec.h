@@ -0,0 +1,117 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include "tgfx/core/Buffer.h"
+#include "tgfx/core/Image.h"
+#include "tgfx/core/ImageBuffer.h"
+#include "tgfx/core/Orientation.h"
+
+namespace tgfx {
+class GrowableStream;
+class ProgressiveDecoder;
+
+/**
+ * ProgressiveCodec decodes an encoded image while its bytes are still arriving, for example over a
+ * slow network. Received bytes are appended with appendData(), and every snapshot of the image
+ * shows the rows (or progressive JPEG scans, or interlaced PNG passes) decoded from the bytes
+ * received so far. JPEG, PNG and WebP images are supported. ProgressiveCodec is thread safe.
+ */
+class ProgressiveCodec {
+ public:
+  /**
+   * Creates a new ProgressiveCodec with no data received yet.
+   */
+  static std::shared_ptr<ProgressiveCodec> Make();
+
+  ~ProgressiveCodec();
+
+  /**
+   * Appends the next received bytes of the encoded image. Returns false if finish() has already
+   * been called, or if the received bytes do not start with a supported image format.
+   */
+  bool appendData(const void* bytes, size_t length);
+
+  /**
+   * Marks that all bytes of the encoded image have been received. If the received bytes are
+   * truncated, the pixels that never arrived stay transparent (or gray for JPEG).
+   */
+  void finish();
+
+  /**
+   * Returns true if finish() has been called.
+   */
+  bool isFinished() const;
+
+  /**
+   * Returns the number of bytes received so far.
+   */
+  size_t bytesReceived() const;
+
+  /**
+   * Returns the width of the image, or 0 if its header has not been received yet.
+   */
+  int width() const;
+
+  /**
+   * Returns the height of the image, or 0 if its header has not been received yet.
+   */
+  int height() const;
+
+  /**
+   * Returns the orientation of the image. Returns Orientation::TopLeft until the header has been
+   * received.
+   */
+  Orientation orientation() const;
+
+  /**
+   * Returns true if the end of the image has been decoded.
+   */
+  bool isComplete() const;
+
+  /**
+   * Decodes the bytes received since the previous call and returns a snapshot of all the pixels
+   * decoded so far. Returns nullptr if the header has not been received yet or decoding fails
+   * before any pixels are available. The returned buffer is not affected by later data.
+   */
+  std::shared_ptr<ImageBuffer> makeBuffer(bool tryHardware = true) const;
+
+  /**
+   * Returns an Image that shows the pixels decoded so far each time it is drawn. New data is
+   * decoded off the render thread when the image is drawn, and the texture is refreshed only if
+   * more bytes have been received since it was last uploaded. The orientation of the image is
+   * already applied. Returns nullptr if the header has not been received yet.
+   */
+  std::shared_ptr<Image> makeImage() const;
+
+ private:
+  mutable std::mutex locker = {};
+  std::unique_ptr<GrowableStream> stream;
+  std::unique_ptr<ProgressiveDecoder> decoder;
+  mutable Buffer pixels = {};
+  bool unsupported = false;
+  std::weak_ptr<ProgressiveCodec> weakThis;
+
+  ProgressiveCodec();
+
+  bool checkHeader();
+};
+}  // namespace tgfx
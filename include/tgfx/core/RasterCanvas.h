@@ -0,0 +1,87 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include "tgfx/core/Canvas.h"
+#include "tgfx/core/Picture.h"
+#include "tgfx/core/Pixmap.h"
+
+namespace tgfx {
+class RasterDrawContext;
+class RasterImageCache;
+
+/**
+ * RasterCanvas draws into the pixels of a Pixmap entirely on the CPU, without a GPU Context. It
+ * is meant for headless rendering, such as turning Pictures or layer trees into images on machines
+ * without a GPU. Image filters (including layer styles built on them, like blurs and shadows),
+ * meshes, color glyphs, and PerlinNoise shaders are not supported by the raster backend. Use
+ * drawPicture() or DisplayList::render() to find out whether some content can not be rendered;
+ * anything drawn directly through getCanvas() skips such content with an error log.
+ */
+class RasterCanvas {
+ public:
+  /**
+   * Creates a RasterCanvas that draws into the pixels of the given pixmap. The pixmap must be
+   * RGBA_8888 or BGRA_8888 with premultiplied or opaque alpha, and its pixels must stay valid
+   * while the RasterCanvas is in use. Returns nullptr if the pixmap is empty or has an unsupported
+   * format.
+   */
+  static std::unique_ptr<RasterCanvas> Make(const Pixmap& pixmap);
+
+  ~RasterCanvas();
+
+  /**
+   * Returns the width of the target pixels.
+   */
+  int width() const {
+    return pixmap.width();
+  }
+
+  /**
+   * Returns the height of the target pixels.
+   */
+  int height() const {
+    return pixmap.height();
+  }
+
+  /**
+   * Returns the Canvas that draws into the target pixels. The Canvas is owned by the RasterCanvas
+   * and is deleted when the RasterCanvas is deleted.
+   */
+  Canvas* getCanvas() const {
+    return canvas;
+  }
+
+  /**
+   * Draws the picture with the current matrix and clip of the Canvas. Returns false and leaves the
+   * pixels untouched if the picture contains content that the raster backend can not render, so
+   * the caller can fall back to a GPU Surface instead of getting incomplete pixels.
+   */
+  bool drawPicture(std::shared_ptr<Picture> picture);
+
+ private:
+  Pixmap pixmap = {};
+  RasterImageCache* imageCache = nullptr;
+  RasterDrawContext* drawContext = nullptr;
+  Canvas* canvas = nullptr;
+
+  explicit RasterCanvas(const Pixmap& pixmap);
+};
+}  // namespace tgfx
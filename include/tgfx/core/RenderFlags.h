@@ -37,5 +37,13 @@ class RenderFlags {
    * asynchronously.
    */
   static constexpr uint32_t DisableAsyncTask = 1 << 1;
+
+  /**
+   * Renders medium and large glyphs from signed distance field strikes instead of rasterizing a
+   * new bitmap strike for every text size and scale. One distance field strike per typeface serves
+   * a wide range of scales, which avoids re-rasterizing glyphs during continuous zooming. Small
+   * glyphs, color glyphs, stroked text, and faux bold text still use bitmap strikes.
+   */
+  static constexpr uint32_t DistanceFieldText = 1 << 2;
 };
 }  // namespace tgfx
@@ -24,6 +24,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace tgfx {
 class TaskGroup;
@@ -80,6 +81,18 @@ class Task {
    */
   static void ReleaseThreads();
 
+  /**
+   * Sets the maximum number of threads used to execute tasks. The value is clamped to [1, 32]. If
+   * the limit is lowered, the extra threads stop taking tasks until ReleaseThreads() is called or
+   * the limit is raised again. The default is the number of CPU cores.
+   */
+  static void SetMaxThreads(int count);
+
+  /**
+   * Returns the maximum number of threads used to execute tasks.
+   */
+  static int GetMaxThreads();
+
   /**
    * Submits a code block for asynchronous execution immediately and returns a Task wraps the code
    * block. Hold a reference to the returned Task if you want to cancel it or wait for it to finish
@@ -99,6 +112,33 @@ class Task {
    */
   static void Run(std::shared_ptr<Task> task, TaskPriority priority = TaskPriority::Medium);
 
+  /**
+   * Submits a code block that starts executing once all the given dependencies have finished or
+   * been canceled. Unlike calling wait() on the dependencies inside the block, no thread is blocked
+   * while the dependencies are pending. A dependency that never runs keeps the returned Task from
+   * starting.
+   * @param block The code block to be executed.
+   * @param dependencies The Tasks that must complete before the block starts. nullptr entries are
+   * ignored.
+   * @param priority The priority of the Task. The default is TaskPriority::Medium.
+   * @return nullptr if the block is nullptr, otherwise a shared pointer to the Task.
+   */
+  static std::shared_ptr<Task> Run(std::function<void()> block,
+                                   const std::vector<std::shared_ptr<Task>>& dependencies,
+                                   TaskPriority priority = TaskPriority::Medium);
+
+  /**
+   * Submits a Task that starts executing once all the given dependencies have finished or been
+   * canceled. Does nothing if the Task is nullptr. A Task can only be submitted once.
+   * @param task The Task to be executed.
+   * @param dependencies The Tasks that must complete before the Task starts. nullptr entries are
+   * ignored.
+   * @param priority The priority of the Task. The default is TaskPriority::Medium.
+   */
+  static void Run(std::shared_ptr<Task> task,
+                  const std::vector<std::shared_ptr<Task>>& dependencies,
+                  TaskPriority priority = TaskPriority::Medium);
+
   virtual ~Task() = default;
 
   /**
@@ -117,8 +157,10 @@ class Task {
   /**
    * Blocks the current thread until the Task finishes its execution or the specified timeout
    * elapses. Returns immediately if the Task is finished or canceled. The task may be executed on
-   * the calling thread if it is not canceled and still in the queue, in which case the timeout is
-   * not applied. If the timeout is zero, this method blocks indefinitely until the Task finishes.
+   * the calling thread if it is not canceled, still in the queue and has no pending dependencies,
+   * in which case the timeout is not applied. When called from a task thread, the thread keeps
+   * executing other queued tasks while it waits instead of blocking. If the timeout is zero, this
+   * method blocks indefinitely until the Task finishes.
    * @param timeout The maximum duration in milliseconds to wait for the Task to finish. The default
    * is 0ms, which means the method will block indefinitely.
    * @return true if the Task finished or was canceled, false if it timed out.
@@ -143,9 +185,20 @@ class Task {
   std::mutex locker = {};
   std::condition_variable condition = {};
   std::atomic<TaskStatus> _status = TaskStatus::Queueing;
+  TaskPriority priority = TaskPriority::Medium;
+  std::atomic_int pendingDependencies = 0;
+  std::vector<std::shared_ptr<Task>> dependents = {};
+
+  static void Schedule(std::shared_ptr<Task> task);
+
+  static void ReleaseDependency(std::shared_ptr<Task> task);
+
+  bool isDone() const;
 
   void execute();
 
+  void finish();
+
   friend class TaskGroup;
 };
 
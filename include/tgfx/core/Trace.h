@@ -0,0 +1,62 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include "tgfx/core/Data.h"
+
+namespace tgfx {
+/**
+ * Trace records the scoped zones and counters that tgfx emits across the render pipeline, from
+ * DisplayList::render() and Layer drawing down to the render task execution and the GPU submit.
+ * The recorded events are exported in the Chrome trace-event JSON format, which can be opened in
+ * chrome://tracing or in the Perfetto UI (ui.perfetto.dev). The zones are only compiled in when
+ * tgfx is built with the TGFX_USE_TRACE option, otherwise all methods do nothing and IsAvailable()
+ * returns false. All methods are thread-safe.
+ */
+class Trace {
+ public:
+  /**
+   * Returns true if tgfx was built with the TGFX_USE_TRACE option.
+   */
+  static bool IsAvailable();
+
+  /**
+   * Returns true if the events are being recorded.
+   */
+  static bool IsRecording();
+
+  /**
+   * Discards all previously recorded events and starts recording new events from all threads.
+   * Once the number of recorded events reaches the internal limit, further events are dropped.
+   */
+  static void Start();
+
+  /**
+   * Stops recording events. The recorded events are kept until the next call to Start().
+   */
+  static void Stop();
+
+  /**
+   * Exports the recorded events as a Chrome trace-event JSON document. Returns nullptr if there
+   * is no recorded event.
+   */
+  static std::shared_ptr<Data> ExportJSON();
+};
+}  // namespace tgfx
@@ -69,7 +69,8 @@ class Typeface {
 
   /**
    * Creates a new typeface for the given file path and ttc index. Returns nullptr if the typeface
-   * can't be created.
+   * can't be created. Local font files are memory-mapped where supported, see
+   * Data::MakeFromFileMapping(), so the file must not be truncated while the typeface is alive.
    */
   static std::shared_ptr<Typeface> MakeFromPath(const std::string& fontPath, int ttcIndex = 0);
 
@@ -199,5 +200,6 @@ class Typeface {
   friend class RenderContext;
   friend class PDFExportContext;
   friend class PDFFont;
+  friend class PictureWriter;
 };
 }  // namespace tgfx
@@ -52,7 +52,8 @@ class CommandQueue {
    * afterwards. The pixel data must match the texture's pixel format, and the rectangle must be
    * fully contained within the texture's dimensions. If the texture has mipmaps, you should call
    * CommandEncoder's generateMipmapsForTexture() method after writing the pixels, as mipmaps will
-   * not be generated automatically.
+   * not be generated automatically. For block-compressed formats, the rectangle must be aligned to
+   * the 4x4 blocks or reach the texture edges, and rowBytes is the size of one row of blocks.
    */
   virtual void writeTexture(std::shared_ptr<Texture> texture, const Rect& rect, const void* pixels,
                             size_t rowBytes) = 0;
@@ -23,6 +23,8 @@
 #include <memory>
 #include "tgfx/gpu/Backend.h"
 #include "tgfx/gpu/Device.h"
+#include "tgfx/gpu/FrameStats.h"
+#include "tgfx/gpu/ProgramCache.h"
 #include "tgfx/gpu/Recording.h"
 
 namespace tgfx {
@@ -39,6 +41,7 @@ class AtlasManager;
 class CommandBuffer;
 class ShaderCaps;
 class AtlasStrikeCache;
+class AtlasShapeCache;
 class SingleOwner;
 
 /**
@@ -173,6 +176,69 @@ class Context {
    */
   bool flushAndSubmit(bool syncCpu = false);
 
+  /**
+   * Returns the hit and miss counters of the persistent program cache set by
+   * Device::setProgramCache(). All counters stay zero if no program cache is set.
+   */
+  ProgramCacheStats programCacheStats() const;
+
+  /**
+   * Returns true if new shader programs are compiled asynchronously. The default is false.
+   */
+  bool asyncShaderCompilation() const;
+
+  /**
+   * Sets whether new shader programs are compiled asynchronously. When enabled, a draw that needs a
+   * program which is not compiled yet is skipped instead of blocking the frame, and the program is
+   * compiled in the background (or within a small per-frame budget on backends that can not create
+   * pipelines from other threads). Check deferredDrawCount() after each submit and draw the frame
+   * again if it is nonzero.
+   */
+  void setAsyncShaderCompilation(bool enabled);
+
+  /**
+   * Returns the number of draws skipped during the last call to submit() because their shader
+   * programs were still compiling. Always zero if asynchronous shader compilation is disabled.
+   */
+  size_t deferredDrawCount() const;
+
+  /**
+   * Returns the number of recent draw batches a new draw can be moved back across to join a
+   * compatible batch. The default is 8.
+   */
+  size_t reorderWindow() const;
+
+  /**
+   * Sets the number of recent draw batches a new draw can be moved back across to join a
+   * compatible batch. A draw is only moved in front of batches it does not overlap, so the output
+   * stays the same while fewer draw calls and program switches are issued. Set it to 0 to keep
+   * every draw in submission order.
+   */
+  void setReorderWindow(size_t count);
+
+  /**
+   * Returns true if render targets first rendered into during a frame can reuse the textures of
+   * earlier render targets of the same frame whose contents are no longer needed. The default is
+   * true.
+   */
+  bool renderTargetAliasing() const;
+
+  /**
+   * Sets whether render targets first rendered into during a frame can reuse the textures of
+   * earlier render targets of the same frame whose contents are no longer needed, such as the
+   * intermediate passes of a filter chain. Disabling it gives every such render target a texture of
+   * its own, which uses more memory but may help to debug rendering issues.
+   */
+  void setRenderTargetAliasing(bool enabled);
+
+  /**
+   * Returns the statistics of the last frame, which ended with the last call to submit(). Draws
+   * flushed after that call are counted in the next frame. Enable the TGFX_USE_TRACE build option
+   * and call Trace::Start() to also record these counters and the time spent in each stage of the
+   * render pipeline into a trace.
+   */
+  FrameStats frameStats() const;
+
   GlobalCache* globalCache() const {
     return _globalCache;
   }
@@ -199,6 +265,14 @@ class Context {
     return _atlasStrikeCache;
   }
 
+  AtlasShapeCache* atlasShapeCache() const {
+    return _atlasShapeCache;
+  }
+
+  FrameStats* currentFrameStats() {
+    return &_currentFrameStats;
+  }
+
  private:
   std::shared_ptr<DrawingBuffer> getDrawingBuffer(const Recording* recording) const;
 
@@ -211,7 +285,12 @@ class Context {
   ProxyProvider* _proxyProvider = nullptr;
   AtlasManager* _atlasManager = nullptr;
   AtlasStrikeCache* _atlasStrikeCache = nullptr;
+  AtlasShapeCache* _atlasShapeCache = nullptr;
   std::deque<std::shared_ptr<DrawingBuffer>> pendingDrawingBuffers = {};
+  FrameStats _currentFrameStats = {};
+  FrameStats lastFrameStats = {};
+  size_t _reorderWindow = 8;
+  bool _renderTargetAliasing = true;
 
 #if DEBUG
   std::unique_ptr<SingleOwner> singleOwner;
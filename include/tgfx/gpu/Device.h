@@ -25,6 +25,7 @@
 namespace tgfx {
 class Context;
 class GPU;
+class ProgramCache;
 
 /**
  * The GPU interface for drawing graphics.
@@ -55,6 +56,21 @@ class Device {
    */
   void unlock();
 
+  /**
+   * Returns the persistent cache used to store compiled program binaries across sessions, or
+   * nullptr if no cache is set.
+   */
+  std::shared_ptr<ProgramCache> programCache() const;
+
+  /**
+   * Sets a persistent cache used to store compiled program binaries across sessions. The entries
+   * stored for the current GPU driver are preloaded when the Context is created, so set the cache
+   * before the first call to lockContext() to benefit from it on the first frame. Programs that
+   * have no usable binary in the cache are compiled as usual and then added to it. This method
+   * must not be called while the device is locked on the calling thread.
+   */
+  void setProgramCache(std::shared_ptr<ProgramCache> cache);
+
  protected:
   std::mutex locker = {};
   GPU* _gpu = nullptr;
@@ -73,6 +89,7 @@ class Device {
  private:
   uint32_t _uniqueID = 0;
   bool contextLocked = false;
+  std::shared_ptr<ProgramCache> _programCache = nullptr;
 
   friend class ResourceCache;
 };
@@ -0,0 +1,125 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tgfx {
+/**
+ * FrameStats reports the work done by a Context for one frame, which covers everything recorded
+ * by the calls to Context::flush() since the previous frame and the encoding done by the call to
+ * Context::submit() that ends the frame.
+ */
+struct FrameStats {
+  /**
+   * The number of draw operations created by the drawing commands.
+   */
+  size_t drawOpCount = 0;
+
+  /**
+   * The number of drawing commands that were batched into the draw operation of a preceding
+   * command instead of creating their own.
+   */
+  size_t mergedDrawCount = 0;
+
+  /**
+   * The number of batched draw operations, also counted in mergedDrawCount, that were moved back
+   * past non-overlapping draws to join an earlier compatible draw operation. See
+   * Context::setReorderWindow().
+   */
+  size_t reorderedDrawCount = 0;
+
+  /**
+   * The number of times a draw operation bound a different shader program than the draw executed
+   * right before it in the same render pass.
+   */
+  size_t programSwitchCount = 0;
+
+  /**
+   * The number of shapes drawn from the shared coverage mask atlas instead of a mask texture of
+   * their own. Shapes in the same atlas page are batched into one draw operation.
+   */
+  size_t atlasShapeDrawCount = 0;
+
+  /**
+   * The percentage (0-100) of the allocated alpha mask atlas pages covered by glyph and shape
+   * masks, measured at the end of the last flush of the frame.
+   */
+  size_t maskAtlasOccupancy = 0;
+
+  /**
+   * The number of clip masks rasterized for clips that could not be applied analytically.
+   */
+  size_t clipMaskCount = 0;
+
+  /**
+   * The number of clip masks reused from an earlier frame, render target or tile with the same
+   * clip content instead of being rasterized again.
+   */
+  size_t clipMaskCacheHits = 0;
+
+  /**
+   * The number of render targets that were first rendered into during the frame.
+   */
+  size_t transientRenderTargetCount = 0;
+
+  /**
+   * The number of render targets, also counted in transientRenderTargetCount, that reused the
+   * texture of an earlier render target of the same frame whose contents were no longer needed
+   * instead of allocating a texture of their own.
+   */
+  size_t aliasedRenderTargetCount = 0;
+
+  /**
+   * The number of render tasks executed, each of which encodes at least one render pass.
+   */
+  size_t renderTaskCount = 0;
+
+  /**
+   * The number of shader programs compiled, excluding the ones restored from the program cache.
+   */
+  size_t programCompileCount = 0;
+
+  /**
+   * The number of bytes uploaded to GPU textures and buffers.
+   */
+  size_t uploadedBytes = 0;
+
+  /**
+   * The number of GPU resources found in the resource cache.
+   */
+  size_t resourceCacheHits = 0;
+
+  /**
+   * The number of GPU resource lookups that missed the resource cache.
+   */
+  size_t resourceCacheMisses = 0;
+
+  /**
+   * The time in microseconds spent in Context::flush().
+   */
+  int64_t flushTime = 0;
+
+  /**
+   * The time in microseconds spent in Context::submit(), including the encoding of the frame.
+   */
+  int64_t submitTime = 0;
+};
+}  // namespace tgfx
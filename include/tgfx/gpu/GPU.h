@@ -19,6 +19,7 @@
 #pragma once
 
 #include <memory>
+#include "tgfx/core/Data.h"
 #include "tgfx/gpu/Backend.h"
 #include "tgfx/gpu/CommandEncoder.h"
 #include "tgfx/gpu/CommandQueue.h"
@@ -155,6 +156,43 @@ class GPU {
   virtual std::shared_ptr<RenderPipeline> createRenderPipeline(
       const RenderPipelineDescriptor& descriptor) = 0;
 
+  /**
+   * Returns the driver-specific binary of the given pipeline, which can be passed to
+   * createRenderPipelineFromBinary() in a later session to skip shader compilation. Returns nullptr
+   * if the backend does not support per-pipeline binaries.
+   */
+  virtual std::shared_ptr<Data> getPipelineBinary(const RenderPipeline*) {
+    return nullptr;
+  }
+
+  /**
+   * Creates a RenderPipeline from a binary previously returned by getPipelineBinary(). The shader
+   * modules of the descriptor are ignored, while all other states are applied as usual. Returns
+   * nullptr if the backend does not support pipeline binaries or the driver rejects the binary,
+   * for example after a driver update. In that case, the caller should fall back to
+   * createRenderPipeline().
+   */
+  virtual std::shared_ptr<RenderPipeline> createRenderPipelineFromBinary(
+      const RenderPipelineDescriptor&, const Data*) {
+    return nullptr;
+  }
+
+  /**
+   * Returns the serialized content of the backend's internal pipeline cache, such as a
+   * VkPipelineCache in Vulkan. Returns nullptr if the backend has no such cache.
+   */
+  virtual std::shared_ptr<Data> getPipelineCacheData() {
+    return nullptr;
+  }
+
+  /**
+   * Merges the data previously returned by getPipelineCacheData() into the backend's internal
+   * pipeline cache. Returns false if the backend has no such cache or the data is incompatible.
+   */
+  virtual bool mergePipelineCacheData(const Data*) {
+    return false;
+  }
+
   /**
    * Creates a command encoder that can be used to encode commands to be issued to the GPU.
    */
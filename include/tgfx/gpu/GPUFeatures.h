@@ -47,5 +47,30 @@ class GPUFeatures {
    * renderer) is decided by higher-level code, not by this field.
    */
   bool stencilAttachmentSupported = false;
+
+  /**
+   * Indicates whether shader modules and render pipelines can be created from threads other than
+   * the one that owns the Context. If true, new programs can be compiled in the background while
+   * the render thread keeps drawing.
+   */
+  bool concurrentPipelineCreation = false;
+
+  /**
+   * Indicates whether the GPU can sample textures in the ETC2 and EAC block-compressed formats,
+   * which are PixelFormat::ETC2_RGB8 and PixelFormat::ETC2_RGBA8.
+   */
+  bool textureCompressionETC2 = false;
+
+  /**
+   * Indicates whether the GPU can sample textures in the BC (S3TC) block-compressed formats, which
+   * are PixelFormat::BC1_RGB and PixelFormat::BC3_RGBA.
+   */
+  bool textureCompressionBC = false;
+
+  /**
+   * Indicates whether the GPU can sample textures in the ASTC LDR block-compressed formats, which
+   * is PixelFormat::ASTC_4x4.
+   */
+  bool textureCompressionASTC = false;
 };
 }  // namespace tgfx
@@ -56,6 +56,38 @@ enum class PixelFormat {
   /**
    * Pixel with 24 bits for depth, 8 bits for stencil. Each pixel is stored on 4 bytes.
    */
-  DEPTH24_STENCIL8
+  DEPTH24_STENCIL8,
+
+  /**
+   * ETC2 compressed pixels with 8 bits for red, green, blue, and an opaque alpha. Each block of 4x4
+   * pixels is stored on 8 bytes. Requires GPUFeatures::textureCompressionETC2.
+   */
+  ETC2_RGB8,
+
+  /**
+   * ETC2 compressed pixels with 8 bits for red, green, blue, alpha, where the alpha is compressed
+   * in the EAC format. Each block of 4x4 pixels is stored on 16 bytes. Requires
+   * GPUFeatures::textureCompressionETC2.
+   */
+  ETC2_RGBA8,
+
+  /**
+   * BC1 (DXT1) compressed pixels with 5-6-5 bits for red, green, blue, and an opaque alpha. Each
+   * block of 4x4 pixels is stored on 8 bytes. Requires GPUFeatures::textureCompressionBC.
+   */
+  BC1_RGB,
+
+  /**
+   * BC3 (DXT5) compressed pixels with 5-6-5 bits for red, green, blue, and 8 bits for alpha. Each
+   * block of 4x4 pixels is stored on 16 bytes. Requires GPUFeatures::textureCompressionBC.
+   */
+  BC3_RGBA,
+
+  /**
+   * ASTC compressed pixels with a 4x4 block footprint and red, green, blue, alpha channels in the
+   * LDR profile. Each block of 4x4 pixels is stored on 16 bytes. Requires
+   * GPUFeatures::textureCompressionASTC.
+   */
+  ASTC_4x4
 };
 }  // namespace tgfx
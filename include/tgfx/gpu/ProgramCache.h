@@ -0,0 +1,76 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "tgfx/core/Data.h"
+
+namespace tgfx {
+/**
+ * ProgramCacheStats reports how effective the persistent program cache has been for a Context.
+ */
+struct ProgramCacheStats {
+  /**
+   * The number of programs that were restored from a stored binary instead of being compiled.
+   */
+  size_t hitCount = 0;
+
+  /**
+   * The number of programs that had to be compiled because no usable binary was found.
+   */
+  size_t missCount = 0;
+
+  /**
+   * The total compile time in microseconds saved by restoring programs from stored binaries,
+   * calculated from the compile time recorded when each binary was stored.
+   */
+  int64_t compileTimeSaved = 0;
+};
+
+/**
+ * ProgramCache is an interface for persisting compiled GPU programs across sessions, so that the
+ * next launch can skip shader compilation. Entries are opaque blobs identified by string keys that
+ * already contain a fingerprint of the GPU driver, so a driver update never reuses stale binaries.
+ * Keys consist of alphanumeric characters and '-' only, which makes them usable as file names.
+ * Implementations can back the cache with a file directory, a database, or any other storage.
+ * All methods are called on the thread that locked the Context.
+ */
+class ProgramCache {
+ public:
+  /**
+   * Creates a ProgramCache that stores each entry as a file in the specified directory. The
+   * directory must already exist. Returns nullptr if the directory path is empty.
+   */
+  static std::shared_ptr<ProgramCache> MakeFromDirectory(const std::string& directory);
+
+  virtual ~ProgramCache() = default;
+
+  /**
+   * Returns the data stored with the specified key, or nullptr if there is no such entry.
+   */
+  virtual std::shared_ptr<Data> load(const std::string& key) = 0;
+
+  /**
+   * Stores the data with the specified key, replacing any existing entry with the same key.
+   */
+  virtual void store(const std::string& key, std::shared_ptr<Data> data) = 0;
+};
+}  // namespace tgfx
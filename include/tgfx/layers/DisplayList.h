@@ -24,6 +24,7 @@
 #include "tgfx/layers/Layer.h"
 
 namespace tgfx {
+class RasterCanvas;
 class RootLayer;
 class Tile;
 class TileCache;
@@ -255,6 +256,45 @@ class DisplayList {
     _maxTilesRefinedPerFrame = count;
   }
 
+  /**
+   * Returns the maximum number of threads used to record dirty tiles in tiled rendering mode. This
+   * setting is ignored in other render modes. When greater than 1, the dirty tiles of a frame are
+   * partitioned across TaskGroup threads, each recording its tiles into separate Pictures, which
+   * are then played back to the tile caches in order on the calling thread. This reduces the
+   * CPU-side cost of Layer recording for large layer trees. Frames whose layer tree contains
+   * background styles, blend modes, 3D layers, or that use subtree caching are always recorded on
+   * the calling thread, since those features need to access the GPU context while recording. The
+   * default value is 1, which records all tiles on the calling thread.
+   */
+  int tileRecordingThreads() const {
+    return _tileRecordingThreads;
+  }
+
+  /**
+   * Sets the maximum number of threads used to record dirty tiles in tiled rendering mode.
+   */
+  void setTileRecordingThreads(int count);
+
+  /**
+   * Returns the maximum number of threads used to update the contents of dirty layers before each
+   * render. When greater than 1, the layers whose contents were invalidated since the last frame
+   * call their onUpdateContent() methods concurrently on TaskGroup threads, which also resolve the
+   * bounds of the new contents. The results are then applied to the layer tree on the calling
+   * thread, so rendering produces the same output as a single-threaded update. Layers that share a
+   * LayerProperty (e.g. a VectorElement added to multiple VectorLayers) are always updated on the
+   * calling thread. Custom Layer subclasses that override onUpdateContent() must not access state
+   * shared with other layers when this is enabled. The default value is 1, which updates all
+   * contents on the calling thread.
+   */
+  int contentUpdateThreads() const {
+    return _contentUpdateThreads;
+  }
+
+  /**
+   * Sets the maximum number of threads used to update the contents of dirty layers.
+   */
+  void setContentUpdateThreads(int count);
+
   /**
    * Returns the background color of the display list. The background is an infinite rectangle that
    * covers the entire display area and is drawn using the SrcOver blend mode during rendering.
@@ -312,6 +352,17 @@ class DisplayList {
    */
   void render(Surface* surface, bool autoClear = true);
 
+  /**
+   * Renders the display list into the pixels of the given RasterCanvas on the CPU, as if it were
+   * rendered in RenderMode::Direct. Returns false and leaves the pixels untouched if the layer tree
+   * contains content that the raster backend can not render, such as layer styles or filters based
+   * on image filters. Rendering to a RasterCanvas drops the caches used by render(Surface*).
+   * @param canvas The RasterCanvas to render the display list into.
+   * @param autoClear If true, the pixels will be cleared before rendering the display list.
+   * Otherwise, the display list will be rendered over the existing content.
+   */
+  bool render(RasterCanvas* canvas, bool autoClear = true);
+
  private:
   std::shared_ptr<RootLayer> _root = nullptr;
   Color _backgroundColor = Color::Transparent();
@@ -323,6 +374,8 @@ class DisplayList {
   int _maxTileCount = 0;
   TileUpdateMode _tileUpdateMode = TileUpdateMode::Immediate;
   int _maxTilesRefinedPerFrame = 5;
+  int _tileRecordingThreads = 1;
+  int _contentUpdateThreads = 1;
   int _subtreeCacheMaxSize = 0;
   bool _showDirtyRegions = false;
   bool _hasContentChanged = false;
@@ -384,6 +437,18 @@ class DisplayList {
 
   void drawTileTask(const DrawTask& task, BackgroundSnapshotMap* snapshots) const;
 
+  Matrix getTileViewMatrix(const DrawTask& task, Rect* clipRect) const;
+
+  void updateLayerContents();
+
+  bool canRecordTilesConcurrently() const;
+
+  std::vector<std::shared_ptr<Picture>> recordTileTasks(
+      const std::vector<DrawTask>& tileTasks, const std::shared_ptr<ColorSpace>& colorSpace) const;
+
+  std::shared_ptr<Picture> recordTileTask(const DrawTask& task,
+                                          const std::shared_ptr<ColorSpace>& colorSpace) const;
+
   void drawScreenTasks(std::vector<DrawTask> screenTasks, std::vector<Rect> skippedRects,
                        Surface* surface, bool autoClear) const;
 
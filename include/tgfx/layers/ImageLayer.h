@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "tgfx/core/AnimatedCodec.h"
 #include "tgfx/core/Image.h"
 #include "tgfx/layers/Layer.h"
 
@@ -57,10 +58,39 @@ class ImageLayer : public Layer {
   }
 
   /**
-   * Sets the image displayed by this layer.
+   * Sets the image displayed by this layer. Any animated codec set before is removed.
    */
   void setImage(std::shared_ptr<Image> value);
 
+  /**
+   * Returns the animated codec whose frames are displayed by this layer, or nullptr if the layer
+   * displays a still image.
+   */
+  std::shared_ptr<AnimatedCodec> animatedCodec() const {
+    return _animatedCodec;
+  }
+
+  /**
+   * Sets an animated codec whose frames are displayed by this layer in place of the image. The
+   * layer shows the frame at currentTime(), and image() returns that frame. Switching between
+   * frames only uploads the area that changed, and the following frames are decoded in the
+   * background ahead of time.
+   */
+  void setAnimatedCodec(std::shared_ptr<AnimatedCodec> value);
+
+  /**
+   * Returns the playback time of the animated codec in microseconds. The default value is 0.
+   */
+  int64_t currentTime() const {
+    return _currentTime;
+  }
+
+  /**
+   * Sets the playback time of the animated codec in microseconds. The content of the layer is only
+   * invalidated if the time falls on another frame.
+   */
+  void setCurrentTime(int64_t value);
+
  protected:
   ImageLayer() : _sampling(FilterMode::Linear, MipmapMode::Linear) {
   }
@@ -70,5 +100,10 @@ class ImageLayer : public Layer {
  private:
   SamplingOptions _sampling;
   std::shared_ptr<Image> _image = nullptr;
+  std::shared_ptr<AnimatedCodec> _animatedCodec = nullptr;
+  int64_t _currentTime = 0;
+  int currentFrame = -1;
+
+  void updateAnimatedFrame();
 };
 }  // namespace tgfx
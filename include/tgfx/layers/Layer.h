@@ -33,6 +33,7 @@
 
 namespace tgfx {
 class LayerContent;
+class LayerBVH;
 class SubtreeCache;
 class DisplayList;
 class DrawArgs;
@@ -630,6 +631,8 @@ class Layer : public std::enable_shared_from_this<Layer> {
 
   LayerContent* getContent();
 
+  std::unique_ptr<LayerContent> recordContent();
+
   Rect mapContentBoundsToImage(float scale, const Rect& imageBounds);
 
   Rect mapOutputBoundsToInput(const Rect& srcRect, float contentScale);
@@ -685,6 +688,18 @@ class Layer : public std::enable_shared_from_this<Layer> {
 
   bool getLayersUnderPointInternal(float x, float y, std::vector<std::shared_ptr<Layer>>* results);
 
+  bool getHitTestCandidates(float x, float y, std::vector<size_t>* candidates);
+
+  bool updateHitTestIndex();
+
+  void updateHitTestSlot(size_t index);
+
+  bool getHitTestBounds(Rect* bounds);
+
+  void updateRenderIndex();
+
+  void resetChildIndexes();
+
   bool prepareMask(const DrawArgs& args, Canvas* canvas, std::shared_ptr<MaskFilter>* maskFilter);
 
   MaskData getMaskData(const DrawArgs& args, float scale,
@@ -750,6 +765,8 @@ class Layer : public std::enable_shared_from_this<Layer> {
     bool hasBlendMode : 1;
     bool matrix3DIsAffine : 1;  // Whether the matrix3D is equivalent to a 2D affine matrix
     bool staticSubtree : 1;  // Whether the subtree (content, children, filters, styles) is static.
+    bool hitTestUnbounded : 1;  // Whether hitTestBounds cannot bound the subtree (3D descendants)
+    bool sharedProperty : 1;    // Whether a LayerProperty of this layer has ever had other owners
     uint8_t blendMode : 5;
     uint8_t maskType : 2;
   } bitFields = {};
@@ -768,9 +785,12 @@ class Layer : public std::enable_shared_from_this<Layer> {
   std::vector<std::shared_ptr<LayerStyle>> _layerStyles = {};
   std::unique_ptr<SubtreeCache> subtreeCache;
   std::shared_ptr<LayerContent> layerContent = nullptr;
-  Rect renderBounds = {};                       // in global coordinates
-  Rect* contentBounds = nullptr;                //  in global coordinates
-  std::unique_ptr<Rect> localBounds = nullptr;  // in local coordinates
+  Rect renderBounds = {};                            // in global coordinates
+  Rect* contentBounds = nullptr;                     //  in global coordinates
+  std::unique_ptr<Rect> localBounds = nullptr;       // in local coordinates
+  std::unique_ptr<Rect> hitTestBounds = nullptr;     // in local coordinates, excluding effects
+  std::unique_ptr<LayerBVH> renderIndex;             // children indexed by renderBounds
+  std::unique_ptr<LayerBVH> hitTestIndex;            // children indexed by hit-test bounds
 
   // Max/min background-sourced filter outset (local units at contentScale=1) across this subtree.
   // max>0 doubles as a presence flag for background styles; min is used to decide bg surface
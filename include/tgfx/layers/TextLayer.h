@@ -25,6 +25,7 @@
 namespace tgfx {
 class GlyphInfo;
 class GlyphLine;
+class ShapedParagraph;
 class TextBlob;
 
 /**
@@ -147,12 +148,13 @@ class TextLayer : public Layer {
   float _height = 0;
   TextAlign _textAlign = TextAlign::Start;
   bool _autoWrap = false;
+  std::vector<std::shared_ptr<ShapedParagraph>> shapedParagraphs = {};
+  Font shapedFont = {};
+  uint32_t shapedFallbackGeneration = 0;
 
   static std::string PreprocessNewLines(const std::string& text);
-  static std::vector<std::shared_ptr<GlyphInfo>> ShapeText(
-      const std::string& text, const std::shared_ptr<Typeface>& typeface);
 
-  float calcAdvance(const std::shared_ptr<GlyphInfo>& glyphInfo, float emptyAdvance) const;
+  void updateShapedParagraphs(const std::string& text);
   float getLineHeight(const std::shared_ptr<GlyphLine>& glyphLine) const;
   void truncateGlyphLines(std::vector<std::shared_ptr<GlyphLine>>& glyphLines) const;
   void resolveTextAlignment(const std::vector<std::shared_ptr<GlyphLine>>& glyphLines,
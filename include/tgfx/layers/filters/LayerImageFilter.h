@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <mutex>
 #include "tgfx/layers/filters/LayerFilter.h"
 
 namespace tgfx {
@@ -47,6 +48,8 @@ class LayerImageFilter : public LayerFilter {
  private:
   std::shared_ptr<ImageFilter> getImageFilter(float scale);
 
+  // Guards the cached filter, which may be requested by several tile recording threads at once.
+  std::mutex locker = {};
   bool dirty = true;
   float lastScale = 1.0f;
   std::shared_ptr<ImageFilter> lastFilter;
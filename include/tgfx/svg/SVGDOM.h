@@ -51,7 +51,9 @@ using CSSMapper = std::unordered_map<std::string, std::string>;
 class SVGDOM {
  public:
   /**
-   * Creates an SVGDOM object from the provided stream.
+   * Creates an SVGDOM object from the provided stream. Streams with a memory base, such as the ones
+   * returned by Stream::MakeFromData() for a Data::MakeFromFileMapping() file, are parsed in place
+   * without copying.
    * If textShaper is nullptr, only text with specified system fonts will render. Text without a
    * specified font or requiring fallback fonts will not render.
    * If customParser is nullptr, the default parser will be used. All custom attributes will be
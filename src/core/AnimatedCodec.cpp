@@ -0,0 +1,348 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tgfx/core/AnimatedCodec.h"
+#include <algorithm>
+#include <cstring>
+#include "core/AnimatedDecoder.h"
+#include "core/PixelBuffer.h"
+#include "core/images/AnimatedImage.h"
+#include "core/utils/Log.h"
+#include "core/utils/USE.h"
+#include "gpu/tasks/AnimatedFrameUploadTask.h"
+#include "tgfx/core/Pixmap.h"
+#include "tgfx/core/Task.h"
+
+namespace tgfx {
+// Browsers play frames lasting 10ms or less at 100ms, and many GIFs rely on that.
+static constexpr int64_t MIN_FRAME_DURATION = 10000;
+static constexpr int64_t DEFAULT_FRAME_DURATION = 100000;
+
+std::shared_ptr<AnimatedCodec> AnimatedCodec::MakeFrom(const std::string& filePath) {
+  return MakeFrom(Data::MakeFromFile(filePath));
+}
+
+std::shared_ptr<AnimatedCodec> AnimatedCodec::MakeFrom(std::shared_ptr<Data> imageBytes) {
+  auto decoder = AnimatedDecoder::Make(std::move(imageBytes));
+  if (decoder == nullptr || !ImageInfo::IsValidSize(decoder->width(), decoder->height())) {
+    return nullptr;
+  }
+  auto codec = std::shared_ptr<AnimatedCodec>(new AnimatedCodec(std::move(decoder)));
+  codec->weakThis = codec;
+  return codec;
+}
+
+AnimatedCodec::AnimatedCodec(std::unique_ptr<AnimatedDecoder> animatedDecoder)
+    : decoder(std::move(animatedDecoder)), _width(decoder->width()), _height(decoder->height()),
+      _loopCount(decoder->loopCount()) {
+  auto canvasBounds = Rect::MakeWH(_width, _height);
+  for (auto& info : decoder->frameInfos()) {
+    auto frameInfo = info;
+    if (!frameInfo.bounds.intersect(canvasBounds)) {
+      frameInfo.bounds.setEmpty();
+    }
+    if (frameInfo.duration <= MIN_FRAME_DURATION) {
+      frameInfo.duration = DEFAULT_FRAME_DURATION;
+    }
+    frameStartTimes.push_back(_duration);
+    _duration += frameInfo.duration;
+    frameInfos.push_back(frameInfo);
+  }
+}
+
+AnimatedCodec::~AnimatedCodec() {
+  if (decodeAheadTask != nullptr) {
+    decodeAheadTask->cancel();
+  }
+}
+
+AnimatedFrameInfo AnimatedCodec::getFrameInfo(int index) const {
+  if (index < 0 || index >= frameCount()) {
+    return {};
+  }
+  return frameInfos[static_cast<size_t>(index)];
+}
+
+int AnimatedCodec::getFrameAtTime(int64_t time) const {
+  if (time <= 0 || _duration <= 0) {
+    return 0;
+  }
+  if (_loopCount > 0 && time / _duration >= _loopCount) {
+    return frameCount() - 1;
+  }
+  auto result = std::upper_bound(frameStartTimes.begin(), frameStartTimes.end(), time % _duration);
+  return static_cast<int>(result - frameStartTimes.begin()) - 1;
+}
+
+int AnimatedCodec::maxCachedFrames() const {
+  std::lock_guard<std::mutex> autoLock(cacheLocker);
+  return _maxCachedFrames;
+}
+
+void AnimatedCodec::setMaxCachedFrames(int count) {
+  std::lock_guard<std::mutex> autoLock(cacheLocker);
+  _maxCachedFrames = std::max(count, 1);
+  while (cachedFrames.size() > static_cast<size_t>(_maxCachedFrames)) {
+    cachedFrames.pop_front();
+  }
+}
+
+bool AnimatedCodec::readFrame(int index, const ImageInfo& dstInfo, void* dstPixels) const {
+  auto pixels = getFrame(index);
+  if (pixels == nullptr) {
+    return false;
+  }
+  auto srcInfo = ImageInfo::Make(_width, _height, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  return Pixmap(srcInfo, pixels->data()).readPixels(dstInfo, dstPixels);
+}
+
+std::shared_ptr<Image> AnimatedCodec::makeFrameImage(int index) const {
+  auto image = AnimatedImage::MakeFrom(weakThis.lock(), index);
+  if (image != nullptr) {
+    // Start on the frame right away, so that it is likely ready by the time it is drawn.
+    scheduleDecodeAhead(index);
+  }
+  return image;
+}
+
+std::shared_ptr<AnimatedTextureState> AnimatedCodec::getTextureState(uint32_t contextID,
+                                                                      bool mipmapped) const {
+  std::lock_guard<std::mutex> autoLock(textureStateLocker);
+  auto& state = textureStates[mipmapped ? 1 : 0][contextID];
+  if (state == nullptr) {
+    state = std::make_shared<AnimatedTextureState>();
+  }
+  return state;
+}
+
+std::shared_ptr<Data> AnimatedCodec::findCachedFrame(int index) const {
+  std::lock_guard<std::mutex> autoLock(cacheLocker);
+  for (auto& frame : cachedFrames) {
+    if (frame.index == index) {
+      return frame.pixels;
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<Data> AnimatedCodec::getFrame(int index) const {
+  if (index < 0 || index >= frameCount()) {
+    return nullptr;
+  }
+  auto pixels = findCachedFrame(index);
+  if (pixels == nullptr) {
+    pixels = decodeFrame(index);
+  }
+  scheduleDecodeAhead(index + 1);
+  return pixels;
+}
+
+std::shared_ptr<Data> AnimatedCodec::decodeFrame(int index) const {
+  std::lock_guard<std::mutex> autoLock(decodeLocker);
+  // The decode-ahead task may have finished the frame while we were waiting for the lock.
+  if (auto pixels = findCachedFrame(index)) {
+    return pixels;
+  }
+  if (canvasFrame > index) {
+    // Frames depend on the ones before them, so seeking backward restarts from the first frame.
+    canvasFrame = -1;
+  }
+  while (canvasFrame < index) {
+    if (!compositeNextFrame()) {
+      return nullptr;
+    }
+  }
+  auto pixels = Data::MakeWithCopy(canvas.data(), canvas.size());
+  if (pixels == nullptr) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> cacheLock(cacheLocker);
+  cachedFrames.push_back({index, pixels});
+  while (cachedFrames.size() > static_cast<size_t>(_maxCachedFrames)) {
+    cachedFrames.pop_front();
+  }
+  return pixels;
+}
+
+static void ClearRect(uint8_t* pixels, size_t rowBytes, const Rect& rect) {
+  auto left = static_cast<size_t>(rect.left) * 4;
+  auto width = static_cast<size_t>(rect.width()) * 4;
+  for (auto y = static_cast<size_t>(rect.top); y < static_cast<size_t>(rect.bottom); y++) {
+    memset(pixels + y * rowBytes + left, 0, width);
+  }
+}
+
+static void CopyRect(const uint8_t* srcPixels, uint8_t* dstPixels, size_t rowBytes,
+                     const Rect& rect) {
+  auto left = static_cast<size_t>(rect.left) * 4;
+  auto width = static_cast<size_t>(rect.width()) * 4;
+  for (auto y = static_cast<size_t>(rect.top); y < static_cast<size_t>(rect.bottom); y++) {
+    memcpy(dstPixels + y * rowBytes + left, srcPixels + y * rowBytes + left, width);
+  }
+}
+
+static void BlendOver(const uint8_t* srcRow, uint8_t* dstRow, size_t width) {
+  for (size_t x = 0; x < width; x++) {
+    auto src = srcRow + x * 4;
+    auto dst = dstRow + x * 4;
+    auto srcAlpha = src[3];
+    if (srcAlpha == 255) {
+      memcpy(dst, src, 4);
+    } else if (srcAlpha != 0) {
+      auto inverseAlpha = 255 - srcAlpha;
+      for (int i = 0; i < 4; i++) {
+        dst[i] = static_cast<uint8_t>(src[i] + (dst[i] * inverseAlpha + 127) / 255);
+      }
+    }
+  }
+}
+
+bool AnimatedCodec::compositeNextFrame() const {
+  auto rowBytes = static_cast<size_t>(_width) * 4;
+  if (canvas.isEmpty() && !canvas.alloc(rowBytes * static_cast<size_t>(_height))) {
+    return false;
+  }
+  auto canvasPixels = canvas.bytes();
+  if (canvasFrame < 0) {
+    canvas.clear();
+  } else {
+    auto& previous = frameInfos[static_cast<size_t>(canvasFrame)];
+    if (previous.disposal == FrameDisposal::Background) {
+      ClearRect(canvasPixels, rowBytes, previous.bounds);
+    } else if (previous.disposal == FrameDisposal::Previous && !restoreCanvas.isEmpty()) {
+      CopyRect(restoreCanvas.bytes(), canvasPixels, rowBytes, previous.bounds);
+    }
+  }
+  auto index = canvasFrame + 1;
+  canvasFrame = index;
+  auto& info = frameInfos[static_cast<size_t>(index)];
+  if (info.bounds.isEmpty()) {
+    return true;
+  }
+  if (info.disposal == FrameDisposal::Previous) {
+    if (restoreCanvas.isEmpty() && !restoreCanvas.alloc(canvas.size())) {
+      return false;
+    }
+    CopyRect(canvasPixels, restoreCanvas.bytes(), rowBytes, info.bounds);
+  }
+  // The decoder works on the full frame, which may extend beyond the canvas.
+  auto& frameBounds = decoder->frameInfos()[static_cast<size_t>(index)].bounds;
+  auto frameWidth = static_cast<int>(frameBounds.width());
+  auto frameHeight = static_cast<int>(frameBounds.height());
+  if (!ImageInfo::IsValidSize(frameWidth, frameHeight)) {
+    LOGE("AnimatedCodec::compositeNextFrame() Invalid size of frame %d!", index);
+    return true;
+  }
+  auto frameRowBytes = static_cast<size_t>(frameWidth) * 4;
+  auto frameByteSize = frameRowBytes * static_cast<size_t>(frameHeight);
+  if (framePixels.size() < frameByteSize && !framePixels.alloc(frameByteSize)) {
+    return false;
+  }
+  memset(framePixels.data(), 0, frameByteSize);
+  if (!decoder->decodeFrame(index, framePixels.data(), frameRowBytes)) {
+    // A broken frame leaves the canvas untouched, and the animation goes on with the next one.
+    LOGE("AnimatedCodec::compositeNextFrame() Failed to decode frame %d!", index);
+    return true;
+  }
+  auto left = static_cast<size_t>(info.bounds.left);
+  auto width = static_cast<size_t>(info.bounds.width());
+  auto srcX = static_cast<size_t>(info.bounds.left - frameBounds.left);
+  auto srcY = static_cast<size_t>(info.bounds.top - frameBounds.top);
+  for (auto y = static_cast<size_t>(info.bounds.top); y < static_cast<size_t>(info.bounds.bottom);
+       y++) {
+    auto srcRow = framePixels.bytes() + (srcY++) * frameRowBytes + srcX * 4;
+    auto dstRow = canvasPixels + y * rowBytes + left * 4;
+    if (info.blend == FrameBlend::Source) {
+      memcpy(dstRow, srcRow, width * 4);
+    } else {
+      BlendOver(srcRow, dstRow, width);
+    }
+  }
+  return true;
+}
+
+void AnimatedCodec::scheduleDecodeAhead(int index) const {
+#ifdef TGFX_USE_THREADS
+  int count = 0;
+  {
+    std::lock_guard<std::mutex> autoLock(cacheLocker);
+    if (decodeAheadTask != nullptr && (decodeAheadTask->status() == TaskStatus::Queueing ||
+                                       decodeAheadTask->status() == TaskStatus::Executing)) {
+      return;
+    }
+    // The ring keeps the frame on display plus the frames ahead of it.
+    count = _maxCachedFrames - 1;
+  }
+  if (count <= 0) {
+    return;
+  }
+  auto weakCodec = weakThis;
+  // Task::Run() may execute the block right away, so it is called without holding the lock.
+  auto task = Task::Run(
+      [weakCodec, index, count]() {
+        auto codec = weakCodec.lock();
+        if (codec == nullptr) {
+          return;
+        }
+        auto frameCount = codec->frameCount();
+        for (int i = 0; i < count && i < frameCount; i++) {
+          auto frameIndex = (index + i) % frameCount;
+          if (codec->findCachedFrame(frameIndex) == nullptr &&
+              codec->decodeFrame(frameIndex) == nullptr) {
+            break;
+          }
+        }
+      },
+      TaskPriority::Low);
+  std::lock_guard<std::mutex> autoLock(cacheLocker);
+  decodeAheadTask = std::move(task);
+#else
+  // Without threads, decoding ahead would only block the caller with frames it does not need yet.
+  USE(index);
+#endif
+}
+
+Rect AnimatedCodec::getDirtyBounds(int fromIndex, int toIndex) const {
+  if (fromIndex == toIndex) {
+    return Rect::MakeEmpty();
+  }
+  if (fromIndex < 0 || toIndex < fromIndex) {
+    return Rect::MakeWH(_width, _height);
+  }
+  auto bounds = Rect::MakeEmpty();
+  for (auto index = fromIndex + 1; index <= toIndex; index++) {
+    auto& previous = frameInfos[static_cast<size_t>(index - 1)];
+    if (previous.disposal != FrameDisposal::Keep) {
+      bounds.join(previous.bounds);
+    }
+    bounds.join(frameInfos[static_cast<size_t>(index)].bounds);
+  }
+  return bounds;
+}
+
+std::shared_ptr<ImageBuffer> AnimatedCodec::makeFrameBuffer(int index, bool tryHardware) const {
+  auto pixelBuffer = PixelBuffer::Make(_width, _height, false, tryHardware);
+  if (pixelBuffer == nullptr) {
+    return nullptr;
+  }
+  auto dstPixels = pixelBuffer->lockPixels();
+  auto result = readFrame(index, pixelBuffer->info(), dstPixels);
+  pixelBuffer->unlockPixels();
+  return result ? pixelBuffer : nullptr;
+}
+}  // namespace tgfx
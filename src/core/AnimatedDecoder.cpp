@@ -0,0 +1,55 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "AnimatedDecoder.h"
+#include "core/codecs/GifDecoder.h"
+
+#ifdef TGFX_USE_WEBP_DECODE
+#include "core/codecs/webp/WebpAnimatedDecoder.h"
+#endif
+
+#ifdef TGFX_USE_PNG_DECODE
+#include "core/codecs/png/PngAnimatedDecoder.h"
+#endif
+
+namespace tgfx {
+std::unique_ptr<AnimatedDecoder> AnimatedDecoder::Make(std::shared_ptr<Data> imageBytes) {
+  if (imageBytes == nullptr || imageBytes->empty()) {
+    return nullptr;
+  }
+  std::unique_ptr<AnimatedDecoder> decoder = nullptr;
+  if (GifDecoder::IsGif(imageBytes)) {
+    decoder = GifDecoder::Make(imageBytes);
+  }
+#ifdef TGFX_USE_WEBP_DECODE
+  if (decoder == nullptr) {
+    decoder = WebpAnimatedDecoder::Make(imageBytes);
+  }
+#endif
+#ifdef TGFX_USE_PNG_DECODE
+  if (decoder == nullptr) {
+    decoder = PngAnimatedDecoder::Make(imageBytes);
+  }
+#endif
+  if (decoder == nullptr || decoder->width() <= 0 || decoder->height() <= 0 ||
+      decoder->frameInfos().empty()) {
+    return nullptr;
+  }
+  return decoder;
+}
+}  // namespace tgfx
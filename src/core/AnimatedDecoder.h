@@ -0,0 +1,84 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "tgfx/core/AnimatedCodec.h"
+#include "tgfx/core/Data.h"
+
+namespace tgfx {
+/**
+ * AnimatedDecoder parses the frames of an animated image and decodes each of them on its own,
+ * without applying the blend and disposal rules. AnimatedCodec composites the decoded frames onto
+ * the canvas. AnimatedDecoder is not thread safe.
+ */
+class AnimatedDecoder {
+ public:
+  /**
+   * Creates an AnimatedDecoder for the format recognized from the image bytes. Returns nullptr if
+   * the format is not supported, the image is not animated, or it has no valid frame.
+   */
+  static std::unique_ptr<AnimatedDecoder> Make(std::shared_ptr<Data> imageBytes);
+
+  virtual ~AnimatedDecoder() = default;
+
+  /**
+   * Returns the width of the animation canvas.
+   */
+  int width() const {
+    return _width;
+  }
+
+  /**
+   * Returns the height of the animation canvas.
+   */
+  int height() const {
+    return _height;
+  }
+
+  /**
+   * Returns the number of times the animation plays, or 0 if it repeats forever.
+   */
+  int loopCount() const {
+    return _loopCount;
+  }
+
+  /**
+   * Returns the information of all frames. The bounds of a frame may extend beyond the canvas.
+   */
+  const std::vector<AnimatedFrameInfo>& frameInfos() const {
+    return _frameInfos;
+  }
+
+  /**
+   * Decodes the frame at the specified index into pixels, a premultiplied RGBA_8888 buffer the size
+   * of the frame bounds with the given rowBytes. The caller clears the buffer to transparent
+   * beforehand, so the pixels missing from a truncated frame stay transparent. Returns false if
+   * the frame can not be decoded at all.
+   */
+  virtual bool decodeFrame(int index, void* pixels, size_t rowBytes) = 0;
+
+ protected:
+  int _width = 0;
+  int _height = 0;
+  int _loopCount = 0;
+  std::vector<AnimatedFrameInfo> _frameInfos = {};
+};
+}  // namespace tgfx
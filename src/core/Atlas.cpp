@@ -132,6 +132,19 @@ bool Atlas::hasCell(const PlotLocator& plotLocator) const {
   return plotGeneration == locatorGeneration;
 }
 
+float Atlas::occupancy() const {
+  if (pages.empty() || numPlots == 0) {
+    return 0.0f;
+  }
+  float totalFull = 0.0f;
+  for (auto& page : pages) {
+    for (auto& plot : page.plotList) {
+      totalFull += plot->percentFull();
+    }
+  }
+  return totalFull / static_cast<float>(pages.size() * numPlots);
+}
+
 void Atlas::setLastUseToken(const PlotLocator& plotLocator, AtlasToken token) {
   auto plotIndex = plotLocator.plotIndex();
   DEBUG_ASSERT(plotIndex < numPlots);
@@ -41,6 +41,12 @@ class Atlas {
     return textureProxies;
   }
 
+  /**
+   * Returns the fraction of the area of the active pages covered by cells, or 0 if no page is
+   * active.
+   */
+  float occupancy() const;
+
   void compact(AtlasToken);
 
   //To ensure the atlas does not evict a given entry, the client must set the use token
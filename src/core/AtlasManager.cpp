@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "AtlasManager.h"
+#include <cmath>
 #include "core/utils/PixelFormatUtil.h"
 #include "tgfx/core/Size.h"
 
@@ -63,13 +64,27 @@ Atlas* AtlasManager::getAtlas(MaskFormat maskFormat) const {
 
 bool AtlasManager::addCellToAtlas(const AtlasCell& cell, AtlasToken nextFlushToken,
                                   AtlasLocator* atlasLocator) const {
-  return getAtlas(cell.maskFormat)->addToAtlas(cell, nextFlushToken, atlasLocator);
+  if (!getAtlas(cell.maskFormat)->addToAtlas(cell, nextFlushToken, atlasLocator)) {
+    return false;
+  }
+  auto bytesPerPixel = cell.maskFormat == MaskFormat::A8 ? 1u : 4u;
+  _addedCellCount++;
+  _addedCellBytes += static_cast<size_t>(cell.width) * cell.height * bytesPerPixel;
+  return true;
 }
 
 bool AtlasManager::hasGlyph(MaskFormat maskFormat, const AtlasGlyph* glyph) const {
   return this->getAtlas(maskFormat)->hasCell(glyph->atlasLocator.plotLocator());
 }
 
+size_t AtlasManager::occupancy(MaskFormat maskFormat) const {
+  auto& atlas = atlases[MaskFormatToAtlasIndex(maskFormat)];
+  if (atlas == nullptr) {
+    return 0;
+  }
+  return static_cast<size_t>(std::round(atlas->occupancy() * 100.0f));
+}
+
 void AtlasManager::setPlotUseToken(PlotUseUpdater& plotUseUpdater, const PlotLocator& plotLocator,
                                    MaskFormat maskFormat, AtlasToken useToken) const {
   if (plotUseUpdater.add(plotLocator)) {
@@ -35,6 +35,26 @@ class AtlasManager : public AtlasGenerationCounter {
 
   bool addCellToAtlas(const AtlasCell& cell, AtlasToken nextFlushToken, AtlasLocator*) const;
 
+  /**
+   * Returns the number of cells added to the atlases so far, which equals the number of glyphs
+   * that have been rasterized.
+   */
+  size_t addedCellCount() const {
+    return _addedCellCount;
+  }
+
+  /**
+   * Returns the total number of bytes of all cells added to the atlases so far.
+   */
+  size_t addedCellBytes() const {
+    return _addedCellBytes;
+  }
+
+  /**
+   * Returns the percentage (0-100) of the allocated pages of the given atlas covered by cells.
+   */
+  size_t occupancy(MaskFormat maskFormat) const;
+
   void setPlotUseToken(PlotUseUpdater&, const PlotLocator&, MaskFormat, AtlasToken) const;
 
   void preFlush() {
@@ -56,5 +76,7 @@ class AtlasManager : public AtlasGenerationCounter {
   Context* context = nullptr;
   std::unique_ptr<Atlas> atlases[MaskFormatCount];
   AtlasTokenTracker atlasTokenTracker = {};
+  mutable size_t _addedCellCount = 0;
+  mutable size_t _addedCellBytes = 0;
 };
 }  // namespace tgfx
@@ -0,0 +1,35 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "AtlasShapeCache.h"
+
+namespace tgfx {
+AtlasGlyph* AtlasShapeCache::findOrCreateGlyph(const UniqueKey& key) {
+  if (auto iter = glyphMap.find(key); iter != glyphMap.end()) {
+    lruList.splice(lruList.begin(), lruList, iter->second);
+    return &iter->second->glyph;
+  }
+  if (lruList.size() >= GlyphCountLimit) {
+    glyphMap.erase(lruList.back().key);
+    lruList.pop_back();
+  }
+  lruList.push_front({key, {}});
+  glyphMap.emplace(key, lruList.begin());
+  return &lruList.front().glyph;
+}
+}  // namespace tgfx
@@ -0,0 +1,59 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <list>
+#include "core/AtlasTypes.h"
+#include "gpu/resources/ResourceKey.h"
+
+namespace tgfx {
+/**
+ * AtlasShapeCache remembers where the coverage masks of small shapes live in the A8 atlas, so that
+ * a shape drawn again with the same transform can reuse its atlas cell across frames. Entries are
+ * keyed by the shape's unique key combined with the draw matrix, of which only the subpixel part of
+ * the translation is kept, and are purged in least-recently-used order. Whether an entry is still
+ * resident in the atlas must be checked with AtlasManager::hasGlyph() before using its locator.
+ */
+class AtlasShapeCache {
+ public:
+  /**
+   * Returns the atlas entry for the given key, creating an empty one if it does not exist yet.
+   * The returned pointer stays valid until the next call to findOrCreateGlyph().
+   */
+  AtlasGlyph* findOrCreateGlyph(const UniqueKey& key);
+
+  /**
+   * Returns the number of entries in the cache.
+   */
+  size_t glyphCount() const {
+    return lruList.size();
+  }
+
+ private:
+  static constexpr size_t GlyphCountLimit = 4096;
+
+  struct Entry {
+    UniqueKey key = {};
+    AtlasGlyph glyph = {};
+  };
+
+  ResourceKeyMap<std::list<Entry>::iterator> glyphMap = {};
+  std::list<Entry> lruList = {};
+};
+}  // namespace tgfx
@@ -245,6 +245,13 @@ class Plot {
 
   void resetRects();
 
+  /**
+   * Returns the fraction of the plot area covered by the cells added so far.
+   */
+  float percentFull() const {
+    return rectPack.percentFull();
+  }
+
   AtlasToken lastUseToken() const {
     return _lastUseToken;
   }
@@ -0,0 +1,57 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CompressedBuffer.h"
+#include "core/utils/BlockCompression.h"
+#include "core/utils/Log.h"
+#include "core/utils/PixelFormatUtil.h"
+#include "gpu/resources/TextureView.h"
+#include "tgfx/core/Buffer.h"
+#include "tgfx/gpu/Context.h"
+#include "tgfx/gpu/GPU.h"
+
+namespace tgfx {
+std::shared_ptr<CompressedBuffer> CompressedBuffer::Make(int width, int height, PixelFormat format,
+                                                         std::shared_ptr<Data> data,
+                                                         std::shared_ptr<ColorSpace> colorSpace) {
+  if (width <= 0 || height <= 0 || !IsCompressedPixelFormat(format) || data == nullptr ||
+      data->size() < PixelFormatDataSize(format, width, height)) {
+    return nullptr;
+  }
+  return std::shared_ptr<CompressedBuffer>(
+      new CompressedBuffer(width, height, format, std::move(data), std::move(colorSpace)));
+}
+
+std::shared_ptr<TextureView> CompressedBuffer::onMakeTexture(Context* context,
+                                                             bool mipmapped) const {
+  // Compressed textures are uploaded without mipmaps, since the GPU can not generate them for
+  // compressed formats.
+  if (IsCompressedFormatSupported(context->gpu()->features(), _format)) {
+    return TextureView::MakeCompressed(context, _width, _height, _data->data(), _data->size(),
+                                       _format);
+  }
+  auto rowBytes = static_cast<size_t>(_width) * 4;
+  Buffer buffer(rowBytes * static_cast<size_t>(_height));
+  if (buffer.isEmpty() ||
+      !DecodeCompressedBlocks(_format, _data->data(), _width, _height, buffer.data(), rowBytes)) {
+    LOGE("CompressedBuffer::onMakeTexture() The compressed format is not supported!");
+    return nullptr;
+  }
+  return TextureView::MakeRGBA(context, _width, _height, buffer.data(), rowBytes, mipmapped);
+}
+}  // namespace tgfx
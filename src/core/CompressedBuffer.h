@@ -0,0 +1,88 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "tgfx/core/Data.h"
+#include "tgfx/core/ImageBuffer.h"
+#include "tgfx/gpu/PixelFormat.h"
+
+namespace tgfx {
+/**
+ * CompressedBuffer holds the 4x4 blocks of an image in a GPU block-compressed format, such as
+ * ETC2, BC or ASTC. The blocks are uploaded to the GPU untouched if the format is supported by the
+ * current device. Otherwise, they are decoded into RGBA pixels on the CPU before uploading. Like
+ * other textures, the color channels of formats with alpha must be premultiplied.
+ */
+class CompressedBuffer : public ImageBuffer {
+ public:
+  /**
+   * Creates a CompressedBuffer from the tightly packed blocks of the specified format. Returns
+   * nullptr if the format is not a compressed one or the data is too small for the given size.
+   */
+  static std::shared_ptr<CompressedBuffer> Make(int width, int height, PixelFormat format,
+                                                std::shared_ptr<Data> data,
+                                                std::shared_ptr<ColorSpace> colorSpace = nullptr);
+
+  int width() const override {
+    return _width;
+  }
+
+  int height() const override {
+    return _height;
+  }
+
+  bool isAlphaOnly() const override {
+    return false;
+  }
+
+  const std::shared_ptr<ColorSpace>& colorSpace() const override {
+    return _colorSpace;
+  }
+
+  /**
+   * Returns the compressed format of the blocks.
+   */
+  PixelFormat format() const {
+    return _format;
+  }
+
+  /**
+   * Returns the compressed blocks.
+   */
+  const std::shared_ptr<Data>& data() const {
+    return _data;
+  }
+
+ protected:
+  std::shared_ptr<TextureView> onMakeTexture(Context* context, bool mipmapped) const override;
+
+ private:
+  int _width = 0;
+  int _height = 0;
+  PixelFormat _format = PixelFormat::Unknown;
+  std::shared_ptr<Data> _data = nullptr;
+  std::shared_ptr<ColorSpace> _colorSpace = nullptr;
+
+  CompressedBuffer(int width, int height, PixelFormat format, std::shared_ptr<Data> data,
+                   std::shared_ptr<ColorSpace> colorSpace)
+      : _width(width), _height(height), _format(format), _data(std::move(data)),
+        _colorSpace(std::move(colorSpace)) {
+  }
+};
+}  // namespace tgfx
@@ -19,6 +19,12 @@
 #include "tgfx/core/Data.h"
 #include <cstring>
 #include "tgfx/core/Stream.h"
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace tgfx {
 std::shared_ptr<Data> Data::MakeFromFile(const std::string& filePath) {
@@ -31,10 +37,43 @@ std::shared_ptr<Data> Data::MakeFromFile(const std::string& filePath) {
     return nullptr;
   }
   stream->read(buffer, stream->size());
-  auto data = new Data(buffer, stream->size(), Data::DeleteProc, nullptr);
-  return std::shared_ptr<Data>(data);
+  return std::shared_ptr<Data>(new Data(buffer, stream->size(), Data::DeleteProc, nullptr));
 }
 
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+static void UnmapProc(const void* data, void* context) {
+  munmap(const_cast<void*>(data), reinterpret_cast<size_t>(context));
+}
+
+std::shared_ptr<Data> Data::MakeFromFileMapping(const std::string& filePath) {
+  // Paths with a custom protocol are resolved by the registered StreamFactory instead.
+  if (filePath.empty() || filePath.find("://") != std::string::npos) {
+    return nullptr;
+  }
+  auto fd = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat fileStat = {};
+  if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) || fileStat.st_size <= 0) {
+    close(fd);
+    return nullptr;
+  }
+  auto length = static_cast<size_t>(fileStat.st_size);
+  auto address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after the file descriptor is closed.
+  close(fd);
+  if (address == MAP_FAILED) {
+    return nullptr;
+  }
+  return MakeAdopted(address, length, UnmapProc, reinterpret_cast<void*>(length));
+}
+#else
+std::shared_ptr<Data> Data::MakeFromFileMapping(const std::string&) {
+  return nullptr;
+}
+#endif
+
 std::shared_ptr<Data> Data::MakeWithCopy(const void* bytes, size_t length) {
   if (length == 0) {
     return MakeEmpty();
@@ -0,0 +1,153 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "DistanceFieldRasterizer.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "tgfx/core/Pixmap.h"
+
+namespace tgfx {
+static constexpr float INFINITE_DISTANCE = 1e20f;
+
+// Computes the exact 1D squared Euclidean distance transform of the samples in place, using the
+// lower envelope of parabolas (Felzenszwalb and Huttenlocher). The buffers must hold at least
+// length samples, and zeros must hold length + 1 samples.
+static void TransformLine(float* grid, size_t start, size_t stride, size_t length, float* samples,
+                          int* vertices, float* zeros) {
+  for (size_t i = 0; i < length; i++) {
+    samples[i] = grid[start + i * stride];
+  }
+  size_t k = 0;
+  vertices[0] = 0;
+  zeros[0] = -INFINITE_DISTANCE;
+  zeros[1] = INFINITE_DISTANCE;
+  for (size_t q = 1; q < length; q++) {
+    auto fq = samples[q] + static_cast<float>(q * q);
+    float s = 0.0f;
+    while (true) {
+      auto r = static_cast<size_t>(vertices[k]);
+      s = (fq - samples[r] - static_cast<float>(r * r)) / static_cast<float>(2 * (q - r));
+      if (s > zeros[k] || k == 0) {
+        break;
+      }
+      k--;
+    }
+    if (s <= zeros[k]) {
+      // Only reachable when k is 0: the new parabola replaces the first one.
+      vertices[0] = static_cast<int>(q);
+      zeros[0] = -INFINITE_DISTANCE;
+      zeros[1] = INFINITE_DISTANCE;
+      continue;
+    }
+    k++;
+    vertices[k] = static_cast<int>(q);
+    zeros[k] = s;
+    zeros[k + 1] = INFINITE_DISTANCE;
+  }
+  k = 0;
+  for (size_t q = 0; q < length; q++) {
+    auto position = static_cast<float>(q);
+    while (zeros[k + 1] < position) {
+      k++;
+    }
+    auto r = static_cast<float>(vertices[k]);
+    grid[start + q * stride] = (position - r) * (position - r) + samples[vertices[k]];
+  }
+}
+
+static void TransformGrid(std::vector<float>& grid, size_t width, size_t height) {
+  auto length = std::max(width, height);
+  std::vector<float> samples(length);
+  std::vector<int> vertices(length);
+  std::vector<float> zeros(length + 1);
+  for (size_t x = 0; x < width; x++) {
+    TransformLine(grid.data(), x, width, height, samples.data(), vertices.data(), zeros.data());
+  }
+  for (size_t y = 0; y < height; y++) {
+    TransformLine(grid.data(), y * width, 1, width, samples.data(), vertices.data(), zeros.data());
+  }
+}
+
+std::shared_ptr<DistanceFieldRasterizer> DistanceFieldRasterizer::MakeFrom(
+    std::shared_ptr<ImageCodec> source) {
+  if (source == nullptr || !source->isAlphaOnly()) {
+    return nullptr;
+  }
+  return std::make_shared<DistanceFieldRasterizer>(std::move(source));
+}
+
+DistanceFieldRasterizer::DistanceFieldRasterizer(std::shared_ptr<ImageCodec> source)
+    : ImageCodec(source->width() + 2 * Padding, source->height() + 2 * Padding),
+      source(std::move(source)) {
+}
+
+bool DistanceFieldRasterizer::onReadPixels(ColorType colorType, AlphaType alphaType,
+                                           size_t dstRowBytes,
+                                           std::shared_ptr<ColorSpace> dstColorSpace,
+                                           void* dstPixels) const {
+  auto sourceWidth = static_cast<size_t>(source->width());
+  auto sourceHeight = static_cast<size_t>(source->height());
+  std::vector<uint8_t> mask(sourceWidth * sourceHeight);
+  auto maskInfo = ImageInfo::Make(source->width(), source->height(), ColorType::ALPHA_8,
+                                  AlphaType::Premultiplied, sourceWidth);
+  if (!source->readPixels(maskInfo, mask.data())) {
+    return false;
+  }
+  auto fieldWidth = static_cast<size_t>(width());
+  auto fieldHeight = static_cast<size_t>(height());
+  auto padding = static_cast<size_t>(Padding);
+  // Squared distances to the nearest pixel inside (toInside) and outside (toOutside) the shape.
+  // Partially covered pixels start with a sub-pixel estimate of the distance to the edge.
+  std::vector<float> toInside(fieldWidth * fieldHeight, INFINITE_DISTANCE);
+  std::vector<float> toOutside(fieldWidth * fieldHeight, 0.0f);
+  for (size_t y = 0; y < sourceHeight; y++) {
+    auto maskRow = mask.data() + y * sourceWidth;
+    auto fieldRow = (y + padding) * fieldWidth + padding;
+    for (size_t x = 0; x < sourceWidth; x++) {
+      auto alpha = static_cast<float>(maskRow[x]) / 255.0f;
+      if (alpha <= 0.0f) {
+        continue;
+      }
+      auto index = fieldRow + x;
+      if (alpha >= 1.0f) {
+        toInside[index] = 0.0f;
+        toOutside[index] = INFINITE_DISTANCE;
+      } else {
+        auto distance = 0.5f - alpha;
+        toInside[index] = distance > 0.0f ? distance * distance : 0.0f;
+        toOutside[index] = distance < 0.0f ? distance * distance : 0.0f;
+      }
+    }
+  }
+  TransformGrid(toInside, fieldWidth, fieldHeight);
+  TransformGrid(toOutside, fieldWidth, fieldHeight);
+  std::vector<uint8_t> field(fieldWidth * fieldHeight);
+  auto scale = 0.5f / static_cast<float>(Padding);
+  for (size_t i = 0; i < field.size(); i++) {
+    auto distance = std::sqrt(toOutside[i]) - std::sqrt(toInside[i]);
+    auto value = 0.5f + distance * scale;
+    field[i] = static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+  }
+  auto fieldInfo = ImageInfo::Make(width(), height(), ColorType::ALPHA_8, AlphaType::Premultiplied,
+                                   fieldWidth);
+  auto dstInfo = ImageInfo::Make(width(), height(), colorType, alphaType, dstRowBytes,
+                                 std::move(dstColorSpace));
+  return Pixmap(fieldInfo, field.data()).readPixels(dstInfo, dstPixels);
+}
+}  // namespace tgfx
@@ -0,0 +1,61 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "tgfx/core/ImageCodec.h"
+
+namespace tgfx {
+/**
+ * A Rasterizer that converts the alpha mask of another codec into a signed distance field. The
+ * output is an alpha-only image padded by Padding pixels on each side, where a value of 0.5 lies on
+ * the edge of the shape, and the value changes by 0.5 / Padding per pixel away from the edge,
+ * increasing towards the inside.
+ */
+class DistanceFieldRasterizer : public ImageCodec {
+ public:
+  /**
+   * The number of pixels added around the source mask, which is also the largest distance that the
+   * field can represent on either side of the edge.
+   */
+  static constexpr int Padding = 6;
+
+  /**
+   * Creates a new DistanceFieldRasterizer from an alpha-only source codec. Returns nullptr if the
+   * source is null or not alpha-only.
+   */
+  static std::shared_ptr<DistanceFieldRasterizer> MakeFrom(std::shared_ptr<ImageCodec> source);
+
+  explicit DistanceFieldRasterizer(std::shared_ptr<ImageCodec> source);
+
+  bool isAlphaOnly() const override {
+    return true;
+  }
+
+  bool asyncSupport() const override {
+    return source->asyncSupport();
+  }
+
+ protected:
+  bool onReadPixels(ColorType colorType, AlphaType alphaType, size_t dstRowBytes,
+                    std::shared_ptr<ColorSpace> dstColorSpace, void* dstPixels) const override;
+
+ private:
+  std::shared_ptr<ImageCodec> source = nullptr;
+};
+}  // namespace tgfx
@@ -29,9 +29,12 @@ namespace tgfx {
  */
 class YUVBuffer : public ImageBuffer {
  public:
-  YUVBuffer(std::shared_ptr<YUVData> data, YUVFormat format, YUVColorSpace yuvColorSpace)
+  YUVBuffer(std::shared_ptr<YUVData> data, YUVFormat format, YUVColorSpace yuvColorSpace,
+            std::shared_ptr<ColorSpace> colorSpace = nullptr)
       : data(std::move(data)), _yuvColorSpace(yuvColorSpace),
-        _colorSpace(MakeColorSpaceFromYUVColorSpace(yuvColorSpace)), format(format) {
+        _colorSpace(colorSpace ? std::move(colorSpace)
+                               : MakeColorSpaceFromYUVColorSpace(yuvColorSpace)),
+        format(format) {
   }
 
   int width() const override {
@@ -85,6 +88,16 @@ std::shared_ptr<ImageBuffer> ImageBuffer::MakeI420(std::shared_ptr<YUVData> yuvD
   return std::make_shared<YUVBuffer>(std::move(yuvData), YUVFormat::I420, colorSpace);
 }
 
+std::shared_ptr<ImageBuffer> ImageBuffer::MakeI420(std::shared_ptr<YUVData> yuvData,
+                                                   YUVColorSpace yuvColorSpace,
+                                                   std::shared_ptr<ColorSpace> colorSpace) {
+  if (yuvData == nullptr || yuvData->planeCount() != YUVData::I420_PLANE_COUNT) {
+    return nullptr;
+  }
+  return std::make_shared<YUVBuffer>(std::move(yuvData), YUVFormat::I420, yuvColorSpace,
+                                     std::move(colorSpace));
+}
+
 std::shared_ptr<ImageBuffer> ImageBuffer::MakeNV12(std::shared_ptr<YUVData> yuvData,
                                                    YUVColorSpace colorSpace) {
   if (yuvData == nullptr || yuvData->planeCount() != YUVData::NV12_PLANE_COUNT) {
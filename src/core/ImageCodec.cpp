@@ -19,6 +19,7 @@
 #include "tgfx/core/ImageCodec.h"
 #include "BoxFilterDownsample.h"
 #include "core/PixelBuffer.h"
+#include "core/codecs/Ktx2Codec.h"
 #include "core/utils/MathExtra.h"
 #include "core/utils/USE.h"
 #include "core/utils/WeakMap.h"
@@ -48,6 +49,30 @@ static size_t GetPaddingAlignment16(size_t size) {
   return (16 - remainder) & 0xF;
 }
 
+// Creates a codec with the built-in decoders for the given encoded bytes.
+static std::shared_ptr<ImageCodec> MakeBuiltinCodec(const std::shared_ptr<Data>& imageBytes) {
+  std::shared_ptr<ImageCodec> codec = nullptr;
+  if (Ktx2Codec::IsKtx2(imageBytes)) {
+    codec = Ktx2Codec::MakeFrom(imageBytes);
+  }
+#ifdef TGFX_USE_WEBP_DECODE
+  if (codec == nullptr && WebpCodec::IsWebp(imageBytes)) {
+    codec = WebpCodec::MakeFrom(imageBytes);
+  }
+#endif
+#ifdef TGFX_USE_PNG_DECODE
+  if (codec == nullptr && PngCodec::IsPng(imageBytes)) {
+    codec = PngCodec::MakeFrom(imageBytes);
+  }
+#endif
+#ifdef TGFX_USE_JPEG_DECODE
+  if (codec == nullptr && JpegCodec::IsJpeg(imageBytes)) {
+    codec = JpegCodec::MakeFrom(imageBytes);
+  }
+#endif
+  return codec;
+}
+
 std::shared_ptr<ImageCodec> ImageCodec::MakeFrom(const std::string& filePath) {
   static WeakMap<std::string, ImageCodec> imageCodecMap = {};
   if (filePath.empty()) {
@@ -57,28 +82,39 @@ std::shared_ptr<ImageCodec> ImageCodec::MakeFrom(const std::string& filePath) {
     return cached;
   }
   std::shared_ptr<ImageCodec> codec = nullptr;
-  auto stream = Stream::MakeFromFile(filePath);
-  if (stream && stream->size() > 14) {
-    Buffer buffer(14);
-    if (stream->read(buffer.data(), 14) == 14) {
-      auto data = buffer.release();
+  // The built-in codecs parse the header of a mapped file in place, which only touches the first
+  // pages of the file, and decode it later without copying the file into heap memory.
+  auto fileData = Data::MakeFromFileMapping(filePath);
+  if (fileData != nullptr) {
+    codec = MakeBuiltinCodec(fileData);
+  } else {
+    auto stream = Stream::MakeFromFile(filePath);
+    if (stream && stream->size() > 14) {
+      Buffer buffer(14);
+      if (stream->read(buffer.data(), 14) == 14) {
+        auto data = buffer.release();
+        if (Ktx2Codec::IsKtx2(data)) {
+          codec = Ktx2Codec::MakeFrom(filePath);
+        }
+
 #ifdef TGFX_USE_WEBP_DECODE
-      if (WebpCodec::IsWebp(data)) {
-        codec = WebpCodec::MakeFrom(filePath);
-      }
+        if (codec == nullptr && WebpCodec::IsWebp(data)) {
+          codec = WebpCodec::MakeFrom(filePath);
+        }
 #endif
 
 #ifdef TGFX_USE_PNG_DECODE
-      if (codec == nullptr && PngCodec::IsPng(data)) {
-        codec = PngCodec::MakeFrom(filePath);
-      }
+        if (codec == nullptr && PngCodec::IsPng(data)) {
+          codec = PngCodec::MakeFrom(filePath);
+        }
 #endif
 
 #ifdef TGFX_USE_JPEG_DECODE
-      if (codec == nullptr && JpegCodec::IsJpeg(data)) {
-        codec = JpegCodec::MakeFrom(filePath);
-      }
+        if (codec == nullptr && JpegCodec::IsJpeg(data)) {
+          codec = JpegCodec::MakeFrom(filePath);
+        }
 #endif
+      }
     }
   }
   if (codec == nullptr) {
@@ -97,22 +133,7 @@ std::shared_ptr<ImageCodec> ImageCodec::MakeFrom(std::shared_ptr<Data> imageByte
   if (imageBytes == nullptr || imageBytes->size() == 0) {
     return nullptr;
   }
-  std::shared_ptr<ImageCodec> codec = nullptr;
-#ifdef TGFX_USE_WEBP_DECODE
-  if (WebpCodec::IsWebp(imageBytes)) {
-    codec = WebpCodec::MakeFrom(imageBytes);
-  }
-#endif
-#ifdef TGFX_USE_PNG_DECODE
-  if (PngCodec::IsPng(imageBytes)) {
-    codec = PngCodec::MakeFrom(imageBytes);
-  }
-#endif
-#ifdef TGFX_USE_JPEG_DECODE
-  if (JpegCodec::IsJpeg(imageBytes)) {
-    codec = JpegCodec::MakeFrom(imageBytes);
-  }
-#endif
+  auto codec = MakeBuiltinCodec(imageBytes);
   if (codec == nullptr) {
     codec = MakeNativeCodec(imageBytes);
   }
@@ -157,12 +178,39 @@ std::pair<int, int> ImageCodec::getScaledDimensions(float scale) const {
 }
 
 bool ImageCodec::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
-  if (dstInfo.width() > width() || dstInfo.height() > height()) {
+  return readRegionPixels(Rect::MakeWH(width(), height()), dstInfo, dstPixels);
+}
+
+bool ImageCodec::readPixels(const Rect& srcRect, const ImageInfo& dstInfo, void* dstPixels) const {
+  auto region = srcRect;
+  region.roundOut();
+  if (region.isEmpty() || !Rect::MakeWH(width(), height()).contains(region)) {
     return false;
   }
-  if (dstInfo.width() == width() && dstInfo.height() == height()) {
-    return onReadPixels(dstInfo.colorType(), dstInfo.alphaType(), dstInfo.rowBytes(),
-                        dstInfo.colorSpace(), dstPixels);
+  if (region.width() == static_cast<float>(width()) &&
+      region.height() == static_cast<float>(height())) {
+    return readPixels(dstInfo, dstPixels);
+  }
+  return readRegionPixels(region, dstInfo, dstPixels);
+}
+
+bool ImageCodec::readRegionPixels(const Rect& region, const ImageInfo& dstInfo,
+                                  void* dstPixels) const {
+  auto regionWidth = static_cast<int>(region.width());
+  auto regionHeight = static_cast<int>(region.height());
+  if (dstInfo.width() > regionWidth || dstInfo.height() > regionHeight) {
+    return false;
+  }
+  auto isFullImage = regionWidth == width() && regionHeight == height();
+  auto decode = [&](ColorType colorType, size_t rowBytes, void* pixels) {
+    if (isFullImage) {
+      return onReadPixels(colorType, dstInfo.alphaType(), rowBytes, dstInfo.colorSpace(), pixels);
+    }
+    return onReadRegion(region, colorType, dstInfo.alphaType(), rowBytes, dstInfo.colorSpace(),
+                        pixels);
+  };
+  if (dstInfo.width() == regionWidth && dstInfo.height() == regionHeight) {
+    return decode(dstInfo.colorType(), dstInfo.rowBytes(), dstPixels);
   }
 
   Buffer buffer = {};
@@ -170,11 +218,11 @@ bool ImageCodec::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
   auto dstData = dstPixels;
   auto dstImageInfo = dstInfo;
   auto colorType = dstInfo.colorType();
-  auto srcRowBytes = dstInfo.bytesPerPixel() * static_cast<size_t>(width());
+  auto srcRowBytes = dstInfo.bytesPerPixel() * static_cast<size_t>(regionWidth);
   if (dstInfo.colorType() != ColorType::RGBA_8888 && dstInfo.colorType() != ColorType::BGRA_8888 &&
       dstInfo.colorType() != ColorType::ALPHA_8 && dstInfo.colorType() != ColorType::Gray_8) {
     colorType = ColorType::RGBA_8888;
-    srcRowBytes = ImageInfo::GetBytesPerPixel(colorType) * static_cast<size_t>(width());
+    srcRowBytes = ImageInfo::GetBytesPerPixel(colorType) * static_cast<size_t>(regionWidth);
     dstImageInfo = dstInfo.makeColorType(colorType);
     auto dstRowBytes = dstImageInfo.rowBytes();
     if (dstRowBytes % 16) {
@@ -188,17 +236,15 @@ bool ImageCodec::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
     dstData = dstTempBuffer.bytes();
   }
   srcRowBytes = srcRowBytes + GetPaddingAlignment16(srcRowBytes);
-  if (!buffer.alloc(srcRowBytes * static_cast<size_t>(height()))) {
+  if (!buffer.alloc(srcRowBytes * static_cast<size_t>(regionHeight))) {
     return false;
   }
-  auto result = onReadPixels(colorType, dstInfo.alphaType(), srcRowBytes, dstInfo.colorSpace(),
-                             buffer.data());
-  if (!result) {
+  if (!decode(colorType, srcRowBytes, buffer.data())) {
     return false;
   }
   auto isOneComponent = dstImageInfo.colorType() == ColorType::Gray_8 ||
                         dstImageInfo.colorType() == ColorType::ALPHA_8;
-  auto inputLayout = PixelLayout{width(), height(), static_cast<int>(srcRowBytes)};
+  auto inputLayout = PixelLayout{regionWidth, regionHeight, static_cast<int>(srcRowBytes)};
   auto outputLayout = PixelLayout{dstImageInfo.width(), dstImageInfo.height(),
                                   static_cast<int>(dstImageInfo.rowBytes())};
   BoxFilterDownsample(buffer.data(), inputLayout, dstData, outputLayout, isOneComponent);
@@ -208,6 +254,25 @@ bool ImageCodec::readPixels(const ImageInfo& dstInfo, void* dstPixels) const {
   return true;
 }
 
+bool ImageCodec::onReadRegion(const Rect& srcRect, ColorType colorType, AlphaType alphaType,
+                              size_t dstRowBytes, std::shared_ptr<ColorSpace> dstColorSpace,
+                              void* dstPixels) const {
+  auto info = ImageInfo::Make(width(), height(), colorType, alphaType, 0, dstColorSpace);
+  Buffer buffer = {};
+  if (info.isEmpty() || !buffer.alloc(info.byteSize())) {
+    return false;
+  }
+  if (!onReadPixels(colorType, alphaType, info.rowBytes(), dstColorSpace, buffer.data())) {
+    return false;
+  }
+  auto dstInfo = ImageInfo::Make(static_cast<int>(srcRect.width()),
+                                 static_cast<int>(srcRect.height()), colorType, alphaType,
+                                 dstRowBytes, std::move(dstColorSpace));
+  return Pixmap(info, buffer.data())
+      .readPixels(dstInfo, dstPixels, static_cast<int>(srcRect.left),
+                  static_cast<int>(srcRect.top));
+}
+
 std::shared_ptr<ImageBuffer> ImageCodec::onMakeBuffer(bool tryHardware) const {
   auto pixelBuffer = PixelBuffer::Make(width(), height(), isAlphaOnly(), tryHardware, colorSpace());
   if (pixelBuffer == nullptr) {
@@ -19,7 +19,10 @@
 #include "tgfx/core/Picture.h"
 #include "core/ClipStack.h"
 #include "core/MeasureContext.h"
+#include "core/PictureBBH.h"
+#include "core/PictureReader.h"
 #include "core/PictureRecords.h"
+#include "core/PictureWriter.h"
 #include "core/shaders/ImageShader.h"
 #include "core/utils/AtomicCache.h"
 #include "core/utils/BlockAllocator.h"
@@ -35,6 +38,12 @@ Picture::Picture(std::unique_ptr<BlockBuffer> buffer,
     : blockBuffer(std::move(buffer)), records(std::move(recordList)), drawCount(drawCount) {
   DEBUG_ASSERT(blockBuffer != nullptr);
   DEBUG_ASSERT(!records.empty());
+  Rect pictureBounds = {};
+  bbh = PictureBBH::Make(records, drawCount, &pictureBounds);
+  if (bbh != nullptr) {
+    // The hierarchy measures every draw record, so the bounds come for free.
+    AtomicCacheSet(bounds, &pictureBounds);
+  }
   bool hasInverseClip = true;
   for (auto& record : records) {
     if (record->hasUnboundedFill(hasInverseClip)) {
@@ -44,12 +53,27 @@ Picture::Picture(std::unique_ptr<BlockBuffer> buffer,
   }
 }
 
+Picture::Picture(std::unique_ptr<PictureReader> pictureReader, size_t drawCount,
+                 bool hasUnboundedFill)
+    : reader(std::move(pictureReader)), drawCount(drawCount), _hasUnboundedFill(hasUnboundedFill) {
+  DEBUG_ASSERT(reader != nullptr);
+  AtomicCacheSet(bounds, &reader->bounds());
+}
+
+std::shared_ptr<Picture> Picture::MakeFrom(std::shared_ptr<Data> data) {
+  return PictureReader::MakePicture(std::move(data));
+}
+
 Picture::~Picture() {
   // Make sure the records are cleared before the block data is destroyed.
   records.clear();
   AtomicCacheReset(bounds);
 }
 
+std::shared_ptr<Data> Picture::serialize() const {
+  return PictureWriter::Serialize(this);
+}
+
 Rect Picture::getBounds() const {
   if (auto cachedBounds = AtomicCacheGet(bounds)) {
     return *cachedBounds;
@@ -69,9 +93,42 @@ void Picture::playback(Canvas* canvas, AbortCallback* callback) const {
 }
 
 void Picture::playback(DrawContext* drawContext, const Matrix& matrix, const ClipStack& clip,
-                       AbortCallback* callback) const {
+                       AbortCallback* callback, const Rect* cullBounds) const {
   DEBUG_ASSERT(drawContext != nullptr);
   PlaybackContext playbackContext(matrix, clip);
+  std::vector<size_t> visibleDraws = {};
+  if (getVisibleDraws(matrix, clip, cullBounds, &visibleDraws)) {
+    // State records are always played back so that each visible draw sees the same matrix, clip
+    // and brush as in a full playback.
+    auto nextDraw = visibleDraws.begin();
+    size_t drawIndex = 0;
+    for (auto& record : records) {
+      if (nextDraw == visibleDraws.end()) {
+        break;
+      }
+      if (record->type() >= PictureRecordType::DrawFill) {
+        if (drawIndex++ != *nextDraw) {
+          continue;
+        }
+        ++nextDraw;
+      }
+      if (callback && callback->abort()) {
+        break;
+      }
+      record->playback(drawContext, &playbackContext);
+    }
+    return;
+  }
+  if (reader != nullptr) {
+    reader->visit([&](const PictureRecord& record) {
+      if (callback && callback->abort()) {
+        return false;
+      }
+      record.playback(drawContext, &playbackContext);
+      return true;
+    });
+    return;
+  }
   for (auto& record : records) {
     if (callback && callback->abort()) {
       break;
@@ -80,6 +137,53 @@ void Picture::playback(DrawContext* drawContext, const Matrix& matrix, const Cli
   }
 }
 
+bool Picture::getVisibleDraws(const Matrix& matrix, const ClipStack& clip, const Rect* cullBounds,
+                              std::vector<size_t>* visibleDraws) const {
+  if (bbh == nullptr) {
+    return false;
+  }
+  Rect deviceBounds = {};
+  if (clip.state() == ClipState::Empty) {
+    visibleDraws->clear();
+    return true;
+  }
+  if (clip.state() != ClipState::WideOpen) {
+    deviceBounds = clip.bounds();
+    if (cullBounds != nullptr && !deviceBounds.intersect(*cullBounds)) {
+      visibleDraws->clear();
+      return true;
+    }
+  } else if (cullBounds != nullptr) {
+    deviceBounds = *cullBounds;
+  } else {
+    return false;
+  }
+  Matrix inverse = {};
+  if (matrix.hasPerspective() || !matrix.invert(&inverse)) {
+    return false;
+  }
+  // Anti-aliased edges may reach half a pixel outside the geometry bounds.
+  deviceBounds.outset(1.0f, 1.0f);
+  auto localBounds = inverse.mapRect(deviceBounds);
+  if (localBounds.contains(getBounds())) {
+    return false;
+  }
+  bbh->search(localBounds, visibleDraws);
+  return true;
+}
+
+void Picture::forEachRecord(const std::function<bool(const PictureRecord*)>& visitor) const {
+  if (reader != nullptr) {
+    reader->visit([&](const PictureRecord& record) { return visitor(&record); });
+    return;
+  }
+  for (auto& record : records) {
+    if (!visitor(record.get())) {
+      break;
+    }
+  }
+}
+
 // Returns a hard-edged clip rectangle. Returns false if the clip cannot be represented as a
 // hard-edged rectangle.
 static bool GetHardClipRect(const ClipStack& clip, const Matrix* matrix, Rect* clipRect) {
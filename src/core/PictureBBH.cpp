@@ -0,0 +1,139 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PictureBBH.h"
+#include <algorithm>
+#include "core/MeasureContext.h"
+#include "core/PictureRecords.h"
+#include "core/utils/Log.h"
+
+namespace tgfx {
+// The maximum number of items stored in a leaf node.
+static constexpr uint32_t MAX_LEAF_ITEMS = 4;
+
+static bool Overlaps(const Rect& a, const Rect& b) {
+  // Inclusive comparisons keep zero-area bounds, such as those of hairlines, searchable.
+  return a.left <= b.right && b.left <= a.right && a.top <= b.bottom && b.top <= a.bottom;
+}
+
+std::unique_ptr<PictureBBH> PictureBBH::Make(
+    const std::vector<PlacementPtr<PictureRecord>>& records, size_t drawCount,
+    Rect* pictureBounds) {
+  if (drawCount < MIN_DRAW_COUNT) {
+    return nullptr;
+  }
+  auto bbh = std::unique_ptr<PictureBBH>(new PictureBBH());
+  bbh->items.reserve(drawCount);
+  Rect totalBounds = {};
+  PlaybackContext playback = {};
+  bool hasInverseClip = true;
+  size_t slot = 0;
+  for (auto& record : records) {
+    auto unbounded = record->hasUnboundedFill(hasInverseClip);
+    if (record->type() < PictureRecordType::DrawFill) {
+      record->playback(nullptr, &playback);
+      continue;
+    }
+    MeasureContext context = {};
+    record->playback(&context, &playback);
+    auto bounds = context.getBounds();
+    totalBounds.join(bounds);
+    if (unbounded || record->type() == PictureRecordType::DrawFill) {
+      bbh->unboundedSlots.push_back(slot);
+    } else if (!bounds.isEmpty()) {
+      bbh->items.push_back({bounds, slot});
+    } else if (playback.clip().state() != ClipState::Empty) {
+      // The measured bounds can be empty for degenerate geometry that still produces pixels after
+      // anti-aliasing, so keep it visible instead of dropping it.
+      bbh->unboundedSlots.push_back(slot);
+    }
+    slot++;
+  }
+  DEBUG_ASSERT(slot == drawCount);
+  if (!bbh->items.empty()) {
+    bbh->nodes.reserve(2 * bbh->items.size() / MAX_LEAF_ITEMS + 1);
+    bbh->buildNodes(0, static_cast<uint32_t>(bbh->items.size()));
+  }
+  if (pictureBounds != nullptr) {
+    *pictureBounds = totalBounds;
+  }
+  return bbh;
+}
+
+uint32_t PictureBBH::buildNodes(uint32_t begin, uint32_t end) {
+  auto index = static_cast<uint32_t>(nodes.size());
+  nodes.emplace_back();
+  Rect bounds = items[begin].bounds;
+  for (auto i = begin + 1; i < end; i++) {
+    bounds.join(items[i].bounds);
+  }
+  nodes[index].bounds = bounds;
+  if (end - begin <= MAX_LEAF_ITEMS) {
+    nodes[index].begin = begin;
+    nodes[index].end = end;
+    return index;
+  }
+  // Split at the median center along the longer axis of the node bounds.
+  auto first = items.begin() + begin;
+  auto middle = items.begin() + (begin + end) / 2;
+  auto last = items.begin() + end;
+  if (bounds.width() >= bounds.height()) {
+    std::nth_element(first, middle, last, [](const Item& a, const Item& b) {
+      return a.bounds.centerX() < b.bounds.centerX();
+    });
+  } else {
+    std::nth_element(first, middle, last, [](const Item& a, const Item& b) {
+      return a.bounds.centerY() < b.bounds.centerY();
+    });
+  }
+  auto split = (begin + end) / 2;
+  buildNodes(begin, split);
+  auto right = buildNodes(split, end);
+  nodes[index].isLeaf = false;
+  nodes[index].begin = right;
+  return index;
+}
+
+void PictureBBH::search(const Rect& rect, std::vector<size_t>* result) const {
+  DEBUG_ASSERT(result != nullptr);
+  result->clear();
+  if (!nodes.empty()) {
+    std::vector<uint32_t> stack = {0};
+    while (!stack.empty()) {
+      auto index = stack.back();
+      stack.pop_back();
+      auto& node = nodes[index];
+      if (!Overlaps(node.bounds, rect)) {
+        continue;
+      }
+      if (!node.isLeaf) {
+        stack.push_back(node.begin);
+        stack.push_back(index + 1);
+        continue;
+      }
+      for (auto i = node.begin; i < node.end; i++) {
+        if (Overlaps(items[i].bounds, rect)) {
+          result->push_back(items[i].slot);
+        }
+      }
+    }
+  }
+  result->insert(result->end(), unboundedSlots.begin(), unboundedSlots.end());
+  std::sort(result->begin(), result->end());
+}
+}  // namespace tgfx
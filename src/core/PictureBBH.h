@@ -0,0 +1,80 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "core/utils/PlacementPtr.h"
+#include "tgfx/core/Rect.h"
+
+namespace tgfx {
+class PictureRecord;
+
+/**
+ * PictureBBH is a static bounding-box hierarchy over the draw records of a recorded Picture. Each
+ * draw record owns one slot, addressed by its index among the draw records of the picture. A slot
+ * is either excluded (it never draws anything, e.g. under an empty clip), unbounded (always
+ * returned) or bounded by its bounds in the picture's coordinate space, including the effects of
+ * its matrix, clip, stroke, and layer filter. Searches return slot indices in ascending order, so
+ * the drawing order is kept.
+ */
+class PictureBBH {
+ public:
+  /**
+   * Pictures with fewer draw records than this are cheaper to play back entirely.
+   */
+  static constexpr size_t MIN_DRAW_COUNT = 16;
+
+  /**
+   * Measures each draw record and builds a hierarchy over them. The union of all measured bounds
+   * is returned in pictureBounds, which matches the result of Picture::getBounds(). Returns
+   * nullptr if there are fewer than MIN_DRAW_COUNT draw records.
+   */
+  static std::unique_ptr<PictureBBH> Make(const std::vector<PlacementPtr<PictureRecord>>& records,
+                                          size_t drawCount, Rect* pictureBounds);
+
+  /**
+   * Collects the slots whose bounds intersect the given rect, plus all unbounded slots.
+   */
+  void search(const Rect& rect, std::vector<size_t>* result) const;
+
+ private:
+  struct Item {
+    Rect bounds = {};
+    size_t slot = 0;
+  };
+
+  struct Node {
+    Rect bounds = {};
+    // For leaves, the range of items. For branches, the index of the right child, while the left
+    // child always follows its parent.
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    bool isLeaf = true;
+  };
+
+  std::vector<Item> items = {};
+  std::vector<Node> nodes = {};
+  std::vector<size_t> unboundedSlots = {};
+
+  PictureBBH() = default;
+
+  uint32_t buildNodes(uint32_t begin, uint32_t end);
+};
+}  // namespace tgfx
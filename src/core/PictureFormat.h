@@ -0,0 +1,361 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "tgfx/core/Color.h"
+#include "tgfx/core/Matrix.h"
+#include "tgfx/core/Rect.h"
+
+namespace tgfx {
+/**
+ * The serialized picture format is a flat list of object definitions that follows a small header.
+ * Each definition only references definitions that appear before it, and the last definition is
+ * always the root picture. Every picture definition carries its own table of referenced objects
+ * and a compact record stream that is played back directly from the serialized bytes. All values
+ * are stored in little-endian byte order.
+ */
+static constexpr uint32_t PICTURE_FORMAT_MAGIC = 0x46504754;  // 'TGPF'
+static constexpr uint32_t PICTURE_FORMAT_VERSION = 1;
+
+/**
+ * The types of shared objects that can be defined in a serialized picture. Records reference
+ * objects by their index in the local table of the picture that contains them.
+ */
+enum class PictureObjectType : uint8_t {
+  Typeface,
+  Path,
+  Shape,
+  TextBlob,
+  Image,
+  Shader,
+  ColorFilter,
+  MaskFilter,
+  ImageFilter,
+  Clip,
+  Picture
+};
+
+static constexpr size_t PICTURE_OBJECT_TYPE_COUNT =
+    static_cast<size_t>(PictureObjectType::Picture) + 1;
+
+/**
+ * The encoding of a Matrix in the record stream. Most matrices are pure translations or
+ * scale-translations, which are stored with fewer floats.
+ */
+enum class PictureMatrixType : uint8_t { Identity, Translate, ScaleTranslate, Affine, Perspective };
+
+/**
+ * PictureBufferWriter appends primitive values to a growable byte buffer.
+ */
+class PictureBufferWriter {
+ public:
+  void writeUInt8(uint8_t value) {
+    buffer.push_back(value);
+  }
+
+  void writeBool(bool value) {
+    buffer.push_back(value ? 1 : 0);
+  }
+
+  /**
+   * Writes an unsigned integer using the variable-length LEB128 encoding, which takes a single
+   * byte for values below 128.
+   */
+  void writeVarint(uint32_t value) {
+    while (value >= 0x80) {
+      buffer.push_back(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    buffer.push_back(static_cast<uint8_t>(value));
+  }
+
+  void writeInt32(int32_t value) {
+    writeBytes(&value, sizeof(value));
+  }
+
+  void writeFloat(float value) {
+    writeBytes(&value, sizeof(value));
+  }
+
+  void writeFloats(const float* values, size_t count) {
+    writeBytes(values, count * sizeof(float));
+  }
+
+  void writePoint(const Point& point) {
+    writeFloat(point.x);
+    writeFloat(point.y);
+  }
+
+  void writeRect(const Rect& rect) {
+    writeFloat(rect.left);
+    writeFloat(rect.top);
+    writeFloat(rect.right);
+    writeFloat(rect.bottom);
+  }
+
+  void writeColor(const Color& color) {
+    writeFloat(color.red);
+    writeFloat(color.green);
+    writeFloat(color.blue);
+    writeFloat(color.alpha);
+  }
+
+  void writeMatrix(const Matrix& matrix) {
+    if (matrix.isIdentity()) {
+      writeUInt8(static_cast<uint8_t>(PictureMatrixType::Identity));
+    } else if (matrix.isTranslate()) {
+      writeUInt8(static_cast<uint8_t>(PictureMatrixType::Translate));
+      writeFloat(matrix.getTranslateX());
+      writeFloat(matrix.getTranslateY());
+    } else if (matrix.getSkewX() == 0 && matrix.getSkewY() == 0) {
+      writeUInt8(static_cast<uint8_t>(PictureMatrixType::ScaleTranslate));
+      writeFloat(matrix.getScaleX());
+      writeFloat(matrix.getScaleY());
+      writeFloat(matrix.getTranslateX());
+      writeFloat(matrix.getTranslateY());
+    } else if (!matrix.hasPerspective()) {
+      float values[6] = {};
+      matrix.get6(values);
+      writeUInt8(static_cast<uint8_t>(PictureMatrixType::Affine));
+      writeFloats(values, 6);
+    } else {
+      float values[9] = {};
+      matrix.get9(values);
+      writeUInt8(static_cast<uint8_t>(PictureMatrixType::Perspective));
+      writeFloats(values, 9);
+    }
+  }
+
+  void writeString(const std::string& text) {
+    writeVarint(static_cast<uint32_t>(text.size()));
+    writeBytes(text.data(), text.size());
+  }
+
+  void writeBytes(const void* bytes, size_t size) {
+    if (size == 0) {
+      return;
+    }
+    auto offset = buffer.size();
+    buffer.resize(offset + size);
+    memcpy(buffer.data() + offset, bytes, size);
+  }
+
+  const uint8_t* data() const {
+    return buffer.data();
+  }
+
+  size_t size() const {
+    return buffer.size();
+  }
+
+ private:
+  std::vector<uint8_t> buffer = {};
+};
+
+/**
+ * PictureBufferReader reads primitive values from a byte range without copying it. Every read is
+ * bounds-checked: once a read runs past the end of the range or meets an invalid value, the reader
+ * enters a failed state and all subsequent reads return zero values.
+ */
+class PictureBufferReader {
+ public:
+  PictureBufferReader(const uint8_t* bytes, size_t size) : bytes(bytes), size(size) {
+  }
+
+  bool isValid() const {
+    return !failed;
+  }
+
+  bool isEnd() const {
+    return position >= size;
+  }
+
+  size_t offset() const {
+    return position;
+  }
+
+  /**
+   * Reads an element count and fails if the remaining bytes cannot hold that many elements of
+   * elementSize encoded bytes each. Returns 0 on failure.
+   */
+  uint32_t readCount(size_t elementSize) {
+    auto count = readVarint();
+    if (failed || count > (size - position) / elementSize) {
+      fail();
+      return 0;
+    }
+    return count;
+  }
+
+  void fail() {
+    failed = true;
+    position = size;
+  }
+
+  uint8_t readUInt8() {
+    if (position >= size) {
+      fail();
+      return 0;
+    }
+    return bytes[position++];
+  }
+
+  bool readBool() {
+    return readUInt8() != 0;
+  }
+
+  /**
+   * Reads an enum value stored as a single byte, failing if it is greater than maxValue.
+   */
+  template <typename T>
+  T readEnum(T maxValue) {
+    auto value = readUInt8();
+    if (value > static_cast<uint8_t>(maxValue)) {
+      fail();
+      return static_cast<T>(0);
+    }
+    return static_cast<T>(value);
+  }
+
+  uint32_t readVarint() {
+    uint32_t value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      auto byte = readUInt8();
+      value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    fail();
+    return 0;
+  }
+
+  int32_t readInt32() {
+    int32_t value = 0;
+    readBytes(&value, sizeof(value));
+    return value;
+  }
+
+  float readFloat() {
+    float value = 0;
+    readBytes(&value, sizeof(value));
+    return value;
+  }
+
+  Point readPoint() {
+    auto x = readFloat();
+    auto y = readFloat();
+    return {x, y};
+  }
+
+  Rect readRect() {
+    Rect rect = {};
+    rect.left = readFloat();
+    rect.top = readFloat();
+    rect.right = readFloat();
+    rect.bottom = readFloat();
+    return rect;
+  }
+
+  Color readColor() {
+    Color color = {};
+    color.red = readFloat();
+    color.green = readFloat();
+    color.blue = readFloat();
+    color.alpha = readFloat();
+    return color;
+  }
+
+  Matrix readMatrix() {
+    Matrix matrix = {};
+    switch (readEnum(PictureMatrixType::Perspective)) {
+      case PictureMatrixType::Identity:
+        break;
+      case PictureMatrixType::Translate: {
+        auto tx = readFloat();
+        auto ty = readFloat();
+        matrix.setTranslate(tx, ty);
+        break;
+      }
+      case PictureMatrixType::ScaleTranslate: {
+        auto sx = readFloat();
+        auto sy = readFloat();
+        auto tx = readFloat();
+        auto ty = readFloat();
+        matrix.setAll(sx, 0, tx, 0, sy, ty);
+        break;
+      }
+      case PictureMatrixType::Affine: {
+        float values[6] = {};
+        readBytes(values, sizeof(values));
+        matrix.set6(values);
+        break;
+      }
+      case PictureMatrixType::Perspective: {
+        float values[9] = {};
+        readBytes(values, sizeof(values));
+        matrix.set9(values);
+        break;
+      }
+    }
+    return matrix;
+  }
+
+  std::string readString() {
+    auto length = readVarint();
+    auto text = readBytes(length);
+    if (text == nullptr) {
+      return "";
+    }
+    return {reinterpret_cast<const char*>(text), length};
+  }
+
+  /**
+   * Returns a pointer to the next size bytes and skips them, or nullptr if the range is too short.
+   */
+  const uint8_t* readBytes(size_t length) {
+    if (length > size - position) {
+      fail();
+      return nullptr;
+    }
+    auto result = bytes + position;
+    position += length;
+    return result;
+  }
+
+  bool readBytes(void* buffer, size_t length) {
+    auto source = readBytes(length);
+    if (source == nullptr) {
+      memset(buffer, 0, length);
+      return false;
+    }
+    memcpy(buffer, source, length);
+    return true;
+  }
+
+ private:
+  const uint8_t* bytes = nullptr;
+  size_t size = 0;
+  size_t position = 0;
+  bool failed = false;
+};
+}  // namespace tgfx
@@ -0,0 +1,300 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PictureOptimizer.h"
+#include <cmath>
+#include "core/MeasureContext.h"
+#include "core/PictureContext.h"
+#include "core/PictureRecords.h"
+#include "core/utils/Log.h"
+
+namespace tgfx {
+// The maximum number of opaque rects tracked while searching for occluded draws.
+static constexpr size_t MAX_OCCLUDER_COUNT = 8;
+
+enum class DrawState { Keep, Removed, MergedHead, MergedTail };
+
+struct DrawInfo {
+  const PictureRecord* record = nullptr;
+  Matrix matrix = {};
+  ClipStack clip = {};
+  Brush brush = {};
+  bool hasStroke = false;
+  bool unbounded = false;
+  Rect bounds = {};
+  Rect mergedRect = {};
+  DrawState state = DrawState::Keep;
+};
+
+static bool SameBrush(const Brush& a, const Brush& b) {
+  return a.color == b.color && a.antiAlias == b.antiAlias && a.blendMode == b.blendMode &&
+         a.shader == b.shader && a.maskFilter == b.maskFilter && a.colorFilter == b.colorFilter;
+}
+
+// Returns the local rect of a DrawRect or a zero-radius DrawRRect that is filled under a matrix
+// that keeps rects as rects.
+static bool GetFilledRect(const DrawInfo& draw, Rect* rect) {
+  if (draw.hasStroke || !draw.matrix.rectStaysRect()) {
+    return false;
+  }
+  switch (draw.record->type()) {
+    case PictureRecordType::DrawRect:
+      *rect = static_cast<const DrawRect*>(draw.record)->rect;
+      return true;
+    case PictureRecordType::DrawRRect: {
+      auto& rRect = static_cast<const DrawRRect*>(draw.record)->rRect;
+      if (!rRect.isRect()) {
+        return false;
+      }
+      *rect = rRect.rect();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+// Returns the pixel-aligned area that the draw replaces entirely with opaque pixels. Sets
+// coversAll to true if the draw replaces every pixel.
+static bool GetOpaqueCoverage(const DrawInfo& draw, Rect* coverage, bool* coversAll) {
+  if (!draw.brush.isOpaque()) {
+    return false;
+  }
+  if (draw.record->type() == PictureRecordType::DrawFill) {
+    if (draw.clip.state() != ClipState::WideOpen) {
+      return false;
+    }
+    *coversAll = true;
+    return true;
+  }
+  Rect rect = {};
+  if (!GetFilledRect(draw, &rect)) {
+    return false;
+  }
+  *coverage = draw.matrix.mapRect(rect);
+  switch (draw.clip.state()) {
+    case ClipState::WideOpen:
+      break;
+    case ClipState::Rect: {
+      // In the Rect state the only valid element is an axis-aligned rect under an identity matrix
+      // at the back of the stack.
+      auto& elements = draw.clip.elements();
+      if (elements.empty() || !elements.back().shape().isRect() ||
+          !elements.back().matrix().isIdentity()) {
+        return false;
+      }
+      if (!coverage->intersect(elements.back().shape().rect())) {
+        return false;
+      }
+      break;
+    }
+    default:
+      return false;
+  }
+  // Anti-aliased edges only cover part of their pixels, so keep the fully covered pixels only.
+  coverage->roundIn();
+  return !coverage->isEmpty();
+}
+
+static bool IsOccluded(const Rect& bounds, const std::vector<Rect>& occluders) {
+  // The margin keeps anti-aliased pixels just outside the geometry bounds, which may also show
+  // through when the picture is played back under a scale.
+  auto outsetBounds = bounds;
+  outsetBounds.outset(1.0f, 1.0f);
+  for (auto& occluder : occluders) {
+    if (occluder.contains(outsetBounds)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void AddOccluder(std::vector<Rect>* occluders, const Rect& rect) {
+  if (occluders->size() < MAX_OCCLUDER_COUNT) {
+    occluders->push_back(rect);
+    return;
+  }
+  auto area = rect.width() * rect.height();
+  auto smallest = occluders->begin();
+  for (auto iter = occluders->begin() + 1; iter != occluders->end(); ++iter) {
+    if (iter->width() * iter->height() < smallest->width() * smallest->height()) {
+      smallest = iter;
+    }
+  }
+  if (smallest->width() * smallest->height() < area) {
+    *smallest = rect;
+  }
+}
+
+// Merges two rects that share a full edge in device space. Anti-aliased rects are merged only if
+// the shared edge lies on the pixel grid, where the union renders exactly the same pixels.
+static bool MergeRects(const Rect& a, const Rect& b, const Matrix& matrix, bool antiAlias,
+                       Rect* result) {
+  auto deviceA = matrix.mapRect(a);
+  auto deviceB = matrix.mapRect(b);
+  float edge = 0.0f;
+  if (deviceA.top == deviceB.top && deviceA.bottom == deviceB.bottom) {
+    if (deviceA.right == deviceB.left) {
+      edge = deviceA.right;
+    } else if (deviceB.right == deviceA.left) {
+      edge = deviceB.right;
+    } else {
+      return false;
+    }
+  } else if (deviceA.left == deviceB.left && deviceA.right == deviceB.right) {
+    if (deviceA.bottom == deviceB.top) {
+      edge = deviceA.bottom;
+    } else if (deviceB.bottom == deviceA.top) {
+      edge = deviceB.bottom;
+    } else {
+      return false;
+    }
+  } else {
+    return false;
+  }
+  if (antiAlias && edge != std::floor(edge)) {
+    return false;
+  }
+  *result = a;
+  result->join(b);
+  return true;
+}
+
+static std::vector<DrawInfo> CollectDraws(const std::vector<PlacementPtr<PictureRecord>>& records) {
+  std::vector<DrawInfo> draws = {};
+  PlaybackContext playback = {};
+  bool hasInverseClip = true;
+  for (auto& record : records) {
+    auto unbounded = record->hasUnboundedFill(hasInverseClip);
+    if (record->type() < PictureRecordType::DrawFill) {
+      record->playback(nullptr, &playback);
+      continue;
+    }
+    DrawInfo draw = {};
+    draw.record = record.get();
+    draw.matrix = playback.matrix();
+    draw.clip = playback.clip();
+    draw.brush = playback.brush();
+    draw.hasStroke = playback.stroke() != nullptr;
+    MeasureContext context = {};
+    record->playback(&context, &playback);
+    draw.bounds = context.getBounds();
+    draw.unbounded = unbounded || record->type() == PictureRecordType::DrawFill;
+    draws.push_back(std::move(draw));
+  }
+  return draws;
+}
+
+static size_t RemoveOccludedDraws(std::vector<DrawInfo>& draws) {
+  size_t removedCount = 0;
+  std::vector<Rect> occluders = {};
+  bool coversAll = false;
+  for (auto iter = draws.rbegin(); iter != draws.rend(); ++iter) {
+    auto& draw = *iter;
+    auto drawsNothing = draw.clip.state() == ClipState::Empty || draw.brush.nothingToDraw() ||
+                        (!draw.unbounded && draw.bounds.isEmpty() && !draw.hasStroke);
+    if (coversAll || drawsNothing || (!draw.unbounded && IsOccluded(draw.bounds, occluders))) {
+      draw.state = DrawState::Removed;
+      removedCount++;
+      continue;
+    }
+    Rect coverage = {};
+    if (GetOpaqueCoverage(draw, &coverage, &coversAll) && !coversAll) {
+      AddOccluder(&occluders, coverage);
+    }
+  }
+  return removedCount;
+}
+
+static size_t MergeRectRuns(std::vector<DrawInfo>& draws) {
+  size_t mergedCount = 0;
+  DrawInfo* head = nullptr;
+  Rect runRect = {};
+  for (auto& draw : draws) {
+    if (draw.state == DrawState::Removed) {
+      continue;
+    }
+    Rect rect = {};
+    if (!GetFilledRect(draw, &rect)) {
+      head = nullptr;
+      continue;
+    }
+    if (head != nullptr && head->matrix == draw.matrix && head->clip.isSame(draw.clip) &&
+        SameBrush(head->brush, draw.brush) &&
+        MergeRects(runRect, rect, draw.matrix, draw.brush.antiAlias, &runRect)) {
+      head->state = DrawState::MergedHead;
+      head->mergedRect = runRect;
+      draw.state = DrawState::MergedTail;
+      mergedCount++;
+      continue;
+    }
+    head = &draw;
+    runRect = rect;
+  }
+  return mergedCount;
+}
+
+std::shared_ptr<Picture> PictureOptimizer::Optimize(std::shared_ptr<Picture> picture,
+                                                    PictureOptimizerStats* stats) {
+  if (stats != nullptr) {
+    *stats = {};
+  }
+  if (picture == nullptr || picture->reader != nullptr) {
+    return picture;
+  }
+  auto draws = CollectDraws(picture->records);
+  DEBUG_ASSERT(draws.size() == picture->drawCount);
+  auto removedDraws = RemoveOccludedDraws(draws);
+  auto mergedDraws = MergeRectRuns(draws);
+  if (removedDraws == 0 && mergedDraws == 0) {
+    return picture;
+  }
+  PictureContext context = {};
+  PlaybackContext playback = {};
+  auto draw = draws.begin();
+  for (auto& record : picture->records) {
+    if (record->type() < PictureRecordType::DrawFill) {
+      record->playback(nullptr, &playback);
+      continue;
+    }
+    switch (draw->state) {
+      case DrawState::Keep:
+        record->playback(&context, &playback);
+        break;
+      case DrawState::MergedHead:
+        context.drawRect(draw->mergedRect, draw->matrix, draw->clip, draw->brush, nullptr);
+        break;
+      case DrawState::Removed:
+      case DrawState::MergedTail:
+        break;
+    }
+    ++draw;
+  }
+  auto result = context.finishRecordingAsPicture();
+  if (result == nullptr) {
+    // Every draw was removed, which only happens if none of them produced any pixels.
+    return picture;
+  }
+  if (stats != nullptr) {
+    stats->removedRecords = picture->records.size() - result->records.size();
+    stats->removedDraws = removedDraws;
+    stats->mergedDraws = mergedDraws;
+  }
+  return result;
+}
+}  // namespace tgfx
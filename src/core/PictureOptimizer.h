@@ -0,0 +1,60 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "tgfx/core/Picture.h"
+
+namespace tgfx {
+/**
+ * Counters collected by PictureOptimizer::Optimize().
+ */
+struct PictureOptimizerStats {
+  /**
+   * The number of records in the source picture minus the number of records in the result.
+   */
+  size_t removedRecords = 0;
+
+  /**
+   * The number of draws dropped because they are hidden by later opaque draws or draw nothing.
+   */
+  size_t removedDraws = 0;
+
+  /**
+   * The number of draws folded into a preceding DrawRect of the same run.
+   */
+  size_t mergedDraws = 0;
+};
+
+/**
+ * PictureOptimizer rewrites a finished Picture into an equivalent one with fewer records. Draws
+ * that are entirely covered by a later opaque DrawRect or DrawFill are dropped, as are draws under
+ * an empty clip. Adjacent DrawRect or zero-radius DrawRRect records with identical state that share
+ * a pixel-aligned edge are merged into a single DrawRect. The remaining draws are re-recorded,
+ * which also removes the state records that only served the dropped draws.
+ */
+class PictureOptimizer {
+ public:
+  /**
+   * Returns the optimized picture, or the source picture itself if nothing can be removed. Pictures
+   * loaded from serialized data are returned unchanged.
+   */
+  static std::shared_ptr<Picture> Optimize(std::shared_ptr<Picture> picture,
+                                           PictureOptimizerStats* stats = nullptr);
+};
+}  // namespace tgfx
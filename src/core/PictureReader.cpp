@@ -0,0 +1,770 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "core/PictureReader.h"
+#include "core/PictureContext.h"
+#include "core/images/OrientImage.h"
+#include "core/images/SubsetImage.h"
+#include "core/utils/Log.h"
+#include "core/utils/Types.h"
+#include "tgfx/core/GradientType.h"
+#include "tgfx/core/ImageCodec.h"
+#include "tgfx/core/TextBlobBuilder.h"
+
+namespace tgfx {
+static void ReleaseDataProc(const void*, void* context) {
+  delete static_cast<std::shared_ptr<Data>*>(context);
+}
+
+static size_t GetPositionFloatCount(GlyphPositioning positioning) {
+  switch (positioning) {
+    case GlyphPositioning::Default:
+    case GlyphPositioning::Horizontal:
+      return 1;
+    case GlyphPositioning::Point:
+      return 2;
+    case GlyphPositioning::RSXform:
+      return 4;
+    case GlyphPositioning::Matrix:
+      return 6;
+  }
+  return 0;
+}
+
+/**
+ * PictureLoader decodes the object definitions of serialized data in order and builds the
+ * pictures defined in it.
+ */
+class PictureLoader {
+ public:
+  explicit PictureLoader(std::shared_ptr<Data> data)
+      : data(std::move(data)), reader(this->data->bytes(), this->data->size()) {
+  }
+
+  std::shared_ptr<Picture> load();
+
+ private:
+  std::shared_ptr<Data> data = nullptr;
+  PictureBufferReader reader;
+  PictureObjects objects = {};
+
+  template <typename T>
+  bool getObject(const std::vector<T>& list, T* result) {
+    auto index = reader.readVarint();
+    if (index >= list.size()) {
+      reader.fail();
+      return false;
+    }
+    *result = list[index];
+    return true;
+  }
+
+  template <typename T>
+  static bool AddObject(std::vector<T>* list, T object) {
+    if (object == nullptr) {
+      return false;
+    }
+    list->push_back(std::move(object));
+    return true;
+  }
+
+  // Wraps a range of the serialized data without copying it, keeping the whole data alive.
+  std::shared_ptr<Data> readSubData(size_t length);
+
+  bool readTypeface();
+  bool readPath();
+  bool readShape();
+  bool readTextBlob();
+  bool readImage();
+  bool readShader();
+  bool readColorFilter();
+  bool readMaskFilter();
+  bool readImageFilter();
+  bool readClip();
+  bool readPicture();
+};
+
+std::shared_ptr<Picture> PictureLoader::load() {
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  reader.readBytes(&magic, sizeof(magic));
+  reader.readBytes(&version, sizeof(version));
+  if (magic != PICTURE_FORMAT_MAGIC || version != PICTURE_FORMAT_VERSION) {
+    LOGE("PictureReader::MakePicture() Unsupported data format or version!");
+    return nullptr;
+  }
+  auto lastType = PictureObjectType::Typeface;
+  while (!reader.isEnd()) {
+    lastType = reader.readEnum(PictureObjectType::Picture);
+    bool success = false;
+    switch (lastType) {
+      case PictureObjectType::Typeface:
+        success = readTypeface();
+        break;
+      case PictureObjectType::Path:
+        success = readPath();
+        break;
+      case PictureObjectType::Shape:
+        success = readShape();
+        break;
+      case PictureObjectType::TextBlob:
+        success = readTextBlob();
+        break;
+      case PictureObjectType::Image:
+        success = readImage();
+        break;
+      case PictureObjectType::Shader:
+        success = readShader();
+        break;
+      case PictureObjectType::ColorFilter:
+        success = readColorFilter();
+        break;
+      case PictureObjectType::MaskFilter:
+        success = readMaskFilter();
+        break;
+      case PictureObjectType::ImageFilter:
+        success = readImageFilter();
+        break;
+      case PictureObjectType::Clip:
+        success = readClip();
+        break;
+      case PictureObjectType::Picture:
+        success = readPicture();
+        break;
+    }
+    if (!success || !reader.isValid()) {
+      LOGE("PictureReader::MakePicture() The serialized data is malformed!");
+      return nullptr;
+    }
+  }
+  if (lastType != PictureObjectType::Picture || objects.pictures.empty()) {
+    LOGE("PictureReader::MakePicture() The serialized data has no picture!");
+    return nullptr;
+  }
+  return objects.pictures.back();
+}
+
+std::shared_ptr<Data> PictureLoader::readSubData(size_t length) {
+  auto bytes = reader.readBytes(length);
+  if (bytes == nullptr || length == 0) {
+    return nullptr;
+  }
+  return Data::MakeAdopted(bytes, length, ReleaseDataProc, new std::shared_ptr<Data>(data));
+}
+
+bool PictureLoader::readTypeface() {
+  auto fontFamily = reader.readString();
+  auto fontStyle = reader.readString();
+  auto fontData = readSubData(reader.readVarint());
+  if (!reader.isValid()) {
+    return false;
+  }
+  std::shared_ptr<Typeface> typeface = nullptr;
+  if (fontData != nullptr) {
+    typeface = Typeface::MakeFromData(std::move(fontData));
+    // Font collections always load their first face, so fall back to the font name if the stored
+    // data resolves to a different face.
+    if (typeface != nullptr &&
+        (typeface->fontFamily() != fontFamily || typeface->fontStyle() != fontStyle)) {
+      typeface = nullptr;
+    }
+  }
+  if (typeface == nullptr && !fontFamily.empty()) {
+    typeface = Typeface::MakeFromName(fontFamily, fontStyle);
+  }
+  if (typeface == nullptr) {
+    typeface = Typeface::MakeEmpty();
+  }
+  return AddObject(&objects.typefaces, std::move(typeface));
+}
+
+bool PictureLoader::readPath() {
+  Path path = {};
+  path.setFillType(reader.readEnum(PathFillType::InverseEvenOdd));
+  auto verbCount = reader.readVarint();
+  for (uint32_t i = 0; i < verbCount && reader.isValid(); i++) {
+    switch (reader.readEnum(PathVerb::Close)) {
+      case PathVerb::Move:
+        path.moveTo(reader.readPoint());
+        break;
+      case PathVerb::Line:
+        path.lineTo(reader.readPoint());
+        break;
+      case PathVerb::Quad: {
+        auto control = reader.readPoint();
+        path.quadTo(control, reader.readPoint());
+        break;
+      }
+      case PathVerb::Conic: {
+        auto control = reader.readPoint();
+        auto point = reader.readPoint();
+        path.conicTo(control, point, reader.readFloat());
+        break;
+      }
+      case PathVerb::Cubic: {
+        auto control1 = reader.readPoint();
+        auto control2 = reader.readPoint();
+        path.cubicTo(control1, control2, reader.readPoint());
+        break;
+      }
+      case PathVerb::Close:
+        path.close();
+        break;
+      default:
+        break;
+    }
+  }
+  objects.paths.push_back(std::move(path));
+  return reader.isValid();
+}
+
+bool PictureLoader::readShape() {
+  Path path = {};
+  if (!getObject(objects.paths, &path)) {
+    return false;
+  }
+  // An empty path produces a null shape, which is skipped during playback.
+  objects.shapes.push_back(Shape::MakeFrom(std::move(path)));
+  return true;
+}
+
+bool PictureLoader::readTextBlob() {
+  auto bounds = reader.readRect();
+  auto runCount = reader.readVarint();
+  TextBlobBuilder builder = {};
+  for (uint32_t i = 0; i < runCount; i++) {
+    std::shared_ptr<Typeface> typeface = nullptr;
+    if (!getObject(objects.typefaces, &typeface)) {
+      return false;
+    }
+    Font font(std::move(typeface), reader.readFloat());
+    font.setFauxBold(reader.readBool());
+    font.setFauxItalic(reader.readBool());
+    auto positioning = reader.readEnum(GlyphPositioning::Matrix);
+    auto glyphCount = reader.readVarint();
+    auto offsetY = reader.readFloat();
+    auto glyphs = reader.readBytes(glyphCount * sizeof(GlyphID));
+    auto positionSize = glyphCount * GetPositionFloatCount(positioning) * sizeof(float);
+    auto positions = reader.readBytes(positionSize);
+    if (glyphs == nullptr || positions == nullptr || glyphCount == 0) {
+      return false;
+    }
+    const TextBlobBuilder::RunBuffer* buffer = nullptr;
+    switch (positioning) {
+      case GlyphPositioning::Default:
+      case GlyphPositioning::Horizontal:
+        buffer = &builder.allocRunPosH(font, glyphCount, offsetY);
+        break;
+      case GlyphPositioning::Point:
+        buffer = &builder.allocRunPos(font, glyphCount);
+        break;
+      case GlyphPositioning::RSXform:
+        buffer = &builder.allocRunRSXform(font, glyphCount);
+        break;
+      case GlyphPositioning::Matrix:
+        buffer = &builder.allocRunMatrix(font, glyphCount);
+        break;
+    }
+    memcpy(buffer->glyphs, glyphs, glyphCount * sizeof(GlyphID));
+    memcpy(buffer->positions, positions, positionSize);
+  }
+  builder.setBounds(bounds);
+  return AddObject(&objects.textBlobs, builder.build());
+}
+
+bool PictureLoader::readImage() {
+  std::shared_ptr<Image> image = nullptr;
+  auto type = reader.readEnum(Types::ImageType::Scaled);
+  switch (type) {
+    case Types::ImageType::Codec: {
+      auto width = reader.readInt32();
+      auto height = reader.readInt32();
+      auto mipmapped = reader.readBool();
+      std::shared_ptr<ImageCodec> codec = nullptr;
+      if (reader.readBool()) {
+        codec = ImageCodec::MakeFrom(readSubData(reader.readVarint()));
+      } else {
+        auto codecWidth = reader.readInt32();
+        auto codecHeight = reader.readInt32();
+        auto colorType = reader.readBool() ? ColorType::ALPHA_8 : ColorType::RGBA_8888;
+        auto info = ImageInfo::Make(codecWidth, codecHeight, colorType);
+        auto pixels = readSubData(reader.readVarint());
+        if (info.isEmpty() || pixels == nullptr || pixels->size() != info.byteSize()) {
+          return false;
+        }
+        codec = ImageCodec::MakeFrom(info, std::move(pixels));
+      }
+      image = Image::MakeFrom(std::move(codec));
+      if (image == nullptr || width <= 0 || height <= 0) {
+        return false;
+      }
+      if (image->width() != width || image->height() != height) {
+        image = image->makeScaled(width, height);
+      }
+      if (image != nullptr && mipmapped) {
+        image = image->makeMipmapped(true);
+      }
+      break;
+    }
+    case Types::ImageType::Picture: {
+      std::shared_ptr<Picture> picture = nullptr;
+      if (!getObject(objects.pictures, &picture)) {
+        return false;
+      }
+      auto width = reader.readInt32();
+      auto height = reader.readInt32();
+      auto mipmapped = reader.readBool();
+      auto hasMatrix = reader.readBool();
+      auto matrix = hasMatrix ? reader.readMatrix() : Matrix::I();
+      std::shared_ptr<ColorSpace> colorSpace = nullptr;
+      auto profileSize = reader.readVarint();
+      if (profileSize > 0) {
+        auto profile = reader.readBytes(profileSize);
+        if (profile == nullptr) {
+          return false;
+        }
+        colorSpace = ColorSpace::MakeFromICC(profile, profileSize);
+      }
+      image = Image::MakeFrom(std::move(picture), width, height, hasMatrix ? &matrix : nullptr,
+                              std::move(colorSpace));
+      if (image != nullptr && mipmapped) {
+        image = image->makeMipmapped(true);
+      }
+      break;
+    }
+    case Types::ImageType::Subset: {
+      std::shared_ptr<Image> source = nullptr;
+      if (!getObject(objects.images, &source)) {
+        return false;
+      }
+      image = SubsetImage::MakeFrom(std::move(source), reader.readRect());
+      break;
+    }
+    case Types::ImageType::Orient: {
+      std::shared_ptr<Image> source = nullptr;
+      if (!getObject(objects.images, &source)) {
+        return false;
+      }
+      auto orientation = reader.readEnum(Orientation::LeftBottom);
+      if (orientation < Orientation::TopLeft) {
+        return false;
+      }
+      image = OrientImage::MakeFrom(std::move(source), orientation);
+      break;
+    }
+    default:
+      return false;
+  }
+  return AddObject(&objects.images, std::move(image));
+}
+
+bool PictureLoader::readShader() {
+  std::shared_ptr<Shader> shader = nullptr;
+  switch (reader.readEnum(Types::ShaderType::PerlinNoise)) {
+    case Types::ShaderType::Color:
+      shader = Shader::MakeColorShader(reader.readColor());
+      break;
+    case Types::ShaderType::Image: {
+      std::shared_ptr<Image> image = nullptr;
+      if (!getObject(objects.images, &image)) {
+        return false;
+      }
+      auto tileModeX = reader.readEnum(TileMode::Decal);
+      auto tileModeY = reader.readEnum(TileMode::Decal);
+      auto sampling = PictureReader::ReadSampling(&reader);
+      shader = Shader::MakeImageShader(std::move(image), tileModeX, tileModeY, sampling);
+      break;
+    }
+    case Types::ShaderType::Blend: {
+      auto mode = reader.readEnum(BlendMode::PlusDarker);
+      std::shared_ptr<Shader> dst = nullptr;
+      std::shared_ptr<Shader> src = nullptr;
+      if (!getObject(objects.shaders, &dst) || !getObject(objects.shaders, &src)) {
+        return false;
+      }
+      shader = Shader::MakeBlend(mode, std::move(dst), std::move(src));
+      break;
+    }
+    case Types::ShaderType::Matrix: {
+      std::shared_ptr<Shader> source = nullptr;
+      if (!getObject(objects.shaders, &source)) {
+        return false;
+      }
+      shader = source->makeWithMatrix(reader.readMatrix());
+      break;
+    }
+    case Types::ShaderType::ColorFilter: {
+      std::shared_ptr<Shader> source = nullptr;
+      std::shared_ptr<ColorFilter> colorFilter = nullptr;
+      if (!getObject(objects.shaders, &source) ||
+          !getObject(objects.colorFilters, &colorFilter)) {
+        return false;
+      }
+      shader = source->makeWithColorFilter(std::move(colorFilter));
+      break;
+    }
+    case Types::ShaderType::Gradient: {
+      auto gradientType = reader.readEnum(GradientType::Diamond);
+      auto colorCount = reader.readCount(sizeof(float) * 4);
+      if (!reader.isValid()) {
+        return false;
+      }
+      std::vector<Color> colors(colorCount);
+      for (auto& color : colors) {
+        color = reader.readColor();
+        if (!reader.isValid()) {
+          return false;
+        }
+      }
+      auto positionCount = reader.readCount(sizeof(float));
+      if (!reader.isValid()) {
+        return false;
+      }
+      std::vector<float> positions(positionCount);
+      if (!reader.readBytes(positions.data(), positions.size() * sizeof(float))) {
+        return false;
+      }
+      auto point0 = reader.readPoint();
+      auto point1 = reader.readPoint();
+      auto radius0 = reader.readFloat();
+      auto radius1 = reader.readFloat();
+      switch (gradientType) {
+        case GradientType::Linear:
+          shader = Shader::MakeLinearGradient(point0, point1, colors, positions);
+          break;
+        case GradientType::Radial:
+          shader = Shader::MakeRadialGradient(point0, radius0, colors, positions);
+          break;
+        case GradientType::Conic:
+          shader = Shader::MakeConicGradient(point0, radius0, radius1, colors, positions);
+          break;
+        case GradientType::Diamond:
+          shader = Shader::MakeDiamondGradient(point0, radius0, colors, positions);
+          break;
+        default:
+          break;
+      }
+      break;
+    }
+    case Types::ShaderType::PerlinNoise: {
+      auto turbulence = reader.readBool();
+      auto baseFrequencyX = reader.readFloat();
+      auto baseFrequencyY = reader.readFloat();
+      auto numOctaves = reader.readInt32();
+      auto seed = reader.readFloat();
+      auto stitchTiles = reader.readBool();
+      ISize tileSize = {};
+      tileSize.width = reader.readInt32();
+      tileSize.height = reader.readInt32();
+      auto tileSizePtr = stitchTiles ? &tileSize : nullptr;
+      if (turbulence) {
+        shader = Shader::MakeTurbulence(baseFrequencyX, baseFrequencyY, numOctaves, seed,
+                                        tileSizePtr);
+      } else {
+        shader = Shader::MakeFractalNoise(baseFrequencyX, baseFrequencyY, numOctaves, seed,
+                                          tileSizePtr);
+      }
+      break;
+    }
+  }
+  return AddObject(&objects.shaders, std::move(shader));
+}
+
+bool PictureLoader::readColorFilter() {
+  std::shared_ptr<ColorFilter> colorFilter = nullptr;
+  switch (reader.readEnum(Types::ColorFilterType::Luma)) {
+    case Types::ColorFilterType::Blend: {
+      auto color = reader.readColor();
+      colorFilter = ColorFilter::Blend(color, reader.readEnum(BlendMode::PlusDarker));
+      break;
+    }
+    case Types::ColorFilterType::Matrix: {
+      std::array<float, 20> matrix = {};
+      if (!reader.readBytes(matrix.data(), sizeof(float) * matrix.size())) {
+        return false;
+      }
+      colorFilter = ColorFilter::Matrix(matrix);
+      break;
+    }
+    case Types::ColorFilterType::AlphaThreshold:
+      colorFilter = ColorFilter::AlphaThreshold(reader.readFloat());
+      break;
+    case Types::ColorFilterType::Compose: {
+      std::shared_ptr<ColorFilter> inner = nullptr;
+      std::shared_ptr<ColorFilter> outer = nullptr;
+      if (!getObject(objects.colorFilters, &inner) || !getObject(objects.colorFilters, &outer)) {
+        return false;
+      }
+      colorFilter = ColorFilter::Compose(std::move(inner), std::move(outer));
+      break;
+    }
+    case Types::ColorFilterType::Luma:
+      colorFilter = ColorFilter::Luma();
+      break;
+  }
+  return AddObject(&objects.colorFilters, std::move(colorFilter));
+}
+
+bool PictureLoader::readMaskFilter() {
+  std::shared_ptr<Shader> shader = nullptr;
+  if (!getObject(objects.shaders, &shader)) {
+    return false;
+  }
+  auto inverted = reader.readBool();
+  return AddObject(&objects.maskFilters, MaskFilter::MakeShader(std::move(shader), inverted));
+}
+
+bool PictureLoader::readImageFilter() {
+  std::shared_ptr<ImageFilter> imageFilter = nullptr;
+  auto type = reader.readEnum(Types::ImageFilterType::Blend);
+  switch (type) {
+    case Types::ImageFilterType::Blur: {
+      auto blurrinessX = reader.readFloat();
+      auto blurrinessY = reader.readFloat();
+      auto tileMode = reader.readEnum(TileMode::Decal);
+      imageFilter = ImageFilter::Blur(blurrinessX, blurrinessY, tileMode);
+      break;
+    }
+    case Types::ImageFilterType::DropShadow:
+    case Types::ImageFilterType::InnerShadow: {
+      auto dx = reader.readFloat();
+      auto dy = reader.readFloat();
+      auto blurrinessX = reader.readFloat();
+      auto blurrinessY = reader.readFloat();
+      auto color = reader.readColor();
+      auto shadowOnly = reader.readBool();
+      if (type == Types::ImageFilterType::DropShadow) {
+        imageFilter = shadowOnly
+                          ? ImageFilter::DropShadowOnly(dx, dy, blurrinessX, blurrinessY, color)
+                          : ImageFilter::DropShadow(dx, dy, blurrinessX, blurrinessY, color);
+      } else {
+        imageFilter = shadowOnly
+                          ? ImageFilter::InnerShadowOnly(dx, dy, blurrinessX, blurrinessY, color)
+                          : ImageFilter::InnerShadow(dx, dy, blurrinessX, blurrinessY, color);
+      }
+      break;
+    }
+    case Types::ImageFilterType::Color: {
+      std::shared_ptr<ColorFilter> colorFilter = nullptr;
+      if (!getObject(objects.colorFilters, &colorFilter)) {
+        return false;
+      }
+      imageFilter = ImageFilter::ColorFilter(std::move(colorFilter));
+      break;
+    }
+    case Types::ImageFilterType::Compose: {
+      // Each filter is referenced by a varint index of at least one byte.
+      auto filterCount = reader.readCount(1);
+      if (!reader.isValid()) {
+        return false;
+      }
+      std::vector<std::shared_ptr<ImageFilter>> filters(filterCount);
+      for (auto& filter : filters) {
+        if (!getObject(objects.imageFilters, &filter)) {
+          return false;
+        }
+      }
+      imageFilter = ImageFilter::Compose(std::move(filters));
+      break;
+    }
+    case Types::ImageFilterType::Blend: {
+      auto blendMode = reader.readEnum(BlendMode::PlusDarker);
+      std::shared_ptr<Shader> shader = nullptr;
+      if (!getObject(objects.shaders, &shader)) {
+        return false;
+      }
+      imageFilter = ImageFilter::Blend(blendMode, std::move(shader));
+      break;
+    }
+    default:
+      return false;
+  }
+  return AddObject(&objects.imageFilters, std::move(imageFilter));
+}
+
+bool PictureLoader::readClip() {
+  ClipStack clip = {};
+  if (reader.readBool()) {
+    clip.clipRect(Rect::MakeEmpty(), Matrix::I(), false);
+  }
+  auto elementCount = reader.readVarint();
+  for (uint32_t i = 0; i < elementCount && reader.isValid(); i++) {
+    auto shapeType = reader.readEnum(GeometryShape::Type::Path);
+    Rect rect = {};
+    RRect rRect = {};
+    Path path = {};
+    switch (shapeType) {
+      case GeometryShape::Type::Rect:
+        rect = reader.readRect();
+        break;
+      case GeometryShape::Type::RRect: {
+        auto bounds = reader.readRect();
+        std::array<Point, 4> radii = {};
+        for (auto& radius : radii) {
+          radius = reader.readPoint();
+        }
+        rRect.setRectRadii(bounds, radii);
+        break;
+      }
+      case GeometryShape::Type::Path:
+        if (!getObject(objects.paths, &path)) {
+          return false;
+        }
+        break;
+      default:
+        break;
+    }
+    auto matrix = reader.readMatrix();
+    auto antiAlias = reader.readBool();
+    if (!reader.isValid()) {
+      return false;
+    }
+    switch (shapeType) {
+      case GeometryShape::Type::Rect:
+        clip.clipRect(rect, matrix, antiAlias);
+        break;
+      case GeometryShape::Type::RRect:
+        clip.clipRRect(rRect, matrix, antiAlias);
+        break;
+      case GeometryShape::Type::Path:
+        clip.clipPath(path, matrix, antiAlias);
+        break;
+      default:
+        break;
+    }
+  }
+  objects.clips.push_back(std::move(clip));
+  return reader.isValid();
+}
+
+template <typename T>
+static bool ReadLocalObjects(PictureBufferReader* reader, const std::vector<T>& globalList,
+                             std::vector<T>* localList) {
+  auto count = reader->readVarint();
+  for (uint32_t i = 0; i < count && reader->isValid(); i++) {
+    auto index = reader->readVarint();
+    if (index >= globalList.size()) {
+      reader->fail();
+      return false;
+    }
+    localList->push_back(globalList[index]);
+  }
+  return reader->isValid();
+}
+
+bool PictureLoader::readPicture() {
+  auto bounds = reader.readRect();
+  PictureObjects locals = {};
+  if (!ReadLocalObjects(&reader, objects.typefaces, &locals.typefaces) ||
+      !ReadLocalObjects(&reader, objects.paths, &locals.paths) ||
+      !ReadLocalObjects(&reader, objects.shapes, &locals.shapes) ||
+      !ReadLocalObjects(&reader, objects.textBlobs, &locals.textBlobs) ||
+      !ReadLocalObjects(&reader, objects.images, &locals.images) ||
+      !ReadLocalObjects(&reader, objects.shaders, &locals.shaders) ||
+      !ReadLocalObjects(&reader, objects.colorFilters, &locals.colorFilters) ||
+      !ReadLocalObjects(&reader, objects.maskFilters, &locals.maskFilters) ||
+      !ReadLocalObjects(&reader, objects.imageFilters, &locals.imageFilters) ||
+      !ReadLocalObjects(&reader, objects.clips, &locals.clips) ||
+      !ReadLocalObjects(&reader, objects.pictures, &locals.pictures)) {
+    return false;
+  }
+  auto recordSize = reader.readVarint();
+  auto recordBytes = reader.readBytes(recordSize);
+  if (recordBytes == nullptr || recordSize == 0) {
+    return false;
+  }
+  auto pictureReader = std::make_unique<PictureReader>(data, recordBytes, recordSize,
+                                                       std::move(locals), bounds);
+  // Validate the record stream once up front, so that playback never meets malformed records.
+  size_t drawCount = 0;
+  bool hasUnboundedFill = false;
+  bool hasInverseClip = true;
+  auto valid = pictureReader->visit([&](const PictureRecord& record) {
+    if (record.type() >= PictureRecordType::DrawFill) {
+      drawCount++;
+    }
+    if (!hasUnboundedFill && record.hasUnboundedFill(hasInverseClip)) {
+      hasUnboundedFill = true;
+    }
+    return true;
+  });
+  if (!valid) {
+    return false;
+  }
+  std::shared_ptr<Picture> picture = nullptr;
+  if (drawCount <= 1) {
+    // Pictures with a single draw are re-recorded, since callers like Image::MakeFrom() inspect
+    // their only draw record to unwrap images, which requires real record objects.
+    PictureContext context = {};
+    PlaybackContext playback = {};
+    pictureReader->visit([&](const PictureRecord& record) {
+      record.playback(&context, &playback);
+      return true;
+    });
+    picture = context.finishRecordingAsPicture();
+  }
+  if (picture == nullptr) {
+    picture = std::shared_ptr<Picture>(
+        new Picture(std::move(pictureReader), drawCount, hasUnboundedFill));
+  }
+  objects.pictures.push_back(std::move(picture));
+  return true;
+}
+
+std::shared_ptr<Picture> PictureReader::MakePicture(std::shared_ptr<Data> data) {
+  if (data == nullptr || data->empty()) {
+    return nullptr;
+  }
+  PictureLoader loader(std::move(data));
+  return loader.load();
+}
+
+PictureReader::PictureReader(std::shared_ptr<Data> data, const uint8_t* recordBytes,
+                             size_t recordSize, PictureObjects objects, const Rect& bounds)
+    : data(std::move(data)), recordBytes(recordBytes), recordSize(recordSize),
+      objects(std::move(objects)), _bounds(bounds) {
+}
+
+Brush PictureReader::readBrush(PictureBufferReader* reader) const {
+  Brush brush = {};
+  brush.color = reader->readColor();
+  brush.blendMode = reader->readEnum(BlendMode::PlusDarker);
+  brush.antiAlias = reader->readBool();
+  brush.shader = GetOptionalObject(objects.shaders, reader);
+  brush.maskFilter = GetOptionalObject(objects.maskFilters, reader);
+  brush.colorFilter = GetOptionalObject(objects.colorFilters, reader);
+  return brush;
+}
+
+Stroke PictureReader::ReadStroke(PictureBufferReader* reader) {
+  Stroke stroke = {};
+  stroke.width = reader->readFloat();
+  stroke.cap = reader->readEnum(LineCap::Square);
+  stroke.join = reader->readEnum(LineJoin::Bevel);
+  stroke.miterLimit = reader->readFloat();
+  return stroke;
+}
+
+SamplingOptions PictureReader::ReadSampling(PictureBufferReader* reader) {
+  SamplingOptions sampling = {};
+  sampling.minFilterMode = reader->readEnum(FilterMode::Linear);
+  sampling.magFilterMode = reader->readEnum(FilterMode::Linear);
+  sampling.mipmapMode = reader->readEnum(MipmapMode::Linear);
+  return sampling;
+}
+}  // namespace tgfx
@@ -0,0 +1,259 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/PictureFormat.h"
+#include "core/PictureRecords.h"
+#include "tgfx/core/Data.h"
+#include "tgfx/core/Picture.h"
+#include "tgfx/core/TextBlob.h"
+#include "tgfx/core/Typeface.h"
+
+namespace tgfx {
+/**
+ * PictureObjects holds the shared objects referenced by serialized records, one table per type.
+ */
+struct PictureObjects {
+  std::vector<std::shared_ptr<Typeface>> typefaces = {};
+  std::vector<Path> paths = {};
+  std::vector<std::shared_ptr<Shape>> shapes = {};
+  std::vector<std::shared_ptr<TextBlob>> textBlobs = {};
+  std::vector<std::shared_ptr<Image>> images = {};
+  std::vector<std::shared_ptr<Shader>> shaders = {};
+  std::vector<std::shared_ptr<ColorFilter>> colorFilters = {};
+  std::vector<std::shared_ptr<MaskFilter>> maskFilters = {};
+  std::vector<std::shared_ptr<ImageFilter>> imageFilters = {};
+  std::vector<ClipStack> clips = {};
+  std::vector<std::shared_ptr<Picture>> pictures = {};
+};
+
+/**
+ * PictureReader plays back the records of a deserialized Picture directly from the serialized
+ * bytes. Shared objects such as paths, images and text blobs are decoded once when the picture is
+ * loaded, while the records themselves stay in the compact byte stream and are decoded into
+ * temporary stack objects during each playback.
+ */
+class PictureReader {
+ public:
+  /**
+   * Creates a Picture from the data produced by PictureWriter::Serialize(). Returns nullptr if the
+   * data is malformed or was written by an unsupported format version.
+   */
+  static std::shared_ptr<Picture> MakePicture(std::shared_ptr<Data> data);
+
+  PictureReader(std::shared_ptr<Data> data, const uint8_t* recordBytes, size_t recordSize,
+                PictureObjects objects, const Rect& bounds);
+
+  /**
+   * Returns the bounds stored when the Picture was serialized.
+   */
+  const Rect& bounds() const {
+    return _bounds;
+  }
+
+  /**
+   * Decodes the records one by one and passes each of them to the visitor, which returns false to
+   * stop the iteration. The record passed to the visitor is only valid during the call. Returns
+   * false if the record stream is malformed.
+   */
+  template <typename Visitor>
+  bool visit(Visitor&& visitor) const;
+
+ private:
+  enum class VisitResult { Continue, Stop, Invalid };
+
+  std::shared_ptr<Data> data = nullptr;
+  const uint8_t* recordBytes = nullptr;
+  size_t recordSize = 0;
+  PictureObjects objects = {};
+  Rect _bounds = {};
+
+  template <typename T>
+  static T GetObject(const std::vector<T>& list, PictureBufferReader* reader) {
+    auto index = reader->readVarint();
+    if (index >= list.size()) {
+      reader->fail();
+      return {};
+    }
+    return list[index];
+  }
+
+  template <typename T>
+  static T GetOptionalObject(const std::vector<T>& list, PictureBufferReader* reader) {
+    // Optional references are stored as index + 1, where zero means no object.
+    auto index = reader->readVarint();
+    if (index == 0) {
+      return {};
+    }
+    if (index > list.size()) {
+      reader->fail();
+      return {};
+    }
+    return list[index - 1];
+  }
+
+  template <typename Visitor>
+  static VisitResult Visit(const PictureBufferReader& reader, const PictureRecord& record,
+                           Visitor& visitor) {
+    if (!reader.isValid()) {
+      return VisitResult::Invalid;
+    }
+    return visitor(record) ? VisitResult::Continue : VisitResult::Stop;
+  }
+
+  Brush readBrush(PictureBufferReader* reader) const;
+
+  static Stroke ReadStroke(PictureBufferReader* reader);
+
+  static SamplingOptions ReadSampling(PictureBufferReader* reader);
+
+  friend class PictureLoader;
+};
+
+template <typename Visitor>
+bool PictureReader::visit(Visitor&& visitor) const {
+  PictureBufferReader reader(recordBytes, recordSize);
+  while (!reader.isEnd()) {
+    auto result = VisitResult::Continue;
+    auto type = reader.readEnum(PictureRecordType::DrawLayer);
+    switch (type) {
+      case PictureRecordType::SetMatrix: {
+        SetMatrix record(reader.readMatrix());
+        result = Visit(reader, record, visitor);
+        break;
+      }
+      case PictureRecordType::SetClip: {
+        SetClip record(GetObject(objects.clips, &reader));
+        result = Visit(reader, record, visitor);
+        break;
+      }
+      case PictureRecordType::SetColor: {
+        SetColor record(reader.readColor());
+        result = Visit(reader, record, visitor);
+        break;
+      }
+      case PictureRecordType::SetFill: {
+        SetBrush record(readBrush(&reader));
+        result = Visit(reader, record, visitor);
+        break;
+      }
+      case PictureRecordType::SetStrokeWidth: {
+        SetStrokeWidth record(reader.readFloat());
+        result = Visit(reader, record, visitor);
+        break;
+      }
+      case PictureRecordType::SetStroke: {
+        SetStroke record(ReadStroke(&reader));
+        result = Visit(reader, record, visitor);
+        break;
+      }
+      case PictureRecordType::SetHasStroke: {
+        SetHasStroke record(reader.readBool());
+        result = Visit(reader, record, visitor);
+        break;
+      }
+      case PictureRecordType::DrawFill: {
+        DrawFill record = {};
+        result = Visit(reader, record, visitor);
+        break;
+      }
+      case PictureRecordType::DrawRect: {
+        DrawRect record(reader.readRect());
+        result = Visit(reader, record, visitor);
+        break;
+      }
+      case PictureRecordType::DrawRRect: {
+        auto rect = reader.readRect();
+        std::array<Point, 4> radii = {};
+        for (auto& radius : radii) {
+          radius = reader.readPoint();
+        }
+        RRect rRect = {};
+        rRect.setRectRadii(rect, radii);
+        DrawRRect record(rRect);
+        result = Visit(reader, record, visitor);
+        break;
+      }
+      case PictureRecordType::DrawPath: {
+        DrawPath record(GetObject(objects.paths, &reader));
+        result = Visit(reader, record, visitor);
+        break;
+      }
+      case PictureRecordType::DrawShape: {
+        auto shape = GetObject(objects.shapes, &reader);
+        if (shape == nullptr) {
+          // The shape had an empty path when serialized, so there is nothing to draw.
+          break;
+        }
+        DrawShape record(std::move(shape));
+        result = Visit(reader, record, visitor);
+        break;
+      }
+      case PictureRecordType::DrawImage: {
+        auto image = GetObject(objects.images, &reader);
+        DrawImage record(std::move(image), ReadSampling(&reader));
+        result = Visit(reader, record, visitor);
+        break;
+      }
+      case PictureRecordType::DrawImageRect:
+      case PictureRecordType::DrawImageRectToRect: {
+        auto image = GetObject(objects.images, &reader);
+        auto sampling = ReadSampling(&reader);
+        auto rect = reader.readRect();
+        auto constraint = reader.readEnum(SrcRectConstraint::Fast);
+        auto strictRect = reader.readBool() ? reader.readRect() : Rect::MakeEmpty();
+        if (type == PictureRecordType::DrawImageRectToRect) {
+          DrawImageRectToRect record(std::move(image), rect, reader.readRect(), sampling,
+                                     constraint, strictRect);
+          result = Visit(reader, record, visitor);
+        } else {
+          DrawImageRect record(std::move(image), rect, sampling, constraint, strictRect);
+          result = Visit(reader, record, visitor);
+        }
+        break;
+      }
+      case PictureRecordType::DrawTextBlob: {
+        DrawTextBlob record(GetObject(objects.textBlobs, &reader));
+        result = Visit(reader, record, visitor);
+        break;
+      }
+      case PictureRecordType::DrawPicture: {
+        DrawPicture record(GetObject(objects.pictures, &reader));
+        result = Visit(reader, record, visitor);
+        break;
+      }
+      case PictureRecordType::DrawLayer: {
+        auto picture = GetObject(objects.pictures, &reader);
+        DrawLayer record(std::move(picture), GetOptionalObject(objects.imageFilters, &reader));
+        result = Visit(reader, record, visitor);
+        break;
+      }
+      default:
+        // DrawMesh records are never serialized.
+        reader.fail();
+        result = VisitResult::Invalid;
+        break;
+    }
+    if (result != VisitResult::Continue) {
+      return result == VisitResult::Stop;
+    }
+  }
+  return reader.isValid();
+}
+}  // namespace tgfx
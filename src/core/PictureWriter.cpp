@@ -0,0 +1,855 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "core/PictureWriter.h"
+#include "core/PathRef.h"
+#include "core/filters/AlphaThresholdColorFilter.h"
+#include "core/filters/BlendImageFilter.h"
+#include "core/filters/ColorImageFilter.h"
+#include "core/filters/ComposeColorFilter.h"
+#include "core/filters/ComposeImageFilter.h"
+#include "core/filters/DropShadowImageFilter.h"
+#include "core/filters/GaussianBlurImageFilter.h"
+#include "core/filters/InnerShadowImageFilter.h"
+#include "core/filters/MatrixColorFilter.h"
+#include "core/filters/ModeColorFilter.h"
+#include "core/filters/ShaderMaskFilter.h"
+#include "core/images/CodecImage.h"
+#include "core/images/OrientImage.h"
+#include "core/images/PictureImage.h"
+#include "core/images/SubsetImage.h"
+#include "core/shaders/BlendShader.h"
+#include "core/shaders/ColorFilterShader.h"
+#include "core/shaders/ColorShader.h"
+#include "core/shaders/GradientShader.h"
+#include "core/shaders/ImageShader.h"
+#include "core/shaders/MatrixShader.h"
+#include "core/shaders/PerlinNoiseShader.h"
+#include "core/utils/Log.h"
+#include "core/utils/Types.h"
+#include "tgfx/core/Buffer.h"
+#include "tgfx/core/Stream.h"
+
+namespace tgfx {
+/**
+ * The objects referenced by the records of a single picture. Records store local indices into
+ * these tables, which map to the global object IDs of the serialized data.
+ */
+struct PictureWriter::LocalObjects {
+  std::array<std::vector<uint32_t>, PICTURE_OBJECT_TYPE_COUNT> objectIDs = {};
+  std::array<std::unordered_map<uint32_t, uint32_t>, PICTURE_OBJECT_TYPE_COUNT> localIDs = {};
+
+  uint32_t getLocalID(PictureObjectType type, uint32_t globalID) {
+    auto index = static_cast<size_t>(type);
+    auto& ids = localIDs[index];
+    auto result = ids.find(globalID);
+    if (result != ids.end()) {
+      return result->second;
+    }
+    auto localID = static_cast<uint32_t>(objectIDs[index].size());
+    objectIDs[index].push_back(globalID);
+    ids[globalID] = localID;
+    return localID;
+  }
+};
+
+static size_t GetPositionFloatCount(GlyphPositioning positioning) {
+  switch (positioning) {
+    case GlyphPositioning::Default:
+    case GlyphPositioning::Horizontal:
+      return 1;
+    case GlyphPositioning::Point:
+      return 2;
+    case GlyphPositioning::RSXform:
+      return 4;
+    case GlyphPositioning::Matrix:
+      return 6;
+  }
+  return 0;
+}
+
+static void WriteSampling(const SamplingOptions& sampling, PictureBufferWriter* writer) {
+  writer->writeUInt8(static_cast<uint8_t>(sampling.minFilterMode));
+  writer->writeUInt8(static_cast<uint8_t>(sampling.magFilterMode));
+  writer->writeUInt8(static_cast<uint8_t>(sampling.mipmapMode));
+}
+
+static void WriteShadow(float dx, float dy, const std::shared_ptr<ImageFilter>& blurFilter,
+                        const Color& color, bool shadowOnly, PictureBufferWriter* writer) {
+  float blurrinessX = 0.0f;
+  float blurrinessY = 0.0f;
+  if (blurFilter != nullptr && Types::Get(blurFilter.get()) == Types::ImageFilterType::Blur) {
+    auto blur = static_cast<const GaussianBlurImageFilter*>(blurFilter.get());
+    blurrinessX = blur->blurrinessX;
+    blurrinessY = blur->blurrinessY;
+  }
+  writer->writeFloat(dx);
+  writer->writeFloat(dy);
+  writer->writeFloat(blurrinessX);
+  writer->writeFloat(blurrinessY);
+  writer->writeColor(color);
+  writer->writeBool(shadowOnly);
+}
+
+std::shared_ptr<Data> PictureWriter::Serialize(const Picture* picture) {
+  if (picture == nullptr) {
+    return nullptr;
+  }
+  PictureWriter writer = {};
+  writer.buffer.writeBytes(&PICTURE_FORMAT_MAGIC, sizeof(PICTURE_FORMAT_MAGIC));
+  writer.buffer.writeBytes(&PICTURE_FORMAT_VERSION, sizeof(PICTURE_FORMAT_VERSION));
+  uint32_t pictureID = 0;
+  if (!writer.writePicture(picture, &pictureID)) {
+    return nullptr;
+  }
+  return Data::MakeWithCopy(writer.buffer.data(), writer.buffer.size());
+}
+
+bool PictureWriter::findObject(PictureObjectType type, const void* object, uint32_t* id) const {
+  auto& ids = objectIDs[static_cast<size_t>(type)];
+  auto result = ids.find(object);
+  if (result == ids.end()) {
+    return false;
+  }
+  *id = result->second;
+  return true;
+}
+
+uint32_t PictureWriter::beginObject(PictureObjectType type, const void* object) {
+  auto index = static_cast<size_t>(type);
+  auto id = objectCounts[index]++;
+  objectIDs[index][object] = id;
+  buffer.writeUInt8(static_cast<uint8_t>(type));
+  return id;
+}
+
+bool PictureWriter::writeTypeface(const std::shared_ptr<Typeface>& typeface, uint32_t* id) {
+  if (findObject(PictureObjectType::Typeface, typeface.get(), id)) {
+    return true;
+  }
+  std::vector<uint8_t> fontData = {};
+  if (typeface != nullptr) {
+    if (typeface->isCustom()) {
+      LOGE("PictureWriter::writeTypeface() Custom typefaces can not be serialized!");
+      return false;
+    }
+    auto stream = typeface->openStream();
+    if (stream != nullptr && stream->size() > 0) {
+      fontData.resize(stream->size());
+      if (stream->read(fontData.data(), fontData.size()) != fontData.size()) {
+        fontData.clear();
+      }
+    }
+  }
+  *id = beginObject(PictureObjectType::Typeface, typeface.get());
+  buffer.writeString(typeface ? typeface->fontFamily() : "");
+  buffer.writeString(typeface ? typeface->fontStyle() : "");
+  buffer.writeVarint(static_cast<uint32_t>(fontData.size()));
+  buffer.writeBytes(fontData.data(), fontData.size());
+  return true;
+}
+
+bool PictureWriter::writePath(const Path& path, uint32_t* id) {
+  auto key = &PathRef::ReadAccess(path);
+  if (findObject(PictureObjectType::Path, key, id)) {
+    return true;
+  }
+  retainedPaths.push_back(path);
+  *id = beginObject(PictureObjectType::Path, key);
+  buffer.writeUInt8(static_cast<uint8_t>(path.getFillType()));
+  buffer.writeVarint(static_cast<uint32_t>(path.countVerbs()));
+  for (auto& segment : path) {
+    buffer.writeUInt8(static_cast<uint8_t>(segment.verb));
+    switch (segment.verb) {
+      case PathVerb::Move:
+        buffer.writePoint(segment.points[0]);
+        break;
+      case PathVerb::Line:
+        buffer.writePoint(segment.points[1]);
+        break;
+      case PathVerb::Quad:
+        buffer.writePoint(segment.points[1]);
+        buffer.writePoint(segment.points[2]);
+        break;
+      case PathVerb::Conic:
+        buffer.writePoint(segment.points[1]);
+        buffer.writePoint(segment.points[2]);
+        buffer.writeFloat(segment.conicWeight);
+        break;
+      case PathVerb::Cubic:
+        buffer.writePoint(segment.points[1]);
+        buffer.writePoint(segment.points[2]);
+        buffer.writePoint(segment.points[3]);
+        break;
+      default:
+        break;
+    }
+  }
+  return true;
+}
+
+bool PictureWriter::writeShape(const std::shared_ptr<Shape>& shape, uint32_t* id) {
+  if (findObject(PictureObjectType::Shape, shape.get(), id)) {
+    return true;
+  }
+  uint32_t pathID = 0;
+  if (!writePath(shape->getPath(), &pathID)) {
+    return false;
+  }
+  *id = beginObject(PictureObjectType::Shape, shape.get());
+  buffer.writeVarint(pathID);
+  return true;
+}
+
+bool PictureWriter::writeTextBlob(const std::shared_ptr<TextBlob>& textBlob, uint32_t* id) {
+  if (findObject(PictureObjectType::TextBlob, textBlob.get(), id)) {
+    return true;
+  }
+  std::vector<uint32_t> typefaceIDs = {};
+  for (auto run : *textBlob) {
+    uint32_t typefaceID = 0;
+    if (!writeTypeface(run.font.getTypeface(), &typefaceID)) {
+      return false;
+    }
+    typefaceIDs.push_back(typefaceID);
+  }
+  *id = beginObject(PictureObjectType::TextBlob, textBlob.get());
+  buffer.writeRect(textBlob->getBounds());
+  buffer.writeVarint(static_cast<uint32_t>(typefaceIDs.size()));
+  size_t runIndex = 0;
+  for (auto run : *textBlob) {
+    auto& font = run.font;
+    buffer.writeVarint(typefaceIDs[runIndex++]);
+    buffer.writeFloat(font.getSize());
+    buffer.writeBool(font.isFauxBold());
+    buffer.writeBool(font.isFauxItalic());
+    buffer.writeUInt8(static_cast<uint8_t>(run.positioning));
+    buffer.writeVarint(static_cast<uint32_t>(run.glyphCount));
+    buffer.writeFloat(run.offsetY);
+    buffer.writeBytes(run.glyphs, run.glyphCount * sizeof(GlyphID));
+    buffer.writeFloats(run.positions, run.glyphCount * GetPositionFloatCount(run.positioning));
+  }
+  return true;
+}
+
+bool PictureWriter::writeImage(const std::shared_ptr<Image>& image, uint32_t* id) {
+  if (findObject(PictureObjectType::Image, image.get(), id)) {
+    return true;
+  }
+  auto type = Types::Get(image.get());
+  switch (type) {
+    case Types::ImageType::Codec: {
+      auto codec = static_cast<const CodecImage*>(image.get())->getCodec();
+      auto encodedData = codec->getEncodedData();
+      std::shared_ptr<Data> pixels = nullptr;
+      auto info = ImageInfo::Make(codec->width(), codec->height(),
+                                  codec->isAlphaOnly() ? ColorType::ALPHA_8 : ColorType::RGBA_8888);
+      if (encodedData == nullptr) {
+        Buffer pixelBuffer(info.byteSize());
+        if (pixelBuffer.isEmpty() || !codec->readPixels(info, pixelBuffer.data())) {
+          LOGE("PictureWriter::writeImage() Failed to read pixels from the image codec!");
+          return false;
+        }
+        pixels = pixelBuffer.release();
+      }
+      *id = beginObject(PictureObjectType::Image, image.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeInt32(image->width());
+      buffer.writeInt32(image->height());
+      buffer.writeBool(image->hasMipmaps());
+      buffer.writeBool(encodedData != nullptr);
+      if (encodedData != nullptr) {
+        buffer.writeVarint(static_cast<uint32_t>(encodedData->size()));
+        buffer.writeBytes(encodedData->data(), encodedData->size());
+      } else {
+        buffer.writeInt32(info.width());
+        buffer.writeInt32(info.height());
+        buffer.writeBool(codec->isAlphaOnly());
+        buffer.writeVarint(static_cast<uint32_t>(pixels->size()));
+        buffer.writeBytes(pixels->data(), pixels->size());
+      }
+      return true;
+    }
+    case Types::ImageType::Picture: {
+      auto pictureImage = static_cast<const PictureImage*>(image.get());
+      uint32_t pictureID = 0;
+      if (!writePicture(pictureImage->picture.get(), &pictureID)) {
+        return false;
+      }
+      std::shared_ptr<Data> profile = nullptr;
+      if (pictureImage->colorSpace() != nullptr) {
+        profile = pictureImage->colorSpace()->toICCProfile();
+      }
+      *id = beginObject(PictureObjectType::Image, image.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeVarint(pictureID);
+      buffer.writeInt32(image->width());
+      buffer.writeInt32(image->height());
+      buffer.writeBool(image->hasMipmaps());
+      buffer.writeBool(pictureImage->matrix != nullptr);
+      if (pictureImage->matrix != nullptr) {
+        buffer.writeMatrix(*pictureImage->matrix);
+      }
+      auto profileSize = profile ? profile->size() : 0;
+      buffer.writeVarint(static_cast<uint32_t>(profileSize));
+      buffer.writeBytes(profile ? profile->data() : nullptr, profileSize);
+      return true;
+    }
+    case Types::ImageType::Subset: {
+      auto subsetImage = static_cast<const SubsetImage*>(image.get());
+      uint32_t sourceID = 0;
+      if (!writeImage(subsetImage->source, &sourceID)) {
+        return false;
+      }
+      *id = beginObject(PictureObjectType::Image, image.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeVarint(sourceID);
+      buffer.writeRect(subsetImage->bounds);
+      return true;
+    }
+    case Types::ImageType::Orient: {
+      auto orientImage = static_cast<const OrientImage*>(image.get());
+      uint32_t sourceID = 0;
+      if (!writeImage(orientImage->source, &sourceID)) {
+        return false;
+      }
+      *id = beginObject(PictureObjectType::Image, image.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeVarint(sourceID);
+      buffer.writeUInt8(static_cast<uint8_t>(orientImage->orientation));
+      return true;
+    }
+    default:
+      break;
+  }
+  LOGE("PictureWriter::writeImage() Unsupported image type: %d", static_cast<int>(type));
+  return false;
+}
+
+bool PictureWriter::writeShader(const std::shared_ptr<Shader>& shader, uint32_t* id) {
+  if (findObject(PictureObjectType::Shader, shader.get(), id)) {
+    return true;
+  }
+  auto type = Types::Get(shader.get());
+  switch (type) {
+    case Types::ShaderType::Color: {
+      auto colorShader = static_cast<const ColorShader*>(shader.get());
+      *id = beginObject(PictureObjectType::Shader, shader.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeColor(colorShader->color);
+      return true;
+    }
+    case Types::ShaderType::Image: {
+      auto imageShader = static_cast<const ImageShader*>(shader.get());
+      uint32_t imageID = 0;
+      if (!writeImage(imageShader->image, &imageID)) {
+        return false;
+      }
+      *id = beginObject(PictureObjectType::Shader, shader.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeVarint(imageID);
+      buffer.writeUInt8(static_cast<uint8_t>(imageShader->tileModeX));
+      buffer.writeUInt8(static_cast<uint8_t>(imageShader->tileModeY));
+      WriteSampling(imageShader->sampling, &buffer);
+      return true;
+    }
+    case Types::ShaderType::Blend: {
+      auto blendShader = static_cast<const BlendShader*>(shader.get());
+      uint32_t dstID = 0;
+      uint32_t srcID = 0;
+      if (!writeShader(blendShader->dst, &dstID) || !writeShader(blendShader->src, &srcID)) {
+        return false;
+      }
+      *id = beginObject(PictureObjectType::Shader, shader.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeUInt8(static_cast<uint8_t>(blendShader->mode));
+      buffer.writeVarint(dstID);
+      buffer.writeVarint(srcID);
+      return true;
+    }
+    case Types::ShaderType::Matrix: {
+      auto matrixShader = static_cast<const MatrixShader*>(shader.get());
+      uint32_t sourceID = 0;
+      if (!writeShader(matrixShader->source, &sourceID)) {
+        return false;
+      }
+      *id = beginObject(PictureObjectType::Shader, shader.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeVarint(sourceID);
+      buffer.writeMatrix(matrixShader->matrix);
+      return true;
+    }
+    case Types::ShaderType::ColorFilter: {
+      auto filterShader = static_cast<const ColorFilterShader*>(shader.get());
+      uint32_t sourceID = 0;
+      uint32_t filterID = 0;
+      if (!writeShader(filterShader->shader, &sourceID) ||
+          !writeColorFilter(filterShader->colorFilter, &filterID)) {
+        return false;
+      }
+      *id = beginObject(PictureObjectType::Shader, shader.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeVarint(sourceID);
+      buffer.writeVarint(filterID);
+      return true;
+    }
+    case Types::ShaderType::Gradient: {
+      GradientInfo info = {};
+      auto gradientType = static_cast<const GradientShader*>(shader.get())->asGradient(&info);
+      *id = beginObject(PictureObjectType::Shader, shader.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeUInt8(static_cast<uint8_t>(gradientType));
+      buffer.writeVarint(static_cast<uint32_t>(info.colors.size()));
+      for (auto& color : info.colors) {
+        buffer.writeColor(color);
+      }
+      buffer.writeVarint(static_cast<uint32_t>(info.positions.size()));
+      buffer.writeFloats(info.positions.data(), info.positions.size());
+      buffer.writePoint(info.points[0]);
+      buffer.writePoint(info.points[1]);
+      buffer.writeFloat(info.radiuses[0]);
+      buffer.writeFloat(info.radiuses[1]);
+      return true;
+    }
+    case Types::ShaderType::PerlinNoise: {
+      auto noiseShader = static_cast<const PerlinNoiseShader*>(shader.get());
+      *id = beginObject(PictureObjectType::Shader, shader.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeUInt8(static_cast<uint8_t>(noiseShader->noiseType));
+      buffer.writeFloat(noiseShader->baseFrequencyX);
+      buffer.writeFloat(noiseShader->baseFrequencyY);
+      buffer.writeInt32(noiseShader->numOctaves);
+      buffer.writeFloat(noiseShader->seed);
+      buffer.writeBool(noiseShader->stitchTiles);
+      buffer.writeInt32(noiseShader->tileSize.width);
+      buffer.writeInt32(noiseShader->tileSize.height);
+      return true;
+    }
+  }
+  LOGE("PictureWriter::writeShader() Unsupported shader type: %d", static_cast<int>(type));
+  return false;
+}
+
+bool PictureWriter::writeColorFilter(const std::shared_ptr<ColorFilter>& colorFilter,
+                                     uint32_t* id) {
+  if (findObject(PictureObjectType::ColorFilter, colorFilter.get(), id)) {
+    return true;
+  }
+  auto type = Types::Get(colorFilter.get());
+  switch (type) {
+    case Types::ColorFilterType::Blend: {
+      auto modeFilter = static_cast<const ModeColorFilter*>(colorFilter.get());
+      *id = beginObject(PictureObjectType::ColorFilter, colorFilter.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeColor(modeFilter->color);
+      buffer.writeUInt8(static_cast<uint8_t>(modeFilter->mode));
+      return true;
+    }
+    case Types::ColorFilterType::Matrix: {
+      auto matrixFilter = static_cast<const MatrixColorFilter*>(colorFilter.get());
+      *id = beginObject(PictureObjectType::ColorFilter, colorFilter.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeFloats(matrixFilter->matrix.data(), matrixFilter->matrix.size());
+      return true;
+    }
+    case Types::ColorFilterType::AlphaThreshold: {
+      auto thresholdFilter = static_cast<const AlphaThresholdColorFilter*>(colorFilter.get());
+      *id = beginObject(PictureObjectType::ColorFilter, colorFilter.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeFloat(thresholdFilter->threshold);
+      return true;
+    }
+    case Types::ColorFilterType::Compose: {
+      auto composeFilter = static_cast<const ComposeColorFilter*>(colorFilter.get());
+      uint32_t innerID = 0;
+      uint32_t outerID = 0;
+      if (!writeColorFilter(composeFilter->inner, &innerID) ||
+          !writeColorFilter(composeFilter->outer, &outerID)) {
+        return false;
+      }
+      *id = beginObject(PictureObjectType::ColorFilter, colorFilter.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeVarint(innerID);
+      buffer.writeVarint(outerID);
+      return true;
+    }
+    case Types::ColorFilterType::Luma:
+      *id = beginObject(PictureObjectType::ColorFilter, colorFilter.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      return true;
+  }
+  LOGE("PictureWriter::writeColorFilter() Unsupported color filter type: %d",
+       static_cast<int>(type));
+  return false;
+}
+
+bool PictureWriter::writeMaskFilter(const std::shared_ptr<MaskFilter>& maskFilter, uint32_t* id) {
+  if (findObject(PictureObjectType::MaskFilter, maskFilter.get(), id)) {
+    return true;
+  }
+  if (Types::Get(maskFilter.get()) != Types::MaskFilterType::Shader) {
+    LOGE("PictureWriter::writeMaskFilter() Unsupported mask filter type!");
+    return false;
+  }
+  auto shaderFilter = static_cast<const ShaderMaskFilter*>(maskFilter.get());
+  uint32_t shaderID = 0;
+  if (!writeShader(shaderFilter->shader, &shaderID)) {
+    return false;
+  }
+  *id = beginObject(PictureObjectType::MaskFilter, maskFilter.get());
+  buffer.writeVarint(shaderID);
+  buffer.writeBool(shaderFilter->inverted);
+  return true;
+}
+
+bool PictureWriter::writeImageFilter(const std::shared_ptr<ImageFilter>& imageFilter,
+                                     uint32_t* id) {
+  if (findObject(PictureObjectType::ImageFilter, imageFilter.get(), id)) {
+    return true;
+  }
+  auto type = Types::Get(imageFilter.get());
+  switch (type) {
+    case Types::ImageFilterType::Blur: {
+      auto blurFilter = static_cast<const GaussianBlurImageFilter*>(imageFilter.get());
+      *id = beginObject(PictureObjectType::ImageFilter, imageFilter.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeFloat(blurFilter->blurrinessX);
+      buffer.writeFloat(blurFilter->blurrinessY);
+      buffer.writeUInt8(static_cast<uint8_t>(blurFilter->tileMode));
+      return true;
+    }
+    case Types::ImageFilterType::DropShadow: {
+      auto shadowFilter = static_cast<const DropShadowImageFilter*>(imageFilter.get());
+      *id = beginObject(PictureObjectType::ImageFilter, imageFilter.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      WriteShadow(shadowFilter->dx, shadowFilter->dy, shadowFilter->blurFilter,
+                  shadowFilter->color, shadowFilter->shadowOnly, &buffer);
+      return true;
+    }
+    case Types::ImageFilterType::InnerShadow: {
+      auto shadowFilter = static_cast<const InnerShadowImageFilter*>(imageFilter.get());
+      *id = beginObject(PictureObjectType::ImageFilter, imageFilter.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      WriteShadow(shadowFilter->dx, shadowFilter->dy, shadowFilter->blurFilter,
+                  shadowFilter->color, shadowFilter->shadowOnly, &buffer);
+      return true;
+    }
+    case Types::ImageFilterType::Color: {
+      auto colorImageFilter = static_cast<const ColorImageFilter*>(imageFilter.get());
+      uint32_t filterID = 0;
+      if (!writeColorFilter(colorImageFilter->filter, &filterID)) {
+        return false;
+      }
+      *id = beginObject(PictureObjectType::ImageFilter, imageFilter.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeVarint(filterID);
+      return true;
+    }
+    case Types::ImageFilterType::Compose: {
+      auto composeFilter = static_cast<const ComposeImageFilter*>(imageFilter.get());
+      std::vector<uint32_t> filterIDs = {};
+      for (auto& filter : composeFilter->filters) {
+        uint32_t filterID = 0;
+        if (!writeImageFilter(filter, &filterID)) {
+          return false;
+        }
+        filterIDs.push_back(filterID);
+      }
+      *id = beginObject(PictureObjectType::ImageFilter, imageFilter.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeVarint(static_cast<uint32_t>(filterIDs.size()));
+      for (auto filterID : filterIDs) {
+        buffer.writeVarint(filterID);
+      }
+      return true;
+    }
+    case Types::ImageFilterType::Blend: {
+      auto blendFilter = static_cast<const BlendImageFilter*>(imageFilter.get());
+      uint32_t shaderID = 0;
+      if (!writeShader(blendFilter->shader, &shaderID)) {
+        return false;
+      }
+      *id = beginObject(PictureObjectType::ImageFilter, imageFilter.get());
+      buffer.writeUInt8(static_cast<uint8_t>(type));
+      buffer.writeUInt8(static_cast<uint8_t>(blendFilter->blendMode));
+      buffer.writeVarint(shaderID);
+      return true;
+    }
+    default:
+      break;
+  }
+  LOGE("PictureWriter::writeImageFilter() Unsupported image filter type: %d",
+       static_cast<int>(type));
+  return false;
+}
+
+bool PictureWriter::writeClip(const ClipStack& clip, uint32_t* id) {
+  auto result = clipIDs.find(clip.uniqueID());
+  if (result != clipIDs.end()) {
+    *id = result->second;
+    return true;
+  }
+  std::vector<const ClipElement*> elements = {};
+  std::vector<uint32_t> pathIDs = {};
+  if (clip.state() != ClipState::Empty) {
+    auto& clipElements = clip.elements();
+    for (size_t i = clip.oldestValidIndex(); i < clipElements.size(); ++i) {
+      auto& element = clipElements[i];
+      if (!element.isValid()) {
+        continue;
+      }
+      uint32_t pathID = 0;
+      if (element.shape().type() == GeometryShape::Type::Path &&
+          !writePath(element.shape().path(), &pathID)) {
+        return false;
+      }
+      elements.push_back(&element);
+      pathIDs.push_back(pathID);
+    }
+  }
+  // Clips are keyed by their unique IDs rather than by their addresses.
+  *id = objectCounts[static_cast<size_t>(PictureObjectType::Clip)]++;
+  clipIDs[clip.uniqueID()] = *id;
+  buffer.writeUInt8(static_cast<uint8_t>(PictureObjectType::Clip));
+  buffer.writeBool(clip.state() == ClipState::Empty);
+  buffer.writeVarint(static_cast<uint32_t>(elements.size()));
+  for (size_t i = 0; i < elements.size(); ++i) {
+    auto& shape = elements[i]->shape();
+    buffer.writeUInt8(static_cast<uint8_t>(shape.type()));
+    switch (shape.type()) {
+      case GeometryShape::Type::Rect:
+        buffer.writeRect(shape.rect());
+        break;
+      case GeometryShape::Type::RRect:
+        buffer.writeRect(shape.rRect().rect());
+        for (auto& radius : shape.rRect().radii()) {
+          buffer.writePoint(radius);
+        }
+        break;
+      case GeometryShape::Type::Path:
+        buffer.writeVarint(pathIDs[i]);
+        break;
+      default:
+        break;
+    }
+    buffer.writeMatrix(elements[i]->matrix());
+    buffer.writeBool(elements[i]->antiAlias());
+  }
+  return true;
+}
+
+bool PictureWriter::writePicture(const Picture* picture, uint32_t* id) {
+  if (findObject(PictureObjectType::Picture, picture, id)) {
+    return true;
+  }
+  PictureBufferWriter records = {};
+  LocalObjects locals = {};
+  bool success = true;
+  picture->forEachRecord([&](const PictureRecord* record) {
+    success = writeRecord(record, &records, &locals);
+    return success;
+  });
+  if (!success) {
+    return false;
+  }
+  auto bounds = picture->getBounds();
+  *id = beginObject(PictureObjectType::Picture, picture);
+  buffer.writeRect(bounds);
+  for (auto& localIDs : locals.objectIDs) {
+    buffer.writeVarint(static_cast<uint32_t>(localIDs.size()));
+    for (auto objectID : localIDs) {
+      buffer.writeVarint(objectID);
+    }
+  }
+  buffer.writeVarint(static_cast<uint32_t>(records.size()));
+  buffer.writeBytes(records.data(), records.size());
+  return true;
+}
+
+bool PictureWriter::writeBrush(const Brush& brush, PictureBufferWriter* writer,
+                               LocalObjects* locals) {
+  // Optional references are stored as local index + 1, where zero means no object.
+  uint32_t shaderID = 0;
+  uint32_t maskFilterID = 0;
+  uint32_t colorFilterID = 0;
+  if (brush.shader) {
+    if (!writeShader(brush.shader, &shaderID)) {
+      return false;
+    }
+    shaderID = locals->getLocalID(PictureObjectType::Shader, shaderID) + 1;
+  }
+  if (brush.maskFilter) {
+    if (!writeMaskFilter(brush.maskFilter, &maskFilterID)) {
+      return false;
+    }
+    maskFilterID = locals->getLocalID(PictureObjectType::MaskFilter, maskFilterID) + 1;
+  }
+  if (brush.colorFilter) {
+    if (!writeColorFilter(brush.colorFilter, &colorFilterID)) {
+      return false;
+    }
+    colorFilterID = locals->getLocalID(PictureObjectType::ColorFilter, colorFilterID) + 1;
+  }
+  writer->writeColor(brush.color);
+  writer->writeUInt8(static_cast<uint8_t>(brush.blendMode));
+  writer->writeBool(brush.antiAlias);
+  writer->writeVarint(shaderID);
+  writer->writeVarint(maskFilterID);
+  writer->writeVarint(colorFilterID);
+  return true;
+}
+
+bool PictureWriter::writeRecord(const PictureRecord* record, PictureBufferWriter* writer,
+                                LocalObjects* locals) {
+  auto type = record->type();
+  uint32_t id = 0;
+  switch (type) {
+    case PictureRecordType::SetMatrix:
+      writer->writeUInt8(static_cast<uint8_t>(type));
+      writer->writeMatrix(static_cast<const SetMatrix*>(record)->matrix);
+      return true;
+    case PictureRecordType::SetClip:
+      if (!writeClip(static_cast<const SetClip*>(record)->clip, &id)) {
+        return false;
+      }
+      writer->writeUInt8(static_cast<uint8_t>(type));
+      writer->writeVarint(locals->getLocalID(PictureObjectType::Clip, id));
+      return true;
+    case PictureRecordType::SetColor:
+      writer->writeUInt8(static_cast<uint8_t>(type));
+      writer->writeColor(static_cast<const SetColor*>(record)->color);
+      return true;
+    case PictureRecordType::SetFill: {
+      PictureBufferWriter brushWriter = {};
+      if (!writeBrush(static_cast<const SetBrush*>(record)->brush, &brushWriter, locals)) {
+        return false;
+      }
+      writer->writeUInt8(static_cast<uint8_t>(type));
+      writer->writeBytes(brushWriter.data(), brushWriter.size());
+      return true;
+    }
+    case PictureRecordType::SetStrokeWidth:
+      writer->writeUInt8(static_cast<uint8_t>(type));
+      writer->writeFloat(static_cast<const SetStrokeWidth*>(record)->width);
+      return true;
+    case PictureRecordType::SetStroke: {
+      auto& stroke = static_cast<const SetStroke*>(record)->stroke;
+      writer->writeUInt8(static_cast<uint8_t>(type));
+      writer->writeFloat(stroke.width);
+      writer->writeUInt8(static_cast<uint8_t>(stroke.cap));
+      writer->writeUInt8(static_cast<uint8_t>(stroke.join));
+      writer->writeFloat(stroke.miterLimit);
+      return true;
+    }
+    case PictureRecordType::SetHasStroke:
+      writer->writeUInt8(static_cast<uint8_t>(type));
+      writer->writeBool(static_cast<const SetHasStroke*>(record)->hasStroke);
+      return true;
+    case PictureRecordType::DrawFill:
+      writer->writeUInt8(static_cast<uint8_t>(type));
+      return true;
+    case PictureRecordType::DrawRect:
+      writer->writeUInt8(static_cast<uint8_t>(type));
+      writer->writeRect(static_cast<const DrawRect*>(record)->rect);
+      return true;
+    case PictureRecordType::DrawRRect: {
+      auto& rRect = static_cast<const DrawRRect*>(record)->rRect;
+      writer->writeUInt8(static_cast<uint8_t>(type));
+      writer->writeRect(rRect.rect());
+      for (auto& radius : rRect.radii()) {
+        writer->writePoint(radius);
+      }
+      return true;
+    }
+    case PictureRecordType::DrawPath:
+      if (!writePath(static_cast<const DrawPath*>(record)->path, &id)) {
+        return false;
+      }
+      writer->writeUInt8(static_cast<uint8_t>(type));
+      writer->writeVarint(locals->getLocalID(PictureObjectType::Path, id));
+      return true;
+    case PictureRecordType::DrawShape:
+      if (!writeShape(static_cast<const DrawShape*>(record)->shape, &id)) {
+        return false;
+      }
+      writer->writeUInt8(static_cast<uint8_t>(type));
+      writer->writeVarint(locals->getLocalID(PictureObjectType::Shape, id));
+      return true;
+    case PictureRecordType::DrawImage:
+    case PictureRecordType::DrawImageRect:
+    case PictureRecordType::DrawImageRectToRect: {
+      auto imageRecord = static_cast<const DrawImage*>(record);
+      if (!writeImage(imageRecord->image, &id)) {
+        return false;
+      }
+      writer->writeUInt8(static_cast<uint8_t>(type));
+      writer->writeVarint(locals->getLocalID(PictureObjectType::Image, id));
+      WriteSampling(imageRecord->sampling, writer);
+      if (type == PictureRecordType::DrawImage) {
+        return true;
+      }
+      auto rectRecord = static_cast<const DrawImageRect*>(record);
+      writer->writeRect(rectRecord->rect);
+      writer->writeUInt8(static_cast<uint8_t>(rectRecord->constraint));
+      writer->writeBool(!rectRecord->strictRect.isEmpty());
+      if (!rectRecord->strictRect.isEmpty()) {
+        writer->writeRect(rectRecord->strictRect);
+      }
+      if (type == PictureRecordType::DrawImageRectToRect) {
+        writer->writeRect(static_cast<const DrawImageRectToRect*>(record)->dstRect);
+      }
+      return true;
+    }
+    case PictureRecordType::DrawTextBlob:
+      if (!writeTextBlob(static_cast<const DrawTextBlob*>(record)->textBlob, &id)) {
+        return false;
+      }
+      writer->writeUInt8(static_cast<uint8_t>(type));
+      writer->writeVarint(locals->getLocalID(PictureObjectType::TextBlob, id));
+      return true;
+    case PictureRecordType::DrawPicture:
+      if (!writePicture(static_cast<const DrawPicture*>(record)->picture.get(), &id)) {
+        return false;
+      }
+      writer->writeUInt8(static_cast<uint8_t>(type));
+      writer->writeVarint(locals->getLocalID(PictureObjectType::Picture, id));
+      return true;
+    case PictureRecordType::DrawLayer: {
+      auto layerRecord = static_cast<const DrawLayer*>(record);
+      uint32_t filterID = 0;
+      if (!writePicture(layerRecord->picture.get(), &id)) {
+        return false;
+      }
+      if (layerRecord->filter) {
+        if (!writeImageFilter(layerRecord->filter, &filterID)) {
+          return false;
+        }
+        filterID = locals->getLocalID(PictureObjectType::ImageFilter, filterID) + 1;
+      }
+      writer->writeUInt8(static_cast<uint8_t>(type));
+      writer->writeVarint(locals->getLocalID(PictureObjectType::Picture, id));
+      writer->writeVarint(filterID);
+      return true;
+    }
+    case PictureRecordType::DrawMesh:
+      break;
+  }
+  LOGE("PictureWriter::writeRecord() Unsupported record type: %d", static_cast<int>(type));
+  return false;
+}
+}  // namespace tgfx
@@ -0,0 +1,85 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <unordered_map>
+#include "core/PictureFormat.h"
+#include "core/PictureRecords.h"
+#include "tgfx/core/Data.h"
+#include "tgfx/core/Picture.h"
+#include "tgfx/core/TextBlob.h"
+#include "tgfx/core/Typeface.h"
+
+namespace tgfx {
+/**
+ * PictureWriter serializes a Picture into the compact binary format described in PictureFormat.h.
+ * Shared objects referenced by multiple records or nested pictures, such as paths, images,
+ * typefaces and text blobs, are written only once.
+ */
+class PictureWriter {
+ public:
+  /**
+   * Serializes the given Picture. Returns nullptr if the Picture contains content that cannot be
+   * serialized, such as meshes, texture-backed images or runtime effects.
+   */
+  static std::shared_ptr<Data> Serialize(const Picture* picture);
+
+ private:
+  struct LocalObjects;
+
+  PictureBufferWriter buffer = {};
+  std::array<std::unordered_map<const void*, uint32_t>, PICTURE_OBJECT_TYPE_COUNT> objectIDs = {};
+  std::array<uint32_t, PICTURE_OBJECT_TYPE_COUNT> objectCounts = {};
+  std::unordered_map<uint32_t, uint32_t> clipIDs = {};
+  // Keeps the written paths alive so that their addresses can't be reused by other paths.
+  std::vector<Path> retainedPaths = {};
+
+  bool findObject(PictureObjectType type, const void* object, uint32_t* id) const;
+
+  uint32_t beginObject(PictureObjectType type, const void* object);
+
+  bool writeTypeface(const std::shared_ptr<Typeface>& typeface, uint32_t* id);
+
+  bool writePath(const Path& path, uint32_t* id);
+
+  bool writeShape(const std::shared_ptr<Shape>& shape, uint32_t* id);
+
+  bool writeTextBlob(const std::shared_ptr<TextBlob>& textBlob, uint32_t* id);
+
+  bool writeImage(const std::shared_ptr<Image>& image, uint32_t* id);
+
+  bool writeShader(const std::shared_ptr<Shader>& shader, uint32_t* id);
+
+  bool writeColorFilter(const std::shared_ptr<ColorFilter>& colorFilter, uint32_t* id);
+
+  bool writeMaskFilter(const std::shared_ptr<MaskFilter>& maskFilter, uint32_t* id);
+
+  bool writeImageFilter(const std::shared_ptr<ImageFilter>& imageFilter, uint32_t* id);
+
+  bool writeClip(const ClipStack& clip, uint32_t* id);
+
+  bool writePicture(const Picture* picture, uint32_t* id);
+
+  bool writeRecord(const PictureRecord* record, PictureBufferWriter* writer,
+                   LocalObjects* locals);
+
+  bool writeBrush(const Brush& brush, PictureBufferWriter* writer, LocalObjects* locals);
+};
+}  // namespace tgfx
@@ -0,0 +1,142 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tgfx/core/ProgressiveCodec.h"
+#include "core/PixelBuffer.h"
+#include "core/ProgressiveDecoder.h"
+#include "core/images/ProgressiveImage.h"
+#include "core/utils/GrowableStream.h"
+#include "tgfx/core/Pixmap.h"
+
+namespace tgfx {
+std::shared_ptr<ProgressiveCodec> ProgressiveCodec::Make() {
+  auto codec = std::shared_ptr<ProgressiveCodec>(new ProgressiveCodec());
+  codec->weakThis = codec;
+  return codec;
+}
+
+ProgressiveCodec::ProgressiveCodec() : stream(std::make_unique<GrowableStream>()) {
+}
+
+ProgressiveCodec::~ProgressiveCodec() = default;
+
+bool ProgressiveCodec::appendData(const void* bytes, size_t length) {
+  if (bytes == nullptr || length == 0) {
+    return false;
+  }
+  if (!stream->append(bytes, length)) {
+    return false;
+  }
+  std::lock_guard<std::mutex> autoLock(locker);
+  return checkHeader();
+}
+
+void ProgressiveCodec::finish() {
+  stream->finish();
+  std::lock_guard<std::mutex> autoLock(locker);
+  checkHeader();
+}
+
+bool ProgressiveCodec::isFinished() const {
+  return stream->isFinished();
+}
+
+size_t ProgressiveCodec::bytesReceived() const {
+  return stream->size();
+}
+
+int ProgressiveCodec::width() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return pixels.isEmpty() ? 0 : decoder->width();
+}
+
+int ProgressiveCodec::height() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return pixels.isEmpty() ? 0 : decoder->height();
+}
+
+Orientation ProgressiveCodec::orientation() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return pixels.isEmpty() ? Orientation::TopLeft : decoder->orientation();
+}
+
+bool ProgressiveCodec::isComplete() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return decoder && decoder->isComplete();
+}
+
+bool ProgressiveCodec::checkHeader() {
+  if (unsupported) {
+    return false;
+  }
+  if (decoder == nullptr) {
+    decoder = ProgressiveDecoder::Make(stream.get());
+    if (decoder == nullptr) {
+      // Wait for enough bytes to recognize the format, unless no more bytes are coming.
+      unsupported = stream->size() >= PROGRESSIVE_FORMAT_HEADER_SIZE || stream->isFinished();
+      return !unsupported;
+    }
+  }
+  if (!pixels.isEmpty() || !decoder->readHeader(stream.get())) {
+    return !decoder->hasFailed();
+  }
+  if (!ImageInfo::IsValidSize(decoder->width(), decoder->height())) {
+    unsupported = true;
+    return false;
+  }
+  // Rows that have not arrived yet stay transparent.
+  auto rowBytes = static_cast<size_t>(decoder->width()) * 4;
+  auto byteSize = rowBytes * static_cast<size_t>(decoder->height());
+  if (!pixels.alloc(byteSize)) {
+    unsupported = true;
+    return false;
+  }
+  pixels.clear();
+  return true;
+}
+
+std::shared_ptr<ImageBuffer> ProgressiveCodec::makeBuffer(bool tryHardware) const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (pixels.isEmpty()) {
+    return nullptr;
+  }
+  auto width = decoder->width();
+  auto height = decoder->height();
+  auto rowBytes = static_cast<size_t>(width) * 4;
+  // A failed decoder keeps the pixels it has decoded before the failure.
+  decoder->decode(stream.get(), pixels.data(), rowBytes);
+  auto pixelBuffer = PixelBuffer::Make(width, height, false, tryHardware);
+  if (pixelBuffer == nullptr) {
+    return nullptr;
+  }
+  auto srcInfo =
+      ImageInfo::Make(width, height, ColorType::RGBA_8888, decoder->alphaType(), rowBytes);
+  auto dstPixels = pixelBuffer->lockPixels();
+  auto result = Pixmap(srcInfo, pixels.data()).readPixels(pixelBuffer->info(), dstPixels);
+  pixelBuffer->unlockPixels();
+  return result ? pixelBuffer : nullptr;
+}
+
+std::shared_ptr<Image> ProgressiveCodec::makeImage() const {
+  auto image = ProgressiveImage::MakeFrom(weakThis.lock());
+  if (image == nullptr) {
+    return nullptr;
+  }
+  return image->makeOriented(orientation());
+}
+}  // namespace tgfx
@@ -0,0 +1,63 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ProgressiveDecoder.h"
+#include "tgfx/core/Data.h"
+
+#ifdef TGFX_USE_WEBP_DECODE
+#include "core/codecs/webp/WebpCodec.h"
+#include "core/codecs/webp/WebpProgressiveDecoder.h"
+#endif
+
+#ifdef TGFX_USE_PNG_DECODE
+#include "core/codecs/png/PngCodec.h"
+#include "core/codecs/png/PngProgressiveDecoder.h"
+#endif
+
+#ifdef TGFX_USE_JPEG_DECODE
+#include "core/codecs/jpeg/JpegCodec.h"
+#include "core/codecs/jpeg/JpegProgressiveDecoder.h"
+#endif
+
+namespace tgfx {
+std::unique_ptr<ProgressiveDecoder> ProgressiveDecoder::Make(const GrowableStream* stream) {
+  uint8_t header[PROGRESSIVE_FORMAT_HEADER_SIZE] = {};
+  auto length = stream->peek(header, PROGRESSIVE_FORMAT_HEADER_SIZE);
+  if (length == 0) {
+    return nullptr;
+  }
+  auto data = Data::MakeWithCopy(header, length);
+  std::unique_ptr<ProgressiveDecoder> decoder = nullptr;
+#ifdef TGFX_USE_WEBP_DECODE
+  if (WebpCodec::IsWebp(data)) {
+    decoder = std::make_unique<WebpProgressiveDecoder>();
+  }
+#endif
+#ifdef TGFX_USE_PNG_DECODE
+  if (PngCodec::IsPng(data)) {
+    decoder = std::make_unique<PngProgressiveDecoder>();
+  }
+#endif
+#ifdef TGFX_USE_JPEG_DECODE
+  if (JpegCodec::IsJpeg(data)) {
+    decoder = std::make_unique<JpegProgressiveDecoder>();
+  }
+#endif
+  return decoder;
+}
+}  // namespace tgfx
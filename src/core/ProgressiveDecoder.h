@@ -0,0 +1,112 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include "core/utils/GrowableStream.h"
+#include "tgfx/core/AlphaType.h"
+#include "tgfx/core/Orientation.h"
+
+namespace tgfx {
+/**
+ * The number of leading bytes that is enough to recognize every supported format.
+ */
+static constexpr size_t PROGRESSIVE_FORMAT_HEADER_SIZE = 14;
+
+/**
+ * ProgressiveDecoder decodes an encoded image from a GrowableStream while its bytes are still
+ * arriving. It keeps its decoding state between calls, so each call to decode() only processes the
+ * bytes received since the previous call. ProgressiveDecoder is not thread safe.
+ */
+class ProgressiveDecoder {
+ public:
+  /**
+   * Creates a ProgressiveDecoder for the format recognized from the leading bytes of the stream.
+   * Returns nullptr if the format is not supported or not enough bytes have arrived to tell.
+   */
+  static std::unique_ptr<ProgressiveDecoder> Make(const GrowableStream* stream);
+
+  virtual ~ProgressiveDecoder() = default;
+
+  /**
+   * Returns the width of the image, or 0 if the header has not been read yet.
+   */
+  int width() const {
+    return _width;
+  }
+
+  /**
+   * Returns the height of the image, or 0 if the header has not been read yet.
+   */
+  int height() const {
+    return _height;
+  }
+
+  /**
+   * Returns the alpha type of the decoded RGBA_8888 pixels.
+   */
+  AlphaType alphaType() const {
+    return _alphaType;
+  }
+
+  /**
+   * Returns the orientation recorded in the image header.
+   */
+  Orientation orientation() const {
+    return _orientation;
+  }
+
+  /**
+   * Returns true if the decoder has reached the end of the image. A finished JPEG stream always
+   * reaches it, since libjpeg fills the rows of a truncated file in gray.
+   */
+  bool isComplete() const {
+    return complete;
+  }
+
+  /**
+   * Returns true if the encoded bytes turned out to be invalid. No more pixels are decoded after a
+   * failure.
+   */
+  bool hasFailed() const {
+    return failed;
+  }
+
+  /**
+   * Reads the image header from the stream. Returns true once the width and height are known.
+   */
+  virtual bool readHeader(GrowableStream* stream) = 0;
+
+  /**
+   * Decodes the bytes received so far into pixels, an RGBA_8888 buffer of width() x height() with
+   * the given rowBytes. The same buffer must be passed to every call, and the decoder only writes
+   * the rows (or scans) that the new bytes complete, leaving the rest of the buffer untouched.
+   * Returns false if the decoding has failed.
+   */
+  virtual bool decode(GrowableStream* stream, void* pixels, size_t rowBytes) = 0;
+
+ protected:
+  int _width = 0;
+  int _height = 0;
+  AlphaType _alphaType = AlphaType::Unpremultiplied;
+  Orientation _orientation = Orientation::TopLeft;
+  bool complete = false;
+  bool failed = false;
+};
+}  // namespace tgfx
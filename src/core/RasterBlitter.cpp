@@ -0,0 +1,1046 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "RasterBlitter.h"
+#include <algorithm>
+#include <cmath>
+#include "core/PixelBuffer.h"
+#include "core/RasterBlitterSIMD.h"
+#include "core/RasterDrawContext.h"
+#include "core/filters/AlphaThresholdColorFilter.h"
+#include "core/filters/ComposeColorFilter.h"
+#include "core/filters/MatrixColorFilter.h"
+#include "core/filters/ShaderMaskFilter.h"
+#include "core/images/BufferImage.h"
+#include "core/images/CodecImage.h"
+#include "core/images/GeneratorImage.h"
+#include "core/images/OrientImage.h"
+#include "core/images/PictureImage.h"
+#include "core/images/RasterizedImage.h"
+#include "core/images/ScaledImage.h"
+#include "core/images/SubsetImage.h"
+#include "core/shaders/BlendShader.h"
+#include "core/shaders/ColorFilterShader.h"
+#include "core/shaders/ColorShader.h"
+#include "core/shaders/GradientShader.h"
+#include "core/shaders/ImageShader.h"
+#include "core/shaders/MatrixShader.h"
+#include "core/utils/Types.h"
+
+namespace tgfx {
+static const PMColor OpaqueWhite = {1.0f, 1.0f, 1.0f, 1.0f};
+static const PMColor TransparentBlack = {0.0f, 0.0f, 0.0f, 0.0f};
+
+static float Clamp01(float value) {
+  return std::min(std::max(value, 0.0f), 1.0f);
+}
+
+static uint8_t ToByte(float value) {
+  return static_cast<uint8_t>(Clamp01(value) * 255.0f + 0.5f);
+}
+
+static PMColor Scale(const PMColor& color, float scale) {
+  return {color.red * scale, color.green * scale, color.blue * scale, color.alpha * scale};
+}
+
+static PMColor ReadPixel(const uint8_t* pixel, bool bgra) {
+  constexpr float Inv255 = 1.0f / 255.0f;
+  auto red = static_cast<float>(pixel[bgra ? 2 : 0]) * Inv255;
+  auto blue = static_cast<float>(pixel[bgra ? 0 : 2]) * Inv255;
+  return {red, static_cast<float>(pixel[1]) * Inv255, blue, static_cast<float>(pixel[3]) * Inv255};
+}
+
+static void WritePixel(const PMColor& color, bool bgra, uint8_t* pixel) {
+  pixel[bgra ? 2 : 0] = ToByte(color.red);
+  pixel[1] = ToByte(color.green);
+  pixel[bgra ? 0 : 2] = ToByte(color.blue);
+  pixel[3] = ToByte(color.alpha);
+}
+
+//========================================= Blend Modes ===========================================
+
+static float Luminance(const float* rgb) {
+  return 0.3f * rgb[0] + 0.59f * rgb[1] + 0.11f * rgb[2];
+}
+
+// Sets the luminance of hueSat to the luminance of lumColor, keeping the result within alpha.
+static void SetLuminance(float* hueSat, float alpha, const float* lumColor) {
+  float delta[3] = {lumColor[0] - hueSat[0], lumColor[1] - hueSat[1], lumColor[2] - hueSat[2]};
+  auto diff = Luminance(delta);
+  for (int i = 0; i < 3; i++) {
+    hueSat[i] += diff;
+  }
+  auto outLum = Luminance(hueSat);
+  auto minComp = std::min({hueSat[0], hueSat[1], hueSat[2]});
+  auto maxComp = std::max({hueSat[0], hueSat[1], hueSat[2]});
+  if (minComp < 0.0f && outLum != minComp) {
+    for (int i = 0; i < 3; i++) {
+      hueSat[i] = outLum + (hueSat[i] - outLum) * outLum / (outLum - minComp);
+    }
+  }
+  if (maxComp > alpha && maxComp != outLum) {
+    for (int i = 0; i < 3; i++) {
+      hueSat[i] = outLum + (hueSat[i] - outLum) * (alpha - outLum) / (maxComp - outLum);
+    }
+  }
+}
+
+// Sets the saturation of hueLum to the saturation of satColor.
+static void SetSaturation(float* hueLum, const float* satColor) {
+  auto sat = std::max({satColor[0], satColor[1], satColor[2]}) -
+             std::min({satColor[0], satColor[1], satColor[2]});
+  int order[3] = {0, 1, 2};
+  std::sort(order, order + 3, [hueLum](int a, int b) { return hueLum[a] < hueLum[b]; });
+  auto minComp = hueLum[order[0]];
+  auto midComp = hueLum[order[1]];
+  auto maxComp = hueLum[order[2]];
+  if (minComp < maxComp) {
+    hueLum[order[1]] = sat * (midComp - minComp) / (maxComp - minComp);
+    hueLum[order[2]] = sat;
+  } else {
+    hueLum[order[1]] = 0.0f;
+    hueLum[order[2]] = 0.0f;
+  }
+  hueLum[order[0]] = 0.0f;
+}
+
+static float HardLight(float s, float sa, float d, float da) {
+  float result = 0.0f;
+  if (2.0f * s < sa) {
+    result = 2.0f * s * d;
+  } else {
+    result = sa * da - 2.0f * (da - d) * (sa - s);
+  }
+  return result + s * (1.0f - da) + d * (1.0f - sa);
+}
+
+static float ColorDodge(float s, float sa, float d, float da) {
+  if (d == 0.0f) {
+    return s * (1.0f - da);
+  }
+  auto delta = sa - s;
+  if (delta == 0.0f) {
+    return sa * da + s * (1.0f - da) + d * (1.0f - sa);
+  }
+  delta = std::min(da, d * sa / delta);
+  return delta * sa + s * (1.0f - da) + d * (1.0f - sa);
+}
+
+static float ColorBurn(float s, float sa, float d, float da) {
+  if (da == d) {
+    return sa * da + s * (1.0f - da) + d * (1.0f - sa);
+  }
+  if (s == 0.0f) {
+    return d * (1.0f - sa);
+  }
+  auto delta = std::max(0.0f, da - (da - d) * sa / s);
+  return sa * delta + s * (1.0f - da) + d * (1.0f - sa);
+}
+
+static float SoftLight(float s, float sa, float d, float da) {
+  if (2.0f * s <= sa) {
+    return d * d * (sa - 2.0f * s) / da + (1.0f - da) * s + d * (-sa + 2.0f * s + 1.0f);
+  }
+  if (4.0f * d <= da) {
+    auto dSqd = d * d;
+    auto dCub = dSqd * d;
+    auto daSqd = da * da;
+    auto daCub = daSqd * da;
+    return (daSqd * (s - d * (3.0f * sa - 6.0f * s - 1.0f)) + 12.0f * da * dSqd * (sa - 2.0f * s) -
+            16.0f * dCub * (sa - 2.0f * s) - daCub * s) /
+           daSqd;
+  }
+  return d * (sa - 2.0f * s + 1.0f) + s - std::sqrt(da * d) * (sa - 2.0f * s) - da * s;
+}
+
+// Blends the premultiplied colors with the same formulas as the GPU backend.
+static PMColor BlendColors(BlendMode mode, const PMColor& src, const PMColor& dst) {
+  auto sa = src.alpha;
+  auto da = dst.alpha;
+  PMColor result = TransparentBlack;
+  switch (mode) {
+    case BlendMode::Clear:
+      return TransparentBlack;
+    case BlendMode::Src:
+      return src;
+    case BlendMode::Dst:
+      return dst;
+    case BlendMode::SrcOver:
+      for (int i = 0; i < 4; i++) {
+        result[i] = src[i] + dst[i] * (1.0f - sa);
+      }
+      return result;
+    case BlendMode::DstOver:
+      for (int i = 0; i < 4; i++) {
+        result[i] = dst[i] + src[i] * (1.0f - da);
+      }
+      return result;
+    case BlendMode::SrcIn:
+      return Scale(src, da);
+    case BlendMode::DstIn:
+      return Scale(dst, sa);
+    case BlendMode::SrcOut:
+      return Scale(src, 1.0f - da);
+    case BlendMode::DstOut:
+      return Scale(dst, 1.0f - sa);
+    case BlendMode::SrcATop:
+      for (int i = 0; i < 4; i++) {
+        result[i] = src[i] * da + dst[i] * (1.0f - sa);
+      }
+      return result;
+    case BlendMode::DstATop:
+      for (int i = 0; i < 4; i++) {
+        result[i] = dst[i] * sa + src[i] * (1.0f - da);
+      }
+      return result;
+    case BlendMode::Xor:
+      for (int i = 0; i < 4; i++) {
+        result[i] = src[i] * (1.0f - da) + dst[i] * (1.0f - sa);
+      }
+      return result;
+    case BlendMode::PlusLighter:
+      for (int i = 0; i < 4; i++) {
+        result[i] = std::min(src[i] + dst[i], 1.0f);
+      }
+      return result;
+    case BlendMode::Modulate:
+      for (int i = 0; i < 4; i++) {
+        result[i] = src[i] * dst[i];
+      }
+      return result;
+    case BlendMode::Screen:
+      for (int i = 0; i < 4; i++) {
+        result[i] = src[i] + dst[i] - src[i] * dst[i];
+      }
+      return result;
+    default:
+      break;
+  }
+  // The remaining modes all perform src-over on the alpha channel.
+  result.alpha = sa + (1.0f - sa) * da;
+  float s[3] = {src.red, src.green, src.blue};
+  float d[3] = {dst.red, dst.green, dst.blue};
+  float out[3] = {};
+  switch (mode) {
+    case BlendMode::Overlay:
+      for (int i = 0; i < 3; i++) {
+        out[i] = HardLight(d[i], da, s[i], sa);
+      }
+      break;
+    case BlendMode::Darken:
+      for (int i = 0; i < 3; i++) {
+        out[i] = std::min((1.0f - sa) * d[i] + s[i], (1.0f - da) * s[i] + d[i]);
+      }
+      break;
+    case BlendMode::Lighten:
+      for (int i = 0; i < 3; i++) {
+        out[i] = std::max((1.0f - sa) * d[i] + s[i], (1.0f - da) * s[i] + d[i]);
+      }
+      break;
+    case BlendMode::ColorDodge:
+      for (int i = 0; i < 3; i++) {
+        out[i] = ColorDodge(s[i], sa, d[i], da);
+      }
+      break;
+    case BlendMode::ColorBurn:
+      for (int i = 0; i < 3; i++) {
+        out[i] = ColorBurn(s[i], sa, d[i], da);
+      }
+      break;
+    case BlendMode::HardLight:
+      for (int i = 0; i < 3; i++) {
+        out[i] = HardLight(s[i], sa, d[i], da);
+      }
+      break;
+    case BlendMode::SoftLight:
+      if (da == 0.0f) {
+        return src;
+      }
+      for (int i = 0; i < 3; i++) {
+        out[i] = SoftLight(s[i], sa, d[i], da);
+      }
+      break;
+    case BlendMode::Difference:
+      for (int i = 0; i < 3; i++) {
+        out[i] = s[i] + d[i] - 2.0f * std::min(s[i] * da, d[i] * sa);
+      }
+      break;
+    case BlendMode::Exclusion:
+      for (int i = 0; i < 3; i++) {
+        out[i] = d[i] + s[i] - 2.0f * d[i] * s[i];
+      }
+      break;
+    case BlendMode::Multiply:
+      for (int i = 0; i < 3; i++) {
+        out[i] = (1.0f - sa) * d[i] + (1.0f - da) * s[i] + s[i] * d[i];
+      }
+      break;
+    case BlendMode::Hue:
+    case BlendMode::Saturation:
+    case BlendMode::Color:
+    case BlendMode::Luminosity: {
+      float srcDstAlpha[3] = {s[0] * da, s[1] * da, s[2] * da};
+      float dstSrcAlpha[3] = {d[0] * sa, d[1] * sa, d[2] * sa};
+      if (mode == BlendMode::Hue) {
+        std::copy(srcDstAlpha, srcDstAlpha + 3, out);
+        SetSaturation(out, dstSrcAlpha);
+        SetLuminance(out, sa * da, dstSrcAlpha);
+      } else if (mode == BlendMode::Saturation) {
+        std::copy(dstSrcAlpha, dstSrcAlpha + 3, out);
+        SetSaturation(out, srcDstAlpha);
+        SetLuminance(out, sa * da, dstSrcAlpha);
+      } else if (mode == BlendMode::Color) {
+        std::copy(srcDstAlpha, srcDstAlpha + 3, out);
+        SetLuminance(out, sa * da, dstSrcAlpha);
+      } else {
+        std::copy(dstSrcAlpha, dstSrcAlpha + 3, out);
+        SetLuminance(out, sa * da, srcDstAlpha);
+      }
+      for (int i = 0; i < 3; i++) {
+        out[i] += (1.0f - sa) * d[i] + (1.0f - da) * s[i];
+      }
+      break;
+    }
+    case BlendMode::PlusDarker:
+      for (int i = 0; i < 3; i++) {
+        out[i] = Clamp01(1.0f + s[i] + d[i] - da - sa);
+        out[i] *= result.alpha > 0.0f ? 1.0f : 0.0f;
+      }
+      break;
+    default:
+      break;
+  }
+  result.red = out[0];
+  result.green = out[1];
+  result.blue = out[2];
+  return result;
+}
+
+//======================================== Color Filters ==========================================
+
+static void FilterWithMatrix(const std::array<float, 20>& matrix, PMColor* colors, int count) {
+  for (int i = 0; i < count; i++) {
+    auto& color = colors[i];
+    auto alpha = std::max(color.alpha, 1e-4f);
+    float input[4] = {color.red / alpha, color.green / alpha, color.blue / alpha, color.alpha};
+    float output[4] = {};
+    for (int row = 0; row < 4; row++) {
+      auto m = matrix.data() + row * 5;
+      output[row] = Clamp01(m[0] * input[0] + m[1] * input[1] + m[2] * input[2] +
+                            m[3] * input[3] + m[4]);
+    }
+    color = {output[0] * output[3], output[1] * output[3], output[2] * output[3], output[3]};
+  }
+}
+
+static void FilterWithAlphaThreshold(float threshold, PMColor* colors, int count) {
+  for (int i = 0; i < count; i++) {
+    auto& color = colors[i];
+    if (color.alpha <= 0.0f) {
+      color = TransparentBlack;
+      continue;
+    }
+    auto alpha = color.alpha >= threshold ? 1.0f : 0.0f;
+    color = {Clamp01(color.red / color.alpha), Clamp01(color.green / color.alpha),
+             Clamp01(color.blue / color.alpha), alpha};
+  }
+}
+
+bool FilterColors(const ColorFilter* colorFilter, PMColor* colors, int count) {
+  switch (Types::Get(colorFilter)) {
+    case Types::ColorFilterType::Blend: {
+      Color filterColor = {};
+      BlendMode mode = BlendMode::SrcOver;
+      if (!colorFilter->asColorMode(&filterColor, &mode)) {
+        return false;
+      }
+      auto src = filterColor.premultiply();
+      for (int i = 0; i < count; i++) {
+        colors[i] = BlendColors(mode, src, colors[i]);
+      }
+      return true;
+    }
+    case Types::ColorFilterType::Matrix:
+      FilterWithMatrix(static_cast<const MatrixColorFilter*>(colorFilter)->matrix, colors, count);
+      return true;
+    case Types::ColorFilterType::AlphaThreshold: {
+      auto threshold = static_cast<const AlphaThresholdColorFilter*>(colorFilter)->threshold;
+      FilterWithAlphaThreshold(threshold, colors, count);
+      return true;
+    }
+    case Types::ColorFilterType::Compose: {
+      auto composeFilter = static_cast<const ComposeColorFilter*>(colorFilter);
+      return FilterColors(composeFilter->inner.get(), colors, count) &&
+             FilterColors(composeFilter->outer.get(), colors, count);
+    }
+    case Types::ColorFilterType::Luma:
+      // The GPU backend uses the BT.709 factors for sRGB destinations.
+      for (int i = 0; i < count; i++) {
+        auto& color = colors[i];
+        auto luma = 0.2126f * color.red + 0.7152f * color.green + 0.0722f * color.blue;
+        color = {luma, luma, luma, luma};
+      }
+      return true;
+  }
+  return false;
+}
+
+//======================================== Image Decoding =========================================
+
+static std::shared_ptr<RasterPixels> MakePixels(int width, int height, bool alphaOnly) {
+  auto colorType = alphaOnly ? ColorType::ALPHA_8 : ColorType::RGBA_8888;
+  auto info = ImageInfo::Make(width, height, colorType, AlphaType::Premultiplied);
+  if (info.isEmpty()) {
+    return nullptr;
+  }
+  auto pixels = std::make_shared<RasterPixels>();
+  pixels->info = info;
+  pixels->buffer.resize(info.byteSize(), 0);
+  return pixels;
+}
+
+std::shared_ptr<RasterPixels> RasterImageCache::ReadImageBuffer(
+    std::shared_ptr<ImageBuffer> imageBuffer) {
+  if (imageBuffer == nullptr || !imageBuffer->isPixelBuffer()) {
+    return nullptr;
+  }
+  auto pixelBuffer = std::static_pointer_cast<PixelBuffer>(imageBuffer);
+  auto pixels = MakePixels(pixelBuffer->width(), pixelBuffer->height(), pixelBuffer->isAlphaOnly());
+  if (pixels == nullptr) {
+    return nullptr;
+  }
+  auto srcPixels = pixelBuffer->lockPixels();
+  if (srcPixels == nullptr) {
+    return nullptr;
+  }
+  Pixmap pixmap(pixelBuffer->info(), srcPixels);
+  auto success = pixmap.readPixels(pixels->info, pixels->buffer.data());
+  pixelBuffer->unlockPixels();
+  return success ? pixels : nullptr;
+}
+
+static std::shared_ptr<RasterPixels> ReadCodec(const std::shared_ptr<ImageCodec>& codec) {
+  if (codec == nullptr) {
+    return nullptr;
+  }
+  auto pixels = MakePixels(codec->width(), codec->height(), codec->isAlphaOnly());
+  if (pixels == nullptr || !codec->readPixels(pixels->info, pixels->buffer.data())) {
+    return nullptr;
+  }
+  return pixels;
+}
+
+static std::shared_ptr<RasterPixels> Resample(std::shared_ptr<RasterPixels> source, int width,
+                                              int height, const Matrix& dstToSource,
+                                              const SamplingOptions& sampling);
+
+std::shared_ptr<RasterPixels> RasterImageCache::getPixels(const std::shared_ptr<Image>& image) {
+  auto result = entries.find(image.get());
+  if (result != entries.end() && result->second.image.lock() == image) {
+    return result->second.pixels;
+  }
+  auto pixels = decode(image);
+  if (pixels == nullptr) {
+    return nullptr;
+  }
+  for (auto iter = entries.begin(); iter != entries.end();) {
+    if (iter->second.image.expired()) {
+      iter = entries.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  entries[image.get()] = {image, pixels};
+  return pixels;
+}
+
+std::shared_ptr<RasterPixels> RasterImageCache::decode(const std::shared_ptr<Image>& image) {
+  switch (Types::Get(image.get())) {
+    case Types::ImageType::Codec:
+      return ReadCodec(std::static_pointer_cast<CodecImage>(image)->getCodec());
+    case Types::ImageType::Buffer:
+      return ReadImageBuffer(std::static_pointer_cast<BufferImage>(image)->imageBuffer);
+    case Types::ImageType::Generator: {
+      auto generator = std::static_pointer_cast<GeneratorImage>(image)->generator;
+      if (generator->isImageCodec()) {
+        return ReadCodec(std::static_pointer_cast<ImageCodec>(generator));
+      }
+      return ReadImageBuffer(generator->makeBuffer(false));
+    }
+    case Types::ImageType::Rasterized:
+      return getPixels(std::static_pointer_cast<RasterizedImage>(image)->source);
+    case Types::ImageType::Subset: {
+      auto subsetImage = std::static_pointer_cast<SubsetImage>(image);
+      auto source = getPixels(subsetImage->source);
+      if (source == nullptr) {
+        return nullptr;
+      }
+      auto pixels = MakePixels(image->width(), image->height(), source->info.isAlphaOnly());
+      if (pixels == nullptr) {
+        return nullptr;
+      }
+      Pixmap pixmap(source->info, source->buffer.data());
+      auto left = static_cast<int>(subsetImage->bounds.left);
+      auto top = static_cast<int>(subsetImage->bounds.top);
+      pixmap.readPixels(pixels->info, pixels->buffer.data(), left, top);
+      return pixels;
+    }
+    case Types::ImageType::Scaled: {
+      auto scaledImage = std::static_pointer_cast<ScaledImage>(image);
+      auto source = getPixels(scaledImage->source);
+      if (source == nullptr) {
+        return nullptr;
+      }
+      auto matrix = Matrix::MakeScale(static_cast<float>(source->info.width()) /
+                                          static_cast<float>(image->width()),
+                                      static_cast<float>(source->info.height()) /
+                                          static_cast<float>(image->height()));
+      return Resample(std::move(source), image->width(), image->height(), matrix,
+                      SamplingOptions(FilterMode::Linear, MipmapMode::None));
+    }
+    case Types::ImageType::Orient: {
+      auto orientImage = std::static_pointer_cast<OrientImage>(image);
+      auto source = getPixels(orientImage->source);
+      if (source == nullptr) {
+        return nullptr;
+      }
+      auto matrix = OrientationToMatrix(orientImage->orientation, source->info.width(),
+                                        source->info.height());
+      if (!matrix.invert(&matrix)) {
+        return nullptr;
+      }
+      return Resample(std::move(source), image->width(), image->height(), matrix,
+                      SamplingOptions(FilterMode::Nearest, MipmapMode::None));
+    }
+    case Types::ImageType::Picture: {
+      auto pictureImage = std::static_pointer_cast<PictureImage>(image);
+      auto pixels = MakePixels(image->width(), image->height(), false);
+      if (pixels == nullptr) {
+        return nullptr;
+      }
+      RasterDrawContext drawContext(Pixmap(pixels->info, pixels->buffer.data()), this);
+      auto matrix = pictureImage->matrix ? *pictureImage->matrix : Matrix::I();
+      drawContext.drawPicture(pictureImage->picture, matrix, {});
+      return pixels;
+    }
+    default:
+      break;
+  }
+  reportUnsupported("RasterImageCache::decode() The image type can not be decoded on the CPU.");
+  return nullptr;
+}
+
+//=========================================== Shaders =============================================
+
+class ColorRasterShader : public RasterShader {
+ public:
+  explicit ColorRasterShader(const PMColor& color) : color(color) {
+  }
+
+  void shadeRow(int, int, int count, const PMColor& input, PMColor* colors) const override {
+    std::fill(colors, colors + count, Scale(color, input.alpha));
+  }
+
+ private:
+  PMColor color = {};
+};
+
+class GradientRasterShader : public RasterShader {
+ public:
+  GradientRasterShader(const GradientShader* shader, const Matrix& deviceToUnit)
+      : type(shader->asGradient(&info)), deviceToUnit(deviceToUnit) {
+    if (type == GradientType::Conic) {
+      // The start and end angles are stored in degrees.
+      auto t0 = info.radiuses[0] / 360.0f;
+      auto t1 = info.radiuses[1] / 360.0f;
+      bias = -t0;
+      scale = 1.0f / (t1 - t0);
+    }
+  }
+
+  void shadeRow(int x, int y, int count, const PMColor& input, PMColor* colors) const override {
+    for (int i = 0; i < count; i++) {
+      auto point = deviceToUnit.mapXY(static_cast<float>(x + i) + 0.5f,
+                                      static_cast<float>(y) + 0.5f);
+      colors[i] = Scale(colorAt(layout(point)), input.alpha);
+    }
+  }
+
+ private:
+  GradientInfo info = {};
+  GradientType type = GradientType::None;
+  Matrix deviceToUnit = {};
+  float bias = 0.0f;
+  float scale = 1.0f;
+
+  float layout(const Point& point) const {
+    switch (type) {
+      case GradientType::Radial:
+        return std::sqrt(point.x * point.x + point.y * point.y);
+      case GradientType::Conic: {
+        auto angle = std::atan2(-point.y, -point.x);
+        return (angle * 0.15915494309180001f + 0.5f + bias) * scale;
+      }
+      case GradientType::Diamond:
+        return std::max(std::fabs(point.x), std::fabs(point.y));
+      default:
+        return point.x;
+    }
+  }
+
+  PMColor colorAt(float t) const {
+    auto& colors = info.colors;
+    auto& positions = info.positions;
+    if (t <= 0.0f) {
+      return colors.front().premultiply();
+    }
+    if (t >= 1.0f) {
+      return colors.back().premultiply();
+    }
+    for (size_t i = 0; i + 1 < positions.size(); i++) {
+      if (t < positions[i + 1]) {
+        auto range = positions[i + 1] - positions[i];
+        auto weight = range > 0.0f ? (t - positions[i]) / range : 0.0f;
+        auto& start = colors[i];
+        auto& end = colors[i + 1];
+        Color color = {start.red + (end.red - start.red) * weight,
+                       start.green + (end.green - start.green) * weight,
+                       start.blue + (end.blue - start.blue) * weight,
+                       start.alpha + (end.alpha - start.alpha) * weight};
+        return color.premultiply();
+      }
+    }
+    return colors.back().premultiply();
+  }
+};
+
+class ImageRasterShader : public RasterShader {
+ public:
+  ImageRasterShader(std::shared_ptr<RasterPixels> pixels, TileMode tileModeX, TileMode tileModeY,
+                    const SamplingOptions& sampling, const Matrix& deviceToImage,
+                    const Rect& subset)
+      : pixels(std::move(pixels)), tileModeX(tileModeX), tileModeY(tileModeY),
+        deviceToImage(deviceToImage) {
+    // Each device pixel covers more than one texel when the image is minified.
+    auto filterMode =
+        deviceToImage.getMaxScale() > 1.0f ? sampling.minFilterMode : sampling.magFilterMode;
+    linear = filterMode == FilterMode::Linear;
+    auto bounds = Rect::MakeWH(this->pixels->info.width(), this->pixels->info.height());
+    if (!bounds.intersect(subset)) {
+      bounds.setEmpty();
+    }
+    bounds.roundOut();
+    left = static_cast<int>(bounds.left);
+    top = static_cast<int>(bounds.top);
+    right = static_cast<int>(bounds.right);
+    bottom = static_cast<int>(bounds.bottom);
+  }
+
+  void shadeRow(int x, int y, int count, const PMColor& input, PMColor* colors) const override {
+    if (left >= right || top >= bottom) {
+      std::fill(colors, colors + count, TransparentBlack);
+      return;
+    }
+    auto alphaOnly = pixels->info.isAlphaOnly();
+    for (int i = 0; i < count; i++) {
+      auto point = deviceToImage.mapXY(static_cast<float>(x + i) + 0.5f,
+                                       static_cast<float>(y) + 0.5f);
+      auto color = linear ? sampleLinear(point.x, point.y) : sampleNearest(point.x, point.y);
+      colors[i] = alphaOnly ? Scale(input, color.alpha) : Scale(color, input.alpha);
+    }
+  }
+
+ private:
+  std::shared_ptr<RasterPixels> pixels = nullptr;
+  TileMode tileModeX = TileMode::Clamp;
+  TileMode tileModeY = TileMode::Clamp;
+  Matrix deviceToImage = {};
+  bool linear = true;
+  int left = 0;
+  int top = 0;
+  int right = 0;
+  int bottom = 0;
+
+  // Maps the texel index into the domain [start, end), or returns -1 if it falls outside a decal
+  // domain.
+  static int Tile(int index, int start, int end, TileMode tileMode) {
+    auto size = end - start;
+    switch (tileMode) {
+      case TileMode::Repeat: {
+        auto offset = (index - start) % size;
+        return start + (offset < 0 ? offset + size : offset);
+      }
+      case TileMode::Mirror: {
+        auto period = 2 * size;
+        auto offset = (index - start) % period;
+        offset = offset < 0 ? offset + period : offset;
+        return start + (offset >= size ? period - 1 - offset : offset);
+      }
+      case TileMode::Decal:
+        return index >= start && index < end ? index : -1;
+      default:
+        return std::min(std::max(index, start), end - 1);
+    }
+  }
+
+  PMColor fetch(int column, int row) const {
+    auto tileX = Tile(column, left, right, tileModeX);
+    auto tileY = Tile(row, top, bottom, tileModeY);
+    if (tileX < 0 || tileY < 0) {
+      return TransparentBlack;
+    }
+    auto& info = pixels->info;
+    auto offset = static_cast<size_t>(tileY) * info.rowBytes() +
+                  static_cast<size_t>(tileX) * info.bytesPerPixel();
+    auto pixel = pixels->buffer.data() + offset;
+    if (info.isAlphaOnly()) {
+      auto alpha = static_cast<float>(pixel[0]) / 255.0f;
+      return {0.0f, 0.0f, 0.0f, alpha};
+    }
+    return ReadPixel(pixel, false);
+  }
+
+  PMColor sampleNearest(float u, float v) const {
+    return fetch(static_cast<int>(std::floor(u)), static_cast<int>(std::floor(v)));
+  }
+
+  PMColor sampleLinear(float u, float v) const {
+    u -= 0.5f;
+    v -= 0.5f;
+    auto u0 = std::floor(u);
+    auto v0 = std::floor(v);
+    auto fx = u - u0;
+    auto fy = v - v0;
+    auto column = static_cast<int>(u0);
+    auto row = static_cast<int>(v0);
+    auto c00 = fetch(column, row);
+    auto c10 = fetch(column + 1, row);
+    auto c01 = fetch(column, row + 1);
+    auto c11 = fetch(column + 1, row + 1);
+    PMColor result = TransparentBlack;
+    for (int i = 0; i < 4; i++) {
+      auto topValue = c00[i] + (c10[i] - c00[i]) * fx;
+      auto bottomValue = c01[i] + (c11[i] - c01[i]) * fx;
+      result[i] = topValue + (bottomValue - topValue) * fy;
+    }
+    return result;
+  }
+};
+
+class DevicePixelsRasterShader : public RasterShader {
+ public:
+  DevicePixelsRasterShader(const Pixmap& pixmap, int offsetX, int offsetY)
+      : pixmap(pixmap), offsetX(offsetX), offsetY(offsetY),
+        bgra(pixmap.colorType() == ColorType::BGRA_8888) {
+  }
+
+  void shadeRow(int x, int y, int count, const PMColor& input, PMColor* colors) const override {
+    auto row = y - offsetY;
+    auto pixels = static_cast<const uint8_t*>(pixmap.pixels());
+    for (int i = 0; i < count; i++) {
+      auto column = x + i - offsetX;
+      if (row < 0 || row >= pixmap.height() || column < 0 || column >= pixmap.width()) {
+        colors[i] = TransparentBlack;
+        continue;
+      }
+      auto pixel = pixels + static_cast<size_t>(row) * pixmap.rowBytes() +
+                   static_cast<size_t>(column) * 4;
+      colors[i] = Scale(ReadPixel(pixel, bgra), input.alpha);
+    }
+  }
+
+ private:
+  Pixmap pixmap = {};
+  int offsetX = 0;
+  int offsetY = 0;
+  bool bgra = false;
+};
+
+class BlendRasterShader : public RasterShader {
+ public:
+  BlendRasterShader(BlendMode mode, std::unique_ptr<RasterShader> dst,
+                    std::unique_ptr<RasterShader> src)
+      : mode(mode), dst(std::move(dst)), src(std::move(src)) {
+  }
+
+  void shadeRow(int x, int y, int count, const PMColor& input, PMColor* colors) const override {
+    srcColors.resize(static_cast<size_t>(count));
+    dst->shadeRow(x, y, count, input, colors);
+    src->shadeRow(x, y, count, input, srcColors.data());
+    for (int i = 0; i < count; i++) {
+      colors[i] = BlendColors(mode, srcColors[static_cast<size_t>(i)], colors[i]);
+    }
+  }
+
+ private:
+  BlendMode mode = BlendMode::SrcOver;
+  std::unique_ptr<RasterShader> dst = nullptr;
+  std::unique_ptr<RasterShader> src = nullptr;
+  mutable std::vector<PMColor> srcColors = {};
+};
+
+class ColorFilterRasterShader : public RasterShader {
+ public:
+  ColorFilterRasterShader(std::unique_ptr<RasterShader> source,
+                          std::shared_ptr<ColorFilter> colorFilter)
+      : source(std::move(source)), colorFilter(std::move(colorFilter)) {
+  }
+
+  void shadeRow(int x, int y, int count, const PMColor& input, PMColor* colors) const override {
+    source->shadeRow(x, y, count, input, colors);
+    FilterColors(colorFilter.get(), colors, count);
+  }
+
+ private:
+  std::unique_ptr<RasterShader> source = nullptr;
+  std::shared_ptr<ColorFilter> colorFilter = nullptr;
+};
+
+static bool IsColorFilterSupported(const ColorFilter* colorFilter) {
+  auto color = OpaqueWhite;
+  return FilterColors(colorFilter, &color, 1);
+}
+
+static std::shared_ptr<RasterPixels> Resample(std::shared_ptr<RasterPixels> source, int width,
+                                              int height, const Matrix& dstToSource,
+                                              const SamplingOptions& sampling) {
+  auto alphaOnly = source->info.isAlphaOnly();
+  auto pixels = MakePixels(width, height, alphaOnly);
+  if (pixels == nullptr) {
+    return nullptr;
+  }
+  auto subset = Rect::MakeWH(source->info.width(), source->info.height());
+  ImageRasterShader shader(std::move(source), TileMode::Clamp, TileMode::Clamp, sampling,
+                           dstToSource, subset);
+  std::vector<PMColor> colors(static_cast<size_t>(width));
+  for (int y = 0; y < height; y++) {
+    shader.shadeRow(0, y, width, OpaqueWhite, colors.data());
+    auto row = pixels->buffer.data() + static_cast<size_t>(y) * pixels->info.rowBytes();
+    for (int x = 0; x < width; x++) {
+      auto& color = colors[static_cast<size_t>(x)];
+      if (alphaOnly) {
+        row[x] = ToByte(color.alpha);
+      } else {
+        WritePixel(color, false, row + 4 * x);
+      }
+    }
+  }
+  return pixels;
+}
+
+std::unique_ptr<RasterShader> RasterShader::Make(const Shader* shader, const Matrix& deviceToLocal,
+                                                 RasterImageCache* cache) {
+  DEBUG_ASSERT(shader != nullptr);
+  switch (Types::Get(shader)) {
+    case Types::ShaderType::Color: {
+      auto color = static_cast<const ColorShader*>(shader)->color;
+      return std::make_unique<ColorRasterShader>(color.premultiply());
+    }
+    case Types::ShaderType::Gradient: {
+      auto gradientShader = static_cast<const GradientShader*>(shader);
+      auto deviceToUnit = deviceToLocal;
+      deviceToUnit.postConcat(gradientShader->pointsToUnit);
+      return std::make_unique<GradientRasterShader>(gradientShader, deviceToUnit);
+    }
+    case Types::ShaderType::Image: {
+      auto imageShader = static_cast<const ImageShader*>(shader);
+      auto& image = imageShader->image;
+      return MakeImage(image, imageShader->tileModeX, imageShader->tileModeY,
+                       imageShader->sampling, deviceToLocal,
+                       Rect::MakeWH(image->width(), image->height()), cache);
+    }
+    case Types::ShaderType::Matrix: {
+      auto matrixShader = static_cast<const MatrixShader*>(shader);
+      Matrix inverse = {};
+      if (!matrixShader->matrix.invert(&inverse)) {
+        return nullptr;
+      }
+      auto totalMatrix = deviceToLocal;
+      totalMatrix.postConcat(inverse);
+      return Make(matrixShader->source.get(), totalMatrix, cache);
+    }
+    case Types::ShaderType::Blend: {
+      auto blendShader = static_cast<const BlendShader*>(shader);
+      auto dst = Make(blendShader->dst.get(), deviceToLocal, cache);
+      auto src = Make(blendShader->src.get(), deviceToLocal, cache);
+      if (dst == nullptr || src == nullptr) {
+        return nullptr;
+      }
+      return std::make_unique<BlendRasterShader>(blendShader->mode, std::move(dst),
+                                                 std::move(src));
+    }
+    case Types::ShaderType::ColorFilter: {
+      auto colorFilterShader = static_cast<const ColorFilterShader*>(shader);
+      if (!IsColorFilterSupported(colorFilterShader->colorFilter.get())) {
+        cache->reportUnsupported(
+            "RasterShader::Make() The color filter can not be evaluated on the CPU.");
+        return nullptr;
+      }
+      auto source = Make(colorFilterShader->shader.get(), deviceToLocal, cache);
+      if (source == nullptr) {
+        return nullptr;
+      }
+      return std::make_unique<ColorFilterRasterShader>(std::move(source),
+                                                       colorFilterShader->colorFilter);
+    }
+    default:
+      break;
+  }
+  cache->reportUnsupported("RasterShader::Make() The shader type can not be evaluated on the CPU.");
+  return nullptr;
+}
+
+std::unique_ptr<RasterShader> RasterShader::MakeImage(const std::shared_ptr<Image>& image,
+                                                      TileMode tileModeX, TileMode tileModeY,
+                                                      const SamplingOptions& sampling,
+                                                      const Matrix& deviceToLocal,
+                                                      const Rect& subset,
+                                                      RasterImageCache* cache) {
+  DEBUG_ASSERT(image != nullptr);
+  auto pixels = cache->getPixels(image);
+  if (pixels == nullptr) {
+    return nullptr;
+  }
+  return std::make_unique<ImageRasterShader>(std::move(pixels), tileModeX, tileModeY, sampling,
+                                             deviceToLocal, subset);
+}
+
+std::unique_ptr<RasterShader> RasterShader::MakeDevicePixels(const Pixmap& pixmap, int offsetX,
+                                                             int offsetY) {
+  return std::make_unique<DevicePixelsRasterShader>(pixmap, offsetX, offsetY);
+}
+
+//=========================================== Blitter =============================================
+
+std::unique_ptr<RasterBlitter> RasterBlitter::Make(const Brush& brush, const Matrix& deviceToLocal,
+                                                   bool bgra, RasterImageCache* cache) {
+  if (brush.nothingToDraw()) {
+    return nullptr;
+  }
+  std::unique_ptr<RasterShader> source = nullptr;
+  if (brush.shader != nullptr) {
+    source = RasterShader::Make(brush.shader.get(), deviceToLocal, cache);
+    if (source == nullptr) {
+      return nullptr;
+    }
+  }
+  return Make(std::move(source), brush, deviceToLocal, bgra, cache);
+}
+
+std::unique_ptr<RasterBlitter> RasterBlitter::Make(std::unique_ptr<RasterShader> source,
+                                                   const Brush& brush, const Matrix& deviceToLocal,
+                                                   bool bgra, RasterImageCache* cache) {
+  if (brush.nothingToDraw()) {
+    return nullptr;
+  }
+  if (brush.colorFilter != nullptr && !IsColorFilterSupported(brush.colorFilter.get())) {
+    cache->reportUnsupported(
+        "RasterBlitter::Make() The color filter can not be evaluated on the CPU.");
+    return nullptr;
+  }
+  std::unique_ptr<RasterShader> maskShader = nullptr;
+  auto invertMask = false;
+  if (brush.maskFilter != nullptr) {
+    if (Types::Get(brush.maskFilter.get()) != Types::MaskFilterType::Shader) {
+      // An empty mask filter hides everything.
+      return nullptr;
+    }
+    auto shaderMaskFilter = static_cast<const ShaderMaskFilter*>(brush.maskFilter.get());
+    maskShader = RasterShader::Make(shaderMaskFilter->getShader().get(), deviceToLocal, cache);
+    if (maskShader == nullptr) {
+      return nullptr;
+    }
+    invertMask = shaderMaskFilter->isInverted();
+  }
+  auto blitter = std::unique_ptr<RasterBlitter>(new RasterBlitter(std::move(source), brush, bgra));
+  blitter->maskShader = std::move(maskShader);
+  blitter->invertMask = invertMask;
+  return blitter;
+}
+
+RasterBlitter::RasterBlitter(std::unique_ptr<RasterShader> source, const Brush& brush, bool bgra)
+    : source(std::move(source)), colorFilter(brush.colorFilter), blendMode(brush.blendMode),
+      bgra(bgra), color(brush.color.premultiply()) {
+  if (this->source == nullptr && colorFilter != nullptr) {
+    // A solid color stays solid after the color filter, so filter it only once.
+    FilterColors(colorFilter.get(), &color, 1);
+    colorFilter = nullptr;
+  }
+  srcOver = blendMode == BlendMode::SrcOver;
+  if (this->source == nullptr && blendMode == BlendMode::Src && color.alpha >= 1.0f) {
+    // Drawing an opaque color with Src is the same as SrcOver, even at partial coverage.
+    srcOver = true;
+  }
+  WritePixel(color, bgra, colorBytes);
+}
+
+void RasterBlitter::blitRow(uint8_t* dst, int x, int y, uint8_t* coverage, int count) {
+  auto size = static_cast<size_t>(count);
+  if (maskShader != nullptr) {
+    maskColors.resize(size);
+    maskShader->shadeRow(x, y, count, OpaqueWhite, maskColors.data());
+    for (size_t i = 0; i < size; i++) {
+      auto alpha = Clamp01(maskColors[i].alpha);
+      alpha = invertMask ? 1.0f - alpha : alpha;
+      coverage[i] = static_cast<uint8_t>(static_cast<float>(coverage[i]) * alpha + 0.5f);
+    }
+  }
+  if (source == nullptr) {
+    if (srcOver) {
+      BlitSolidSrcOver(dst, colorBytes, coverage, count);
+      return;
+    }
+    colors.assign(size, color);
+    blendRow(dst, colors.data(), coverage, count);
+    return;
+  }
+  colors.resize(size);
+  source->shadeRow(x, y, count, color, colors.data());
+  if (colorFilter != nullptr) {
+    FilterColors(colorFilter.get(), colors.data(), count);
+  }
+  if (!srcOver) {
+    blendRow(dst, colors.data(), coverage, count);
+    return;
+  }
+  colorRow.resize(size * 4);
+  for (size_t i = 0; i < size; i++) {
+    WritePixel(colors[i], bgra, colorRow.data() + 4 * i);
+  }
+  BlitSpanSrcOver(dst, colorRow.data(), coverage, count);
+}
+
+void RasterBlitter::blendRow(uint8_t* dst, const PMColor* srcColors, const uint8_t* coverage,
+                             int count) const {
+  for (int i = 0; i < count; i++) {
+    if (coverage[i] == 0) {
+      continue;
+    }
+    auto pixel = dst + 4 * i;
+    auto dstColor = ReadPixel(pixel, bgra);
+    auto result = BlendColors(blendMode, srcColors[i], dstColor);
+    if (coverage[i] < 255) {
+      auto weight = static_cast<float>(coverage[i]) / 255.0f;
+      for (int j = 0; j < 4; j++) {
+        result[j] = dstColor[j] + (result[j] - dstColor[j]) * weight;
+      }
+    }
+    WritePixel(result, bgra, pixel);
+  }
+}
+}  // namespace tgfx
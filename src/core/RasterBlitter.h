@@ -0,0 +1,185 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "core/utils/Log.h"
+#include "tgfx/core/Brush.h"
+#include "tgfx/core/Image.h"
+#include "tgfx/core/ImageBuffer.h"
+#include "tgfx/core/Pixmap.h"
+#include "tgfx/core/SamplingOptions.h"
+#include "tgfx/core/TileMode.h"
+
+namespace tgfx {
+/**
+ * RasterPixels holds the premultiplied pixels of an Image decoded on the CPU, either as
+ * RGBA_8888 or as ALPHA_8 for alpha-only images.
+ */
+struct RasterPixels {
+  ImageInfo info = {};
+  std::vector<uint8_t> buffer = {};
+};
+
+/**
+ * RasterImageCache keeps the decoded pixels of the images drawn by a raster backend, so that
+ * drawing the same image repeatedly does not decode it again.
+ */
+class RasterImageCache {
+ public:
+  /**
+   * Returns the decoded pixels of the image, or nullptr if the image can not be decoded on the
+   * CPU, such as images backed by GPU textures.
+   */
+  std::shared_ptr<RasterPixels> getPixels(const std::shared_ptr<Image>& image);
+
+  /**
+   * Returns true if any content drawn with this cache could not be rendered on the CPU, such as
+   * image filters, meshes, color glyphs, or images and shaders without a CPU implementation.
+   */
+  bool hasUnsupportedContent() const {
+    return unsupportedContent;
+  }
+
+  /**
+   * Logs the message and records that the content being drawn can not be rendered on the CPU.
+   */
+  void reportUnsupported(const char* message) {
+    LOGE("%s", message);
+    unsupportedContent = true;
+  }
+
+  /**
+   * Clears the record of unsupported content, so that the next draws can be checked on their own.
+   */
+  void resetUnsupportedContent() {
+    unsupportedContent = false;
+  }
+
+ private:
+  struct Entry {
+    std::weak_ptr<Image> image;
+    std::shared_ptr<RasterPixels> pixels;
+  };
+
+  std::unordered_map<const Image*, Entry> entries = {};
+  bool unsupportedContent = false;
+
+  std::shared_ptr<RasterPixels> decode(const std::shared_ptr<Image>& image);
+
+  static std::shared_ptr<RasterPixels> ReadImageBuffer(std::shared_ptr<ImageBuffer> imageBuffer);
+};
+
+/**
+ * RasterShader computes the premultiplied colors of a Shader or an image for runs of device
+ * pixels.
+ */
+class RasterShader {
+ public:
+  /**
+   * Creates a RasterShader for the given Shader, where deviceToLocal maps device pixel coordinates
+   * into the local space of the shader. Returns nullptr if the shader can not be evaluated on the
+   * CPU.
+   */
+  static std::unique_ptr<RasterShader> Make(const Shader* shader, const Matrix& deviceToLocal,
+                                            RasterImageCache* cache);
+
+  /**
+   * Creates a RasterShader that samples the image, where deviceToLocal maps device pixel
+   * coordinates into the image space. Samples are clamped to the given subset of the image
+   * when both tile modes are TileMode::Clamp.
+   */
+  static std::unique_ptr<RasterShader> MakeImage(const std::shared_ptr<Image>& image,
+                                                 TileMode tileModeX, TileMode tileModeY,
+                                                 const SamplingOptions& sampling,
+                                                 const Matrix& deviceToLocal, const Rect& subset,
+                                                 RasterImageCache* cache);
+
+  /**
+   * Creates a RasterShader that reads the premultiplied pixels one to one, with the top-left pixel
+   * placed at the given device offset. Pixels outside the pixmap are transparent. The pixmap must
+   * share the channel order of the destination and stay valid while the shader is in use.
+   */
+  static std::unique_ptr<RasterShader> MakeDevicePixels(const Pixmap& pixmap, int offsetX,
+                                                        int offsetY);
+
+  virtual ~RasterShader() = default;
+
+  /**
+   * Writes the colors of count pixels starting at the device pixel (x, y). The colors are
+   * modulated by the input color in the same way as the GPU fragment processors do.
+   */
+  virtual void shadeRow(int x, int y, int count, const PMColor& input, PMColor* colors) const = 0;
+};
+
+/**
+ * RasterBlitter blends the colors of a Brush into runs of 32-bit premultiplied destination
+ * pixels, weighted by 8-bit coverage.
+ */
+class RasterBlitter {
+ public:
+  /**
+   * Creates a RasterBlitter that paints with the given brush, where deviceToLocal maps device
+   * pixel coordinates into the local space of the brush's shader and mask filter. Returns nullptr
+   * if nothing would be drawn or the brush can not be evaluated on the CPU.
+   */
+  static std::unique_ptr<RasterBlitter> Make(const Brush& brush, const Matrix& deviceToLocal,
+                                             bool bgra, RasterImageCache* cache);
+
+  /**
+   * Creates a RasterBlitter that paints the colors of the given source instead of the brush's own
+   * shader. The brush color is used as the input of the source.
+   */
+  static std::unique_ptr<RasterBlitter> Make(std::unique_ptr<RasterShader> source,
+                                             const Brush& brush, const Matrix& deviceToLocal,
+                                             bool bgra, RasterImageCache* cache);
+
+  /**
+   * Blends count pixels starting at the device pixel (x, y). The dst pointer addresses the first
+   * pixel. The coverage values may be modified by the mask filter of the brush.
+   */
+  void blitRow(uint8_t* dst, int x, int y, uint8_t* coverage, int count);
+
+ private:
+  std::unique_ptr<RasterShader> source = nullptr;
+  std::unique_ptr<RasterShader> maskShader = nullptr;
+  std::shared_ptr<ColorFilter> colorFilter = nullptr;
+  BlendMode blendMode = BlendMode::SrcOver;
+  bool invertMask = false;
+  bool bgra = false;
+  bool srcOver = false;
+  PMColor color = {};
+  uint8_t colorBytes[4] = {};
+  std::vector<PMColor> colors = {};
+  std::vector<uint8_t> colorRow = {};
+  std::vector<PMColor> maskColors = {};
+
+  RasterBlitter(std::unique_ptr<RasterShader> source, const Brush& brush, bool bgra);
+
+  void blendRow(uint8_t* dst, const PMColor* srcColors, const uint8_t* coverage, int count) const;
+};
+
+/**
+ * Applies the color filter to count premultiplied colors in place. Returns false if the color
+ * filter can not be evaluated on the CPU.
+ */
+bool FilterColors(const ColorFilter* colorFilter, PMColor* colors, int count);
+}  // namespace tgfx
@@ -0,0 +1,158 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "RasterBlitterSIMD.h"
+// First undef to prevent error when re-included.
+#undef HWY_TARGET_INCLUDE
+// For dynamic dispatch, specify the name of the current file (unfortunately
+// __FILE__ is not reliable) so that foreach_target.h can re-include it.
+#define HWY_TARGET_INCLUDE "core/RasterBlitterSIMD.cpp"
+// Generates code for each enabled target by re-including this source file.
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wgnu-zero-variadic-macro-arguments"
+// Must come after foreach_target.h to avoid redefinition errors.
+#include "hwy/highway.h"
+#pragma clang diagnostic pop
+
+HWY_BEFORE_NAMESPACE();
+namespace tgfx {
+namespace HWY_NAMESPACE {
+namespace hn = hwy::HWY_NAMESPACE;
+
+// Divides x by 255 with rounding, exact for every product of two 8-bit values.
+static inline unsigned Div255(unsigned x) {
+  x += 128;
+  return (x + (x >> 8)) >> 8;
+}
+
+template <class D>
+HWY_INLINE hn::Vec<D> Div255(D d, hn::Vec<D> x) {
+  auto t = hn::Add(x, hn::Set(d, static_cast<uint16_t>(128)));
+  return hn::ShiftRight<8>(hn::Add(t, hn::ShiftRight<8>(t)));
+}
+
+// Returns src * coverage / 255 + dst * inverseAlpha / 255, where inverseAlpha is 255 minus the
+// source alpha after coverage.
+template <class D>
+HWY_INLINE hn::Vec<D> SrcOverLanes(D d, hn::Vec<D> src, hn::Vec<D> coverage, hn::Vec<D> dst,
+                                   hn::Vec<D> inverseAlpha) {
+  return hn::Add(Div255(d, hn::Mul(src, coverage)), Div255(d, hn::Mul(dst, inverseAlpha)));
+}
+
+// Blends one channel of lanes pixels, given the source channel already promoted to 16 bits.
+template <class D8, class D16>
+HWY_INLINE hn::Vec<D8> SrcOverChannel(D8 d8, D16 d16, hn::Vec<D16> srcLow, hn::Vec<D16> srcHigh,
+                                      hn::Vec<D8> dst, hn::Vec<D16> covLow, hn::Vec<D16> covHigh,
+                                      hn::Vec<D16> invLow, hn::Vec<D16> invHigh) {
+  const hn::Half<D8> dh8;
+  auto low = SrcOverLanes(d16, srcLow, covLow, hn::PromoteLowerTo(d16, dst), invLow);
+  auto high = SrcOverLanes(d16, srcHigh, covHigh, hn::PromoteUpperTo(d16, dst), invHigh);
+  return hn::Combine(d8, hn::DemoteTo(dh8, high), hn::DemoteTo(dh8, low));
+}
+
+static inline void SrcOverPixel(uint8_t* dst, const uint8_t* src, unsigned coverage) {
+  auto inverseAlpha = 255 - Div255(src[3] * coverage);
+  for (int i = 0; i < 4; i++) {
+    dst[i] = static_cast<uint8_t>(Div255(src[i] * coverage) + Div255(dst[i] * inverseAlpha));
+  }
+}
+
+void BlitSolidSrcOverImpl(uint8_t* dst, const uint8_t* color, const uint8_t* coverage, int count) {
+  const hn::ScalableTag<uint8_t> d8;
+  const hn::ScalableTag<uint16_t> d16;
+  const int lanes = static_cast<int>(hn::Lanes(d8));
+  const auto max = hn::Set(d16, static_cast<uint16_t>(255));
+  const auto c0 = hn::Set(d16, static_cast<uint16_t>(color[0]));
+  const auto c1 = hn::Set(d16, static_cast<uint16_t>(color[1]));
+  const auto c2 = hn::Set(d16, static_cast<uint16_t>(color[2]));
+  const auto c3 = hn::Set(d16, static_cast<uint16_t>(color[3]));
+  int x = 0;
+  for (; x + lanes <= count; x += lanes) {
+    auto pixels = dst + 4 * x;
+    hn::Vec<decltype(d8)> p0, p1, p2, p3;
+    hn::LoadInterleaved4(d8, pixels, p0, p1, p2, p3);
+    auto cov = hn::LoadU(d8, coverage + x);
+    auto covLow = hn::PromoteLowerTo(d16, cov);
+    auto covHigh = hn::PromoteUpperTo(d16, cov);
+    auto invLow = hn::Sub(max, Div255(d16, hn::Mul(c3, covLow)));
+    auto invHigh = hn::Sub(max, Div255(d16, hn::Mul(c3, covHigh)));
+    auto r0 = SrcOverChannel(d8, d16, c0, c0, p0, covLow, covHigh, invLow, invHigh);
+    auto r1 = SrcOverChannel(d8, d16, c1, c1, p1, covLow, covHigh, invLow, invHigh);
+    auto r2 = SrcOverChannel(d8, d16, c2, c2, p2, covLow, covHigh, invLow, invHigh);
+    auto r3 = SrcOverChannel(d8, d16, c3, c3, p3, covLow, covHigh, invLow, invHigh);
+    hn::StoreInterleaved4(r0, r1, r2, r3, d8, pixels);
+  }
+  for (; x < count; x++) {
+    if (coverage[x] != 0) {
+      SrcOverPixel(dst + 4 * x, color, coverage[x]);
+    }
+  }
+}
+
+void BlitSpanSrcOverImpl(uint8_t* dst, const uint8_t* src, const uint8_t* coverage, int count) {
+  const hn::ScalableTag<uint8_t> d8;
+  const hn::ScalableTag<uint16_t> d16;
+  const int lanes = static_cast<int>(hn::Lanes(d8));
+  const auto max = hn::Set(d16, static_cast<uint16_t>(255));
+  int x = 0;
+  for (; x + lanes <= count; x += lanes) {
+    auto pixels = dst + 4 * x;
+    hn::Vec<decltype(d8)> s0, s1, s2, s3, p0, p1, p2, p3;
+    hn::LoadInterleaved4(d8, src + 4 * x, s0, s1, s2, s3);
+    hn::LoadInterleaved4(d8, pixels, p0, p1, p2, p3);
+    auto cov = hn::LoadU(d8, coverage + x);
+    auto covLow = hn::PromoteLowerTo(d16, cov);
+    auto covHigh = hn::PromoteUpperTo(d16, cov);
+    auto invLow = hn::Sub(max, Div255(d16, hn::Mul(hn::PromoteLowerTo(d16, s3), covLow)));
+    auto invHigh = hn::Sub(max, Div255(d16, hn::Mul(hn::PromoteUpperTo(d16, s3), covHigh)));
+    auto r0 = SrcOverChannel(d8, d16, hn::PromoteLowerTo(d16, s0), hn::PromoteUpperTo(d16, s0), p0,
+                             covLow, covHigh, invLow, invHigh);
+    auto r1 = SrcOverChannel(d8, d16, hn::PromoteLowerTo(d16, s1), hn::PromoteUpperTo(d16, s1), p1,
+                             covLow, covHigh, invLow, invHigh);
+    auto r2 = SrcOverChannel(d8, d16, hn::PromoteLowerTo(d16, s2), hn::PromoteUpperTo(d16, s2), p2,
+                             covLow, covHigh, invLow, invHigh);
+    auto r3 = SrcOverChannel(d8, d16, hn::PromoteLowerTo(d16, s3), hn::PromoteUpperTo(d16, s3), p3,
+                             covLow, covHigh, invLow, invHigh);
+    hn::StoreInterleaved4(r0, r1, r2, r3, d8, pixels);
+  }
+  for (; x < count; x++) {
+    if (coverage[x] != 0) {
+      SrcOverPixel(dst + 4 * x, src + 4 * x, coverage[x]);
+    }
+  }
+}
+}  // namespace HWY_NAMESPACE
+}  // namespace tgfx
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace tgfx {
+HWY_EXPORT(BlitSolidSrcOverImpl);
+HWY_EXPORT(BlitSpanSrcOverImpl);
+
+void BlitSolidSrcOver(uint8_t* dst, const uint8_t color[4], const uint8_t* coverage, int count) {
+  HWY_DYNAMIC_DISPATCH(BlitSolidSrcOverImpl)(dst, color, coverage, count);
+}
+
+void BlitSpanSrcOver(uint8_t* dst, const uint8_t* src, const uint8_t* coverage, int count) {
+  HWY_DYNAMIC_DISPATCH(BlitSpanSrcOverImpl)(dst, src, coverage, count);
+}
+}  // namespace tgfx
+#endif
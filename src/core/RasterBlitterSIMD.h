@@ -0,0 +1,37 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+namespace tgfx {
+/**
+ * Blends a solid premultiplied color over count 32-bit pixels with SrcOver, scaling the color by
+ * the 8-bit coverage of each pixel. The channels of the color must be in the same order as the
+ * destination pixels, with alpha in the last channel.
+ */
+void BlitSolidSrcOver(uint8_t* dst, const uint8_t color[4], const uint8_t* coverage, int count);
+
+/**
+ * Blends count premultiplied 32-bit source pixels over the destination pixels with SrcOver,
+ * scaling each source pixel by its 8-bit coverage. Both spans must use the same channel order,
+ * with alpha in the last channel.
+ */
+void BlitSpanSrcOver(uint8_t* dst, const uint8_t* src, const uint8_t* coverage, int count);
+}  // namespace tgfx
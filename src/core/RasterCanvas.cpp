@@ -0,0 +1,65 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tgfx/core/RasterCanvas.h"
+#include "core/RasterDrawContext.h"
+
+namespace tgfx {
+std::unique_ptr<RasterCanvas> RasterCanvas::Make(const Pixmap& pixmap) {
+  if (pixmap.isEmpty() || pixmap.writablePixels() == nullptr) {
+    return nullptr;
+  }
+  if (pixmap.colorType() != ColorType::RGBA_8888 && pixmap.colorType() != ColorType::BGRA_8888) {
+    LOGE("RasterCanvas::Make() Only RGBA_8888 and BGRA_8888 pixels are supported!");
+    return nullptr;
+  }
+  if (pixmap.alphaType() == AlphaType::Unpremultiplied) {
+    LOGE("RasterCanvas::Make() Unpremultiplied pixels are not supported!");
+    return nullptr;
+  }
+  return std::unique_ptr<RasterCanvas>(new RasterCanvas(pixmap));
+}
+
+RasterCanvas::RasterCanvas(const Pixmap& pixmap) : pixmap(pixmap) {
+  imageCache = new RasterImageCache();
+  drawContext = new RasterDrawContext(pixmap, imageCache);
+  canvas = new Canvas(drawContext);
+}
+
+RasterCanvas::~RasterCanvas() {
+  delete canvas;
+  delete drawContext;
+  delete imageCache;
+}
+
+bool RasterCanvas::drawPicture(std::shared_ptr<Picture> picture) {
+  if (picture == nullptr) {
+    return false;
+  }
+  // Prepare every draw once without touching the pixels. The images decoded on the way stay in
+  // the shared cache for the actual drawing.
+  imageCache->resetUnsupportedContent();
+  RasterDrawContext checkContext(pixmap, imageCache, true);
+  checkContext.drawPicture(picture, canvas->getMatrix(), {});
+  if (imageCache->hasUnsupportedContent()) {
+    return false;
+  }
+  canvas->drawPicture(std::move(picture));
+  return true;
+}
+}  // namespace tgfx
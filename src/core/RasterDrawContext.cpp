@@ -0,0 +1,449 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "RasterDrawContext.h"
+#include <cmath>
+#include "core/PathRasterizer.h"
+#include "core/utils/GeometryExtra.h"
+#include "core/utils/Log.h"
+#include "core/utils/MathExtra.h"
+#include "core/utils/RectToRectMatrix.h"
+#include "core/utils/StrokeUtils.h"
+#include "tgfx/core/Image.h"
+
+namespace tgfx {
+static bool HasAntiAliasElement(const ClipStack& clip) {
+  auto& elements = clip.elements();
+  for (size_t i = clip.oldestValidIndex(); i < elements.size(); i++) {
+    auto& element = elements[i];
+    if (element.isValid() && element.antiAlias()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool IsPixelAligned(const Rect& rect) {
+  auto rounded = rect;
+  rounded.round();
+  return rounded == rect;
+}
+
+static void ApplyThreshold(uint8_t* coverage, int count) {
+  for (int i = 0; i < count; i++) {
+    coverage[i] = coverage[i] >= 128 ? 255 : 0;
+  }
+}
+
+static uint8_t MulDiv255(unsigned a, unsigned b) {
+  auto value = a * b + 128;
+  return static_cast<uint8_t>((value + (value >> 8)) >> 8);
+}
+
+RasterDrawContext::RasterDrawContext(const Pixmap& pixmap, RasterImageCache* imageCache,
+                                     bool checkOnly)
+    : pixmap(pixmap), bgra(pixmap.colorType() == ColorType::BGRA_8888), checkOnly(checkOnly),
+      imageCache(imageCache) {
+  DEBUG_ASSERT(pixmap.colorType() == ColorType::RGBA_8888 ||
+               pixmap.colorType() == ColorType::BGRA_8888);
+  if (this->imageCache == nullptr) {
+    ownedImageCache = std::make_unique<RasterImageCache>();
+    this->imageCache = ownedImageCache.get();
+  }
+}
+
+void RasterDrawContext::drawFill(const Brush& brush) {
+  // The brush of drawFill() is already in device space.
+  auto blitter = RasterBlitter::Make(brush, Matrix::I(), bgra, imageCache);
+  if (blitter == nullptr) {
+    return;
+  }
+  auto bounds = Rect::MakeWH(pixmap.width(), pixmap.height());
+  fillRect(bounds, Matrix::I(), ClipStack(), false, blitter.get());
+}
+
+void RasterDrawContext::drawRect(const Rect& rect, const Matrix& matrix, const ClipStack& clip,
+                                 const Brush& brush, const Stroke* stroke) {
+  if (stroke != nullptr) {
+    Path path = {};
+    path.addRect(rect);
+    drawShape(Shape::MakeFrom(std::move(path)), matrix, clip, brush, stroke);
+    return;
+  }
+  auto blitter = makeBlitter(brush, matrix);
+  if (blitter == nullptr) {
+    return;
+  }
+  fillRect(rect, matrix, clip, brush.antiAlias, blitter.get());
+}
+
+void RasterDrawContext::drawRRect(const RRect& rRect, const Matrix& matrix, const ClipStack& clip,
+                                  const Brush& brush, const Stroke* stroke) {
+  Path path = {};
+  path.addRRect(rRect);
+  drawShape(Shape::MakeFrom(std::move(path)), matrix, clip, brush, stroke);
+}
+
+void RasterDrawContext::drawPath(const Path& path, const Matrix& matrix, const ClipStack& clip,
+                                 const Brush& brush) {
+  drawShape(Shape::MakeFrom(path), matrix, clip, brush, nullptr);
+}
+
+void RasterDrawContext::drawShape(std::shared_ptr<Shape> shape, const Matrix& matrix,
+                                  const ClipStack& clip, const Brush& brush,
+                                  const Stroke* stroke) {
+  if (shape == nullptr) {
+    return;
+  }
+  auto blitter = makeBlitter(brush, matrix);
+  if (blitter == nullptr) {
+    return;
+  }
+  if (stroke != nullptr && TreatStrokeAsHairline(*stroke, matrix)) {
+    // Hairlines are one device pixel wide, and thinner strokes fade out instead of shrinking.
+    auto hairline = *stroke;
+    hairline.width = 1.0f;
+    auto deviceShape = Shape::ApplyStroke(Shape::ApplyMatrix(std::move(shape), matrix), &hairline);
+    fillShape(std::move(deviceShape), clip, brush.antiAlias,
+              GetHairlineAlphaFactor(*stroke, matrix), blitter.get());
+    return;
+  }
+  shape = Shape::ApplyStroke(std::move(shape), stroke);
+  fillShape(Shape::ApplyMatrix(std::move(shape), matrix), clip, brush.antiAlias, 1.0f,
+            blitter.get());
+}
+
+void RasterDrawContext::drawMesh(std::shared_ptr<Mesh>, const Matrix&, const ClipStack&,
+                                 const Brush&) {
+  imageCache->reportUnsupported(
+      "RasterDrawContext::drawMesh() Meshes are not supported by the raster backend.");
+}
+
+void RasterDrawContext::drawImage(std::shared_ptr<Image> image, const SamplingOptions& sampling,
+                                  const Matrix& matrix, const ClipStack& clip,
+                                  const Brush& brush) {
+  DEBUG_ASSERT(image != nullptr);
+  auto rect = Rect::MakeWH(image->width(), image->height());
+  drawImageRect(std::move(image), rect, rect, sampling, matrix, clip, brush,
+                SrcRectConstraint::Fast);
+}
+
+void RasterDrawContext::drawImageRect(std::shared_ptr<Image> image, const Rect& srcRect,
+                                      const Rect& dstRect, const SamplingOptions& sampling,
+                                      const Matrix& matrix, const ClipStack& clip,
+                                      const Brush& brush, SrcRectConstraint constraint,
+                                      const Rect* strictRect) {
+  DEBUG_ASSERT(image != nullptr);
+  DEBUG_ASSERT(image->isAlphaOnly() || brush.shader == nullptr);
+  auto imageToDevice = MakeRectToRectMatrix(srcRect, dstRect);
+  imageToDevice.postConcat(matrix);
+  Matrix deviceToImage = {};
+  Matrix deviceToLocal = {};
+  if (!imageToDevice.invert(&deviceToImage) || !matrix.invert(&deviceToLocal)) {
+    return;
+  }
+  auto subset = Rect::MakeWH(image->width(), image->height());
+  if (constraint == SrcRectConstraint::Strict) {
+    subset = strictRect ? *strictRect : srcRect;
+  }
+  auto alphaOnly = image->isAlphaOnly();
+  auto imageShader = RasterShader::MakeImage(image, TileMode::Clamp, TileMode::Clamp, sampling,
+                                             deviceToImage, subset, imageCache);
+  if (imageShader == nullptr) {
+    return;
+  }
+  if (alphaOnly) {
+    // Alpha-only images act as a coverage mask for the brush, including its shader.
+    auto blitter = RasterBlitter::Make(brush, deviceToLocal, bgra, imageCache);
+    if (blitter != nullptr) {
+      fillRect(dstRect, matrix, clip, brush.antiAlias, blitter.get(), imageShader.get());
+    }
+    return;
+  }
+  auto blitter =
+      RasterBlitter::Make(std::move(imageShader), brush, deviceToLocal, bgra, imageCache);
+  if (blitter != nullptr) {
+    fillRect(dstRect, matrix, clip, brush.antiAlias, blitter.get());
+  }
+}
+
+void RasterDrawContext::drawTextBlob(std::shared_ptr<TextBlob> textBlob, const Matrix& matrix,
+                                     const ClipStack& clip, const Brush& brush,
+                                     const Stroke* stroke) {
+  DEBUG_ASSERT(textBlob != nullptr);
+  // Glyphs are filled as outlines, so color glyphs without outlines are skipped.
+  for (auto run : *textBlob) {
+    if (!run.font.hasOutlines()) {
+      imageCache->reportUnsupported("RasterDrawContext::drawTextBlob() Color glyphs are not "
+                                    "supported by the raster backend.");
+      break;
+    }
+  }
+  drawShape(Shape::MakeFrom(std::move(textBlob)), matrix, clip, brush, stroke);
+}
+
+void RasterDrawContext::drawPicture(std::shared_ptr<Picture> picture, const Matrix& matrix,
+                                    const ClipStack& clip) {
+  DEBUG_ASSERT(picture != nullptr);
+  auto clipBounds = getClipBounds(clip);
+  if (clipBounds.isEmpty()) {
+    return;
+  }
+  picture->playback(this, matrix, clip, nullptr, &clipBounds);
+}
+
+void RasterDrawContext::drawLayer(std::shared_ptr<Picture> picture,
+                                  std::shared_ptr<ImageFilter> filter, const Matrix& matrix,
+                                  const ClipStack& clip, const Brush& brush) {
+  DEBUG_ASSERT(brush.shader == nullptr);
+  Rect bounds = {};
+  if (picture->hasUnboundedFill()) {
+    bounds = ToLocalBounds(getClipBounds(clip), matrix);
+  } else {
+    bounds = picture->getBounds();
+  }
+  if (bounds.isEmpty()) {
+    return;
+  }
+  if (filter != nullptr) {
+    imageCache->reportUnsupported(
+        "RasterDrawContext::drawLayer() Image filters are not supported by the raster backend, "
+        "the layer is drawn without the filter.");
+  }
+  if (checkOnly) {
+    // Check the contents and the brush of the layer without rasterizing it into an image.
+    picture->playback(this, matrix, clip);
+    makeBlitter(brush, matrix);
+    return;
+  }
+  bounds.roundOut();
+  auto width = FloatSaturateToInt(bounds.width());
+  auto height = FloatSaturateToInt(bounds.height());
+  auto viewMatrix = Matrix::MakeTrans(-bounds.x(), -bounds.y());
+  // The PictureImage is decoded by a nested RasterDrawContext that shares the image cache.
+  auto image = Image::MakeFrom(std::move(picture), width, height, &viewMatrix);
+  if (image == nullptr) {
+    return;
+  }
+  auto drawMatrix = matrix;
+  drawMatrix.preTranslate(bounds.x(), bounds.y());
+  drawImage(std::move(image), {}, drawMatrix, clip, brush.makeWithMatrix(viewMatrix));
+}
+
+Rect RasterDrawContext::getClipBounds(const ClipStack& clip) const {
+  auto targetBounds = Rect::MakeWH(pixmap.width(), pixmap.height());
+  switch (clip.state()) {
+    case ClipState::Empty:
+      return {};
+    case ClipState::WideOpen:
+      return targetBounds;
+    default:
+      break;
+  }
+  auto bounds = clip.bounds();
+  if (clip.state() == ClipState::Rect && !HasAntiAliasElement(clip)) {
+    bounds.round();
+  } else {
+    bounds.roundOut();
+  }
+  if (!bounds.intersect(targetBounds)) {
+    return {};
+  }
+  return bounds;
+}
+
+const RasterDrawContext::ClipMask* RasterDrawContext::getClipMask(const ClipStack& clip,
+                                                                 const Rect& clipBounds) {
+  if (clip.state() == ClipState::WideOpen) {
+    return nullptr;
+  }
+  if (clip.state() == ClipState::Rect &&
+      (!HasAntiAliasElement(clip) || IsPixelAligned(clip.bounds()))) {
+    // The clip bounds already match the rect exactly.
+    return nullptr;
+  }
+  if (!clipMask.pixels.empty() && clipMask.clipID == clip.uniqueID() &&
+      clipMask.bounds == clipBounds) {
+    return &clipMask;
+  }
+  auto width = static_cast<int>(clipBounds.width());
+  auto height = static_cast<int>(clipBounds.height());
+  clipMask.pixels.assign(static_cast<size_t>(width) * static_cast<size_t>(height), 0);
+  clipMask.clipID = clip.uniqueID();
+  clipMask.bounds = clipBounds;
+  auto matrix = Matrix::MakeTrans(-clipBounds.left, -clipBounds.top);
+  auto rasterizer = PathRasterizer::MakeFrom(width, height, clip.getClipPath(), true, &matrix);
+  if (rasterizer == nullptr) {
+    return &clipMask;
+  }
+  auto info = ImageInfo::Make(width, height, ColorType::ALPHA_8, AlphaType::Premultiplied,
+                              static_cast<size_t>(width));
+  rasterizer->readPixels(info, clipMask.pixels.data());
+  if (!HasAntiAliasElement(clip)) {
+    ApplyThreshold(clipMask.pixels.data(), static_cast<int>(clipMask.pixels.size()));
+  }
+  return &clipMask;
+}
+
+std::unique_ptr<RasterBlitter> RasterDrawContext::makeBlitter(const Brush& brush,
+                                                              const Matrix& matrix) const {
+  Matrix deviceToLocal = {};
+  if (!matrix.invert(&deviceToLocal)) {
+    return nullptr;
+  }
+  return RasterBlitter::Make(brush, deviceToLocal, bgra, imageCache);
+}
+
+void RasterDrawContext::fillRect(const Rect& rect, const Matrix& matrix, const ClipStack& clip,
+                                 bool antiAlias, RasterBlitter* blitter,
+                                 const RasterShader* coverageShader) {
+  if (!matrix.rectStaysRect()) {
+    Path path = {};
+    path.addRect(rect);
+    auto deviceShape = Shape::ApplyMatrix(Shape::MakeFrom(std::move(path)), matrix);
+    fillShape(std::move(deviceShape), clip, antiAlias, 1.0f, blitter, coverageShader);
+    return;
+  }
+  if (checkOnly) {
+    return;
+  }
+  auto deviceRect = matrix.mapRect(rect);
+  deviceRect.sort();
+  if (!antiAlias) {
+    deviceRect.round();
+  }
+  auto bounds = deviceRect;
+  bounds.roundOut();
+  auto clipBounds = getClipBounds(clip);
+  if (!bounds.intersect(clipBounds)) {
+    return;
+  }
+  auto mask = getClipMask(clip, clipBounds);
+  auto left = static_cast<int>(bounds.left);
+  auto top = static_cast<int>(bounds.top);
+  auto width = static_cast<int>(bounds.width());
+  auto height = static_cast<int>(bounds.height());
+  // The coverage of an axis-aligned rect is the product of its horizontal and vertical overlap
+  // with each pixel.
+  std::vector<float> columnCoverage(static_cast<size_t>(width));
+  for (int i = 0; i < width; i++) {
+    auto x = static_cast<float>(left + i);
+    auto overlap = std::min(x + 1.0f, deviceRect.right) - std::max(x, deviceRect.left);
+    columnCoverage[static_cast<size_t>(i)] = std::min(std::max(overlap, 0.0f), 1.0f) * 255.0f;
+  }
+  std::vector<uint8_t> coverage(static_cast<size_t>(width));
+  for (int y = top; y < top + height; y++) {
+    auto rowY = static_cast<float>(y);
+    auto overlap = std::min(rowY + 1.0f, deviceRect.bottom) - std::max(rowY, deviceRect.top);
+    auto rowCoverage = std::min(std::max(overlap, 0.0f), 1.0f);
+    for (size_t i = 0; i < coverage.size(); i++) {
+      coverage[i] = static_cast<uint8_t>(columnCoverage[i] * rowCoverage + 0.5f);
+    }
+    blitRow(left, y, coverage.data(), width, mask, blitter, coverageShader);
+  }
+}
+
+void RasterDrawContext::fillShape(std::shared_ptr<Shape> deviceShape, const ClipStack& clip,
+                                  bool antiAlias, float alpha, RasterBlitter* blitter,
+                                  const RasterShader* coverageShader) {
+  if (deviceShape == nullptr || checkOnly) {
+    return;
+  }
+  auto clipBounds = getClipBounds(clip);
+  auto bounds = clipBounds;
+  if (!deviceShape->isInverseFillType()) {
+    auto shapeBounds = deviceShape->getBounds();
+    shapeBounds.roundOut();
+    if (!bounds.intersect(shapeBounds)) {
+      return;
+    }
+  }
+  if (bounds.isEmpty()) {
+    return;
+  }
+  auto left = static_cast<int>(bounds.left);
+  auto top = static_cast<int>(bounds.top);
+  auto width = static_cast<int>(bounds.width());
+  auto height = static_cast<int>(bounds.height());
+  auto offsetMatrix = Matrix::MakeTrans(-bounds.left, -bounds.top);
+  auto shape = Shape::ApplyMatrix(std::move(deviceShape), offsetMatrix);
+  auto rasterizer = PathRasterizer::MakeFrom(width, height, std::move(shape), antiAlias);
+  if (rasterizer == nullptr) {
+    return;
+  }
+  auto rowBytes = static_cast<size_t>(width);
+  auto info = ImageInfo::Make(width, height, ColorType::ALPHA_8, AlphaType::Premultiplied,
+                              rowBytes);
+  std::vector<uint8_t> pixels(info.byteSize());
+  if (!rasterizer->readPixels(info, pixels.data())) {
+    return;
+  }
+  auto mask = getClipMask(clip, clipBounds);
+  auto alphaScale = static_cast<unsigned>(std::round(std::min(std::max(alpha, 0.0f), 1.0f) * 255));
+  for (int y = 0; y < height; y++) {
+    auto coverage = pixels.data() + static_cast<size_t>(y) * rowBytes;
+    if (!antiAlias) {
+      ApplyThreshold(coverage, width);
+    }
+    if (alphaScale < 255) {
+      for (int i = 0; i < width; i++) {
+        coverage[i] = MulDiv255(coverage[i], alphaScale);
+      }
+    }
+    blitRow(left, top + y, coverage, width, mask, blitter, coverageShader);
+  }
+}
+
+void RasterDrawContext::blitRow(int x, int y, uint8_t* coverage, int count, const ClipMask* mask,
+                                RasterBlitter* blitter, const RasterShader* coverageShader) {
+  if (mask != nullptr) {
+    auto maskWidth = static_cast<size_t>(mask->bounds.width());
+    auto maskX = static_cast<size_t>(x - static_cast<int>(mask->bounds.left));
+    auto maskY = static_cast<size_t>(y - static_cast<int>(mask->bounds.top));
+    auto maskRow = mask->pixels.data() + maskY * maskWidth + maskX;
+    for (int i = 0; i < count; i++) {
+      coverage[i] = MulDiv255(coverage[i], maskRow[i]);
+    }
+  }
+  // Trim the pixels without coverage at both ends of the row.
+  int start = 0;
+  while (start < count && coverage[start] == 0) {
+    start++;
+  }
+  while (count > start && coverage[count - 1] == 0) {
+    count--;
+  }
+  if (start == count) {
+    return;
+  }
+  x += start;
+  coverage += start;
+  count -= start;
+  if (coverageShader != nullptr) {
+    coverageColors.resize(static_cast<size_t>(count));
+    coverageShader->shadeRow(x, y, count, {1.0f, 1.0f, 1.0f, 1.0f}, coverageColors.data());
+    for (int i = 0; i < count; i++) {
+      auto alpha = std::min(std::max(coverageColors[static_cast<size_t>(i)].alpha, 0.0f), 1.0f);
+      coverage[i] = static_cast<uint8_t>(static_cast<float>(coverage[i]) * alpha + 0.5f);
+    }
+  }
+  auto dst = static_cast<uint8_t*>(pixmap.writablePixels()) +
+             static_cast<size_t>(y) * pixmap.rowBytes() + static_cast<size_t>(x) * 4;
+  blitter->blitRow(dst, x, y, coverage, count);
+}
+}  // namespace tgfx
@@ -0,0 +1,118 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/DrawContext.h"
+#include "core/RasterBlitter.h"
+#include "tgfx/core/Pixmap.h"
+
+namespace tgfx {
+/**
+ * RasterDrawContext renders drawing commands into 32-bit premultiplied pixels on the CPU. Coverage
+ * comes from PathRasterizer and clipping from ClipStack, and the colors are blended by a
+ * RasterBlitter, so no GPU Context is required.
+ */
+class RasterDrawContext : public DrawContext {
+ public:
+  /**
+   * Creates a RasterDrawContext that renders into the pixels of the given pixmap, which must be
+   * RGBA_8888 or BGRA_8888 and stay valid while the context is in use. If imageCache is nullptr,
+   * the context keeps its own cache of decoded images. If checkOnly is true, the context prepares
+   * every draw without touching the pixels, so the draws can be checked for content the raster
+   * backend can not render through RasterImageCache::hasUnsupportedContent().
+   */
+  explicit RasterDrawContext(const Pixmap& pixmap, RasterImageCache* imageCache = nullptr,
+                             bool checkOnly = false);
+
+  /**
+   * Returns the cache of decoded images used by the context, which also records whether any
+   * content could not be rendered.
+   */
+  RasterImageCache* getImageCache() const {
+    return imageCache;
+  }
+
+  void drawFill(const Brush& brush) override;
+
+  void drawRect(const Rect& rect, const Matrix& matrix, const ClipStack& clip, const Brush& brush,
+                const Stroke* stroke) override;
+
+  void drawRRect(const RRect& rRect, const Matrix& matrix, const ClipStack& clip,
+                 const Brush& brush, const Stroke* stroke) override;
+
+  void drawPath(const Path& path, const Matrix& matrix, const ClipStack& clip,
+                const Brush& brush) override;
+
+  void drawShape(std::shared_ptr<Shape> shape, const Matrix& matrix, const ClipStack& clip,
+                 const Brush& brush, const Stroke* stroke) override;
+
+  void drawMesh(std::shared_ptr<Mesh> mesh, const Matrix& matrix, const ClipStack& clip,
+                const Brush& brush) override;
+
+  void drawImage(std::shared_ptr<Image> image, const SamplingOptions& sampling,
+                 const Matrix& matrix, const ClipStack& clip, const Brush& brush) override;
+
+  void drawImageRect(std::shared_ptr<Image> image, const Rect& srcRect, const Rect& dstRect,
+                     const SamplingOptions& sampling, const Matrix& matrix, const ClipStack& clip,
+                     const Brush& brush, SrcRectConstraint constraint,
+                     const Rect* strictRect = nullptr) override;
+
+  void drawTextBlob(std::shared_ptr<TextBlob> textBlob, const Matrix& matrix, const ClipStack& clip,
+                    const Brush& brush, const Stroke* stroke) override;
+
+  void drawPicture(std::shared_ptr<Picture> picture, const Matrix& matrix,
+                   const ClipStack& clip) override;
+
+  void drawLayer(std::shared_ptr<Picture> picture, std::shared_ptr<ImageFilter> filter,
+                 const Matrix& matrix, const ClipStack& clip, const Brush& brush) override;
+
+ private:
+  /**
+   * The rasterized coverage of a complex clip, cached until the clip changes.
+   */
+  struct ClipMask {
+    uint32_t clipID = 0;
+    Rect bounds = {};
+    std::vector<uint8_t> pixels = {};
+  };
+
+  Pixmap pixmap = {};
+  bool bgra = false;
+  bool checkOnly = false;
+  RasterImageCache* imageCache = nullptr;
+  std::unique_ptr<RasterImageCache> ownedImageCache = nullptr;
+  ClipMask clipMask = {};
+  std::vector<PMColor> coverageColors = {};
+
+  Rect getClipBounds(const ClipStack& clip) const;
+
+  const ClipMask* getClipMask(const ClipStack& clip, const Rect& clipBounds);
+
+  std::unique_ptr<RasterBlitter> makeBlitter(const Brush& brush, const Matrix& matrix) const;
+
+  void fillRect(const Rect& rect, const Matrix& matrix, const ClipStack& clip, bool antiAlias,
+                RasterBlitter* blitter, const RasterShader* coverageShader = nullptr);
+
+  void fillShape(std::shared_ptr<Shape> deviceShape, const ClipStack& clip, bool antiAlias,
+                 float alpha, RasterBlitter* blitter, const RasterShader* coverageShader = nullptr);
+
+  void blitRow(int x, int y, uint8_t* coverage, int count, const ClipMask* mask,
+               RasterBlitter* blitter, const RasterShader* coverageShader);
+};
+}  // namespace tgfx
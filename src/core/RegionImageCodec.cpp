@@ -0,0 +1,48 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "RegionImageCodec.h"
+
+namespace tgfx {
+std::shared_ptr<RegionImageCodec> RegionImageCodec::MakeFrom(std::shared_ptr<ImageCodec> source,
+                                                             const Rect& region) {
+  if (source == nullptr) {
+    return nullptr;
+  }
+  auto bounds = region;
+  bounds.roundOut();
+  if (bounds.isEmpty() || !Rect::MakeWH(source->width(), source->height()).contains(bounds)) {
+    return nullptr;
+  }
+  return std::shared_ptr<RegionImageCodec>(new RegionImageCodec(std::move(source), bounds));
+}
+
+RegionImageCodec::RegionImageCodec(std::shared_ptr<ImageCodec> source, const Rect& region)
+    : ImageCodec(static_cast<int>(region.width()), static_cast<int>(region.height()),
+                 Orientation::TopLeft, source->colorSpace()),
+      source(std::move(source)), region(region) {
+}
+
+bool RegionImageCodec::onReadPixels(ColorType colorType, AlphaType alphaType, size_t dstRowBytes,
+                                    std::shared_ptr<ColorSpace> dstColorSpace,
+                                    void* dstPixels) const {
+  auto dstInfo = ImageInfo::Make(width(), height(), colorType, alphaType, dstRowBytes,
+                                 std::move(dstColorSpace));
+  return source->readPixels(region, dstInfo, dstPixels);
+}
+}  // namespace tgfx
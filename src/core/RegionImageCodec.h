@@ -0,0 +1,56 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "tgfx/core/ImageCodec.h"
+
+namespace tgfx {
+/**
+ * An ImageCodec that decodes a rectangular region of another codec, using the region decoding of
+ * the source codec so that only the pixels of the region are decoded.
+ */
+class RegionImageCodec : public ImageCodec {
+ public:
+  /**
+   * Creates a new RegionImageCodec for the given region of the source codec. The region is rounded
+   * out to integer bounds. Returns nullptr if the source is null or the region does not lie within
+   * the source.
+   */
+  static std::shared_ptr<RegionImageCodec> MakeFrom(std::shared_ptr<ImageCodec> source,
+                                                    const Rect& region);
+
+  bool isAlphaOnly() const override {
+    return source->isAlphaOnly();
+  }
+
+  bool asyncSupport() const override {
+    return source->asyncSupport();
+  }
+
+ protected:
+  bool onReadPixels(ColorType colorType, AlphaType alphaType, size_t dstRowBytes,
+                    std::shared_ptr<ColorSpace> dstColorSpace, void* dstPixels) const override;
+
+ private:
+  std::shared_ptr<ImageCodec> source = nullptr;
+  Rect region = {};
+
+  RegionImageCodec(std::shared_ptr<ImageCodec> source, const Rect& region);
+};
+}  // namespace tgfx
@@ -0,0 +1,160 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tgfx/core/Trace.h"
+#include "core/utils/TraceZone.h"
+
+#ifdef TGFX_USE_TRACE
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+#endif
+
+namespace tgfx {
+#ifdef TGFX_USE_TRACE
+// Caps the memory used by a long recording at about 32MB.
+static constexpr size_t MAX_TRACE_EVENTS = 1 << 20;
+
+struct TraceEvent {
+  const char* name = nullptr;
+  int threadID = 0;
+  int64_t timestamp = 0;
+  // The duration of a zone in nanoseconds, or -1 for a counter.
+  int64_t duration = -1;
+  int64_t value = 0;
+};
+
+static std::mutex& EventLocker() {
+  static std::mutex locker = {};
+  return locker;
+}
+
+static std::vector<TraceEvent>& Events() {
+  static std::vector<TraceEvent> events = {};
+  return events;
+}
+
+static int CurrentThreadID() {
+  static std::atomic_int nextThreadID = {1};
+  static thread_local int threadID = nextThreadID.fetch_add(1, std::memory_order_relaxed);
+  return threadID;
+}
+
+static void AddEvent(const TraceEvent& event) {
+  std::lock_guard<std::mutex> autoLock(EventLocker());
+  auto& events = Events();
+  if (events.size() < MAX_TRACE_EVENTS) {
+    events.push_back(event);
+  }
+}
+
+// Writes a time in nanoseconds as microseconds with three decimal places, the unit of the format.
+static void AppendTime(std::string* json, int64_t nanoseconds) {
+  char buffer[32] = {};
+  snprintf(buffer, sizeof(buffer), "%" PRId64 ".%03" PRId64, nanoseconds / 1000,
+           nanoseconds % 1000);
+  json->append(buffer);
+}
+
+std::atomic_bool TraceRecorder::Recording = false;
+
+int64_t TraceRecorder::Now() {
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+void TraceRecorder::AddZone(const char* name, int64_t startTime) {
+  AddEvent({name, CurrentThreadID(), startTime, Now() - startTime, 0});
+}
+
+void TraceRecorder::AddCounter(const char* name, int64_t value) {
+  AddEvent({name, CurrentThreadID(), Now(), -1, value});
+}
+
+bool Trace::IsAvailable() {
+  return true;
+}
+
+bool Trace::IsRecording() {
+  return TraceRecorder::IsRecording();
+}
+
+void Trace::Start() {
+  std::lock_guard<std::mutex> autoLock(EventLocker());
+  Events().clear();
+  TraceRecorder::Recording = true;
+}
+
+void Trace::Stop() {
+  TraceRecorder::Recording = false;
+}
+
+std::shared_ptr<Data> Trace::ExportJSON() {
+  std::vector<TraceEvent> events = {};
+  {
+    std::lock_guard<std::mutex> autoLock(EventLocker());
+    events = Events();
+  }
+  if (events.empty()) {
+    return nullptr;
+  }
+  std::string json = "{\"traceEvents\":[";
+  for (size_t i = 0; i < events.size(); i++) {
+    auto& event = events[i];
+    if (i > 0) {
+      json += ",";
+    }
+    json += "{\"name\":\"";
+    json += event.name;
+    json += "\",\"cat\":\"tgfx\",\"pid\":1,\"tid\":" + std::to_string(event.threadID);
+    json += ",\"ts\":";
+    AppendTime(&json, event.timestamp);
+    if (event.duration >= 0) {
+      json += ",\"ph\":\"X\",\"dur\":";
+      AppendTime(&json, event.duration);
+    } else {
+      json += ",\"ph\":\"C\",\"args\":{\"value\":" + std::to_string(event.value) + "}";
+    }
+    json += "}";
+  }
+  json += "],\"displayTimeUnit\":\"ms\"}";
+  return Data::MakeWithCopy(json.data(), json.size());
+}
+#else
+bool Trace::IsAvailable() {
+  return false;
+}
+
+bool Trace::IsRecording() {
+  return false;
+}
+
+void Trace::Start() {
+}
+
+void Trace::Stop() {
+}
+
+std::shared_ptr<Data> Trace::ExportJSON() {
+  return nullptr;
+}
+#endif
+}  // namespace tgfx
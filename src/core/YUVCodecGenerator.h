@@ -0,0 +1,49 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "tgfx/core/ImageCodec.h"
+
+namespace tgfx {
+/**
+ * YUVCodecGenerator decodes the image of an ImageCodec into YUV planes when the codec supports it,
+ * which are uploaded as a planar texture and converted to RGB on the GPU. Otherwise, it falls back
+ * to the RGBA pixels of the codec.
+ */
+class YUVCodecGenerator : public ImageGenerator {
+ public:
+  static std::shared_ptr<YUVCodecGenerator> MakeFrom(std::shared_ptr<ImageCodec> codec);
+
+  ~YUVCodecGenerator() override = default;
+
+  bool isAlphaOnly() const override {
+    return source->isAlphaOnly();
+  }
+
+  bool asyncSupport() const override {
+    return source->asyncSupport();
+  }
+
+  std::shared_ptr<ImageBuffer> onMakeBuffer(bool tryHardware) const override;
+
+ private:
+  std::shared_ptr<ImageCodec> source = nullptr;
+
+  explicit YUVCodecGenerator(std::shared_ptr<ImageCodec> codec);
+};
+}  // namespace tgfx
@@ -0,0 +1,319 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GifDecoder.h"
+#include <algorithm>
+#include <cstring>
+
+namespace tgfx {
+static constexpr int GIF_MAX_CODE_BITS = 12;
+static constexpr int GIF_MAX_CODES = 1 << GIF_MAX_CODE_BITS;
+static constexpr uint8_t GIF_EXTENSION = 0x21;
+static constexpr uint8_t GIF_IMAGE_DESCRIPTOR = 0x2C;
+static constexpr uint8_t GIF_TRAILER = 0x3B;
+static constexpr uint8_t GIF_GRAPHIC_CONTROL = 0xF9;
+static constexpr uint8_t GIF_APPLICATION = 0xFF;
+
+bool GifDecoder::IsGif(const std::shared_ptr<Data>& data) {
+  auto bytes = data->bytes();
+  return data->size() >= 6 && (!memcmp(bytes, "GIF87a", 6) || !memcmp(bytes, "GIF89a", 6));
+}
+
+std::unique_ptr<AnimatedDecoder> GifDecoder::Make(std::shared_ptr<Data> imageBytes) {
+  if (imageBytes == nullptr || !IsGif(imageBytes)) {
+    return nullptr;
+  }
+  auto decoder = std::unique_ptr<GifDecoder>(new GifDecoder(std::move(imageBytes)));
+  if (!decoder->parse()) {
+    return nullptr;
+  }
+  return decoder;
+}
+
+static int ReadUInt16(const uint8_t* bytes) {
+  return bytes[0] | (bytes[1] << 8);
+}
+
+// Returns the offset right after the chain of data sub-blocks starting at offset, or 0 if the
+// chain is truncated.
+static size_t SkipSubBlocks(const uint8_t* bytes, size_t length, size_t offset) {
+  while (offset < length) {
+    auto blockSize = bytes[offset++];
+    if (blockSize == 0) {
+      return offset;
+    }
+    offset += blockSize;
+  }
+  return 0;
+}
+
+bool GifDecoder::parse() {
+  auto bytes = fileData->bytes();
+  auto length = fileData->size();
+  if (length < 13) {
+    return false;
+  }
+  _width = ReadUInt16(bytes + 6);
+  _height = ReadUInt16(bytes + 8);
+  auto screenFlags = bytes[10];
+  size_t offset = 13;
+  size_t globalTableOffset = 0;
+  int globalTableSize = 0;
+  if (screenFlags & 0x80) {
+    globalTableOffset = offset;
+    globalTableSize = 2 << (screenFlags & 0x07);
+    offset += static_cast<size_t>(globalTableSize) * 3;
+  }
+  // A GIF without the NETSCAPE2.0 extension plays once.
+  _loopCount = 1;
+  int64_t delay = 0;
+  auto disposal = FrameDisposal::Keep;
+  int transparentIndex = -1;
+  while (offset < length) {
+    auto blockType = bytes[offset++];
+    if (blockType == GIF_TRAILER) {
+      break;
+    }
+    if (blockType == GIF_EXTENSION) {
+      if (offset >= length) {
+        break;
+      }
+      auto label = bytes[offset++];
+      if (label == GIF_GRAPHIC_CONTROL && offset + 5 <= length && bytes[offset] >= 4) {
+        auto packed = bytes[offset + 1];
+        auto method = (packed >> 2) & 0x07;
+        disposal = method == 2   ? FrameDisposal::Background
+                   : method == 3 ? FrameDisposal::Previous
+                                 : FrameDisposal::Keep;
+        // The delay is stored in hundredths of a second.
+        delay = static_cast<int64_t>(ReadUInt16(bytes + offset + 2)) * 10000;
+        transparentIndex = (packed & 0x01) ? bytes[offset + 4] : -1;
+      } else if (label == GIF_APPLICATION && offset + 16 <= length && bytes[offset] == 11 &&
+                 (!memcmp(bytes + offset + 1, "NETSCAPE2.0", 11) ||
+                  !memcmp(bytes + offset + 1, "ANIMEXTS1.0", 11))) {
+        auto subBlock = bytes + offset + 12;
+        if (subBlock[0] >= 3 && subBlock[1] == 1) {
+          // The extension stores the number of repetitions after the first play.
+          auto repetitions = ReadUInt16(subBlock + 2);
+          _loopCount = repetitions == 0 ? 0 : repetitions + 1;
+        }
+      }
+      offset = SkipSubBlocks(bytes, length, offset);
+      if (offset == 0) {
+        break;
+      }
+      continue;
+    }
+    if (blockType != GIF_IMAGE_DESCRIPTOR || offset + 9 > length) {
+      break;
+    }
+    GifFrame frame = {};
+    frame.left = ReadUInt16(bytes + offset);
+    frame.top = ReadUInt16(bytes + offset + 2);
+    frame.width = ReadUInt16(bytes + offset + 4);
+    frame.height = ReadUInt16(bytes + offset + 6);
+    auto imageFlags = bytes[offset + 8];
+    offset += 9;
+    frame.interlaced = (imageFlags & 0x40) != 0;
+    if (imageFlags & 0x80) {
+      frame.colorTableOffset = offset;
+      frame.colorTableSize = 2 << (imageFlags & 0x07);
+      offset += static_cast<size_t>(frame.colorTableSize) * 3;
+    } else {
+      frame.colorTableOffset = globalTableOffset;
+      frame.colorTableSize = globalTableSize;
+    }
+    frame.transparentIndex = transparentIndex;
+    frame.dataOffset = offset;
+    if (offset >= length) {
+      break;
+    }
+    if (frame.colorTableSize > 0 && frame.width > 0 && frame.height > 0) {
+      AnimatedFrameInfo info = {};
+      info.bounds = Rect::MakeXYWH(frame.left, frame.top, frame.width, frame.height);
+      info.duration = delay;
+      info.disposal = disposal;
+      _frameInfos.push_back(info);
+      gifFrames.push_back(frame);
+    }
+    delay = 0;
+    disposal = FrameDisposal::Keep;
+    transparentIndex = -1;
+    offset = SkipSubBlocks(bytes, length, offset + 1);
+    if (offset == 0) {
+      break;
+    }
+  }
+  if (_width == 0 || _height == 0) {
+    // Some encoders leave the logical screen empty, so the frames define the canvas instead.
+    for (auto& frame : gifFrames) {
+      _width = std::max(_width, frame.left + frame.width);
+      _height = std::max(_height, frame.top + frame.height);
+    }
+  }
+  return !gifFrames.empty();
+}
+
+// Maps the index of a decoded line to its row in an interlaced frame, which stores every 8th row
+// from row 0, then every 8th row from row 4, every 4th row from row 2, and every 2nd row from row 1.
+static int InterlacedRow(int line, int height) {
+  auto firstPass = (height + 7) / 8;
+  if (line < firstPass) {
+    return line * 8;
+  }
+  line -= firstPass;
+  auto secondPass = (height + 3) / 8;
+  if (line < secondPass) {
+    return line * 8 + 4;
+  }
+  line -= secondPass;
+  auto thirdPass = (height + 1) / 4;
+  if (line < thirdPass) {
+    return line * 4 + 2;
+  }
+  line -= thirdPass;
+  return line * 2 + 1;
+}
+
+bool GifDecoder::decodeFrame(int index, void* pixels, size_t rowBytes) {
+  if (index < 0 || index >= static_cast<int>(gifFrames.size()) || pixels == nullptr) {
+    return false;
+  }
+  auto& frame = gifFrames[static_cast<size_t>(index)];
+  auto dstPixels = static_cast<uint8_t*>(pixels);
+  auto bytes = fileData->bytes();
+  auto length = fileData->size();
+  auto offset = frame.dataOffset;
+  if (offset >= length) {
+    return false;
+  }
+  int minCodeSize = bytes[offset++];
+  if (minCodeSize < 1 || minCodeSize >= GIF_MAX_CODE_BITS) {
+    return false;
+  }
+  auto colorTable = bytes + frame.colorTableOffset;
+  size_t blockRemaining = 0;
+  uint32_t bitBuffer = 0;
+  int bitCount = 0;
+  int codeSize = minCodeSize + 1;
+  // Reads the next code from the sub-blocks, or returns -1 once the image data ends.
+  auto readCode = [&]() {
+    while (bitCount < codeSize) {
+      if (blockRemaining == 0) {
+        if (offset >= length || bytes[offset] == 0) {
+          return -1;
+        }
+        blockRemaining = bytes[offset++];
+      }
+      if (offset >= length) {
+        return -1;
+      }
+      bitBuffer |= static_cast<uint32_t>(bytes[offset++]) << bitCount;
+      bitCount += 8;
+      blockRemaining--;
+    }
+    auto code = static_cast<int>(bitBuffer & ((1u << codeSize) - 1));
+    bitBuffer >>= codeSize;
+    bitCount -= codeSize;
+    return code;
+  };
+  int x = 0;
+  int line = 0;
+  auto row = dstPixels;
+  auto writeIndex = [&](uint8_t colorIndex) {
+    if (line >= frame.height) {
+      return;
+    }
+    if (colorIndex != frame.transparentIndex && colorIndex < frame.colorTableSize) {
+      auto color = colorTable + colorIndex * 3;
+      auto pixel = row + x * 4;
+      pixel[0] = color[0];
+      pixel[1] = color[1];
+      pixel[2] = color[2];
+      pixel[3] = 255;
+    }
+    if (++x == frame.width && ++line < frame.height) {
+      x = 0;
+      auto y = frame.interlaced ? InterlacedRow(line, frame.height) : line;
+      row = dstPixels + rowBytes * static_cast<size_t>(y);
+    }
+  };
+  uint16_t prefix[GIF_MAX_CODES] = {};
+  uint8_t suffix[GIF_MAX_CODES] = {};
+  uint8_t stack[GIF_MAX_CODES + 1] = {};
+  auto clearCode = 1 << minCodeSize;
+  auto endCode = clearCode + 1;
+  for (int i = 0; i < clearCode; i++) {
+    suffix[i] = static_cast<uint8_t>(i);
+  }
+  auto nextCode = endCode + 1;
+  int previousCode = -1;
+  uint8_t firstByte = 0;
+  while (line < frame.height) {
+    auto code = readCode();
+    if (code < 0 || code == endCode) {
+      break;
+    }
+    if (code == clearCode) {
+      codeSize = minCodeSize + 1;
+      nextCode = endCode + 1;
+      previousCode = -1;
+      continue;
+    }
+    if (previousCode < 0) {
+      if (code > clearCode) {
+        break;
+      }
+      firstByte = static_cast<uint8_t>(code);
+      writeIndex(firstByte);
+      previousCode = code;
+      continue;
+    }
+    auto currentCode = code;
+    int stackSize = 0;
+    if (code >= nextCode) {
+      if (code > nextCode) {
+        break;
+      }
+      // The code being defined right now: the previous string followed by its own first byte.
+      stack[stackSize++] = firstByte;
+      code = previousCode;
+    }
+    while (code > endCode) {
+      stack[stackSize++] = suffix[code];
+      code = prefix[code];
+    }
+    firstByte = suffix[code];
+    stack[stackSize++] = firstByte;
+    while (stackSize > 0) {
+      writeIndex(stack[--stackSize]);
+    }
+    if (nextCode < GIF_MAX_CODES) {
+      prefix[nextCode] = static_cast<uint16_t>(previousCode);
+      suffix[nextCode] = firstByte;
+      nextCode++;
+      if (nextCode == (1 << codeSize) && codeSize < GIF_MAX_CODE_BITS) {
+        codeSize++;
+      }
+    }
+    previousCode = currentCode;
+  }
+  // A frame that ends early keeps the rows decoded so far, as browsers do.
+  return true;
+}
+}  // namespace tgfx
@@ -0,0 +1,59 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/AnimatedDecoder.h"
+
+namespace tgfx {
+/**
+ * GifDecoder decodes the frames of GIF87a and GIF89a images with a built-in LZW decoder, so GIF
+ * support does not depend on any third-party library. Frames of a truncated file are kept up to the
+ * last one whose image data has started.
+ */
+class GifDecoder : public AnimatedDecoder {
+ public:
+  static std::unique_ptr<AnimatedDecoder> Make(std::shared_ptr<Data> imageBytes);
+  static bool IsGif(const std::shared_ptr<Data>& data);
+
+  bool decodeFrame(int index, void* pixels, size_t rowBytes) override;
+
+ private:
+  struct GifFrame {
+    int left = 0;
+    int top = 0;
+    int width = 0;
+    int height = 0;
+    bool interlaced = false;
+    int transparentIndex = -1;
+    // The offset and entry count of the color table the frame uses.
+    size_t colorTableOffset = 0;
+    int colorTableSize = 0;
+    // The offset of the LZW minimum code size byte.
+    size_t dataOffset = 0;
+  };
+
+  std::shared_ptr<Data> fileData = nullptr;
+  std::vector<GifFrame> gifFrames = {};
+
+  explicit GifDecoder(std::shared_ptr<Data> fileData) : fileData(std::move(fileData)) {
+  }
+
+  bool parse();
+};
+}  // namespace tgfx
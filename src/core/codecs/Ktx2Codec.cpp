@@ -0,0 +1,163 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "core/codecs/Ktx2Codec.h"
+#include "core/CompressedBuffer.h"
+#include "core/utils/BlockCompression.h"
+#include "core/utils/Log.h"
+#include "core/utils/PixelFormatUtil.h"
+#include "tgfx/core/Buffer.h"
+#include "tgfx/core/Pixmap.h"
+
+namespace tgfx {
+static constexpr uint8_t KTX2_IDENTIFIER[] = {0xAB, 'K',  'T',  'X', ' ',  '2',
+                                              '0',  0xBB, '\r', '\n', 0x1A, '\n'};
+static constexpr size_t KTX2_HEADER_SIZE = 80;
+static constexpr size_t KTX2_LEVEL_INDEX_ENTRY_SIZE = 24;
+// The offsets of the color primaries and the flags in the basic data format descriptor block,
+// counting the leading total size field of the data format descriptor.
+static constexpr size_t DFD_PRIMARIES_OFFSET = 13;
+static constexpr size_t DFD_FLAGS_OFFSET = 15;
+static constexpr uint8_t DFD_PRIMARIES_DISPLAY_P3 = 10;
+static constexpr uint8_t DFD_FLAG_ALPHA_PREMULTIPLIED = 1;
+
+static uint32_t ReadUInt32(const uint8_t* bytes) {
+  return static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8 |
+         static_cast<uint32_t>(bytes[2]) << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+static uint64_t ReadUInt64(const uint8_t* bytes) {
+  return static_cast<uint64_t>(ReadUInt32(bytes)) |
+         static_cast<uint64_t>(ReadUInt32(bytes + 4)) << 32;
+}
+
+// The sRGB variants map to the same formats as the UNORM ones, so the encoded values are sampled
+// untouched like the pixels of any other image.
+static PixelFormat VkFormatToPixelFormat(uint32_t vkFormat) {
+  switch (vkFormat) {
+    case 131:  // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+    case 132:  // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+      return PixelFormat::BC1_RGB;
+    case 137:  // VK_FORMAT_BC3_UNORM_BLOCK
+    case 138:  // VK_FORMAT_BC3_SRGB_BLOCK
+      return PixelFormat::BC3_RGBA;
+    case 147:  // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+    case 148:  // VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK
+      return PixelFormat::ETC2_RGB8;
+    case 151:  // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+    case 152:  // VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK
+      return PixelFormat::ETC2_RGBA8;
+    case 157:  // VK_FORMAT_ASTC_4x4_UNORM_BLOCK
+    case 158:  // VK_FORMAT_ASTC_4x4_SRGB_BLOCK
+      return PixelFormat::ASTC_4x4;
+    default:
+      return PixelFormat::Unknown;
+  }
+}
+
+bool Ktx2Codec::IsKtx2(const std::shared_ptr<Data>& data) {
+  return data->size() >= sizeof(KTX2_IDENTIFIER) &&
+         !memcmp(data->bytes(), KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER));
+}
+
+std::shared_ptr<ImageCodec> Ktx2Codec::MakeFrom(const std::string& filePath) {
+  return MakeFrom(Data::MakeFromFile(filePath));
+}
+
+std::shared_ptr<ImageCodec> Ktx2Codec::MakeFrom(std::shared_ptr<Data> imageBytes) {
+  if (imageBytes == nullptr || !IsKtx2(imageBytes) ||
+      imageBytes->size() < KTX2_HEADER_SIZE + KTX2_LEVEL_INDEX_ENTRY_SIZE) {
+    return nullptr;
+  }
+  auto bytes = imageBytes->bytes();
+  auto size = imageBytes->size();
+  auto format = VkFormatToPixelFormat(ReadUInt32(bytes + 12));
+  auto width = ReadUInt32(bytes + 20);
+  auto height = ReadUInt32(bytes + 24);
+  auto depth = ReadUInt32(bytes + 28);
+  auto layerCount = ReadUInt32(bytes + 32);
+  auto faceCount = ReadUInt32(bytes + 36);
+  auto supercompressionScheme = ReadUInt32(bytes + 44);
+  if (format == PixelFormat::Unknown || width == 0 || height == 0 || depth != 0 ||
+      layerCount > 1 || faceCount != 1 || supercompressionScheme != 0 ||
+      width > static_cast<uint32_t>(INT32_MAX) || height > static_cast<uint32_t>(INT32_MAX) ||
+      !ImageInfo::IsValidSize(static_cast<int>(width), static_cast<int>(height))) {
+    LOGE("Ktx2Codec::MakeFrom() Unsupported KTX2 texture!");
+    return nullptr;
+  }
+  // The level index lists the base level first.
+  auto levelOffset = ReadUInt64(bytes + KTX2_HEADER_SIZE);
+  auto levelLength = ReadUInt64(bytes + KTX2_HEADER_SIZE + 8);
+  auto dataSize = PixelFormatDataSize(format, static_cast<int>(width), static_cast<int>(height));
+  if (levelOffset > size || levelLength > size - levelOffset || levelLength < dataSize) {
+    LOGE("Ktx2Codec::MakeFrom() The base level of the KTX2 texture is truncated!");
+    return nullptr;
+  }
+  auto alphaType = AlphaType::Opaque;
+  std::shared_ptr<ColorSpace> colorSpace = nullptr;
+  auto dfdOffset = ReadUInt32(bytes + 48);
+  auto dfdLength = ReadUInt32(bytes + 52);
+  if (dfdLength > DFD_FLAGS_OFFSET && dfdOffset <= size && dfdLength <= size - dfdOffset) {
+    if (format == PixelFormat::ETC2_RGBA8 || format == PixelFormat::BC3_RGBA ||
+        format == PixelFormat::ASTC_4x4) {
+      auto premultiplied = bytes[dfdOffset + DFD_FLAGS_OFFSET] & DFD_FLAG_ALPHA_PREMULTIPLIED;
+      alphaType = premultiplied ? AlphaType::Premultiplied : AlphaType::Unpremultiplied;
+    }
+    if (bytes[dfdOffset + DFD_PRIMARIES_OFFSET] == DFD_PRIMARIES_DISPLAY_P3) {
+      colorSpace = ColorSpace::DisplayP3();
+    }
+  }
+  return std::shared_ptr<ImageCodec>(new Ktx2Codec(
+      static_cast<int>(width), static_cast<int>(height), std::move(imageBytes), format, alphaType,
+      static_cast<size_t>(levelOffset), static_cast<size_t>(dataSize), std::move(colorSpace)));
+}
+
+static void ReleaseFileData(const void*, void* context) {
+  delete static_cast<std::shared_ptr<Data>*>(context);
+}
+
+std::shared_ptr<Data> Ktx2Codec::levelData() const {
+  // The returned data points into the file data and keeps it alive.
+  auto context = new std::shared_ptr<Data>(fileData);
+  return Data::MakeAdopted(fileData->bytes() + levelOffset, levelLength, ReleaseFileData, context);
+}
+
+std::shared_ptr<ImageBuffer> Ktx2Codec::onMakeBuffer(bool tryHardware) const {
+  // Textures expect premultiplied colors, so the blocks of unpremultiplied images are decoded and
+  // premultiplied on the CPU instead.
+  if (alphaType != AlphaType::Unpremultiplied) {
+    return CompressedBuffer::Make(width(), height(), _format, levelData(), colorSpace());
+  }
+  return ImageCodec::onMakeBuffer(tryHardware);
+}
+
+bool Ktx2Codec::onReadPixels(ColorType colorType, AlphaType dstAlphaType, size_t dstRowBytes,
+                             std::shared_ptr<ColorSpace> dstColorSpace, void* dstPixels) const {
+  auto srcInfo = ImageInfo::Make(width(), height(), ColorType::RGBA_8888, alphaType, 0,
+                                 colorSpace());
+  Buffer buffer(srcInfo.byteSize());
+  if (buffer.isEmpty() || !DecodeCompressedBlocks(_format, fileData->bytes() + levelOffset,
+                                                  width(), height(), buffer.data(),
+                                                  srcInfo.rowBytes())) {
+    return false;
+  }
+  auto dstInfo = ImageInfo::Make(width(), height(), colorType, dstAlphaType, dstRowBytes,
+                                 std::move(dstColorSpace));
+  return Pixmap(srcInfo, buffer.data()).readPixels(dstInfo, dstPixels);
+}
+}  // namespace tgfx
@@ -0,0 +1,71 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "tgfx/core/ImageCodec.h"
+#include "tgfx/gpu/PixelFormat.h"
+
+namespace tgfx {
+/**
+ * Ktx2Codec decodes KTX2 containers holding a 2D texture in a block-compressed format. The blocks
+ * of the base mipmap level are handed to the GPU untouched if the current device supports the
+ * format, and are decoded on the CPU otherwise. Supercompressed files, cube maps and texture
+ * arrays are not supported.
+ */
+class Ktx2Codec : public ImageCodec {
+ public:
+  static std::shared_ptr<ImageCodec> MakeFrom(const std::string& filePath);
+  static std::shared_ptr<ImageCodec> MakeFrom(std::shared_ptr<Data> imageBytes);
+  static bool IsKtx2(const std::shared_ptr<Data>& data);
+
+  /**
+   * Returns the compressed format of the image.
+   */
+  PixelFormat format() const {
+    return _format;
+  }
+
+ protected:
+  std::shared_ptr<ImageBuffer> onMakeBuffer(bool tryHardware) const override;
+
+  bool onReadPixels(ColorType colorType, AlphaType alphaType, size_t dstRowBytes,
+                    std::shared_ptr<ColorSpace> dstColorSpace, void* dstPixels) const override;
+
+  std::shared_ptr<Data> getEncodedData() const override {
+    return fileData;
+  }
+
+ private:
+  std::shared_ptr<Data> fileData = nullptr;
+  PixelFormat _format = PixelFormat::Unknown;
+  AlphaType alphaType = AlphaType::Opaque;
+  size_t levelOffset = 0;
+  size_t levelLength = 0;
+
+  Ktx2Codec(int width, int height, std::shared_ptr<Data> fileData, PixelFormat format,
+            AlphaType alphaType, size_t levelOffset, size_t levelLength,
+            std::shared_ptr<ColorSpace> colorSpace)
+      : ImageCodec(width, height, Orientation::TopLeft, std::move(colorSpace)),
+        fileData(std::move(fileData)), _format(format), alphaType(alphaType),
+        levelOffset(levelOffset), levelLength(levelLength) {
+  }
+
+  std::shared_ptr<Data> levelData() const;
+};
+}  // namespace tgfx
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "core/codecs/jpeg/JpegCodec.h"
+#include <algorithm>
 #include <csetjmp>
 #include "core/utils/ColorSpaceHelper.h"
 #include "core/utils/Log.h"
@@ -25,6 +26,7 @@
 #include "skcms.h"
 #include "tgfx/core/Buffer.h"
 #include "tgfx/core/Data.h"
+#include "tgfx/core/ImageBuffer.h"
 #include "tgfx/core/Pixmap.h"
 
 extern "C" {
@@ -247,15 +249,26 @@ bool JpegCodec::onReadPixels(ColorType colorType, AlphaType alphaType, size_t ds
                           std::move(colorSpace));
 }
 
+bool JpegCodec::onReadRegion(const Rect& srcRect, ColorType colorType, AlphaType alphaType,
+                             size_t dstRowBytes, std::shared_ptr<ColorSpace> dstColorSpace,
+                             void* dstPixels) const {
+  return readScaledPixels(colorType, alphaType, dstRowBytes, dstPixels, JPEG_SCALE_DENOM,
+                          std::move(dstColorSpace), &srcRect);
+}
+
 bool JpegCodec::readScaledPixels(ColorType colorType, AlphaType alphaType, size_t dstRowBytes,
                                  void* dstPixels, uint32_t scaleNum,
-                                 std::shared_ptr<ColorSpace> dstColorSpace) const {
+                                 std::shared_ptr<ColorSpace> dstColorSpace,
+                                 const Rect* srcRect) const {
   if (dstPixels == nullptr) {
     return false;
   }
   if (colorType == ColorType::ALPHA_8) {
     auto [_, alphaHeight] =
         getScaledDimensions(static_cast<float>(scaleNum) / static_cast<float>(JPEG_SCALE_DENOM));
+    if (srcRect != nullptr) {
+      alphaHeight = static_cast<int>(srcRect->height());
+    }
     memset(dstPixels, 255, dstRowBytes * static_cast<size_t>(alphaHeight));
     return true;
   }
@@ -319,6 +332,39 @@ bool JpegCodec::readScaledPixels(ColorType colorType, AlphaType alphaType, size_
     // Use libjpeg's authoritative output dimensions to avoid buffer overflow.
     auto dstWidth = static_cast<int>(cinfo.output_width);
     auto dstHeight = static_cast<int>(cinfo.output_height);
+    // For region decoding, libjpeg widens the cropped columns to iMCU boundaries, so each scanline
+    // is decoded into a row buffer and the requested columns are copied out of it. Fancy
+    // upsampling replicates chroma at the edges of the crop and right after skipped rows, so the
+    // crop keeps one extra column on the left and one iMCU on the right, and the skip stops one
+    // iMCU row early.
+    // This makes the region match the same pixels of a full decode exactly.
+    JDIMENSION cropOffset = 0;
+    Buffer cropRow = {};
+    if (srcRect != nullptr) {
+      auto iMCUWidth = static_cast<JDIMENSION>(cinfo.max_h_samp_factor * DCTSIZE);
+      auto iMCUHeight = static_cast<JDIMENSION>(cinfo.max_v_samp_factor * DCTSIZE);
+      auto left = static_cast<JDIMENSION>(srcRect->left);
+      auto top = static_cast<JDIMENSION>(srcRect->top);
+      auto cropLeft = left > 0 ? left - 1 : 0;
+      auto cropRight = std::min(static_cast<JDIMENSION>(srcRect->right) + iMCUWidth,
+                                cinfo.output_width);
+      auto cropWidth = cropRight - cropLeft;
+      cropOffset = cropLeft;
+      jpeg_crop_scanline(&cinfo, &cropOffset, &cropWidth);
+      cropOffset = left - cropOffset;
+      auto skipRows = top / iMCUHeight * iMCUHeight;
+      skipRows = skipRows > iMCUHeight ? skipRows - iMCUHeight : 0;
+      jpeg_skip_scanlines(&cinfo, skipRows);
+      dstWidth = static_cast<int>(srcRect->width());
+      dstHeight = static_cast<int>(srcRect->height());
+      if (!cropRow.alloc(static_cast<size_t>(cinfo.output_width) * 4)) {
+        break;
+      }
+      JSAMPROW skipRow[1] = {static_cast<JSAMPROW>(cropRow.bytes())};
+      while (cinfo.output_scanline < top) {
+        jpeg_read_scanlines(&cinfo, skipRow, 1);
+      }
+    }
     auto dstInfo =
         ImageInfo::Make(dstWidth, dstHeight, colorType, alphaType, dstRowBytes, dstColorSpace);
     auto outPixels = dstPixels;
@@ -335,10 +381,24 @@ bool JpegCodec::readScaledPixels(ColorType colorType, AlphaType alphaType, size_
       outRowBytes = pixmap.rowBytes();
     }
     JSAMPROW pRow[1];
-    while (cinfo.output_scanline < cinfo.output_height) {
-      pRow[0] = static_cast<JSAMPROW>(static_cast<unsigned char*>(outPixels) +
-                                      outRowBytes * static_cast<size_t>(cinfo.output_scanline));
-      jpeg_read_scanlines(&cinfo, pRow, 1);
+    if (srcRect != nullptr) {
+      auto outColorType = needsBitmapConversion ? ColorType::RGBA_8888 : colorType;
+      auto bytesPerPixel = cinfo.out_color_space == JCS_CMYK
+                               ? static_cast<size_t>(4)
+                               : ImageInfo::GetBytesPerPixel(outColorType);
+      auto copyBytes = bytesPerPixel * static_cast<size_t>(dstWidth);
+      pRow[0] = static_cast<JSAMPROW>(cropRow.bytes());
+      for (size_t y = 0; y < static_cast<size_t>(dstHeight); y++) {
+        jpeg_read_scanlines(&cinfo, pRow, 1);
+        memcpy(static_cast<unsigned char*>(outPixels) + outRowBytes * y,
+               cropRow.bytes() + bytesPerPixel * cropOffset, copyBytes);
+      }
+    } else {
+      while (cinfo.output_scanline < cinfo.output_height) {
+        pRow[0] = static_cast<JSAMPROW>(static_cast<unsigned char*>(outPixels) +
+                                        outRowBytes * static_cast<size_t>(cinfo.output_scanline));
+        jpeg_read_scanlines(&cinfo, pRow, 1);
+      }
     }
     if (cinfo.out_color_space == JCS_CMYK) {
       bool converted = false;
@@ -353,7 +413,14 @@ bool JpegCodec::readScaledPixels(ColorType colorType, AlphaType alphaType, size_
         ConvertCMYKToRGBWithFormula(outPixels, dstInfo);
       }
     }
-    result = jpeg_finish_decompress(&cinfo);
+    if (srcRect != nullptr) {
+      // The rows below the region are never decoded, so the decompression is aborted instead of
+      // finished.
+      jpeg_abort_decompress(&cinfo);
+      result = true;
+    } else {
+      result = jpeg_finish_decompress(&cinfo);
+    }
     if (result) {
       if (!pixmap.isEmpty()) {
         pixmap.readPixels(dstInfo, dstPixels);
@@ -370,6 +437,108 @@ bool JpegCodec::readScaledPixels(ColorType colorType, AlphaType alphaType, size_
   return result;
 }
 
+static void ReleaseYUVPlanes(void* context, const void**, size_t) {
+  free(context);
+}
+
+static bool IsYUV420(const jpeg_decompress_struct& cinfo) {
+  if (cinfo.jpeg_color_space != JCS_YCbCr || cinfo.num_components != 3) {
+    return false;
+  }
+  auto components = cinfo.comp_info;
+  if (components[0].h_samp_factor != 2 || components[0].v_samp_factor != 2) {
+    return false;
+  }
+  for (int i = 1; i < 3; i++) {
+    if (components[i].h_samp_factor != 1 || components[i].v_samp_factor != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<ImageBuffer> JpegCodec::makeYUVBuffer() const {
+  FILE* infile = nullptr;
+  if (fileData == nullptr && (infile = fopen(filePath.c_str(), "rb")) == nullptr) {
+    return nullptr;
+  }
+  jpeg_decompress_struct cinfo = {};
+  my_error_mgr jerr = {};
+  cinfo.err = jpeg_std_error(&jerr.pub);
+  std::shared_ptr<YUVData> yuvData = nullptr;
+  void* planeMemory = nullptr;
+  do {
+    if (setjmp(jerr.setjmp_buffer)) break;
+    jpeg_create_decompress(&cinfo);
+    if (infile) {
+      jpeg_stdio_src(&cinfo, infile);
+    } else {
+      jpeg_mem_src(&cinfo, fileData->bytes(), fileData->size());
+    }
+    if (jpeg_read_header(&cinfo, TRUE) != JPEG_HEADER_OK || !IsYUV420(cinfo)) {
+      break;
+    }
+    // Take the DCT output planes as they are, which skips both the chroma upsampling and the
+    // YCbCr to RGB conversion.
+    cinfo.raw_data_out = TRUE;
+    cinfo.out_color_space = JCS_YCbCr;
+    if (!jpeg_start_decompress(&cinfo)) {
+      break;
+    }
+    // jpeg_read_raw_data() outputs whole iMCU rows of 16 luma rows and 8 chroma rows, and each row
+    // is padded to whole DCT blocks, so the planes are allocated in multiples of the iMCU size.
+    auto iMCUHeight = static_cast<size_t>(DCTSIZE * 2);
+    auto iMCUColumns = (static_cast<size_t>(cinfo.output_width) + iMCUHeight - 1) / iMCUHeight;
+    auto iMCURows = (static_cast<size_t>(cinfo.output_height) + iMCUHeight - 1) / iMCUHeight;
+    size_t rowBytes[3] = {iMCUColumns * iMCUHeight, iMCUColumns * DCTSIZE,
+                          iMCUColumns * DCTSIZE};
+    size_t planeHeights[3] = {iMCURows * iMCUHeight, iMCURows * DCTSIZE, iMCURows * DCTSIZE};
+    auto totalBytes = rowBytes[0] * planeHeights[0] + rowBytes[1] * planeHeights[1] * 2;
+    planeMemory = malloc(totalBytes);
+    if (planeMemory == nullptr) {
+      break;
+    }
+    JSAMPLE* planes[3] = {};
+    planes[0] = static_cast<JSAMPLE*>(planeMemory);
+    planes[1] = planes[0] + rowBytes[0] * planeHeights[0];
+    planes[2] = planes[1] + rowBytes[1] * planeHeights[1];
+    JSAMPROW yRows[DCTSIZE * 2];
+    JSAMPROW uRows[DCTSIZE];
+    JSAMPROW vRows[DCTSIZE];
+    JSAMPARRAY rows[3] = {yRows, uRows, vRows};
+    while (cinfo.output_scanline < cinfo.output_height) {
+      auto lumaRow = static_cast<size_t>(cinfo.output_scanline);
+      for (size_t i = 0; i < iMCUHeight; i++) {
+        yRows[i] = planes[0] + rowBytes[0] * (lumaRow + i);
+      }
+      for (size_t i = 0; i < DCTSIZE; i++) {
+        uRows[i] = planes[1] + rowBytes[1] * (lumaRow / 2 + i);
+        vRows[i] = planes[2] + rowBytes[2] * (lumaRow / 2 + i);
+      }
+      if (jpeg_read_raw_data(&cinfo, rows, static_cast<JDIMENSION>(iMCUHeight)) == 0) {
+        break;
+      }
+    }
+    if (cinfo.output_scanline < cinfo.output_height || !jpeg_finish_decompress(&cinfo)) {
+      break;
+    }
+    const void* planeData[3] = {planes[0], planes[1], planes[2]};
+    yuvData = YUVData::MakeFrom(static_cast<int>(cinfo.output_width),
+                                static_cast<int>(cinfo.output_height), planeData, rowBytes,
+                                YUVData::I420_PLANE_COUNT, ReleaseYUVPlanes, planeMemory);
+  } while (false);
+  jpeg_destroy_decompress(&cinfo);
+  if (infile) {
+    fclose(infile);
+  }
+  if (yuvData == nullptr) {
+    free(planeMemory);
+    return nullptr;
+  }
+  // JPEG stores full range BT.601 YCbCr, which converts back to RGB in the color space of the file.
+  return ImageBuffer::MakeI420(std::move(yuvData), YUVColorSpace::JPEG_FULL, colorSpace());
+}
+
 std::shared_ptr<Data> JpegCodec::getEncodedData() const {
   if (fileData) {
     return fileData;
@@ -35,10 +35,16 @@ class JpegCodec : public ImageCodec {
 
   bool readPixels(const ImageInfo& dstInfo, void* dstPixels) const override;
 
+  std::shared_ptr<ImageBuffer> makeYUVBuffer() const override;
+
  protected:
   bool onReadPixels(ColorType colorType, AlphaType alphaType, size_t dstRowBytes,
                     std::shared_ptr<ColorSpace> colorSpace, void* dstPixels) const override;
 
+  bool onReadRegion(const Rect& srcRect, ColorType colorType, AlphaType alphaType,
+                    size_t dstRowBytes, std::shared_ptr<ColorSpace> dstColorSpace,
+                    void* dstPixels) const override;
+
   std::shared_ptr<Data> getEncodedData() const override;
 
  private:
@@ -47,7 +53,8 @@ class JpegCodec : public ImageCodec {
 
   bool readScaledPixels(ColorType colorType, AlphaType alphaType, size_t dstRowBytes,
                         void* dstPixels, uint32_t scaleNum,
-                        std::shared_ptr<ColorSpace> dstColorSpace) const;
+                        std::shared_ptr<ColorSpace> dstColorSpace,
+                        const Rect* srcRect = nullptr) const;
 
   static std::shared_ptr<ImageCodec> MakeFromData(const std::string& filePath,
                                                   std::shared_ptr<Data> byteData);
@@ -0,0 +1,277 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "JpegProgressiveDecoder.h"
+#include <algorithm>
+#include <csetjmp>
+#include <vector>
+#include "core/utils/OrientationHelper.h"
+
+extern "C" {
+#include "jerror.h"
+#include "jpeglib.h"
+}
+
+namespace tgfx {
+static const JOCTET FAKE_EOI[2] = {0xFF, JPEG_EOI};
+
+struct JpegErrorManager {
+  jpeg_error_mgr pub;
+  jmp_buf setjmpBuffer;
+};
+
+// The source keeps the bytes libjpeg has not consumed yet. libjpeg resumes from next_input_byte
+// after a suspension, so those bytes must stay in place until the next decode() call.
+struct JpegSourceManager {
+  jpeg_source_mgr pub;
+  std::vector<uint8_t> buffer;
+  size_t bytesToSkip;
+  bool endOfStream;
+};
+
+struct JpegProgressiveState {
+  jpeg_decompress_struct cinfo = {};
+  JpegErrorManager errorManager = {};
+  JpegSourceManager source = {};
+  bool decompressStarted = false;
+  bool outputPassStarted = false;
+  bool cmyk = false;
+};
+
+static void JpegErrorExit(j_common_ptr cinfo) {
+  auto errorManager = reinterpret_cast<JpegErrorManager*>(cinfo->err);
+  longjmp(errorManager->setjmpBuffer, 1);
+}
+
+static void JpegOutputMessage(j_common_ptr) {
+  // Truncated data is expected while the bytes are still arriving, so warnings are not printed.
+}
+
+static void JpegInitSource(j_decompress_ptr) {
+}
+
+static boolean JpegFillInputBuffer(j_decompress_ptr cinfo) {
+  auto source = reinterpret_cast<JpegSourceManager*>(cinfo->src);
+  if (!source->endOfStream) {
+    // Suspend the decoder until more bytes arrive.
+    return FALSE;
+  }
+  // No more bytes are coming, end the image the same way libjpeg ends truncated files.
+  WARNMS(cinfo, JWRN_JPEG_EOF);
+  source->pub.next_input_byte = FAKE_EOI;
+  source->pub.bytes_in_buffer = 2;
+  return TRUE;
+}
+
+static void JpegSkipInputData(j_decompress_ptr cinfo, long numBytes) {
+  if (numBytes <= 0) {
+    return;
+  }
+  auto source = reinterpret_cast<JpegSourceManager*>(cinfo->src);
+  auto count = static_cast<size_t>(numBytes);
+  if (count > source->pub.bytes_in_buffer) {
+    source->bytesToSkip += count - source->pub.bytes_in_buffer;
+    count = source->pub.bytes_in_buffer;
+  }
+  source->pub.next_input_byte += count;
+  source->pub.bytes_in_buffer -= count;
+}
+
+static void JpegTermSource(j_decompress_ptr) {
+}
+
+static Orientation GetExifOrientation(jpeg_decompress_struct* cinfo) {
+  // Account for 'E', 'x', 'i', 'f', '\0', '<fill byte>'.
+  constexpr uint8_t ExifSignature[] = {'E', 'x', 'i', 'f', '\0'};
+  constexpr size_t ExifOffset = 6;
+  Orientation orientation = Orientation::TopLeft;
+  for (auto marker = cinfo->marker_list; marker; marker = marker->next) {
+    if (marker->marker != JPEG_APP0 + 1 || marker->data_length <= ExifOffset ||
+        memcmp(marker->data, ExifSignature, sizeof(ExifSignature)) != 0) {
+      continue;
+    }
+    if (is_orientation_marker(marker->data + ExifOffset, marker->data_length - ExifOffset,
+                              &orientation)) {
+      return orientation;
+    }
+  }
+  return Orientation::TopLeft;
+}
+
+// libjpeg outputs inverted CMYK (like Photoshop), so R = C * K / 255.
+static void ConvertCMYKRowToRGBA(uint8_t* row, int width) {
+  for (int x = 0; x < width; x++) {
+    auto pixel = row + x * 4;
+    auto k = pixel[3];
+    pixel[0] = static_cast<uint8_t>((pixel[0] * k + 127) / 255);
+    pixel[1] = static_cast<uint8_t>((pixel[1] * k + 127) / 255);
+    pixel[2] = static_cast<uint8_t>((pixel[2] * k + 127) / 255);
+    pixel[3] = 255;
+  }
+}
+
+JpegProgressiveDecoder::JpegProgressiveDecoder()
+    : state(std::make_unique<JpegProgressiveState>()) {
+  _alphaType = AlphaType::Opaque;
+  auto cinfo = &state->cinfo;
+  cinfo->err = jpeg_std_error(&state->errorManager.pub);
+  state->errorManager.pub.error_exit = JpegErrorExit;
+  state->errorManager.pub.output_message = JpegOutputMessage;
+  if (setjmp(state->errorManager.setjmpBuffer)) {
+    failed = true;
+    return;
+  }
+  jpeg_create_decompress(cinfo);
+  auto& source = state->source.pub;
+  source.init_source = JpegInitSource;
+  source.fill_input_buffer = JpegFillInputBuffer;
+  source.skip_input_data = JpegSkipInputData;
+  source.resync_to_restart = jpeg_resync_to_restart;
+  source.term_source = JpegTermSource;
+  cinfo->src = &source;
+  jpeg_save_markers(cinfo, JPEG_APP0 + 1, 0xFFFF);
+}
+
+JpegProgressiveDecoder::~JpegProgressiveDecoder() {
+  jpeg_destroy_decompress(&state->cinfo);
+}
+
+bool JpegProgressiveDecoder::receiveBytes(GrowableStream* stream) {
+  auto& source = state->source;
+  if (source.endOfStream) {
+    return false;
+  }
+  auto& buffer = source.buffer;
+  auto consumed = buffer.size() - source.pub.bytes_in_buffer;
+  buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(consumed));
+  auto length = stream->size() - stream->position();
+  if (length > 0) {
+    auto offset = buffer.size();
+    buffer.resize(offset + length);
+    length = stream->read(buffer.data() + offset, length);
+    buffer.resize(offset + length);
+  }
+  auto skipped = std::min(source.bytesToSkip, buffer.size());
+  buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(skipped));
+  source.bytesToSkip -= skipped;
+  source.pub.next_input_byte = buffer.data();
+  source.pub.bytes_in_buffer = buffer.size();
+  source.endOfStream = stream->isFinished() && stream->position() == stream->size();
+  return length > 0;
+}
+
+bool JpegProgressiveDecoder::readHeader(GrowableStream* stream) {
+  if (_width > 0) {
+    return true;
+  }
+  if (failed) {
+    return false;
+  }
+  receiveBytes(stream);
+  auto cinfo = &state->cinfo;
+  if (setjmp(state->errorManager.setjmpBuffer)) {
+    failed = true;
+    return false;
+  }
+  auto result = jpeg_read_header(cinfo, TRUE);
+  if (result == JPEG_SUSPENDED) {
+    return false;
+  }
+  if (result != JPEG_HEADER_OK) {
+    failed = true;
+    return false;
+  }
+  _orientation = GetExifOrientation(cinfo);
+  state->cmyk = cinfo->jpeg_color_space == JCS_CMYK || cinfo->jpeg_color_space == JCS_YCCK;
+  cinfo->out_color_space = state->cmyk ? JCS_CMYK : JCS_EXT_RGBA;
+  cinfo->buffered_image = jpeg_has_multiple_scans(cinfo);
+  _width = static_cast<int>(cinfo->image_width);
+  _height = static_cast<int>(cinfo->image_height);
+  return true;
+}
+
+bool JpegProgressiveDecoder::readScanlines(uint8_t* pixels, size_t rowBytes) {
+  auto cinfo = &state->cinfo;
+  while (cinfo->output_scanline < cinfo->output_height) {
+    auto row = pixels + static_cast<size_t>(cinfo->output_scanline) * rowBytes;
+    if (jpeg_read_scanlines(cinfo, &row, 1) != 1) {
+      return false;
+    }
+    if (state->cmyk) {
+      ConvertCMYKRowToRGBA(row, _width);
+    }
+  }
+  return true;
+}
+
+bool JpegProgressiveDecoder::decode(GrowableStream* stream, void* pixels, size_t rowBytes) {
+  if (!readHeader(stream) || complete || failed) {
+    return !failed;
+  }
+  auto hasNewBytes = receiveBytes(stream);
+  auto cinfo = &state->cinfo;
+  auto dstPixels = static_cast<uint8_t*>(pixels);
+  if (setjmp(state->errorManager.setjmpBuffer)) {
+    failed = true;
+    return false;
+  }
+  if (!state->decompressStarted) {
+    if (!jpeg_start_decompress(cinfo)) {
+      return true;
+    }
+    state->decompressStarted = true;
+    hasNewBytes = true;
+  }
+  if (!cinfo->buffered_image) {
+    if (readScanlines(dstPixels, rowBytes) && jpeg_finish_decompress(cinfo)) {
+      complete = true;
+    }
+    return true;
+  }
+  while (true) {
+    if (!state->outputPassStarted) {
+      if (!hasNewBytes && !state->source.endOfStream) {
+        return true;
+      }
+      // Absorb all the received bytes first, so the pass shows the most recent scan.
+      int status;
+      do {
+        status = jpeg_consume_input(cinfo);
+      } while (status != JPEG_SUSPENDED && status != JPEG_REACHED_EOI);
+      if (!jpeg_start_output(cinfo, cinfo->input_scan_number)) {
+        return true;
+      }
+      state->outputPassStarted = true;
+    }
+    if (!readScanlines(dstPixels, rowBytes) || !jpeg_finish_output(cinfo)) {
+      return true;
+    }
+    state->outputPassStarted = false;
+    if (!jpeg_input_complete(cinfo)) {
+      return true;
+    }
+    if (cinfo->output_scan_number == cinfo->input_scan_number) {
+      if (jpeg_finish_decompress(cinfo)) {
+        complete = true;
+      }
+      return true;
+    }
+    // The rest of the image arrived during this pass, run one more pass with the final scan.
+  }
+}
+}  // namespace tgfx
@@ -0,0 +1,48 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/ProgressiveDecoder.h"
+
+namespace tgfx {
+struct JpegProgressiveState;
+
+/**
+ * JpegProgressiveDecoder decodes a JPEG image as its bytes arrive, using the suspending data source
+ * of libjpeg. Baseline images are decoded row by row. Progressive images are decoded in buffered
+ * image mode, and each decode() call outputs a full pass with the most recent scan.
+ */
+class JpegProgressiveDecoder : public ProgressiveDecoder {
+ public:
+  JpegProgressiveDecoder();
+
+  ~JpegProgressiveDecoder() override;
+
+  bool readHeader(GrowableStream* stream) override;
+
+  bool decode(GrowableStream* stream, void* pixels, size_t rowBytes) override;
+
+ private:
+  std::unique_ptr<JpegProgressiveState> state;
+
+  bool receiveBytes(GrowableStream* stream);
+
+  bool readScanlines(uint8_t* pixels, size_t rowBytes);
+};
+}  // namespace tgfx
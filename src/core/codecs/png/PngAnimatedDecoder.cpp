@@ -0,0 +1,202 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PngAnimatedDecoder.h"
+#include <cstring>
+#include "core/codecs/png/PngCodec.h"
+#include "tgfx/core/Buffer.h"
+#include "zlib.h"
+
+namespace tgfx {
+static constexpr size_t PNG_SIGNATURE_SIZE = 8;
+static constexpr size_t PNG_CHUNK_OVERHEAD = 12;
+static constexpr size_t PNG_IHDR_SIZE = 13;
+static constexpr size_t PNG_FCTL_SIZE = 26;
+
+static uint32_t ReadUInt32(const uint8_t* bytes) {
+  return static_cast<uint32_t>(bytes[0]) << 24 | static_cast<uint32_t>(bytes[1]) << 16 |
+         static_cast<uint32_t>(bytes[2]) << 8 | static_cast<uint32_t>(bytes[3]);
+}
+
+static uint16_t ReadUInt16(const uint8_t* bytes) {
+  return static_cast<uint16_t>(bytes[0] << 8 | bytes[1]);
+}
+
+static void WriteUInt32(uint8_t* bytes, uint32_t value) {
+  bytes[0] = static_cast<uint8_t>(value >> 24);
+  bytes[1] = static_cast<uint8_t>(value >> 16);
+  bytes[2] = static_cast<uint8_t>(value >> 8);
+  bytes[3] = static_cast<uint8_t>(value);
+}
+
+static FrameDisposal ToFrameDisposal(uint8_t disposeOp) {
+  switch (disposeOp) {
+    case 1:
+      return FrameDisposal::Background;
+    case 2:
+      return FrameDisposal::Previous;
+    default:
+      return FrameDisposal::Keep;
+  }
+}
+
+std::unique_ptr<AnimatedDecoder> PngAnimatedDecoder::Make(std::shared_ptr<Data> imageBytes) {
+  if (imageBytes == nullptr || !PngCodec::IsPng(imageBytes)) {
+    return nullptr;
+  }
+  auto decoder = std::unique_ptr<PngAnimatedDecoder>(new PngAnimatedDecoder(imageBytes));
+  auto bytes = imageBytes->bytes();
+  auto length = imageBytes->size();
+  auto offset = PNG_SIGNATURE_SIZE;
+  bool hasAnimation = false;
+  bool hasImageData = false;
+  while (offset + PNG_CHUNK_OVERHEAD <= length) {
+    auto chunkLength = static_cast<size_t>(ReadUInt32(bytes + offset));
+    if (chunkLength > length - offset - PNG_CHUNK_OVERHEAD) {
+      break;
+    }
+    auto type = bytes + offset + 4;
+    auto chunkData = offset + 8;
+    if (!memcmp(type, "IHDR", 4)) {
+      if (chunkLength != PNG_IHDR_SIZE) {
+        return nullptr;
+      }
+      decoder->headerOffset = chunkData;
+      decoder->_width = static_cast<int>(ReadUInt32(bytes + chunkData));
+      decoder->_height = static_cast<int>(ReadUInt32(bytes + chunkData + 4));
+    } else if (!memcmp(type, "acTL", 4)) {
+      if (chunkLength >= 8) {
+        hasAnimation = true;
+        decoder->_loopCount = static_cast<int>(ReadUInt32(bytes + chunkData + 4));
+      }
+    } else if (!memcmp(type, "fcTL", 4)) {
+      if (chunkLength < PNG_FCTL_SIZE) {
+        break;
+      }
+      auto control = bytes + chunkData;
+      auto frameWidth = static_cast<uint64_t>(ReadUInt32(control + 4));
+      auto frameHeight = static_cast<uint64_t>(ReadUInt32(control + 8));
+      auto frameX = static_cast<uint64_t>(ReadUInt32(control + 12));
+      auto frameY = static_cast<uint64_t>(ReadUInt32(control + 16));
+      // Frames must lie within the canvas.
+      if (frameWidth == 0 || frameHeight == 0 ||
+          frameX + frameWidth > static_cast<uint64_t>(decoder->_width) ||
+          frameY + frameHeight > static_cast<uint64_t>(decoder->_height)) {
+        break;
+      }
+      AnimatedFrameInfo info = {};
+      info.bounds = Rect::MakeXYWH(static_cast<int>(frameX), static_cast<int>(frameY),
+                                   static_cast<int>(frameWidth), static_cast<int>(frameHeight));
+      auto delayNumerator = static_cast<int64_t>(ReadUInt16(control + 20));
+      auto delayDenominator = static_cast<int64_t>(ReadUInt16(control + 22));
+      // A zero denominator means the delay is in hundredths of a second.
+      info.duration = delayNumerator * 1000000 / (delayDenominator == 0 ? 100 : delayDenominator);
+      info.disposal = ToFrameDisposal(control[24]);
+      if (decoder->_frameInfos.empty() && info.disposal == FrameDisposal::Previous) {
+        // There is nothing to restore for the first frame, so it is cleared instead.
+        info.disposal = FrameDisposal::Background;
+      }
+      info.blend = control[25] == 1 ? FrameBlend::Over : FrameBlend::Source;
+      decoder->_frameInfos.push_back(info);
+      decoder->frameData.emplace_back();
+    } else if (!memcmp(type, "IDAT", 4)) {
+      // The default image is the first frame only if an fcTL chunk precedes it.
+      if (!decoder->frameData.empty()) {
+        decoder->frameData.back().push_back({chunkData, chunkLength});
+      }
+      hasImageData = true;
+    } else if (!memcmp(type, "fdAT", 4)) {
+      if (!decoder->frameData.empty() && chunkLength > 4) {
+        decoder->frameData.back().push_back({chunkData + 4, chunkLength - 4});
+      }
+    } else if (!memcmp(type, "IEND", 4)) {
+      break;
+    } else if (!hasImageData) {
+      decoder->sharedChunks.push_back({offset, chunkLength + PNG_CHUNK_OVERHEAD});
+    }
+    offset += chunkLength + PNG_CHUNK_OVERHEAD;
+  }
+  if (!hasAnimation || decoder->headerOffset == 0) {
+    return nullptr;
+  }
+  // Drop the frames whose image data never arrived.
+  while (!decoder->frameData.empty() && decoder->frameData.back().empty()) {
+    decoder->frameData.pop_back();
+    decoder->_frameInfos.pop_back();
+  }
+  return decoder;
+}
+
+static uint8_t* WriteChunk(uint8_t* dst, const char* type, const uint8_t* data, size_t length) {
+  WriteUInt32(dst, static_cast<uint32_t>(length));
+  memcpy(dst + 4, type, 4);
+  if (length > 0) {
+    memcpy(dst + 8, data, length);
+  }
+  auto crc = crc32(0, dst + 4, static_cast<uInt>(length + 4));
+  WriteUInt32(dst + 8 + length, static_cast<uint32_t>(crc));
+  return dst + length + PNG_CHUNK_OVERHEAD;
+}
+
+std::shared_ptr<Data> PngAnimatedDecoder::makeFrameStream(int index) const {
+  auto& ranges = frameData[static_cast<size_t>(index)];
+  auto& bounds = _frameInfos[static_cast<size_t>(index)].bounds;
+  auto streamLength = PNG_SIGNATURE_SIZE + PNG_IHDR_SIZE + PNG_CHUNK_OVERHEAD * 2;
+  for (auto& chunk : sharedChunks) {
+    streamLength += chunk.length;
+  }
+  for (auto& range : ranges) {
+    streamLength += range.length + PNG_CHUNK_OVERHEAD;
+  }
+  Buffer buffer(streamLength);
+  if (buffer.isEmpty()) {
+    return nullptr;
+  }
+  auto bytes = fileData->bytes();
+  auto dst = buffer.bytes();
+  memcpy(dst, bytes, PNG_SIGNATURE_SIZE);
+  dst += PNG_SIGNATURE_SIZE;
+  uint8_t header[PNG_IHDR_SIZE] = {};
+  memcpy(header, bytes + headerOffset, PNG_IHDR_SIZE);
+  WriteUInt32(header, static_cast<uint32_t>(bounds.width()));
+  WriteUInt32(header + 4, static_cast<uint32_t>(bounds.height()));
+  dst = WriteChunk(dst, "IHDR", header, PNG_IHDR_SIZE);
+  for (auto& chunk : sharedChunks) {
+    memcpy(dst, bytes + chunk.offset, chunk.length);
+    dst += chunk.length;
+  }
+  for (auto& range : ranges) {
+    dst = WriteChunk(dst, "IDAT", bytes + range.offset, range.length);
+  }
+  WriteChunk(dst, "IEND", nullptr, 0);
+  return buffer.release();
+}
+
+bool PngAnimatedDecoder::decodeFrame(int index, void* pixels, size_t rowBytes) {
+  if (index < 0 || index >= static_cast<int>(frameData.size()) || pixels == nullptr) {
+    return false;
+  }
+  auto codec = PngCodec::MakeFrom(makeFrameStream(index));
+  if (codec == nullptr) {
+    return false;
+  }
+  auto info = ImageInfo::Make(codec->width(), codec->height(), ColorType::RGBA_8888,
+                              AlphaType::Premultiplied, rowBytes, ColorSpace::SRGB());
+  return codec->readPixels(info, pixels);
+}
+}  // namespace tgfx
@@ -0,0 +1,53 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/AnimatedDecoder.h"
+
+namespace tgfx {
+/**
+ * PngAnimatedDecoder decodes the frames of an APNG image. libpng does not understand the animation
+ * chunks, so each frame is rewritten as a standalone PNG stream, with the frame size in its IHDR
+ * chunk and its fdAT chunks turned into IDAT chunks, and then decoded by PngCodec.
+ */
+class PngAnimatedDecoder : public AnimatedDecoder {
+ public:
+  static std::unique_ptr<AnimatedDecoder> Make(std::shared_ptr<Data> imageBytes);
+
+  bool decodeFrame(int index, void* pixels, size_t rowBytes) override;
+
+ private:
+  struct ByteRange {
+    size_t offset = 0;
+    size_t length = 0;
+  };
+
+  std::shared_ptr<Data> fileData = nullptr;
+  size_t headerOffset = 0;
+  // The chunks before the first IDAT that every frame needs, such as PLTE, tRNS and iCCP.
+  std::vector<ByteRange> sharedChunks = {};
+  // The compressed image data of each frame, without the sequence numbers of fdAT chunks.
+  std::vector<std::vector<ByteRange>> frameData = {};
+
+  explicit PngAnimatedDecoder(std::shared_ptr<Data> fileData) : fileData(std::move(fileData)) {
+  }
+
+  std::shared_ptr<Data> makeFrameStream(int index) const;
+};
+}  // namespace tgfx
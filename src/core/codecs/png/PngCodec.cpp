@@ -335,6 +335,49 @@ bool PngCodec::onReadPixels(ColorType colorType, AlphaType alphaType, size_t dst
   return pixmap.readPixels(dstInfo, dstPixels);
 }
 
+bool PngCodec::onReadRegion(const Rect& srcRect, ColorType colorType, AlphaType alphaType,
+                            size_t dstRowBytes, std::shared_ptr<ColorSpace> dstColorSpace,
+                            void* dstPixels) const {
+  auto readInfo = ReadInfo::Make(filePath, fileData);
+  if (readInfo == nullptr) {
+    return false;
+  }
+  if (png_get_interlace_type(readInfo->p, readInfo->pi) != PNG_INTERLACE_NONE) {
+    // Interlaced rows are only complete after the last pass, so the whole image has to be decoded.
+    return ImageCodec::onReadRegion(srcRect, colorType, alphaType, dstRowBytes,
+                                    std::move(dstColorSpace), dstPixels);
+  }
+  auto left = static_cast<size_t>(srcRect.left);
+  auto top = static_cast<size_t>(srcRect.top);
+  auto regionWidth = static_cast<int>(srcRect.width());
+  auto regionHeight = static_cast<int>(srcRect.height());
+  UpdateReadInfo(readInfo->p, readInfo->pi);
+  // Rows are decoded one at a time into a single row buffer: rows above the region are decoded and
+  // dropped, and decoding stops after the last row of the region.
+  auto rowBytes = png_get_rowbytes(readInfo->p, readInfo->pi);
+  ImageInfo info = ImageInfo::Make(regionWidth, regionHeight, ColorType::RGBA_8888,
+                                   AlphaType::Unpremultiplied, 0, colorSpace());
+  readInfo->data = (unsigned char*)malloc(rowBytes + info.byteSize());
+  if (readInfo->data == nullptr) {
+    return false;
+  }
+  if (setjmp(png_jmpbuf(readInfo->p))) {
+    return false;
+  }
+  auto row = readInfo->data;
+  auto regionPixels = readInfo->data + rowBytes;
+  auto bottom = top + static_cast<size_t>(regionHeight);
+  for (size_t y = 0; y < bottom; y++) {
+    png_read_row(readInfo->p, row, nullptr);
+    if (y >= top) {
+      memcpy(regionPixels + info.rowBytes() * (y - top), row + left * 4, info.rowBytes());
+    }
+  }
+  auto dstInfo =
+      ImageInfo::Make(regionWidth, regionHeight, colorType, alphaType, dstRowBytes, dstColorSpace);
+  return Pixmap(info, regionPixels).readPixels(dstInfo, dstPixels);
+}
+
 bool PngCodec::isAlphaOnly() const {
   return _isAlphaOnly;
 }
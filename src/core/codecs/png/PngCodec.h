@@ -38,6 +38,10 @@ class PngCodec : public ImageCodec {
   bool onReadPixels(ColorType colorType, AlphaType alphaType, size_t dstRowBytes,
                     std::shared_ptr<ColorSpace> dstColorSpace, void* dstPixels) const override;
 
+  bool onReadRegion(const Rect& srcRect, ColorType colorType, AlphaType alphaType,
+                    size_t dstRowBytes, std::shared_ptr<ColorSpace> dstColorSpace,
+                    void* dstPixels) const override;
+
   std::shared_ptr<Data> getEncodedData() const override;
 
  private:
@@ -0,0 +1,169 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PngProgressiveDecoder.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "png.h"
+
+namespace tgfx {
+// The signature plus the length, type and width/height fields of the IHDR chunk.
+static constexpr size_t PNG_HEADER_SIZE = 24;
+// The received bytes are handed to libpng in chunks of at most this size.
+static constexpr size_t PNG_READ_CHUNK_SIZE = 64 * 1024;
+
+struct PngProgressiveState {
+  png_structp p = nullptr;
+  png_infop pi = nullptr;
+  uint8_t* pixels = nullptr;
+  size_t rowBytes = 0;
+  bool interlaced = false;
+  bool complete = false;
+};
+
+static void PngInfoCallback(png_structp p, png_infop pi) {
+  auto state = static_cast<PngProgressiveState*>(png_get_progressive_ptr(p));
+  int colorType = png_get_color_type(p, pi);
+  int bitDepth = png_get_bit_depth(p, pi);
+  if (bitDepth == 16) {
+    png_set_strip_16(p);
+  }
+  if (colorType == PNG_COLOR_TYPE_PALETTE) {
+    png_set_palette_to_rgb(p);
+  }
+  if (colorType == PNG_COLOR_TYPE_GRAY && bitDepth < 8) {
+    png_set_expand_gray_1_2_4_to_8(p);
+  }
+  if (png_get_valid(p, pi, PNG_INFO_tRNS)) {
+    png_set_tRNS_to_alpha(p);
+  }
+  if (colorType == PNG_COLOR_TYPE_RGB || colorType == PNG_COLOR_TYPE_GRAY ||
+      colorType == PNG_COLOR_TYPE_PALETTE) {
+    png_set_filler(p, 0xFF, PNG_FILLER_AFTER);
+  }
+  if (colorType == PNG_COLOR_TYPE_GRAY || colorType == PNG_COLOR_TYPE_GRAY_ALPHA) {
+    png_set_gray_to_rgb(p);
+  }
+  state->interlaced = png_set_interlace_handling(p) > 1;
+  png_read_update_info(p, pi);
+}
+
+static void PngRowCallback(png_structp p, png_bytep newRow, png_uint_32 rowIndex, int) {
+  auto state = static_cast<PngProgressiveState*>(png_get_progressive_ptr(p));
+  if (newRow == nullptr) {
+    return;
+  }
+  auto row = state->pixels + static_cast<size_t>(rowIndex) * state->rowBytes;
+  if (state->interlaced) {
+    // Merges the pixels of the current pass into the row decoded by the previous passes.
+    png_progressive_combine_row(p, row, newRow);
+  } else {
+    memcpy(row, newRow, state->rowBytes);
+  }
+}
+
+static void PngEndCallback(png_structp p, png_infop) {
+  auto state = static_cast<PngProgressiveState*>(png_get_progressive_ptr(p));
+  state->complete = true;
+}
+
+static uint32_t ReadBigEndian32(const uint8_t* bytes) {
+  return static_cast<uint32_t>(bytes[0]) << 24 | static_cast<uint32_t>(bytes[1]) << 16 |
+         static_cast<uint32_t>(bytes[2]) << 8 | static_cast<uint32_t>(bytes[3]);
+}
+
+PngProgressiveDecoder::PngProgressiveDecoder() : state(std::make_unique<PngProgressiveState>()) {
+}
+
+PngProgressiveDecoder::~PngProgressiveDecoder() {
+  if (state->p) {
+    png_destroy_read_struct(&state->p, &state->pi, nullptr);
+  }
+}
+
+bool PngProgressiveDecoder::readHeader(GrowableStream* stream) {
+  if (_width > 0) {
+    return true;
+  }
+  if (failed) {
+    return false;
+  }
+  // The IHDR chunk always follows the signature, so the size is read directly from the bytes
+  // without feeding libpng, which would also decode any rows that are already available.
+  uint8_t header[PNG_HEADER_SIZE] = {};
+  if (stream->peek(header, PNG_HEADER_SIZE) < PNG_HEADER_SIZE) {
+    failed = stream->isFinished();
+    return false;
+  }
+  if (memcmp(header + 12, "IHDR", 4) != 0) {
+    failed = true;
+    return false;
+  }
+  auto width = ReadBigEndian32(header + 16);
+  auto height = ReadBigEndian32(header + 20);
+  if (width == 0 || height == 0 || width > INT32_MAX || height > INT32_MAX) {
+    failed = true;
+    return false;
+  }
+  _width = static_cast<int>(width);
+  _height = static_cast<int>(height);
+  return true;
+}
+
+bool PngProgressiveDecoder::decode(GrowableStream* stream, void* pixels, size_t rowBytes) {
+  if (!readHeader(stream) || complete || failed) {
+    return !failed;
+  }
+  if (state->p == nullptr) {
+    state->p = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    if (state->p == nullptr) {
+      failed = true;
+      return false;
+    }
+    state->pi = png_create_info_struct(state->p);
+    if (state->pi == nullptr) {
+      failed = true;
+      return false;
+    }
+#ifdef PNG_SET_OPTION_SUPPORTED
+    png_set_option(state->p, PNG_MAXIMUM_INFLATE_WINDOW, PNG_OPTION_ON);
+#endif
+    png_set_progressive_read_fn(state->p, state.get(), PngInfoCallback, PngRowCallback,
+                                PngEndCallback);
+  }
+  state->pixels = static_cast<uint8_t*>(pixels);
+  state->rowBytes = rowBytes;
+  std::vector<uint8_t> buffer = {};
+  if (setjmp(png_jmpbuf(state->p))) {
+    failed = true;
+    return false;
+  }
+  while (!state->complete) {
+    auto length = std::min(stream->size() - stream->position(), PNG_READ_CHUNK_SIZE);
+    if (length == 0) {
+      break;
+    }
+    buffer.resize(length);
+    length = stream->read(buffer.data(), length);
+    png_process_data(state->p, state->pi, buffer.data(), length);
+  }
+  complete = state->complete;
+  return true;
+}
+}  // namespace tgfx
@@ -0,0 +1,43 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/ProgressiveDecoder.h"
+
+namespace tgfx {
+struct PngProgressiveState;
+
+/**
+ * PngProgressiveDecoder decodes a PNG image as its bytes arrive, using the progressive reader of
+ * libpng. Interlaced images show each Adam7 pass as blocks that the later passes refine.
+ */
+class PngProgressiveDecoder : public ProgressiveDecoder {
+ public:
+  PngProgressiveDecoder();
+
+  ~PngProgressiveDecoder() override;
+
+  bool readHeader(GrowableStream* stream) override;
+
+  bool decode(GrowableStream* stream, void* pixels, size_t rowBytes) override;
+
+ private:
+  std::unique_ptr<PngProgressiveState> state;
+};
+}  // namespace tgfx
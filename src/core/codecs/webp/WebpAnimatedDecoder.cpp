@@ -0,0 +1,81 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "WebpAnimatedDecoder.h"
+#include "core/codecs/webp/WebpCodec.h"
+
+namespace tgfx {
+std::unique_ptr<AnimatedDecoder> WebpAnimatedDecoder::Make(std::shared_ptr<Data> imageBytes) {
+  if (imageBytes == nullptr || !WebpCodec::IsWebp(imageBytes)) {
+    return nullptr;
+  }
+  WebPData webpData = {imageBytes->bytes(), imageBytes->size()};
+  auto demux = WebPDemux(&webpData);
+  if (demux == nullptr) {
+    return nullptr;
+  }
+  if (!(WebPDemuxGetI(demux, WEBP_FF_FORMAT_FLAGS) & ANIMATION_FLAG)) {
+    WebPDemuxDelete(demux);
+    return nullptr;
+  }
+  auto decoder =
+      std::unique_ptr<WebpAnimatedDecoder>(new WebpAnimatedDecoder(std::move(imageBytes)));
+  decoder->_width = static_cast<int>(WebPDemuxGetI(demux, WEBP_FF_CANVAS_WIDTH));
+  decoder->_height = static_cast<int>(WebPDemuxGetI(demux, WEBP_FF_CANVAS_HEIGHT));
+  decoder->_loopCount = static_cast<int>(WebPDemuxGetI(demux, WEBP_FF_LOOP_COUNT));
+  WebPIterator iterator = {};
+  if (WebPDemuxGetFrame(demux, 1, &iterator)) {
+    do {
+      AnimatedFrameInfo info = {};
+      info.bounds = Rect::MakeXYWH(iterator.x_offset, iterator.y_offset, iterator.width,
+                                   iterator.height);
+      info.duration = static_cast<int64_t>(iterator.duration) * 1000;
+      info.blend = iterator.blend_method == WEBP_MUX_BLEND ? FrameBlend::Over : FrameBlend::Source;
+      info.disposal = iterator.dispose_method == WEBP_MUX_DISPOSE_BACKGROUND
+                          ? FrameDisposal::Background
+                          : FrameDisposal::Keep;
+      decoder->_frameInfos.push_back(info);
+      // The fragments point into the file data, which outlives the demuxer.
+      decoder->fragments.push_back(iterator.fragment);
+    } while (WebPDemuxNextFrame(&iterator));
+    WebPDemuxReleaseIterator(&iterator);
+  }
+  WebPDemuxDelete(demux);
+  return decoder;
+}
+
+bool WebpAnimatedDecoder::decodeFrame(int index, void* pixels, size_t rowBytes) {
+  if (index < 0 || index >= static_cast<int>(fragments.size()) || pixels == nullptr) {
+    return false;
+  }
+  auto& fragment = fragments[static_cast<size_t>(index)];
+  auto height = static_cast<size_t>(_frameInfos[static_cast<size_t>(index)].bounds.height());
+  WebPDecoderConfig config;
+  if (!WebPInitDecoderConfig(&config)) {
+    return false;
+  }
+  config.output.is_external_memory = 1;
+  config.output.colorspace = MODE_rgbA;
+  config.output.u.RGBA.rgba = static_cast<uint8_t*>(pixels);
+  config.output.u.RGBA.stride = static_cast<int>(rowBytes);
+  config.output.u.RGBA.size = rowBytes * height;
+  auto result = WebPDecode(fragment.bytes, fragment.size, &config);
+  WebPFreeDecBuffer(&config.output);
+  return result == VP8_STATUS_OK;
+}
+}  // namespace tgfx
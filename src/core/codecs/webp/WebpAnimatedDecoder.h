@@ -0,0 +1,42 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/AnimatedDecoder.h"
+#include "webp/demux.h"
+
+namespace tgfx {
+/**
+ * WebpAnimatedDecoder decodes the frames of an animated WebP image using the libwebp demuxer.
+ */
+class WebpAnimatedDecoder : public AnimatedDecoder {
+ public:
+  static std::unique_ptr<AnimatedDecoder> Make(std::shared_ptr<Data> imageBytes);
+
+  bool decodeFrame(int index, void* pixels, size_t rowBytes) override;
+
+ private:
+  std::shared_ptr<Data> fileData = nullptr;
+  // The encoded bitstream of each frame, pointing into fileData.
+  std::vector<WebPData> fragments = {};
+
+  explicit WebpAnimatedDecoder(std::shared_ptr<Data> fileData) : fileData(std::move(fileData)) {
+  }
+};
+}  // namespace tgfx
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "core/codecs/webp/WebpCodec.h"
+#include <algorithm>
 #include "core/codecs/webp/WebpUtility.h"
 #include "core/utils/ColorSpaceHelper.h"
 #include "tgfx/core/Buffer.h"
@@ -123,6 +124,67 @@ bool WebpCodec::onReadPixels(ColorType colorType, AlphaType alphaType, size_t ds
   return decodeSuccess;
 }
 
+// Extra pixels kept around a cropped region so that the fancy upsampling of lossy images produces
+// the same pixels at the region edges as a full decode does.
+static constexpr int WEBP_CROP_MARGIN = 2;
+
+bool WebpCodec::onReadRegion(const Rect& srcRect, ColorType colorType, AlphaType alphaType,
+                             size_t dstRowBytes, std::shared_ptr<ColorSpace> dstColorSpace,
+                             void* dstPixels) const {
+  if (dstPixels == nullptr) {
+    return false;
+  }
+  auto byteData = fileData;
+  if (byteData == nullptr) {
+    byteData = Data::MakeFromFile(filePath);
+  }
+  if (byteData == nullptr) {
+    return false;
+  }
+  WebPDecoderConfig config;
+  if (!WebPInitDecoderConfig(&config)) {
+    return false;
+  }
+  if (WebPGetFeatures(byteData->bytes(), byteData->size(), &config.input) != VP8_STATUS_OK) {
+    return false;
+  }
+  // libwebp aligns the crop origin to even coordinates for YUV sources, so the crop is aligned up
+  // front and the region is copied out of the decoded crop afterwards.
+  auto left = static_cast<int>(srcRect.left);
+  auto top = static_cast<int>(srcRect.top);
+  auto cropLeft = std::max(left - WEBP_CROP_MARGIN, 0) & ~1;
+  auto cropTop = std::max(top - WEBP_CROP_MARGIN, 0) & ~1;
+  auto cropRight = std::min(static_cast<int>(srcRect.right) + WEBP_CROP_MARGIN, width());
+  auto cropBottom = std::min(static_cast<int>(srcRect.bottom) + WEBP_CROP_MARGIN, height());
+  config.options.use_cropping = 1;
+  config.options.crop_left = cropLeft;
+  config.options.crop_top = cropTop;
+  config.options.crop_width = cropRight - cropLeft;
+  config.options.crop_height = cropBottom - cropTop;
+  auto cropInfo = ImageInfo::Make(config.options.crop_width, config.options.crop_height,
+                                  ColorType::RGBA_8888, alphaType, 0, colorSpace());
+  Buffer buffer(cropInfo.byteSize());
+  if (buffer.isEmpty()) {
+    return false;
+  }
+  config.output.is_external_memory = 1;
+  config.output.colorspace = webp_decode_mode(ColorType::RGBA_8888,
+                                              cropInfo.alphaType() == AlphaType::Premultiplied);
+  config.output.u.RGBA.rgba = buffer.bytes();
+  config.output.u.RGBA.stride = static_cast<int>(cropInfo.rowBytes());
+  config.output.u.RGBA.size = cropInfo.byteSize();
+  auto decodeSuccess = WebPDecode(byteData->bytes(), byteData->size(), &config) == VP8_STATUS_OK;
+  WebPFreeDecBuffer(&config.output);
+  if (!decodeSuccess) {
+    return false;
+  }
+  auto dstInfo = ImageInfo::Make(static_cast<int>(srcRect.width()),
+                                 static_cast<int>(srcRect.height()), colorType, alphaType,
+                                 dstRowBytes, std::move(dstColorSpace));
+  return Pixmap(cropInfo, buffer.bytes())
+      .readPixels(dstInfo, dstPixels, left - cropLeft, top - cropTop);
+}
+
 std::shared_ptr<Data> WebpCodec::getEncodedData() const {
   if (fileData) {
     return fileData;
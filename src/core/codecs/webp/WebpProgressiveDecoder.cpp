@@ -0,0 +1,112 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "WebpProgressiveDecoder.h"
+#include <algorithm>
+#include <vector>
+#include "webp/decode.h"
+
+namespace tgfx {
+// The received bytes are handed to libwebp in chunks of at most this size.
+static constexpr size_t WEBP_READ_CHUNK_SIZE = 64 * 1024;
+
+struct WebpProgressiveState {
+  WebPDecBuffer output = {};
+  WebPIDecoder* decoder = nullptr;
+};
+
+WebpProgressiveDecoder::WebpProgressiveDecoder()
+    : state(std::make_unique<WebpProgressiveState>()) {
+  // Decode premultiplied pixels the same way WebpCodec does, which also keeps the premultiplied
+  // rounding of libwebp.
+  _alphaType = AlphaType::Premultiplied;
+  WebPInitDecBuffer(&state->output);
+}
+
+WebpProgressiveDecoder::~WebpProgressiveDecoder() {
+  if (state->decoder) {
+    WebPIDelete(state->decoder);
+  }
+  WebPFreeDecBuffer(&state->output);
+}
+
+bool WebpProgressiveDecoder::readHeader(GrowableStream* stream) {
+  if (_width > 0) {
+    return true;
+  }
+  if (failed) {
+    return false;
+  }
+  // The header is only peeked at, decode() hands the whole stream to libwebp from the start.
+  std::vector<uint8_t> header(stream->size() - stream->position());
+  header.resize(stream->peek(header.data(), header.size()));
+  WebPBitstreamFeatures features = {};
+  auto status = WebPGetFeatures(header.data(), header.size(), &features);
+  if (status == VP8_STATUS_NOT_ENOUGH_DATA) {
+    failed = stream->isFinished();
+    return false;
+  }
+  if (status != VP8_STATUS_OK || features.has_animation) {
+    failed = true;
+    return false;
+  }
+  _width = features.width;
+  _height = features.height;
+  return true;
+}
+
+bool WebpProgressiveDecoder::decode(GrowableStream* stream, void* pixels, size_t rowBytes) {
+  if (!readHeader(stream) || complete || failed) {
+    return !failed;
+  }
+  if (state->decoder == nullptr) {
+    // libwebp writes the decoded rows straight into the pixels, which stay at the same address
+    // for every call.
+    auto& output = state->output;
+    output.colorspace = MODE_rgbA;
+    output.is_external_memory = 1;
+    output.u.RGBA.rgba = static_cast<uint8_t*>(pixels);
+    output.u.RGBA.stride = static_cast<int>(rowBytes);
+    output.u.RGBA.size = rowBytes * static_cast<size_t>(_height);
+    state->decoder = WebPINewDecoder(&output);
+    if (state->decoder == nullptr) {
+      failed = true;
+      return false;
+    }
+  }
+  std::vector<uint8_t> buffer = {};
+  while (true) {
+    auto length = std::min(stream->size() - stream->position(), WEBP_READ_CHUNK_SIZE);
+    if (length == 0) {
+      break;
+    }
+    buffer.resize(length);
+    length = stream->read(buffer.data(), length);
+    auto status = WebPIAppend(state->decoder, buffer.data(), length);
+    if (status == VP8_STATUS_OK) {
+      complete = true;
+      break;
+    }
+    if (status != VP8_STATUS_SUSPENDED) {
+      failed = true;
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace tgfx
@@ -52,5 +52,7 @@ class ShaderMaskFilter : public MaskFilter {
  private:
   std::shared_ptr<Shader> shader;
   bool inverted;
+
+  friend class PictureWriter;
 };
 }  // namespace tgfx
@@ -0,0 +1,109 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "AnimatedImage.h"
+#include "gpu/DrawingManager.h"
+#include "gpu/ProxyProvider.h"
+#include "gpu/TPArgs.h"
+#include "gpu/tasks/AnimatedFrameUploadTask.h"
+
+namespace tgfx {
+class AnimatedFrameGenerator : public ImageGenerator {
+ public:
+  AnimatedFrameGenerator(std::shared_ptr<AnimatedCodec> codec, int frameIndex)
+      : ImageGenerator(codec->width(), codec->height()), codec(std::move(codec)),
+        frameIndex(frameIndex) {
+  }
+
+  bool isAlphaOnly() const override {
+    return false;
+  }
+
+ protected:
+  std::shared_ptr<ImageBuffer> onMakeBuffer(bool tryHardware) const override {
+    return codec->makeFrameBuffer(frameIndex, tryHardware);
+  }
+
+ private:
+  std::shared_ptr<AnimatedCodec> codec = nullptr;
+  int frameIndex = 0;
+};
+
+std::shared_ptr<Image> AnimatedImage::MakeFrom(std::shared_ptr<AnimatedCodec> codec,
+                                               int frameIndex) {
+  if (codec == nullptr || frameIndex < 0 || frameIndex >= codec->frameCount()) {
+    return nullptr;
+  }
+  auto image =
+      std::shared_ptr<AnimatedImage>(new AnimatedImage(std::move(codec), frameIndex, false));
+  image->weakThis = image;
+  return image;
+}
+
+AnimatedImage::AnimatedImage(std::shared_ptr<AnimatedCodec> source, int frameIndex,
+                             bool mipmapped)
+    : GeneratorImage(std::make_shared<AnimatedFrameGenerator>(source, frameIndex), mipmapped),
+      codec(std::move(source)), frameIndex(frameIndex) {
+}
+
+std::shared_ptr<TextureProxy> AnimatedImage::lockTextureProxy(const TPArgs& args) const {
+  // Each context keeps its own shared texture, so the pending draws of one context never see the
+  // uploads of another.
+  auto state = codec->getTextureState(args.context->uniqueID(), args.mipmapped);
+  std::lock_guard<std::mutex> autoLock(state->locker);
+  if (auto pendingProxy = state->pendingProxy.lock()) {
+    if (state->pendingFrame == frameIndex) {
+      return pendingProxy;
+    }
+    // The draws recorded since the last flush already show another frame from the shared
+    // texture, so this frame gets a texture of its own until the next flush.
+    return GeneratorImage::lockTextureProxy(args);
+  }
+  auto proxyProvider = args.context->proxyProvider();
+  auto textureProxy = proxyProvider->findOrWrapTextureProxy(state->uniqueKey);
+  if (textureProxy == nullptr || state->residentFrame != frameIndex ||
+      textureProxy->getTextureView() != state->texture.lock()) {
+    auto pixels = codec->getFrame(frameIndex);
+    if (pixels == nullptr) {
+      return nullptr;
+    }
+    if (textureProxy == nullptr) {
+      textureProxy = proxyProvider->createTextureProxy(
+          state->uniqueKey, codec->width(), codec->height(), PixelFormat::RGBA_8888,
+          args.mipmapped, ImageOrigin::TopLeft, BackingFit::Exact, args.renderFlags);
+      if (textureProxy == nullptr) {
+        return nullptr;
+      }
+    }
+    auto drawingManager = args.context->drawingManager();
+    auto task = args.context->drawingAllocator()->make<AnimatedFrameUploadTask>(
+        textureProxy, state, codec, frameIndex, std::move(pixels));
+    drawingManager->addResourceTask(std::move(task));
+    drawingManager->addGenerateMipmapsTask(textureProxy);
+  }
+  state->pendingProxy = textureProxy;
+  state->pendingFrame = frameIndex;
+  return textureProxy;
+}
+
+std::shared_ptr<Image> AnimatedImage::onMakeMipmapped(bool enabled) const {
+  auto image = std::shared_ptr<AnimatedImage>(new AnimatedImage(codec, frameIndex, enabled));
+  image->weakThis = image;
+  return image;
+}
+}  // namespace tgfx
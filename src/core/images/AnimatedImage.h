@@ -0,0 +1,47 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/images/GeneratorImage.h"
+#include "tgfx/core/AnimatedCodec.h"
+
+namespace tgfx {
+/**
+ * AnimatedImage shows one frame of an AnimatedCodec. All frame images of a codec draw from the
+ * same texture, which is updated in place with the area that changed since the frame it held.
+ */
+class AnimatedImage : public GeneratorImage {
+ public:
+  /**
+   * Creates an AnimatedImage for the frame at the specified index of the codec.
+   */
+  static std::shared_ptr<Image> MakeFrom(std::shared_ptr<AnimatedCodec> codec, int frameIndex);
+
+ protected:
+  std::shared_ptr<TextureProxy> lockTextureProxy(const TPArgs& args) const override;
+
+  std::shared_ptr<Image> onMakeMipmapped(bool enabled) const override;
+
+ private:
+  std::shared_ptr<AnimatedCodec> codec = nullptr;
+  int frameIndex = 0;
+
+  AnimatedImage(std::shared_ptr<AnimatedCodec> codec, int frameIndex, bool mipmapped);
+};
+}  // namespace tgfx
@@ -18,12 +18,21 @@
 
 #include "CodecImage.h"
 #include "RasterizedImage.h"
+#include "core/RegionImageCodec.h"
 #include "core/ScaledImageGenerator.h"
 #include "core/utils/NextCacheScaleLevel.h"
 #include "gpu/ProxyProvider.h"
 #include "gpu/TPArgs.h"
+#include "gpu/processors/FragmentProcessor.h"
+#include "gpu/processors/TiledTextureEffect.h"
+#include "tgfx/core/RenderFlags.h"
 
 namespace tgfx {
+// Codecs with fewer pixels than this are always decoded in full: the decode is cheap, and the one
+// texture serves every draw of the image.
+static constexpr int64_t MIN_REGION_DECODE_PIXELS = 2048 * 2048;
+static constexpr float REGION_GRID_SIZE = 256.0f;
+
 CodecImage::CodecImage(std::shared_ptr<ImageCodec> codec, int width, int height, bool mipmapped)
     : GeneratorImage(std::move(codec), mipmapped), _width(width), _height(height) {
 }
@@ -64,4 +73,98 @@ std::shared_ptr<TextureProxy> CodecImage::lockTextureProxy(const TPArgs& args) c
   return args.context->proxyProvider()->createTextureProxy(tempGenerator, args.mipmapped,
                                                            args.renderFlags);
 }
+
+PlacementPtr<FragmentProcessor> CodecImage::asFragmentProcessor(const FPArgs& args,
+                                                                const SamplingArgs& samplingArgs,
+                                                                const Matrix* uvMatrix) const {
+  if (auto processor = asRegionFragmentProcessor(args, samplingArgs, uvMatrix, {})) {
+    return processor;
+  }
+  return PixelImage::asFragmentProcessor(args, samplingArgs, uvMatrix);
+}
+
+PlacementPtr<FragmentProcessor> CodecImage::asRegionFragmentProcessor(
+    const FPArgs& args, const SamplingArgs& samplingArgs, const Matrix* uvMatrix,
+    const UniqueKey& textureKey) const {
+  auto region = getDecodeRegion(args, samplingArgs, uvMatrix);
+  if (!region.has_value()) {
+    return nullptr;
+  }
+  auto proxyProvider = args.context->proxyProvider();
+  UniqueKey regionKey = {};
+  std::shared_ptr<TextureProxy> textureProxy = nullptr;
+  if (!textureKey.empty()) {
+    BytesKey bytesKey = {};
+    bytesKey.write(region->left);
+    bytesKey.write(region->top);
+    bytesKey.write(region->right);
+    bytesKey.write(region->bottom);
+    regionKey = UniqueKey::Append(textureKey, bytesKey.data(), bytesKey.size());
+    textureProxy = proxyProvider->findOrWrapTextureProxy(regionKey);
+  }
+  if (textureProxy == nullptr) {
+    auto regionCodec = RegionImageCodec::MakeFrom(getCodec(), *region);
+    if (regionCodec == nullptr) {
+      return nullptr;
+    }
+    textureProxy = proxyProvider->createTextureProxy(std::move(regionCodec), false,
+                                                     args.renderFlags);
+    if (textureProxy == nullptr) {
+      return nullptr;
+    }
+    if (!regionKey.empty()) {
+      proxyProvider->assignProxyUniqueKey(textureProxy, regionKey);
+      if (!(args.renderFlags & RenderFlags::DisableCache)) {
+        textureProxy->assignUniqueKey(regionKey);
+      }
+    }
+  }
+  auto regionMatrix = Matrix::MakeTrans(-region->left, -region->top);
+  if (uvMatrix) {
+    regionMatrix.preConcat(*uvMatrix);
+  }
+  auto regionSamplingArgs = samplingArgs;
+  if (regionSamplingArgs.sampleArea.has_value()) {
+    regionSamplingArgs.sampleArea->offset(-region->left, -region->top);
+  }
+  auto allocator = args.context->drawingAllocator();
+  return TiledTextureEffect::Make(allocator, std::move(textureProxy), regionSamplingArgs,
+                                  &regionMatrix, isAlphaOnly());
+}
+
+std::optional<Rect> CodecImage::getDecodeRegion(const FPArgs& args,
+                                                const SamplingArgs& samplingArgs,
+                                                const Matrix* uvMatrix) const {
+  auto codec = getCodec();
+  if (_width != codec->width() || _height != codec->height() || args.drawRect.isEmpty() ||
+      static_cast<int64_t>(_width) * _height < MIN_REGION_DECODE_PIXELS) {
+    return std::nullopt;
+  }
+  // Repeated tiles and mipmap levels sample outside of the drawn area.
+  if (samplingArgs.tileModeX != TileMode::Clamp || samplingArgs.tileModeY != TileMode::Clamp ||
+      (mipmapped && samplingArgs.sampling.mipmapMode != MipmapMode::None)) {
+    return std::nullopt;
+  }
+  auto region = uvMatrix ? uvMatrix->mapRect(args.drawRect) : args.drawRect;
+  // Keep a margin of source pixels around the drawn area so that filtering at its edges reads the
+  // same neighbors as it would from the full image, including after downscaling by drawScale.
+  auto textureScale = std::min(std::max(args.drawScale, 0.01f), 1.0f);
+  auto margin = std::ceil(2.0f / textureScale);
+  region.outset(margin, margin);
+  // Snap the region to a coarse grid so that nearby draws and small scrolls share the same cached
+  // region texture instead of decoding a new one each frame.
+  region.setLTRB(std::floor(region.left / REGION_GRID_SIZE) * REGION_GRID_SIZE,
+                 std::floor(region.top / REGION_GRID_SIZE) * REGION_GRID_SIZE,
+                 std::ceil(region.right / REGION_GRID_SIZE) * REGION_GRID_SIZE,
+                 std::ceil(region.bottom / REGION_GRID_SIZE) * REGION_GRID_SIZE);
+  if (!region.intersect(Rect::MakeWH(_width, _height))) {
+    return std::nullopt;
+  }
+  // Decoding most of the image as a region saves little and loses the shared full texture.
+  auto regionPixels = static_cast<int64_t>(region.width()) * static_cast<int64_t>(region.height());
+  if (regionPixels * 2 > static_cast<int64_t>(_width) * _height) {
+    return std::nullopt;
+  }
+  return region;
+}
 }  // namespace tgfx
@@ -19,9 +19,11 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include "core/images/BufferImage.h"
 #include "core/images/GeneratorImage.h"
 #include "core/utils/NextCacheScaleLevel.h"
+#include "gpu/resources/ResourceKey.h"
 #include "tgfx/core/Image.h"
 #include "tgfx/core/ImageCodec.h"
 
@@ -33,6 +35,17 @@ class CodecImage : public GeneratorImage {
 
   std::shared_ptr<ImageCodec> getCodec() const;
 
+  /**
+   * Returns a FragmentProcessor that samples a texture decoded from only the part of the codec
+   * visible to the draw, or nullptr if the image is too small or the draw needs the whole image.
+   * If textureKey is not empty, the region texture is cached under textureKey plus the region
+   * bounds, and later draws of the same region reuse it instead of decoding it again.
+   */
+  PlacementPtr<FragmentProcessor> asRegionFragmentProcessor(const FPArgs& args,
+                                                            const SamplingArgs& samplingArgs,
+                                                            const Matrix* uvMatrix,
+                                                            const UniqueKey& textureKey) const;
+
   int width() const override {
     return _width;
   }
@@ -55,10 +68,21 @@ class CodecImage : public GeneratorImage {
 
   std::shared_ptr<TextureProxy> lockTextureProxy(const TPArgs& args) const override;
 
+  PlacementPtr<FragmentProcessor> asFragmentProcessor(const FPArgs& args,
+                                                      const SamplingArgs& samplingArgs,
+                                                      const Matrix* uvMatrix) const override;
+
  private:
   int _width;
   int _height;
 
+  /**
+   * Returns the region of the image worth decoding on its own for the draw described by args, or
+   * std::nullopt if the whole image should be decoded.
+   */
+  std::optional<Rect> getDecodeRegion(const FPArgs& args, const SamplingArgs& samplingArgs,
+                                      const Matrix* uvMatrix) const;
+
   friend class BufferImage;
 };
 
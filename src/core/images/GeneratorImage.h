@@ -60,5 +60,7 @@ class GeneratorImage : public PixelImage {
   std::shared_ptr<Image> onMakeMipmapped(bool mipmapped) const override;
 
   std::shared_ptr<ImageGenerator> generator = nullptr;
+
+  friend class RasterImageCache;
 };
 }  // namespace tgfx
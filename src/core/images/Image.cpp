@@ -18,6 +18,8 @@
 
 #include "tgfx/core/Image.h"
 #include <memory>
+#include "core/CompressedBuffer.h"
+#include "core/YUVCodecGenerator.h"
 #include "core/images/CodecImage.h"
 #include "core/images/FilterImage.h"
 #include "core/images/OrientImage.h"
@@ -26,13 +28,18 @@
 #include "core/images/ScaledImage.h"
 #include "core/images/SubsetImage.h"
 #include "core/images/TextureImage.h"
+#include "core/utils/BlockCompression.h"
 #include "core/utils/WeakMap.h"
 #include "gpu/DrawingManager.h"
 #include "gpu/ProxyProvider.h"
 #include "gpu/RenderContext.h"
 #include "gpu/TPArgs.h"
+#include "tgfx/core/Buffer.h"
+#include "tgfx/core/Canvas.h"
 #include "tgfx/core/ImageCodec.h"
 #include "tgfx/core/Pixmap.h"
+#include "tgfx/core/Surface.h"
+#include "tgfx/gpu/GPU.h"
 
 namespace tgfx {
 std::shared_ptr<Image> Image::MakeFromFile(const std::string& filePath) {
@@ -101,6 +108,18 @@ std::shared_ptr<Image> Image::MakeFrom(HardwareBufferRef hardwareBuffer,
   return MakeFrom(std::move(buffer));
 }
 
+std::shared_ptr<Image> Image::MakeYUVFrom(std::shared_ptr<ImageCodec> codec) {
+  if (codec == nullptr) {
+    return nullptr;
+  }
+  auto orientation = codec->orientation();
+  auto image = MakeFrom(YUVCodecGenerator::MakeFrom(std::move(codec)));
+  if (image == nullptr) {
+    return nullptr;
+  }
+  return image->makeOriented(orientation);
+}
+
 std::shared_ptr<Image> Image::MakeI420(std::shared_ptr<YUVData> yuvData, YUVColorSpace colorSpace) {
   auto buffer = ImageBuffer::MakeI420(std::move(yuvData), colorSpace);
   return MakeFrom(std::move(buffer));
@@ -142,6 +161,46 @@ std::shared_ptr<Image> Image::makeTextureImage(Context* context) const {
   return TextureImage::Wrap(std::move(textureProxy), colorSpace());
 }
 
+std::shared_ptr<Image> Image::makeCompressedTextureImage(Context* context) const {
+  if (context == nullptr) {
+    return nullptr;
+  }
+  auto features = context->gpu()->features();
+  auto format = PixelFormat::Unknown;
+  if (features->textureCompressionETC2) {
+    format = PixelFormat::ETC2_RGB8;
+  } else if (features->textureCompressionBC) {
+    format = PixelFormat::BC1_RGB;
+  }
+  if (format == PixelFormat::Unknown || isAlphaOnly() || isTextureBacked() || hasMipmaps()) {
+    return makeTextureImage(context);
+  }
+  auto surface = Surface::Make(context, width(), height(), false, 1, false, 0, colorSpace());
+  if (surface == nullptr) {
+    return makeTextureImage(context);
+  }
+  surface->getCanvas()->drawImage(weakThis.lock());
+  auto info = ImageInfo::Make(width(), height(), ColorType::RGBA_8888, AlphaType::Premultiplied, 0,
+                              colorSpace());
+  Buffer pixels(info.byteSize());
+  if (pixels.isEmpty() || !surface->readPixels(info, pixels.data())) {
+    return makeTextureImage(context);
+  }
+  // The encoders drop the alpha channel, so images with any transparent pixel stay uncompressed.
+  for (size_t i = 3; i < pixels.size(); i += 4) {
+    if (pixels.bytes()[i] != 255) {
+      return makeTextureImage(context);
+    }
+  }
+  auto blocks = EncodeCompressedBlocks(format, pixels.data(), width(), height(), info.rowBytes());
+  auto buffer = CompressedBuffer::Make(width(), height(), format, std::move(blocks), colorSpace());
+  if (buffer == nullptr) {
+    return makeTextureImage(context);
+  }
+  auto textureProxy = context->proxyProvider()->createTextureProxy(std::move(buffer));
+  return TextureImage::Wrap(std::move(textureProxy), colorSpace());
+}
+
 BackendTexture Image::getBackendTexture(Context*, ImageOrigin*) const {
   return {};
 }
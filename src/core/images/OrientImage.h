@@ -55,5 +55,8 @@ class OrientImage : public TransformImage {
   Orientation concatOrientation(Orientation newOrientation) const;
 
   std::optional<Matrix> concatUVMatrix(const Matrix* uvMatrix) const override;
+
+  friend class PictureWriter;
+  friend class RasterImageCache;
 };
 }  // namespace tgfx
@@ -164,6 +164,7 @@ bool PictureImage::drawPicture(std::shared_ptr<RenderTargetProxy> renderTarget,
   if (renderTarget == nullptr) {
     return false;
   }
+  auto renderBounds = Rect::MakeWH(renderTarget->width(), renderTarget->height());
   RenderContext renderContext(std::move(renderTarget), renderFlags, true, nullptr, _colorSpace);
   Matrix totalMatrix = {};
   if (extraMatrix) {
@@ -172,7 +173,7 @@ bool PictureImage::drawPicture(std::shared_ptr<RenderTargetProxy> renderTarget,
   if (matrix) {
     totalMatrix.preConcat(*matrix);
   }
-  picture->playback(&renderContext, totalMatrix, ClipStack());
+  picture->playback(&renderContext, totalMatrix, ClipStack(), nullptr, &renderBounds);
   renderContext.flush();
   return true;
 }
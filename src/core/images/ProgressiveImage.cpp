@@ -0,0 +1,93 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ProgressiveImage.h"
+#include "gpu/ProxyProvider.h"
+#include "gpu/TPArgs.h"
+#include "tgfx/core/RenderFlags.h"
+
+namespace tgfx {
+class ProgressiveGenerator : public ImageGenerator {
+ public:
+  explicit ProgressiveGenerator(std::shared_ptr<ProgressiveCodec> codec)
+      : ImageGenerator(codec->width(), codec->height()), codec(std::move(codec)) {
+  }
+
+  bool isAlphaOnly() const override {
+    return false;
+  }
+
+ protected:
+  std::shared_ptr<ImageBuffer> onMakeBuffer(bool tryHardware) const override {
+    return codec->makeBuffer(tryHardware);
+  }
+
+ private:
+  std::shared_ptr<ProgressiveCodec> codec = nullptr;
+};
+
+std::shared_ptr<Image> ProgressiveImage::MakeFrom(std::shared_ptr<ProgressiveCodec> codec) {
+  if (codec == nullptr || codec->width() <= 0 || codec->height() <= 0) {
+    return nullptr;
+  }
+  auto image = std::shared_ptr<ProgressiveImage>(
+      new ProgressiveImage(std::move(codec), UniqueKey::Make(), false));
+  image->weakThis = image;
+  return image;
+}
+
+ProgressiveImage::ProgressiveImage(std::shared_ptr<ProgressiveCodec> source, UniqueKey key,
+                                   bool mipmapped)
+    : GeneratorImage(std::make_shared<ProgressiveGenerator>(source), mipmapped),
+      codec(std::move(source)), uniqueKey(std::move(key)) {
+}
+
+std::shared_ptr<Image> ProgressiveImage::onMakeDecoded(Context*, bool) const {
+  // A decoded copy would stop showing the data that arrives later.
+  return nullptr;
+}
+
+std::shared_ptr<TextureProxy> ProgressiveImage::lockTextureProxy(const TPArgs& args) const {
+  // Read the state before decoding, so that bytes arriving during the decoding give the next draw
+  // a new key instead of being hidden behind this one.
+  auto bytesReceived = static_cast<uint64_t>(codec->bytesReceived());
+  uint32_t keyData[3] = {static_cast<uint32_t>(bytesReceived),
+                         static_cast<uint32_t>(bytesReceived >> 32), codec->isFinished() ? 1u : 0u};
+  auto textureKey = UniqueKey::Append(uniqueKey, keyData, 3);
+  auto proxyProvider = args.context->proxyProvider();
+  if (auto textureProxy = proxyProvider->findOrWrapTextureProxy(textureKey)) {
+    return textureProxy;
+  }
+  auto textureProxy = GeneratorImage::lockTextureProxy(args);
+  if (textureProxy == nullptr) {
+    return nullptr;
+  }
+  proxyProvider->assignProxyUniqueKey(textureProxy, textureKey);
+  if (!(args.renderFlags & RenderFlags::DisableCache)) {
+    textureProxy->assignUniqueKey(textureKey);
+  }
+  return textureProxy;
+}
+
+std::shared_ptr<Image> ProgressiveImage::onMakeMipmapped(bool enabled) const {
+  auto image =
+      std::shared_ptr<ProgressiveImage>(new ProgressiveImage(codec, UniqueKey::Make(), enabled));
+  image->weakThis = image;
+  return image;
+}
+}  // namespace tgfx
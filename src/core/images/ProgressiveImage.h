@@ -0,0 +1,51 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "core/images/GeneratorImage.h"
+#include "gpu/resources/ResourceKey.h"
+#include "tgfx/core/ProgressiveCodec.h"
+
+namespace tgfx {
+/**
+ * ProgressiveImage shows the pixels a ProgressiveCodec has decoded so far. Its texture is cached
+ * per amount of received data, so a new texture is only decoded and uploaded after more bytes
+ * arrive.
+ */
+class ProgressiveImage : public GeneratorImage {
+ public:
+  /**
+   * Creates a ProgressiveImage for the codec, which must have received the image header.
+   */
+  static std::shared_ptr<Image> MakeFrom(std::shared_ptr<ProgressiveCodec> codec);
+
+ protected:
+  std::shared_ptr<Image> onMakeDecoded(Context* context, bool tryHardware) const override;
+
+  std::shared_ptr<TextureProxy> lockTextureProxy(const TPArgs& args) const override;
+
+  std::shared_ptr<Image> onMakeMipmapped(bool enabled) const override;
+
+ private:
+  std::shared_ptr<ProgressiveCodec> codec = nullptr;
+  UniqueKey uniqueKey = {};
+
+  ProgressiveImage(std::shared_ptr<ProgressiveCodec> codec, UniqueKey uniqueKey, bool mipmapped);
+};
+}  // namespace tgfx
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "RasterizedImage.h"
+#include "core/images/CodecImage.h"
 #include "gpu/DrawingManager.h"
 #include "gpu/ProxyProvider.h"
 #include "gpu/TPArgs.h"
@@ -64,6 +65,20 @@ std::shared_ptr<TextureProxy> RasterizedImage::lockTextureProxy(const TPArgs& ar
 
 PlacementPtr<FragmentProcessor> RasterizedImage::asFragmentProcessor(
     const FPArgs& args, const SamplingArgs& samplingArgs, const Matrix* uvMatrix) const {
+  if (source->type() == Type::Codec && !source->hasMipmaps() &&
+      source->getRasterizedScale(args.drawScale) >= 1.0f) {
+    // Huge codecs drawn at full resolution decode only the visible region, unless a texture of the
+    // whole image is already cached. Region textures are cached under the full texture key.
+    auto proxyProvider = args.context->proxyProvider();
+    auto textureKey = getTextureKey();
+    if (proxyProvider->findOrWrapTextureProxy(textureKey) == nullptr) {
+      auto codecImage = std::static_pointer_cast<CodecImage>(source);
+      if (auto processor =
+              codecImage->asRegionFragmentProcessor(args, samplingArgs, uvMatrix, textureKey)) {
+        return processor;
+      }
+    }
+  }
   auto textureProxy = lockTextureProxy(
       TPArgs(args.context, args.renderFlags, hasMipmaps(), args.drawScale, BackingFit::Exact));
   if (textureProxy == nullptr) {
@@ -80,5 +80,7 @@ class RasterizedImage : public Image {
   UniqueKey uniqueKey;
 
   std::shared_ptr<Image> source = nullptr;
+
+  friend class RasterImageCache;
 };
 }  // namespace tgfx
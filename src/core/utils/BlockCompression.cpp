@@ -0,0 +1,688 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "BlockCompression.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "core/utils/PixelFormatUtil.h"
+#include "tgfx/core/Buffer.h"
+
+namespace tgfx {
+static constexpr int BLOCK_SIZE = 4;
+static constexpr int BLOCK_PIXELS = BLOCK_SIZE * BLOCK_SIZE;
+
+// The intensity modifiers of ETC1 and ETC2, indexed by the table codeword and the pixel index.
+static constexpr int ETC_MODIFIERS[8][4] = {{2, 8, -2, -8},       {5, 17, -5, -17},
+                                            {9, 29, -9, -29},     {13, 42, -13, -42},
+                                            {18, 60, -18, -60},   {24, 80, -24, -80},
+                                            {33, 106, -33, -106}, {47, 183, -47, -183}};
+
+// The distances between the paint colors of the ETC2 T and H modes.
+static constexpr int ETC_DISTANCES[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+// The alpha modifiers of EAC, indexed by the table index and the pixel index.
+static constexpr int EAC_MODIFIERS[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12}, {-2, -5, -8, -13, 1, 4, 7, 12},
+    {-2, -4, -6, -13, 1, 3, 5, 12}, {-3, -6, -8, -12, 2, 5, 7, 11},  {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},  {-2, -6, -8, -10, 1, 5, 7, 9},
+    {-2, -5, -8, -10, 1, 4, 7, 9},  {-2, -4, -8, -10, 1, 3, 7, 9},   {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},  {-1, -2, -3, -10, 0, 1, 2, 9},   {-4, -6, -8, -9, 3, 5, 7, 8},
+    {-3, -5, -7, -9, 2, 4, 6, 8}};
+
+static uint8_t ClampByte(int value) {
+  return static_cast<uint8_t>(std::clamp(value, 0, 255));
+}
+
+static int Extend4(int value) {
+  return value << 4 | value;
+}
+
+static int Extend5(int value) {
+  return value << 3 | value >> 2;
+}
+
+static int Extend6(int value) {
+  return value << 2 | value >> 4;
+}
+
+static int Extend7(int value) {
+  return value << 1 | value >> 6;
+}
+
+static uint32_t ReadBigEndian32(const uint8_t* bytes) {
+  return static_cast<uint32_t>(bytes[0]) << 24 | static_cast<uint32_t>(bytes[1]) << 16 |
+         static_cast<uint32_t>(bytes[2]) << 8 | static_cast<uint32_t>(bytes[3]);
+}
+
+static uint32_t ReadLittleEndian32(const uint8_t* bytes) {
+  return static_cast<uint32_t>(bytes[3]) << 24 | static_cast<uint32_t>(bytes[2]) << 16 |
+         static_cast<uint32_t>(bytes[1]) << 8 | static_cast<uint32_t>(bytes[0]);
+}
+
+static void WritePixel(uint8_t* rgba, int index, int red, int green, int blue) {
+  auto pixel = rgba + index * 4;
+  pixel[0] = ClampByte(red);
+  pixel[1] = ClampByte(green);
+  pixel[2] = ClampByte(blue);
+  pixel[3] = 255;
+}
+
+// ETC pixel indices are stored column by column, with the most significant bits in the upper half.
+static int ETCPixelIndex(uint32_t indices, int x, int y) {
+  auto bit = x * BLOCK_SIZE + y;
+  auto msb = static_cast<int>((indices >> (bit + 16)) & 1);
+  return msb << 1 | static_cast<int>((indices >> bit) & 1);
+}
+
+static void DecodeETC2PaintBlock(uint32_t indices, const int paints[4][3], uint8_t* rgba) {
+  for (int y = 0; y < BLOCK_SIZE; y++) {
+    for (int x = 0; x < BLOCK_SIZE; x++) {
+      auto& paint = paints[ETCPixelIndex(indices, x, y)];
+      WritePixel(rgba, y * BLOCK_SIZE + x, paint[0], paint[1], paint[2]);
+    }
+  }
+}
+
+static void DecodeETC2TMode(const uint8_t* block, uint32_t indices, uint8_t* rgba) {
+  int red1 = Extend4((block[0] >> 3 & 3) << 2 | (block[0] & 3));
+  int green1 = Extend4(block[1] >> 4);
+  int blue1 = Extend4(block[1] & 0xF);
+  int red2 = Extend4(block[2] >> 4);
+  int green2 = Extend4(block[2] & 0xF);
+  int blue2 = Extend4(block[3] >> 4);
+  int distance = ETC_DISTANCES[(block[3] >> 2 & 3) << 1 | (block[3] & 1)];
+  const int paints[4][3] = {{red1, green1, blue1},
+                            {red2 + distance, green2 + distance, blue2 + distance},
+                            {red2, green2, blue2},
+                            {red2 - distance, green2 - distance, blue2 - distance}};
+  DecodeETC2PaintBlock(indices, paints, rgba);
+}
+
+static void DecodeETC2HMode(const uint8_t* block, uint32_t indices, uint8_t* rgba) {
+  int red1 = block[0] >> 3 & 0xF;
+  int green1 = (block[0] & 7) << 1 | (block[1] >> 4 & 1);
+  int blue1 = (block[1] & 8) | (block[1] & 3) << 1 | block[2] >> 7;
+  int red2 = block[2] >> 3 & 0xF;
+  int green2 = (block[2] & 7) << 1 | block[3] >> 7;
+  int blue2 = block[3] >> 3 & 0xF;
+  int order = (red1 << 8 | green1 << 4 | blue1) >= (red2 << 8 | green2 << 4 | blue2) ? 1 : 0;
+  int distance = ETC_DISTANCES[(block[3] & 4) | (block[3] & 1) << 1 | order];
+  red1 = Extend4(red1);
+  green1 = Extend4(green1);
+  blue1 = Extend4(blue1);
+  red2 = Extend4(red2);
+  green2 = Extend4(green2);
+  blue2 = Extend4(blue2);
+  const int paints[4][3] = {{red1 + distance, green1 + distance, blue1 + distance},
+                            {red1 - distance, green1 - distance, blue1 - distance},
+                            {red2 + distance, green2 + distance, blue2 + distance},
+                            {red2 - distance, green2 - distance, blue2 - distance}};
+  DecodeETC2PaintBlock(indices, paints, rgba);
+}
+
+static void DecodeETC2PlanarMode(const uint8_t* block, uint8_t* rgba) {
+  int origin[3] = {Extend6(block[0] >> 1 & 0x3F),
+                   Extend7((block[0] & 1) << 6 | (block[1] >> 1 & 0x3F)),
+                   Extend6((block[1] & 1) << 5 | (block[2] & 0x18) | (block[2] & 3) << 1 |
+                           block[3] >> 7)};
+  int horizontal[3] = {Extend6((block[3] >> 2 & 0x1F) << 1 | (block[3] & 1)),
+                       Extend7(block[4] >> 1), Extend6((block[4] & 1) << 5 | block[5] >> 3)};
+  int vertical[3] = {Extend6((block[5] & 7) << 3 | block[6] >> 5),
+                     Extend7((block[6] & 0x1F) << 2 | block[7] >> 6), Extend6(block[7] & 0x3F)};
+  for (int y = 0; y < BLOCK_SIZE; y++) {
+    for (int x = 0; x < BLOCK_SIZE; x++) {
+      int color[3] = {};
+      for (int c = 0; c < 3; c++) {
+        color[c] = (x * (horizontal[c] - origin[c]) + y * (vertical[c] - origin[c]) +
+                    4 * origin[c] + 2) >>
+                   2;
+      }
+      WritePixel(rgba, y * BLOCK_SIZE + x, color[0], color[1], color[2]);
+    }
+  }
+}
+
+static void DecodeETC2ColorBlock(const uint8_t* block, uint8_t* rgba) {
+  auto indices = ReadBigEndian32(block + 4);
+  int bases[2][3] = {};
+  if (block[3] & 2) {
+    // The differential mode, whose overflowing second colors select the ETC2 modes instead.
+    int deltas[3] = {};
+    for (int c = 0; c < 3; c++) {
+      bases[0][c] = block[c] >> 3;
+      deltas[c] = ((block[c] & 7) ^ 4) - 4;
+      bases[1][c] = bases[0][c] + deltas[c];
+    }
+    if (bases[1][0] < 0 || bases[1][0] > 31) {
+      DecodeETC2TMode(block, indices, rgba);
+      return;
+    }
+    if (bases[1][1] < 0 || bases[1][1] > 31) {
+      DecodeETC2HMode(block, indices, rgba);
+      return;
+    }
+    if (bases[1][2] < 0 || bases[1][2] > 31) {
+      DecodeETC2PlanarMode(block, rgba);
+      return;
+    }
+    for (int c = 0; c < 3; c++) {
+      bases[0][c] = Extend5(bases[0][c]);
+      bases[1][c] = Extend5(bases[1][c]);
+    }
+  } else {
+    for (int c = 0; c < 3; c++) {
+      bases[0][c] = Extend4(block[c] >> 4);
+      bases[1][c] = Extend4(block[c] & 0xF);
+    }
+  }
+  bool flip = block[3] & 1;
+  const int* tables[2] = {ETC_MODIFIERS[block[3] >> 5 & 7], ETC_MODIFIERS[block[3] >> 2 & 7]};
+  for (int y = 0; y < BLOCK_SIZE; y++) {
+    for (int x = 0; x < BLOCK_SIZE; x++) {
+      auto subblock = (flip ? y : x) >= 2 ? 1 : 0;
+      auto modifier = tables[subblock][ETCPixelIndex(indices, x, y)];
+      auto& base = bases[subblock];
+      WritePixel(rgba, y * BLOCK_SIZE + x, base[0] + modifier, base[1] + modifier,
+                 base[2] + modifier);
+    }
+  }
+}
+
+static void DecodeEACAlphaBlock(const uint8_t* block, uint8_t* rgba) {
+  int base = block[0];
+  int multiplier = block[1] >> 4;
+  auto table = EAC_MODIFIERS[block[1] & 0xF];
+  uint64_t bits = 0;
+  for (int i = 2; i < 8; i++) {
+    bits = bits << 8 | block[i];
+  }
+  for (int y = 0; y < BLOCK_SIZE; y++) {
+    for (int x = 0; x < BLOCK_SIZE; x++) {
+      auto shift = 45 - 3 * (x * BLOCK_SIZE + y);
+      auto index = static_cast<int>(bits >> shift & 7);
+      rgba[(y * BLOCK_SIZE + x) * 4 + 3] = ClampByte(base + table[index] * multiplier);
+    }
+  }
+}
+
+static void Expand565(uint16_t color, int* rgb) {
+  rgb[0] = Extend5(color >> 11);
+  rgb[1] = Extend6(color >> 5 & 0x3F);
+  rgb[2] = Extend5(color & 0x1F);
+}
+
+static void MakeBC1Palette(uint16_t color0, uint16_t color1, bool fourColors, int palette[4][3]) {
+  Expand565(color0, palette[0]);
+  Expand565(color1, palette[1]);
+  for (int c = 0; c < 3; c++) {
+    if (fourColors) {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    } else {
+      palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+      palette[3][c] = 0;
+    }
+  }
+}
+
+static void DecodeBC1ColorBlock(const uint8_t* block, uint8_t* rgba, bool alwaysFourColors) {
+  auto color0 = static_cast<uint16_t>(block[0] | block[1] << 8);
+  auto color1 = static_cast<uint16_t>(block[2] | block[3] << 8);
+  int palette[4][3] = {};
+  MakeBC1Palette(color0, color1, alwaysFourColors || color0 > color1, palette);
+  auto indices = ReadLittleEndian32(block + 4);
+  for (int i = 0; i < BLOCK_PIXELS; i++) {
+    auto& color = palette[indices >> (2 * i) & 3];
+    WritePixel(rgba, i, color[0], color[1], color[2]);
+  }
+}
+
+static void DecodeBC3AlphaBlock(const uint8_t* block, uint8_t* rgba) {
+  int palette[8] = {block[0], block[1]};
+  if (palette[0] > palette[1]) {
+    for (int i = 1; i <= 6; i++) {
+      palette[i + 1] = ((7 - i) * palette[0] + i * palette[1] + 3) / 7;
+    }
+  } else {
+    for (int i = 1; i <= 4; i++) {
+      palette[i + 1] = ((5 - i) * palette[0] + i * palette[1] + 2) / 5;
+    }
+    palette[6] = 0;
+    palette[7] = 255;
+  }
+  uint64_t bits = 0;
+  for (int i = 7; i >= 2; i--) {
+    bits = bits << 8 | block[i];
+  }
+  for (int i = 0; i < BLOCK_PIXELS; i++) {
+    rgba[i * 4 + 3] = static_cast<uint8_t>(palette[bits >> (3 * i) & 7]);
+  }
+}
+
+bool DecodeCompressedBlocks(PixelFormat format, const void* blocks, int width, int height,
+                            void* dstPixels, size_t dstRowBytes) {
+  auto blockBytes = CompressedBlockBytes(format);
+  if (blocks == nullptr || dstPixels == nullptr || width <= 0 || height <= 0 || blockBytes == 0 ||
+      format == PixelFormat::ASTC_4x4) {
+    return false;
+  }
+  auto src = static_cast<const uint8_t*>(blocks);
+  auto dst = static_cast<uint8_t*>(dstPixels);
+  uint8_t rgba[BLOCK_PIXELS * 4] = {};
+  for (int blockY = 0; blockY < height; blockY += BLOCK_SIZE) {
+    for (int blockX = 0; blockX < width; blockX += BLOCK_SIZE) {
+      switch (format) {
+        case PixelFormat::ETC2_RGB8:
+          DecodeETC2ColorBlock(src, rgba);
+          break;
+        case PixelFormat::ETC2_RGBA8:
+          DecodeETC2ColorBlock(src + 8, rgba);
+          DecodeEACAlphaBlock(src, rgba);
+          break;
+        case PixelFormat::BC1_RGB:
+          DecodeBC1ColorBlock(src, rgba, false);
+          break;
+        case PixelFormat::BC3_RGBA:
+          DecodeBC1ColorBlock(src + 8, rgba, true);
+          DecodeBC3AlphaBlock(src, rgba);
+          break;
+        default:
+          return false;
+      }
+      src += blockBytes;
+      auto rows = std::min(BLOCK_SIZE, height - blockY);
+      auto copyBytes = static_cast<size_t>(std::min(BLOCK_SIZE, width - blockX)) * 4;
+      for (int y = 0; y < rows; y++) {
+        auto dstRow = dst + static_cast<size_t>(blockY + y) * dstRowBytes +
+                      static_cast<size_t>(blockX) * 4;
+        memcpy(dstRow, rgba + y * BLOCK_SIZE * 4, copyBytes);
+      }
+    }
+  }
+  return true;
+}
+
+static int ColorDistance(const uint8_t* pixel, int red, int green, int blue) {
+  int dr = pixel[0] - red;
+  int dg = pixel[1] - green;
+  int db = pixel[2] - blue;
+  return dr * dr + dg * dg + db * db;
+}
+
+static uint16_t To565(const float* rgb) {
+  auto red = static_cast<int>(std::lround(std::clamp(rgb[0], 0.0f, 255.0f) * 31.0f / 255.0f));
+  auto green = static_cast<int>(std::lround(std::clamp(rgb[1], 0.0f, 255.0f) * 63.0f / 255.0f));
+  auto blue = static_cast<int>(std::lround(std::clamp(rgb[2], 0.0f, 255.0f) * 31.0f / 255.0f));
+  return static_cast<uint16_t>(red << 11 | green << 5 | blue);
+}
+
+// Fits the endpoints of a BC1 block along the principal axis of its colors.
+static void EncodeBC1Block(const uint8_t* rgba, uint8_t* block) {
+  float mean[3] = {};
+  for (int i = 0; i < BLOCK_PIXELS; i++) {
+    for (int c = 0; c < 3; c++) {
+      mean[c] += static_cast<float>(rgba[i * 4 + c]);
+    }
+  }
+  for (auto& value : mean) {
+    value /= static_cast<float>(BLOCK_PIXELS);
+  }
+  float covariance[6] = {};
+  for (int i = 0; i < BLOCK_PIXELS; i++) {
+    float d[3] = {};
+    for (int c = 0; c < 3; c++) {
+      d[c] = static_cast<float>(rgba[i * 4 + c]) - mean[c];
+    }
+    covariance[0] += d[0] * d[0];
+    covariance[1] += d[0] * d[1];
+    covariance[2] += d[0] * d[2];
+    covariance[3] += d[1] * d[1];
+    covariance[4] += d[1] * d[2];
+    covariance[5] += d[2] * d[2];
+  }
+  // A few power iterations are enough to find the dominant axis of 16 colors.
+  float axis[3] = {1.0f, 1.0f, 1.0f};
+  for (int iteration = 0; iteration < 4; iteration++) {
+    float next[3] = {covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+                     covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+                     covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2]};
+    auto length = std::max({std::fabs(next[0]), std::fabs(next[1]), std::fabs(next[2])});
+    if (length <= 0.0f) {
+      break;
+    }
+    for (int c = 0; c < 3; c++) {
+      axis[c] = next[c] / length;
+    }
+  }
+  float minProjection = 0.0f;
+  float maxProjection = 0.0f;
+  for (int i = 0; i < BLOCK_PIXELS; i++) {
+    float projection = 0.0f;
+    for (int c = 0; c < 3; c++) {
+      projection += (static_cast<float>(rgba[i * 4 + c]) - mean[c]) * axis[c];
+    }
+    minProjection = std::min(minProjection, projection);
+    maxProjection = std::max(maxProjection, projection);
+  }
+  auto lengthSquared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+  float maxColor[3] = {};
+  float minColor[3] = {};
+  for (int c = 0; c < 3; c++) {
+    maxColor[c] = mean[c] + axis[c] * maxProjection / lengthSquared;
+    minColor[c] = mean[c] + axis[c] * minProjection / lengthSquared;
+  }
+  auto color0 = To565(maxColor);
+  auto color1 = To565(minColor);
+  if (color0 < color1) {
+    std::swap(color0, color1);
+  }
+  uint32_t indices = 0;
+  if (color0 != color1) {
+    int palette[4][3] = {};
+    MakeBC1Palette(color0, color1, true, palette);
+    for (int i = 0; i < BLOCK_PIXELS; i++) {
+      uint32_t bestIndex = 0;
+      auto bestDistance = ColorDistance(rgba + i * 4, palette[0][0], palette[0][1], palette[0][2]);
+      for (uint32_t index = 1; index < 4; index++) {
+        auto& color = palette[index];
+        auto distance = ColorDistance(rgba + i * 4, color[0], color[1], color[2]);
+        if (distance < bestDistance) {
+          bestDistance = distance;
+          bestIndex = index;
+        }
+      }
+      indices |= bestIndex << (2 * i);
+    }
+  }
+  block[0] = static_cast<uint8_t>(color0 & 0xFF);
+  block[1] = static_cast<uint8_t>(color0 >> 8);
+  block[2] = static_cast<uint8_t>(color1 & 0xFF);
+  block[3] = static_cast<uint8_t>(color1 >> 8);
+  for (int i = 0; i < 4; i++) {
+    block[4 + i] = static_cast<uint8_t>(indices >> (8 * i));
+  }
+}
+
+struct ETCSubblockFit {
+  int table = 0;
+  int error = 0;
+  // The pixel indices in the layout of the block, which can be OR-ed together for both subblocks.
+  uint32_t indices = 0;
+};
+
+static ETCSubblockFit FitETCSubblock(const uint8_t* rgba, bool flip, int subblock,
+                                     const int* base) {
+  ETCSubblockFit best = {};
+  best.error = -1;
+  for (int table = 0; table < 8; table++) {
+    ETCSubblockFit fit = {};
+    fit.table = table;
+    for (int y = 0; y < BLOCK_SIZE; y++) {
+      for (int x = 0; x < BLOCK_SIZE; x++) {
+        if (((flip ? y : x) >= 2 ? 1 : 0) != subblock) {
+          continue;
+        }
+        auto pixel = rgba + (y * BLOCK_SIZE + x) * 4;
+        int bestIndex = 0;
+        int bestDistance = -1;
+        for (int index = 0; index < 4; index++) {
+          auto modifier = ETC_MODIFIERS[table][index];
+          auto distance = ColorDistance(pixel, ClampByte(base[0] + modifier),
+                                        ClampByte(base[1] + modifier),
+                                        ClampByte(base[2] + modifier));
+          if (bestDistance < 0 || distance < bestDistance) {
+            bestDistance = distance;
+            bestIndex = index;
+          }
+        }
+        fit.error += bestDistance;
+        auto bit = x * BLOCK_SIZE + y;
+        fit.indices |= static_cast<uint32_t>(bestIndex >> 1) << (bit + 16) |
+                       static_cast<uint32_t>(bestIndex & 1) << bit;
+      }
+    }
+    if (best.error < 0 || fit.error < best.error) {
+      best = fit;
+    }
+  }
+  return best;
+}
+
+static int PackedColor4(const int* color) {
+  return color[0] << 8 | color[1] << 4 | color[2];
+}
+
+// Splits the pixels of a block into two clusters and returns their average colors.
+static void FindTwoColors(const uint8_t* rgba, float colors[2][3]) {
+  float low[3] = {255.0f, 255.0f, 255.0f};
+  float high[3] = {};
+  for (int i = 0; i < BLOCK_PIXELS; i++) {
+    for (int c = 0; c < 3; c++) {
+      low[c] = std::min(low[c], static_cast<float>(rgba[i * 4 + c]));
+      high[c] = std::max(high[c], static_cast<float>(rgba[i * 4 + c]));
+    }
+  }
+  memcpy(colors[0], low, sizeof(low));
+  memcpy(colors[1], high, sizeof(high));
+  for (int iteration = 0; iteration < 4; iteration++) {
+    float sums[2][3] = {};
+    int counts[2] = {};
+    for (int i = 0; i < BLOCK_PIXELS; i++) {
+      float distances[2] = {};
+      for (int k = 0; k < 2; k++) {
+        for (int c = 0; c < 3; c++) {
+          auto d = static_cast<float>(rgba[i * 4 + c]) - colors[k][c];
+          distances[k] += d * d;
+        }
+      }
+      auto k = distances[1] < distances[0] ? 1 : 0;
+      counts[k]++;
+      for (int c = 0; c < 3; c++) {
+        sums[k][c] += static_cast<float>(rgba[i * 4 + c]);
+      }
+    }
+    for (int k = 0; k < 2; k++) {
+      if (counts[k] > 0) {
+        for (int c = 0; c < 3; c++) {
+          colors[k][c] = sums[k][c] / static_cast<float>(counts[k]);
+        }
+      }
+    }
+  }
+}
+
+// Tries the H mode of ETC2, which paints a block with two base colors shifted by a distance. It
+// suits blocks split by a sharp edge between two hues, which the ETC1 modes can not represent.
+// Returns the error of the encoded block, or -1 if the colors of the block are too close.
+static int EncodeETC2HModeBlock(const uint8_t* rgba, uint8_t* block) {
+  float averages[2][3] = {};
+  FindTwoColors(rgba, averages);
+  int colors[2][3] = {};
+  for (int k = 0; k < 2; k++) {
+    for (int c = 0; c < 3; c++) {
+      colors[k][c] = static_cast<int>(std::lround(averages[k][c] * 15.0f / 255.0f));
+    }
+  }
+  if (PackedColor4(colors[0]) == PackedColor4(colors[1])) {
+    return -1;
+  }
+  int bestError = -1;
+  int bestDistance = 0;
+  uint32_t bestIndices = 0;
+  int bestColors[2][3] = {};
+  for (int distanceIndex = 0; distanceIndex < 8; distanceIndex++) {
+    // The lowest bit of the distance index is implied by the order of the two base colors.
+    auto order = PackedColor4(colors[0]) >= PackedColor4(colors[1]) ? 1 : 0;
+    if (order != (distanceIndex & 1)) {
+      std::swap(colors[0], colors[1]);
+    }
+    auto distance = ETC_DISTANCES[distanceIndex];
+    int paints[4][3] = {};
+    for (int c = 0; c < 3; c++) {
+      paints[0][c] = ClampByte(Extend4(colors[0][c]) + distance);
+      paints[1][c] = ClampByte(Extend4(colors[0][c]) - distance);
+      paints[2][c] = ClampByte(Extend4(colors[1][c]) + distance);
+      paints[3][c] = ClampByte(Extend4(colors[1][c]) - distance);
+    }
+    int error = 0;
+    uint32_t indices = 0;
+    for (int y = 0; y < BLOCK_SIZE; y++) {
+      for (int x = 0; x < BLOCK_SIZE; x++) {
+        auto pixel = rgba + (y * BLOCK_SIZE + x) * 4;
+        int bestIndex = 0;
+        auto bestPixelError = ColorDistance(pixel, paints[0][0], paints[0][1], paints[0][2]);
+        for (int index = 1; index < 4; index++) {
+          auto pixelError = ColorDistance(pixel, paints[index][0], paints[index][1],
+                                          paints[index][2]);
+          if (pixelError < bestPixelError) {
+            bestPixelError = pixelError;
+            bestIndex = index;
+          }
+        }
+        error += bestPixelError;
+        auto bit = x * BLOCK_SIZE + y;
+        indices |= static_cast<uint32_t>(bestIndex >> 1) << (bit + 16) |
+                   static_cast<uint32_t>(bestIndex & 1) << bit;
+      }
+    }
+    if (bestError < 0 || error < bestError) {
+      bestError = error;
+      bestDistance = distanceIndex;
+      bestIndices = indices;
+      memcpy(bestColors, colors, sizeof(colors));
+    }
+  }
+  auto& first = bestColors[0];
+  auto& second = bestColors[1];
+  // The unused bits are chosen so that the red channel of the differential mode stays in range
+  // while the green channel overflows, which is how decoders recognize the H mode.
+  auto redDelta = ((first[1] >> 1) ^ 4) - 4;
+  auto redHigh = first[0] < 4 && redDelta < 0 ? 1 : 0;
+  auto greenBase = (first[1] & 1) << 1 | (first[2] >> 3 & 1);
+  auto greenDelta = first[2] >> 1 & 3;
+  auto greenHigh = greenBase + greenDelta >= 4;
+  block[0] = static_cast<uint8_t>(redHigh << 7 | first[0] << 3 | first[1] >> 1);
+  block[1] = static_cast<uint8_t>((greenHigh ? 0xE0 : 0x04) | (first[1] & 1) << 4 |
+                                  (first[2] >> 3 & 1) << 3 | (first[2] >> 1 & 3));
+  block[2] = static_cast<uint8_t>((first[2] & 1) << 7 | second[0] << 3 | second[1] >> 1);
+  block[3] = static_cast<uint8_t>((second[1] & 1) << 7 | second[2] << 3 | (bestDistance & 4) |
+                                  2 | (bestDistance >> 1 & 1));
+  for (int i = 0; i < 4; i++) {
+    block[4 + i] = static_cast<uint8_t>(bestIndices >> (24 - 8 * i));
+  }
+  return bestError;
+}
+
+// Encodes a block in the individual or differential mode of ETC1, or the H mode of ETC2, whichever
+// has the lowest error.
+static void EncodeETC2Block(const uint8_t* rgba, uint8_t* block) {
+  int bestError = -1;
+  for (int flip = 0; flip < 2; flip++) {
+    float averages[2][3] = {};
+    for (int y = 0; y < BLOCK_SIZE; y++) {
+      for (int x = 0; x < BLOCK_SIZE; x++) {
+        auto subblock = (flip ? y : x) >= 2 ? 1 : 0;
+        for (int c = 0; c < 3; c++) {
+          averages[subblock][c] += static_cast<float>(rgba[(y * BLOCK_SIZE + x) * 4 + c]) / 8.0f;
+        }
+      }
+    }
+    int quantized[2][3] = {};
+    bool differential = true;
+    for (int c = 0; c < 3; c++) {
+      quantized[0][c] = static_cast<int>(std::lround(averages[0][c] * 31.0f / 255.0f));
+      quantized[1][c] = static_cast<int>(std::lround(averages[1][c] * 31.0f / 255.0f));
+      auto delta = quantized[1][c] - quantized[0][c];
+      differential = differential && delta >= -4 && delta <= 3;
+    }
+    int bases[2][3] = {};
+    for (int s = 0; s < 2; s++) {
+      for (int c = 0; c < 3; c++) {
+        if (differential) {
+          bases[s][c] = Extend5(quantized[s][c]);
+        } else {
+          quantized[s][c] = static_cast<int>(std::lround(averages[s][c] * 15.0f / 255.0f));
+          bases[s][c] = Extend4(quantized[s][c]);
+        }
+      }
+    }
+    auto first = FitETCSubblock(rgba, flip, 0, bases[0]);
+    auto second = FitETCSubblock(rgba, flip, 1, bases[1]);
+    auto error = first.error + second.error;
+    if (bestError >= 0 && error >= bestError) {
+      continue;
+    }
+    bestError = error;
+    for (int c = 0; c < 3; c++) {
+      if (differential) {
+        auto delta = quantized[1][c] - quantized[0][c];
+        block[c] = static_cast<uint8_t>(quantized[0][c] << 3 | (delta & 7));
+      } else {
+        block[c] = static_cast<uint8_t>(quantized[0][c] << 4 | quantized[1][c]);
+      }
+    }
+    block[3] = static_cast<uint8_t>(first.table << 5 | second.table << 2 |
+                                    (differential ? 2 : 0) | flip);
+    auto indices = first.indices | second.indices;
+    for (int i = 0; i < 4; i++) {
+      block[4 + i] = static_cast<uint8_t>(indices >> (24 - 8 * i));
+    }
+  }
+  uint8_t hModeBlock[8] = {};
+  auto hModeError = EncodeETC2HModeBlock(rgba, hModeBlock);
+  if (hModeError >= 0 && hModeError < bestError) {
+    memcpy(block, hModeBlock, sizeof(hModeBlock));
+  }
+}
+
+std::shared_ptr<Data> EncodeCompressedBlocks(PixelFormat format, const void* pixels, int width,
+                                             int height, size_t rowBytes) {
+  if (pixels == nullptr || width <= 0 || height <= 0 ||
+      (format != PixelFormat::ETC2_RGB8 && format != PixelFormat::BC1_RGB)) {
+    return nullptr;
+  }
+  auto blockBytes = CompressedBlockBytes(format);
+  Buffer buffer(PixelFormatDataSize(format, width, height));
+  if (buffer.isEmpty()) {
+    return nullptr;
+  }
+  auto src = static_cast<const uint8_t*>(pixels);
+  auto dst = buffer.bytes();
+  uint8_t rgba[BLOCK_PIXELS * 4] = {};
+  for (int blockY = 0; blockY < height; blockY += BLOCK_SIZE) {
+    for (int blockX = 0; blockX < width; blockX += BLOCK_SIZE) {
+      // Pixels outside the image repeat the edges, so they do not pull the colors of the block.
+      for (int y = 0; y < BLOCK_SIZE; y++) {
+        auto srcY = static_cast<size_t>(std::min(blockY + y, height - 1));
+        for (int x = 0; x < BLOCK_SIZE; x++) {
+          auto srcX = static_cast<size_t>(std::min(blockX + x, width - 1));
+          memcpy(rgba + (y * BLOCK_SIZE + x) * 4, src + srcY * rowBytes + srcX * 4, 4);
+        }
+      }
+      if (format == PixelFormat::ETC2_RGB8) {
+        EncodeETC2Block(rgba, dst);
+      } else {
+        EncodeBC1Block(rgba, dst);
+      }
+      dst += blockBytes;
+    }
+  }
+  return buffer.release();
+}
+}  // namespace tgfx
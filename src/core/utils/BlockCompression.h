@@ -0,0 +1,41 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include "tgfx/core/Data.h"
+#include "tgfx/gpu/PixelFormat.h"
+
+namespace tgfx {
+/**
+ * Decodes the 4x4 blocks of a compressed format into RGBA_8888 pixels, keeping the channel values
+ * exactly as stored in the blocks. The blocks are tightly packed in rows. Supports the ETC2 and BC
+ * formats. Returns false if the format can not be decoded on the CPU, such as ASTC_4x4.
+ */
+bool DecodeCompressedBlocks(PixelFormat format, const void* blocks, int width, int height,
+                            void* dstPixels, size_t dstRowBytes);
+
+/**
+ * Encodes RGBA_8888 pixels into the 4x4 blocks of ETC2_RGB8 or BC1_RGB, ignoring the alpha
+ * channel. Both formats take 8 bytes per block, or half a byte per pixel. Returns nullptr if the
+ * format is not supported by the encoder.
+ */
+std::shared_ptr<Data> EncodeCompressedBlocks(PixelFormat format, const void* pixels, int width,
+                                             int height, size_t rowBytes);
+}  // namespace tgfx
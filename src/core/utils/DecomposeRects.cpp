@@ -17,73 +17,209 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "DecomposeRects.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
 #include "core/utils/Log.h"
 
 namespace tgfx {
-static void DecomposeRect(Rect* rectA, Rect* rectB) {
-  // Ensure rectA and rectB overlap
-  DEBUG_ASSERT(Rect::Intersects(*rectA, *rectB));
+// The extra area allowed when merging two rectangles, relative to the sum of their areas. Each
+// level is tried in turn while there are still too many rectangles.
+static constexpr float MergeTolerances[] = {0.0f, 0.5f, 1.0f};
 
-  // Step 1: Build the 3 rect slabs on the y-axis
-  Rect rects[3];
-  if (rectA->top < rectB->top) {
-    rects[0].top = rectA->top;
-    rects[0].bottom = rectB->top;
-    rects[0].left = rectA->left;
-    rects[0].right = rectA->right;
-  } else {
-    rects[0].top = rectB->top;
-    rects[0].bottom = rectA->top;
-    rects[0].left = rectB->left;
-    rects[0].right = rectB->right;
+static bool LeftLess(const Rect& a, const Rect& b) {
+  return a.left < b.left;
+}
+
+// Merges each rectangle with the ones that start before it ends horizontally (plus the allowed
+// gap) if the bounding box adds at most tolerance times their areas. Stops merging once minCount
+// rectangles are left. Returns true if any pair was merged.
+static bool MergeSweep(std::vector<Rect>* rects, float tolerance, size_t minCount) {
+  auto& list = *rects;
+  std::sort(list.begin(), list.end(), LeftLess);
+  auto count = list.size();
+  auto remaining = count;
+  std::vector<bool> removed(count, false);
+  bool merged = false;
+  for (size_t i = 0; i < count && remaining > minCount; i++) {
+    if (removed[i]) {
+      continue;
+    }
+    auto& rect = list[i];
+    for (size_t j = i + 1; j < count && remaining > minCount; j++) {
+      // The rectangles are sorted by their left edges, so the merged one keeps the left of rect.
+      auto gap = tolerance * std::max(rect.width(), rect.height());
+      if (list[j].left > rect.right + gap) {
+        break;
+      }
+      if (removed[j]) {
+        continue;
+      }
+      auto& other = list[j];
+      if (other.top > rect.bottom + gap || other.bottom < rect.top - gap) {
+        continue;
+      }
+      auto unionRect = rect;
+      unionRect.join(other);
+      if (unionRect.area() <= (rect.area() + other.area()) * (1.0f + tolerance)) {
+        rect = unionRect;
+        removed[j] = true;
+        remaining--;
+        merged = true;
+      }
+    }
   }
-  if (rectA->bottom < rectB->bottom) {
-    rects[2].top = rectA->bottom;
-    rects[2].bottom = rectB->bottom;
-    rects[2].left = rectB->left;
-    rects[2].right = rectB->right;
-  } else {
-    rects[2].top = rectB->bottom;
-    rects[2].bottom = rectA->bottom;
-    rects[2].left = rectA->left;
-    rects[2].right = rectA->right;
+  if (merged) {
+    size_t index = 0;
+    for (size_t i = 0; i < count; i++) {
+      if (!removed[i]) {
+        list[index++] = list[i];
+      }
+    }
+    list.resize(index);
   }
-  rects[1].top = rects[0].bottom;
-  rects[1].bottom = rects[2].top;
-  rects[1].left = std::min(rectA->left, rectB->left);
-  rects[1].right = std::max(rectA->right, rectB->right);
+  return merged;
+}
 
-  // Step 2: Compute areas
-  float areas[3];
-  for (int i = 0; i < 3; ++i) {
-    areas[i] = rects[i].area();
+// Joins the rectangles whose centers fall into the same cell of a grid with at most maxCount cells.
+static void MergeByGrid(std::vector<Rect>* rects, size_t maxCount) {
+  auto bounds = Rect::MakeEmpty();
+  for (auto& rect : *rects) {
+    bounds.join(rect);
+  }
+  auto columns = std::max(static_cast<size_t>(std::sqrt(static_cast<double>(maxCount))),
+                          static_cast<size_t>(1));
+  auto rows = std::max(maxCount / columns, static_cast<size_t>(1));
+  auto cellWidth = bounds.width() / static_cast<float>(columns);
+  auto cellHeight = bounds.height() / static_cast<float>(rows);
+  std::map<size_t, Rect> cells = {};
+  for (auto& rect : *rects) {
+    auto column = cellWidth > 0 ? static_cast<size_t>((rect.centerX() - bounds.left) / cellWidth)
+                                : 0;
+    auto row = cellHeight > 0 ? static_cast<size_t>((rect.centerY() - bounds.top) / cellHeight)
+                              : 0;
+    auto key = std::min(row, rows - 1) * columns + std::min(column, columns - 1);
+    auto result = cells.find(key);
+    if (result == cells.end()) {
+      cells.emplace(key, rect);
+    } else {
+      result->second.join(rect);
+    }
+  }
+  rects->clear();
+  for (auto& item : cells) {
+    rects->push_back(item.second);
   }
+}
 
-  // Step 3: Union slabs and compute area deltas
-  Rect u1 = rects[0];
-  u1.join(rects[1]);
-  Rect u2 = rects[1];
-  u2.join(rects[2]);
-  float delta0 = areas[0] + areas[1] - u1.area();
-  float delta1 = areas[1] + areas[2] - u2.area();
+void MergeRects(std::vector<Rect>* rects, size_t maxCount) {
+  DEBUG_ASSERT(maxCount > 0);
+  rects->erase(std::remove_if(rects->begin(), rects->end(),
+                              [](const Rect& rect) { return rect.isEmpty(); }),
+               rects->end());
+  for (auto tolerance : MergeTolerances) {
+    // Merging without extra area is always worth it, the others only until maxCount is reached.
+    auto minCount = tolerance > 0 ? maxCount : 1;
+    while (rects->size() > minCount && MergeSweep(rects, tolerance, minCount)) {
+    }
+    if (rects->size() <= maxCount) {
+      return;
+    }
+  }
+  MergeByGrid(rects, maxCount);
+  while (rects->size() > 1 && MergeSweep(rects, 0.0f, 1)) {
+  }
+}
 
-  // Step 4: Choose the best decomposition
-  if (delta0 > delta1) {
-    *rectA = u1;
-    *rectB = rects[2];
-  } else {
-    *rectA = rects[0];
-    *rectB = u2;
+static size_t FindRoot(std::vector<size_t>& parents, size_t index) {
+  while (parents[index] != index) {
+    parents[index] = parents[parents[index]];
+    index = parents[index];
   }
+  return index;
 }
 
-void DecomposeRects(Rect* rects, size_t count) {
+// Cuts a group of overlapping rectangles into horizontal bands, merges the covered intervals of
+// each band, and extends the rectangles of the previous band when the intervals line up.
+static void DecomposeGroup(const std::vector<Rect>& group, std::vector<Rect>* result) {
+  std::vector<float> edges = {};
+  edges.reserve(group.size() * 2);
+  for (auto& rect : group) {
+    edges.push_back(rect.top);
+    edges.push_back(rect.bottom);
+  }
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+  // Maps the left and right of each rectangle that ends at the top of the current band to its
+  // index in the result.
+  std::map<std::pair<float, float>, size_t> openRects = {};
+  std::vector<std::pair<float, float>> intervals = {};
+  for (size_t i = 0; i + 1 < edges.size(); i++) {
+    auto top = edges[i];
+    auto bottom = edges[i + 1];
+    intervals.clear();
+    for (auto& rect : group) {
+      if (rect.top <= top && rect.bottom >= bottom) {
+        intervals.emplace_back(rect.left, rect.right);
+      }
+    }
+    std::sort(intervals.begin(), intervals.end());
+    std::map<std::pair<float, float>, size_t> bandRects = {};
+    size_t index = 0;
+    while (index < intervals.size()) {
+      auto left = intervals[index].first;
+      auto right = intervals[index].second;
+      while (++index < intervals.size() && intervals[index].first <= right) {
+        right = std::max(right, intervals[index].second);
+      }
+      auto key = std::make_pair(left, right);
+      auto open = openRects.find(key);
+      if (open != openRects.end()) {
+        (*result)[open->second].bottom = bottom;
+        bandRects.emplace(key, open->second);
+      } else {
+        bandRects.emplace(key, result->size());
+        result->push_back(Rect::MakeLTRB(left, top, right, bottom));
+      }
+    }
+    openRects = std::move(bandRects);
+  }
+}
+
+std::vector<Rect> DecomposeRects(const std::vector<Rect>& rects) {
+  std::vector<Rect> sorted = {};
+  sorted.reserve(rects.size());
+  for (auto& rect : rects) {
+    if (!rect.isEmpty()) {
+      sorted.push_back(rect);
+    }
+  }
+  std::sort(sorted.begin(), sorted.end(), LeftLess);
+  auto count = sorted.size();
+  // Groups the rectangles that overlap each other, directly or through others.
+  std::vector<size_t> parents(count);
+  std::iota(parents.begin(), parents.end(), static_cast<size_t>(0));
   for (size_t i = 0; i < count; i++) {
-    for (size_t j = i + 1; j < count; j++) {
-      if (Rect::Intersects(rects[i], rects[j])) {
-        DecomposeRect(&rects[i], &rects[j]);
+    for (size_t j = i + 1; j < count && sorted[j].left < sorted[i].right; j++) {
+      if (sorted[j].top < sorted[i].bottom && sorted[j].bottom > sorted[i].top) {
+        parents[FindRoot(parents, j)] = FindRoot(parents, i);
       }
     }
   }
+  std::map<size_t, std::vector<Rect>> groups = {};
+  std::vector<Rect> result = {};
+  result.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    groups[FindRoot(parents, i)].push_back(sorted[i]);
+  }
+  for (auto& item : groups) {
+    if (item.second.size() == 1) {
+      result.push_back(item.second.front());
+    } else {
+      DecomposeGroup(item.second, &result);
+    }
+  }
+  return result;
 }
 }  // namespace tgfx
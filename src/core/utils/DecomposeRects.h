@@ -18,14 +18,27 @@
 
 #pragma once
 
+#include <vector>
 #include "tgfx/core/Rect.h"
 
 namespace tgfx {
 /**
- * Restructure a list of rectangles to remove their intersections while still covering the same or a
- * larger area. The input rectangles are modified in place.
- * @param rects Array of rectangles to decompose.
- * @param count Number of rectangles in the array.
+ * Merges rectangles whose bounding box covers no more area than the rectangles themselves, such as
+ * nested, heavily overlapping, or adjacent aligned ones. If more than maxCount rectangles remain,
+ * nearby rectangles are merged as well, accepting some extra area, until at most maxCount are
+ * left. The merging sweeps the rectangles sorted by their left edges, which takes O(n log n) for
+ * scattered rectangles.
+ * @param rects The rectangles to merge, modified in place. Empty rectangles are removed.
+ * @param maxCount The maximum number of rectangles to keep, must be greater than 0.
  */
-void DecomposeRects(Rect* rects, size_t count);
+void MergeRects(std::vector<Rect>* rects, size_t maxCount);
+
+/**
+ * Splits a list of rectangles into non-overlapping rectangles that cover exactly the same area.
+ * Rectangles that do not overlap any other one are returned unchanged, and each group of
+ * overlapping rectangles is cut into horizontal bands.
+ * @param rects The rectangles to decompose.
+ * @return The non-overlapping rectangles.
+ */
+std::vector<Rect> DecomposeRects(const std::vector<Rect>& rects);
 }  // namespace tgfx
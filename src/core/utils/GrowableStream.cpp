@@ -0,0 +1,95 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GrowableStream.h"
+#include <algorithm>
+#include <cstring>
+
+namespace tgfx {
+bool GrowableStream::append(const void* data, size_t length) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (finished) {
+    return false;
+  }
+  auto start = static_cast<const uint8_t*>(data);
+  bytes.insert(bytes.end(), start, start + length);
+  return true;
+}
+
+void GrowableStream::finish() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  finished = true;
+}
+
+bool GrowableStream::isFinished() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return finished;
+}
+
+size_t GrowableStream::position() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return offset;
+}
+
+size_t GrowableStream::peek(void* buffer, size_t size) const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  size = std::min(size, bytes.size() - offset);
+  if (buffer && size > 0) {
+    memcpy(buffer, bytes.data() + offset, size);
+  }
+  return size;
+}
+
+size_t GrowableStream::size() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return bytes.size();
+}
+
+bool GrowableStream::seek(size_t position) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  offset = std::min(position, bytes.size());
+  return true;
+}
+
+bool GrowableStream::move(int moveOffset) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (moveOffset < 0) {
+    auto distance = static_cast<size_t>(-static_cast<int64_t>(moveOffset));
+    offset = distance > offset ? 0 : offset - distance;
+  } else {
+    offset = std::min(offset + static_cast<size_t>(moveOffset), bytes.size());
+  }
+  return true;
+}
+
+size_t GrowableStream::read(void* buffer, size_t size) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  size = std::min(size, bytes.size() - offset);
+  if (buffer && size > 0) {
+    memcpy(buffer, bytes.data() + offset, size);
+  }
+  offset += size;
+  return size;
+}
+
+bool GrowableStream::rewind() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  offset = 0;
+  return true;
+}
+}  // namespace tgfx
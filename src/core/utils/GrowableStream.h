@@ -0,0 +1,78 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include "tgfx/core/Stream.h"
+
+namespace tgfx {
+/**
+ * GrowableStream is a Stream whose bytes arrive over time, such as an image being downloaded. One
+ * thread may append bytes while another reads them, reads only return the bytes received so far.
+ */
+class GrowableStream : public Stream {
+ public:
+  /**
+   * Appends the specified bytes to the end of the stream. Returns false if the stream has already
+   * been finished.
+   */
+  bool append(const void* bytes, size_t length);
+
+  /**
+   * Marks the stream as finished, no more bytes can be appended afterward.
+   */
+  void finish();
+
+  /**
+   * Returns true if the stream has been finished.
+   */
+  bool isFinished() const;
+
+  /**
+   * Returns the current read position of the stream.
+   */
+  size_t position() const;
+
+  /**
+   * Copies up to size bytes from the current position into buffer without moving the position.
+   * Returns how many bytes were copied.
+   */
+  size_t peek(void* buffer, size_t size) const;
+
+  /**
+   * Returns the number of bytes received so far.
+   */
+  size_t size() const override;
+
+  bool seek(size_t position) override;
+
+  bool move(int offset) override;
+
+  size_t read(void* buffer, size_t size) override;
+
+  bool rewind() override;
+
+ private:
+  mutable std::mutex locker = {};
+  std::vector<uint8_t> bytes = {};
+  size_t offset = 0;
+  bool finished = false;
+};
+}  // namespace tgfx
@@ -64,6 +64,56 @@ size_t PixelFormatBytesPerPixel(PixelFormat format) {
   }
 }
 
+bool IsCompressedPixelFormat(PixelFormat format) {
+  return CompressedBlockBytes(format) > 0;
+}
+
+size_t CompressedBlockBytes(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::ETC2_RGB8:
+    case PixelFormat::BC1_RGB:
+      return 8;
+    case PixelFormat::ETC2_RGBA8:
+    case PixelFormat::BC3_RGBA:
+    case PixelFormat::ASTC_4x4:
+      return 16;
+    default:
+      return 0;
+  }
+}
+
+size_t PixelFormatDataSize(PixelFormat format, int width, int height) {
+  if (width <= 0 || height <= 0) {
+    return 0;
+  }
+  auto blockBytes = CompressedBlockBytes(format);
+  if (blockBytes == 0) {
+    return static_cast<size_t>(width) * static_cast<size_t>(height) *
+           PixelFormatBytesPerPixel(format);
+  }
+  auto blocksWide = (static_cast<size_t>(width) + 3) / 4;
+  auto blocksHigh = (static_cast<size_t>(height) + 3) / 4;
+  return blocksWide * blocksHigh * blockBytes;
+}
+
+bool IsCompressedFormatSupported(const GPUFeatures* features, PixelFormat format) {
+  if (features == nullptr) {
+    return false;
+  }
+  switch (format) {
+    case PixelFormat::ETC2_RGB8:
+    case PixelFormat::ETC2_RGBA8:
+      return features->textureCompressionETC2;
+    case PixelFormat::BC1_RGB:
+    case PixelFormat::BC3_RGBA:
+      return features->textureCompressionBC;
+    case PixelFormat::ASTC_4x4:
+      return features->textureCompressionASTC;
+    default:
+      return false;
+  }
+}
+
 PixelFormat MaskFormatToPixelFormat(MaskFormat format) {
   switch (format) {
     case MaskFormat::A8:
@@ -21,6 +21,7 @@
 #include <cstdio>
 #include "core/AtlasTypes.h"
 #include "tgfx/core/ImageInfo.h"
+#include "tgfx/gpu/GPUFeatures.h"
 #include "tgfx/gpu/PixelFormat.h"
 
 namespace tgfx {
@@ -30,6 +31,28 @@ ColorType PixelFormatToColorType(PixelFormat format);
 
 size_t PixelFormatBytesPerPixel(PixelFormat format);
 
+/**
+ * Returns true if the format stores pixels in compressed blocks of 4x4 pixels.
+ */
+bool IsCompressedPixelFormat(PixelFormat format);
+
+/**
+ * Returns the number of bytes taken by each 4x4 block of a compressed format, or 0 if the format is
+ * not compressed.
+ */
+size_t CompressedBlockBytes(PixelFormat format);
+
+/**
+ * Returns the number of bytes taken by the pixels of the given size in the format. Compressed
+ * formats count whole blocks, so the size is rounded up to multiples of 4.
+ */
+size_t PixelFormatDataSize(PixelFormat format, int width, int height);
+
+/**
+ * Returns true if the GPU with the given features can sample textures in the compressed format.
+ */
+bool IsCompressedFormatSupported(const GPUFeatures* features, PixelFormat format);
+
 PixelFormat MaskFormatToPixelFormat(MaskFormat format);
 
 }  // namespace tgfx
@@ -21,6 +21,9 @@
 #include "core/utils/TaskGroup.h"
 
 namespace tgfx {
+// How long a task thread waiting for a Task sleeps before checking the queues for other work again.
+static constexpr auto TASK_THREAD_WAIT_INTERVAL = std::chrono::milliseconds(1);
+
 class BlockTask : public Task {
  public:
   explicit BlockTask(std::function<void()> block) : block(std::move(block)) {
@@ -39,6 +42,14 @@ void Task::ReleaseThreads() {
   TaskGroup::GetInstance()->releaseThreads(false);
 }
 
+void Task::SetMaxThreads(int count) {
+  TaskGroup::GetInstance()->setMaxThreads(count);
+}
+
+int Task::GetMaxThreads() {
+  return TaskGroup::GetInstance()->maxThreads;
+}
+
 std::shared_ptr<Task> Task::Run(std::function<void()> block, TaskPriority priority) {
   if (block == nullptr) {
     return nullptr;
@@ -52,17 +63,64 @@ void Task::Run(std::shared_ptr<Task> task, TaskPriority priority) {
   if (task == nullptr) {
     return;
   }
+  task->priority = priority;
+  Schedule(std::move(task));
+}
+
+std::shared_ptr<Task> Task::Run(std::function<void()> block,
+                                const std::vector<std::shared_ptr<Task>>& dependencies,
+                                TaskPriority priority) {
+  if (block == nullptr) {
+    return nullptr;
+  }
+  auto task = std::make_shared<BlockTask>(std::move(block));
+  Run(task, dependencies, priority);
+  return task;
+}
+
+void Task::Run(std::shared_ptr<Task> task, const std::vector<std::shared_ptr<Task>>& dependencies,
+               TaskPriority priority) {
+  if (task == nullptr) {
+    return;
+  }
+  task->priority = priority;
+  // Holds an extra count while registering, so the task can't be scheduled before all the
+  // dependencies are registered.
+  task->pendingDependencies = 1;
+  for (auto& dependency : dependencies) {
+    if (dependency == nullptr || dependency == task) {
+      continue;
+    }
+    std::lock_guard<std::mutex> autoLock(dependency->locker);
+    if (dependency->isDone()) {
+      continue;
+    }
+    ++task->pendingDependencies;
+    dependency->dependents.push_back(task);
+  }
+  ReleaseDependency(std::move(task));
+}
+
+void Task::Schedule(std::shared_ptr<Task> task) {
+  auto priority = task->priority;
   if (!TaskGroup::GetInstance()->pushTask(task, priority)) {
     task->execute();
   }
 }
 
+void Task::ReleaseDependency(std::shared_ptr<Task> task) {
+  if (--task->pendingDependencies == 0) {
+    Schedule(std::move(task));
+  }
+}
+
 void Task::cancel() {
   auto currentStatus = _status.load(std::memory_order_acquire);
   if (currentStatus == TaskStatus::Queueing) {
     if (_status.compare_exchange_strong(currentStatus, TaskStatus::Canceled,
                                         std::memory_order_acq_rel, std::memory_order_relaxed)) {
       onCancel();
+      finish();
     }
   }
 }
@@ -74,7 +132,7 @@ bool Task::wait(uint64_t timeout) {
   }
   // If wait() is called from the thread pool, all threads might block, leaving no thread to execute
   // this task. To avoid deadlock, execute the task directly on the current thread if it's queued.
-  if (oldStatus == TaskStatus::Queueing) {
+  if (oldStatus == TaskStatus::Queueing && pendingDependencies == 0) {
     if (_status.compare_exchange_strong(oldStatus, TaskStatus::Executing, std::memory_order_acq_rel,
                                         std::memory_order_relaxed)) {
       onExecute();
@@ -82,21 +140,43 @@ bool Task::wait(uint64_t timeout) {
       while (!_status.compare_exchange_weak(oldStatus, TaskStatus::Finished,
                                             std::memory_order_acq_rel, std::memory_order_relaxed)) {
       }
+      finish();
       return true;
     }
   }
-  std::unique_lock<std::mutex> autoLock(locker);
-  if (_status.load(std::memory_order_acquire) == TaskStatus::Executing) {
-    if (timeout == 0) {
+  auto hasTimeout = timeout > 0;
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+  auto taskGroup = TaskGroup::GetInstance();
+  // On a task thread, keep executing other queued tasks (such as the pending dependencies of this
+  // task) instead of blocking the thread.
+  while (!isDone()) {
+    if (hasTimeout && std::chrono::steady_clock::now() >= deadline) {
+      return false;
+    }
+    if (taskGroup->runPendingTask()) {
+      continue;
+    }
+    std::unique_lock<std::mutex> autoLock(locker);
+    if (isDone()) {
+      break;
+    }
+    if (TaskGroup::IsTaskThread()) {
+      // Nothing to run for now, check the queues again shortly in case new tasks arrive.
+      condition.wait_for(autoLock, TASK_THREAD_WAIT_INTERVAL);
+    } else if (hasTimeout) {
+      condition.wait_until(autoLock, deadline);
+    } else {
       condition.wait(autoLock);
-      return true;
     }
-    auto chronoTimeout = std::chrono::milliseconds(timeout);
-    return condition.wait_for(autoLock, chronoTimeout) == std::cv_status::no_timeout;
   }
   return true;
 }
 
+bool Task::isDone() const {
+  auto currentStatus = _status.load(std::memory_order_acquire);
+  return currentStatus == TaskStatus::Finished || currentStatus == TaskStatus::Canceled;
+}
+
 void Task::execute() {
   auto oldStatus = _status.load(std::memory_order_acquire);
   if (oldStatus == TaskStatus::Queueing &&
@@ -107,8 +187,20 @@ void Task::execute() {
     while (!_status.compare_exchange_weak(oldStatus, TaskStatus::Finished,
                                           std::memory_order_acq_rel, std::memory_order_relaxed)) {
     }
+    finish();
+  }
+}
+
+void Task::finish() {
+  std::vector<std::shared_ptr<Task>> readyTasks = {};
+  {
     std::unique_lock<std::mutex> autoLock(locker);
+    readyTasks = std::move(dependents);
+    dependents = {};
     condition.notify_all();
   }
+  for (auto& task : readyTasks) {
+    ReleaseDependency(std::move(task));
+  }
 }
 }  // namespace tgfx
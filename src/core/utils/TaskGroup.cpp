@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "TaskGroup.h"
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include "MathExtra.h"
@@ -33,6 +34,9 @@ static constexpr size_t TASK_PRIORITY_SIZE = 3;
 // 70% of max threads can run low priority tasks
 static constexpr float LOW_PRIORITY_THREAD_RATIO = 0.7f;
 
+// The index of the task thread running on the current thread, or -1 for threads outside the pool.
+static thread_local int CurrentWorkerIndex = -1;
+
 static int GetMaxThreads() {
   int cpuCores = 0;
 #ifdef __APPLE__
@@ -56,9 +60,14 @@ TaskGroup* TaskGroup::GetInstance() {
   return &taskGroup;
 }
 
-void TaskGroup::RunLoop(TaskGroup* taskGroup) {
+bool TaskGroup::IsTaskThread() {
+  return CurrentWorkerIndex >= 0;
+}
+
+void TaskGroup::RunLoop(TaskGroup* taskGroup, int workerIndex) {
+  CurrentWorkerIndex = workerIndex;
   while (true) {
-    auto task = taskGroup->popTask();
+    auto task = taskGroup->popTask(workerIndex);
     if (task == nullptr) {
       if (taskGroup->exited) {
         break;
@@ -75,30 +84,46 @@ void OnAppExit() {
   TaskGroup::GetInstance()->exit();
 }
 
-TaskGroup::TaskGroup() : maxThreads(GetMaxThreads()) {
-  lowPriorityThreads = FloatRoundToInt(static_cast<float>(maxThreads) * LOW_PRIORITY_THREAD_RATIO);
-  if (lowPriorityThreads < 1) {
-    lowPriorityThreads = 1;
-  }
-  threads = new moodycamel::ConcurrentQueue<std::thread*>(static_cast<size_t>(maxThreads));
+TaskGroup::TaskGroup() {
+  setMaxThreads(GetMaxThreads());
+  threads = new moodycamel::ConcurrentQueue<std::thread*>(static_cast<size_t>(MAX_THREADS_SIZE));
   priorityQueues.reserve(TASK_PRIORITY_SIZE);
   for (size_t i = 0; i < TASK_PRIORITY_SIZE; i++) {
     auto queue = new moodycamel::ConcurrentQueue<std::shared_ptr<Task>>();
     priorityQueues.push_back(queue);
   }
+  // Allocate the local queues up front, so threads can steal from them without locking the list.
+  workerQueues.reserve(MAX_THREADS_SIZE);
+  for (int i = 0; i < MAX_THREADS_SIZE; i++) {
+    workerQueues.push_back(new WorkerQueue());
+  }
   std::atexit(OnAppExit);
 }
 
+void TaskGroup::setMaxThreads(int count) {
+  count = std::clamp(count, 1, MAX_THREADS_SIZE);
+  maxThreads = count;
+  auto lowThreads = FloatRoundToInt(static_cast<float>(count) * LOW_PRIORITY_THREAD_RATIO);
+  lowPriorityThreads = std::max(lowThreads, 1);
+  condition.notify_all();
+}
+
 bool TaskGroup::checkThreads() {
   if (waitingThreads == 0 && totalThreads < maxThreads) {
-    auto thread = new (std::nothrow) std::thread(TaskGroup::RunLoop, this);
+    auto workerIndex = totalThreads.fetch_add(1);
+    if (workerIndex >= maxThreads) {
+      --totalThreads;
+      return true;
+    }
+    auto thread = new (std::nothrow) std::thread(TaskGroup::RunLoop, this, workerIndex);
     if (thread) {
-      if (threads->enqueue(thread)) {
-        ++totalThreads;
-      } else {
+      if (!threads->enqueue(thread)) {
+        --totalThreads;
         delete thread;
         return false;
       }
+    } else {
+      --totalThreads;
     }
   } else {
     return true;
@@ -113,9 +138,17 @@ bool TaskGroup::pushTask(std::shared_ptr<Task> task, TaskPriority priority) {
   if (exited || !checkThreads()) {
     return false;
   }
-  auto& queue = priorityQueues[static_cast<size_t>(priority)];
-  if (!queue->enqueue(task)) {
-    return false;
+  auto workerIndex = CurrentWorkerIndex;
+  if (workerIndex >= 0 && priority != TaskPriority::Low) {
+    auto workerQueue = workerQueues[static_cast<size_t>(workerIndex)];
+    std::lock_guard<std::mutex> autoLock(workerQueue->locker);
+    workerQueue->tasks.push_back(std::move(task));
+    ++workerQueue->size;
+  } else {
+    auto& queue = priorityQueues[static_cast<size_t>(priority)];
+    if (!queue->enqueue(task)) {
+      return false;
+    }
   }
   if (waitingThreads > 0) {
     condition.notify_one();
@@ -123,17 +156,12 @@ bool TaskGroup::pushTask(std::shared_ptr<Task> task, TaskPriority priority) {
   return true;
 }
 
-std::shared_ptr<Task> TaskGroup::popTask() {
+std::shared_ptr<Task> TaskGroup::popTask(int workerIndex) {
   while (!exited) {
-    std::shared_ptr<Task> task = nullptr;
-    for (size_t i = 0; i < static_cast<size_t>(TaskPriority::Low); i++) {
-      if (priorityQueues[i]->try_dequeue(task)) {
-        return task;
-      }
-    }
-    if (totalThreads - waitingThreads < lowPriorityThreads) {
-      auto& queue = priorityQueues[static_cast<size_t>(TaskPriority::Low)];
-      if (queue->try_dequeue(task)) {
+    // Threads beyond a lowered thread limit stay parked until the limit is raised again.
+    if (workerIndex < maxThreads) {
+      auto task = tryPopTask(workerIndex);
+      if (task != nullptr) {
         return task;
       }
     }
@@ -154,6 +182,69 @@ std::shared_ptr<Task> TaskGroup::popTask() {
   return nullptr;
 }
 
+std::shared_ptr<Task> TaskGroup::tryPopTask(int workerIndex) {
+  std::shared_ptr<Task> task = nullptr;
+  if (workerIndex >= 0) {
+    auto workerQueue = workerQueues[static_cast<size_t>(workerIndex)];
+    if (workerQueue->size > 0) {
+      std::lock_guard<std::mutex> autoLock(workerQueue->locker);
+      if (!workerQueue->tasks.empty()) {
+        task = std::move(workerQueue->tasks.back());
+        workerQueue->tasks.pop_back();
+        --workerQueue->size;
+        return task;
+      }
+    }
+  }
+  for (size_t i = 0; i < static_cast<size_t>(TaskPriority::Low); i++) {
+    if (priorityQueues[i]->try_dequeue(task)) {
+      return task;
+    }
+  }
+  task = stealTask(workerIndex);
+  if (task != nullptr) {
+    return task;
+  }
+  if (totalThreads - waitingThreads < lowPriorityThreads) {
+    auto& queue = priorityQueues[static_cast<size_t>(TaskPriority::Low)];
+    if (queue->try_dequeue(task)) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<Task> TaskGroup::stealTask(int workerIndex) {
+  auto start = workerIndex >= 0 ? static_cast<size_t>(workerIndex) + 1 : 0;
+  for (size_t i = 0; i < workerQueues.size(); i++) {
+    auto victim = workerQueues[(start + i) % workerQueues.size()];
+    if (victim->size == 0) {
+      continue;
+    }
+    std::lock_guard<std::mutex> autoLock(victim->locker);
+    if (!victim->tasks.empty()) {
+      auto task = std::move(victim->tasks.front());
+      victim->tasks.pop_front();
+      --victim->size;
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+bool TaskGroup::runPendingTask() {
+  auto workerIndex = CurrentWorkerIndex;
+  if (workerIndex < 0 || exited) {
+    return false;
+  }
+  auto task = tryPopTask(workerIndex);
+  if (task == nullptr) {
+    return false;
+  }
+  task->execute();
+  return true;
+}
+
 void TaskGroup::exit() {
   releaseThreads(true);
 }
@@ -180,6 +271,10 @@ void TaskGroup::releaseThreads(bool exit) {
       delete queue;
     }
     priorityQueues.clear();
+    for (auto& workerQueue : workerQueues) {
+      delete workerQueue;
+    }
+    workerQueues.clear();
   } else {
     exited = false;
   }
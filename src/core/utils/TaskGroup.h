@@ -19,6 +19,7 @@
 #pragma once
 
 #include <condition_variable>
+#include <deque>
 #include <list>
 #include <mutex>
 #include <thread>
@@ -28,24 +29,42 @@
 
 namespace tgfx {
 
+/**
+ * TaskGroup is the thread pool that executes Tasks. Tasks submitted from outside the pool go to
+ * global priority queues. Tasks submitted from a task thread (including the tasks unlocked when a
+ * dependency finishes) go to the local deque of that thread, which pops them in LIFO order while
+ * idle threads steal from the other end.
+ */
 class TaskGroup {
  private:
+  struct WorkerQueue {
+    std::mutex locker = {};
+    std::deque<std::shared_ptr<Task>> tasks = {};
+    std::atomic_size_t size = 0;
+  };
+
   std::mutex locker = {};
-  int maxThreads = 32;
-  int lowPriorityThreads = 2;
+  std::atomic_int maxThreads = 32;
+  std::atomic_int lowPriorityThreads = 2;
   std::condition_variable condition = {};
   std::atomic_int totalThreads = 0;
   std::atomic_bool exited = false;
   std::atomic_int waitingThreads = 0;
   std::vector<moodycamel::ConcurrentQueue<std::shared_ptr<Task>>*> priorityQueues = {};
+  std::vector<WorkerQueue*> workerQueues = {};
   moodycamel::ConcurrentQueue<std::thread*>* threads = nullptr;
   static TaskGroup* GetInstance();
-  static void RunLoop(TaskGroup* taskGroup);
+  static bool IsTaskThread();
+  static void RunLoop(TaskGroup* taskGroup, int workerIndex);
 
   TaskGroup();
+  void setMaxThreads(int count);
   bool checkThreads();
   bool pushTask(std::shared_ptr<Task> task, TaskPriority priority);
-  std::shared_ptr<Task> popTask();
+  std::shared_ptr<Task> popTask(int workerIndex);
+  std::shared_ptr<Task> tryPopTask(int workerIndex);
+  std::shared_ptr<Task> stealTask(int workerIndex);
+  bool runPendingTask();
   void exit();
   void releaseThreads(bool exit);
 
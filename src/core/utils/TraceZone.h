@@ -0,0 +1,100 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#ifdef TGFX_USE_TRACE
+
+#include <atomic>
+#include <cstdint>
+
+namespace tgfx {
+/**
+ * TraceRecorder collects the events exported by tgfx::Trace. Event names must be string literals,
+ * since only their pointers are stored.
+ */
+class TraceRecorder {
+ public:
+  static bool IsRecording() {
+    return Recording.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns the current time in nanoseconds, used as the start time of zones.
+   */
+  static int64_t Now();
+
+  /**
+   * Records a zone that started at startTime and ends now.
+   */
+  static void AddZone(const char* name, int64_t startTime);
+
+  /**
+   * Records the current value of a counter.
+   */
+  static void AddCounter(const char* name, int64_t value);
+
+ private:
+  static std::atomic_bool Recording;
+
+  friend class Trace;
+};
+
+/**
+ * TraceZone records a zone that spans its own lifetime.
+ */
+class TraceZone {
+ public:
+  explicit TraceZone(const char* name) {
+    if (TraceRecorder::IsRecording()) {
+      this->name = name;
+      startTime = TraceRecorder::Now();
+    }
+  }
+
+  ~TraceZone() {
+    if (name != nullptr) {
+      TraceRecorder::AddZone(name, startTime);
+    }
+  }
+
+  TraceZone(const TraceZone&) = delete;
+  TraceZone& operator=(const TraceZone&) = delete;
+
+ private:
+  const char* name = nullptr;
+  int64_t startTime = 0;
+};
+}  // namespace tgfx
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_ZONE(name) ::tgfx::TraceZone TRACE_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_COUNTER(name, value)                                          \
+  do {                                                                      \
+    if (::tgfx::TraceRecorder::IsRecording()) {                             \
+      ::tgfx::TraceRecorder::AddCounter(name, static_cast<int64_t>(value)); \
+    }                                                                       \
+  } while (false)
+
+#else
+
+#define TRACE_ZONE(name)
+#define TRACE_COUNTER(name, value)
+
+#endif
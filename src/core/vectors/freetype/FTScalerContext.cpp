@@ -207,6 +207,7 @@ FTScalerContext::FTScalerContext(std::shared_ptr<Typeface> typeFace, float size)
       LOGE("FT_Set_CharSize(%s, %f, %f) failed.", face->family_name, textScaleDot6, textScaleDot6);
       return;
     }
+    charSize = textScaleDot6;
     // Adjust the matrix to reflect the actually chosen scale.
     // FreeType currently does not allow requesting sizes less than 1, this allows for scaling.
     // Don't do this at all sizes as that will interfere with hinting.
@@ -259,22 +260,41 @@ FTScalerContext::~FTScalerContext() {
   }
 }
 
-int FTScalerContext::setupSize(bool fauxItalic) const {
-  FT_Error err = FT_Activate_Size(ftSize);
-  if (err != 0) {
-    return err;
-  }
-  auto matrix = getExtraMatrix(fauxItalic);
+static void SetFaceTransform(FT_Face face, const Matrix& matrix) {
   FT_Matrix matrix22 = {
       FloatToFTFixed(matrix.getScaleX()),
       FloatToFTFixed(-matrix.getSkewX()),
       FloatToFTFixed(-matrix.getSkewY()),
       FloatToFTFixed(matrix.getScaleY()),
   };
-  FT_Set_Transform(ftTypeface()->face, &matrix22, nullptr);
+  FT_Set_Transform(face, &matrix22, nullptr);
+}
+
+int FTScalerContext::setupSize(bool fauxItalic) const {
+  FT_Error err = FT_Activate_Size(ftSize);
+  if (err != 0) {
+    return err;
+  }
+  SetFaceTransform(ftTypeface()->face, getExtraMatrix(fauxItalic));
   return 0;
 }
 
+bool FTScalerContext::setupRasterFace(FTRasterFace* rasterFace) const {
+  // Raster faces are shared by all scaler contexts of the typeface, so the char size is only
+  // reapplied when it changes. This keeps the hinting setup of runs at one size cheap.
+  if (rasterFace->charSize != charSize) {
+    auto err = FT_Set_Char_Size(rasterFace->face, charSize, charSize, DefaultResolutionInDPI,
+                                DefaultResolutionInDPI);
+    if (err != FT_Err_Ok) {
+      rasterFace->charSize = 0;
+      return false;
+    }
+    rasterFace->charSize = charSize;
+  }
+  SetFaceTransform(rasterFace->face, getExtraMatrix(false));
+  return true;
+}
+
 FontMetrics FTScalerContext::onComputeFontMetrics() const {
   std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
   FontMetrics metrics = {};
@@ -862,16 +882,10 @@ bool FTScalerContext::readPixels(GlyphID glyphID, bool fauxBold, const Stroke*,
   USE(isColorVector);
   USE(glyphOffset);
 #endif
-  std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
   if (!colorFont) {
-    auto face = ftTypeface()->face;
-    if (!loadOutlineGlyph(face, glyphID, fauxBold, false)) {
-      return false;
-    }
-    ClearPixels(dstInfo, dstPixels);
-    RenderOutLineGlyph(face, dstInfo, dstPixels);
-    return true;
+    return readOutlinePixels(glyphID, fauxBold, dstInfo, dstPixels);
   }
+  std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
   auto glyphFlags = loadGlyphFlags;
   glyphFlags |= FT_LOAD_RENDER;
   glyphFlags &= ~FT_LOAD_NO_BITMAP;
@@ -930,12 +944,7 @@ FTTypeface* FTScalerContext::ftTypeface() const {
   return static_cast<FTTypeface*>(typeface.get());
 }
 
-bool FTScalerContext::loadOutlineGlyph(FT_Face face, GlyphID glyphID, bool fauxBold,
-                                       bool fauxItalic) const {
-  // FT_IS_SCALABLE is documented to mean the face contains outline glyphs.
-  if (!FT_IS_SCALABLE(face) || setupSize(fauxItalic)) {
-    return false;
-  }
+static bool LoadOutline(FT_Face face, GlyphID glyphID, FT_Int32 loadGlyphFlags, bool fauxBold) {
   auto flags = loadGlyphFlags;
   flags |= FT_LOAD_NO_BITMAP;  // ignore embedded bitmaps so we're sure to get the outline
   flags &= ~FT_LOAD_RENDER;    // don't scan convert (we just want the outline)
@@ -949,6 +958,41 @@ bool FTScalerContext::loadOutlineGlyph(FT_Face face, GlyphID glyphID, bool fauxB
   return true;
 }
 
+bool FTScalerContext::loadOutlineGlyph(FT_Face face, GlyphID glyphID, bool fauxBold,
+                                       bool fauxItalic) const {
+  // FT_IS_SCALABLE is documented to mean the face contains outline glyphs.
+  if (!FT_IS_SCALABLE(face) || setupSize(fauxItalic)) {
+    return false;
+  }
+  return LoadOutline(face, glyphID, loadGlyphFlags, fauxBold);
+}
+
+bool FTScalerContext::readOutlinePixels(GlyphID glyphID, bool fauxBold, const ImageInfo& dstInfo,
+                                        void* dstPixels) const {
+  auto typeface = ftTypeface();
+  // Glyph cells are rasterized on task threads. Rendering on a raster face of our own lets those
+  // threads run FreeType in parallel instead of queuing on the typeface lock.
+  auto rasterFace = charSize > 0 ? typeface->acquireRasterFace() : FTRasterFace{};
+  if (rasterFace.face == nullptr) {
+    std::lock_guard<std::mutex> autoLock(typeface->locker);
+    auto face = typeface->face;
+    if (!loadOutlineGlyph(face, glyphID, fauxBold, false)) {
+      return false;
+    }
+    ClearPixels(dstInfo, dstPixels);
+    RenderOutLineGlyph(face, dstInfo, dstPixels);
+    return true;
+  }
+  auto result = setupRasterFace(&rasterFace) &&
+                LoadOutline(rasterFace.face, glyphID, loadGlyphFlags, fauxBold);
+  if (result) {
+    ClearPixels(dstInfo, dstPixels);
+    RenderOutLineGlyph(rasterFace.face, dstInfo, dstPixels);
+  }
+  typeface->releaseRasterFace(rasterFace);
+  return result;
+}
+
 #if defined(__ANDROID__) || defined(ANDROID)
 bool FTScalerContext::MeasureColorVectorGlyph(GlyphID glyphID, Rect* rect) const {
   std::string text = ftTypeface()->getGlyphUTF8(glyphID);
@@ -77,6 +77,11 @@ class FTScalerContext : public ScalerContext {
 
   bool loadOutlineGlyph(FT_Face face, GlyphID glyphID, bool fauxBold, bool fauxItalic) const;
 
+  bool readOutlinePixels(GlyphID glyphID, bool fauxBold, const ImageInfo& dstInfo,
+                         void* dstPixels) const;
+
+  bool setupRasterFace(FTRasterFace* rasterFace) const;
+
   void collectCOLRv1GlyphPaths(FT_Face face, const FT_OpaquePaint& opaquePaint, bool fauxBold,
                                bool fauxItalic, Path* path) const;
 
@@ -87,6 +92,8 @@ class FTScalerContext : public ScalerContext {
   float textScale = 1.0f;
   Point extraScale = Point::Make(1.f, 1.f);
   FT_Size ftSize = nullptr;
+  // The char size passed to FT_Set_Char_Size for scalable faces, or 0 for bitmap-only faces.
+  FT_F26Dot6 charSize = 0;
   FT_Int strikeIndex = -1;  // The bitmap strike for the face (or -1 if none).
   FT_Int32 loadGlyphFlags = 0;
   float backingSize = 1.0f;
@@ -32,6 +32,7 @@
 #include <array>
 #include "FTScalerContext.h"
 #include "SystemFont.h"
+#include "core/utils/Log.h"
 #include "core/utils/UniqueID.h"
 #include "tgfx/core/UTF.h"
 
@@ -49,7 +50,11 @@ std::shared_ptr<Typeface> Typeface::MakeFromName(const std::string& fontFamily,
 #endif
 
 std::shared_ptr<Typeface> Typeface::MakeFromPath(const std::string& fontPath, int ttcIndex) {
-  return FTTypeface::Make(FTFontData(fontPath, ttcIndex));
+  FTFontData fontData(fontPath, ttcIndex);
+  // All faces of the typeface read the glyphs from one mapping of the font file, which shares its
+  // pages with the page cache instead of opening and buffering the file for every face.
+  fontData.data = Data::MakeFromFileMapping(fontPath);
+  return FTTypeface::Make(std::move(fontData));
 }
 
 std::shared_ptr<Typeface> Typeface::MakeFromBytes(const void* bytes, size_t length, int ttcIndex) {
@@ -64,6 +69,10 @@ std::shared_ptr<Typeface> Typeface::MakeFromData(std::shared_ptr<Data> data, int
   return FTTypeface::Make(FTFontData(std::move(data), ttcIndex));
 }
 
+// The maximum number of raster faces opened per typeface. Each face holds its own glyph slot and
+// size objects, so the pool is capped to bound memory when many threads rasterize the same font.
+static constexpr size_t MaxRasterFaces = 8;
+
 static std::mutex& FTMutex() {
   static std::mutex& mutex = *new std::mutex;
   return mutex;
@@ -122,9 +131,43 @@ FTTypeface::FTTypeface(FTFontData data, FT_Face face)
 
 FTTypeface::~FTTypeface() {
   std::lock_guard<std::mutex> autoLock(FTMutex());
+  for (auto& rasterFace : freeRasterFaces) {
+    FT_Done_Face(rasterFace.face);
+  }
   FT_Done_Face(face);
 }
 
+FTRasterFace FTTypeface::acquireRasterFace() const {
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (!freeRasterFaces.empty()) {
+      auto rasterFace = freeRasterFaces.back();
+      freeRasterFaces.pop_back();
+      return rasterFace;
+    }
+    if (rasterFaceCount >= MaxRasterFaces) {
+      return {};
+    }
+    rasterFaceCount++;
+  }
+  FTRasterFace rasterFace = {};
+  rasterFace.face = CreateFTFace(data);
+  if (rasterFace.face == nullptr) {
+    // Keep the slot counted so that a font that fails to reopen is not retried for every glyph.
+    LOGE("FTTypeface::acquireRasterFace() failed to open an extra face for \"%s\".",
+         face->family_name);
+  }
+  return rasterFace;
+}
+
+void FTTypeface::releaseRasterFace(const FTRasterFace& rasterFace) const {
+  if (rasterFace.face == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> autoLock(locker);
+  freeRasterFaces.push_back(rasterFace);
+}
+
 std::string FTTypeface::fontFamily() const {
   std::lock_guard<std::mutex> autoLock(locker);
   return face->family_name ? face->family_name : "";
@@ -22,6 +22,7 @@
 #include "tgfx/platform/android/Global.h"
 #endif
 #include <mutex>
+#include <vector>
 #include "ft2build.h"
 #include "tgfx/core/Stream.h"
 #include FT_FREETYPE_H
@@ -30,6 +31,16 @@
 #include "tgfx/core/Typeface.h"
 
 namespace tgfx {
+/**
+ * An extra FT_Face opened on the same font data as its FTTypeface, used to rasterize glyphs outside
+ * of the typeface lock. A raster face is owned by one thread at a time.
+ */
+struct FTRasterFace {
+  FT_Face face = nullptr;
+  // The char size currently applied to the face, in 26.6 fixed point.
+  FT_F26Dot6 charSize = 0;
+};
+
 class FTTypeface : public Typeface {
  public:
   static std::shared_ptr<FTTypeface> Make(FTFontData data);
@@ -80,8 +91,23 @@ class FTTypeface : public Typeface {
   Global<jobject> typeface;
 #endif
 
+  mutable std::vector<FTRasterFace> freeRasterFaces = {};
+  mutable size_t rasterFaceCount = 0;
+
   FTTypeface(FTFontData data, FT_Face face);
 
+  /**
+   * Takes a raster face from the pool, opening a new one if the pool is not full yet. Returns an
+   * empty FTRasterFace if the pool is exhausted, in which case the caller should fall back to the
+   * shared face under the typeface lock.
+   */
+  FTRasterFace acquireRasterFace() const;
+
+  /**
+   * Returns a raster face acquired by acquireRasterFace() to the pool.
+   */
+  void releaseRasterFace(const FTRasterFace& rasterFace) const;
+
   int unitsPerEmInternal() const;
 
 #ifdef TGFX_USE_ADVANCED_TYPEFACE_PROPERTY
@@ -18,11 +18,13 @@
 
 #include "tgfx/gpu/Context.h"
 #include "core/AtlasManager.h"
+#include "core/AtlasShapeCache.h"
 #include "core/AtlasStrikeCache.h"
 #include "core/utils/BlockAllocator.h"
 #include "core/utils/Log.h"
 #include "core/utils/SingleOwner.h"
 #include "core/utils/SlidingWindowTracker.h"
+#include "core/utils/TraceZone.h"
 #include "gpu/DrawingManager.h"
 #include "gpu/GlobalCache.h"
 #include "gpu/ProxyProvider.h"
@@ -46,6 +48,7 @@ Context::Context(Device* device, GPU* gpu) : _device(device), _gpu(gpu) {
   _proxyProvider = new ProxyProvider(this);
   _atlasManager = new AtlasManager(this);
   _atlasStrikeCache = new AtlasStrikeCache();
+  _atlasShapeCache = new AtlasShapeCache();
 }
 
 Context::~Context() {
@@ -56,6 +59,7 @@ Context::~Context() {
   delete _resourceCache;
   delete _shaderCaps;
   delete _atlasStrikeCache;
+  delete _atlasShapeCache;
 }
 
 Backend Context::backend() const {
@@ -80,9 +84,13 @@ bool Context::wait(const BackendSemaphore& waitSemaphore) {
 
 std::unique_ptr<Recording> Context::flush(BackendSemaphore* signalSemaphore) {
   ASSERT_OWNER_THREAD;
+  TRACE_ZONE("Context::flush");
+  auto startTime = Clock::Now();
   _atlasManager->preFlush();
   auto drawingBuffer = _drawingManager->flush();
+  _currentFrameStats.maskAtlasOccupancy = _atlasManager->occupancy(MaskFormat::A8);
   if (drawingBuffer == nullptr) {
+    _currentFrameStats.flushTime += Clock::Now() - startTime;
     return nullptr;
   }
   if (signalSemaphore != nullptr) {
@@ -94,6 +102,7 @@ std::unique_ptr<Recording> Context::flush(BackendSemaphore* signalSemaphore) {
   _atlasManager->postFlush();
   _proxyProvider->purgeExpiredProxies();
   pendingDrawingBuffers.push_back(drawingBuffer);
+  _currentFrameStats.flushTime += Clock::Now() - startTime;
   return std::unique_ptr<Recording>(
       new Recording(uniqueID(), drawingBuffer->uniqueID(), drawingBuffer->generation()));
 }
@@ -119,7 +128,10 @@ std::shared_ptr<DrawingBuffer> Context::getDrawingBuffer(const Recording* record
 
 void Context::submit(std::unique_ptr<Recording> recording, bool syncCpu) {
   ASSERT_OWNER_THREAD;
+  TRACE_ZONE("Context::submit");
+  auto startTime = Clock::Now();
   _resourceCache->processUnreferencedResources();
+  _globalCache->programCompileQueue()->process();
   auto queue = gpu()->queue();
   auto targetBuffer = getDrawingBuffer(recording.get());
   if (targetBuffer != nullptr) {
@@ -139,7 +151,10 @@ void Context::submit(std::unique_ptr<Recording> recording, bool syncCpu) {
           queue->waitSemaphore(std::move(semaphore));
         }
       }
-      queue->submit(std::move(commandBuffer));
+      {
+        TRACE_ZONE("CommandQueue::submit");
+        queue->submit(std::move(commandBuffer));
+      }
       drawingBuffer->presentWindows(this);
       pendingDrawingBuffers.pop_front();
       if (isLast) {
@@ -148,8 +163,28 @@ void Context::submit(std::unique_ptr<Recording> recording, bool syncCpu) {
     }
   }
   if (syncCpu) {
+    TRACE_ZONE("CommandQueue::waitUntilCompleted");
     queue->waitUntilCompleted();
   }
+  _globalCache->programBinaryCache()->flush();
+  _currentFrameStats.submitTime += Clock::Now() - startTime;
+  lastFrameStats = _currentFrameStats;
+  _currentFrameStats = {};
+  TRACE_COUNTER("drawOpCount", lastFrameStats.drawOpCount);
+  TRACE_COUNTER("mergedDrawCount", lastFrameStats.mergedDrawCount);
+  TRACE_COUNTER("reorderedDrawCount", lastFrameStats.reorderedDrawCount);
+  TRACE_COUNTER("programSwitchCount", lastFrameStats.programSwitchCount);
+  TRACE_COUNTER("atlasShapeDrawCount", lastFrameStats.atlasShapeDrawCount);
+  TRACE_COUNTER("maskAtlasOccupancy", lastFrameStats.maskAtlasOccupancy);
+  TRACE_COUNTER("clipMaskCount", lastFrameStats.clipMaskCount);
+  TRACE_COUNTER("clipMaskCacheHits", lastFrameStats.clipMaskCacheHits);
+  TRACE_COUNTER("transientRenderTargetCount", lastFrameStats.transientRenderTargetCount);
+  TRACE_COUNTER("aliasedRenderTargetCount", lastFrameStats.aliasedRenderTargetCount);
+  TRACE_COUNTER("renderTaskCount", lastFrameStats.renderTaskCount);
+  TRACE_COUNTER("programCompileCount", lastFrameStats.programCompileCount);
+  TRACE_COUNTER("uploadedBytes", lastFrameStats.uploadedBytes);
+  TRACE_COUNTER("resourceCacheHits", lastFrameStats.resourceCacheHits);
+  TRACE_COUNTER("resourceCacheMisses", lastFrameStats.resourceCacheMisses);
 }
 
 bool Context::flushAndSubmit(bool syncCpu) {
@@ -162,6 +197,49 @@ bool Context::flushAndSubmit(bool syncCpu) {
   return hasRecording;
 }
 
+ProgramCacheStats Context::programCacheStats() const {
+  ASSERT_OWNER_THREAD;
+  return _globalCache->programBinaryCache()->stats();
+}
+
+FrameStats Context::frameStats() const {
+  ASSERT_OWNER_THREAD;
+  return lastFrameStats;
+}
+
+bool Context::asyncShaderCompilation() const {
+  ASSERT_OWNER_THREAD;
+  return _globalCache->programCompileQueue()->enabled();
+}
+
+void Context::setAsyncShaderCompilation(bool enabled) {
+  ASSERT_OWNER_THREAD;
+  _globalCache->programCompileQueue()->setEnabled(enabled);
+}
+
+size_t Context::deferredDrawCount() const {
+  ASSERT_OWNER_THREAD;
+  return _globalCache->programCompileQueue()->deferredDrawCount();
+}
+
+size_t Context::reorderWindow() const {
+  return _reorderWindow;
+}
+
+void Context::setReorderWindow(size_t count) {
+  ASSERT_OWNER_THREAD;
+  _reorderWindow = count;
+}
+
+bool Context::renderTargetAliasing() const {
+  return _renderTargetAliasing;
+}
+
+void Context::setRenderTargetAliasing(bool enabled) {
+  ASSERT_OWNER_THREAD;
+  _renderTargetAliasing = enabled;
+}
+
 size_t Context::memoryUsage() const {
   ASSERT_OWNER_THREAD;
   return _resourceCache->getResourceBytes();
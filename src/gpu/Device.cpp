@@ -20,6 +20,7 @@
 #include "core/utils/Log.h"
 #include "core/utils/SingleOwner.h"
 #include "core/utils/UniqueID.h"
+#include "gpu/GlobalCache.h"
 #include "tgfx/gpu/Context.h"
 #include "tgfx/gpu/GPU.h"
 
@@ -60,6 +61,18 @@ void Device::unlock() {
   locker.unlock();
 }
 
+std::shared_ptr<ProgramCache> Device::programCache() const {
+  return _programCache;
+}
+
+void Device::setProgramCache(std::shared_ptr<ProgramCache> cache) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  _programCache = std::move(cache);
+  if (context != nullptr) {
+    context->globalCache()->programBinaryCache()->setProgramCache(_programCache);
+  }
+}
+
 bool Device::onLockContext() {
   return true;
 }
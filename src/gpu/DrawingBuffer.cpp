@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "DrawingBuffer.h"
+#include "core/utils/TraceZone.h"
 #include "core/utils/UniqueID.h"
 #include "gpu/GlobalCache.h"
 #include "tgfx/gpu/GPU.h"
@@ -28,29 +29,39 @@ namespace tgfx {
 // to pre-allocation optimizations on some platforms.
 DrawingBuffer::DrawingBuffer(Context* context)
     : context(context), _uniqueID(UniqueID::Next()), drawingAllocator(1 << 14, 1 << 21),
-      vertexAllocator(1 << 14, 1 << 21), instanceAllocator(1 << 14, 1 << 21) {
+      vertexAllocator(1 << 14, 1 << 21), instanceAllocator(1 << 14, 1 << 21),
+      transientTargets(context) {
   DEBUG_ASSERT(context != nullptr);
 }
 
 std::shared_ptr<CommandBuffer> DrawingBuffer::encode() {
   DEBUG_ASSERT(!empty());
+  TRACE_ZONE("DrawingBuffer::encode");
   {
+    TRACE_ZONE("ResourceTask::execute");
     for (auto& task : resourceTasks) {
       task->execute(context);
       task = nullptr;
     }
   }
-  for (auto& task : atlasTasks) {
-    task->upload(context);
-    task = nullptr;
-  }
-  auto commandEncoder = context->gpu()->createCommandEncoder();
   {
-    for (auto& task : renderTasks) {
-      task->execute(commandEncoder.get());
+    TRACE_ZONE("AtlasUploadTask::upload");
+    for (auto& task : atlasTasks) {
+      task->upload(context);
       task = nullptr;
     }
   }
+  auto commandEncoder = context->gpu()->createCommandEncoder();
+  for (size_t i = 0; i < renderTasks.size(); ++i) {
+    TRACE_ZONE("RenderTask::execute");
+    auto& task = renderTasks[i];
+    transientTargets.beforeExecute(i, task.get());
+    task->execute(commandEncoder.get());
+    task = nullptr;
+    transientTargets.afterExecute();
+  }
+  transientTargets.reset();
+  context->currentFrameStats()->renderTaskCount += renderTasks.size();
   vertexMaxValueTracker.addValue(vertexAllocator.size());
   instanceMaxValueTracker.addValue(instanceAllocator.size());
   drawingMaxValueTracker.addValue(drawingAllocator.size());
@@ -75,6 +86,7 @@ void DrawingBuffer::reset() {
   renderTasks.clear();
   resourceTasks.clear();
   atlasTasks.clear();
+  transientTargets.reset();
   windows.clear();
   vertexAllocator.clear(vertexMaxValueTracker.getMaxValue());
   instanceAllocator.clear(instanceMaxValueTracker.getMaxValue());
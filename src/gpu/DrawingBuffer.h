@@ -22,6 +22,7 @@
 #include <vector>
 #include "core/utils/BlockAllocator.h"
 #include "core/utils/SlidingWindowTracker.h"
+#include "gpu/TransientTargetAllocator.h"
 #include "gpu/tasks/AtlasUploadTask.h"
 #include "gpu/tasks/RenderTask.h"
 #include "gpu/tasks/ResourceTask.h"
@@ -82,6 +83,7 @@ class DrawingBuffer {
   std::vector<PlacementPtr<ResourceTask>> resourceTasks = {};
   std::vector<PlacementPtr<RenderTask>> renderTasks = {};
   std::vector<PlacementPtr<AtlasUploadTask>> atlasTasks = {};
+  TransientTargetAllocator transientTargets;
   std::vector<std::weak_ptr<Window>> windows = {};
 
   friend class DrawingManager;
@@ -19,6 +19,7 @@
 #include "DrawingManager.h"
 #include "ProxyProvider.h"
 #include "core/AtlasManager.h"
+#include "core/utils/TraceZone.h"
 #include "gpu/proxies/RenderTargetProxy.h"
 #include "gpu/proxies/TextureProxy.h"
 #include "gpu/tasks/GenerateMipmapsTask.h"
@@ -188,6 +189,7 @@ std::shared_ptr<DrawingBuffer> DrawingManager::flush() {
   if (currentBuffer == nullptr) {
     return nullptr;
   }
+  TRACE_ZONE("DrawingManager::flush");
   while (!compositors.empty()) {
     auto compositor = compositors.back();
     // The makeClosed() method may add more compositors to the list.
@@ -203,6 +205,9 @@ std::shared_ptr<DrawingBuffer> DrawingManager::flush() {
     return nullptr;
   }
 
+  // Find out which render targets are first used by this frame, so their textures can be shared
+  // once they are no longer needed while the frame is encoded.
+  currentBuffer->transientTargets.analyze(currentBuffer->renderTasks);
   auto drawingBuffer = currentBuffer;
   bufferPool.push_back(currentBuffer);
   currentBuffer = nullptr;
@@ -52,9 +52,12 @@ static constexpr uint16_t HairlineQuadIndexPattern[] = {
 };
 // clang-format on
 
-GlobalCache::GlobalCache(Context* context) : context(context) {
+GlobalCache::GlobalCache(Context* context)
+    : context(context), _programBinaryCache(std::make_unique<ProgramBinaryCache>(context)),
+      _programCompileQueue(std::make_unique<ProgramCompileQueue>(context)) {
   uniformBufferPool.resize(INITIAL_UNIFORM_PACKET_COUNT);
   activePacket = &uniformBufferPool[0];
+  _programBinaryCache->setProgramCache(context->device()->programCache());
 }
 
 std::shared_ptr<Program> GlobalCache::findProgram(const BytesKey& programKey) {
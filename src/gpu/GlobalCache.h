@@ -24,6 +24,8 @@
 #include "core/utils/SlidingWindowTracker.h"
 #include "gpu/AAType.h"
 #include "gpu/Program.h"
+#include "gpu/ProgramBinaryCache.h"
+#include "gpu/ProgramCompileQueue.h"
 #include "gpu/proxies/GPUBufferProxy.h"
 #include "gpu/proxies/TextureProxy.h"
 #include "tgfx/core/Color.h"
@@ -66,6 +68,21 @@ class GlobalCache {
    */
   void addProgram(const BytesKey& programKey, std::shared_ptr<Program> program);
 
+  /**
+   * Returns the cache that restores program binaries from the persistent ProgramCache set on the
+   * Device, so that programs missing from this cache can skip shader compilation.
+   */
+  ProgramBinaryCache* programBinaryCache() const {
+    return _programBinaryCache.get();
+  }
+
+  /**
+   * Returns the queue that compiles new programs asynchronously if enabled on the Context.
+   */
+  ProgramCompileQueue* programCompileQueue() const {
+    return _programCompileQueue.get();
+  }
+
   /**
    * Returns a texture that represents a gradient created from the specified colors and positions.
    */
@@ -131,6 +148,8 @@ class GlobalCache {
   Context* context = nullptr;
   std::list<Program*> programLRU = {};
   BytesKeyMap<std::shared_ptr<Program>> programMap = {};
+  std::unique_ptr<ProgramBinaryCache> _programBinaryCache = nullptr;
+  std::unique_ptr<ProgramCompileQueue> _programCompileQueue = nullptr;
   std::list<GradientTexture*> gradientLRU = {};
   BytesKeyMap<std::unique_ptr<GradientTexture>> gradientTextures = {};
   std::shared_ptr<GPUBufferProxy> aaQuadIndexBuffer = nullptr;
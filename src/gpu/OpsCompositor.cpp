@@ -17,7 +17,10 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "OpsCompositor.h"
+#include "core/AtlasManager.h"
+#include "core/AtlasShapeCache.h"
 #include "core/MeshBase.h"
+#include "core/PathRasterizer.h"
 #include "core/PathRef.h"
 #include "core/VertexMesh.h"
 #include "core/utils/ColorHelper.h"
@@ -26,6 +29,7 @@
 #include "core/utils/MathExtra.h"
 #include "core/utils/RectToRectMatrix.h"
 #include "core/utils/StrokeUtils.h"
+#include "core/utils/TraceZone.h"
 #include "core/utils/USE.h"
 #include "gpu/DrawingManager.h"
 #include "gpu/ProxyProvider.h"
@@ -42,6 +46,7 @@
 #include "processors/ColorSpaceXFormEffect.h"
 #include "processors/PorterDuffXferProcessor.h"
 #include "processors/XfermodeFragmentProcessor.h"
+#include "tgfx/core/RenderFlags.h"
 #include "tgfx/gpu/GPU.h"
 
 namespace tgfx {
@@ -199,6 +204,9 @@ void OpsCompositor::drawShape(std::shared_ptr<Shape> shape, const Matrix& matrix
     pendingStencilCoverColors.emplace_back(brush.color);
     return;
   }
+  if (drawShapeFromAtlas(shape, matrix, clip, brush)) {
+    return;
+  }
   if (canAppend(PendingOpType::Shape, clip, brush) && pendingShape &&
       pendingShape->getUniqueKey() == shape->getUniqueKey() &&
       MatrixOnlyDiffersInTranslation(pendingShapeMatrix, matrix)) {
@@ -229,6 +237,99 @@ void OpsCompositor::drawShape(std::shared_ptr<Shape> shape, const Matrix& matrix
   pendingShapeColors.emplace_back(brush.color);
 }
 
+// Shapes no larger than this in device space are always rasterized into coverage masks by
+// ShapeRasterizer, so they are packed into the shared A8 atlas instead of textures of their own.
+static constexpr float MaxAtlasShapeSize = 64.0f;
+bool OpsCompositor::drawShapeFromAtlas(const std::shared_ptr<Shape>& shape, const Matrix& matrix,
+                                       const ClipStack& clip, const Brush& brush) {
+  if ((renderFlags & RenderFlags::DisableCache) || shape->isInverseFillType() ||
+      matrix.hasPerspective()) {
+    return false;
+  }
+  auto shapeBounds = shape->getBounds();
+  auto deviceBounds = matrix.mapRect(shapeBounds);
+  if (deviceBounds.isEmpty() || deviceBounds.width() > MaxAtlasShapeSize ||
+      deviceBounds.height() > MaxAtlasShapeSize) {
+    return false;
+  }
+  if (!Rect::Intersects(deviceBounds, getClipBounds(clip))) {
+    return true;
+  }
+  // The mask is rasterized with only the subpixel part of the translation and drawn at the integer
+  // part, so the same cell serves every position with the same subpixel offset. The subpixel part
+  // is kept exact, so a shape renders the same as it does from a mask texture of its own.
+  auto translateX = matrix.getTranslateX();
+  auto translateY = matrix.getTranslateY();
+  auto integerX = std::floor(translateX);
+  auto integerY = std::floor(translateY);
+  auto rasterMatrix = matrix;
+  rasterMatrix.setTranslateX(translateX - integerX);
+  rasterMatrix.setTranslateY(translateY - integerY);
+  auto aaType = getAAType(brush);
+  auto maskBounds = rasterMatrix.mapRect(shapeBounds);
+  if (aaType != AAType::None) {
+    // Add a 1-pixel outset to preserve antialiasing results.
+    maskBounds.outset(1.0f, 1.0f);
+  }
+  maskBounds.roundOut();
+
+  static const auto AtlasShapeType = UniqueID::Next();
+  BytesKey bytesKey(8);
+  bytesKey.write(AtlasShapeType);
+  bytesKey.write(rasterMatrix.getScaleX());
+  bytesKey.write(rasterMatrix.getSkewX());
+  bytesKey.write(rasterMatrix.getTranslateX());
+  bytesKey.write(rasterMatrix.getSkewY());
+  bytesKey.write(rasterMatrix.getScaleY());
+  bytesKey.write(rasterMatrix.getTranslateY());
+  bytesKey.write(aaType == AAType::None ? 0 : 1);
+  auto key = UniqueKey::Append(shape->getUniqueKey(), bytesKey.data(), bytesKey.size());
+
+  auto atlasManager = context->atlasManager();
+  auto& textureProxies = atlasManager->getTextureProxies(MaskFormat::A8);
+  auto nextFlushToken = atlasManager->nextFlushToken();
+  auto atlasGlyph = context->atlasShapeCache()->findOrCreateGlyph(key);
+  auto& atlasLocator = atlasGlyph->atlasLocator;
+  if (!atlasManager->hasGlyph(MaskFormat::A8, atlasGlyph)) {
+    auto width = static_cast<int>(maskBounds.width());
+    auto height = static_cast<int>(maskBounds.height());
+    rasterMatrix.postTranslate(-maskBounds.left, -maskBounds.top);
+    auto maskShape = Shape::ApplyMatrix(shape, rasterMatrix);
+    auto rasterizer =
+        PathRasterizer::MakeFrom(width, height, std::move(maskShape), aaType != AAType::None);
+    if (rasterizer == nullptr) {
+      return false;
+    }
+    AtlasCell atlasCell = {MaskFormat::A8, static_cast<uint16_t>(width),
+                           static_cast<uint16_t>(height)};
+    if (!atlasManager->addCellToAtlas(atlasCell, nextFlushToken, &atlasLocator)) {
+      // The atlas is full, fall back to a mask texture of its own.
+      return false;
+    }
+    atlasGlyph->offset = Point::Make(maskBounds.left, maskBounds.top);
+    auto& location = atlasLocator.getLocation();
+    context->drawingManager()->addAtlasCellTask(textureProxies[atlasLocator.pageIndex()],
+                                                Point::Make(location.x(), location.y()),
+                                                std::move(rasterizer));
+  }
+  PlotUseUpdater plotUseUpdater;
+  atlasManager->setPlotUseToken(plotUseUpdater, atlasLocator.plotLocator(), MaskFormat::A8,
+                                nextFlushToken);
+  auto textureProxy = textureProxies[atlasLocator.pageIndex()];
+  if (textureProxy == nullptr) {
+    return false;
+  }
+  auto& location = atlasLocator.getLocation();
+  auto drawMatrix = Matrix::MakeTrans(integerX + atlasGlyph->offset.x - location.left,
+                                      integerY + atlasGlyph->offset.y - location.top);
+  // The atlas op samples the brush in device space, like the glyphs drawn from the same atlas.
+  SamplingOptions sampling(FilterMode::Nearest, MipmapMode::None);
+  fillTextAtlas(std::move(textureProxy), location, sampling, drawMatrix, clip,
+                brush.makeWithMatrix(matrix));
+  context->currentFrameStats()->atlasShapeDrawCount++;
+  return true;
+}
+
 bool OpsCompositor::shouldUseStencilCover(const Brush& brush, const Shape& shape) const {
 #ifndef TGFX_ENABLE_STENCIL_COVER_PATH
   // Compile-time master switch: shouldUseStencilCover returns false unconditionally when
@@ -383,6 +484,7 @@ void OpsCompositor::drawHairlineShape(std::shared_ptr<Shape> shape, const Matrix
 
 void OpsCompositor::discardAll() {
   drawOps.clear();
+  deferredBatches.clear();
   clearColor.reset();
   if (pendingType != PendingOpType::Unknown) {
     resetPendingOps();
@@ -403,6 +505,7 @@ void OpsCompositor::resetPendingOps(PendingOpType type, ClipStack clip, Brush br
   pendingRRects.clear();
   pendingStrokes.clear();
   pendingAtlasTexture = nullptr;
+  pendingDistanceField = false;
   pendingShape = nullptr;
   pendingShapeMatrix = {};
   pendingShapeOffsets.clear();
@@ -479,19 +582,195 @@ void OpsCompositor::flushPendingOps(PendingOpType type, ClipStack clip, Brush br
       pendingType = type;
       pendingClip = std::move(clip);
       pendingBrush = std::move(brush);
+    } else {
+      flushDeferredBatches();
     }
     return;
   }
+  TRACE_ZONE("OpsCompositor::flushPendingOps");
+  // Every pending draw except the first is batched into the same DrawOp. Stencil-cover paths
+  // still emit one DrawOp per shape, so they are not counted.
+  auto pendingDrawCount = std::max(pendingRects.size(), pendingRRects.size());
+  pendingDrawCount = std::max(pendingDrawCount, pendingShapeOffsets.size());
+  if (pendingDrawCount > 1) {
+    context->currentFrameStats()->mergedDrawCount += pendingDrawCount - 1;
+  }
   PendingOpsAutoReset autoReset(this, type, std::move(clip), std::move(brush));
   // Shape is handled separately with its own bounds computation.
   if (pendingType == PendingOpType::Shape) {
+    flushDeferredBatches();
     flushPendingShapeOps();
     return;
   }
   if (pendingType == PendingOpType::StencilCoverPath) {
+    flushDeferredBatches();
     flushPendingStencilCoverOps();
     return;
   }
+  auto batch = takePendingBatch();
+  if (canDeferBatch(batch)) {
+    deferBatch(std::move(batch));
+    if (type == PendingOpType::Unknown) {
+      // The next op is not batched, so it must not overtake the deferred batches.
+      flushDeferredBatches();
+    }
+    return;
+  }
+  flushDeferredBatches();
+  flushBatch(batch);
+}
+
+PendingBatch OpsCompositor::takePendingBatch() {
+  PendingBatch batch = {};
+  batch.type = pendingType;
+  batch.clip = pendingClip;
+  batch.brush = pendingBrush;
+  batch.image = std::move(pendingImage);
+  batch.sampling = pendingSampling;
+  batch.constraint = pendingConstraint;
+  batch.atlasTexture = std::move(pendingAtlasTexture);
+  batch.distanceField = pendingDistanceField;
+  batch.hasRectToRectDraw = hasRectToRectDraw;
+  batch.rects = std::move(pendingRects);
+  batch.uvRects = std::move(pendingUVRects);
+  batch.subsetRects = std::move(pendingSubsetRects);
+  batch.rRects = std::move(pendingRRects);
+  batch.strokes = std::move(pendingStrokes);
+  return batch;
+}
+
+bool OpsCompositor::canDeferBatch(const PendingBatch& batch) const {
+  if (context->reorderWindow() == 0 || batch.type == PendingOpType::Unknown) {
+    return false;
+  }
+  // Draws that read the destination copy it at flush time, so they must keep their position.
+  if (BlendModeNeedDstTexture(batch.brush.blendMode, true)) {
+    return false;
+  }
+  // A single opaque rect covering the render target turns into a clear and drops every op before
+  // it, which only works when it is flushed in order.
+  if (batch.type == PendingOpType::Rect && batch.rects.size() == 1 && batch.strokes.empty()) {
+    auto& record = batch.rects.front();
+    if (isClearRect(record->rect, record->viewMatrix, batch.clip, batch.brush)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool OpsCompositor::CanMergeBatches(const PendingBatch& a, const PendingBatch& b) {
+  if (a.type != b.type || !a.clip.isSame(b.clip) || !CompareBrush(a.brush, b.brush)) {
+    return false;
+  }
+  switch (a.type) {
+    case PendingOpType::Image:
+      if (a.image != b.image || a.sampling != b.sampling || a.constraint != b.constraint) {
+        return false;
+      }
+      return a.rects.size() + b.rects.size() <= RectDrawOp::MaxNumRects;
+    case PendingOpType::Atlas:
+      if (a.atlasTexture != b.atlasTexture || a.sampling != b.sampling ||
+          a.distanceField != b.distanceField) {
+        return false;
+      }
+      return a.rects.size() + b.rects.size() <= RectDrawOp::MaxNumRects;
+    case PendingOpType::Rect:
+      break;
+    case PendingOpType::RRect:
+      if (a.rRects.front()->rRect.isComplex() != b.rRects.front()->rRect.isComplex()) {
+        return false;
+      }
+      break;
+    default:
+      return false;
+  }
+  // Stroked and filled records use different vertex layouts, and strokes must share the join.
+  if (a.strokes.empty() != b.strokes.empty()) {
+    return false;
+  }
+  if (!a.strokes.empty() && a.strokes.front()->join != b.strokes.front()->join) {
+    return false;
+  }
+  if (a.type == PendingOpType::Rect) {
+    return a.rects.size() + b.rects.size() <= RectDrawOp::MaxNumRects;
+  }
+  return a.rRects.size() + b.rRects.size() <= RRectDrawOp::MaxNumRRects;
+}
+
+static Rect GetRecordBounds(const Rect& rect, const Matrix& viewMatrix, const Stroke* stroke) {
+  auto bounds = rect;
+  if (stroke != nullptr) {
+    ApplyStrokeToBounds(*stroke, &bounds);
+  }
+  bounds = viewMatrix.mapRect(bounds);
+  // Leave room for the antialiasing ramp around the edges.
+  bounds.outset(1.0f, 1.0f);
+  return bounds;
+}
+
+void OpsCompositor::deferBatch(PendingBatch batch) {
+  batch.deviceBounds = Rect::MakeEmpty();
+  auto strokeCount = batch.strokes.size();
+  for (size_t i = 0; i < batch.rects.size(); i++) {
+    auto stroke = i < strokeCount ? batch.strokes[i].get() : nullptr;
+    auto& record = batch.rects[i];
+    batch.deviceBounds.join(GetRecordBounds(record->rect, record->viewMatrix, stroke));
+  }
+  for (size_t i = 0; i < batch.rRects.size(); i++) {
+    auto stroke = i < strokeCount ? batch.strokes[i].get() : nullptr;
+    auto& record = batch.rRects[i];
+    batch.deviceBounds.join(GetRecordBounds(record->rRect.rect(), record->viewMatrix, stroke));
+  }
+  if (batch.clip.state() != ClipState::WideOpen &&
+      !batch.deviceBounds.intersect(batch.clip.bounds())) {
+    // The batch is clipped out entirely.
+    return;
+  }
+  // Walk back from the newest deferred batch. The new batch may join a compatible batch as long as
+  // it does not overlap any batch it would be moved in front of.
+  auto window = std::min(context->reorderWindow(), deferredBatches.size());
+  for (size_t i = 0; i < window; i++) {
+    auto& target = deferredBatches[deferredBatches.size() - 1 - i];
+    if (CanMergeBatches(target, batch)) {
+      // The draws inside the batch were counted when it was flushed, so joining the target only
+      // saves the one DrawOp the batch would have created on its own.
+      auto stats = context->currentFrameStats();
+      stats->mergedDrawCount++;
+      if (i > 0) {
+        stats->reorderedDrawCount++;
+      }
+      std::move(batch.rects.begin(), batch.rects.end(), std::back_inserter(target.rects));
+      std::move(batch.rRects.begin(), batch.rRects.end(), std::back_inserter(target.rRects));
+      std::move(batch.strokes.begin(), batch.strokes.end(), std::back_inserter(target.strokes));
+      std::move(batch.subsetRects.begin(), batch.subsetRects.end(),
+                std::back_inserter(target.subsetRects));
+      // The uv rects are required by the flush as soon as either batch draws rect to rect.
+      std::move(batch.uvRects.begin(), batch.uvRects.end(), std::back_inserter(target.uvRects));
+      target.hasRectToRectDraw = target.hasRectToRectDraw || batch.hasRectToRectDraw;
+      target.deviceBounds.join(batch.deviceBounds);
+      return;
+    }
+    if (Rect::Intersects(target.deviceBounds, batch.deviceBounds)) {
+      break;
+    }
+  }
+  deferredBatches.push_back(std::move(batch));
+  while (deferredBatches.size() > context->reorderWindow()) {
+    auto oldest = std::move(deferredBatches.front());
+    deferredBatches.pop_front();
+    flushBatch(oldest);
+  }
+}
+
+void OpsCompositor::flushDeferredBatches() {
+  while (!deferredBatches.empty()) {
+    auto oldest = std::move(deferredBatches.front());
+    deferredBatches.pop_front();
+    flushBatch(oldest);
+  }
+}
+
+void OpsCompositor::flushBatch(PendingBatch& batch) {
   PlacementPtr<DrawOp> drawOp = nullptr;
   std::optional<Rect> localBounds = std::nullopt;
   std::optional<Rect> deviceBounds = std::nullopt;
@@ -500,14 +779,14 @@ void OpsCompositor::flushPendingOps(PendingOpType type, ClipStack clip, Brush br
   // deviceBounds needs to be computed for DstTexture creation. We assume coverage exists unless
   // clip is empty, since some ops (e.g., AtlasTextOp) always have coverage regardless of clip.
   // Underestimating causes draws to be skipped on GPUs without frameBufferFetch (e.g., SwiftShader).
-  bool hasCoverage = pendingBrush.maskFilter != nullptr || pendingClip.state() != ClipState::Empty;
-  bool hasImageFill = pendingType == PendingOpType::Image;
-  auto [needLocalBounds, needDeviceBounds] =
-      needComputeBounds(pendingBrush, hasCoverage, hasImageFill);
-  auto aaType = getAAType(pendingBrush);
+  bool hasCoverage = batch.brush.maskFilter != nullptr || batch.clip.state() != ClipState::Empty;
+  bool hasImageFill = batch.type == PendingOpType::Image;
+  auto [needLocalBounds, needDeviceBounds] = needComputeBounds(
+      batch.brush, hasCoverage, hasImageFill, batch.type == PendingOpType::RRect);
+  auto aaType = getAAType(batch.brush);
   Rect clipBounds = {};
   if (needLocalBounds || needDeviceBounds) {
-    clipBounds = getClipBounds(pendingClip);
+    clipBounds = getClipBounds(batch.clip);
   }
   if (needLocalBounds) {
     localBounds = Rect::MakeEmpty();
@@ -515,9 +794,9 @@ void OpsCompositor::flushPendingOps(PendingOpType type, ClipStack clip, Brush br
   }
 
   if (needLocalBounds || needDeviceBounds) {
-    if (pendingType == PendingOpType::RRect) {
+    if (batch.type == PendingOpType::RRect) {
       deviceBounds = Rect::MakeEmpty();
-      for (auto& record : pendingRRects) {
+      for (auto& record : batch.rRects) {
         auto rect = record->viewMatrix.mapRect(record->rRect.rect());
         deviceBounds->join(rect);
         drawScale = std::max(*drawScale, record->viewMatrix.getMaxScale());
@@ -531,13 +810,13 @@ void OpsCompositor::flushPendingOps(PendingOpType type, ClipStack clip, Brush br
       }
     } else {
       if (needLocalBounds) {
-        auto rectCount = pendingRects.size();
+        auto rectCount = batch.rects.size();
         for (size_t i = 0; i < rectCount; i++) {
-          auto& record = pendingRects[i];
+          auto& record = batch.rects[i];
           auto viewMatrix = record->viewMatrix;
           auto rect = &record->rect;
-          if (hasRectToRectDraw) {
-            auto& uvRect = *pendingUVRects[i];
+          if (batch.hasRectToRectDraw) {
+            auto& uvRect = *batch.uvRects[i];
             viewMatrix.preConcat(MakeRectToRectMatrix(uvRect, record->rect));
             rect = &uvRect;
           }
@@ -547,7 +826,7 @@ void OpsCompositor::flushPendingOps(PendingOpType type, ClipStack clip, Brush br
       }
       if (needDeviceBounds) {
         deviceBounds = Rect::MakeEmpty();
-        for (auto& record : pendingRects) {
+        for (auto& record : batch.rects) {
           auto rect = record->viewMatrix.mapRect(record->rect);
           deviceBounds->join(rect);
         }
@@ -561,69 +840,69 @@ void OpsCompositor::flushPendingOps(PendingOpType type, ClipStack clip, Brush br
     }
   }
 
-  switch (pendingType) {
+  switch (batch.type) {
     case PendingOpType::Rect:
-      if (pendingRects.size() == 1 && pendingStrokes.empty()) {
-        auto& paint = pendingRects.front();
-        if (drawAsClear(paint->rect, paint->viewMatrix, pendingClip, pendingBrush)) {
+      if (batch.rects.size() == 1 && batch.strokes.empty()) {
+        auto& paint = batch.rects.front();
+        if (drawAsClear(paint->rect, paint->viewMatrix, batch.clip, batch.brush)) {
           return;
         }
       }
     // fallthrough
     case PendingOpType::Image: {
       auto subsetMode = UVSubsetMode::None;
-      if (pendingConstraint == SrcRectConstraint::Strict && pendingImage) {
-        subsetMode = pendingSampling.magFilterMode == FilterMode::Linear ||
-                             pendingSampling.minFilterMode == FilterMode::Linear
+      if (batch.constraint == SrcRectConstraint::Strict && batch.image) {
+        subsetMode = batch.sampling.magFilterMode == FilterMode::Linear ||
+                             batch.sampling.minFilterMode == FilterMode::Linear
                          ? UVSubsetMode::SubsetOnly
                          : UVSubsetMode::RoundOutAndSubset;
       }
       bool needUVCoord =
-          needLocalBounds && (hasRectToRectDraw || HasDifferentViewMatrix(pendingRects));
+          needLocalBounds && (batch.hasRectToRectDraw || HasDifferentViewMatrix(batch.rects));
       auto uvRects =
-          hasRectToRectDraw ? std::move(pendingUVRects) : std::vector<PlacementPtr<Rect>>();
-      // pendingSubsetRects is populated only when constraint == Strict (per fillImageRect).
-      // When subsetMode != None we must provide subset rects of the same size as pendingRects.
-      auto subsetRects = std::move(pendingSubsetRects);
+          batch.hasRectToRectDraw ? std::move(batch.uvRects) : std::vector<PlacementPtr<Rect>>();
+      // subsetRects is populated only when constraint == Strict (per fillImageRect). When
+      // subsetMode != None we must provide subset rects of the same size as rects.
+      auto subsetRects = std::move(batch.subsetRects);
       auto provider = RectsVertexProvider::MakeFrom(
-          drawingAllocator(), std::move(pendingRects), std::move(uvRects), std::move(subsetRects),
-          aaType, needUVCoord, subsetMode, std::move(pendingStrokes), dstColorSpace);
+          drawingAllocator(), std::move(batch.rects), std::move(uvRects), std::move(subsetRects),
+          aaType, needUVCoord, subsetMode, std::move(batch.strokes), dstColorSpace);
       drawOp = RectDrawOp::Make(context, std::move(provider), renderFlags);
     } break;
     case PendingOpType::RRect: {
       auto provider =
-          RRectsVertexProvider::MakeFrom(drawingAllocator(), std::move(pendingRRects), aaType,
-                                         std::move(pendingStrokes), dstColorSpace);
+          RRectsVertexProvider::MakeFrom(drawingAllocator(), std::move(batch.rRects), aaType,
+                                         std::move(batch.strokes), dstColorSpace);
       drawOp = RRectDrawOp::Make(context, std::move(provider), renderFlags);
     } break;
     case PendingOpType::Atlas: {
       auto provider =
-          RectsVertexProvider::MakeFrom(drawingAllocator(), std::move(pendingRects), {}, {},
+          RectsVertexProvider::MakeFrom(drawingAllocator(), std::move(batch.rects), {}, {},
                                         AAType::None, true, UVSubsetMode::None, {}, dstColorSpace);
       drawOp = AtlasTextOp::Make(context, std::move(provider), renderFlags,
-                                 std::move(pendingAtlasTexture), pendingSampling);
+                                 std::move(batch.atlasTexture), batch.sampling,
+                                 batch.distanceField);
     } break;
     default:
       break;
   }
-  if (drawOp != nullptr && pendingType == PendingOpType::Image) {
+  if (drawOp != nullptr && batch.type == PendingOpType::Image) {
     FPArgs args = {context, renderFlags, localBounds.value_or(Rect::MakeEmpty()),
                    drawScale.value_or(1.0f)};
-    auto processor =
-        FragmentProcessor::Make(pendingImage, args, pendingSampling, pendingConstraint);
+    auto processor = FragmentProcessor::Make(batch.image, args, batch.sampling, batch.constraint);
     if (processor == nullptr) {
       return;
     }
     drawOp->addColorFP(std::move(processor));
-    if (!pendingImage->isAlphaOnly() &&
-        NeedConvertColorSpace(pendingImage->colorSpace(), dstColorSpace)) {
+    if (!batch.image->isAlphaOnly() &&
+        NeedConvertColorSpace(batch.image->colorSpace(), dstColorSpace)) {
       auto xformEffect = ColorSpaceXformEffect::Make(
-          context->drawingAllocator(), pendingImage->colorSpace().get(), AlphaType::Premultiplied,
+          context->drawingAllocator(), batch.image->colorSpace().get(), AlphaType::Premultiplied,
           dstColorSpace.get(), AlphaType::Premultiplied);
       drawOp->addColorFP(std::move(xformEffect));
     }
   }
-  addDrawOp(std::move(drawOp), pendingClip, pendingBrush, localBounds, deviceBounds,
+  addDrawOp(std::move(drawOp), batch.clip, batch.brush, localBounds, deviceBounds,
             drawScale.value_or(1.0f));
 }
 
@@ -784,8 +1063,8 @@ static bool HasColorOnly(const Brush& brush) {
   return !brush.shader && !brush.maskFilter && !brush.colorFilter;
 }
 
-bool OpsCompositor::drawAsClear(const Rect& rect, const Matrix& matrix, const ClipStack& clip,
-                                const Brush& brush) {
+bool OpsCompositor::isClearRect(const Rect& rect, const Matrix& matrix, const ClipStack& clip,
+                                const Brush& brush) const {
   if (!HasColorOnly(brush) || !brush.isOpaque() || !matrix.rectStaysRect()) {
     return false;
   }
@@ -808,11 +1087,17 @@ bool OpsCompositor::drawAsClear(const Rect& rect, const Matrix& matrix, const Cl
     return false;
   }
   bounds.round();
-  if (bounds != deviceBounds) {
+  return bounds == deviceBounds;
+}
+
+bool OpsCompositor::drawAsClear(const Rect& rect, const Matrix& matrix, const ClipStack& clip,
+                                const Brush& brush) {
+  if (!isClearRect(rect, matrix, clip, brush)) {
     return false;
   }
   // discard all previous ops since the clear rect covers the entire render target.
   drawOps.clear();
+  deferredBatches.clear();
   auto format = renderTarget->format();
   auto writeSwizzle = Swizzle::ForWrite(format);
   auto dstColor = ToPMColor(brush.color, dstColorSpace);
@@ -846,7 +1131,7 @@ AAType OpsCompositor::getAAType(bool antiAlias) const {
 }
 
 std::pair<bool, bool> OpsCompositor::needComputeBounds(const Brush& brush, bool hasCoverage,
-                                                       bool hasImageFill) {
+                                                       bool hasImageFill, bool isRRect) {
   bool needLocalBounds = hasImageFill || brush.shader != nullptr || brush.maskFilter != nullptr;
   bool needDeviceBounds = false;
   if (BlendModeNeedDstTexture(brush.blendMode, hasCoverage)) {
@@ -858,7 +1143,7 @@ std::pair<bool, bool> OpsCompositor::needComputeBounds(const Brush& brush, bool
       needDeviceBounds = true;
     }
   }
-  if (pendingType == PendingOpType::RRect && (needDeviceBounds || needLocalBounds)) {
+  if (isRRect && (needDeviceBounds || needLocalBounds)) {
     // When either localBounds or deviceBounds needs to be computed for RRect, both should be set to
     // true, since localBounds and deviceBounds are computed together in that case.
     needLocalBounds = true;
@@ -1008,30 +1293,161 @@ std::pair<bool, PlacementPtr<FragmentProcessor>> OpsCompositor::tryApplyAnalytic
   return {true, std::move(elementFP)};
 }
 
+// Clip masks whose clip content fits in this size are rasterized over the content bounds instead of
+// the clip bounds of the current render target, so every tile or render target that uses the same
+// clip can share one mask.
+static constexpr float MaxSharedClipMaskSize = 1024.0f;
+
+// Paths with more verbs than this are keyed by their PathRef identity instead of their content to
+// keep the key building cheap.
+static constexpr int MaxKeyedClipPathVerbs = 256;
+
+static Rect GetClipMaskBounds(const std::vector<const ClipElement*>& elements,
+                              const Rect& clipBound) {
+  auto maskBounds = elements.front()->outerBounds();
+  for (size_t i = 1; i < elements.size(); ++i) {
+    if (!maskBounds.intersect(elements[i]->outerBounds())) {
+      return clipBound;
+    }
+  }
+  maskBounds.roundOut();
+  // Written as a negated comparison so that NaN sizes from unbounded inverse fills also fall back.
+  if (!(maskBounds.width() <= MaxSharedClipMaskSize &&
+        maskBounds.height() <= MaxSharedClipMaskSize) ||
+      !maskBounds.contains(clipBound)) {
+    return clipBound;
+  }
+  return maskBounds;
+}
+
+static void WriteClipPathKey(BytesKey* bytesKey, const Path& path) {
+  if (path.countVerbs() > MaxKeyedClipPathVerbs) {
+    bytesKey->write(static_cast<uint32_t>(0));
+    bytesKey->write(PathRef::GetUniqueKey(path).domainID());
+    return;
+  }
+  bytesKey->write(static_cast<uint32_t>(1));
+  bytesKey->write(static_cast<uint32_t>(path.getFillType()));
+  for (const auto& segment : path) {
+    bytesKey->write(static_cast<uint32_t>(segment.verb));
+    // Segments after the first Move start at the end point of the previous one, so only the new
+    // points are written.
+    size_t start = segment.verb == PathVerb::Move ? 0 : 1;
+    size_t end = start;
+    switch (segment.verb) {
+      case PathVerb::Move:
+        end = 1;
+        break;
+      case PathVerb::Line:
+        end = 2;
+        break;
+      case PathVerb::Quad:
+        end = 3;
+        break;
+      case PathVerb::Conic:
+        end = 3;
+        bytesKey->write(segment.conicWeight);
+        break;
+      case PathVerb::Cubic:
+        end = 4;
+        break;
+      default:
+        break;
+    }
+    for (size_t i = start; i < end; ++i) {
+      bytesKey->write(segment.points[i].x);
+      bytesKey->write(segment.points[i].y);
+    }
+  }
+}
+
+// Builds a key from the content of the clip elements relative to the top-left corner of the mask,
+// so the same clip drawn at an integer offset (in a neighboring tile, in another render target or
+// in a later frame) maps to the same mask.
+static UniqueKey MakeClipMaskKey(const std::vector<const ClipElement*>& elements,
+                                 const Rect& maskBounds) {
+  static const auto ClipMaskKey = UniqueKey::Make();
+  static const auto ClipMaskType = UniqueID::Next();
+  BytesKey bytesKey(3 + elements.size() * 20);
+  bytesKey.write(ClipMaskType);
+  bytesKey.write(FloatSaturateToInt(maskBounds.width()));
+  bytesKey.write(FloatSaturateToInt(maskBounds.height()));
+  for (auto& element : elements) {
+    auto& shape = element->shape();
+    auto matrix = element->matrix();
+    matrix.postTranslate(-maskBounds.left, -maskBounds.top);
+    bytesKey.write((static_cast<uint32_t>(shape.type()) << 1) | (element->antiAlias() ? 1u : 0u));
+    float values[9] = {};
+    matrix.get9(values);
+    for (auto value : values) {
+      bytesKey.write(value);
+    }
+    switch (shape.type()) {
+      case GeometryShape::Type::Rect: {
+        auto& rect = shape.rect();
+        bytesKey.write(rect.left);
+        bytesKey.write(rect.top);
+        bytesKey.write(rect.right);
+        bytesKey.write(rect.bottom);
+        break;
+      }
+      case GeometryShape::Type::RRect: {
+        auto& rRect = shape.rRect();
+        bytesKey.write(rRect.rect().left);
+        bytesKey.write(rRect.rect().top);
+        bytesKey.write(rRect.rect().right);
+        bytesKey.write(rRect.rect().bottom);
+        for (auto& radius : rRect.radii()) {
+          bytesKey.write(radius.x);
+          bytesKey.write(radius.y);
+        }
+        break;
+      }
+      case GeometryShape::Type::Path:
+        WriteClipPathKey(&bytesKey, shape.path());
+        break;
+      default:
+        break;
+    }
+  }
+  return UniqueKey::Append(ClipMaskKey, bytesKey.data(), bytesKey.size());
+}
+
 PlacementPtr<FragmentProcessor> OpsCompositor::getClipMaskFP(
     const std::vector<const ClipElement*>& elements, uint32_t uniqueID, const Rect& clipBound,
     PlacementPtr<FragmentProcessor> inputFP) {
   // OpsCompositor is bound to a single RenderTarget, so using uniqueID alone as the cache key
   // (without clipBound) is safe.
   if (uniqueID == cachedClipID && clipTexture) {
-    return makeMaskFP(clipTexture, clipBound, std::move(inputFP));
+    return makeMaskFP(clipTexture, clipTextureBounds, std::move(inputFP));
   }
-  clipTexture = makeClipTexture(elements, clipBound);
-  if (clipTexture == nullptr) {
-    DEBUG_ASSERT(false);
-    return nullptr;
+  auto maskBounds = GetClipMaskBounds(elements, clipBound);
+  auto maskKey = MakeClipMaskKey(elements, maskBounds);
+  clipTexture = proxyProvider()->findOrWrapTextureProxy(maskKey);
+  if (clipTexture != nullptr) {
+    context->currentFrameStats()->clipMaskCacheHits++;
+  } else {
+    clipTexture = makeClipTexture(elements, maskBounds, maskKey);
+    if (clipTexture == nullptr) {
+      DEBUG_ASSERT(false);
+      return nullptr;
+    }
+    context->currentFrameStats()->clipMaskCount++;
   }
   cachedClipID = uniqueID;
-  return makeMaskFP(clipTexture, clipBound, std::move(inputFP));
+  clipTextureBounds = maskBounds;
+  return makeMaskFP(clipTexture, clipTextureBounds, std::move(inputFP));
 }
 
 std::shared_ptr<TextureProxy> OpsCompositor::makeClipTexture(
-    const std::vector<const ClipElement*>& elements, const Rect& bounds) const {
+    const std::vector<const ClipElement*>& elements, const Rect& bounds,
+    const UniqueKey& uniqueKey) const {
   const auto width = FloatSaturateToInt(bounds.width());
   const auto height = FloatSaturateToInt(bounds.height());
   const auto rasterizeMatrix = Matrix::MakeTrans(-bounds.left, -bounds.top);
-  auto clipRenderTarget = RenderTargetProxy::Make(context, width, height, true, 1, false,
-                                                  ImageOrigin::TopLeft, BackingFit::Approx);
+  auto clipRenderTarget = proxyProvider()->createRenderTargetProxy(
+      uniqueKey, width, height, PixelFormat::ALPHA_8, 1, false, ImageOrigin::TopLeft,
+      BackingFit::Approx, renderFlags);
   if (clipRenderTarget == nullptr) {
     DEBUG_ASSERT(false);
     return nullptr;
@@ -1202,18 +1618,20 @@ void OpsCompositor::addDrawOp(PlacementPtr<DrawOp> op, const ClipStack& clip, co
     op->setXferProcessor(std::move(xferProcessor));
   }
   drawOps.emplace_back(std::move(op));
+  context->currentFrameStats()->drawOpCount++;
 }
 
 void OpsCompositor::fillTextAtlas(std::shared_ptr<TextureProxy> textureProxy, const Rect& rect,
                                   const SamplingOptions& sampling, const Matrix& matrix,
-                                  const ClipStack& clip, const Brush& brush) {
+                                  const ClipStack& clip, const Brush& brush, bool distanceField) {
   DEBUG_ASSERT(textureProxy != nullptr);
   DEBUG_ASSERT(!rect.isEmpty());
   if (!canAppend(PendingOpType::Atlas, clip, brush) || pendingAtlasTexture != textureProxy ||
-      pendingSampling != sampling) {
+      pendingSampling != sampling || pendingDistanceField != distanceField) {
     flushPendingOps(PendingOpType::Atlas, clip, brush);
     pendingAtlasTexture = std::move(textureProxy);
     pendingSampling = sampling;
+    pendingDistanceField = distanceField;
   }
   auto record = drawingAllocator()->make<RectRecord>(rect, matrix, brush.color);
   pendingRects.emplace_back(std::move(record));
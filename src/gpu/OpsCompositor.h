@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <deque>
 #include "core/ClipStack.h"
 #include "gpu/ops/RRectDrawOp.h"
 #include "gpu/ops/RectDrawOp.h"
@@ -60,6 +61,29 @@ enum class PendingOpType {
   StencilCoverPath,
 };
 
+/**
+ * PendingBatch holds the records of consecutive rect-like draws (rects, rrects, images and atlas
+ * glyphs) that share the same clip, brush and pipeline state and will become a single DrawOp.
+ */
+struct PendingBatch {
+  PendingOpType type = PendingOpType::Unknown;
+  ClipStack clip = {};
+  Brush brush = {};
+  std::shared_ptr<Image> image = nullptr;
+  SamplingOptions sampling = {};
+  SrcRectConstraint constraint = SrcRectConstraint::Fast;
+  std::shared_ptr<TextureProxy> atlasTexture = nullptr;
+  bool distanceField = false;
+  bool hasRectToRectDraw = false;
+  std::vector<PlacementPtr<RectRecord>> rects = {};
+  std::vector<PlacementPtr<Rect>> uvRects = {};
+  std::vector<PlacementPtr<Rect>> subsetRects = {};
+  std::vector<PlacementPtr<RRectRecord>> rRects = {};
+  std::vector<PlacementPtr<Stroke>> strokes = {};
+  // A conservative device-space bounds of all the records, used for the overlap tests.
+  Rect deviceBounds = {};
+};
+
 /**
  * OpsCompositor is a helper class for composing a series of draw operations into a single render
  * task.
@@ -118,11 +142,12 @@ class OpsCompositor {
                 const Brush& brush);
 
   /**
-   * Fills the given rect with the given atlas textureProxy, sampling options, state and fill.
+   * Fills the given rect with the given atlas textureProxy, sampling options, state and fill. If
+   * distanceField is true, the atlas cell holds a signed distance field instead of a coverage mask.
    */
   void fillTextAtlas(std::shared_ptr<TextureProxy> textureProxy, const Rect& rect,
                      const SamplingOptions& sampling, const Matrix& matrix, const ClipStack& clip,
-                     const Brush& brush);
+                     const Brush& brush, bool distanceField = false);
 
   /**
    * Discard all pending operations.
@@ -149,6 +174,7 @@ class OpsCompositor {
   uint32_t renderFlags = 0;
   uint32_t cachedClipID = 0;
   std::shared_ptr<TextureProxy> clipTexture = nullptr;
+  Rect clipTextureBounds = {};
   bool hasRectToRectDraw = false;
   PendingOpType pendingType = PendingOpType::Unknown;
   ClipStack pendingClip = {};
@@ -157,6 +183,7 @@ class OpsCompositor {
   SrcRectConstraint pendingConstraint = SrcRectConstraint::Fast;
   SamplingOptions pendingSampling = {};
   std::shared_ptr<TextureProxy> pendingAtlasTexture = nullptr;
+  bool pendingDistanceField = false;
   std::vector<PlacementPtr<RectRecord>> pendingRects = {};
   std::vector<PlacementPtr<Rect>> pendingUVRects = {};
   std::vector<PlacementPtr<Rect>> pendingSubsetRects = {};
@@ -176,11 +203,15 @@ class OpsCompositor {
   std::vector<std::shared_ptr<Shape>> pendingStencilCoverShapes = {};
   std::vector<Matrix> pendingStencilCoverMatrices = {};
   std::vector<Color> pendingStencilCoverColors = {};
+  // Batches that are already complete but not yet turned into DrawOps, oldest first. A later batch
+  // can still be merged into one of them as long as no batch in between overlaps it.
+  std::deque<PendingBatch> deferredBatches = {};
   std::optional<PMColor> clearColor = std::nullopt;
   std::vector<PlacementPtr<DrawOp>> drawOps = {};
   std::shared_ptr<ColorSpace> dstColorSpace = nullptr;
 
   static bool CompareBrush(const Brush& a, const Brush& b);
+  static bool CanMergeBatches(const PendingBatch& a, const PendingBatch& b);
 
   BlockAllocator* drawingAllocator() const {
     return context->drawingAllocator();
@@ -190,20 +221,29 @@ class OpsCompositor {
     return context->proxyProvider();
   }
 
+  bool isClearRect(const Rect& rect, const Matrix& matrix, const ClipStack& clip,
+                   const Brush& brush) const;
   bool drawAsClear(const Rect& rect, const Matrix& matrix, const ClipStack& clip,
                    const Brush& brush);
   bool canAppend(PendingOpType type, const ClipStack& clip, const Brush& brush) const;
   void flushPendingOps(PendingOpType currentType = PendingOpType::Unknown,
                        ClipStack currentClip = {}, Brush currentBrush = {});
+  PendingBatch takePendingBatch();
+  bool canDeferBatch(const PendingBatch& batch) const;
+  void deferBatch(PendingBatch batch);
+  void flushDeferredBatches();
+  void flushBatch(PendingBatch& batch);
   void flushPendingShapeOps();
   void flushPendingStencilCoverOps();
   bool shouldUseStencilCover(const Brush& brush, const Shape& shape) const;
+  bool drawShapeFromAtlas(const std::shared_ptr<Shape>& shape, const Matrix& matrix,
+                          const ClipStack& clip, const Brush& brush);
   void resetPendingOps(PendingOpType currentType = PendingOpType::Unknown,
                        ClipStack currentClip = {}, Brush currentBrush = {});
   AAType getAAType(const Brush& brush) const;
   AAType getAAType(bool antiAlias) const;
   std::pair<bool, bool> needComputeBounds(const Brush& brush, bool hasCoverage,
-                                          bool hasImageFill = false);
+                                          bool hasImageFill = false, bool isRRect = false);
   Rect getClipBounds(const ClipStack& clip) const;
   AppliedClip applyClip(const ClipStack& clipStack);
   std::pair<bool, PlacementPtr<FragmentProcessor>> tryApplyAnalyticFP(
@@ -212,7 +252,8 @@ class OpsCompositor {
                                                 uint32_t uniqueID, const Rect& clipBound,
                                                 PlacementPtr<FragmentProcessor> inputFP);
   std::shared_ptr<TextureProxy> makeClipTexture(const std::vector<const ClipElement*>& elements,
-                                                const Rect& bounds) const;
+                                                const Rect& bounds,
+                                                const UniqueKey& uniqueKey) const;
   PlacementPtr<FragmentProcessor> makeMaskFP(std::shared_ptr<TextureProxy> maskTexture,
                                              const Rect& bounds,
                                              PlacementPtr<FragmentProcessor> inputFP) const;
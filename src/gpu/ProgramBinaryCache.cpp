@@ -0,0 +1,203 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ProgramBinaryCache.h"
+#include <cstring>
+#include "core/utils/MD5.h"
+#include "tgfx/core/Buffer.h"
+#include "tgfx/core/Clock.h"
+#include "tgfx/gpu/Context.h"
+#include "tgfx/gpu/GPU.h"
+
+namespace tgfx {
+// Bump this version whenever the layout of the stored entries changes.
+static constexpr uint32_t PROGRAM_BINARY_VERSION = 1;
+
+struct ProgramBinaryHeader {
+  uint32_t version = PROGRAM_BINARY_VERSION;
+  uint32_t reserved = 0;
+  int64_t compileTime = 0;
+};
+
+static std::string ToHexString(const MD5::Digest& digest) {
+  static constexpr char HexDigits[] = "0123456789abcdef";
+  std::string result = {};
+  result.reserve(digest.size() * 2);
+  for (auto byte : digest) {
+    result.push_back(HexDigits[byte >> 4]);
+    result.push_back(HexDigits[byte & 0xF]);
+  }
+  return result;
+}
+
+ProgramBinaryCache::ProgramBinaryCache(Context* context) : context(context) {
+  auto info = context->gpu()->info();
+  auto driver = std::to_string(static_cast<int>(info->backend)) + "|" + info->vendor + "|" +
+                info->renderer + "|" + info->version + "|" +
+                std::to_string(PROGRAM_BINARY_VERSION);
+  fingerprint = ToHexString(MD5::Calculate(driver.data(), driver.size()));
+}
+
+void ProgramBinaryCache::setProgramCache(std::shared_ptr<ProgramCache> cache) {
+  if (programCache == cache) {
+    return;
+  }
+  flush();
+  programCache = std::move(cache);
+  preloadedBinaries.clear();
+  storedKeys.clear();
+  storedKeySet.clear();
+  indexDirty = false;
+  pipelineCacheDirty = false;
+  if (programCache != nullptr) {
+    preload();
+  }
+}
+
+std::string ProgramBinaryCache::makeKey(const std::string& vertexCode,
+                                        const std::string& fragmentCode) const {
+  auto code = vertexCode;
+  code.push_back('\0');
+  code += fragmentCode;
+  return fingerprint + "-" + ToHexString(MD5::Calculate(code.data(), code.size()));
+}
+
+std::shared_ptr<RenderPipeline> ProgramBinaryCache::loadPipeline(
+    const std::string& key, const RenderPipelineDescriptor& descriptor) {
+  if (programCache == nullptr) {
+    return nullptr;
+  }
+  std::shared_ptr<Data> data = nullptr;
+  auto result = preloadedBinaries.find(key);
+  if (result != preloadedBinaries.end()) {
+    // The restored program stays in GlobalCache, so the preloaded copy is no longer needed.
+    data = std::move(result->second);
+    preloadedBinaries.erase(result);
+  } else if (storedKeySet.count(key) > 0) {
+    // The program was restored before but has been evicted from GlobalCache since then.
+    data = programCache->load(key);
+  }
+  if (data == nullptr || data->size() <= sizeof(ProgramBinaryHeader)) {
+    return nullptr;
+  }
+  ProgramBinaryHeader header = {};
+  memcpy(&header, data->data(), sizeof(ProgramBinaryHeader));
+  if (header.version != PROGRAM_BINARY_VERSION) {
+    return nullptr;
+  }
+  auto startTime = Clock::Now();
+  auto binary = Data::MakeWithoutCopy(data->bytes() + sizeof(ProgramBinaryHeader),
+                                      data->size() - sizeof(ProgramBinaryHeader));
+  auto pipeline = context->gpu()->createRenderPipelineFromBinary(descriptor, binary.get());
+  if (pipeline == nullptr) {
+    return nullptr;
+  }
+  _stats.hitCount++;
+  auto loadTime = Clock::Now() - startTime;
+  if (header.compileTime > loadTime) {
+    _stats.compileTimeSaved += header.compileTime - loadTime;
+  }
+  return pipeline;
+}
+
+void ProgramBinaryCache::storePipeline(const std::string& key, const RenderPipeline* pipeline,
+                                       int64_t compileTime) {
+  if (programCache == nullptr) {
+    return;
+  }
+  _stats.missCount++;
+  auto binary = context->gpu()->getPipelineBinary(pipeline);
+  if (binary == nullptr) {
+    // Backends without per-pipeline binaries may still keep an internal pipeline cache, which
+    // has just grown by this pipeline.
+    pipelineCacheDirty = true;
+    return;
+  }
+  Buffer buffer(sizeof(ProgramBinaryHeader) + binary->size());
+  if (buffer.isEmpty()) {
+    return;
+  }
+  ProgramBinaryHeader header = {};
+  header.compileTime = compileTime;
+  buffer.writeRange(0, sizeof(ProgramBinaryHeader), &header);
+  buffer.writeRange(sizeof(ProgramBinaryHeader), binary->size(), binary->data());
+  programCache->store(key, buffer.release());
+  if (storedKeySet.insert(key).second) {
+    storedKeys.push_back(key);
+    indexDirty = true;
+  }
+}
+
+void ProgramBinaryCache::flush() {
+  if (programCache == nullptr) {
+    return;
+  }
+  if (indexDirty) {
+    std::string index = {};
+    for (auto& key : storedKeys) {
+      index += key;
+      index.push_back('\n');
+    }
+    programCache->store(indexKey(), Data::MakeWithCopy(index.data(), index.size()));
+    indexDirty = false;
+  }
+  if (pipelineCacheDirty) {
+    auto cacheData = context->gpu()->getPipelineCacheData();
+    if (cacheData != nullptr) {
+      programCache->store(pipelineCacheKey(), std::move(cacheData));
+    }
+    pipelineCacheDirty = false;
+  }
+}
+
+std::string ProgramBinaryCache::indexKey() const {
+  return fingerprint + "-index";
+}
+
+std::string ProgramBinaryCache::pipelineCacheKey() const {
+  return fingerprint + "-pipelines";
+}
+
+void ProgramBinaryCache::preload() {
+  auto indexData = programCache->load(indexKey());
+  if (indexData != nullptr) {
+    std::string index(reinterpret_cast<const char*>(indexData->bytes()), indexData->size());
+    size_t start = 0;
+    while (start < index.size()) {
+      auto end = index.find('\n', start);
+      if (end == std::string::npos) {
+        end = index.size();
+      }
+      auto key = index.substr(start, end - start);
+      start = end + 1;
+      if (key.empty() || !storedKeySet.insert(key).second) {
+        continue;
+      }
+      storedKeys.push_back(key);
+      auto data = programCache->load(key);
+      if (data != nullptr) {
+        preloadedBinaries[key] = std::move(data);
+      }
+    }
+  }
+  auto cacheData = programCache->load(pipelineCacheKey());
+  if (cacheData != nullptr) {
+    context->gpu()->mergePipelineCacheData(cacheData.get());
+  }
+}
+}  // namespace tgfx
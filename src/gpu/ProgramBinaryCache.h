@@ -0,0 +1,97 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "tgfx/gpu/ProgramCache.h"
+#include "tgfx/gpu/RenderPipeline.h"
+
+namespace tgfx {
+class Context;
+
+/**
+ * ProgramBinaryCache connects the GPU backend to the persistent ProgramCache set on the Device. It
+ * preloads the stored binaries when the cache is installed, restores pipelines from them on a
+ * program miss, and stores the binaries of newly compiled pipelines. Program keys in GlobalCache
+ * contain runtime class IDs that change between launches, so entries here are keyed by the
+ * generated shader code together with a fingerprint of the GPU driver instead.
+ */
+class ProgramBinaryCache {
+ public:
+  explicit ProgramBinaryCache(Context* context);
+
+  /**
+   * Replaces the persistent cache and preloads all entries stored for the current GPU driver.
+   */
+  void setProgramCache(std::shared_ptr<ProgramCache> cache);
+
+  /**
+   * Returns true if a persistent cache is installed.
+   */
+  bool enabled() const {
+    return programCache != nullptr;
+  }
+
+  /**
+   * Returns the persistent key for a pipeline built from the specified shader code.
+   */
+  std::string makeKey(const std::string& vertexCode, const std::string& fragmentCode) const;
+
+  /**
+   * Tries to restore a pipeline from the binary stored with the specified key. Returns nullptr if
+   * there is no binary or the driver rejects it, in which case the caller compiles the pipeline
+   * and passes it to storePipeline().
+   */
+  std::shared_ptr<RenderPipeline> loadPipeline(const std::string& key,
+                                               const RenderPipelineDescriptor& descriptor);
+
+  /**
+   * Stores the binary of a newly compiled pipeline. The compile time is kept with the binary to
+   * report the time saved when it is restored later.
+   */
+  void storePipeline(const std::string& key, const RenderPipeline* pipeline, int64_t compileTime);
+
+  /**
+   * Writes the pending index and backend pipeline cache data to the persistent cache, if any.
+   */
+  void flush();
+
+  const ProgramCacheStats& stats() const {
+    return _stats;
+  }
+
+ private:
+  Context* context = nullptr;
+  std::shared_ptr<ProgramCache> programCache = nullptr;
+  std::string fingerprint = {};
+  std::unordered_map<std::string, std::shared_ptr<Data>> preloadedBinaries = {};
+  std::vector<std::string> storedKeys = {};
+  std::unordered_set<std::string> storedKeySet = {};
+  bool indexDirty = false;
+  bool pipelineCacheDirty = false;
+  ProgramCacheStats _stats = {};
+
+  std::string indexKey() const;
+  std::string pipelineCacheKey() const;
+  void preload();
+};
+}  // namespace tgfx
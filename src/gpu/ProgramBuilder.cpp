@@ -17,7 +17,10 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ProgramBuilder.h"
+#include "core/utils/TraceZone.h"
+#include "gpu/GlobalCache.h"
 #include "gpu/processors/FragmentProcessor.h"
+#include "tgfx/core/Clock.h"
 
 namespace tgfx {
 class ProcessorGuard {
@@ -34,6 +37,32 @@ class ProcessorGuard {
   ProgramBuilder* builder = nullptr;
 };
 
+std::shared_ptr<Program> ProgramBuilder::CreateProgram(Context* context,
+                                                       const ProgramInfo* programInfo) {
+  auto source = CreateProgramSource(context, programInfo);
+  if (source == nullptr) {
+    return nullptr;
+  }
+  auto binaryCache = context->globalCache()->programBinaryCache();
+  std::shared_ptr<RenderPipeline> pipeline = nullptr;
+  if (!source->binaryKey.empty()) {
+    pipeline = binaryCache->loadPipeline(source->binaryKey, source->descriptor);
+  }
+  if (pipeline == nullptr) {
+    TRACE_ZONE("ProgramBuilder::compile");
+    auto startTime = Clock::Now();
+    pipeline = source->compile(context->gpu());
+    if (pipeline == nullptr) {
+      return nullptr;
+    }
+    context->currentFrameStats()->programCompileCount++;
+    if (!source->binaryKey.empty()) {
+      binaryCache->storePipeline(source->binaryKey, pipeline.get(), Clock::Now() - startTime);
+    }
+  }
+  return source->makeProgram(std::move(pipeline));
+}
+
 ProgramBuilder::ProgramBuilder(Context* context, const ProgramInfo* programInfo)
     : context(context), programInfo(programInfo) {
 }
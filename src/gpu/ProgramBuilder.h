@@ -20,6 +20,7 @@
 
 #include "FragmentShaderBuilder.h"
 #include "ProgramInfo.h"
+#include "ProgramSource.h"
 #include "UniformHandler.h"
 #include "VaryingHandler.h"
 #include "VertexShaderBuilder.h"
@@ -29,10 +30,18 @@ namespace tgfx {
 class ProgramBuilder {
  public:
   /**
-   * Generates a shader program.
+   * Generates and compiles a shader program on the calling thread. The compilation is skipped if
+   * the program can be restored from the ProgramBinaryCache.
    */
   static std::shared_ptr<Program> CreateProgram(Context* context, const ProgramInfo* programInfo);
 
+  /**
+   * Generates the shader code and pipeline layout of a program without compiling it. Returns
+   * nullptr if any processor fails to emit its code.
+   */
+  static std::unique_ptr<ProgramSource> CreateProgramSource(Context* context,
+                                                            const ProgramInfo* programInfo);
+
   virtual ~ProgramBuilder() = default;
 
   Context* getContext() const {
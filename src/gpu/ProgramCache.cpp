@@ -0,0 +1,65 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tgfx/gpu/ProgramCache.h"
+#include "tgfx/core/WriteStream.h"
+
+namespace tgfx {
+/**
+ * DirectoryProgramCache stores each entry as a file named after its key in a directory.
+ */
+class DirectoryProgramCache : public ProgramCache {
+ public:
+  explicit DirectoryProgramCache(std::string directory) : directory(std::move(directory)) {
+  }
+
+  std::shared_ptr<Data> load(const std::string& key) override {
+    return Data::MakeFromFile(getFilePath(key));
+  }
+
+  void store(const std::string& key, std::shared_ptr<Data> data) override {
+    if (data == nullptr) {
+      return;
+    }
+    auto stream = WriteStream::MakeFromFile(getFilePath(key));
+    if (stream == nullptr) {
+      return;
+    }
+    stream->write(data->data(), data->size());
+    stream->flush();
+  }
+
+ private:
+  std::string directory = {};
+
+  std::string getFilePath(const std::string& key) const {
+    return directory + "/" + key;
+  }
+};
+
+std::shared_ptr<ProgramCache> ProgramCache::MakeFromDirectory(const std::string& directory) {
+  if (directory.empty()) {
+    return nullptr;
+  }
+  auto path = directory;
+  while (path.size() > 1 && (path.back() == '/' || path.back() == '\\')) {
+    path.pop_back();
+  }
+  return std::make_shared<DirectoryProgramCache>(std::move(path));
+}
+}  // namespace tgfx
@@ -0,0 +1,121 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ProgramCompileQueue.h"
+#include "core/utils/Log.h"
+#include "gpu/GlobalCache.h"
+#include "tgfx/core/Clock.h"
+#include "tgfx/gpu/Context.h"
+
+namespace tgfx {
+// The time in microseconds that process() may spend compiling programs on the render thread when
+// the GPU cannot create pipelines concurrently. At least one program is compiled per call, so a
+// slow program can not starve the queue.
+static constexpr int64_t MAX_COMPILE_TIME_PER_FRAME = 4000;
+
+ProgramCompileTask::ProgramCompileTask(GPU* gpu, BytesKey programKey,
+                                       std::unique_ptr<ProgramSource> source)
+    : gpu(gpu), programKey(std::move(programKey)), source(std::move(source)) {
+}
+
+void ProgramCompileTask::compile() {
+  auto startTime = Clock::Now();
+  pipeline = source->compile(gpu);
+  compileTime = Clock::Now() - startTime;
+}
+
+ProgramCompileQueue::ProgramCompileQueue(Context* context) : context(context) {
+#ifdef TGFX_USE_THREADS
+  backgroundCompile = context->gpu()->features()->concurrentPipelineCreation;
+#endif
+}
+
+ProgramCompileQueue::~ProgramCompileQueue() {
+  for (auto& task : pendingTasks) {
+    task->cancel();
+  }
+  // Tasks that have already started must finish before the GPU is released.
+  for (auto& task : pendingTasks) {
+    task->wait();
+  }
+}
+
+std::shared_ptr<Program> ProgramCompileQueue::enqueue(const BytesKey& programKey,
+                                                      std::unique_ptr<ProgramSource> source) {
+  if (source == nullptr || isPending(programKey)) {
+    return nullptr;
+  }
+  if (!source->binaryKey.empty()) {
+    auto binaryCache = context->globalCache()->programBinaryCache();
+    auto pipeline = binaryCache->loadPipeline(source->binaryKey, source->descriptor);
+    if (pipeline != nullptr) {
+      return source->makeProgram(std::move(pipeline));
+    }
+  }
+  auto task = std::make_shared<ProgramCompileTask>(context->gpu(), programKey, std::move(source));
+  pendingKeys[programKey] = true;
+  pendingTasks.push_back(task);
+  if (backgroundCompile) {
+    Task::Run(std::move(task), TaskPriority::High);
+  }
+  return nullptr;
+}
+
+void ProgramCompileQueue::process() {
+  _deferredDrawCount = 0;
+  auto startTime = Clock::Now();
+  bool compiled = false;
+  auto task = pendingTasks.begin();
+  while (task != pendingTasks.end()) {
+    if (backgroundCompile) {
+      if ((*task)->status() != TaskStatus::Finished) {
+        ++task;
+        continue;
+      }
+    } else {
+      if (compiled && Clock::Now() - startTime >= MAX_COMPILE_TIME_PER_FRAME) {
+        break;
+      }
+      (*task)->compile();
+      compiled = true;
+    }
+    install(task->get());
+    task = pendingTasks.erase(task);
+  }
+}
+
+void ProgramCompileQueue::install(ProgramCompileTask* task) {
+  pendingKeys.erase(task->programKey);
+  if (task->pipeline == nullptr) {
+    LOGE("ProgramCompileQueue::install() Failed to compile the program!");
+    return;
+  }
+  context->currentFrameStats()->programCompileCount++;
+  auto globalCache = context->globalCache();
+  if (!task->source->binaryKey.empty()) {
+    globalCache->programBinaryCache()->storePipeline(task->source->binaryKey, task->pipeline.get(),
+                                                     task->compileTime);
+  }
+  // The program may have been compiled synchronously in the meantime if asynchronous compilation
+  // was turned off while the task was pending.
+  if (globalCache->findProgram(task->programKey) != nullptr) {
+    return;
+  }
+  globalCache->addProgram(task->programKey, task->source->makeProgram(std::move(task->pipeline)));
+}
+}  // namespace tgfx
@@ -0,0 +1,140 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <list>
+#include "gpu/ProgramSource.h"
+#include "tgfx/core/BytesKey.h"
+#include "tgfx/core/Task.h"
+
+namespace tgfx {
+class Context;
+
+/**
+ * ProgramCompileTask compiles a ProgramSource into a render pipeline. It runs on a TaskGroup thread
+ * if the GPU supports concurrent pipeline creation, otherwise it is run by ProgramCompileQueue on
+ * the render thread.
+ */
+class ProgramCompileTask : public Task {
+ public:
+  ProgramCompileTask(GPU* gpu, BytesKey programKey, std::unique_ptr<ProgramSource> source);
+
+  /**
+   * Compiles the pipeline on the calling thread.
+   */
+  void compile();
+
+ protected:
+  void onExecute() override {
+    compile();
+  }
+
+ private:
+  GPU* gpu = nullptr;
+  BytesKey programKey = {};
+  std::unique_ptr<ProgramSource> source = nullptr;
+  std::shared_ptr<RenderPipeline> pipeline = nullptr;
+  int64_t compileTime = 0;
+
+  friend class ProgramCompileQueue;
+};
+
+/**
+ * ProgramCompileQueue compiles new programs off the critical path of the frame when asynchronous
+ * shader compilation is enabled on the Context. Draws whose programs are still compiling are
+ * skipped and counted, so the caller knows the frame has to be drawn again. On GPUs that support
+ * concurrent pipeline creation, programs are compiled on TaskGroup threads. On other GPUs (e.g.
+ * OpenGL, where a context is bound to a single thread), the queued programs are compiled on the
+ * render thread at the start of the next submit, within a fixed time budget per frame.
+ */
+class ProgramCompileQueue {
+ public:
+  explicit ProgramCompileQueue(Context* context);
+
+  ~ProgramCompileQueue();
+
+  /**
+   * Returns true if asynchronous shader compilation is enabled.
+   */
+  bool enabled() const {
+    return _enabled;
+  }
+
+  /**
+   * Enables or disables asynchronous shader compilation. Programs already queued keep compiling and
+   * are added to the GlobalCache as usual.
+   */
+  void setEnabled(bool value) {
+    _enabled = value;
+  }
+
+  /**
+   * Returns true if a program with the specified key is waiting to be compiled.
+   */
+  bool isPending(const BytesKey& programKey) const {
+    return pendingKeys.find(programKey) != pendingKeys.end();
+  }
+
+  /**
+   * Queues the source for compilation. If the pipeline can be restored from the
+   * ProgramBinaryCache, the program is returned immediately and nothing is queued. Otherwise,
+   * returns nullptr and the program will be added to the GlobalCache by a later call to process().
+   */
+  std::shared_ptr<Program> enqueue(const BytesKey& programKey,
+                                   std::unique_ptr<ProgramSource> source);
+
+  /**
+   * Moves the finished programs into the GlobalCache and resets the deferred draw counter. On GPUs
+   * without concurrent pipeline creation, this also compiles queued programs on the calling thread
+   * until the per-frame budget is spent. Called at the start of each Context::submit().
+   */
+  void process();
+
+  /**
+   * Records a draw that was skipped because its program is still compiling.
+   */
+  void recordDeferredDraw() {
+    _deferredDrawCount++;
+  }
+
+  /**
+   * Returns the number of draws skipped since the last call to process().
+   */
+  size_t deferredDrawCount() const {
+    return _deferredDrawCount;
+  }
+
+  /**
+   * Returns the number of programs that are still waiting to be compiled.
+   */
+  size_t pendingCount() const {
+    return pendingTasks.size();
+  }
+
+ private:
+  Context* context = nullptr;
+  bool _enabled = false;
+  bool backgroundCompile = false;
+  size_t _deferredDrawCount = 0;
+  std::list<std::shared_ptr<ProgramCompileTask>> pendingTasks = {};
+  BytesKeyMap<bool> pendingKeys = {};
+
+  void install(ProgramCompileTask* task);
+};
+}  // namespace tgfx
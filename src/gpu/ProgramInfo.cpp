@@ -129,7 +129,7 @@ std::string ProgramInfo::getMangledSuffix(const Processor* processor) const {
   return "_P" + std::to_string(processorIndex);
 }
 
-std::shared_ptr<Program> ProgramInfo::getProgram() const {
+std::shared_ptr<Program> ProgramInfo::getProgram(bool* deferred) const {
   auto context = renderTarget->getContext();
   BytesKey programKey = {};
   geometryProcessor->computeProcessorKey(context, &programKey);
@@ -159,15 +159,34 @@ std::shared_ptr<Program> ProgramInfo::getProgram() const {
   EncodeStencilFace(programKey, depthStencil.stencilFront);
   EncodeStencilFace(programKey, depthStencil.stencilBack);
 
-  auto program = context->globalCache()->findProgram(programKey);
-  if (program == nullptr) {
+  auto globalCache = context->globalCache();
+  auto program = globalCache->findProgram(programKey);
+  if (program != nullptr) {
+    return program;
+  }
+  auto compileQueue = globalCache->programCompileQueue();
+  if (deferred != nullptr && compileQueue->enabled()) {
+    if (!compileQueue->isPending(programKey)) {
+      auto source = ProgramBuilder::CreateProgramSource(context, this);
+      if (source == nullptr) {
+        LOGE("ProgramInfo::getProgram() Failed to create the program source!");
+        return nullptr;
+      }
+      program = compileQueue->enqueue(programKey, std::move(source));
+    }
+    if (program == nullptr) {
+      compileQueue->recordDeferredDraw();
+      *deferred = true;
+      return nullptr;
+    }
+  } else {
     program = ProgramBuilder::CreateProgram(context, this);
     if (program == nullptr) {
       LOGE("ProgramInfo::getProgram() Failed to create the program!");
       return nullptr;
     }
-    context->globalCache()->addProgram(programKey, program);
   }
+  globalCache->addProgram(programKey, program);
   return program;
 }
 
@@ -84,7 +84,13 @@ class ProgramInfo {
 
   std::string getMangledSuffix(const Processor* processor) const;
 
-  std::shared_ptr<Program> getProgram() const;
+  /**
+   * Returns the program for this ProgramInfo, compiling it on a cache miss. If deferred is not
+   * nullptr and asynchronous shader compilation is enabled on the Context, a missing program is
+   * queued for compilation instead, and nullptr is returned with deferred set to true. Callers that
+   * opt in must skip the draw in that case.
+   */
+  std::shared_ptr<Program> getProgram(bool* deferred = nullptr) const;
 
   std::shared_ptr<GPUBuffer> getUniformBuffer(const Program* program, size_t* vertexOffset,
                                               size_t* fragmentOffset) const;
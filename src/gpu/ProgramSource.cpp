@@ -0,0 +1,45 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ProgramSource.h"
+
+namespace tgfx {
+std::shared_ptr<RenderPipeline> ProgramSource::compile(GPU* gpu) {
+  descriptor.vertex.module = gpu->createShaderModule(vertexModule);
+  if (descriptor.vertex.module == nullptr) {
+    return nullptr;
+  }
+  descriptor.fragment.module = gpu->createShaderModule(fragmentModule);
+  if (descriptor.fragment.module == nullptr) {
+    return nullptr;
+  }
+  auto pipeline = gpu->createRenderPipeline(descriptor);
+  // The modules are only needed while the pipeline is being created.
+  descriptor.vertex.module = nullptr;
+  descriptor.fragment.module = nullptr;
+  return pipeline;
+}
+
+std::shared_ptr<Program> ProgramSource::makeProgram(std::shared_ptr<RenderPipeline> pipeline) {
+  if (pipeline == nullptr) {
+    return nullptr;
+  }
+  return std::make_shared<Program>(std::move(pipeline), std::move(vertexUniformData),
+                                   std::move(fragmentUniformData));
+}
+}  // namespace tgfx
@@ -0,0 +1,57 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string>
+#include "gpu/Program.h"
+#include "tgfx/gpu/GPU.h"
+
+namespace tgfx {
+/**
+ * ProgramSource holds the generated shader code and pipeline layout of a program that has not been
+ * compiled yet. Unlike ProgramInfo, it does not reference any processors of the current flush, so
+ * it can outlive the frame that generated it and be compiled on another thread.
+ */
+class ProgramSource {
+ public:
+  ShaderModuleDescriptor vertexModule = {};
+  ShaderModuleDescriptor fragmentModule = {};
+  RenderPipelineDescriptor descriptor = {};
+  std::unique_ptr<UniformData> vertexUniformData = nullptr;
+  std::unique_ptr<UniformData> fragmentUniformData = nullptr;
+  /**
+   * The key used to store the compiled pipeline in the ProgramBinaryCache. Empty if the binary
+   * cache is disabled.
+   */
+  std::string binaryKey = {};
+
+  /**
+   * Compiles the shader modules and creates the render pipeline. Only touches the GPU, so it can be
+   * called from a worker thread if GPUFeatures::concurrentPipelineCreation is true. Returns nullptr
+   * if the compilation fails.
+   */
+  std::shared_ptr<RenderPipeline> compile(GPU* gpu);
+
+  /**
+   * Creates a Program with the given pipeline. The uniform data is moved into the Program, so this
+   * method can only be called once.
+   */
+  std::shared_ptr<Program> makeProgram(std::shared_ptr<RenderPipeline> pipeline);
+};
+}  // namespace tgfx
@@ -20,6 +20,7 @@
 #include "core/Atlas.h"
 #include "core/AtlasManager.h"
 #include "core/AtlasStrikeCache.h"
+#include "core/DistanceFieldRasterizer.h"
 #include "core/GlyphRasterizer.h"
 #include "core/GlyphTransform.h"
 #include "core/PathRasterizer.h"
@@ -64,6 +65,21 @@ static BytesKey GetStrikeKey(uint32_t typefaceID, float backingSize, bool isBold
   return key;
 }
 
+// Distance field glyphs are rasterized once at this size and scaled to any device size in the
+// [MIN_DISTANCE_FIELD_TEXT_SIZE, MAX_DISTANCE_FIELD_TEXT_SIZE] range. Smaller text keeps bitmap
+// strikes, which are sharper thanks to hinting, and larger text would show rounded corners.
+static constexpr float DISTANCE_FIELD_BASE_SIZE = 64.0f;
+static constexpr float MIN_DISTANCE_FIELD_TEXT_SIZE = 24.0f;
+static constexpr float MAX_DISTANCE_FIELD_TEXT_SIZE = 256.0f;
+
+static BytesKey GetDistanceFieldStrikeKey(uint32_t typefaceID) {
+  BytesKey key;
+  key.write(typefaceID);
+  // A negative size never collides with the backing size of a bitmap strike.
+  key.write(-DISTANCE_FIELD_BASE_SIZE);
+  return key;
+}
+
 static Font GetScaledFont(const Font& font, float scale) {
   if (FloatNearlyEqual(scale, 1.0f)) {
     return font;
@@ -408,7 +424,11 @@ void RenderContext::drawTextBlob(std::shared_ptr<TextBlob> textBlob, const Matri
       continue;
     }
     std::vector<size_t> rejectedIndices;
-    drawGlyphsAsDirectMask(run, matrix, clip, brush, stroke, localClipBounds, &rejectedIndices);
+    if (shouldUseDistanceField(run.font, matrix, stroke)) {
+      drawGlyphsAsDistanceField(run, matrix, clip, brush, localClipBounds, &rejectedIndices);
+    } else {
+      drawGlyphsAsDirectMask(run, matrix, clip, brush, stroke, localClipBounds, &rejectedIndices);
+    }
     // Process rejected glyphs immediately to maintain correct draw order.
     if (!rejectedIndices.empty()) {
       if (!run.font.hasColor() && run.font.hasOutlines()) {
@@ -426,7 +446,11 @@ void RenderContext::drawTextBlob(std::shared_ptr<TextBlob> textBlob, const Matri
 void RenderContext::drawPicture(std::shared_ptr<Picture> picture, const Matrix& matrix,
                                 const ClipStack& clip) {
   DEBUG_ASSERT(picture != nullptr);
-  picture->playback(this, matrix, clip);
+  auto clipBounds = getClipBounds(clip);
+  if (clipBounds.isEmpty()) {
+    return;
+  }
+  picture->playback(this, matrix, clip, nullptr, &clipBounds);
 }
 
 void RenderContext::drawLayer(std::shared_ptr<Picture> picture, std::shared_ptr<ImageFilter> filter,
@@ -636,6 +660,121 @@ void RenderContext::drawGlyphsAsDirectMask(const GlyphRun& sourceGlyphRun, const
   }
 }
 
+bool RenderContext::shouldUseDistanceField(const Font& font, const Matrix& matrix,
+                                           const Stroke* stroke) const {
+  if (!(renderFlags & RenderFlags::DistanceFieldText) || stroke != nullptr || font.hasColor() ||
+      !font.hasOutlines() || font.isFauxBold() || matrix.hasPerspective()) {
+    return false;
+  }
+  auto deviceSize = font.getSize() * matrix.getMaxScale();
+  return deviceSize >= MIN_DISTANCE_FIELD_TEXT_SIZE && deviceSize <= MAX_DISTANCE_FIELD_TEXT_SIZE;
+}
+
+void RenderContext::drawGlyphsAsDistanceField(const GlyphRun& sourceGlyphRun,
+                                              const Matrix& matrix, const ClipStack& clip,
+                                              const Brush& brush, const Rect& localClipBounds,
+                                              std::vector<size_t>* rejectedIndices) {
+  auto compositor = getOpsCompositor();
+  if (compositor == nullptr) {
+    return;
+  }
+  auto font = sourceGlyphRun.font.makeWithSize(DISTANCE_FIELD_BASE_SIZE);
+  auto typeface = font.getTypeface();
+  const auto typefaceID = GetTypefaceID(typeface.get(), typeface->isCustom());
+  auto strikeKey = GetDistanceFieldStrikeKey(typefaceID);
+
+  AtlasCell atlasCell{MaskFormat::A8};
+  PlotUseUpdater plotUseUpdater;
+  auto atlasManager = getContext()->atlasManager();
+  const auto nextFlushToken = atlasManager->nextFlushToken();
+  auto strike = getContext()->atlasStrikeCache()->findOrCreateStrike(strikeKey);
+  DEBUG_ASSERT(strike != nullptr);
+
+  auto drawingManager = getContext()->drawingManager();
+  const auto atlasBrush = brush.makeWithMatrix(matrix);
+  const auto backingSize = font.scalerContext->getBackingSize();
+  const auto glyphRenderScale = font.scalerContext->getSize() / backingSize;
+  // Maps the distance field pixels to the local space of the run.
+  const auto combinedScale =
+      glyphRenderScale * sourceGlyphRun.font.getSize() / DISTANCE_FIELD_BASE_SIZE;
+  const SamplingOptions sampling(FilterMode::Linear, MipmapMode::None);
+
+  auto typefaceBounds = GetTypefaceBounds(typeface, sourceGlyphRun.font.getSize(), 1.0f, nullptr);
+  const auto* sharedBounds = typefaceBounds.isEmpty() ? nullptr : &typefaceBounds;
+  auto& textureProxies = atlasManager->getTextureProxies(MaskFormat::A8);
+
+  Rect perGlyphBounds = {};
+  auto hasOnlyOffset = !HasComplexTransform(sourceGlyphRun);
+  for (size_t i = 0; i < sourceGlyphRun.glyphCount; i++) {
+    auto glyphID = sourceGlyphRun.glyphs[i];
+    auto glyphBounds = sharedBounds ? sharedBounds
+                                    : GetGlyphBounds(sourceGlyphRun.font, glyphID, 1.0f, nullptr,
+                                                     &perGlyphBounds);
+    if (!glyphBounds) {
+      continue;
+    }
+    Rect mappedBounds = {};
+    if (hasOnlyOffset) {
+      auto position = GetGlyphPosition(sourceGlyphRun, i);
+      mappedBounds = glyphBounds->makeOffset(position.x, position.y);
+    } else {
+      mappedBounds = GetGlyphMatrix(sourceGlyphRun, i).mapRect(*glyphBounds);
+    }
+    if (!Rect::Intersects(mappedBounds, localClipBounds) || strike->isEmptyGlyph(glyphID)) {
+      continue;
+    }
+
+    Point glyphOffset = {};
+    auto atlasGlyph = strike->getGlyph(glyphID);
+    DEBUG_ASSERT(atlasGlyph != nullptr);
+    auto& atlasLocator = atlasGlyph->atlasLocator;
+    if (atlasManager->hasGlyph(MaskFormat::A8, atlasGlyph)) {
+      glyphOffset = atlasGlyph->offset;
+    } else {
+      bool shouldRetry = false;
+      bool isEmptyGlyph = false;
+      auto glyphCodec = GetGlyphCodec(font, font.scalerContext, glyphID, nullptr, &glyphOffset,
+                                      &isEmptyGlyph, &shouldRetry);
+      auto fieldCodec = DistanceFieldRasterizer::MakeFrom(std::move(glyphCodec));
+      if (fieldCodec == nullptr || fieldCodec->width() > Atlas::MaxCellSize ||
+          fieldCodec->height() > Atlas::MaxCellSize) {
+        if (isEmptyGlyph) {
+          strike->markEmptyGlyph(glyphID);
+        } else {
+          rejectedIndices->push_back(i);
+        }
+        continue;
+      }
+      auto padding = static_cast<float>(DistanceFieldRasterizer::Padding);
+      glyphOffset.offset(-padding, -padding);
+      atlasGlyph->offset = glyphOffset;
+      atlasCell.width = static_cast<uint16_t>(fieldCodec->width());
+      atlasCell.height = static_cast<uint16_t>(fieldCodec->height());
+      if (!atlasManager->addCellToAtlas(atlasCell, nextFlushToken, &atlasLocator)) {
+        rejectedIndices->push_back(i);
+        continue;
+      }
+      auto& atlasRect = atlasLocator.getLocation();
+      drawingManager->addAtlasCellTask(textureProxies[atlasLocator.pageIndex()],
+                                       Point::Make(atlasRect.x(), atlasRect.y()),
+                                       std::move(fieldCodec));
+    }
+    atlasManager->setPlotUseToken(plotUseUpdater, atlasLocator.plotLocator(), MaskFormat::A8,
+                                  nextFlushToken);
+    auto textureProxy = textureProxies[atlasLocator.pageIndex()];
+    if (textureProxy == nullptr) {
+      rejectedIndices->push_back(i);
+      continue;
+    }
+    Matrix glyphMatrix = {};
+    auto& rect = atlasLocator.getLocation();
+    ComputeGlyphRenderMatrix(rect, matrix, sourceGlyphRun, i, combinedScale, glyphOffset,
+                             font.isFauxItalic(), false, &glyphMatrix);
+    compositor->fillTextAtlas(std::move(textureProxy), rect, sampling, glyphMatrix, clip,
+                              atlasBrush, true);
+  }
+}
+
 void RenderContext::drawGlyphAsPath(const Font& font, GlyphID glyphID, const Matrix& glyphMatrix,
                                     const Matrix& matrix, const ClipStack& clip, const Brush& brush,
                                     const Stroke* stroke, Rect& localClipBounds) {
@@ -89,6 +89,20 @@ class RenderContext : public DrawContext {
                               const ClipStack& clip, const Brush& brush, const Stroke* stroke,
                               const Rect& localClipBounds, std::vector<size_t>* rejectedIndices);
 
+  /**
+   * Returns true if the glyphs of the run should be drawn from the distance field strike of their
+   * typeface instead of a bitmap strike at their device size.
+   */
+  bool shouldUseDistanceField(const Font& font, const Matrix& matrix, const Stroke* stroke) const;
+
+  /**
+   * Draws glyphs from the distance field strike of the run's typeface, which serves all scales in
+   * the distance field range. Glyphs that fail to render are recorded in rejectedIndices.
+   */
+  void drawGlyphsAsDistanceField(const GlyphRun& sourceGlyphRun, const Matrix& matrix,
+                                 const ClipStack& clip, const Brush& brush,
+                                 const Rect& localClipBounds, std::vector<size_t>* rejectedIndices);
+
   void drawGlyphAsPath(const Font& font, GlyphID glyphID, const Matrix& glyphMatrix,
                        const Matrix& matrix, const ClipStack& clip, const Brush& brush,
                        const Stroke* stroke, Rect& localClipBounds);
@@ -160,8 +160,10 @@ void ResourceCache::releaseAll() {
 }
 
 std::shared_ptr<Resource> ResourceCache::findScratchResource(const ScratchKey& scratchKey) {
+  auto stats = context->currentFrameStats();
   auto result = scratchKeyMap.find(scratchKey);
   if (result == scratchKeyMap.end()) {
+    stats->resourceCacheMisses++;
     return nullptr;
   }
   auto completed = context->gpu()->queue()->completedFrameTime();
@@ -177,8 +179,10 @@ std::shared_ptr<Resource> ResourceCache::findScratchResource(const ScratchKey& s
     index++;
   }
   if (!found) {
+    stats->resourceCacheMisses++;
     return nullptr;
   }
+  stats->resourceCacheHits++;
   auto resource = list[index];
   return refResource(resource);
 }
@@ -186,8 +190,12 @@ std::shared_ptr<Resource> ResourceCache::findScratchResource(const ScratchKey& s
 std::shared_ptr<Resource> ResourceCache::findUniqueResource(const UniqueKey& uniqueKey) {
   auto resource = getUniqueResource(uniqueKey);
   if (resource == nullptr) {
+    if (!uniqueKey.empty()) {
+      context->currentFrameStats()->resourceCacheMisses++;
+    }
     return nullptr;
   }
+  context->currentFrameStats()->resourceCacheHits++;
   return refResource(resource);
 }
 
@@ -0,0 +1,106 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "TransientTargetAllocator.h"
+#include <unordered_set>
+#include "gpu/proxies/RenderTargetProxy.h"
+#include "tgfx/gpu/Context.h"
+
+namespace tgfx {
+void TransientTargetAllocator::analyze(const std::vector<PlacementPtr<RenderTask>>& renderTasks) {
+  std::unordered_set<RenderTargetProxy*> visitedTargets = {};
+  for (size_t i = 0; i < renderTasks.size(); ++i) {
+    auto renderTarget = renderTasks[i]->renderTarget();
+    if (renderTarget == nullptr || !renderTarget->isTransient() ||
+        !visitedTargets.insert(renderTarget).second) {
+      continue;
+    }
+    auto proxy = renderTarget->asTextureProxy();
+    if (proxy != nullptr) {
+      pendingTargets.push_back({std::move(proxy), i});
+    }
+  }
+}
+
+void TransientTargetAllocator::beforeExecute(size_t taskIndex, RenderTask* task) {
+  while (pendingIndex < pendingTargets.size() &&
+         pendingTargets[pendingIndex].firstTaskIndex == taskIndex) {
+    auto proxy = std::move(pendingTargets[pendingIndex++].proxy);
+    // A render target shared with an earlier drawing buffer may have been instantiated since the
+    // analysis, in which case its contents must be kept.
+    if (proxy->resource != nullptr || !proxy->uniqueKey.empty()) {
+      continue;
+    }
+    auto stats = context->currentFrameStats();
+    stats->transientRenderTargetCount++;
+    if (!context->renderTargetAliasing()) {
+      continue;
+    }
+    task->discardContents();
+    // Earlier passes may still sample a free texture on the GPU. Backends without implicit
+    // hazard tracking (Vulkan) must wait for those reads when the discarded pass begins.
+    if (auto textureView = takeFreeTexture(proxy.get())) {
+      proxy->resource = std::move(textureView);
+      stats->aliasedRenderTargetCount++;
+    }
+    activeTargets.push_back(std::move(proxy));
+  }
+}
+
+void TransientTargetAllocator::afterExecute() {
+  for (auto item = activeTargets.begin(); item != activeTargets.end();) {
+    auto& proxy = *item;
+    // The allocator holds the last reference, so no pending task can read the contents anymore.
+    if (proxy.use_count() > 1) {
+      ++item;
+      continue;
+    }
+    if (proxy->resource != nullptr && proxy->uniqueKey.empty()) {
+      freeTextures.push_back(std::static_pointer_cast<TextureView>(std::move(proxy->resource)));
+    }
+    item = activeTargets.erase(item);
+  }
+}
+
+void TransientTargetAllocator::reset() {
+  pendingTargets.clear();
+  pendingIndex = 0;
+  activeTargets.clear();
+  freeTextures.clear();
+}
+
+std::shared_ptr<TextureView> TransientTargetAllocator::takeFreeTexture(const TextureProxy* proxy) {
+  auto renderTarget = proxy->asRenderTargetProxy();
+  for (auto item = freeTextures.begin(); item != freeTextures.end(); ++item) {
+    auto& textureView = *item;
+    auto freeTarget = textureView->asRenderTarget();
+    if (freeTarget == nullptr || textureView->width() != proxy->backingStoreWidth() ||
+        textureView->height() != proxy->backingStoreHeight() ||
+        textureView->origin() != proxy->origin() ||
+        textureView->hasMipmaps() != proxy->hasMipmaps() ||
+        freeTarget->format() != renderTarget->format() ||
+        freeTarget->sampleCount() != renderTarget->sampleCount()) {
+      continue;
+    }
+    auto result = std::move(textureView);
+    freeTextures.erase(item);
+    return result;
+  }
+  return nullptr;
+}
+}  // namespace tgfx
@@ -0,0 +1,77 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "core/utils/PlacementPtr.h"
+#include "gpu/proxies/TextureProxy.h"
+#include "gpu/tasks/RenderTask.h"
+
+namespace tgfx {
+/**
+ * TransientTargetAllocator shares textures between the transient render targets of a frame, like
+ * the resource allocator of a frame graph. Once no pending task references a transient render
+ * target anymore, its texture is handed over to the next transient render target with the same
+ * size and format instead of allocating a new one from the resource cache.
+ */
+class TransientTargetAllocator {
+ public:
+  explicit TransientTargetAllocator(Context* context) : context(context) {
+  }
+
+  /**
+   * Collects the render targets that are not instantiated yet from the given tasks and records the
+   * first task rendering into each of them.
+   */
+  void analyze(const std::vector<PlacementPtr<RenderTask>>& renderTasks);
+
+  /**
+   * Prepares the render targets first used by the given task at the given index. If a render target
+   * is still not instantiated, its contents are undefined, so the task is told to discard them and
+   * the render target is backed by a free texture of the same size and format if there is one.
+   */
+  void beforeExecute(size_t taskIndex, RenderTask* task);
+
+  /**
+   * Moves the textures of the transient render targets that are no longer referenced by any
+   * pending task to the free list. Must be called after the executed task is released.
+   */
+  void afterExecute();
+
+  /**
+   * Releases all render targets and free textures back to the resource cache.
+   */
+  void reset();
+
+ private:
+  struct TransientTarget {
+    std::shared_ptr<TextureProxy> proxy = nullptr;
+    size_t firstTaskIndex = 0;
+  };
+
+  Context* context = nullptr;
+  std::vector<TransientTarget> pendingTargets = {};
+  size_t pendingIndex = 0;
+  std::vector<std::shared_ptr<TextureProxy>> activeTargets = {};
+  std::vector<std::shared_ptr<TextureView>> freeTextures = {};
+
+  std::shared_ptr<TextureView> takeFreeTexture(const TextureProxy* proxy);
+};
+}  // namespace tgfx
@@ -18,6 +18,7 @@
 
 #include "GLSLProgramBuilder.h"
 #include <string>
+#include "gpu/GlobalCache.h"
 #include "gpu/UniformData.h"
 #include "tgfx/gpu/GPU.h"
 
@@ -104,8 +105,8 @@ static std::string SLTypeString(SLType t) {
   return "";
 }
 
-std::shared_ptr<Program> ProgramBuilder::CreateProgram(Context* context,
-                                                       const ProgramInfo* programInfo) {
+std::unique_ptr<ProgramSource> ProgramBuilder::CreateProgramSource(
+    Context* context, const ProgramInfo* programInfo) {
   GLSLProgramBuilder builder(context, programInfo);
   if (!builder.emitAndInstallProcessors()) {
     return nullptr;
@@ -167,25 +168,15 @@ std::string GLSLProgramBuilder::getUniformBlockDeclaration(
   return result;
 }
 
-std::shared_ptr<Program> GLSLProgramBuilder::finalize() {
+std::unique_ptr<ProgramSource> GLSLProgramBuilder::finalize() {
   fragmentShaderBuilder()->declareCustomOutputColor();
   finalizeShaders();
-  auto gpu = context->gpu();
-  ShaderModuleDescriptor vertexModule = {};
-  vertexModule.code = vertexShaderBuilder()->shaderString();
-  vertexModule.stage = ShaderStage::Vertex;
-  auto vertexShader = gpu->createShaderModule(vertexModule);
-  if (vertexShader == nullptr) {
-    return nullptr;
-  }
-  ShaderModuleDescriptor fragmentModule = {};
-  fragmentModule.code = fragmentShaderBuilder()->shaderString();
-  fragmentModule.stage = ShaderStage::Fragment;
-  auto fragmentShader = gpu->createShaderModule(fragmentModule);
-  if (fragmentShader == nullptr) {
-    return nullptr;
-  }
-  RenderPipelineDescriptor descriptor = {};
+  auto source = std::make_unique<ProgramSource>();
+  source->vertexModule.code = vertexShaderBuilder()->shaderString();
+  source->vertexModule.stage = ShaderStage::Vertex;
+  source->fragmentModule.code = fragmentShaderBuilder()->shaderString();
+  source->fragmentModule.stage = ShaderStage::Fragment;
+  auto& descriptor = source->descriptor;
   VertexBufferLayout vertexLayout(programInfo->getVertexAttributes());
   descriptor.vertex.bufferLayouts = {vertexLayout};
   auto& instanceAttributes = programInfo->getInstanceAttributes();
@@ -193,17 +184,15 @@ std::shared_ptr<Program> GLSLProgramBuilder::finalize() {
     VertexBufferLayout instanceLayout(instanceAttributes, VertexStepMode::Instance);
     descriptor.vertex.bufferLayouts.push_back(instanceLayout);
   }
-  descriptor.vertex.module = vertexShader;
-  descriptor.fragment.module = fragmentShader;
   descriptor.fragment.colorAttachments.push_back(programInfo->getPipelineColorAttachment());
-  auto vertexUniformData = _uniformHandler.makeUniformData(ShaderStage::Vertex);
-  auto fragmentUniformData = _uniformHandler.makeUniformData(ShaderStage::Fragment);
-  if (vertexUniformData) {
+  source->vertexUniformData = _uniformHandler.makeUniformData(ShaderStage::Vertex);
+  source->fragmentUniformData = _uniformHandler.makeUniformData(ShaderStage::Fragment);
+  if (source->vertexUniformData) {
     BindingEntry vertexBinding = {VertexUniformBlockName, VERTEX_UBO_BINDING_POINT,
                                   ShaderVisibility::Vertex};
     descriptor.layout.uniformBlocks.push_back(vertexBinding);
   }
-  if (fragmentUniformData) {
+  if (source->fragmentUniformData) {
     BindingEntry fragmentBinding = {FragmentUniformBlockName, FRAGMENT_UBO_BINDING_POINT,
                                     ShaderVisibility::Fragment};
     descriptor.layout.uniformBlocks.push_back(fragmentBinding);
@@ -224,12 +213,11 @@ std::shared_ptr<Program> GLSLProgramBuilder::finalize() {
   // construction leaves all stencil ops at Keep so existing draw ops which never opt into
   // stencil writes keep their previous behaviour.
   descriptor.depthStencil = programInfo->getDepthStencil();
-  auto pipeline = gpu->createRenderPipeline(descriptor);
-  if (pipeline == nullptr) {
-    return nullptr;
+  auto binaryCache = context->globalCache()->programBinaryCache();
+  if (binaryCache->enabled()) {
+    source->binaryKey = binaryCache->makeKey(source->vertexModule.code, source->fragmentModule.code);
   }
-  return std::make_shared<Program>(std::move(pipeline), std::move(vertexUniformData),
-                                   std::move(fragmentUniformData));
+  return source;
 }
 
 bool GLSLProgramBuilder::checkSamplerCounts() {
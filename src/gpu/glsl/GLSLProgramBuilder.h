@@ -35,7 +35,7 @@ class GLSLProgramBuilder : public ProgramBuilder {
  private:
   GLSLProgramBuilder(Context* context, const ProgramInfo* programInfo);
 
-  std::shared_ptr<Program> finalize();
+  std::unique_ptr<ProgramSource> finalize();
 
   UniformHandler* uniformHandler() override {
     return &_uniformHandler;
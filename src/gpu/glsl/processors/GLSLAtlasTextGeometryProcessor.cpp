@@ -17,19 +17,21 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GLSLAtlasTextGeometryProcessor.h"
+#include "core/DistanceFieldRasterizer.h"
 
 namespace tgfx {
 PlacementPtr<AtlasTextGeometryProcessor> AtlasTextGeometryProcessor::Make(
     BlockAllocator* allocator, std::shared_ptr<TextureProxy> textureProxy, AAType aa,
-    std::optional<PMColor> commonColor, const SamplingOptions& sampling) {
+    std::optional<PMColor> commonColor, const SamplingOptions& sampling, bool distanceField) {
   return allocator->make<GLSLAtlasTextGeometryProcessor>(std::move(textureProxy), aa, commonColor,
-                                                         sampling);
+                                                         sampling, distanceField);
 }
 
 GLSLAtlasTextGeometryProcessor::GLSLAtlasTextGeometryProcessor(
     std::shared_ptr<TextureProxy> textureProxy, AAType aa, std::optional<PMColor> commonColor,
-    const SamplingOptions& sampling)
-    : AtlasTextGeometryProcessor(std::move(textureProxy), aa, commonColor, sampling) {
+    const SamplingOptions& sampling, bool distanceField)
+    : AtlasTextGeometryProcessor(std::move(textureProxy), aa, commonColor, sampling,
+                                 distanceField) {
 }
 
 void GLSLAtlasTextGeometryProcessor::emitCode(EmitArgs& args) const {
@@ -48,6 +50,11 @@ void GLSLAtlasTextGeometryProcessor::emitCode(EmitArgs& args) const {
   auto uvName = maskCoord.name();
   vertBuilder->codeAppendf("%s = %s * %s;", samplerVarying.vsOut().c_str(), uvName.c_str(),
                            atlasName.c_str());
+  Varying distanceFieldCoord = {};
+  if (distanceField) {
+    distanceFieldCoord = varyingHandler->addVarying("DistanceFieldCoord", SLType::Float2);
+    vertBuilder->codeAppendf("%s = %s;", distanceFieldCoord.vsOut().c_str(), uvName.c_str());
+  }
 
   if (aa == AAType::Coverage) {
     auto coverageVar = varyingHandler->addVarying("Coverage", SLType::Float);
@@ -74,7 +81,19 @@ void GLSLAtlasTextGeometryProcessor::emitCode(EmitArgs& args) const {
   fragBuilder->codeAppend("vec4 color = ");
   fragBuilder->appendTextureLookup(samplerHandle, samplerVarying.vsOut());
   fragBuilder->codeAppend(";");
-  if (textureView->isAlphaOnly()) {
+  if (distanceField) {
+    // The field stores 0.5 on the glyph edge and changes by 0.5 / Padding per atlas pixel. Convert
+    // the distance to screen pixels with the screen-space derivatives of the atlas coordinates, so
+    // the edge stays one pixel wide at any scale.
+    fragBuilder->codeAppendf("float distance = (color.a - 0.5) * %.1f;",
+                             2.0f * static_cast<float>(DistanceFieldRasterizer::Padding));
+    fragBuilder->codeAppendf("vec2 dx = dFdx(%s);", distanceFieldCoord.fsIn().c_str());
+    fragBuilder->codeAppendf("vec2 dy = dFdy(%s);", distanceFieldCoord.fsIn().c_str());
+    fragBuilder->codeAppend("float texelsPerPixel = sqrt(0.5 * (dot(dx, dx) + dot(dy, dy)));");
+    fragBuilder->codeAppendf(
+        "%s = vec4(clamp(distance / max(texelsPerPixel, 0.0001) + 0.5, 0.0, 1.0));",
+        args.outputCoverage.c_str());
+  } else if (textureView->isAlphaOnly()) {
     fragBuilder->codeAppendf("%s = vec4(color.a);", args.outputCoverage.c_str());
   } else {
     fragBuilder->codeAppendf("%s = clamp(vec4(color.rgb/color.a, 1.0), 0.0, 1.0);",
@@ -68,6 +68,10 @@ void MetalCaps::initFeatureSet(id<MTLDevice> device) {
   // stencil attachment capability is unconditionally available.
   _features.stencilAttachmentSupported = true;
 
+  // MTLDevice is thread-safe, so shader libraries and pipeline states can be created on worker
+  // threads while the render thread keeps encoding.
+  _features.concurrentPipelineCreation = true;
+
   // Check for clamp to border support
 #if TARGET_OS_OSX
   if (@available(macOS 10.15, *)) {
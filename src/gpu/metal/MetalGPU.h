@@ -22,6 +22,7 @@
 #include <Metal/Metal.h>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include "MetalCaps.h"
 #include "core/utils/ReturnQueue.h"
@@ -150,6 +151,8 @@ class MetalGPU : public GPU {
   // compilations. The win is not the Compiler object itself, which is lightweight, but avoiding
   // repeated rebuilds of glslang's global built-in symbol tables after init/finalize churn.
   std::unique_ptr<shaderc::Compiler> compiler;
+  // Guards the resources list, which pipelines compiled on worker threads also append to.
+  std::mutex resourceLocker = {};
   std::list<MetalResource*> resources = {};
   std::shared_ptr<ReturnQueue> returnQueue = ReturnQueue::Make();
   CVMetalTextureCacheRef textureCache = nil;
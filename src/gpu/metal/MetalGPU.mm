@@ -239,15 +239,21 @@ BackendSemaphore MetalGPU::stealBackendSemaphore(std::shared_ptr<Semaphore> sema
 
 std::shared_ptr<MetalResource> MetalGPU::addResource(MetalResource* resource) {
   DEBUG_ASSERT(resource != nullptr);
-  resources.push_back(resource);
-  resource->cachedPosition = --resources.end();
+  {
+    std::lock_guard<std::mutex> autoLock(resourceLocker);
+    resources.push_back(resource);
+    resource->cachedPosition = --resources.end();
+  }
   return std::static_pointer_cast<MetalResource>(returnQueue->makeShared(resource));
 }
 
 void MetalGPU::processUnreferencedResources() {
   DEBUG_ASSERT(returnQueue != nullptr);
   while (auto resource = static_cast<MetalResource*>(returnQueue->dequeue())) {
-    resources.erase(resource->cachedPosition);
+    {
+      std::lock_guard<std::mutex> autoLock(resourceLocker);
+      resources.erase(resource->cachedPosition);
+    }
     resource->onRelease(this);
     delete resource;
   }
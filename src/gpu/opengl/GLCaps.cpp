@@ -208,7 +208,16 @@ void GLCaps::initGLSupport(const GLInfo& info) {
       (version >= GL_VER(4, 5) || info.hasExtension("GL_ARB_texture_barrier") ||
        info.hasExtension("GL_NV_texture_barrier"));
   _features.clampToBorder = true;
+  _features.textureCompressionETC2 =
+      version >= GL_VER(4, 3) || info.hasExtension("GL_ARB_ES3_compatibility");
+  _features.textureCompressionBC = info.hasExtension("GL_EXT_texture_compression_s3tc");
+  _features.textureCompressionASTC = info.hasExtension("GL_KHR_texture_compression_astc_ldr");
   frameBufferFetchRequiresEnablePerSample = false;
+  if (version >= GL_VER(4, 1) || info.hasExtension("GL_ARB_get_program_binary")) {
+    int binaryFormatCount = 0;
+    info.getIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+    programBinarySupport = binaryFormatCount > 0;
+  }
 }
 
 void GLCaps::initGLESSupport(const GLInfo& info) {
@@ -219,17 +228,30 @@ void GLCaps::initGLESSupport(const GLInfo& info) {
                             info.hasExtension("GL_EXT_texture_border_clamp") ||
                             info.hasExtension("GL_NV_texture_border_clamp") ||
                             info.hasExtension("GL_OES_texture_border_clamp");
+  // ETC2 and EAC are core features of OpenGL ES 3.0.
+  _features.textureCompressionETC2 = true;
+  _features.textureCompressionBC = info.hasExtension("GL_EXT_texture_compression_s3tc");
+  _features.textureCompressionASTC = info.hasExtension("GL_KHR_texture_compression_astc_ldr");
   // The ARM extension requires enabling MSAA fetching on a per-sample basis.
   // This can hurt performance on some devices and disables multiple render targets.
   frameBufferFetchRequiresEnablePerSample = info.hasExtension("GL_ARM_shader_framebuffer_fetch");
+  if (version >= GL_VER(3, 0) || info.hasExtension("GL_OES_get_program_binary")) {
+    int binaryFormatCount = 0;
+    info.getIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+    programBinarySupport = binaryFormatCount > 0;
+  }
 }
 
-void GLCaps::initWebGLSupport(const GLInfo&) {
+void GLCaps::initWebGLSupport(const GLInfo& info) {
   multisampleDisableSupport = false;
   sampleMaskSupport = false;
   frameBufferFetchRequiresEnablePerSample = false;
+  programBinarySupport = false;
   _features.textureBarrier = false;
   _features.clampToBorder = false;
+  _features.textureCompressionETC2 = info.hasExtension("GL_WEBGL_compressed_texture_etc");
+  _features.textureCompressionBC = info.hasExtension("GL_WEBGL_compressed_texture_s3tc");
+  _features.textureCompressionASTC = info.hasExtension("GL_WEBGL_compressed_texture_astc");
 }
 
 void GLCaps::initFormatMap(const GLInfo& info) {
@@ -258,6 +280,13 @@ void GLCaps::initFormatMap(const GLInfo& info) {
   RGFormat.format.externalFormat = GL_RG;
   RGFormat.format.externalType = GL_UNSIGNED_BYTE;
 
+  // Compressed formats have no external format, since their data is uploaded untouched.
+  pixelFormatMap[PixelFormat::ETC2_RGB8].format.sizedFormat = GL_COMPRESSED_RGB8_ETC2;
+  pixelFormatMap[PixelFormat::ETC2_RGBA8].format.sizedFormat = GL_COMPRESSED_RGBA8_ETC2;
+  pixelFormatMap[PixelFormat::BC1_RGB].format.sizedFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+  pixelFormatMap[PixelFormat::BC3_RGBA].format.sizedFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+  pixelFormatMap[PixelFormat::ASTC_4x4].format.sizedFormat = GL_COMPRESSED_RGBA_ASTC_4x4;
+
   bool useSizedRbFormats = standard == GLStandard::GLES || standard == GLStandard::WebGL;
   for (auto& item : pixelFormatMap) {
     auto& format = item.second.format;
@@ -82,6 +82,8 @@ class GLCaps {
   bool sampleMaskSupport = false;
   bool frameBufferFetchRequiresEnablePerSample = false;
   bool flushBeforeWritePixels = false;
+  // Whether linked programs can be retrieved with glGetProgramBinary and reloaded later.
+  bool programBinarySupport = false;
 
   explicit GLCaps(const GLInfo& info);
 
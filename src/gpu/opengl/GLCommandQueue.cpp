@@ -60,6 +60,17 @@ void GLCommandQueue::writeTexture(std::shared_ptr<Texture> texture, const Rect&
   auto state = gpu->state();
   state->bindTexture(glTexture);
   const auto& textureFormat = caps->getTextureFormat(glTexture->format());
+  if (IsCompressedPixelFormat(glTexture->format())) {
+    // Compressed blocks are uploaded as they are, and the rows must be tightly packed.
+    auto width = static_cast<int>(rect.width());
+    auto height = static_cast<int>(rect.height());
+    auto blockRows = static_cast<size_t>((height + 3) / 4);
+    gl->compressedTexSubImage2D(glTexture->target(), 0, static_cast<int>(rect.x()),
+                                static_cast<int>(rect.y()), width, height,
+                                textureFormat.internalFormatTexImage,
+                                static_cast<int>(rowBytes * blockRows), pixels);
+    return;
+  }
   auto bytesPerPixel = PixelFormatBytesPerPixel(glTexture->format());
   gl->pixelStorei(GL_UNPACK_ALIGNMENT, static_cast<int>(bytesPerPixel));
   int x = static_cast<int>(rect.x());
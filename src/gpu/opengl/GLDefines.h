@@ -822,6 +822,8 @@ namespace tgfx {
 
 // Program Binary
 #define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
 
 // Shader Precision-Specified Types
 #define GL_LOW_FLOAT 0x8DF0
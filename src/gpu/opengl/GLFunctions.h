@@ -62,6 +62,14 @@ using GLClearStencil = void GL_FUNCTION_TYPE(int s);
 using GLColorMask = void GL_FUNCTION_TYPE(unsigned char red, unsigned char green,
                                           unsigned char blue, unsigned char alpha);
 using GLCompileShader = void GL_FUNCTION_TYPE(unsigned shader);
+using GLCompressedTexImage2D = void GL_FUNCTION_TYPE(unsigned target, int level,
+                                                     unsigned internalformat, int width,
+                                                     int height, int border, int imageSize,
+                                                     const void* data);
+using GLCompressedTexSubImage2D = void GL_FUNCTION_TYPE(unsigned target, int level, int xoffset,
+                                                        int yoffset, int width, int height,
+                                                        unsigned format, int imageSize,
+                                                        const void* data);
 using GLCopyTexSubImage2D = void GL_FUNCTION_TYPE(unsigned target, int level, int xoffset,
                                                   int yoffset, int x, int y, int width, int height);
 using GLCreateProgram = unsigned GL_FUNCTION_TYPE();
@@ -111,6 +119,11 @@ using GLGetInternalformativ = void GL_FUNCTION_TYPE(unsigned target, unsigned in
 using GLGetProgramInfoLog = void GL_FUNCTION_TYPE(unsigned program, int bufsize, int* length,
                                                   char* infolog);
 using GLGetProgramiv = void GL_FUNCTION_TYPE(unsigned program, unsigned pname, int* params);
+using GLGetProgramBinary = void GL_FUNCTION_TYPE(unsigned program, int bufSize, int* length,
+                                                 unsigned* binaryFormat, void* binary);
+using GLProgramBinary = void GL_FUNCTION_TYPE(unsigned program, unsigned binaryFormat,
+                                              const void* binary, int length);
+using GLProgramParameteri = void GL_FUNCTION_TYPE(unsigned program, unsigned pname, int value);
 using GLGetShaderInfoLog = void GL_FUNCTION_TYPE(unsigned shader, int bufsize, int* length,
                                                  char* infolog);
 using GLGetShaderiv = void GL_FUNCTION_TYPE(unsigned shader, unsigned pname, int* params);
@@ -210,6 +223,8 @@ class GLFunctions {
   GLClearStencil* clearStencil = nullptr;
   GLColorMask* colorMask = nullptr;
   GLCompileShader* compileShader = nullptr;
+  GLCompressedTexImage2D* compressedTexImage2D = nullptr;
+  GLCompressedTexSubImage2D* compressedTexSubImage2D = nullptr;
   GLCopyTexSubImage2D* copyTexSubImage2D = nullptr;
   GLCreateProgram* createProgram = nullptr;
   GLCreateShader* createShader = nullptr;
@@ -249,6 +264,9 @@ class GLFunctions {
   GLGetInternalformativ* getInternalformativ = nullptr;
   GLGetProgramInfoLog* getProgramInfoLog = nullptr;
   GLGetProgramiv* getProgramiv = nullptr;
+  GLGetProgramBinary* getProgramBinary = nullptr;
+  GLProgramBinary* programBinary = nullptr;
+  GLProgramParameteri* programParameteri = nullptr;
   GLGetShaderInfoLog* getShaderInfoLog = nullptr;
   GLGetShaderiv* getShaderiv = nullptr;
   GLGetShaderPrecisionFormat* getShaderPrecisionFormat = nullptr;
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GLGPU.h"
+#include "core/utils/PixelFormatUtil.h"
 #include "gpu/opengl/GLBuffer.h"
 #if defined(__EMSCRIPTEN__)
 #include "gpu/opengl/webgl/WebGLBuffer.h"
@@ -30,6 +31,7 @@
 #include "gpu/opengl/GLSemaphore.h"
 #include "gpu/opengl/GLShaderModule.h"
 #include "gpu/opengl/GLUtil.h"
+#include "tgfx/core/Buffer.h"
 
 namespace tgfx {
 GLGPU::GLGPU(std::shared_ptr<GLInterface> glInterface)
@@ -101,6 +103,25 @@ std::shared_ptr<Texture> GLGPU::createTexture(const TextureDescriptor& descripto
   _state->bindTexture(texture.get());
   auto& textureFormat = interface->caps()->getTextureFormat(descriptor.format);
   bool success = true;
+  if (IsCompressedPixelFormat(descriptor.format)) {
+    // glCompressedTexImage2D() does not accept null data on every platform, so the storage is
+    // allocated with zeroed blocks and written later by glCompressedTexSubImage2D().
+    auto dataSize = PixelFormatDataSize(descriptor.format, descriptor.width, descriptor.height);
+    Buffer emptyBlocks(dataSize);
+    if (emptyBlocks.isEmpty()) {
+      return nullptr;
+    }
+    emptyBlocks.clear();
+    for (int level = 0; level < descriptor.mipLevelCount && success; level++) {
+      auto currentWidth = std::max(1, descriptor.width >> level);
+      auto currentHeight = std::max(1, descriptor.height >> level);
+      auto levelSize = PixelFormatDataSize(descriptor.format, currentWidth, currentHeight);
+      gl->compressedTexImage2D(target, level, textureFormat.internalFormatTexImage, currentWidth,
+                               currentHeight, 0, static_cast<int>(levelSize), emptyBlocks.bytes());
+      success = CheckGLError(gl);
+    }
+    return success ? texture : nullptr;
+  }
   // Texture memory must be allocated first on the web platform then can write pixels.
   for (int level = 0; level < descriptor.mipLevelCount && success; level++) {
     auto twoToTheMipLevel = 1 << level;
@@ -277,6 +298,9 @@ std::shared_ptr<RenderPipeline> GLGPU::createRenderPipeline(
   }
   auto gl = interface->functions();
   auto programID = gl->createProgram();
+  if (caps()->programBinarySupport && gl->programParameteri != nullptr) {
+    gl->programParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
   gl->attachShader(programID, vertexModule->shader());
   gl->attachShader(programID, fragmentModule->shader());
   gl->linkProgram(programID);
@@ -298,6 +322,64 @@ std::shared_ptr<RenderPipeline> GLGPU::createRenderPipeline(
   return pipeline;
 }
 
+std::shared_ptr<Data> GLGPU::getPipelineBinary(const RenderPipeline* pipeline) {
+  if (pipeline == nullptr || !caps()->programBinarySupport) {
+    return nullptr;
+  }
+  auto programID = static_cast<const GLRenderPipeline*>(pipeline)->programID;
+  if (programID == 0) {
+    return nullptr;
+  }
+  auto gl = interface->functions();
+  int binaryLength = 0;
+  gl->getProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+  if (binaryLength <= 0) {
+    return nullptr;
+  }
+  // The binary format is stored in front of the driver blob, since it is required to reload it.
+  Buffer buffer(sizeof(unsigned) + static_cast<size_t>(binaryLength));
+  unsigned binaryFormat = 0;
+  int length = 0;
+  gl->getProgramBinary(programID, binaryLength, &length, &binaryFormat,
+                       buffer.bytes() + sizeof(unsigned));
+  if (length <= 0) {
+    return nullptr;
+  }
+  memcpy(buffer.data(), &binaryFormat, sizeof(unsigned));
+  return Data::MakeWithCopy(buffer.data(), sizeof(unsigned) + static_cast<size_t>(length));
+}
+
+std::shared_ptr<RenderPipeline> GLGPU::createRenderPipelineFromBinary(
+    const RenderPipelineDescriptor& descriptor, const Data* binary) {
+  if (binary == nullptr || binary->size() <= sizeof(unsigned) || !caps()->programBinarySupport) {
+    return nullptr;
+  }
+  if (descriptor.vertex.bufferLayouts.empty() || descriptor.vertex.bufferLayouts[0].stride == 0 ||
+      descriptor.fragment.colorAttachments.size() != 1) {
+    LOGE("GLGPU::createRenderPipelineFromBinary() invalid pipeline descriptor!");
+    return nullptr;
+  }
+  auto gl = interface->functions();
+  unsigned binaryFormat = 0;
+  memcpy(&binaryFormat, binary->data(), sizeof(unsigned));
+  auto programID = gl->createProgram();
+  gl->programBinary(programID, binaryFormat, binary->bytes() + sizeof(unsigned),
+                    static_cast<int>(binary->size() - sizeof(unsigned)));
+  // Drivers reject binaries produced by a different driver version, so the link status must always
+  // be checked here, even in release builds.
+  int success = 0;
+  gl->getProgramiv(programID, GL_LINK_STATUS, &success);
+  if (!success) {
+    gl->deleteProgram(programID);
+    return nullptr;
+  }
+  auto pipeline = makeResource<GLRenderPipeline>(programID);
+  if (!pipeline->setPipelineDescriptor(this, descriptor)) {
+    return nullptr;
+  }
+  return pipeline;
+}
+
 std::shared_ptr<CommandEncoder> GLGPU::createCommandEncoder() {
   processUnreferencedResources();
   return std::make_shared<GLCommandEncoder>(this);
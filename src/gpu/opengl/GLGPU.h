@@ -91,6 +91,11 @@ class GLGPU : public GPU {
   std::shared_ptr<RenderPipeline> createRenderPipeline(
       const RenderPipelineDescriptor& descriptor) override;
 
+  std::shared_ptr<Data> getPipelineBinary(const RenderPipeline* pipeline) override;
+
+  std::shared_ptr<RenderPipeline> createRenderPipelineFromBinary(
+      const RenderPipelineDescriptor& descriptor, const Data* binary) override;
+
   std::shared_ptr<CommandEncoder> createCommandEncoder() override;
 
   void processUnreferencedResources();
@@ -105,6 +105,10 @@ std::shared_ptr<GLInterface> GLInterface::MakeNativeInterface(const GLProcGetter
   functions->colorMask = reinterpret_cast<GLColorMask*>(getter->getProcAddress("glColorMask"));
   functions->compileShader =
       reinterpret_cast<GLCompileShader*>(getter->getProcAddress("glCompileShader"));
+  functions->compressedTexImage2D = reinterpret_cast<GLCompressedTexImage2D*>(
+      getter->getProcAddress("glCompressedTexImage2D"));
+  functions->compressedTexSubImage2D = reinterpret_cast<GLCompressedTexSubImage2D*>(
+      getter->getProcAddress("glCompressedTexSubImage2D"));
   functions->copyTexSubImage2D =
       reinterpret_cast<GLCopyTexSubImage2D*>(getter->getProcAddress("glCopyTexSubImage2D"));
   functions->createProgram =
@@ -250,6 +254,14 @@ std::shared_ptr<GLInterface> GLInterface::MakeNativeInterface(const GLProcGetter
 
   switch (info.standard) {
     case GLStandard::GL:
+      if (info.version >= GL_VER(4, 1) || info.hasExtension("GL_ARB_get_program_binary")) {
+        functions->getProgramBinary =
+            reinterpret_cast<GLGetProgramBinary*>(getter->getProcAddress("glGetProgramBinary"));
+        functions->programBinary =
+            reinterpret_cast<GLProgramBinary*>(getter->getProcAddress("glProgramBinary"));
+        functions->programParameteri =
+            reinterpret_cast<GLProgramParameteri*>(getter->getProcAddress("glProgramParameteri"));
+      }
       if (info.version >= GL_VER(4, 5) || info.hasExtension("GL_ARB_texture_barrier")) {
         functions->textureBarrier =
             reinterpret_cast<GLTextureBarrier*>(getter->getProcAddress("glTextureBarrier"));
@@ -259,6 +271,19 @@ std::shared_ptr<GLInterface> GLInterface::MakeNativeInterface(const GLProcGetter
       }
       break;
     case GLStandard::GLES:
+      if (info.version >= GL_VER(3, 0)) {
+        functions->getProgramBinary =
+            reinterpret_cast<GLGetProgramBinary*>(getter->getProcAddress("glGetProgramBinary"));
+        functions->programBinary =
+            reinterpret_cast<GLProgramBinary*>(getter->getProcAddress("glProgramBinary"));
+        functions->programParameteri =
+            reinterpret_cast<GLProgramParameteri*>(getter->getProcAddress("glProgramParameteri"));
+      } else if (info.hasExtension("GL_OES_get_program_binary")) {
+        functions->getProgramBinary =
+            reinterpret_cast<GLGetProgramBinary*>(getter->getProcAddress("glGetProgramBinaryOES"));
+        functions->programBinary =
+            reinterpret_cast<GLProgramBinary*>(getter->getProcAddress("glProgramBinaryOES"));
+      }
       if (info.hasExtension("GL_NV_texture_barrier")) {
         functions->textureBarrier =
             reinterpret_cast<GLTextureBarrier*>(getter->getProcAddress("glTextureBarrierNV"));
@@ -271,6 +296,9 @@ std::shared_ptr<GLInterface> GLInterface::MakeNativeInterface(const GLProcGetter
       break;
   }
   auto caps = std::make_unique<GLCaps>(info);
+  if (functions->getProgramBinary == nullptr || functions->programBinary == nullptr) {
+    caps->programBinarySupport = false;
+  }
   return std::shared_ptr<GLInterface>(new GLInterface(std::move(caps), std::move(functions)));
 }
 }  // namespace tgfx
@@ -30,14 +30,15 @@ PlacementPtr<AtlasTextOp> AtlasTextOp::Make(Context* context,
                                             PlacementPtr<RectsVertexProvider> provider,
                                             uint32_t renderFlags,
                                             std::shared_ptr<TextureProxy> textureProxy,
-                                            const SamplingOptions& sampling) {
+                                            const SamplingOptions& sampling, bool distanceField) {
   if (provider == nullptr || textureProxy == nullptr || textureProxy->width() <= 0 ||
       textureProxy->height() <= 0) {
     return nullptr;
   }
   auto allocator = context->drawingAllocator();
   auto atlasTextOp =
-      allocator->make<AtlasTextOp>(allocator, provider.get(), std::move(textureProxy), sampling);
+      allocator->make<AtlasTextOp>(allocator, provider.get(), std::move(textureProxy), sampling,
+                                   distanceField);
   if (provider->aaType() == AAType::Coverage || provider->rectCount() > 1) {
     atlasTextOp->indexBufferProxy = context->globalCache()->getRectIndexBuffer(
         provider->aaType() == AAType::Coverage, std::nullopt);
@@ -53,16 +54,17 @@ PlacementPtr<AtlasTextOp> AtlasTextOp::Make(Context* context,
 
 AtlasTextOp::AtlasTextOp(BlockAllocator* allocator, RectsVertexProvider* provider,
                          std::shared_ptr<TextureProxy> textureProxy,
-                         const SamplingOptions& sampling)
+                         const SamplingOptions& sampling, bool distanceField)
     : StandardDrawOp(allocator, provider->aaType()), rectCount(provider->rectCount()),
-      textureProxy(std::move(textureProxy)), sampling(sampling) {
+      textureProxy(std::move(textureProxy)), sampling(sampling), distanceField(distanceField) {
   if (!provider->hasColor()) {
     commonColor = ToPMColor(provider->firstColor(), provider->dstColorSpace());
   }
 }
 
 PlacementPtr<GeometryProcessor> AtlasTextOp::onMakeGeometryProcessor(RenderTarget*) {
-  return AtlasTextGeometryProcessor::Make(allocator, textureProxy, aaType, commonColor, sampling);
+  return AtlasTextGeometryProcessor::Make(allocator, textureProxy, aaType, commonColor, sampling,
+                                          distanceField);
 }
 
 void AtlasTextOp::onDraw(RenderPass* renderPass, RenderTarget* /*renderTarget*/) {
@@ -26,6 +26,8 @@
 #include "tgfx/gpu/RenderPass.h"
 
 namespace tgfx {
+class Program;
+
 /**
  * DrawOp is the minimal contract every deferred draw operation must satisfy. It exposes only
  * what OpsRenderTask needs to schedule an op inside a render pass: an execute() entry point,
@@ -118,6 +120,15 @@ class DrawOp {
    */
   virtual void execute(RenderPass* renderPass, RenderTarget* renderTarget) = 0;
 
+  /**
+   * Returns the program bound by the last call to execute(), which OpsRenderTask compares across
+   * consecutive ops to count program switches. Returns nullptr if the op bound no program or
+   * binds several programs within one execute() call.
+   */
+  virtual const Program* boundProgram() const {
+    return nullptr;
+  }
+
  protected:
   BlockAllocator* allocator = nullptr;
   AAType aaType = AAType::None;
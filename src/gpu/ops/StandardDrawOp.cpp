@@ -57,13 +57,19 @@ bool StandardDrawOp::bindStandardPipeline(RenderPass* renderPass, RenderTarget*
     programInfo.setDepthStencil(depthStencil);
   }
   onConfigureProgramInfo(programInfo);
-  auto program = programInfo.getProgram();
-  if (program == nullptr) {
-    LOGE("StandardDrawOp::bindStandardPipeline() Failed to get the program!");
+  // Standalone draws can be skipped safely while their programs compile in the background. Ops
+  // with several dependent passes (e.g. stencil-and-cover) keep compiling synchronously.
+  bool deferred = false;
+  auto shaderProgram = programInfo.getProgram(&deferred);
+  if (shaderProgram == nullptr) {
+    if (!deferred) {
+      LOGE("StandardDrawOp::bindStandardPipeline() Failed to get the program!");
+    }
     return false;
   }
-  renderPass->setPipeline(program->getPipeline());
-  programInfo.setUniformsAndSamplers(renderPass, program.get());
+  program = shaderProgram.get();
+  renderPass->setPipeline(shaderProgram->getPipeline());
+  programInfo.setUniformsAndSamplers(renderPass, shaderProgram.get());
   applyScissor(renderPass, renderTarget);
   return true;
 }
@@ -41,6 +41,10 @@ class StandardDrawOp : public DrawOp {
  public:
   void execute(RenderPass* renderPass, RenderTarget* renderTarget) final;
 
+  const Program* boundProgram() const override {
+    return program;
+  }
+
  protected:
   StandardDrawOp(BlockAllocator* allocator, AAType aaType) : DrawOp(allocator, aaType) {
   }
@@ -90,5 +94,7 @@ class StandardDrawOp : public DrawOp {
    * creation fails, in which case execute() aborts before calling onDraw().
    */
   bool bindStandardPipeline(RenderPass* renderPass, RenderTarget* renderTarget);
+
+  const Program* program = nullptr;
 };
 }  // namespace tgfx
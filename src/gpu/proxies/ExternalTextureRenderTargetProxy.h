@@ -22,6 +22,12 @@
 
 namespace tgfx {
 class ExternalTextureRenderTargetProxy : public TextureRenderTargetProxy {
+ public:
+  bool isTransient() const override {
+    // The texture is always wrapped from the backend texture, even if it is adopted.
+    return false;
+  }
+
  protected:
   std::shared_ptr<TextureView> onMakeTexture(Context* context) const override;
 
@@ -96,6 +96,15 @@ class RenderTargetProxy {
    */
   virtual bool externallyOwned() const = 0;
 
+  /**
+   * Returns true if the render target is not instantiated yet, has no unique key, and will
+   * allocate its texture from the resource cache. Such a render target may be backed by the texture
+   * of another transient render target in the same frame whose contents are no longer needed.
+   */
+  virtual bool isTransient() const {
+    return false;
+  }
+
   /**
    * Returns a reference to the underlying TextureProxy representation of this render target, may be
    * nullptr.
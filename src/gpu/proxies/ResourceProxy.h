@@ -59,5 +59,6 @@ class ResourceProxy {
   friend class ProxyProvider;
   friend class GPUHairlineProxy;
   friend class HairlineBufferUploadTask;
+  friend class TransientTargetAllocator;
 };
 }  // namespace tgfx
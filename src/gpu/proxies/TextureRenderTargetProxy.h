@@ -54,6 +54,10 @@ class TextureRenderTargetProxy : public DefaultTextureProxy,
     return _externallyOwned;
   }
 
+  bool isTransient() const override {
+    return !_externallyOwned && uniqueKey.empty() && resource == nullptr;
+  }
+
   std::shared_ptr<TextureProxy> asTextureProxy() const override {
     return std::const_pointer_cast<TextureRenderTargetProxy>(shared_from_this());
   }
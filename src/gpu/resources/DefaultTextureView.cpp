@@ -29,8 +29,7 @@ size_t DefaultTextureView::memoryUsage() const {
   if (auto hardwareBuffer = _texture->getHardwareBuffer()) {
     return GetImageInfo(hardwareBuffer).byteSize();
   }
-  auto colorSize = static_cast<size_t>(width()) * static_cast<size_t>(height()) *
-                   PixelFormatBytesPerPixel(_texture->format());
+  auto colorSize = PixelFormatDataSize(_texture->format(), width(), height());
   return _texture->mipLevelCount() > 1 ? colorSize * 4 / 3 : colorSize;
 }
 }  // namespace tgfx
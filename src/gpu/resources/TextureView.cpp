@@ -84,10 +84,49 @@ std::shared_ptr<TextureView> TextureView::MakeFormat(Context* context, int width
   if (pixels != nullptr) {
     auto texture = textureView->getTexture();
     gpu->queue()->writeTexture(texture, Rect::MakeWH(width, height), pixels, rowBytes);
+    context->currentFrameStats()->uploadedBytes += rowBytes * static_cast<size_t>(height);
   }
   return textureView;
 }
 
+std::shared_ptr<TextureView> TextureView::MakeCompressed(Context* context, int width, int height,
+                                                         const void* data, size_t length,
+                                                         PixelFormat pixelFormat,
+                                                         ImageOrigin origin) {
+  if (context == nullptr || width < 1 || height < 1 || data == nullptr ||
+      length < PixelFormatDataSize(pixelFormat, width, height)) {
+    return nullptr;
+  }
+  auto gpu = context->gpu();
+  if (!IsCompressedFormatSupported(gpu->features(), pixelFormat)) {
+    return nullptr;
+  }
+  auto maxTextureSize = gpu->limits()->maxTextureDimension2D;
+  if (width > maxTextureSize || height > maxTextureSize) {
+    return nullptr;
+  }
+  auto scratchKey = ComputeTextureScratchKey(width, height, pixelFormat, false);
+  auto textureView = Resource::Find<TextureView>(context, scratchKey);
+  if (textureView) {
+    textureView->_origin = origin;
+  } else {
+    TextureDescriptor descriptor = {width, height, pixelFormat,
+                                    false, 1,      TextureUsage::TEXTURE_BINDING};
+    auto texture = gpu->createTexture(descriptor);
+    if (texture == nullptr) {
+      return nullptr;
+    }
+    textureView = Resource::AddToCache(context, new DefaultTextureView(std::move(texture), origin),
+                                       scratchKey);
+  }
+  auto rowBytes = static_cast<size_t>((width + 3) / 4) * CompressedBlockBytes(pixelFormat);
+  gpu->queue()->writeTexture(textureView->getTexture(), Rect::MakeWH(width, height), data,
+                             rowBytes);
+  context->currentFrameStats()->uploadedBytes +=
+      rowBytes * static_cast<size_t>((height + 3) / 4);
+  return textureView;
+}
+
 std::shared_ptr<TextureView> TextureView::MakeFrom(Context* context,
                                                    const BackendTexture& backendTexture,
                                                    ImageOrigin origin, bool adopted) {
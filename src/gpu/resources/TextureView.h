@@ -114,6 +114,17 @@ class TextureView : public Resource {
                                                  PixelFormat pixelFormat, bool mipmapped = false,
                                                  ImageOrigin origin = ImageOrigin::TopLeft);
 
+  /**
+   * Creates a new texture view from the specified block-compressed data, which is uploaded to the
+   * GPU untouched. The data must contain whole 4x4 blocks tightly packed in rows. Compressed
+   * textures can only be sampled and have no mipmaps. Returns nullptr if any of the parameters is
+   * invalid or the GPU does not support the compressed pixelFormat.
+   */
+  static std::shared_ptr<TextureView> MakeCompressed(Context* context, int width, int height,
+                                                     const void* data, size_t length,
+                                                     PixelFormat pixelFormat,
+                                                     ImageOrigin origin = ImageOrigin::TopLeft);
+
   /**
    * Creates a new texture view which wraps the specified backend texture. The caller must ensure
    * the backend texture is valid for the lifetime of returned TextureView.
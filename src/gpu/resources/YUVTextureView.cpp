@@ -41,8 +41,9 @@ static std::vector<std::shared_ptr<Texture>> MakeTexturePlanes(GPU* gpu, const Y
   return texturePlanes;
 }
 
-static void SubmitYUVTexture(GPU* gpu, const YUVData* yuvData,
+static void SubmitYUVTexture(Context* context, const YUVData* yuvData,
                              std::shared_ptr<Texture> textures[]) {
+  auto gpu = context->gpu();
   auto count = yuvData->planeCount();
   for (size_t index = 0; index < count; index++) {
     auto& texture = textures[index];
@@ -51,6 +52,7 @@ static void SubmitYUVTexture(GPU* gpu, const YUVData* yuvData,
     auto pixels = yuvData->getBaseAddressAt(index);
     auto rowBytes = yuvData->getRowBytesAt(index);
     gpu->queue()->writeTexture(texture, Rect::MakeWH(w, h), pixels, rowBytes);
+    context->currentFrameStats()->uploadedBytes += rowBytes * static_cast<size_t>(h);
     // YUV textures do not support mipmaps, so we don't need to regenerate mipmaps.
   }
 }
@@ -70,7 +72,7 @@ std::shared_ptr<TextureView> TextureView::MakeI420(Context* context, const YUVDa
   auto yuvTexture = new YUVTextureView(std::move(texturePlanes), YUVFormat::I420, colorSpace);
   auto texture =
       std::static_pointer_cast<YUVTextureView>(Resource::AddToCache(context, yuvTexture));
-  SubmitYUVTexture(context->gpu(), yuvData, texture->textures.data());
+  SubmitYUVTexture(context, yuvData, texture->textures.data());
   return texture;
 }
 
@@ -88,7 +90,7 @@ std::shared_ptr<TextureView> TextureView::MakeNV12(Context* context, const YUVDa
   auto yuvTexture = new YUVTextureView(std::move(texturePlanes), YUVFormat::NV12, colorSpace);
   auto texture =
       std::static_pointer_cast<YUVTextureView>(Resource::AddToCache(context, yuvTexture));
-  SubmitYUVTexture(context->gpu(), yuvData, texture->textures.data());
+  SubmitYUVTexture(context, yuvData, texture->textures.data());
   return texture;
 }
 
@@ -0,0 +1,62 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "AnimatedFrameUploadTask.h"
+#include "tgfx/gpu/GPU.h"
+
+namespace tgfx {
+AnimatedFrameUploadTask::AnimatedFrameUploadTask(std::shared_ptr<TextureProxy> proxy,
+                                                 std::shared_ptr<AnimatedTextureState> state,
+                                                 std::shared_ptr<AnimatedCodec> codec,
+                                                 int frameIndex, std::shared_ptr<Data> pixels)
+    : ResourceTask(proxy), textureProxy(std::move(proxy)), state(std::move(state)),
+      codec(std::move(codec)), frameIndex(frameIndex), pixels(std::move(pixels)) {
+}
+
+bool AnimatedFrameUploadTask::execute(Context* context) {
+  // The texture is created on first use and then kept across frames, so the proxy is instantiated
+  // here rather than through onMakeResource().
+  auto textureView = textureProxy->getTextureView();
+  if (textureView == nullptr) {
+    LOGE("AnimatedFrameUploadTask::execute() Failed to create the texture view!");
+    return false;
+  }
+  std::lock_guard<std::mutex> autoLock(state->locker);
+  auto dirtyBounds = Rect::MakeWH(codec->width(), codec->height());
+  if (state->texture.lock() == textureView) {
+    dirtyBounds = codec->getDirtyBounds(state->residentFrame, frameIndex);
+  }
+  if (!dirtyBounds.isEmpty()) {
+    auto rowBytes = static_cast<size_t>(codec->width()) * 4;
+    auto offset = static_cast<size_t>(dirtyBounds.top) * rowBytes +
+                  static_cast<size_t>(dirtyBounds.left) * 4;
+    context->gpu()->queue()->writeTexture(textureView->getTexture(), dirtyBounds,
+                                          pixels->bytes() + offset, rowBytes);
+    context->currentFrameStats()->uploadedBytes +=
+        static_cast<size_t>(dirtyBounds.width() * dirtyBounds.height()) * 4;
+  }
+  state->texture = textureView;
+  state->residentFrame = frameIndex;
+  pixels = nullptr;
+  return true;
+}
+
+std::shared_ptr<Resource> AnimatedFrameUploadTask::onMakeResource(Context*) {
+  return nullptr;
+}
+}  // namespace tgfx
@@ -0,0 +1,64 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <mutex>
+#include "ResourceTask.h"
+#include "gpu/proxies/TextureProxy.h"
+#include "tgfx/core/AnimatedCodec.h"
+
+namespace tgfx {
+/**
+ * AnimatedTextureState tracks the texture shared by all frame images of an AnimatedCodec.
+ */
+struct AnimatedTextureState {
+  std::mutex locker = {};
+  UniqueKey uniqueKey = UniqueKey::Make();
+  // The texture and the frame it currently holds. Any other texture needs a full upload.
+  std::weak_ptr<TextureView> texture;
+  int residentFrame = -1;
+  // The proxy used by the draws recorded since the last flush, and the frame they show.
+  std::weak_ptr<TextureProxy> pendingProxy;
+  int pendingFrame = -1;
+};
+
+/**
+ * AnimatedFrameUploadTask writes a frame of an AnimatedCodec into the shared texture. Only the area
+ * that differs from the frame the texture already holds is uploaded.
+ */
+class AnimatedFrameUploadTask : public ResourceTask {
+ public:
+  AnimatedFrameUploadTask(std::shared_ptr<TextureProxy> proxy,
+                          std::shared_ptr<AnimatedTextureState> state,
+                          std::shared_ptr<AnimatedCodec> codec, int frameIndex,
+                          std::shared_ptr<Data> pixels);
+
+  bool execute(Context* context) override;
+
+ protected:
+  std::shared_ptr<Resource> onMakeResource(Context* context) override;
+
+ private:
+  std::shared_ptr<TextureProxy> textureProxy = nullptr;
+  std::shared_ptr<AnimatedTextureState> state = nullptr;
+  std::shared_ptr<AnimatedCodec> codec = nullptr;
+  int frameIndex = 0;
+  std::shared_ptr<Data> pixels = nullptr;
+};
+}  // namespace tgfx
@@ -25,46 +25,74 @@
 #include "tgfx/gpu/GPU.h"
 
 namespace tgfx {
-class AsyncCellUploadTask : public Task, public CellUploadTask {
+// Cells are rasterized in batches rather than one task per glyph, so a page of fresh text costs a
+// few dozen task dispatches instead of thousands. A batch is submitted as soon as it is full, which
+// lets the task threads rasterize while the remaining text ops are still being built.
+static constexpr size_t MAX_BATCH_CELL_COUNT = 32;
+static constexpr size_t MAX_BATCH_PIXEL_COUNT = 128 * 128;
+
+struct AtlasCellData {
+  std::shared_ptr<ImageCodec> imageCodec = nullptr;
+  void* dstPixels = nullptr;
+  ImageInfo dstInfo = {};
+  int offsetX = 0;
+  int offsetY = 0;
+};
+
+class AtlasCellBatchTask : public Task, public CellUploadTask {
  public:
-  AsyncCellUploadTask(std::shared_ptr<ImageCodec> imageCodec, void* dstPixels,
-                      const ImageInfo& dstInfo, int offsetX, int offsetY, bool needsWriteTexture)
-      : imageCodec(std::move(imageCodec)), dstPixels(dstPixels), dstInfo(dstInfo), offsetX(offsetX),
-        offsetY(offsetY), needsWriteTexture(needsWriteTexture) {
+  explicit AtlasCellBatchTask(bool needsWriteTexture) : needsWriteTexture(needsWriteTexture) {
+  }
+
+  void addCell(AtlasCellData cell) {
+    pixelCount += static_cast<size_t>(cell.dstInfo.width() * cell.dstInfo.height());
+    cells.push_back(std::move(cell));
+  }
+
+  bool isFull() const {
+    return cells.size() >= MAX_BATCH_CELL_COUNT || pixelCount >= MAX_BATCH_PIXEL_COUNT;
   }
 
   void upload(std::shared_ptr<Texture> texture, CommandQueue* queue) override {
     wait();
-    if (needsWriteTexture) {
-      auto rect = Rect::MakeXYWH(offsetX, offsetY, dstInfo.width(), dstInfo.height());
-      queue->writeTexture(std::move(texture), rect, dstPixels, dstInfo.rowBytes());
+    if (!needsWriteTexture) {
+      return;
+    }
+    for (auto& cell : cells) {
+      auto& dstInfo = cell.dstInfo;
+      auto rect = Rect::MakeXYWH(cell.offsetX, cell.offsetY, dstInfo.width(), dstInfo.height());
+      queue->writeTexture(texture, rect, cell.dstPixels, dstInfo.rowBytes());
     }
   }
 
-  ~AsyncCellUploadTask() override {
+  ~AtlasCellBatchTask() override {
     Task::cancel();
   }
 
  protected:
   void onExecute() override {
-    DEBUG_ASSERT(imageCodec != nullptr)
-    ClearPixels(dstInfo, dstPixels);
-    auto targetInfo = dstInfo.makeIntersect(0, 0, imageCodec->width(), imageCodec->height());
-    auto targetPixels = dstInfo.computeOffset(dstPixels, Plot::CellPadding, Plot::CellPadding);
-    imageCodec->readPixels(targetInfo, targetPixels);
-    imageCodec = nullptr;
+    for (auto& cell : cells) {
+      DEBUG_ASSERT(cell.imageCodec != nullptr)
+      auto& dstInfo = cell.dstInfo;
+      ClearPixels(dstInfo, cell.dstPixels);
+      auto targetInfo =
+          dstInfo.makeIntersect(0, 0, cell.imageCodec->width(), cell.imageCodec->height());
+      auto targetPixels =
+          dstInfo.computeOffset(cell.dstPixels, Plot::CellPadding, Plot::CellPadding);
+      cell.imageCodec->readPixels(targetInfo, targetPixels);
+      cell.imageCodec = nullptr;
+    }
   }
 
   void onCancel() override {
-    imageCodec = nullptr;
+    for (auto& cell : cells) {
+      cell.imageCodec = nullptr;
+    }
   }
 
  private:
-  std::shared_ptr<ImageCodec> imageCodec = nullptr;
-  void* dstPixels = nullptr;
-  ImageInfo dstInfo = {};
-  int offsetX = 0;
-  int offsetY = 0;
+  std::vector<AtlasCellData> cells = {};
+  size_t pixelCount = 0;
   bool needsWriteTexture = false;
 };
 
@@ -131,14 +159,27 @@ void AtlasUploadTask::addCell(BlockAllocator* allocator, std::shared_ptr<ImageCo
       LOGE("AtlasUploadTask::addCell failed to allocate %zu bytes for atlas cell", length);
       return;
     }
+    uploadBytes += length;
+  }
+  if (pendingBatch == nullptr) {
+    pendingBatch = std::make_shared<AtlasCellBatchTask>(hardwarePixels == nullptr);
+    cellTasks.push_back(pendingBatch);
+  }
+  pendingBatch->addCell({std::move(codec), dstPixels, dstInfo, offsetX, offsetY});
+  if (pendingBatch->isFull()) {
+    submitPendingBatch();
+  }
+}
+
+void AtlasUploadTask::submitPendingBatch() {
+  if (pendingBatch != nullptr) {
+    Task::Run(std::move(pendingBatch));
+    pendingBatch = nullptr;
   }
-  auto task = std::make_shared<AsyncCellUploadTask>(std::move(codec), dstPixels, dstInfo, offsetX,
-                                                    offsetY, hardwarePixels == nullptr);
-  Task::Run(task);
-  cellTasks.emplace_back(std::move(task));
 }
 
 void AtlasUploadTask::upload(Context* context) {
+  submitPendingBatch();
   auto textureView = textureProxy->getTextureView();
   if (textureView == nullptr) {
     return;
@@ -149,6 +190,8 @@ void AtlasUploadTask::upload(Context* context) {
     task->upload(texture, queue);
   }
   cellTasks.clear();
+  context->currentFrameStats()->uploadedBytes += uploadBytes;
+  uploadBytes = 0;
 }
 
 }  // namespace tgfx
@@ -35,6 +35,8 @@ class CellUploadTask {
   virtual void upload(std::shared_ptr<Texture> texture, CommandQueue* queue) = 0;
 };
 
+class AtlasCellBatchTask;
+
 class AtlasUploadTask {
  public:
   /**
@@ -48,9 +50,16 @@ class AtlasUploadTask {
 
   virtual ~AtlasUploadTask();
 
+  /**
+   * Adds a cell to rasterize into the atlas at the given offset. Cells are collected into batches
+   * that are rasterized on task threads, each batch starting as soon as it is full.
+   */
   virtual void addCell(BlockAllocator* allocator, std::shared_ptr<ImageCodec> codec,
                        const Point& atlasOffset);
 
+  /**
+   * Waits for all cells to finish rasterizing and writes them into the atlas texture.
+   */
   void upload(Context* context);
 
  protected:
@@ -58,5 +67,11 @@ class AtlasUploadTask {
   ImageInfo hardwareInfo = {};
   void* hardwarePixels = nullptr;
   std::vector<std::shared_ptr<CellUploadTask>> cellTasks = {};
+  size_t uploadBytes = 0;
+
+ private:
+  std::shared_ptr<AtlasCellBatchTask> pendingBatch = nullptr;
+
+  void submitPendingBatch();
 };
 }  // namespace tgfx
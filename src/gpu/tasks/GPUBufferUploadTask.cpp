@@ -43,6 +43,7 @@ std::shared_ptr<Resource> GPUBufferUploadTask::onMakeResource(Context* context)
     return nullptr;
   }
   context->gpu()->queue()->writeBuffer(bufferResource->gpuBuffer(), 0, data->data(), data->size());
+  context->currentFrameStats()->uploadedBytes += data->size();
   // Free the data source immediately to reduce memory pressure.
   source = nullptr;
   return bufferResource;
@@ -87,6 +87,7 @@ std::shared_ptr<BufferResource> HairlineBufferUploadTask::createBuffer(
   }
 
   gpu->queue()->writeBuffer(bufferResource->gpuBuffer(), 0, data->data(), data->size());
+  context->currentFrameStats()->uploadedBytes += data->size();
   return bufferResource;
 }
 
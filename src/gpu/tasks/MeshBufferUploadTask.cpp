@@ -82,6 +82,7 @@ std::shared_ptr<Resource> VertexMeshBufferUploadTask::onMakeResource(Context* co
 
   context->gpu()->queue()->writeBuffer(bufferResource->gpuBuffer(), 0, buffer.get(),
                                        vertexDataSize);
+  context->currentFrameStats()->uploadedBytes += vertexDataSize;
 
   return bufferResource;
 }
@@ -109,6 +110,7 @@ std::shared_ptr<Resource> MeshIndexBufferUploadTask::onMakeResource(Context* con
 
   context->gpu()->queue()->writeBuffer(bufferResource->gpuBuffer(), 0, vertexMesh->indices(),
                                        indexDataSize);
+  context->currentFrameStats()->uploadedBytes += indexDataSize;
 
   return bufferResource;
 }
@@ -138,6 +140,7 @@ std::shared_ptr<Resource> ShapeMeshBufferUploadTask::onMakeResource(Context* con
 
   context->gpu()->queue()->writeBuffer(bufferResource->gpuBuffer(), 0, vertexData->data(),
                                        vertexData->size());
+  context->currentFrameStats()->uploadedBytes += vertexData->size();
 
   // Release data source to free memory (triangulation result)
   dataSource = nullptr;
@@ -19,6 +19,7 @@
 #include "OpsRenderTask.h"
 #include "gpu/proxies/RenderTargetProxy.h"
 #include "gpu/resources/DepthStencilTextureView.h"
+#include "tgfx/gpu/Context.h"
 #include "tgfx/gpu/RenderPass.h"
 
 namespace tgfx {
@@ -28,7 +29,10 @@ void OpsRenderTask::execute(CommandEncoder* encoder) {
     LOGE("OpsRenderTask::execute() Render target is null!");
     return;
   }
-  auto loadOp = clearColor.has_value() ? LoadAction::Clear : LoadAction::Load;
+  auto loadOp = contentsDiscarded ? LoadAction::DontCare : LoadAction::Load;
+  if (clearColor.has_value()) {
+    loadOp = LoadAction::Clear;
+  }
   auto resolveTexture =
       renderTarget->sampleCount() > 1 ? renderTarget->getSampleTexture() : nullptr;
   RenderPassDescriptor descriptor(renderTarget->getRenderTexture(), loadOp, StoreAction::Store,
@@ -94,6 +98,8 @@ void OpsRenderTask::execute(CommandEncoder* encoder) {
     LOGE("OpsRenderTask::execute() Failed to initialize the render pass!");
     return;
   }
+  auto frameStats = renderTarget->getContext()->currentFrameStats();
+  const Program* lastProgram = nullptr;
   for (auto& op : drawOps) {
     if (op != nullptr && !stencilAvailable && op->needsStencil()) {
       // Drop stencil-aware ops when no stencil attachment was bound — running them would
@@ -102,6 +108,12 @@ void OpsRenderTask::execute(CommandEncoder* encoder) {
       continue;
     }
     op->execute(renderPass.get(), renderTarget.get());
+    // Ops that bind their own programs always count as a switch.
+    auto program = op->boundProgram();
+    if (program == nullptr || program != lastProgram) {
+      frameStats->programSwitchCount++;
+    }
+    lastProgram = program;
     // Release the Op immediately after execution to maximize GPU resource reuse.
     op = nullptr;
   }
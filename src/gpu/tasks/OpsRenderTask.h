@@ -33,9 +33,18 @@ class OpsRenderTask : public RenderTask {
 
   void execute(CommandEncoder* encoder) override;
 
+  RenderTargetProxy* renderTarget() const override {
+    return renderTargetProxy.get();
+  }
+
+  void discardContents() override {
+    contentsDiscarded = true;
+  }
+
  private:
   std::shared_ptr<RenderTargetProxy> renderTargetProxy = nullptr;
   PlacementArray<DrawOp> drawOps = {};
   std::optional<PMColor> clearColor = std::nullopt;
+  bool contentsDiscarded = false;
 };
 }  // namespace tgfx
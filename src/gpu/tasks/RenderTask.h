@@ -22,6 +22,8 @@
 #include "tgfx/gpu/CommandEncoder.h"
 
 namespace tgfx {
+class RenderTargetProxy;
+
 class RenderTask {
  public:
   explicit RenderTask(BlockAllocator* allocator) : allocator(allocator) {
@@ -31,6 +33,20 @@ class RenderTask {
 
   virtual void execute(CommandEncoder* encoder) = 0;
 
+  /**
+   * Returns the render target this task renders into, or nullptr if it does not render into one.
+   */
+  virtual RenderTargetProxy* renderTarget() const {
+    return nullptr;
+  }
+
+  /**
+   * Tells the task that the existing contents of its render target are undefined, so they don't
+   * need to be loaded at the start of the render pass.
+   */
+  virtual void discardContents() {
+  }
+
  protected:
   BlockAllocator* allocator = nullptr;
 };
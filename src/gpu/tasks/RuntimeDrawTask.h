@@ -37,6 +37,10 @@ class RuntimeDrawTask : public RenderTask {
 
   void execute(CommandEncoder* encoder) override;
 
+  RenderTargetProxy* renderTarget() const override {
+    return renderTargetProxy.get();
+  }
+
  private:
   std::shared_ptr<RenderTargetProxy> renderTargetProxy = nullptr;
   std::vector<RuntimeInputTexture> inputTextures = {};
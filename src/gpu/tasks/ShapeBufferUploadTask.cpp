@@ -47,6 +47,7 @@ std::shared_ptr<Resource> ShapeBufferUploadTask::onMakeResource(Context* context
     }
     context->gpu()->queue()->writeBuffer(vertexBuffer->gpuBuffer(), 0, triangles->data(),
                                          triangles->size());
+    context->currentFrameStats()->uploadedBytes += triangles->size();
   } else {
     auto textureView = TextureView::MakeFrom(context, std::move(shapeBuffer->imageBuffer));
     if (!textureView) {
@@ -50,6 +50,7 @@ std::shared_ptr<Resource> StencilCoverPathUploadTask::onMakeResource(Context* co
   }
   context->gpu()->queue()->writeBuffer(vertexBuffer->gpuBuffer(), 0, bezierBuffer->vertices->data(),
                                        bezierBuffer->vertices->size());
+  context->currentFrameStats()->uploadedBytes += bezierBuffer->vertices->size();
   return vertexBuffer;
 }
 }  // namespace tgfx
@@ -80,6 +80,9 @@ void VulkanCaps::initFeatures(VkPhysicalDevice, const VulkanExtensions& extensio
   _features.clampToBorder = true;
   // Vulkan has no glTextureBarrier() equivalent. Disable to force the copy path for dst reads.
   _features.textureBarrier = false;
+  // vkCreateShaderModule, vkCreateGraphicsPipelines and the shaderc compiler are all thread-safe,
+  // and VulkanGPU guards its resource list, so pipelines can be compiled on worker threads.
+  _features.concurrentPipelineCreation = true;
   // stencilAttachmentSupported is set in initFormatTable() after probing the actual
   // depth/stencil format availability, because the capability must not be advertised when
   // no renderable D24S8 / D32S8 format exists on the device.
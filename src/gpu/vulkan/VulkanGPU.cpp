@@ -471,6 +471,43 @@ std::shared_ptr<CommandEncoder> VulkanGPU::createCommandEncoder() {
   return VulkanCommandEncoder::Make(this);
 }
 
+std::shared_ptr<Data> VulkanGPU::getPipelineCacheData() {
+  if (vulkanPipelineCache == VK_NULL_HANDLE) {
+    return nullptr;
+  }
+  size_t dataSize = 0;
+  if (vkGetPipelineCacheData(vulkanDevice, vulkanPipelineCache, &dataSize, nullptr) != VK_SUCCESS ||
+      dataSize == 0) {
+    return nullptr;
+  }
+  std::vector<uint8_t> cacheData(dataSize);
+  auto result = vkGetPipelineCacheData(vulkanDevice, vulkanPipelineCache, &dataSize,
+                                       cacheData.data());
+  if ((result != VK_SUCCESS && result != VK_INCOMPLETE) || dataSize == 0) {
+    return nullptr;
+  }
+  return Data::MakeWithCopy(cacheData.data(), dataSize);
+}
+
+bool VulkanGPU::mergePipelineCacheData(const Data* data) {
+  if (data == nullptr || data->empty() || vulkanPipelineCache == VK_NULL_HANDLE) {
+    return false;
+  }
+  // The driver validates the header (vendor, device and pipeline cache UUID) of the initial data
+  // and silently starts from an empty cache if it does not match the current device.
+  VkPipelineCacheCreateInfo cacheInfo = {};
+  cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+  cacheInfo.initialDataSize = data->size();
+  cacheInfo.pInitialData = data->data();
+  VkPipelineCache loadedCache = VK_NULL_HANDLE;
+  if (vkCreatePipelineCache(vulkanDevice, &cacheInfo, nullptr, &loadedCache) != VK_SUCCESS) {
+    return false;
+  }
+  auto result = vkMergePipelineCaches(vulkanDevice, vulkanPipelineCache, 1, &loadedCache);
+  vkDestroyPipelineCache(vulkanDevice, loadedCache, nullptr);
+  return result == VK_SUCCESS;
+}
+
 std::vector<std::shared_ptr<Texture>> VulkanGPU::importHardwareTextures(
     HardwareBufferRef hardwareBuffer, uint32_t usage) {
   // All eligibility gating (extension bits + HardwareBufferCheck + format/usage) lives inside
@@ -560,15 +597,21 @@ uint32_t VulkanGPU::MakeSamplerKey(const SamplerDescriptor& descriptor) {
 
 std::shared_ptr<VulkanResource> VulkanGPU::addResource(VulkanResource* resource) {
   DEBUG_ASSERT(resource != nullptr);
-  resources.push_back(resource);
-  resource->cachedPosition = --resources.end();
+  {
+    std::lock_guard<std::mutex> autoLock(resourceLocker);
+    resources.push_back(resource);
+    resource->cachedPosition = --resources.end();
+  }
   return std::static_pointer_cast<VulkanResource>(returnQueue->makeShared(resource));
 }
 
 void VulkanGPU::processUnreferencedResources() {
   DEBUG_ASSERT(returnQueue != nullptr);
   while (auto resource = static_cast<VulkanResource*>(returnQueue->dequeue())) {
-    resources.erase(resource->cachedPosition);
+    {
+      std::lock_guard<std::mutex> autoLock(resourceLocker);
+      resources.erase(resource->cachedPosition);
+    }
     resource->onRelease(this);
     delete resource;
   }
@@ -23,6 +23,7 @@
 #include <deque>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <unordered_map>
 #include <vector>
@@ -108,6 +109,8 @@ class VulkanGPU : public GPU {
   std::shared_ptr<RenderPipeline> createRenderPipeline(
       const RenderPipelineDescriptor& descriptor) override;
   std::shared_ptr<CommandEncoder> createCommandEncoder() override;
+  std::shared_ptr<Data> getPipelineCacheData() override;
+  bool mergePipelineCacheData(const Data* data) override;
   std::vector<std::shared_ptr<Texture>> importHardwareTextures(HardwareBufferRef hardwareBuffer,
                                                                uint32_t usage) override;
   std::shared_ptr<Texture> importBackendTexture(const BackendTexture& backendTexture,
@@ -260,6 +263,8 @@ class VulkanGPU : public GPU {
   std::shared_ptr<VulkanResource> addResource(VulkanResource* resource);
   static uint32_t MakeSamplerKey(const SamplerDescriptor& descriptor);
 
+  // Guards the resources list, which pipelines compiled on worker threads also append to.
+  std::mutex resourceLocker = {};
   std::list<VulkanResource*> resources = {};
   std::shared_ptr<ReturnQueue> returnQueue = ReturnQueue::Make();
   std::unordered_map<uint32_t, std::shared_ptr<Sampler>> samplerCache = {};
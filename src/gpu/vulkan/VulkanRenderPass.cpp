@@ -97,14 +97,22 @@ VulkanRenderPass::VulkanRenderPass(VulkanCommandEncoder* encoder, VulkanGPU* gpu
     // so we use the tracked layout (the previous submit that wrote this image will have completed
     // on the same queue before this command buffer executes).
     auto loadAction = ca.loadAction;
-    if (loadAction == LoadAction::Load &&
-        vulkanTexture->currentLayout() == VK_IMAGE_LAYOUT_UNDEFINED) {
+    auto trackedLayout = vulkanTexture->currentLayout();
+    if (loadAction == LoadAction::Load && trackedLayout == VK_IMAGE_LAYOUT_UNDEFINED) {
       loadAction = LoadAction::DontCare;
     }
-    auto oldLayout = (loadAction == LoadAction::Load) ? vulkanTexture->currentLayout()
-                                                      : VK_IMAGE_LAYOUT_UNDEFINED;
+    auto oldLayout = (loadAction == LoadAction::Load) ? trackedLayout : VK_IMAGE_LAYOUT_UNDEFINED;
+    // A discarded attachment may still be in use by earlier passes of the same command buffer, for
+    // example a transient render target handed over by the TransientTargetAllocator while a
+    // previous pass samples it. Wait for those reads and writes before overwriting it.
+    VkPipelineStageFlags waitStages = 0;
+    if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && trackedLayout != VK_IMAGE_LAYOUT_UNDEFINED) {
+      waitStages =
+          VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    }
     TransitionImageLayout(commandBuffer, vulkanTexture->vulkanImage(), oldLayout,
-                          VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_ASPECT_COLOR_BIT);
+                          VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_ASPECT_COLOR_BIT,
+                          waitStages);
 
     VkAttachmentDescription attachment = {};
     attachment.format = vulkanTexture->vulkanFormat();
@@ -153,7 +153,8 @@ VkImageAspectFlags VkFormatToAspectFlags(VkFormat format) {
 }
 
 void TransitionImageLayout(VkCommandBuffer cmd, VkImage image, VkImageLayout oldLayout,
-                           VkImageLayout newLayout, VkImageAspectFlags aspectMask) {
+                           VkImageLayout newLayout, VkImageAspectFlags aspectMask,
+                           VkPipelineStageFlags waitStages) {
   VkPipelineStageFlags srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
   VkAccessFlags srcAccess = 0;
   VkPipelineStageFlags dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
@@ -161,10 +162,16 @@ void TransitionImageLayout(VkCommandBuffer cmd, VkImage image, VkImageLayout old
 
   switch (oldLayout) {
     case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
-    case VK_IMAGE_LAYOUT_GENERAL:
       srcStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
       srcAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
       break;
+    case VK_IMAGE_LAYOUT_GENERAL:
+      // Images in GENERAL are both rendered to and sampled, so wait for earlier fragment shader
+      // reads too. A write-after-read hazard only needs the execution dependency.
+      srcStage =
+          VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+      srcAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+      break;
     case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
       srcStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
       srcAccess = VK_ACCESS_SHADER_READ_BIT;
@@ -184,6 +191,15 @@ void TransitionImageLayout(VkCommandBuffer cmd, VkImage image, VkImageLayout old
     default:
       break;
   }
+  if (waitStages != 0) {
+    if (srcStage == VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT) {
+      srcStage = 0;
+    }
+    srcStage |= waitStages;
+    if (waitStages & VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT) {
+      srcAccess |= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    }
+  }
 
   switch (newLayout) {
     case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
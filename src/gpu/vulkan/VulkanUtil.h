@@ -47,9 +47,12 @@ VkImageAspectFlags VkFormatToAspectFlags(VkFormat format);
 
 /// Inserts a pipeline barrier to transition an image between layouts with precise stage/access
 /// masks derived from the source and destination layouts. Avoids ALL_COMMANDS_BIT stalls.
+/// waitStages adds source stages the barrier must wait for even when oldLayout is UNDEFINED, e.g.
+/// earlier passes that still sample or write an image whose contents are about to be discarded.
 void TransitionImageLayout(VkCommandBuffer cmd, VkImage image, VkImageLayout oldLayout,
                            VkImageLayout newLayout,
-                           VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_COLOR_BIT);
+                           VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                           VkPipelineStageFlags waitStages = 0);
 
 // Error checking macro that logs the VkResult string on failure.
 #define VK_CHECK(result)                                                                   \
@@ -18,16 +18,22 @@
 
 #include "tgfx/layers/DisplayList.h"
 #include <algorithm>
+#include "core/PictureOptimizer.h"
 #include "core/utils/DecomposeRects.h"
 #include "core/utils/Log.h"
 #include "core/utils/MathExtra.h"
 #include "core/utils/TileSortCompareFunc.h"
+#include "core/utils/TraceZone.h"
 #include "layers/BackgroundHandler.h"
 #include "layers/BackgroundSnapshotMap.h"
 #include "layers/BackgroundSource.h"
 #include "layers/DrawArgs.h"
 #include "layers/RootLayer.h"
 #include "layers/TileCache.h"
+#include "layers/contents/LayerContent.h"
+#include "tgfx/core/PictureRecorder.h"
+#include "tgfx/core/RasterCanvas.h"
+#include "tgfx/core/Task.h"
 #include "tgfx/gpu/GPU.h"
 
 namespace tgfx {
@@ -37,6 +43,8 @@ static constexpr int MIN_TILE_SIZE = 16;
 static constexpr int MAX_TILE_SIZE = 2048;
 static constexpr int FALLBACK_GRID_SIZE = 64;
 static constexpr int MAX_ATLAS_SIZE = 8192;
+static constexpr int MAX_TILE_RECORDING_THREADS = 32;
+static constexpr int MAX_CONTENT_UPDATE_THREADS = 32;
 
 class DrawTask {
  public:
@@ -274,6 +282,14 @@ void DisplayList::setMaxTileCount(int count) {
   resetCaches();
 }
 
+void DisplayList::setTileRecordingThreads(int count) {
+  _tileRecordingThreads = std::clamp(count, 1, MAX_TILE_RECORDING_THREADS);
+}
+
+void DisplayList::setContentUpdateThreads(int count) {
+  _contentUpdateThreads = std::clamp(count, 1, MAX_CONTENT_UPDATE_THREADS);
+}
+
 void DisplayList::setBackgroundColor(const Color& color) {
   if (_backgroundColor == color) {
     return;
@@ -319,8 +335,14 @@ void DisplayList::render(Surface* surface, bool autoClear) {
   if (!surface) {
     return;
   }
+  TRACE_ZONE("DisplayList::render");
   _hasContentChanged = false;
-  auto dirtyRegions = _root->updateDirtyRegions();
+  updateLayerContents();
+  std::vector<Rect> dirtyRegions = {};
+  {
+    TRACE_ZONE("RootLayer::updateDirtyRegions");
+    dirtyRegions = _root->updateDirtyRegions();
+  }
   if (_zoomScaleInt == 0) {
     if (autoClear) {
       auto canvas = surface->getCanvas();
@@ -345,6 +367,45 @@ void DisplayList::render(Surface* surface, bool autoClear) {
   _root->updateStaticSubtreeFlags();
 }
 
+bool DisplayList::render(RasterCanvas* canvas, bool autoClear) {
+  if (canvas == nullptr) {
+    return false;
+  }
+  TRACE_ZONE("DisplayList::render");
+  updateLayerContents();
+  _root->updateDirtyRegions();
+  // The dirty regions are consumed here, so the Surface caches can no longer be updated partially.
+  resetCaches();
+  auto clipRect = Rect::MakeWH(canvas->width(), canvas->height());
+  PictureRecorder recorder = {};
+  auto recordingCanvas = recorder.beginRecording();
+  recordingCanvas->clipRect(clipRect, false);
+  if (autoClear) {
+    recordingCanvas->clear();
+  }
+  if (_zoomScaleInt != 0) {
+    auto viewMatrix = getViewMatrix();
+    recordingCanvas->setMatrix(viewMatrix);
+    DrawArgs args(nullptr);
+    Matrix inverse = Matrix::I();
+    viewMatrix.invert(&inverse);
+    auto renderRect = inverse.mapRect(clipRect);
+    renderRect.roundOut();
+    std::vector<Rect> renderRects = {renderRect};
+    args.renderRects = &renderRects;
+    args.backgroundHandler = BackgroundHandler::NoOp();
+    recordingCanvas->drawColor(_backgroundColor, BlendMode::SrcOver);
+    _root->drawLayer(args, recordingCanvas, 1.0f, BlendMode::SrcOver);
+  }
+  auto picture = recorder.finishRecordingAsPicture();
+  if (picture != nullptr && !canvas->drawPicture(std::move(picture))) {
+    return false;
+  }
+  _hasContentChanged = false;
+  _root->updateStaticSubtreeFlags();
+  return true;
+}
+
 std::vector<Rect> DisplayList::renderDirect(Surface* surface, bool autoClear) const {
   auto surfaceRect = Rect::MakeWH(surface->width(), surface->height());
   std::unique_ptr<BackgroundSnapshotMap> snapshotMap = nullptr;
@@ -374,10 +435,32 @@ static std::vector<Rect> MapDirtyRegions(const std::vector<Rect>& dirtyRegions,
     }
   }
   if (decompose) {
-    DecomposeRects(dirtyRects.data(), dirtyRects.size());
+    // Rounding out to pixels makes neighbouring regions overlap, merge them before splitting.
+    MergeRects(&dirtyRects, MAX_DIRTY_REGIONS);
+    return DecomposeRects(dirtyRects);
   }
   return dirtyRects;
 }
+
+// Limits the rects of partial rendering to MAX_PARTIAL_RENDER_RECTS non-overlapping rects.
+static void LimitPartialRenderRects(std::vector<Rect>* renderRects) {
+  if (renderRects->size() <= MAX_PARTIAL_RENDER_RECTS) {
+    return;
+  }
+  MergeRects(renderRects, MAX_PARTIAL_RENDER_RECTS);
+  auto decomposedRects = DecomposeRects(*renderRects);
+  if (decomposedRects.size() <= MAX_PARTIAL_RENDER_RECTS) {
+    *renderRects = std::move(decomposedRects);
+    return;
+  }
+  // The merged rects still overlap in a way that splits into too many bands, draw their bounds.
+  auto bounds = Rect::MakeEmpty();
+  for (auto& rect : *renderRects) {
+    bounds.join(rect);
+  }
+  *renderRects = {bounds};
+}
+
 std::vector<Rect> DisplayList::renderPartial(Surface* surface, bool autoClear,
                                              const std::vector<Rect>& dirtyRegions) {
   auto context = surface->getContext();
@@ -405,6 +488,7 @@ std::vector<Rect> DisplayList::renderPartial(Surface* surface, bool autoClear,
     lastContentOffset = _contentOffset;
   } else {
     renderRects = MapDirtyRegions(dirtyRegions, viewMatrix, true, &surfaceRect);
+    LimitPartialRenderRects(&renderRects);
   }
   // Pass the full rect list so each replay is scoped to a single rect; otherwise Layers in the
   // gaps between scattered dirty regions get skipped.
@@ -458,10 +542,22 @@ std::vector<Rect> DisplayList::renderTiled(Surface* surface, bool autoClear,
     }
     snapshotMap = captureBackgrounds(surface, captureRects);
   }
+  std::vector<std::shared_ptr<Picture>> tilePictures = {};
+  if (snapshotMap == nullptr) {
+    tilePictures = recordTileTasks(tileTasks, surface->colorSpace());
+  }
   std::vector<Rect> dirtyRects = {};
   auto surfaceRect = Rect::MakeWH(surface->width(), surface->height());
-  for (auto& task : tileTasks) {
-    drawTileTask(task, snapshotMap.get());
+  for (size_t i = 0; i < tileTasks.size(); i++) {
+    auto& task = tileTasks[i];
+    if (!tilePictures.empty()) {
+      // Pictures are played back in task order, so the tile caches end up identical to the serial
+      // path and all draws go into a single flush.
+      auto tileSurface = surfaceCaches[task.sourceIndex()].get();
+      tileSurface->getCanvas()->drawPicture(std::move(tilePictures[i]));
+    } else {
+      drawTileTask(task, snapshotMap.get());
+    }
     auto dirtyRect = task.tileRect();
     dirtyRect.offset(_contentOffset.x, _contentOffset.y);
     if (dirtyRect.intersect(surfaceRect)) {
@@ -1015,6 +1111,12 @@ void DisplayList::drawTileTask(const DrawTask& task, BackgroundSnapshotMap* snap
   DEBUG_ASSERT(surface != nullptr);
   auto canvas = surface->getCanvas();
   AutoCanvasRestore autoRestore(canvas);
+  Rect clipRect = {};
+  auto viewMatrix = getTileViewMatrix(task, &clipRect);
+  drawRootLayer(surface, clipRect, viewMatrix, true, snapshots);
+}
+
+Matrix DisplayList::getTileViewMatrix(const DrawTask& task, Rect* clipRect) const {
   auto currentZoomScale = ToZoomScaleFloat(_zoomScaleInt, _zoomScalePrecision);
   DEBUG_ASSERT(currentZoomScale != 0.0f);
   auto viewMatrix = Matrix::MakeScale(currentZoomScale);
@@ -1023,9 +1125,153 @@ void DisplayList::drawTileTask(const DrawTask& task, BackgroundSnapshotMap* snap
   auto offsetX = sourceRect.left - tileRect.left;
   auto offsetY = sourceRect.top - tileRect.top;
   viewMatrix.postTranslate(offsetX, offsetY);
-  auto clipRect = tileRect;
-  clipRect.offset(offsetX, offsetY);
-  drawRootLayer(surface, clipRect, viewMatrix, true, snapshots);
+  *clipRect = tileRect;
+  clipRect->offset(offsetX, offsetY);
+  return viewMatrix;
+}
+
+void DisplayList::updateLayerContents() {
+  if (_contentUpdateThreads < 2) {
+    return;
+  }
+  TRACE_ZONE("DisplayList::updateLayerContents");
+  // Collect the layers that updateRenderBounds() is about to rebuild. Only dirty subtrees are
+  // visited, since a layer with invalidated content always marks itself and its ancestors dirty.
+  std::vector<Layer*> dirtyLayers = {};
+  std::vector<Layer*> layers = {_root.get()};
+  while (!layers.empty()) {
+    auto layer = layers.back();
+    layers.pop_back();
+    // An invalidated mask only marks its owner's transform dirty, so masks are checked even when
+    // the owner itself is clean.
+    if (layer->_mask != nullptr && layer->_mask->bitFields.visible) {
+      layers.push_back(layer->_mask.get());
+    }
+    if (!layer->bitFields.dirtyDescendents) {
+      continue;
+    }
+    if (layer->bitFields.dirtyContent && !layer->bitFields.sharedProperty) {
+      dirtyLayers.push_back(layer);
+    }
+    for (auto& child : layer->_children) {
+      if (child->bitFields.visible && child->_alpha > 0) {
+        layers.push_back(child.get());
+      }
+    }
+  }
+  // A mask layer can also be a child in the same tree, so it may have been reached twice.
+  std::sort(dirtyLayers.begin(), dirtyLayers.end());
+  dirtyLayers.erase(std::unique(dirtyLayers.begin(), dirtyLayers.end()), dirtyLayers.end());
+  auto threadCount = std::min(static_cast<size_t>(_contentUpdateThreads), dirtyLayers.size());
+  if (threadCount < 2) {
+    return;
+  }
+  std::vector<std::shared_ptr<LayerContent>> contents(dirtyLayers.size());
+  std::vector<std::shared_ptr<Task>> tasks = {};
+  tasks.reserve(threadCount);
+  for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+    auto task = Task::Run([&, threadIndex]() {
+      for (auto i = threadIndex; i < dirtyLayers.size(); i += threadCount) {
+        std::shared_ptr<LayerContent> content = dirtyLayers[i]->recordContent();
+        if (content != nullptr) {
+          // Shapes cache their bounds lazily, so resolving them here leaves only cached lookups
+          // for the bounds pass that follows on the calling thread.
+          content->getBounds();
+        }
+        contents[i] = std::move(content);
+      }
+    });
+    tasks.push_back(std::move(task));
+  }
+  for (auto& task : tasks) {
+    task->wait();
+  }
+  for (size_t i = 0; i < dirtyLayers.size(); i++) {
+    auto layer = dirtyLayers[i];
+    layer->layerContent = std::move(contents[i]);
+    layer->bitFields.dirtyContent = false;
+  }
+}
+
+bool DisplayList::canRecordTilesConcurrently() const {
+  // Background styles, pass-through blending, 3D layers and subtree caches all render through the
+  // GPU context while recording, which is only allowed on the calling thread.
+  if (_subtreeCacheMaxSize > 0 || _root->hasBackgroundStyle() || _root->bitFields.hasBlendMode) {
+    return false;
+  }
+  // Walk the tree once on the calling thread to reject 3D layers and to resolve the caches that
+  // layers build lazily while drawing, so the recording threads only read from the tree.
+  std::vector<Layer*> layers = {_root.get()};
+  while (!layers.empty()) {
+    auto layer = layers.back();
+    layers.pop_back();
+    if (!layer->bitFields.visible) {
+      continue;
+    }
+    if (layer->_preserve3D || !layer->bitFields.matrix3DIsAffine) {
+      return false;
+    }
+    layer->getContent();
+    layer->getBoundsInternal(Matrix3D::I(), false);
+    if (layer->_mask != nullptr) {
+      layers.push_back(layer->_mask.get());
+    }
+    for (auto& child : layer->_children) {
+      layers.push_back(child.get());
+    }
+  }
+  return true;
+}
+
+std::vector<std::shared_ptr<Picture>> DisplayList::recordTileTasks(
+    const std::vector<DrawTask>& tileTasks, const std::shared_ptr<ColorSpace>& colorSpace) const {
+  auto threadCount = std::min(static_cast<size_t>(_tileRecordingThreads), tileTasks.size());
+  if (threadCount < 2 || !canRecordTilesConcurrently()) {
+    return {};
+  }
+  std::vector<std::shared_ptr<Picture>> pictures(tileTasks.size());
+  std::vector<std::shared_ptr<Task>> tasks = {};
+  tasks.reserve(threadCount);
+  for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+    // Interleave the tiles so that neighbouring tiles, which tend to have similar costs, are
+    // spread across threads.
+    auto task = Task::Run([&, threadIndex]() {
+      for (auto i = threadIndex; i < tileTasks.size(); i += threadCount) {
+        pictures[i] = recordTileTask(tileTasks[i], colorSpace);
+      }
+    });
+    tasks.push_back(std::move(task));
+  }
+  for (auto& task : tasks) {
+    task->wait();
+  }
+  return pictures;
+}
+
+std::shared_ptr<Picture> DisplayList::recordTileTask(
+    const DrawTask& task, const std::shared_ptr<ColorSpace>& colorSpace) const {
+  Rect clipRect = {};
+  auto viewMatrix = getTileViewMatrix(task, &clipRect);
+  PictureRecorder recorder = {};
+  auto canvas = recorder.beginRecording();
+  canvas->clipRect(clipRect, false);
+  canvas->clear();
+  canvas->setMatrix(viewMatrix);
+  // The recording threads must never touch the GPU context, so the layers are drawn without one.
+  DrawArgs args(nullptr);
+  Matrix inverse = Matrix::I();
+  viewMatrix.invert(&inverse);
+  auto renderRect = inverse.mapRect(clipRect);
+  renderRect.roundOut();
+  std::vector<Rect> renderRects = {renderRect};
+  args.renderRects = &renderRects;
+  args.dstColorSpace = colorSpace;
+  args.backgroundHandler = BackgroundHandler::NoOp();
+  canvas->drawColor(_backgroundColor, BlendMode::SrcOver);
+  _root->drawLayer(args, canvas, 1.0f, BlendMode::SrcOver);
+  // Optimizing here runs on the recording threads and drops the overdraw of layers hidden by
+  // opaque layers above them before the tile is replayed on the render thread.
+  return PictureOptimizer::Optimize(recorder.finishRecordingAsPicture());
 }
 
 void DisplayList::drawScreenTasks(std::vector<DrawTask> screenTasks, std::vector<Rect> skippedRects,
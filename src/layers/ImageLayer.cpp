@@ -32,6 +32,8 @@ void ImageLayer::setSampling(const SamplingOptions& value) {
 }
 
 void ImageLayer::setImage(std::shared_ptr<Image> value) {
+  _animatedCodec = nullptr;
+  currentFrame = -1;
   if (_image == value) {
     return;
   }
@@ -39,6 +41,41 @@ void ImageLayer::setImage(std::shared_ptr<Image> value) {
   invalidateContent();
 }
 
+void ImageLayer::setAnimatedCodec(std::shared_ptr<AnimatedCodec> value) {
+  if (_animatedCodec == value) {
+    return;
+  }
+  _animatedCodec = std::move(value);
+  currentFrame = -1;
+  if (_animatedCodec == nullptr) {
+    _image = nullptr;
+    invalidateContent();
+    return;
+  }
+  updateAnimatedFrame();
+}
+
+void ImageLayer::setCurrentTime(int64_t value) {
+  if (_currentTime == value) {
+    return;
+  }
+  _currentTime = value;
+  updateAnimatedFrame();
+}
+
+void ImageLayer::updateAnimatedFrame() {
+  if (_animatedCodec == nullptr) {
+    return;
+  }
+  auto frameIndex = _animatedCodec->getFrameAtTime(_currentTime);
+  if (frameIndex == currentFrame) {
+    return;
+  }
+  currentFrame = frameIndex;
+  _image = _animatedCodec->makeFrameImage(frameIndex);
+  invalidateContent();
+}
+
 void ImageLayer::onUpdateContent(LayerRecorder* recorder) {
   if (!_image) {
     return;
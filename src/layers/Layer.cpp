@@ -29,12 +29,14 @@
 #include "core/images/TextureImage.h"
 #include "core/utils/Log.h"
 #include "core/utils/MathExtra.h"
+#include "core/utils/TraceZone.h"
 #include "core/utils/Types.h"
 #include "layers/BackgroundHandler.h"
 #include "layers/BackgroundSnapshotMap.h"
 #include "layers/BackgroundSource.h"
 #include "layers/CanvasUtils.h"
 #include "layers/DrawArgs.h"
+#include "layers/LayerBVH.h"
 #include "layers/LayerStyleSource.h"
 #include "layers/MaskContext.h"
 #include "layers/OffscreenRenderer.h"
@@ -483,6 +485,7 @@ bool Layer::addChildAt(std::shared_ptr<Layer> child, int index) {
   _children.insert(_children.begin() + index, child);
   child->_parent = this;
   child->onAttachToRoot(_root);
+  resetChildIndexes();
   child->invalidateTransform();
   invalidateDescendents();
   return true;
@@ -531,6 +534,7 @@ std::shared_ptr<Layer> Layer::removeChildAt(int index) {
     _root->invalidateRect(child->renderBounds);
     child->renderBounds = {};
   }
+  resetChildIndexes();
   invalidateDescendents();
   return child;
 }
@@ -565,6 +569,7 @@ bool Layer::setChildIndex(std::shared_ptr<Layer> child, int index) {
   }
   _children.erase(_children.begin() + oldIndex);
   _children.insert(_children.begin() + index, child);
+  resetChildIndexes();
   if (_root) {
     // Immediately invalidate the old render bounds, as this may affect the background of the above
     // layer styles.
@@ -639,6 +644,7 @@ void Layer::setChildren(const std::vector<std::shared_ptr<Layer>>& children) {
   }
 
   _children = std::move(validChildren);
+  resetChildIndexes();
 
   for (auto* child : addedChildren) {
     nodesToMarkDirty.push_back(child);
@@ -823,26 +829,39 @@ bool Layer::hitTestPoint(float x, float y, bool shapeHitTest) {
     }
   }
 
-  for (const auto& childLayer : _children) {
+  auto hitTestChild = [x, y, shapeHitTest](Layer* childLayer) {
     // Alpha does not need to be checked; alpha == 0 is still valid.
     if (!childLayer->visible() || childLayer->maskOwner) {
-      continue;
+      return false;
     }
 
     if (nullptr != childLayer->_scrollRect) {
       auto pointInChildSpace = childLayer->globalToLocal(Point::Make(x, y));
       if (!childLayer->_scrollRect->contains(pointInChildSpace.x, pointInChildSpace.y)) {
-        continue;
+        return false;
       }
     }
 
     if (nullptr != childLayer->_mask) {
       if (!childLayer->_mask->hitTestPoint(x, y, shapeHitTest)) {
-        continue;
+        return false;
       }
     }
 
-    if (childLayer->hitTestPoint(x, y, shapeHitTest)) {
+    return childLayer->hitTestPoint(x, y, shapeHitTest);
+  };
+
+  std::vector<size_t> candidates = {};
+  if (getHitTestCandidates(x, y, &candidates)) {
+    for (auto index : candidates) {
+      if (hitTestChild(_children[index].get())) {
+        return true;
+      }
+    }
+    return false;
+  }
+  for (const auto& childLayer : _children) {
+    if (hitTestChild(childLayer.get())) {
       return true;
     }
   }
@@ -977,6 +996,9 @@ void Layer::invalidateDescendents() {
 
 void Layer::invalidate() {
   if (_parent) {
+    if (_parent->hitTestIndex) {
+      _parent->hitTestIndex->markStale(this);
+    }
     _parent->invalidateDescendents();
   }
   if (maskOwner) {
@@ -1079,14 +1101,18 @@ Matrix3D Layer::getMatrixWithScrollRect() const {
 
 LayerContent* Layer::getContent() {
   if (bitFields.dirtyContent) {
-    LayerRecorder recorder = {};
-    onUpdateContent(&recorder);
-    layerContent = recorder.finishRecording();
+    layerContent = recordContent();
     bitFields.dirtyContent = false;
   }
   return layerContent.get();
 }
 
+std::unique_ptr<LayerContent> Layer::recordContent() {
+  LayerRecorder recorder = {};
+  onUpdateContent(&recorder);
+  return recorder.finishRecording();
+}
+
 std::shared_ptr<Image> Layer::applyFilters(std::shared_ptr<Image> image, float contentScale,
                                            const Rect& contentBounds, Point* offset) {
   if (!image || _filters.empty()) {
@@ -1130,6 +1156,7 @@ Rect Layer::mapOutputBoundsToInput(const Rect& srcRect, float contentScale) {
 }
 
 bool Layer::drawLayer(const DrawArgs& args, Canvas* canvas, float alpha, BlendMode blendMode) {
+  TRACE_ZONE("Layer::drawLayer");
   DEBUG_ASSERT(canvas != nullptr);
   auto contentScale = canvas->getMatrix().getMaxScale();
   if (FloatNearlyZero(contentScale)) {
@@ -1679,6 +1706,22 @@ bool Layer::drawChildren(const DrawArgs& args, Canvas* canvas, float alpha,
   if (canPreserve3D() && args.render3DContext != nullptr) {
     return true;
   }
+  // Background capturers may force-draw children outside the render rects, so they always take
+  // the linear path below.
+  if (renderIndex != nullptr && stopChild == nullptr && args.renderRects != nullptr &&
+      !args.renderRects->empty() && !bitFields.dirtyDescendents &&
+      (args.backgroundHandler == nullptr || args.backgroundHandler->asCapturer() == nullptr)) {
+    std::vector<size_t> candidates = {};
+    renderIndex->query(*args.renderRects, &candidates);
+    for (auto index : candidates) {
+      auto child = _children[index].get();
+      if (child->maskOwner || !child->visible() || child->_alpha <= 0) {
+        continue;
+      }
+      drawChild(args, canvas, child, alpha, &Layer::drawLayer);
+    }
+    return true;
+  }
   auto childCount = static_cast<int>(_children.size());
   int maxIndex = childCount - 1;
   if (args.backgroundHandler != nullptr) {
@@ -1933,28 +1976,40 @@ void Layer::drawLayerStyleDefault(const DrawArgs& /*args*/, Canvas* canvas, floa
 
 bool Layer::getLayersUnderPointInternal(float x, float y,
                                         std::vector<std::shared_ptr<Layer>>* results) {
-  bool hasLayerUnderPoint = false;
-  for (auto item = _children.rbegin(); item != _children.rend(); ++item) {
-    const auto& childLayer = *item;
+  auto hitTestChild = [x, y, results](Layer* childLayer) {
     if (!childLayer->visible()) {
-      continue;
+      return false;
     }
 
     if (nullptr != childLayer->_scrollRect) {
       auto pointInChildSpace = childLayer->globalToLocal(Point::Make(x, y));
       if (!childLayer->_scrollRect->contains(pointInChildSpace.x, pointInChildSpace.y)) {
-        continue;
+        return false;
       }
     }
 
     if (nullptr != childLayer->_mask) {
       if (!childLayer->_mask->hitTestPoint(x, y)) {
-        continue;
+        return false;
       }
     }
 
-    if (childLayer->getLayersUnderPointInternal(x, y, results)) {
-      hasLayerUnderPoint = true;
+    return childLayer->getLayersUnderPointInternal(x, y, results);
+  };
+
+  bool hasLayerUnderPoint = false;
+  std::vector<size_t> candidates = {};
+  if (getHitTestCandidates(x, y, &candidates)) {
+    for (auto index = candidates.rbegin(); index != candidates.rend(); ++index) {
+      if (hitTestChild(_children[*index].get())) {
+        hasLayerUnderPoint = true;
+      }
+    }
+  } else {
+    for (auto item = _children.rbegin(); item != _children.rend(); ++item) {
+      if (hitTestChild(item->get())) {
+        hasLayerUnderPoint = true;
+      }
     }
   }
 
@@ -1975,6 +2030,104 @@ bool Layer::getLayersUnderPointInternal(float x, float y,
   return hasLayerUnderPoint;
 }
 
+bool Layer::getHitTestCandidates(float x, float y, std::vector<size_t>* candidates) {
+  if (!updateHitTestIndex()) {
+    return false;
+  }
+  Matrix inversedMatrix = {};
+  if (!getGlobalMatrix().asMatrix().invert(&inversedMatrix)) {
+    return false;
+  }
+  auto localPoint = inversedMatrix.mapXY(x, y);
+  hitTestIndex->query(localPoint.x, localPoint.y, candidates);
+  return true;
+}
+
+bool Layer::updateHitTestIndex() {
+  if (_children.size() < LayerBVH::MIN_CHILD_COUNT) {
+    return false;
+  }
+  // The children only notify the index about the first change after each render, so the index is
+  // trusted only when the whole subtree has been settled by the last updateRenderBounds() pass.
+  if (bitFields.dirtyDescendents) {
+    return false;
+  }
+  if (hitTestIndex == nullptr) {
+    hitTestIndex = std::make_unique<LayerBVH>(_children);
+    for (size_t i = 0; i < _children.size(); i++) {
+      updateHitTestSlot(i);
+    }
+    hitTestIndex->build();
+    return true;
+  }
+  for (auto index : hitTestIndex->takeStaleSlots()) {
+    updateHitTestSlot(index);
+  }
+  return true;
+}
+
+void Layer::updateHitTestSlot(size_t index) {
+  auto child = _children[index].get();
+  if (!child->bitFields.visible) {
+    hitTestIndex->setExcluded(index);
+    return;
+  }
+  Rect bounds = {};
+  if (!child->getHitTestBounds(&bounds)) {
+    hitTestIndex->setUnbounded(index);
+    return;
+  }
+  if (child->_scrollRect && !bounds.intersect(*child->_scrollRect)) {
+    hitTestIndex->setExcluded(index);
+    return;
+  }
+  bounds = child->getMatrixWithScrollRect().asMatrix().mapRect(bounds);
+  if (bounds.isEmpty()) {
+    hitTestIndex->setExcluded(index);
+    return;
+  }
+  hitTestIndex->setBounds(index, bounds);
+}
+
+bool Layer::getHitTestBounds(Rect* bounds) {
+  // Layers that may keep changing without notifying their parent cannot be bounded: dirty flags
+  // are only cleared by updateRenderBounds(), which skips subtrees with zero alpha. Layers in 3D
+  // space are not bounded either, since hit testing maps points through the flattened matrices.
+  if (_alpha <= 0 || bitFields.dirtyDescendents || bitFields.dirtyTransform ||
+      !bitFields.matrix3DIsAffine) {
+    return false;
+  }
+  if (hitTestBounds) {
+    *bounds = *hitTestBounds;
+    return !bitFields.hitTestUnbounded;
+  }
+  // Unlike getBounds(), filters and styles are ignored because hit testing only checks the content
+  // bounds, and filters such as a shadow-only DropShadowFilter may move the content away.
+  Rect result = {};
+  bool bounded = true;
+  if (auto content = getContent()) {
+    result = content->getBounds();
+  }
+  for (const auto& child : _children) {
+    if (!child->bitFields.visible) {
+      continue;
+    }
+    Rect childBounds = {};
+    if (!child->getHitTestBounds(&childBounds)) {
+      bounded = false;
+      break;
+    }
+    if (child->_scrollRect && !childBounds.intersect(*child->_scrollRect)) {
+      continue;
+    }
+    result.join(child->getMatrixWithScrollRect().asMatrix().mapRect(childBounds));
+  }
+  hitTestBounds = std::make_unique<Rect>(result);
+  bitFields.hitTestUnbounded = !bounded;
+  *bounds = result;
+  return bounded;
+}
+
 bool Layer::hasValidMask() const {
   return _mask && _mask->root() == root() && _mask->bitFields.visible;
 }
@@ -2006,7 +2159,7 @@ void Layer::updateRenderBounds(std::shared_ptr<RegionTransformer> transformer, b
   // children. Only rects that existed before this layer's subtree ran contribute to this layer's
   // background-blur sampling input; anything produced below (this layer's own content or its
   // descendants) paints above the blur result and must not participate in blur dirty expansion.
-  // The snapshot costs O(MAX_DIRTY_REGIONS) = O(1) per blur-capable layer.
+  // The snapshot costs O(MAX_DIRTY_REGIONS) per blur-capable layer.
   std::vector<Rect> backgroundSourceRects = {};
   for (const auto& style : _layerStyles) {
     if (style && NeedsBackgroundSource(style->extraSourceType())) {
@@ -2084,6 +2237,7 @@ void Layer::updateRenderBounds(std::shared_ptr<RegionTransformer> transformer, b
       renderBounds.join(child->renderBounds);
     }
   }
+  updateRenderIndex();
   auto backOutset = 0.f;
   // maxBackgroundOutset includes every background dependency, while minBackgroundOutset only
   // includes resolution-insensitive effects such as blur. Each LayerStyle classifies its own
@@ -2231,6 +2385,38 @@ void Layer::invalidateSubtree() {
   bitFields.staticSubtree = false;
   subtreeCache = nullptr;
   localBounds = nullptr;
+  hitTestBounds = nullptr;
+}
+
+void Layer::updateRenderIndex() {
+  if (_children.size() < LayerBVH::MIN_CHILD_COUNT) {
+    renderIndex = nullptr;
+    return;
+  }
+  auto rebuild = renderIndex == nullptr;
+  if (rebuild) {
+    renderIndex = std::make_unique<LayerBVH>(_children);
+  }
+  for (size_t i = 0; i < _children.size(); i++) {
+    auto child = _children[i].get();
+    if (child->maskOwner || !child->bitFields.visible || child->_alpha <= 0) {
+      renderIndex->setExcluded(i);
+    } else if (child->renderBounds.isEmpty() || child->canPreserve3D()) {
+      // drawLayer() does not cull layers with empty render bounds, and 3D subtrees are drawn
+      // through their own context.
+      renderIndex->setUnbounded(i);
+    } else {
+      renderIndex->setBounds(i, child->renderBounds);
+    }
+  }
+  if (rebuild) {
+    renderIndex->build();
+  }
+}
+
+void Layer::resetChildIndexes() {
+  renderIndex = nullptr;
+  hitTestIndex = nullptr;
 }
 
 void Layer::updateStaticSubtreeFlags() {
@@ -0,0 +1,429 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "LayerBVH.h"
+#include <algorithm>
+#include "core/utils/Log.h"
+
+namespace tgfx {
+// Leaves are enlarged by this fraction of their longer side, so children can move a little without
+// restructuring the tree.
+static constexpr float LEAF_MARGIN_RATIO = 0.1f;
+
+static Rect MakeLeafBounds(const Rect& bounds) {
+  auto margin = std::max(bounds.width(), bounds.height()) * LEAF_MARGIN_RATIO;
+  auto result = bounds;
+  result.outset(margin, margin);
+  return result;
+}
+
+static Rect Union(const Rect& a, const Rect& b) {
+  return Rect::MakeLTRB(std::min(a.left, b.left), std::min(a.top, b.top),
+                        std::max(a.right, b.right), std::max(a.bottom, b.bottom));
+}
+
+static bool Contains(const Rect& outer, const Rect& inner) {
+  return outer.left <= inner.left && outer.top <= inner.top && outer.right >= inner.right &&
+         outer.bottom >= inner.bottom;
+}
+
+static float Perimeter(const Rect& rect) {
+  return 2.0f * (rect.width() + rect.height());
+}
+
+LayerBVH::LayerBVH(const std::vector<std::shared_ptr<Layer>>& children) {
+  slots.resize(children.size());
+  for (size_t i = 0; i < children.size(); i++) {
+    slots[i].child = children[i].get();
+  }
+}
+
+void LayerBVH::setBounds(size_t index, const Rect& bounds) {
+  DEBUG_ASSERT(index < slots.size());
+  auto& slot = slots[index];
+  if (slot.state == SlotState::Unbounded) {
+    removeSlot(index);
+  }
+  slot.state = SlotState::Bounded;
+  auto leafBounds = MakeLeafBounds(bounds);
+  if (slot.leaf < 0) {
+    auto leaf = allocateNode();
+    slot.leaf = leaf;
+    nodes[static_cast<size_t>(leaf)].slot = index;
+    nodes[static_cast<size_t>(leaf)].bounds = leafBounds;
+    if (built) {
+      insertLeaf(leaf);
+    }
+    return;
+  }
+  auto leaf = slot.leaf;
+  auto& node = nodes[static_cast<size_t>(leaf)];
+  if (!built) {
+    node.bounds = leafBounds;
+    return;
+  }
+  // Keep the leaf while it still covers the child and is not much larger than a fresh one, which
+  // would make queries return too many false candidates.
+  if (Contains(node.bounds, bounds) && Perimeter(node.bounds) <= 2.0f * Perimeter(leafBounds)) {
+    return;
+  }
+  removeLeaf(leaf);
+  node.bounds = leafBounds;
+  insertLeaf(leaf);
+}
+
+void LayerBVH::setUnbounded(size_t index) {
+  DEBUG_ASSERT(index < slots.size());
+  auto& slot = slots[index];
+  if (slot.state == SlotState::Unbounded) {
+    return;
+  }
+  removeSlot(index);
+  slot.state = SlotState::Unbounded;
+  unboundedSlots.push_back(index);
+}
+
+void LayerBVH::setExcluded(size_t index) {
+  DEBUG_ASSERT(index < slots.size());
+  removeSlot(index);
+  slots[index].state = SlotState::Excluded;
+}
+
+void LayerBVH::build() {
+  std::vector<int> leaves = {};
+  leaves.reserve(slots.size());
+  for (auto& slot : slots) {
+    if (slot.leaf >= 0) {
+      leaves.push_back(slot.leaf);
+    }
+  }
+  rootNode = leaves.empty() ? -1 : buildNodes(leaves, 0, leaves.size());
+  if (rootNode >= 0) {
+    nodes[static_cast<size_t>(rootNode)].parent = -1;
+  }
+  built = true;
+}
+
+void LayerBVH::markStale(const Layer* child) {
+  if (slotMap.empty()) {
+    slotMap.reserve(slots.size());
+    for (size_t i = 0; i < slots.size(); i++) {
+      slotMap[slots[i].child] = i;
+    }
+  }
+  auto result = slotMap.find(child);
+  if (result == slotMap.end()) {
+    return;
+  }
+  auto& slot = slots[result->second];
+  if (slot.stale) {
+    return;
+  }
+  slot.stale = true;
+  staleSlots.push_back(result->second);
+}
+
+std::vector<size_t> LayerBVH::takeStaleSlots() {
+  for (auto index : staleSlots) {
+    slots[index].stale = false;
+  }
+  auto result = std::move(staleSlots);
+  staleSlots = {};
+  return result;
+}
+
+void LayerBVH::query(float x, float y, std::vector<size_t>* result) const {
+  collect(
+      [x, y](const Rect& bounds) {
+        return x >= bounds.left && x <= bounds.right && y >= bounds.top && y <= bounds.bottom;
+      },
+      result);
+}
+
+void LayerBVH::query(const std::vector<Rect>& rects, std::vector<size_t>* result) const {
+  collect(
+      [&rects](const Rect& bounds) {
+        for (auto& rect : rects) {
+          if (Rect::Intersects(rect, bounds)) {
+            return true;
+          }
+        }
+        return false;
+      },
+      result);
+}
+
+template <typename Predicate>
+void LayerBVH::collect(const Predicate& overlaps, std::vector<size_t>* result) const {
+  DEBUG_ASSERT(built);
+  result->clear();
+  if (rootNode >= 0) {
+    std::vector<int> stack = {rootNode};
+    while (!stack.empty()) {
+      auto& node = nodes[static_cast<size_t>(stack.back())];
+      stack.pop_back();
+      if (!overlaps(node.bounds)) {
+        continue;
+      }
+      if (node.isLeaf()) {
+        result->push_back(node.slot);
+      } else {
+        stack.push_back(node.left);
+        stack.push_back(node.right);
+      }
+    }
+  }
+  result->insert(result->end(), unboundedSlots.begin(), unboundedSlots.end());
+  std::sort(result->begin(), result->end());
+}
+
+void LayerBVH::removeSlot(size_t index) {
+  auto& slot = slots[index];
+  if (slot.leaf >= 0) {
+    if (built) {
+      removeLeaf(slot.leaf);
+    }
+    freeNode(slot.leaf);
+    slot.leaf = -1;
+  } else if (slot.state == SlotState::Unbounded) {
+    auto result = std::find(unboundedSlots.begin(), unboundedSlots.end(), index);
+    if (result != unboundedSlots.end()) {
+      unboundedSlots.erase(result);
+    }
+  }
+}
+
+int LayerBVH::allocateNode() {
+  if (!freeNodes.empty()) {
+    auto node = freeNodes.back();
+    freeNodes.pop_back();
+    nodes[static_cast<size_t>(node)] = {};
+    return node;
+  }
+  nodes.emplace_back();
+  return static_cast<int>(nodes.size()) - 1;
+}
+
+void LayerBVH::freeNode(int node) {
+  freeNodes.push_back(node);
+}
+
+int LayerBVH::buildNodes(std::vector<int>& leaves, size_t begin, size_t end) {
+  if (end - begin == 1) {
+    auto leaf = leaves[begin];
+    nodes[static_cast<size_t>(leaf)].height = 0;
+    return leaf;
+  }
+  auto centers = Rect::MakeEmpty();
+  bool first = true;
+  for (auto i = begin; i < end; i++) {
+    auto& bounds = nodes[static_cast<size_t>(leaves[i])].bounds;
+    auto centerX = bounds.centerX();
+    auto centerY = bounds.centerY();
+    if (first) {
+      centers.setLTRB(centerX, centerY, centerX, centerY);
+      first = false;
+    } else {
+      centers.setLTRB(std::min(centers.left, centerX), std::min(centers.top, centerY),
+                      std::max(centers.right, centerX), std::max(centers.bottom, centerY));
+    }
+  }
+  // Split at the median along the longer axis of the leaf centers.
+  auto splitX = centers.width() >= centers.height();
+  auto middle = begin + (end - begin) / 2;
+  std::nth_element(leaves.begin() + static_cast<std::ptrdiff_t>(begin),
+                   leaves.begin() + static_cast<std::ptrdiff_t>(middle),
+                   leaves.begin() + static_cast<std::ptrdiff_t>(end), [this, splitX](int a, int b) {
+                     auto& boundsA = nodes[static_cast<size_t>(a)].bounds;
+                     auto& boundsB = nodes[static_cast<size_t>(b)].bounds;
+                     return splitX ? boundsA.centerX() < boundsB.centerX()
+                                   : boundsA.centerY() < boundsB.centerY();
+                   });
+  auto left = buildNodes(leaves, begin, middle);
+  auto right = buildNodes(leaves, middle, end);
+  auto parent = allocateNode();
+  auto& node = nodes[static_cast<size_t>(parent)];
+  auto& leftNode = nodes[static_cast<size_t>(left)];
+  auto& rightNode = nodes[static_cast<size_t>(right)];
+  node.left = left;
+  node.right = right;
+  node.bounds = Union(leftNode.bounds, rightNode.bounds);
+  node.height = 1 + std::max(leftNode.height, rightNode.height);
+  leftNode.parent = parent;
+  rightNode.parent = parent;
+  return parent;
+}
+
+void LayerBVH::insertLeaf(int leaf) {
+  if (rootNode < 0) {
+    rootNode = leaf;
+    nodes[static_cast<size_t>(leaf)].parent = -1;
+    return;
+  }
+  // Descend towards the sibling that grows the total perimeter of the tree the least.
+  auto leafBounds = nodes[static_cast<size_t>(leaf)].bounds;
+  auto index = rootNode;
+  while (!nodes[static_cast<size_t>(index)].isLeaf()) {
+    auto& node = nodes[static_cast<size_t>(index)];
+    auto perimeter = Perimeter(node.bounds);
+    auto combinedPerimeter = Perimeter(Union(node.bounds, leafBounds));
+    auto cost = 2.0f * combinedPerimeter;
+    auto inheritanceCost = 2.0f * (combinedPerimeter - perimeter);
+    auto childCost = [&](int child) {
+      auto& childNode = nodes[static_cast<size_t>(child)];
+      auto childPerimeter = Perimeter(Union(childNode.bounds, leafBounds));
+      if (!childNode.isLeaf()) {
+        childPerimeter -= Perimeter(childNode.bounds);
+      }
+      return childPerimeter + inheritanceCost;
+    };
+    auto leftCost = childCost(node.left);
+    auto rightCost = childCost(node.right);
+    if (cost < leftCost && cost < rightCost) {
+      break;
+    }
+    index = leftCost < rightCost ? node.left : node.right;
+  }
+  auto sibling = index;
+  auto oldParent = nodes[static_cast<size_t>(sibling)].parent;
+  auto newParent = allocateNode();
+  auto& parentNode = nodes[static_cast<size_t>(newParent)];
+  parentNode.parent = oldParent;
+  parentNode.left = sibling;
+  parentNode.right = leaf;
+  parentNode.bounds = Union(leafBounds, nodes[static_cast<size_t>(sibling)].bounds);
+  parentNode.height = nodes[static_cast<size_t>(sibling)].height + 1;
+  nodes[static_cast<size_t>(sibling)].parent = newParent;
+  nodes[static_cast<size_t>(leaf)].parent = newParent;
+  if (oldParent >= 0) {
+    auto& oldParentNode = nodes[static_cast<size_t>(oldParent)];
+    if (oldParentNode.left == sibling) {
+      oldParentNode.left = newParent;
+    } else {
+      oldParentNode.right = newParent;
+    }
+  } else {
+    rootNode = newParent;
+  }
+  refit(newParent);
+}
+
+void LayerBVH::removeLeaf(int leaf) {
+  if (leaf == rootNode) {
+    rootNode = -1;
+    return;
+  }
+  auto parent = nodes[static_cast<size_t>(leaf)].parent;
+  auto& parentNode = nodes[static_cast<size_t>(parent)];
+  auto grandParent = parentNode.parent;
+  auto sibling = parentNode.left == leaf ? parentNode.right : parentNode.left;
+  nodes[static_cast<size_t>(sibling)].parent = grandParent;
+  nodes[static_cast<size_t>(leaf)].parent = -1;
+  freeNode(parent);
+  if (grandParent < 0) {
+    rootNode = sibling;
+    return;
+  }
+  auto& grandParentNode = nodes[static_cast<size_t>(grandParent)];
+  if (grandParentNode.left == parent) {
+    grandParentNode.left = sibling;
+  } else {
+    grandParentNode.right = sibling;
+  }
+  refit(grandParent);
+}
+
+void LayerBVH::refit(int node) {
+  auto index = node;
+  while (index >= 0) {
+    index = balance(index);
+    auto& current = nodes[static_cast<size_t>(index)];
+    auto& left = nodes[static_cast<size_t>(current.left)];
+    auto& right = nodes[static_cast<size_t>(current.right)];
+    current.height = 1 + std::max(left.height, right.height);
+    current.bounds = Union(left.bounds, right.bounds);
+    index = current.parent;
+  }
+}
+
+int LayerBVH::balance(int node) {
+  auto& a = nodes[static_cast<size_t>(node)];
+  if (a.isLeaf() || a.height < 2) {
+    return node;
+  }
+  auto indexB = a.left;
+  auto indexC = a.right;
+  auto& b = nodes[static_cast<size_t>(indexB)];
+  auto& c = nodes[static_cast<size_t>(indexC)];
+  auto replaceChild = [this](int parent, int oldChild, int newChild) {
+    if (parent < 0) {
+      rootNode = newChild;
+      return;
+    }
+    auto& parentNode = nodes[static_cast<size_t>(parent)];
+    if (parentNode.left == oldChild) {
+      parentNode.left = newChild;
+    } else {
+      parentNode.right = newChild;
+    }
+  };
+  if (c.height - b.height > 1) {
+    // Rotate C up.
+    auto indexF = c.left;
+    auto indexG = c.right;
+    auto& f = nodes[static_cast<size_t>(indexF)];
+    auto& g = nodes[static_cast<size_t>(indexG)];
+    c.left = node;
+    c.parent = a.parent;
+    a.parent = indexC;
+    replaceChild(c.parent, node, indexC);
+    auto& kept = f.height > g.height ? f : g;
+    auto& moved = f.height > g.height ? g : f;
+    c.right = f.height > g.height ? indexF : indexG;
+    a.right = f.height > g.height ? indexG : indexF;
+    moved.parent = node;
+    a.bounds = Union(b.bounds, moved.bounds);
+    c.bounds = Union(a.bounds, kept.bounds);
+    a.height = 1 + std::max(b.height, moved.height);
+    c.height = 1 + std::max(a.height, kept.height);
+    return indexC;
+  }
+  if (b.height - c.height > 1) {
+    // Rotate B up.
+    auto indexD = b.left;
+    auto indexE = b.right;
+    auto& d = nodes[static_cast<size_t>(indexD)];
+    auto& e = nodes[static_cast<size_t>(indexE)];
+    b.left = node;
+    b.parent = a.parent;
+    a.parent = indexB;
+    replaceChild(b.parent, node, indexB);
+    auto& kept = d.height > e.height ? d : e;
+    auto& moved = d.height > e.height ? e : d;
+    b.right = d.height > e.height ? indexD : indexE;
+    a.left = d.height > e.height ? indexE : indexD;
+    moved.parent = node;
+    a.bounds = Union(c.bounds, moved.bounds);
+    b.bounds = Union(a.bounds, kept.bounds);
+    a.height = 1 + std::max(c.height, moved.height);
+    b.height = 1 + std::max(a.height, kept.height);
+    return indexB;
+  }
+  return node;
+}
+}  // namespace tgfx
@@ -0,0 +1,128 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "tgfx/core/Rect.h"
+
+namespace tgfx {
+class Layer;
+
+/**
+ * LayerBVH is a dynamic bounding volume hierarchy over the children of a container layer. Each
+ * child owns one slot, addressed by its index in the children list. A slot is either excluded
+ * (never returned by queries), unbounded (always returned) or bounded by a rect stored in an
+ * enlarged leaf, so small movements of a child do not restructure the tree. Queries return the
+ * matching slot indices in ascending order, which keeps the painting order of the children.
+ */
+class LayerBVH {
+ public:
+  /**
+   * Containers with fewer children than this are cheaper to scan linearly.
+   */
+  static constexpr size_t MIN_CHILD_COUNT = 64;
+
+  /**
+   * Creates an index for the given children. All slots start excluded until set, and the tree is
+   * created by build() after the initial slots are assigned.
+   */
+  explicit LayerBVH(const std::vector<std::shared_ptr<Layer>>& children);
+
+  size_t childCount() const {
+    return slots.size();
+  }
+
+  void setBounds(size_t index, const Rect& bounds);
+
+  void setUnbounded(size_t index);
+
+  void setExcluded(size_t index);
+
+  /**
+   * Builds the tree from all bounded slots in one pass. Later slot changes update the tree
+   * incrementally.
+   */
+  void build();
+
+  /**
+   * Records that the bounds of the given child may have changed since its slot was last set.
+   */
+  void markStale(const Layer* child);
+
+  /**
+   * Returns the indices of all stale slots and clears the stale marks.
+   */
+  std::vector<size_t> takeStaleSlots();
+
+  /**
+   * Collects the slots whose bounds contain the given point, plus all unbounded slots.
+   */
+  void query(float x, float y, std::vector<size_t>* result) const;
+
+  /**
+   * Collects the slots whose bounds intersect any of the given rects, plus all unbounded slots.
+   */
+  void query(const std::vector<Rect>& rects, std::vector<size_t>* result) const;
+
+ private:
+  enum class SlotState : uint8_t { Excluded, Unbounded, Bounded };
+
+  struct Slot {
+    const Layer* child = nullptr;
+    int leaf = -1;
+    SlotState state = SlotState::Excluded;
+    bool stale = false;
+  };
+
+  struct Node {
+    Rect bounds = {};
+    int parent = -1;
+    int left = -1;
+    int right = -1;
+    int height = 0;
+    size_t slot = 0;
+
+    bool isLeaf() const {
+      return left < 0;
+    }
+  };
+
+  std::vector<Slot> slots = {};
+  std::vector<Node> nodes = {};
+  std::vector<int> freeNodes = {};
+  std::vector<size_t> unboundedSlots = {};
+  std::vector<size_t> staleSlots = {};
+  std::unordered_map<const Layer*, size_t> slotMap = {};
+  int rootNode = -1;
+  bool built = false;
+
+  void removeSlot(size_t index);
+  int allocateNode();
+  void freeNode(int node);
+  int buildNodes(std::vector<int>& leaves, size_t begin, size_t end);
+  void insertLeaf(int leaf);
+  void removeLeaf(int leaf);
+  int balance(int node);
+  void refit(int node);
+  template <typename Predicate>
+  void collect(const Predicate& overlaps, std::vector<size_t>* result) const;
+};
+}  // namespace tgfx
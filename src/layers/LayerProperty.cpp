@@ -34,6 +34,14 @@ void LayerProperty::invalidateTransform() {
 }
 
 void LayerProperty::attachToLayer(Layer* layer) {
+  for (const auto& owner : owners) {
+    if (owner != layer) {
+      // Properties keep mutable caches that are refreshed while their owners update contents, so
+      // layers sharing a property must never update their contents concurrently.
+      owner->bitFields.sharedProperty = true;
+      layer->bitFields.sharedProperty = true;
+    }
+  }
   owners.push_back(layer);
 }
 
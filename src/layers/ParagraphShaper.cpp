@@ -0,0 +1,230 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ParagraphShaper.h"
+#include "tgfx/core/UTF.h"
+#ifdef TGFX_USE_HARFBUZZ
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include "hb.h"
+#endif
+
+namespace tgfx {
+// Characters that extend the cluster of the character before them, such as combining marks,
+// variation selectors, joiners and emoji modifiers.
+static bool IsClusterExtender(Unichar c) {
+  return (c >= 0x0300 && c <= 0x036F) || (c >= 0x1AB0 && c <= 0x1AFF) ||
+         (c >= 0x1DC0 && c <= 0x1DFF) || (c >= 0x20D0 && c <= 0x20FF) || c == 0x200C ||
+         c == 0x200D || (c >= 0xFE00 && c <= 0xFE0F) || (c >= 0xFE20 && c <= 0xFE2F) ||
+         (c >= 0x1F3FB && c <= 0x1F3FF) || (c >= 0xE0020 && c <= 0xE007F) ||
+         (c >= 0xE0100 && c <= 0xE01EF);
+}
+
+struct ShapedChar {
+  size_t offset = 0;
+  Unichar unichar = 0;
+  GlyphID glyphID = 0;
+  std::shared_ptr<Typeface> typeface = nullptr;
+};
+
+static std::vector<ShapedChar> MapCharacters(
+    const std::string& text, const std::shared_ptr<Typeface>& typeface,
+    const std::vector<std::shared_ptr<Typeface>>& fallbackTypefaces) {
+  std::vector<ShapedChar> chars = {};
+  chars.reserve(text.size());
+  const char* start = text.data();
+  const char* head = start;
+  const char* tail = start + text.size();
+  while (head < tail) {
+    ShapedChar item = {};
+    item.offset = static_cast<size_t>(head - start);
+    item.unichar = UTF::NextUTF8(&head, tail);
+    if (!chars.empty() && chars.back().typeface && IsClusterExtender(item.unichar)) {
+      // Keep the cluster in one typeface if it has the extender, otherwise fall back as usual.
+      auto glyphID = chars.back().typeface->getGlyphID(item.unichar);
+      if (glyphID > 0) {
+        item.glyphID = glyphID;
+        item.typeface = chars.back().typeface;
+        chars.push_back(std::move(item));
+        continue;
+      }
+    }
+    if (typeface != nullptr) {
+      item.glyphID = typeface->getGlyphID(item.unichar);
+      item.typeface = typeface;
+    }
+    if (item.glyphID == 0) {
+      for (const auto& fallbackTypeface : fallbackTypefaces) {
+        if (fallbackTypeface == nullptr) {
+          continue;
+        }
+        auto glyphID = fallbackTypeface->getGlyphID(item.unichar);
+        if (glyphID > 0) {
+          item.glyphID = glyphID;
+          item.typeface = fallbackTypeface;
+          break;
+        }
+      }
+    }
+    chars.push_back(std::move(item));
+  }
+  return chars;
+}
+
+#ifdef TGFX_USE_HARFBUZZ
+// Characters whose glyphs depend on their neighbours: right-to-left and Indic scripts, Thai, Lao,
+// Tibetan, Myanmar, Hangul Jamo, Khmer, Mongolian, Arabic presentation forms and flag sequences.
+static bool NeedsComplexShaping(Unichar c) {
+  return IsClusterExtender(c) || (c >= 0x0590 && c <= 0x0DFF) || (c >= 0x0E00 && c <= 0x109F) ||
+         (c >= 0x1100 && c <= 0x11FF) || (c >= 0x1780 && c <= 0x18AF) ||
+         (c >= 0xFB1D && c <= 0xFDFF) || (c >= 0xFE70 && c <= 0xFEFE) ||
+         (c >= 0x1F1E6 && c <= 0x1F1FF);
+}
+
+static constexpr size_t MaxHBFontCount = 32;
+static std::mutex& HBFontLocker = *new std::mutex;
+static auto& HBFontCache = *new std::list<std::pair<uint32_t, std::shared_ptr<hb_font_t>>>;
+
+static hb_blob_t* GetHBTable(hb_face_t*, hb_tag_t tag, void* userData) {
+  auto typeface = static_cast<std::shared_ptr<Typeface>*>(userData);
+  auto data = (*typeface)->copyTableData(tag);
+  if (data == nullptr) {
+    return nullptr;
+  }
+  auto holder = new std::shared_ptr<Data>(data);
+  return hb_blob_create(static_cast<const char*>(data->data()),
+                        static_cast<unsigned>(data->size()), HB_MEMORY_MODE_READONLY, holder,
+                        [](void* ctx) { delete static_cast<std::shared_ptr<Data>*>(ctx); });
+}
+
+static std::shared_ptr<hb_font_t> GetHBFont(const std::shared_ptr<Typeface>& typeface) {
+  std::lock_guard<std::mutex> autoLock(HBFontLocker);
+  for (auto iter = HBFontCache.begin(); iter != HBFontCache.end(); ++iter) {
+    if (iter->first == typeface->uniqueID()) {
+      HBFontCache.splice(HBFontCache.begin(), HBFontCache, iter);
+      return iter->second;
+    }
+  }
+  auto hbFace = hb_face_create_for_tables(
+      GetHBTable, new std::shared_ptr<Typeface>(typeface),
+      [](void* ctx) { delete static_cast<std::shared_ptr<Typeface>*>(ctx); });
+  hb_face_set_upem(hbFace, static_cast<unsigned>(typeface->unitsPerEm()));
+  auto hbFont = std::shared_ptr<hb_font_t>(hb_font_create(hbFace), hb_font_destroy);
+  hb_face_destroy(hbFace);
+  if (hbFont.get() == hb_font_get_empty()) {
+    return nullptr;
+  }
+  // Immutable fonts can be shared by layers that update their contents on different threads.
+  hb_font_make_immutable(hbFont.get());
+  HBFontCache.emplace_front(typeface->uniqueID(), hbFont);
+  if (HBFontCache.size() > MaxHBFontCount) {
+    HBFontCache.pop_back();
+  }
+  return hbFont;
+}
+
+static bool ShapeComplexRun(const std::string& text, size_t start, size_t end, const Font& font,
+                            std::vector<std::shared_ptr<GlyphInfo>>* glyphs) {
+  auto typeface = font.getTypeface();
+  auto unitsPerEm = typeface->unitsPerEm();
+  if (unitsPerEm <= 0) {
+    return false;
+  }
+  auto hbFont = GetHBFont(typeface);
+  if (hbFont == nullptr) {
+    return false;
+  }
+  auto buffer = std::shared_ptr<hb_buffer_t>(hb_buffer_create(), hb_buffer_destroy);
+  if (!hb_buffer_allocation_successful(buffer.get())) {
+    return false;
+  }
+  // The whole paragraph is passed as context, so joining scripts see their neighbours.
+  hb_buffer_add_utf8(buffer.get(), text.data(), static_cast<int>(text.size()),
+                     static_cast<unsigned>(start), static_cast<int>(end - start));
+  hb_buffer_guess_segment_properties(buffer.get());
+  hb_shape(hbFont.get(), buffer.get(), nullptr, 0);
+  unsigned count = 0;
+  auto infos = hb_buffer_get_glyph_infos(buffer.get(), &count);
+  auto positions = hb_buffer_get_glyph_positions(buffer.get(), nullptr);
+  auto scale = font.getSize() / static_cast<float>(unitsPerEm);
+  auto emptyAdvance = font.getSize() / 2.0f;
+  const char* tail = text.data() + text.size();
+  for (unsigned i = 0; i < count; i++) {
+    const char* head = text.data() + infos[i].cluster;
+    auto unichar = UTF::NextUTF8(&head, tail);
+    auto glyphID = static_cast<GlyphID>(infos[i].codepoint);
+    if (glyphID == 0) {
+      glyphs->push_back(std::make_shared<GlyphInfo>(unichar, 0, typeface, emptyAdvance));
+      continue;
+    }
+    auto advance = static_cast<float>(positions[i].x_advance) * scale;
+    // HarfBuzz offsets point up, while the y axis of the layer points down.
+    auto offset = Point::Make(static_cast<float>(positions[i].x_offset) * scale,
+                              -static_cast<float>(positions[i].y_offset) * scale);
+    glyphs->push_back(std::make_shared<GlyphInfo>(unichar, glyphID, typeface, advance, offset));
+  }
+  return true;
+}
+#endif
+
+std::vector<std::shared_ptr<GlyphInfo>> ParagraphShaper::Shape(
+    const std::string& text, const Font& font,
+    const std::vector<std::shared_ptr<Typeface>>& fallbackTypefaces) {
+  auto chars = MapCharacters(text, font.getTypeface(), fallbackTypefaces);
+  std::vector<std::shared_ptr<GlyphInfo>> glyphs = {};
+  glyphs.reserve(chars.size());
+  auto emptyAdvance = font.getSize() / 2.0f;
+  size_t runStart = 0;
+  while (runStart < chars.size()) {
+    auto typeface = chars[runStart].typeface;
+    auto runEnd = runStart;
+    while (runEnd < chars.size() && chars[runEnd].typeface == typeface) {
+      runEnd++;
+    }
+    auto runFont = font;
+    runFont.setTypeface(typeface);
+#ifdef TGFX_USE_HARFBUZZ
+    auto complex = std::any_of(chars.begin() + static_cast<std::ptrdiff_t>(runStart),
+                               chars.begin() + static_cast<std::ptrdiff_t>(runEnd),
+                               [](const ShapedChar& item) {
+                                 return NeedsComplexShaping(item.unichar);
+                               });
+    if (complex && typeface != nullptr) {
+      auto endOffset = runEnd < chars.size() ? chars[runEnd].offset : text.size();
+      if (ShapeComplexRun(text, chars[runStart].offset, endOffset, runFont, &glyphs)) {
+        runStart = runEnd;
+        continue;
+      }
+    }
+#endif
+    for (auto i = runStart; i < runEnd; i++) {
+      auto& item = chars[i];
+      if (item.glyphID == 0) {
+        // Characters that no typeface supports are left as blank spaces.
+        glyphs.push_back(std::make_shared<GlyphInfo>(' ', 0, font.getTypeface(), emptyAdvance));
+      } else {
+        glyphs.push_back(std::make_shared<GlyphInfo>(item.unichar, item.glyphID, typeface,
+                                                     runFont.getAdvance(item.glyphID)));
+      }
+    }
+    runStart = runEnd;
+  }
+  return glyphs;
+}
+}  // namespace tgfx
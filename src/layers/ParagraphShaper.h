@@ -0,0 +1,86 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "tgfx/core/Font.h"
+
+namespace tgfx {
+class GlyphInfo {
+ public:
+  GlyphInfo(Unichar unichar, GlyphID glyphID, std::shared_ptr<Typeface> typeface, float advance,
+            const Point& offset = {})
+      : _unichar(unichar), _glyphID(glyphID), _typeface(std::move(typeface)), _advance(advance),
+        _offset(offset) {
+  }
+
+  Unichar getUnichar() const {
+    return _unichar;
+  }
+
+  GlyphID getGlyphID() const {
+    return _glyphID;
+  }
+
+  std::shared_ptr<Typeface> getTypeface() const {
+    return _typeface;
+  }
+
+  /**
+   * Returns the horizontal advance of the glyph at the font size it was shaped with.
+   */
+  float getAdvance() const {
+    return _advance;
+  }
+
+  /**
+   * Returns the offset of the glyph from its pen position, such as the placement of a combining
+   * mark above its base glyph.
+   */
+  const Point& getOffset() const {
+    return _offset;
+  }
+
+ private:
+  Unichar _unichar = 0;
+  GlyphID _glyphID = 0;
+  std::shared_ptr<Typeface> _typeface = nullptr;
+  float _advance = 0.0f;
+  Point _offset = {};
+};
+
+/**
+ * ParagraphShaper converts a single paragraph of text (without line breaks) into positioned
+ * glyphs. Each character is mapped to the first typeface that supports it, and runs of complex
+ * scripts (Arabic, Indic, Thai, combining marks, emoji sequences, etc.) are shaped by HarfBuzz
+ * when TGFX_USE_HARFBUZZ is defined. Other runs map each character through the cmap of its
+ * typeface, which is much faster.
+ */
+class ParagraphShaper {
+ public:
+  /**
+   * Shapes the given paragraph with the font. Characters that no typeface supports are returned
+   * as glyph 0 with an advance of half the font size.
+   */
+  static std::vector<std::shared_ptr<GlyphInfo>> Shape(
+      const std::string& text, const Font& font,
+      const std::vector<std::shared_ptr<Typeface>>& fallbackTypefaces);
+};
+}  // namespace tgfx
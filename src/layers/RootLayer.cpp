@@ -17,20 +17,11 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "RootLayer.h"
-#include <limits>
 #include "core/utils/DecomposeRects.h"
 #include "core/utils/Log.h"
 #include "layers/DrawArgs.h"
 
 namespace tgfx {
-static float UnionArea(const Rect& rect1, const Rect& rect2) {
-  auto left = rect1.left < rect2.left ? rect1.left : rect2.left;
-  auto right = rect1.right > rect2.right ? rect1.right : rect2.right;
-  auto top = rect1.top < rect2.top ? rect1.top : rect2.top;
-  auto bottom = rect1.bottom > rect2.bottom ? rect1.bottom : rect2.bottom;
-  return (right - left) * (bottom - top);
-}
-
 std::shared_ptr<RootLayer> RootLayer::Make() {
   return std::shared_ptr<RootLayer>(new RootLayer());
 }
@@ -45,39 +36,11 @@ void RootLayer::invalidateRect(const Rect& rect) {
   if (rect.isEmpty()) {
     return;
   }
-  DEBUG_ASSERT(dirtyRects.size() <= MAX_DIRTY_REGIONS);
   dirtyRects.push_back(rect);
-  dirtyAreas.push_back(rect.area());
-  mergeDirtyList(dirtyRects.size() == MAX_DIRTY_REGIONS + 1);
-}
-
-bool RootLayer::mergeDirtyList(bool forceMerge) {
-  // Merge the pair of rectangles that increases the total area the least.
-  auto dirtySize = dirtyRects.size();
-  if (dirtySize <= 1) {
-    return false;
+  // Merging in batches keeps the cost of each invalidation amortized to O(log n).
+  if (dirtyRects.size() > MAX_DIRTY_REGIONS * 2) {
+    MergeRects(&dirtyRects, MAX_DIRTY_REGIONS);
   }
-  float bestDelta = forceMerge ? std::numeric_limits<float>::max() : 0;
-  size_t mergeA = 0;
-  size_t mergeB = 0;
-  for (size_t i = 0; i < dirtySize; i++) {
-    for (size_t j = i + 1; j < dirtySize; j++) {
-      auto delta = UnionArea(dirtyRects[i], dirtyRects[j]) - dirtyAreas[i] - dirtyAreas[j];
-      if (bestDelta > delta) {
-        mergeA = i;
-        mergeB = j;
-        bestDelta = delta;
-      }
-    }
-  }
-  if (mergeA != mergeB) {
-    dirtyRects[mergeA].join(dirtyRects[mergeB]);
-    dirtyAreas[mergeA] = dirtyRects[mergeA].area();
-    dirtyRects.erase(dirtyRects.begin() + static_cast<long>(mergeB));
-    dirtyAreas.erase(dirtyAreas.begin() + static_cast<long>(mergeB));
-    return true;
-  }
-  return false;
 }
 
 bool RootLayer::invalidateBackground(const Rect& drawRect, LayerStyle* layerStyle,
@@ -107,11 +70,10 @@ bool RootLayer::invalidateBackground(const Rect& drawRect, LayerStyle* layerStyl
 
 std::vector<Rect> RootLayer::updateDirtyRegions() {
   updateRenderBounds();
-  while (mergeDirtyList(false)) {
-  }
-  dirtyAreas.clear();
-  DecomposeRects(dirtyRects.data(), dirtyRects.size());
-  return std::move(dirtyRects);
+  MergeRects(&dirtyRects, MAX_DIRTY_REGIONS);
+  auto dirtyRegions = DecomposeRects(dirtyRects);
+  dirtyRects.clear();
+  return dirtyRegions;
 }
 
 }  // namespace tgfx
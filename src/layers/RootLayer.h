@@ -22,8 +22,13 @@
 #include "tgfx/layers/Layer.h"
 
 namespace tgfx {
-// Maximum number of dirty regions that can be tracked in the root layer.
-static constexpr size_t MAX_DIRTY_REGIONS = 3;
+// Maximum number of dirty regions that can be tracked in the root layer. Nearby regions are merged
+// once there are more, so many small updates far apart from each other stay separate.
+static constexpr size_t MAX_DIRTY_REGIONS = 256;
+
+// Maximum number of rects redrawn by partial rendering in one frame. Each rect is a separate
+// traversal of the layer tree, so the dirty regions are merged further down to this count.
+static constexpr size_t MAX_PARTIAL_RENDER_RECTS = 4;
 
 /**
  * The RootLayer class represents the root layer of a display list. It is the top-level layer that
@@ -82,9 +87,6 @@ class RootLayer : public Layer {
 
  private:
   std::vector<Rect> dirtyRects = {};
-  std::vector<float> dirtyAreas = {};
-
-  bool mergeDirtyList(bool forceMerge);
 
   friend class DisplayList;
 };
@@ -17,36 +17,15 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "tgfx/layers/TextLayer.h"
+#include <string_view>
+#include <unordered_map>
 #include "core/utils/Log.h"
+#include "layers/ParagraphShaper.h"
 #include "tgfx/core/TextBlob.h"
 #include "tgfx/core/TextBlobBuilder.h"
 #include "tgfx/core/UTF.h"
 
 namespace tgfx {
-class GlyphInfo {
- public:
-  GlyphInfo(Unichar unichar, GlyphID glyphID, std::shared_ptr<Typeface> typeface)
-      : _unichar(unichar), _glyphID(glyphID), _typeface(std::move(typeface)) {
-  }
-
-  Unichar getUnichar() const {
-    return _unichar;
-  }
-
-  GlyphID getGlyphID() const {
-    return _glyphID;
-  }
-
-  std::shared_ptr<Typeface> getTypeface() const {
-    return _typeface;
-  }
-
- private:
-  Unichar _unichar = 0;
-  GlyphID _glyphID = 0;
-  std::shared_ptr<Typeface> _typeface = nullptr;
-};
-
 class GlyphLine {
  public:
   GlyphLine() = default;
@@ -79,16 +58,29 @@ class GlyphLine {
   std::vector<std::pair<std::shared_ptr<GlyphInfo>, float>> _glyphInfosAndAdvance = {};
 };
 
+class ShapedParagraph {
+ public:
+  ShapedParagraph(std::string text, std::vector<std::shared_ptr<GlyphInfo>> glyphInfos)
+      : text(std::move(text)), glyphInfos(std::move(glyphInfos)) {
+  }
+
+  std::string text;
+  std::vector<std::shared_ptr<GlyphInfo>> glyphInfos;
+};
+
 static std::mutex& TypefaceMutex = *new std::mutex;
 static std::vector<std::shared_ptr<Typeface>> FallbackTypefaces = {};
+static uint32_t FallbackGeneration = 0;
 
 void TextLayer::SetFallbackTypefaces(std::vector<std::shared_ptr<Typeface>> typefaces) {
   std::lock_guard<std::mutex> lock(TypefaceMutex);
   FallbackTypefaces = std::move(typefaces);
+  FallbackGeneration++;
 }
 
-std::vector<std::shared_ptr<Typeface>> GetFallbackTypefaces() {
+static std::vector<std::shared_ptr<Typeface>> GetFallbackTypefaces(uint32_t* generation) {
   std::lock_guard<std::mutex> lock(TypefaceMutex);
+  *generation = FallbackGeneration;
   return FallbackTypefaces;
 }
 
@@ -166,25 +158,21 @@ void TextLayer::onUpdateContent(LayerRecorder* recorder) {
   // 1. preprocess newlines, convert \r\n, \r to \n
   const std::string text = PreprocessNewLines(_text);
 
-  // 2. shape text to glyphs, handle font fallback
-  const auto& glyphInfos = ShapeText(text, _font.getTypeface());
-  if (glyphInfos.empty()) {
-    return;
-  }
+  // 2. shape the paragraphs whose text changed since the last update, handle font fallback
+  updateShapedParagraphs(text);
 
   // 3. Handle text wrapping and auto-wrapping
   std::vector<std::shared_ptr<GlyphLine>> glyphLines = {};
   auto glyphLine = std::make_shared<GlyphLine>();
   const auto emptyAdvance = _font.getSize() / 2.0f;
-  float xOffset = 0;
-  for (auto& glyphInfo : glyphInfos) {
-    const auto characterUnicode = glyphInfo->getUnichar();
-    if ('\n' == characterUnicode) {
-      xOffset = 0;
+  for (size_t i = 0; i < shapedParagraphs.size(); ++i) {
+    if (i > 0) {
       glyphLines.emplace_back(glyphLine);
       glyphLine = std::make_shared<GlyphLine>();
-    } else {
-      const float advance = calcAdvance(glyphInfo, emptyAdvance);
+    }
+    float xOffset = 0;
+    for (auto& glyphInfo : shapedParagraphs[i]->glyphInfos) {
+      const float advance = glyphInfo->getAdvance();
       // If _width is 0, auto-wrap is disabled and no wrapping will occur.
       if (_autoWrap && (0.0f != _width) && (xOffset + advance > _width)) {
         xOffset = 0;
@@ -242,24 +230,65 @@ std::string TextLayer::PreprocessNewLines(const std::string& text) {
   return result;
 }
 
-float TextLayer::calcAdvance(const std::shared_ptr<GlyphInfo>& glyphInfo,
-                             float emptyAdvance) const {
-  if (glyphInfo == nullptr) {
-    return 0.0f;
-  }
-
-  float advance = 0.0f;
-  const auto glyphID = glyphInfo->getGlyphID();
-  const auto typeface = glyphInfo->getTypeface();
-  if (glyphID <= 0 || typeface == nullptr) {
-    advance = emptyAdvance;
-  } else {
-    auto font = _font;
-    font.setTypeface(typeface);
-    advance = font.getAdvance(glyphID);
+void TextLayer::updateShapedParagraphs(const std::string& text) {
+  uint32_t fallbackGeneration = 0;
+  auto fallbackTypefaces = GetFallbackTypefaces(&fallbackGeneration);
+  if (_font != shapedFont || fallbackGeneration != shapedFallbackGeneration) {
+    shapedParagraphs.clear();
+    shapedFont = _font;
+    shapedFallbackGeneration = fallbackGeneration;
+  }
+  std::vector<std::string_view> lines = {};
+  size_t lineStart = 0;
+  while (true) {
+    auto lineEnd = text.find('\n', lineStart);
+    if (lineEnd == std::string::npos) {
+      lines.emplace_back(text.data() + lineStart, text.size() - lineStart);
+      break;
+    }
+    lines.emplace_back(text.data() + lineStart, lineEnd - lineStart);
+    lineStart = lineEnd + 1;
+  }
+  // An edit usually touches a few paragraphs, so the unchanged ones at both ends are kept as they
+  // are, and the ones in between are looked up by their text before shaping them again.
+  std::vector<std::shared_ptr<ShapedParagraph>> oldParagraphs = {};
+  oldParagraphs.swap(shapedParagraphs);
+  size_t prefix = 0;
+  auto maxCommon = std::min(lines.size(), oldParagraphs.size());
+  while (prefix < maxCommon && lines[prefix] == oldParagraphs[prefix]->text) {
+    prefix++;
+  }
+  size_t suffix = 0;
+  while (suffix < maxCommon - prefix &&
+         lines[lines.size() - 1 - suffix] ==
+             oldParagraphs[oldParagraphs.size() - 1 - suffix]->text) {
+    suffix++;
+  }
+  std::unordered_map<std::string_view, std::shared_ptr<ShapedParagraph>> reusable = {};
+  for (size_t i = prefix; i < oldParagraphs.size() - suffix; ++i) {
+    reusable.emplace(oldParagraphs[i]->text, oldParagraphs[i]);
+  }
+  shapedParagraphs.reserve(lines.size());
+  for (size_t i = 0; i < lines.size(); ++i) {
+    if (i < prefix) {
+      shapedParagraphs.push_back(std::move(oldParagraphs[i]));
+      continue;
+    }
+    if (i >= lines.size() - suffix) {
+      auto oldIndex = oldParagraphs.size() - (lines.size() - i);
+      shapedParagraphs.push_back(std::move(oldParagraphs[oldIndex]));
+      continue;
+    }
+    auto result = reusable.find(lines[i]);
+    if (result != reusable.end()) {
+      shapedParagraphs.push_back(result->second);
+      continue;
+    }
+    std::string line(lines[i]);
+    auto glyphInfos = ParagraphShaper::Shape(line, _font, fallbackTypefaces);
+    shapedParagraphs.push_back(
+        std::make_shared<ShapedParagraph>(std::move(line), std::move(glyphInfos)));
   }
-
-  return advance;
 }
 
 float TextLayer::getLineHeight(const std::shared_ptr<GlyphLine>& glyphLine) const {
@@ -324,51 +353,6 @@ void TextLayer::truncateGlyphLines(std::vector<std::shared_ptr<GlyphLine>>& glyp
   }
 }
 
-std::vector<std::shared_ptr<GlyphInfo>> TextLayer::ShapeText(
-    const std::string& text, const std::shared_ptr<Typeface>& typeface) {
-  if (text.empty()) {
-    return {};
-  }
-
-  const char* head = text.data();
-  const char* tail = head + text.size();
-  auto fallbackTypefaces = GetFallbackTypefaces();
-  std::vector<std::shared_ptr<GlyphInfo>> glyphInfos;
-  glyphInfos.reserve(text.size());
-
-  while (head < tail) {
-    const auto characterUnicode = UTF::NextUTF8(&head, tail);
-    if ('\n' == characterUnicode) {
-      const GlyphID lineFeedCharacterGlyphID = nullptr != typeface ? typeface->getGlyphID('\n') : 0;
-      glyphInfos.emplace_back(
-          std::make_shared<GlyphInfo>('\n', lineFeedCharacterGlyphID, typeface));
-    } else {
-      GlyphID glyphID = typeface ? typeface->getGlyphID(characterUnicode) : 0;
-      if (glyphID <= 0) {
-        for (const auto& fallbackTypeface : fallbackTypefaces) {
-          if (nullptr != fallbackTypeface) {
-            glyphID = fallbackTypeface->getGlyphID(characterUnicode);
-            if (glyphID > 0) {
-              glyphInfos.emplace_back(
-                  std::make_shared<GlyphInfo>(characterUnicode, glyphID, fallbackTypeface));
-              break;
-            }
-          }
-        }
-
-        // If the glyph is still not found, use the space character.
-        if (glyphID <= 0) {
-          glyphInfos.emplace_back(std::make_shared<GlyphInfo>(' ', 0, typeface));
-        }
-      } else {
-        glyphInfos.emplace_back(std::make_shared<GlyphInfo>(characterUnicode, glyphID, typeface));
-      }
-    }
-  }
-
-  return glyphInfos;
-}
-
 void TextLayer::resolveTextAlignment(const std::vector<std::shared_ptr<GlyphLine>>& glyphLines,
                                      float emptyAdvance,
                                      std::vector<std::shared_ptr<GlyphInfo>>& finalGlyphInfos,
@@ -441,6 +425,7 @@ void TextLayer::resolveTextAlignment(const std::vector<std::shared_ptr<GlyphLine
         point.x += xOffset;
       }
       point.y = yOffset;
+      point += glyphInfo->getOffset();
 
       finalGlyphInfos.emplace_back(glyphInfo);
       positions.emplace_back(point);
@@ -40,11 +40,13 @@ Rect LayerImageFilter::filterBounds(const Rect& srcRect, float contentScale,
 }
 
 void LayerImageFilter::onInvalidateFilter() {
+  std::lock_guard<std::mutex> autoLock(locker);
   lastFilter = nullptr;
   dirty = true;
 }
 
 std::shared_ptr<ImageFilter> LayerImageFilter::getImageFilter(float scale) {
+  std::lock_guard<std::mutex> autoLock(locker);
   if (lastScale != scale || dirty) {
     lastFilter = onCreateImageFilter(scale);
     lastScale = scale;
@@ -802,16 +802,17 @@ void PDFExportContext::drawLayer(std::shared_ptr<Picture> picture,
       const auto innerShadowFilter = static_cast<const InnerShadowImageFilter*>(imageFilter.get());
       PlaybackContext playbackContext = {};
       Matrix currentMatrix = Matrix::I();
-      for (const auto& record : picture->records) {
+      picture->forEachRecord([&](const PictureRecord* record) {
         if (!innerShadowFilter->shadowOnly) {
           record->playback(this, &playbackContext);
         }
         if (record->type() == PictureRecordType::SetMatrix) {
-          const auto setMatrix = static_cast<const SetMatrix*>(record.get());
+          const auto setMatrix = static_cast<const SetMatrix*>(record);
           currentMatrix = setMatrix->matrix;
         }
-        drawInnerShadowAfterLayer(record.get(), innerShadowFilter, matrix, clip, currentMatrix);
-      }
+        drawInnerShadowAfterLayer(record, innerShadowFilter, matrix, clip, currentMatrix);
+        return true;
+      });
       return;
     }
     if (Types::Get(imageFilter.get()) == Types::ImageFilterType::Blur) {
@@ -16,10 +16,14 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <limits>
+#include "core/AtlasManager.h"
 #include "core/Matrix3DUtils.h"
+#include "core/PictureBBH.h"
+#include "core/PictureOptimizer.h"
 #include "core/PictureRecords.h"
 #include "core/images/SubsetImage.h"
 #include "core/shaders/PerlinNoiseShader.h"
@@ -478,6 +482,452 @@ TGFX_TEST(CanvasTest, Picture) {
   EXPECT_TRUE(Baseline::Compare(surface, "CanvasTest/PictureImage_Path"));
 }
 
+static std::vector<uint8_t> ReadPicturePixels(Context* context, std::shared_ptr<Picture> picture,
+                                              int width, int height) {
+  auto surface = Surface::Make(context, width, height);
+  if (surface == nullptr) {
+    return {};
+  }
+  auto canvas = surface->getCanvas();
+  canvas->clear(Color::White());
+  canvas->drawPicture(std::move(picture));
+  auto info = ImageInfo::Make(width, height, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  std::vector<uint8_t> pixels(info.byteSize());
+  if (!surface->readPixels(info, pixels.data())) {
+    return {};
+  }
+  return pixels;
+}
+
+TGFX_TEST(CanvasTest, PictureSerialization) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto image = MakeImage("resources/apitest/rotation.jpg");
+  ASSERT_TRUE(image != nullptr);
+  auto typeface = MakeTypeface("resources/font/NotoSansSC-Regular.otf");
+  ASSERT_TRUE(typeface != nullptr);
+
+  PictureRecorder recorder = {};
+  auto canvas = recorder.beginRecording();
+  Paint circlePaint = {};
+  circlePaint.setColor(Color::Red());
+  canvas->drawCircle(40, 40, 30, circlePaint);
+  auto innerPicture = recorder.finishRecordingAsPicture();
+  ASSERT_TRUE(innerPicture != nullptr);
+
+  canvas = recorder.beginRecording();
+  Paint paint = {};
+  paint.setColor(Color::Blue());
+  canvas->drawRect(Rect::MakeXYWH(10, 10, 100, 60), paint);
+  Path path = {};
+  path.addOval(Rect::MakeXYWH(120, 10, 80, 60));
+  paint.setShader(Shader::MakeLinearGradient({120, 10}, {200, 70}, {Color::Green(), Color::Red()}));
+  canvas->drawPath(path, paint);
+  paint.setShader(nullptr);
+  canvas->save();
+  canvas->clipRect(Rect::MakeXYWH(10, 80, 120, 120));
+  canvas->rotate(15, 70, 140);
+  canvas->drawImageRect(image, Rect::MakeXYWH(10, 80, 120, 120),
+                        SamplingOptions(FilterMode::Linear));
+  canvas->restore();
+  Font font(typeface, 24.f);
+  paint.setColor(Color::Black());
+  canvas->drawTextBlob(TextBlob::MakeFrom("Hello TGFX~", font), 140, 120, paint);
+  Paint layerPaint = {};
+  layerPaint.setImageFilter(ImageFilter::Blur(4, 4));
+  canvas->saveLayer(&layerPaint);
+  canvas->translate(140, 140);
+  canvas->drawPicture(innerPicture);
+  canvas->restore();
+  canvas->translate(200, 0);
+  canvas->drawPicture(innerPicture);
+  auto picture = recorder.finishRecordingAsPicture();
+  ASSERT_TRUE(picture != nullptr);
+
+  auto data = picture->serialize();
+  ASSERT_TRUE(data != nullptr);
+  auto loadedPicture = Picture::MakeFrom(data);
+  ASSERT_TRUE(loadedPicture != nullptr);
+  EXPECT_EQ(loadedPicture->getBounds(), picture->getBounds());
+  EXPECT_EQ(loadedPicture->drawCount, picture->drawCount);
+  auto loadedData = loadedPicture->serialize();
+  ASSERT_TRUE(loadedData != nullptr);
+  EXPECT_EQ(loadedData->size(), data->size());
+
+  auto expected = ReadPicturePixels(context, picture, 300, 220);
+  auto actual = ReadPicturePixels(context, loadedPicture, 300, 220);
+  ASSERT_FALSE(expected.empty());
+  ASSERT_EQ(expected.size(), actual.size());
+  size_t mismatchCount = 0;
+  for (size_t i = 0; i < expected.size(); i++) {
+    if (std::abs(static_cast<int>(expected[i]) - static_cast<int>(actual[i])) > 2) {
+      mismatchCount++;
+    }
+  }
+  EXPECT_EQ(mismatchCount, 0u);
+
+  auto singlePicture = Picture::MakeFrom(innerPicture->serialize());
+  ASSERT_TRUE(singlePicture != nullptr);
+  EXPECT_EQ(singlePicture->drawCount, 1u);
+
+  EXPECT_TRUE(Picture::MakeFrom(nullptr) == nullptr);
+  auto truncatedData = Data::MakeWithCopy(data->bytes(), data->size() / 2);
+  EXPECT_TRUE(Picture::MakeFrom(truncatedData) == nullptr);
+  std::vector<uint8_t> corruptBytes(data->bytes(), data->bytes() + data->size());
+  corruptBytes[0] ^= 0xFF;
+  auto corruptData = Data::MakeWithCopy(corruptBytes.data(), corruptBytes.size());
+  EXPECT_TRUE(Picture::MakeFrom(corruptData) == nullptr);
+
+  // Overwriting any position with a maximal varint must not make the loader allocate the count it
+  // claims: gradient colors, gradient positions and composed filters are all read as counts.
+  canvas = recorder.beginRecording();
+  Paint gradientPaint = {};
+  gradientPaint.setShader(Shader::MakeRadialGradient({50, 50}, 40, {Color::Red(), Color::Blue()},
+                                                     {0.f, 1.f}));
+  gradientPaint.setImageFilter(
+      ImageFilter::Compose(ImageFilter::Blur(2, 2), ImageFilter::DropShadow(2, 2, 2, 2, {})));
+  canvas->drawRect(Rect::MakeWH(100, 100), gradientPaint);
+  auto gradientData = recorder.finishRecordingAsPicture()->serialize();
+  ASSERT_TRUE(gradientData != nullptr);
+  const uint8_t hugeVarint[] = {0xFF, 0xFF, 0xFF, 0xFF, 0x0F};
+  for (size_t i = 0; i + sizeof(hugeVarint) <= gradientData->size(); i++) {
+    std::vector<uint8_t> bytes(gradientData->bytes(), gradientData->bytes() + gradientData->size());
+    memcpy(bytes.data() + i, hugeVarint, sizeof(hugeVarint));
+    EXPECT_NO_THROW(Picture::MakeFrom(Data::MakeWithCopy(bytes.data(), bytes.size())));
+  }
+
+  canvas = recorder.beginRecording();
+  Point positions[] = {{0, 0}, {50, 0}, {0, 50}};
+  auto mesh = Mesh::MakeCopy(MeshTopology::Triangles, 3, positions);
+  ASSERT_TRUE(mesh != nullptr);
+  canvas->drawMesh(mesh, paint);
+  auto meshPicture = recorder.finishRecordingAsPicture();
+  ASSERT_TRUE(meshPicture != nullptr);
+  EXPECT_TRUE(meshPicture->serialize() == nullptr);
+}
+
+TGFX_TEST(CanvasTest, LargePictureSerialization) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  constexpr int DrawCount = 5000;
+  PictureRecorder recorder = {};
+  auto canvas = recorder.beginRecording();
+  Paint paint = {};
+  for (int i = 0; i < DrawCount; i++) {
+    auto x = static_cast<float>(i % 100) * 4.f;
+    auto y = static_cast<float>(i / 100) * 4.f;
+    paint.setColor(Color::FromRGBA(static_cast<uint8_t>(i % 256), 128, 64, 255));
+    if (i % 2 == 0) {
+      canvas->drawRect(Rect::MakeXYWH(x, y, 3.f, 3.f), paint);
+    } else {
+      canvas->drawCircle(x + 1.5f, y + 1.5f, 1.5f, paint);
+    }
+  }
+  auto picture = recorder.finishRecordingAsPicture();
+  ASSERT_TRUE(picture != nullptr);
+  auto data = picture->serialize();
+  ASSERT_TRUE(data != nullptr);
+  EXPECT_EQ(picture->drawCount, static_cast<size_t>(DrawCount));
+  auto loadedPicture = Picture::MakeFrom(data);
+  ASSERT_TRUE(loadedPicture != nullptr);
+  EXPECT_EQ(loadedPicture->drawCount, picture->drawCount);
+  auto pixels = ReadPicturePixels(context, picture, 400, 200);
+  ASSERT_FALSE(pixels.empty());
+  EXPECT_TRUE(pixels == ReadPicturePixels(context, loadedPicture, 400, 200));
+}
+
+TGFX_TEST(CanvasTest, PictureBBH) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto record = [](PictureRecorder* recorder) {
+    auto canvas = recorder->beginRecording();
+    Paint paint = {};
+    for (int i = 0; i < 1000; i++) {
+      auto x = static_cast<float>(i % 40) * 10.f;
+      auto y = static_cast<float>(i / 40) * 10.f;
+      paint.setColor(Color::FromRGBA(static_cast<uint8_t>(i % 256), 64, 200, 255));
+      canvas->save();
+      canvas->translate(x, y);
+      if (i % 3 == 0) {
+        canvas->clipRect(Rect::MakeWH(6.f, 6.f));
+      }
+      canvas->drawRect(Rect::MakeWH(8.f, 8.f), paint);
+      canvas->restore();
+    }
+    return recorder->finishRecordingAsPicture();
+  };
+  PictureRecorder recorder = {};
+  auto picture = record(&recorder);
+  ASSERT_TRUE(picture != nullptr);
+  ASSERT_TRUE(picture->bbh != nullptr);
+  EXPECT_EQ(picture->getBounds(), Rect::MakeWH(398.f, 248.f));
+  auto fullPicture = record(&recorder);
+  ASSERT_TRUE(fullPicture != nullptr);
+  fullPicture->bbh = nullptr;
+
+  std::vector<size_t> visibleDraws = {};
+  auto cullBounds = Rect::MakeXYWH(100, 100, 20, 20);
+  EXPECT_TRUE(picture->getVisibleDraws(Matrix::I(), ClipStack(), &cullBounds, &visibleDraws));
+  EXPECT_EQ(visibleDraws.size(), 9u);
+  EXPECT_TRUE(std::is_sorted(visibleDraws.begin(), visibleDraws.end()));
+  cullBounds = Rect::MakeWH(1000, 1000);
+  EXPECT_FALSE(picture->getVisibleDraws(Matrix::I(), ClipStack(), &cullBounds, &visibleDraws));
+
+  auto drawTile = [&](std::shared_ptr<Picture> tilePicture, float offsetX, float offsetY) {
+    auto surface = Surface::Make(context, 64, 64);
+    auto canvas = surface->getCanvas();
+    canvas->clear(Color::White());
+    canvas->translate(-offsetX, -offsetY);
+    canvas->drawPicture(std::move(tilePicture));
+    auto info = ImageInfo::Make(64, 64, ColorType::RGBA_8888, AlphaType::Premultiplied);
+    std::vector<uint8_t> pixels(info.byteSize());
+    EXPECT_TRUE(surface->readPixels(info, pixels.data()));
+    return pixels;
+  };
+  for (auto offset : {0.f, 97.5f, 200.f}) {
+    auto expected = drawTile(fullPicture, offset, offset / 2);
+    auto actual = drawTile(picture, offset, offset / 2);
+    EXPECT_TRUE(expected == actual);
+  }
+}
+
+TGFX_TEST(CanvasTest, PictureOptimizer) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  PictureRecorder recorder = {};
+  auto canvas = recorder.beginRecording();
+  Paint paint = {};
+  for (int i = 0; i < 400; i++) {
+    auto x = static_cast<float>(i % 20) * 10.f + 0.5f;
+    auto y = static_cast<float>(i / 20) * 10.f + 0.5f;
+    paint.setColor(Color::FromRGBA(static_cast<uint8_t>(i % 256), 100, 50, 128));
+    if (i % 2 == 0) {
+      canvas->drawRect(Rect::MakeXYWH(x, y, 8.f, 8.f), paint);
+    } else {
+      canvas->drawOval(Rect::MakeXYWH(x, y, 8.f, 8.f), paint);
+    }
+  }
+  paint.setColor(Color::Blue());
+  canvas->drawRect(Rect::MakeXYWH(0, 0, 120, 200), paint);
+  paint.setColor(Color::Green());
+  for (int i = 0; i < 10; i++) {
+    canvas->drawRect(Rect::MakeXYWH(static_cast<float>(i) * 10.f, 210.f, 10.f, 10.f), paint);
+  }
+  paint.setColor(Color::FromRGBA(255, 0, 0, 128));
+  for (int i = 0; i < 5; i++) {
+    canvas->drawRect(Rect::MakeXYWH(120.f, 210.f + static_cast<float>(i) * 5.f, 20.f, 5.f), paint);
+  }
+  auto picture = recorder.finishRecordingAsPicture();
+  ASSERT_TRUE(picture != nullptr);
+
+  PictureOptimizerStats stats = {};
+  auto optimizedPicture = PictureOptimizer::Optimize(picture, &stats);
+  ASSERT_TRUE(optimizedPicture != nullptr);
+  EXPECT_NE(optimizedPicture, picture);
+  EXPECT_EQ(stats.removedDraws, 209u);
+  EXPECT_EQ(stats.mergedDraws, 13u);
+  EXPECT_EQ(optimizedPicture->drawCount, picture->drawCount - 222u);
+  EXPECT_EQ(stats.removedRecords, picture->records.size() - optimizedPicture->records.size());
+  EXPECT_GT(stats.removedRecords, stats.removedDraws + stats.mergedDraws);
+  EXPECT_EQ(optimizedPicture->getBounds(), picture->getBounds());
+  auto expected = ReadPicturePixels(context, picture, 200, 240);
+  auto actual = ReadPicturePixels(context, optimizedPicture, 200, 240);
+  ASSERT_FALSE(expected.empty());
+  EXPECT_TRUE(expected == actual);
+  EXPECT_EQ(PictureOptimizer::Optimize(optimizedPicture), optimizedPicture);
+}
+
+TGFX_TEST(CanvasTest, DistanceFieldText) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto typeface =
+      Typeface::MakeFromPath(ProjectPath::Absolute("resources/font/NotoSerifSC-Regular.otf"));
+  ASSERT_TRUE(typeface != nullptr);
+  Font font(typeface, 20.f);
+  auto textBlob = TextBlob::MakeFrom("Zoom TGFX", font);
+  ASSERT_TRUE(textBlob != nullptr);
+  auto atlasManager = context->atlasManager();
+  // Sweeps the text through device sizes from 24px to 120px, as a pinch-zoom gesture would.
+  auto zoomSweep = [&](uint32_t renderFlags, size_t* cellCount, size_t* cellBytes) {
+    auto surface = Surface::Make(context, 800, 200, false, 1, false, renderFlags);
+    ASSERT_TRUE(surface != nullptr);
+    auto canvas = surface->getCanvas();
+    auto startCount = atlasManager->addedCellCount();
+    auto startBytes = atlasManager->addedCellBytes();
+    Paint paint = {};
+    paint.setColor(Color::Black());
+    for (int step = 0; step <= 48; step++) {
+      auto scale = 1.2f + 0.1f * static_cast<float>(step);
+      canvas->clear(Color::White());
+      canvas->setMatrix(Matrix::MakeScale(scale));
+      canvas->drawTextBlob(textBlob, 2.f, 20.f, paint);
+      context->flushAndSubmit();
+    }
+    *cellCount = atlasManager->addedCellCount() - startCount;
+    *cellBytes = atlasManager->addedCellBytes() - startBytes;
+  };
+  size_t bitmapCells = 0;
+  size_t bitmapBytes = 0;
+  zoomSweep(0, &bitmapCells, &bitmapBytes);
+  size_t fieldCells = 0;
+  size_t fieldBytes = 0;
+  zoomSweep(RenderFlags::DistanceFieldText, &fieldCells, &fieldBytes);
+  EXPECT_GT(fieldCells, 0u);
+  EXPECT_LT(fieldCells, bitmapCells);
+  EXPECT_LT(fieldBytes, bitmapBytes);
+
+  // At a zoomed size the distance field glyphs match the bitmap glyphs except for slightly
+  // different antialiasing along the edges.
+  auto info = ImageInfo::Make(800, 200, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  auto readZoomedText = [&](uint32_t renderFlags) {
+    std::vector<uint8_t> pixels(info.byteSize());
+    auto surface = Surface::Make(context, 800, 200, false, 1, false, renderFlags);
+    if (surface == nullptr) {
+      return std::vector<uint8_t>{};
+    }
+    auto canvas = surface->getCanvas();
+    canvas->clear(Color::White());
+    canvas->setMatrix(Matrix::MakeScale(3.f));
+    Paint paint = {};
+    paint.setColor(Color::Black());
+    canvas->drawTextBlob(textBlob, 2.f, 20.f, paint);
+    if (!surface->readPixels(info, pixels.data())) {
+      return std::vector<uint8_t>{};
+    }
+    return pixels;
+  };
+  auto bitmapPixels = readZoomedText(0);
+  auto fieldPixels = readZoomedText(RenderFlags::DistanceFieldText);
+  ASSERT_FALSE(bitmapPixels.empty());
+  ASSERT_EQ(bitmapPixels.size(), fieldPixels.size());
+  size_t inkCount = 0;
+  size_t mismatchCount = 0;
+  for (size_t i = 0; i < bitmapPixels.size(); i += 4) {
+    inkCount += bitmapPixels[i] < 128 ? 1 : 0;
+    if (std::abs(static_cast<int>(bitmapPixels[i]) - static_cast<int>(fieldPixels[i])) > 64) {
+      mismatchCount++;
+    }
+  }
+  EXPECT_GT(inkCount, 0u);
+  EXPECT_LT(mismatchCount, inkCount / 20);
+
+  // Small text keeps using bitmap strikes even when the distance field mode is enabled: a 12px
+  // strike is rasterized once and then reused, and the 20px font, which is below the minimum
+  // distance field size, adds bitmap cells of its own since the sweeps only drew 24px and up.
+  auto surface = Surface::Make(context, 200, 50, false, 1, false, RenderFlags::DistanceFieldText);
+  ASSERT_TRUE(surface != nullptr);
+  auto startCount = atlasManager->addedCellCount();
+  Paint paint = {};
+  Font smallFont(typeface, 12.f);
+  auto smallBlob = TextBlob::MakeFrom("Zoom TGFX", smallFont);
+  surface->getCanvas()->drawTextBlob(smallBlob, 2.f, 20.f, paint);
+  context->flushAndSubmit();
+  EXPECT_GT(atlasManager->addedCellCount(), startCount);
+  auto smallCells = atlasManager->addedCellCount() - startCount;
+  surface->getCanvas()->clear();
+  surface->getCanvas()->drawTextBlob(smallBlob, 2.f, 20.f, paint);
+  context->flushAndSubmit();
+  EXPECT_EQ(atlasManager->addedCellCount() - startCount, smallCells);
+  surface->getCanvas()->clear();
+  surface->getCanvas()->drawTextBlob(textBlob, 2.f, 20.f, paint);
+  context->flushAndSubmit();
+  EXPECT_GT(atlasManager->addedCellCount() - startCount, smallCells);
+}
+
+static Path MakeStarPath(int points, float radius) {
+  Path path = {};
+  auto count = points * 2;
+  for (int i = 0; i < count; i++) {
+    auto angle = M_PI_F * static_cast<float>(i) / static_cast<float>(points);
+    auto distance = i % 2 == 0 ? radius : radius * 0.45f;
+    auto x = radius + distance * std::sin(angle);
+    auto y = radius - distance * std::cos(angle);
+    if (i == 0) {
+      path.moveTo(x, y);
+    } else {
+      path.lineTo(x, y);
+    }
+  }
+  path.close();
+  return path;
+}
+
+TGFX_TEST(CanvasTest, ShapeMaskAtlas) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  std::vector<Path> icons = {};
+  for (int points = 5; points < 15; points++) {
+    icons.push_back(MakeStarPath(points, 12.f));
+  }
+  auto atlasManager = context->atlasManager();
+  // Draws a grid of small icons where neighbouring icons never share the same shape, so they can
+  // not be instanced into one op without the atlas.
+  auto info = ImageInfo::Make(400, 400, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  auto drawIcons = [&](uint32_t renderFlags, std::vector<uint8_t>* pixels) {
+    auto surface = Surface::Make(context, 400, 400, false, 1, false, renderFlags);
+    EXPECT_TRUE(surface != nullptr);
+    if (surface == nullptr) {
+      return FrameStats{};
+    }
+    auto canvas = surface->getCanvas();
+    canvas->clear(Color::White());
+    Paint paint = {};
+    for (int i = 0; i < 100; i++) {
+      paint.setColor(i % 2 == 0 ? Color::Red() : Color::Blue());
+      canvas->save();
+      canvas->translate(static_cast<float>(i % 10) * 40.f + 5.25f,
+                        static_cast<float>(i / 10) * 40.f + 5.5f);
+      canvas->drawPath(icons[static_cast<size_t>(i) % icons.size()], paint);
+      canvas->restore();
+    }
+    context->flushAndSubmit(true);
+    auto stats = context->frameStats();
+    if (pixels != nullptr) {
+      pixels->resize(info.byteSize());
+      EXPECT_TRUE(surface->readPixels(info, pixels->data()));
+    }
+    return stats;
+  };
+  context->flushAndSubmit(true);
+  std::vector<uint8_t> separatePixels = {};
+  auto separateStats = drawIcons(RenderFlags::DisableCache, &separatePixels);
+  auto startCount = atlasManager->addedCellCount();
+  std::vector<uint8_t> atlasPixels = {};
+  auto atlasStats = drawIcons(0, &atlasPixels);
+  auto addedCells = atlasManager->addedCellCount() - startCount;
+  EXPECT_EQ(separateStats.atlasShapeDrawCount, 0u);
+  EXPECT_EQ(atlasStats.atlasShapeDrawCount, 100u);
+  // Without the atlas every icon is a ShapeDrawOp of its own. With it, the icons batch into the
+  // atlas ops of the page they share.
+  EXPECT_GE(separateStats.drawOpCount, 100u);
+  EXPECT_LE(atlasStats.drawOpCount, 10u);
+  EXPECT_GT(atlasStats.maskAtlasOccupancy, 0u);
+  EXPECT_LE(atlasStats.maskAtlasOccupancy, 100u);
+  // Every icon sits at the same subpixel offset, so each shape needs exactly one atlas cell.
+  EXPECT_EQ(addedCells, icons.size());
+  // The atlas keeps the exact subpixel offset, so the icons match their own mask textures.
+  ASSERT_EQ(atlasPixels.size(), separatePixels.size());
+  size_t mismatchCount = 0;
+  for (size_t i = 0; i < atlasPixels.size(); i++) {
+    if (std::abs(static_cast<int>(atlasPixels[i]) - static_cast<int>(separatePixels[i])) > 2) {
+      mismatchCount++;
+    }
+  }
+  EXPECT_EQ(mismatchCount, 0u);
+
+  // The cells are reused by the next frame without rasterizing the shapes again.
+  startCount = atlasManager->addedCellCount();
+  atlasStats = drawIcons(0, nullptr);
+  EXPECT_EQ(atlasStats.atlasShapeDrawCount, 100u);
+  EXPECT_EQ(atlasManager->addedCellCount(), startCount);
+}
+
 TGFX_TEST(CanvasTest, PictureImageShaderOptimization) {
   ContextScope scope;
   auto context = scope.getContext();
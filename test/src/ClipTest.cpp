@@ -33,6 +33,9 @@
 #include "tgfx/core/Rect.h"
 #include "tgfx/core/Shape.h"
 #include "tgfx/core/Surface.h"
+#include "tgfx/layers/DisplayList.h"
+#include "tgfx/layers/ShapeLayer.h"
+#include "tgfx/layers/SolidLayer.h"
 #include "utils/TestUtils.h"
 
 namespace tgfx {
@@ -1070,4 +1073,90 @@ TGFX_TEST(ClipTest, Overview) {
   EXPECT_TRUE(Baseline::Compare(surface, "ClipTest/ClipOverview"));
 }
 
+// Two neighboring tiles share a path clip that straddles their common edge. The clip mask is keyed
+// by the clip content relative to its own bounds, so the second tile and every later frame reuse
+// the mask rasterized for the first tile.
+TGFX_TEST(ClipTest, SharedClipMask) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_NE(context, nullptr);
+  auto clipPath = MakePath({{100, 10}, {138, 38}, {124, 82}, {76, 82}, {62, 38}});
+  std::vector<std::shared_ptr<Surface>> tiles = {};
+  for (int i = 0; i < 2; ++i) {
+    auto tile = Surface::Make(context, 100, 100);
+    ASSERT_NE(tile, nullptr);
+    tiles.push_back(std::move(tile));
+  }
+  Paint paint = {};
+  paint.setColor(Color::Red());
+  auto drawTiles = [&]() {
+    for (size_t i = 0; i < tiles.size(); ++i) {
+      auto canvas = tiles[i]->getCanvas();
+      canvas->clear();
+      canvas->save();
+      canvas->translate(-100.f * static_cast<float>(i), 0.f);
+      canvas->clipPath(clipPath, true);
+      canvas->drawRect(Rect::MakeWH(200, 100), paint);
+      canvas->restore();
+    }
+    context->flushAndSubmit(true);
+    return context->frameStats();
+  };
+  auto firstFrame = drawTiles();
+  EXPECT_EQ(firstFrame.clipMaskCount, 1u);
+  EXPECT_EQ(firstFrame.clipMaskCacheHits, 1u);
+  auto secondFrame = drawTiles();
+  EXPECT_EQ(secondFrame.clipMaskCount, 0u);
+  EXPECT_EQ(secondFrame.clipMaskCacheHits, 2u);
+
+  Bitmap bitmap = {};
+  bitmap.allocPixels(100, 100);
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    auto pixels = bitmap.lockPixels();
+    ASSERT_TRUE(tiles[i]->readPixels(bitmap.info(), pixels));
+    bitmap.unlockPixels();
+    // The center of the pentagon sits on the shared edge, 10 pixels away on either side.
+    EXPECT_EQ(bitmap.getColor(i == 0 ? 90 : 10, 50), Color::Red());
+    EXPECT_EQ(bitmap.getColor(i == 0 ? 90 : 10, 5), Color::Transparent());
+  }
+}
+
+TGFX_TEST(ClipTest, SharedClipMaskTiled) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_NE(context, nullptr);
+  auto surface = Surface::Make(context, 128, 64);
+  ASSERT_NE(surface, nullptr);
+  DisplayList displayList;
+  displayList.setRenderMode(RenderMode::Tiled);
+  displayList.setTileSize(64);
+  auto solidLayer = SolidLayer::Make();
+  solidLayer->setWidth(128);
+  solidLayer->setHeight(64);
+  solidLayer->setColor(Color::Red());
+  displayList.root()->addChild(solidLayer);
+  // The pentagon straddles the edge between the two tiles.
+  auto maskLayer = ShapeLayer::Make();
+  maskLayer->setPath(MakePath({{64, 4}, {92, 24}, {82, 60}, {46, 60}, {36, 24}}));
+  maskLayer->setFillStyle(ShapeStyle::Make(Color::White()));
+  displayList.root()->addChild(maskLayer);
+  solidLayer->setMask(maskLayer);
+  displayList.render(surface.get());
+  context->flushAndSubmit(true);
+  auto stats = context->frameStats();
+  // Both tiles clip against the same path, so the second tile reuses the mask of the first.
+  EXPECT_EQ(stats.clipMaskCount, 1u);
+  EXPECT_EQ(stats.clipMaskCacheHits, 1u);
+
+  Bitmap bitmap = {};
+  bitmap.allocPixels(128, 64);
+  auto pixels = bitmap.lockPixels();
+  ASSERT_TRUE(surface->readPixels(bitmap.info(), pixels));
+  bitmap.unlockPixels();
+  EXPECT_EQ(bitmap.getColor(54, 32), Color::Red());
+  EXPECT_EQ(bitmap.getColor(74, 32), Color::Red());
+  EXPECT_EQ(bitmap.getColor(40, 5), Color::Transparent());
+  EXPECT_EQ(bitmap.getColor(88, 5), Color::Transparent());
+}
+
 }  // namespace tgfx
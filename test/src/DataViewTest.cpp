@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <sstream>
 #include "base/TGFXTest.h"
 #include "gtest/gtest.h"
@@ -26,6 +27,9 @@
 #include "tgfx/core/UTF.h"
 #include "tgfx/core/WriteStream.h"
 #include "utils/TestUtils.h"
+#ifdef __linux__
+#include <unistd.h>
+#endif
 
 namespace tgfx {
 TGFX_TEST(DataViewTest, PNGDataCheck) {
@@ -141,4 +145,97 @@ TGFX_TEST(DataViewTest, FileWriteStream) {
   std::filesystem::remove(path);
 }
 
+static size_t GetResidentBytes() {
+#ifdef __linux__
+  std::ifstream statm("/proc/self/statm");
+  size_t totalPages = 0;
+  size_t residentPages = 0;
+  statm >> totalPages >> residentPages;
+  return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+  return 0;
+#endif
+}
+
+TGFX_TEST(DataViewTest, FileMapping) {
+  auto path = ProjectPath::Absolute("test/out/FileMapping.bin");
+  std::filesystem::path filePath = path;
+  std::filesystem::create_directories(filePath.parent_path());
+  std::string contents(1024 * 1024, '\0');
+  for (size_t i = 0; i < contents.size(); i++) {
+    contents[i] = static_cast<char>(i * 7);
+  }
+  {
+    auto writeStream = WriteStream::MakeFromFile(path);
+    ASSERT_TRUE(writeStream != nullptr);
+    writeStream->write(contents.data(), contents.size());
+    writeStream->flush();
+  }
+
+  auto data = Data::MakeFromFile(path);
+  ASSERT_TRUE(data != nullptr);
+  ASSERT_EQ(data->size(), contents.size());
+  EXPECT_EQ(memcmp(data->data(), contents.data(), contents.size()), 0);
+  auto stream = Stream::MakeFromFile(path);
+  ASSERT_TRUE(stream != nullptr);
+  EXPECT_EQ(stream->size(), contents.size());
+  EXPECT_TRUE(stream->seek(1000));
+  char bytes[4] = {};
+  EXPECT_EQ(stream->read(bytes, sizeof(bytes)), sizeof(bytes));
+  EXPECT_EQ(memcmp(bytes, contents.data() + 1000, sizeof(bytes)), 0);
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+  auto mappedData = Data::MakeFromFileMapping(path);
+  ASSERT_TRUE(mappedData != nullptr);
+  EXPECT_EQ(memcmp(mappedData->data(), contents.data(), contents.size()), 0);
+  auto mappedStream = Stream::MakeFromData(mappedData);
+  ASSERT_TRUE(mappedStream != nullptr && mappedStream->getMemoryBase() != nullptr);
+  EXPECT_EQ(memcmp(mappedStream->getMemoryBase(), contents.data(), contents.size()), 0);
+  mappedStream = nullptr;
+  mappedData = nullptr;
+#endif
+  EXPECT_TRUE(Data::MakeFromFileMapping("") == nullptr);
+  EXPECT_TRUE(Data::MakeFromFileMapping(path + ".missing") == nullptr);
+  EXPECT_TRUE(Data::MakeFromFileMapping("assets://FileMapping.bin") == nullptr);
+  EXPECT_TRUE(Data::MakeFromFileMapping(filePath.parent_path().string()) == nullptr);
+  data = nullptr;
+  stream = nullptr;
+  std::filesystem::remove(path);
+
+  // Load every file of the resource directory, the way an app opens its asset folder at startup.
+  std::vector<std::string> filePaths = {};
+  for (auto& entry :
+       std::filesystem::recursive_directory_iterator(ProjectPath::Absolute("resources"))) {
+    if (entry.is_regular_file() && entry.file_size() > 0) {
+      filePaths.push_back(entry.path().string());
+    }
+  }
+  ASSERT_FALSE(filePaths.empty());
+  std::vector<std::shared_ptr<Data>> mappedFiles = {};
+  auto baseResident = GetResidentBytes();
+  for (auto& filePath : filePaths) {
+    if (auto fileData = Data::MakeFromFileMapping(filePath)) {
+      mappedFiles.push_back(std::move(fileData));
+    }
+  }
+  // The resident size can shrink while loading, so the difference is kept signed.
+  auto mappedResident =
+      static_cast<int64_t>(GetResidentBytes()) - static_cast<int64_t>(baseResident);
+
+  std::vector<std::shared_ptr<Data>> heapFiles = {};
+  baseResident = GetResidentBytes();
+  for (auto& filePath : filePaths) {
+    auto fileData = Data::MakeFromFile(filePath);
+    EXPECT_TRUE(fileData != nullptr);
+    heapFiles.push_back(std::move(fileData));
+  }
+  auto heapResident =
+      static_cast<int64_t>(GetResidentBytes()) - static_cast<int64_t>(baseResident);
+  // Mapped files only become resident once their pages are read, while heap copies are resident
+  // as soon as they are loaded. The resident size is unknown on platforms without /proc, and
+  // files can not be mapped on every platform.
+  if (baseResident > 0 && mappedFiles.size() == filePaths.size()) {
+    EXPECT_LT(mappedResident, heapResident);
+  }
+}
+
 }  // namespace tgfx
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <array>
+#include <cstring>
 #include <memory>
 #include <vector>
 #include "CornerPinEffect.h"
@@ -329,6 +330,57 @@ TGFX_TEST(FilterTest, ComposeImageFilter) {
   EXPECT_TRUE(Baseline::Compare(surface, "FilterTest/ComposeImageFilter2"));
 }
 
+TGFX_TEST(FilterTest, TransientRenderTargetAliasing) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto image = MakeImage("resources/assets/bridge.jpg");
+  ASSERT_TRUE(image != nullptr);
+  auto surface = Surface::Make(context, 400, 400);
+  ASSERT_TRUE(surface != nullptr);
+  // Every blur pass renders into intermediate render targets of the same size, which are no
+  // longer needed once the next pass has sampled them.
+  std::vector<std::shared_ptr<ImageFilter>> filters = {};
+  for (int i = 0; i < 6; i++) {
+    filters.push_back(ImageFilter::Blur(4, 4));
+  }
+  Paint paint = {};
+  paint.setImageFilter(ImageFilter::Compose(filters));
+  auto info = ImageInfo::Make(400, 400, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  auto drawBlurStack = [&](bool aliasing, std::vector<uint8_t>* pixels, size_t* memoryUsage) {
+    context->setRenderTargetAliasing(aliasing);
+    // Start from an empty cache so that both runs allocate every texture they need.
+    context->purgeResourcesUntilMemoryTo(0);
+    auto canvas = surface->getCanvas();
+    canvas->clear();
+    canvas->resetMatrix();
+    canvas->scale(300.f / static_cast<float>(image->width()),
+                  300.f / static_cast<float>(image->height()));
+    canvas->drawImage(image, &paint);
+    context->flushAndSubmit(true);
+    *memoryUsage = context->memoryUsage();
+    pixels->resize(info.byteSize());
+    EXPECT_TRUE(surface->readPixels(info, pixels->data()));
+    return context->frameStats();
+  };
+  std::vector<uint8_t> separatePixels = {};
+  size_t separateMemory = 0;
+  auto separateStats = drawBlurStack(false, &separatePixels, &separateMemory);
+  std::vector<uint8_t> aliasedPixels = {};
+  size_t aliasedMemory = 0;
+  auto aliasedStats = drawBlurStack(true, &aliasedPixels, &aliasedMemory);
+  context->setRenderTargetAliasing(true);
+  EXPECT_EQ(separateStats.aliasedRenderTargetCount, 0u);
+  EXPECT_EQ(aliasedStats.transientRenderTargetCount, separateStats.transientRenderTargetCount);
+  EXPECT_GT(aliasedStats.aliasedRenderTargetCount, 0u);
+  EXPECT_LT(aliasedStats.aliasedRenderTargetCount, aliasedStats.transientRenderTargetCount);
+  // Render targets that reuse a texture allocate nothing, which lowers the memory of the frame.
+  EXPECT_LT(aliasedMemory, separateMemory);
+  // Discarding the previous contents of shared textures must not leak into the output.
+  ASSERT_EQ(aliasedPixels.size(), separatePixels.size());
+  EXPECT_EQ(memcmp(aliasedPixels.data(), separatePixels.data(), aliasedPixels.size()), 0);
+}
+
 TGFX_TEST(FilterTest, RuntimeEffect) {
   ContextScope scope;
   auto context = scope.getContext();
@@ -16,23 +16,30 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "core/PixelBuffer.h"
 #include "core/images/CodecImage.h"
 #include "core/images/RasterizedImage.h"
 #include "core/images/SubsetImage.h"
 #include "core/images/TransformImage.h"
+#include "core/utils/BlockCompression.h"
 #include "core/utils/PixelFormatUtil.h"
 #include "gpu/ProxyProvider.h"
 #include "gpu/resources/TextureView.h"
 #include "gtest/gtest.h"
+#include "tgfx/core/AnimatedCodec.h"
 #include "tgfx/core/Buffer.h"
 #include "tgfx/core/Canvas.h"
 #include "tgfx/core/Image.h"
 #include "tgfx/core/Matrix.h"
 #include "tgfx/core/Paint.h"
 #include "tgfx/core/PictureRecorder.h"
+#include "tgfx/core/ProgressiveCodec.h"
 #include "tgfx/core/Rect.h"
 #include "tgfx/core/Shader.h"
 #include "tgfx/core/Surface.h"
+#include "tgfx/core/Task.h"
+#include "tgfx/gpu/GPU.h"
+#include "tgfx/layers/ImageLayer.h"
 #include "utils/TestUtils.h"
 
 namespace tgfx {
@@ -621,4 +628,452 @@ TGFX_TEST(ImageRenderTest, drawScaleImage) {
   EXPECT_TRUE(Baseline::Compare(surface, "ImageRenderTest/drawScaleBufferImage"));
 }
 
+static std::vector<uint8_t> ReadRGBAPixels(const std::shared_ptr<ImageBuffer>& imageBuffer) {
+  auto pixelBuffer = std::static_pointer_cast<PixelBuffer>(imageBuffer);
+  auto info = ImageInfo::Make(pixelBuffer->width(), pixelBuffer->height(), ColorType::RGBA_8888,
+                              AlphaType::Premultiplied);
+  std::vector<uint8_t> pixels(info.byteSize());
+  auto srcPixels = pixelBuffer->lockPixels();
+  Pixmap(pixelBuffer->info(), srcPixels).readPixels(info, pixels.data());
+  pixelBuffer->unlockPixels();
+  return pixels;
+}
+
+TGFX_TEST(ImageRenderTest, ProgressiveDecode) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  std::vector<std::string> paths = {"resources/apitest/imageReplacement.png",
+                                    "resources/apitest/imageReplacement.jpg",
+                                    "resources/apitest/imageReplacement.webp"};
+  for (auto& path : paths) {
+    auto data = ReadFile(path);
+    ASSERT_TRUE(data != nullptr) << path;
+    auto fullCodec = ImageCodec::MakeFrom(data);
+    ASSERT_TRUE(fullCodec != nullptr) << path;
+    auto fullInfo = ImageInfo::Make(fullCodec->width(), fullCodec->height(), ColorType::RGBA_8888,
+                                    AlphaType::Premultiplied, 0, fullCodec->colorSpace());
+    std::vector<uint8_t> fullPixels(fullInfo.byteSize());
+    ASSERT_TRUE(fullCodec->readPixels(fullInfo, fullPixels.data())) << path;
+
+    // Feed the file in small chunks and check that every snapshot only grows toward the full image.
+    auto codec = ProgressiveCodec::Make();
+    EXPECT_TRUE(codec->makeImage() == nullptr);
+    static constexpr size_t ChunkSize = 512;
+    size_t previousMatches = 0;
+    std::shared_ptr<Image> halfImage = nullptr;
+    std::vector<uint8_t> halfPixels = {};
+    for (size_t offset = 0; offset < data->size(); offset += ChunkSize) {
+      auto length = std::min(ChunkSize, data->size() - offset);
+      EXPECT_TRUE(codec->appendData(data->bytes() + offset, length)) << path;
+      auto buffer = codec->makeBuffer(false);
+      if (buffer == nullptr) {
+        EXPECT_EQ(codec->width(), 0) << path;
+        continue;
+      }
+      EXPECT_EQ(codec->width(), fullCodec->width()) << path;
+      EXPECT_EQ(codec->height(), fullCodec->height()) << path;
+      if (halfImage == nullptr && offset >= data->size() / 2) {
+        halfImage = codec->makeImage();
+        ASSERT_TRUE(halfImage != nullptr) << path;
+        auto surface = Surface::Make(context, halfImage->width(), halfImage->height());
+        surface->getCanvas()->drawImage(halfImage);
+        auto surfaceInfo = ImageInfo::Make(surface->width(), surface->height(),
+                                           ColorType::RGBA_8888, AlphaType::Premultiplied);
+        halfPixels.resize(surfaceInfo.byteSize());
+        EXPECT_TRUE(surface->readPixels(surfaceInfo, halfPixels.data()));
+      }
+      auto pixels = ReadRGBAPixels(buffer);
+      size_t matches = 0;
+      for (size_t i = 0; i < pixels.size(); i++) {
+        matches += pixels[i] == fullPixels[i];
+      }
+      EXPECT_GE(matches + pixels.size() / 100, previousMatches) << path;
+      previousMatches = matches;
+    }
+    codec->finish();
+    EXPECT_FALSE(codec->appendData(data->bytes(), 1));
+    auto buffer = codec->makeBuffer(false);
+    ASSERT_TRUE(buffer != nullptr) << path;
+    EXPECT_TRUE(codec->isComplete()) << path;
+    EXPECT_EQ(codec->orientation(), fullCodec->orientation()) << path;
+    EXPECT_TRUE(ReadRGBAPixels(buffer) == fullPixels) << path;
+
+    // The image made from half of the data refreshes its texture once the rest has arrived.
+    ASSERT_TRUE(halfImage != nullptr) << path;
+    auto fullImage = Image::MakeFromEncoded(data);
+    ASSERT_TRUE(fullImage != nullptr) << path;
+    auto surface = Surface::Make(context, fullImage->width(), fullImage->height());
+    auto canvas = surface->getCanvas();
+    auto surfaceInfo = ImageInfo::Make(surface->width(), surface->height(), ColorType::RGBA_8888,
+                                       AlphaType::Premultiplied);
+    std::vector<uint8_t> expected(surfaceInfo.byteSize());
+    canvas->drawImage(fullImage);
+    EXPECT_TRUE(surface->readPixels(surfaceInfo, expected.data()));
+    std::vector<uint8_t> actual(surfaceInfo.byteSize());
+    canvas->clear();
+    canvas->drawImage(halfImage);
+    EXPECT_TRUE(surface->readPixels(surfaceInfo, actual.data()));
+    EXPECT_TRUE(actual == expected) << path;
+    EXPECT_FALSE(halfPixels == expected) << path;
+  }
+
+  // A truncated file still shows the rows that arrived once it is finished.
+  auto data = ReadFile("resources/apitest/imageReplacement.png");
+  ASSERT_TRUE(data != nullptr);
+  auto codec = ProgressiveCodec::Make();
+  EXPECT_TRUE(codec->appendData(data->bytes(), data->size() / 2));
+  codec->finish();
+  EXPECT_TRUE(codec->makeBuffer(false) != nullptr);
+  EXPECT_FALSE(codec->isComplete());
+  auto unknown = ProgressiveCodec::Make();
+  EXPECT_FALSE(unknown->appendData("not an image file", 17));
+}
+
+static std::vector<uint8_t> DrawImagePixels(Surface* surface, std::shared_ptr<Image> image) {
+  auto canvas = surface->getCanvas();
+  canvas->clear();
+  canvas->drawImage(std::move(image));
+  auto info = ImageInfo::Make(surface->width(), surface->height(), ColorType::RGBA_8888,
+                              AlphaType::Premultiplied);
+  std::vector<uint8_t> pixels(info.byteSize());
+  EXPECT_TRUE(surface->readPixels(info, pixels.data()));
+  return pixels;
+}
+
+TGFX_TEST(ImageRenderTest, YUVDecode) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  // Re-encode the photo with the default 4:2:0 chroma subsampling of the JPEG encoder.
+  auto source = MakeImageCodec("resources/apitest/imageReplacement.jpg");
+  ASSERT_TRUE(source != nullptr);
+  Bitmap bitmap(source->width(), source->height(), false, false);
+  ASSERT_FALSE(bitmap.isEmpty());
+  auto pixmap = Pixmap(bitmap);
+  ASSERT_TRUE(source->readPixels(pixmap.info(), pixmap.writablePixels()));
+  auto data = ImageCodec::Encode(pixmap, EncodedFormat::JPEG, 90);
+  ASSERT_TRUE(data != nullptr);
+  auto codec = ImageCodec::MakeFrom(data);
+  ASSERT_TRUE(codec != nullptr);
+  auto width = codec->width();
+  auto height = codec->height();
+
+  auto rgbaBuffer = codec->makeBuffer(false);
+  auto yuvBuffer = codec->makeYUVBuffer();
+  ASSERT_TRUE(rgbaBuffer != nullptr);
+  ASSERT_TRUE(yuvBuffer != nullptr);
+  EXPECT_EQ(yuvBuffer->width(), width);
+  EXPECT_EQ(yuvBuffer->height(), height);
+  EXPECT_FALSE(yuvBuffer->isAlphaOnly());
+  // Formats without YUV support fall back to RGBA pixels.
+  auto pngCodec = MakeImageCodec("resources/apitest/imageReplacement.png");
+  ASSERT_TRUE(pngCodec != nullptr);
+  EXPECT_TRUE(pngCodec->makeYUVBuffer() == nullptr);
+
+  auto surface = Surface::Make(context, width, height);
+  ASSERT_TRUE(surface != nullptr);
+  context->flushAndSubmit(true);
+  auto baseUsage = context->memoryUsage();
+  auto rgbaPixels = DrawImagePixels(surface.get(), Image::MakeFrom(codec));
+  auto rgbaUsage = context->memoryUsage() - baseUsage;
+  baseUsage = context->memoryUsage();
+  auto yuvImage = Image::MakeYUVFrom(codec);
+  ASSERT_TRUE(yuvImage != nullptr);
+  EXPECT_EQ(yuvImage->width(), width);
+  EXPECT_EQ(yuvImage->height(), height);
+  auto yuvPixels = DrawImagePixels(surface.get(), yuvImage);
+  auto yuvUsage = context->memoryUsage() - baseUsage;
+  EXPECT_LT(yuvUsage, rgbaUsage);
+
+  // The planes are upsampled by the GPU instead of libjpeg, so the colors only match closely.
+  ASSERT_EQ(yuvPixels.size(), rgbaPixels.size());
+  size_t totalDiff = 0;
+  for (size_t i = 0; i < yuvPixels.size(); i++) {
+    totalDiff += static_cast<size_t>(std::abs(yuvPixels[i] - rgbaPixels[i]));
+  }
+  EXPECT_LT(totalDiff, yuvPixels.size() * 3);
+}
+
+static std::shared_ptr<Data> MakeKtx2Data(uint32_t vkFormat, int width, int height,
+                                          const std::shared_ptr<Data>& blocks) {
+  constexpr uint8_t identifier[] = {0xAB, 'K',  'T',  'X',  ' ',  '2',
+                                    '0',  0xBB, '\r', '\n', 0x1A, '\n'};
+  constexpr size_t levelOffset = 104;
+  Buffer buffer(levelOffset + blocks->size());
+  buffer.clear();
+  auto writeUInt32 = [&](size_t offset, uint32_t value) {
+    memcpy(buffer.bytes() + offset, &value, sizeof(value));
+  };
+  buffer.writeRange(0, sizeof(identifier), identifier);
+  writeUInt32(12, vkFormat);
+  writeUInt32(16, 1);
+  writeUInt32(20, static_cast<uint32_t>(width));
+  writeUInt32(24, static_cast<uint32_t>(height));
+  writeUInt32(36, 1);
+  writeUInt32(40, 1);
+  writeUInt32(80, static_cast<uint32_t>(levelOffset));
+  writeUInt32(88, static_cast<uint32_t>(blocks->size()));
+  writeUInt32(96, static_cast<uint32_t>(blocks->size()));
+  buffer.writeRange(levelOffset, blocks->size(), blocks->data());
+  return buffer.release();
+}
+
+TGFX_TEST(ImageRenderTest, CompressedTexture) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  // A smooth opaque gradient with sizes that are not multiples of the 4x4 block size.
+  int width = 255;
+  int height = 126;
+  auto info = ImageInfo::Make(width, height, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  Buffer pixels(info.byteSize());
+  ASSERT_FALSE(pixels.isEmpty());
+  for (int y = 0; y < height; y++) {
+    auto row = pixels.bytes() + static_cast<size_t>(y) * info.rowBytes();
+    for (int x = 0; x < width; x++) {
+      row[x * 4] = static_cast<uint8_t>(x);
+      row[x * 4 + 1] = static_cast<uint8_t>(y * 2);
+      row[x * 4 + 2] = static_cast<uint8_t>((x + y) / 2);
+      row[x * 4 + 3] = 255;
+    }
+  }
+  auto rgbaData = pixels.release();
+
+  for (auto format : {PixelFormat::ETC2_RGB8, PixelFormat::BC1_RGB}) {
+    auto blocks = EncodeCompressedBlocks(format, rgbaData->data(), width, height, info.rowBytes());
+    ASSERT_TRUE(blocks != nullptr);
+    EXPECT_EQ(blocks->size(), PixelFormatDataSize(format, width, height));
+    Buffer decoded(info.byteSize());
+    ASSERT_TRUE(DecodeCompressedBlocks(format, blocks->data(), width, height, decoded.data(),
+                                       info.rowBytes()));
+    size_t totalDiff = 0;
+    for (size_t i = 0; i < decoded.size(); i++) {
+      totalDiff += static_cast<size_t>(std::abs(decoded.bytes()[i] - rgbaData->bytes()[i]));
+    }
+    EXPECT_LT(totalDiff, decoded.size() * 3);
+  }
+  EXPECT_TRUE(EncodeCompressedBlocks(PixelFormat::ASTC_4x4, rgbaData->data(), width, height,
+                                     info.rowBytes()) == nullptr);
+
+  auto blocks = EncodeCompressedBlocks(PixelFormat::ETC2_RGB8, rgbaData->data(), width, height,
+                                       info.rowBytes());
+  ASSERT_TRUE(blocks != nullptr);
+  // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+  auto ktxData = MakeKtx2Data(147, width, height, blocks);
+  auto codec = ImageCodec::MakeFrom(ktxData);
+  ASSERT_TRUE(codec != nullptr);
+  EXPECT_EQ(codec->width(), width);
+  EXPECT_EQ(codec->height(), height);
+  Buffer decoded(info.byteSize());
+  ASSERT_TRUE(DecodeCompressedBlocks(PixelFormat::ETC2_RGB8, blocks->data(), width, height,
+                                     decoded.data(), info.rowBytes()));
+  Buffer codecPixels(info.byteSize());
+  ASSERT_TRUE(codec->readPixels(info, codecPixels.data()));
+  EXPECT_EQ(memcmp(codecPixels.data(), decoded.data(), decoded.size()), 0);
+  auto truncated = Data::MakeWithCopy(ktxData->data(), ktxData->size() - 8);
+  EXPECT_TRUE(ImageCodec::MakeFrom(truncated) == nullptr);
+  // Supercompressed payloads are not supported.
+  Buffer supercompressed(ktxData->size());
+  supercompressed.writeRange(0, ktxData->size(), ktxData->data());
+  supercompressed.bytes()[44] = 1;
+  EXPECT_TRUE(ImageCodec::MakeFrom(supercompressed.release()) == nullptr);
+
+  auto surface = Surface::Make(context, width, height);
+  ASSERT_TRUE(surface != nullptr);
+  context->flushAndSubmit(true);
+  auto baseUsage = context->memoryUsage();
+  auto rgbaImage = Image::MakeFrom(info, rgbaData);
+  auto rgbaPixels = DrawImagePixels(surface.get(), rgbaImage);
+  auto rgbaUsage = context->memoryUsage() - baseUsage;
+  baseUsage = context->memoryUsage();
+  auto ktxPixels = DrawImagePixels(surface.get(), Image::MakeFrom(codec));
+  auto ktxUsage = context->memoryUsage() - baseUsage;
+  // ETC2 decoding is bit-exact, no matter whether the GPU or the CPU fallback decodes the blocks.
+  ASSERT_EQ(ktxPixels.size(), decoded.size());
+  EXPECT_EQ(memcmp(ktxPixels.data(), decoded.data(), decoded.size()), 0);
+
+  auto compressedImage = rgbaImage->makeCompressedTextureImage(context);
+  ASSERT_TRUE(compressedImage != nullptr);
+  EXPECT_TRUE(compressedImage->isTextureBacked());
+  baseUsage = context->memoryUsage();
+  auto compressedPixels = DrawImagePixels(surface.get(), compressedImage);
+  auto compressedUsage = context->memoryUsage() - baseUsage;
+  size_t totalDiff = 0;
+  for (size_t i = 0; i < compressedPixels.size(); i++) {
+    totalDiff += static_cast<size_t>(std::abs(compressedPixels[i] - rgbaPixels[i]));
+  }
+  EXPECT_LT(totalDiff, compressedPixels.size() * 3);
+  auto features = context->gpu()->features();
+  if (features->textureCompressionETC2) {
+    EXPECT_LT(ktxUsage * 4, rgbaUsage);
+    EXPECT_LT(compressedUsage * 4, rgbaUsage);
+  }
+}
+
+// Writes a GIF frame whose LZW data clears the table every two pixels, so all codes stay 3 bits.
+static void AppendGifFrame(std::vector<uint8_t>& gif, int left, int top, int width, int height,
+                           const std::vector<uint8_t>& indices, int delay, int disposal,
+                           int transparentIndex) {
+  auto packed = static_cast<uint8_t>((disposal << 2) | (transparentIndex >= 0 ? 1 : 0));
+  gif.insert(gif.end(), {0x21, 0xF9, 4, packed, static_cast<uint8_t>(delay & 0xFF),
+                         static_cast<uint8_t>(delay >> 8),
+                         static_cast<uint8_t>(transparentIndex >= 0 ? transparentIndex : 0), 0});
+  gif.insert(gif.end(), {0x2C, static_cast<uint8_t>(left), 0, static_cast<uint8_t>(top), 0,
+                         static_cast<uint8_t>(width), 0, static_cast<uint8_t>(height), 0, 0, 2});
+  std::vector<uint8_t> codes = {};
+  uint32_t bitBuffer = 0;
+  int bitCount = 0;
+  auto writeCode = [&](uint32_t code) {
+    bitBuffer |= code << bitCount;
+    bitCount += 3;
+    while (bitCount >= 8) {
+      codes.push_back(static_cast<uint8_t>(bitBuffer & 0xFF));
+      bitBuffer >>= 8;
+      bitCount -= 8;
+    }
+  };
+  for (size_t i = 0; i < indices.size(); i++) {
+    if (i % 2 == 0) {
+      writeCode(4);
+    }
+    writeCode(indices[i]);
+  }
+  writeCode(5);
+  if (bitCount > 0) {
+    codes.push_back(static_cast<uint8_t>(bitBuffer & 0xFF));
+  }
+  for (size_t offset = 0; offset < codes.size(); offset += 255) {
+    auto length = std::min(codes.size() - offset, static_cast<size_t>(255));
+    gif.push_back(static_cast<uint8_t>(length));
+    gif.insert(gif.end(), codes.begin() + static_cast<std::ptrdiff_t>(offset),
+               codes.begin() + static_cast<std::ptrdiff_t>(offset + length));
+  }
+  gif.push_back(0);
+}
+
+static std::shared_ptr<Data> MakeAnimatedGif() {
+  // An 8x8 canvas with a red, green, blue and black global color table, looping forever.
+  std::vector<uint8_t> gif = {'G', 'I', 'F', '8', '9', 'a', 8, 0, 8, 0, 0xF1, 0, 0};
+  gif.insert(gif.end(), {255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0});
+  gif.insert(gif.end(), {0x21, 0xFF, 11, 'N', 'E', 'T', 'S', 'C', 'A', 'P', 'E', '2', '.', '0', 3,
+                         1, 0, 0, 0});
+  AppendGifFrame(gif, 0, 0, 8, 8, std::vector<uint8_t>(64, 0), 10, 1, -1);
+  std::vector<uint8_t> green(16, 1);
+  green[0] = 3;
+  AppendGifFrame(gif, 2, 2, 4, 4, green, 20, 2, 3);
+  AppendGifFrame(gif, 6, 6, 2, 2, std::vector<uint8_t>(4, 2), 0, 0, -1);
+  gif.push_back(0x3B);
+  return Data::MakeWithCopy(gif.data(), gif.size());
+}
+
+static std::vector<uint8_t> ExpectedGifFrame(int index) {
+  std::vector<uint8_t> pixels(8 * 8 * 4, 0);
+  for (int y = 0; y < 8; y++) {
+    for (int x = 0; x < 8; x++) {
+      uint32_t color = 0xFF0000FF;
+      bool inGreen = x >= 2 && x < 6 && y >= 2 && y < 6;
+      if (index == 1 && inGreen && !(x == 2 && y == 2)) {
+        color = 0xFF00FF00;
+      } else if (index == 2 && inGreen) {
+        color = 0;
+      } else if (index == 2 && x >= 6 && y >= 6) {
+        color = 0xFFFF0000;
+      }
+      memcpy(pixels.data() + (y * 8 + x) * 4, &color, 4);
+    }
+  }
+  return pixels;
+}
+
+TGFX_TEST(ImageRenderTest, AnimatedImage) {
+  auto codec = AnimatedCodec::MakeFrom(MakeAnimatedGif());
+  ASSERT_TRUE(codec != nullptr);
+  EXPECT_EQ(codec->width(), 8);
+  EXPECT_EQ(codec->height(), 8);
+  ASSERT_EQ(codec->frameCount(), 3);
+  EXPECT_EQ(codec->loopCount(), 0);
+  EXPECT_EQ(codec->getFrameInfo(0).duration, 100000);
+  EXPECT_EQ(codec->getFrameInfo(1).duration, 200000);
+  // Near-zero delays are played at 100ms, like browsers do.
+  EXPECT_EQ(codec->getFrameInfo(2).duration, 100000);
+  EXPECT_EQ(codec->getFrameInfo(1).bounds, Rect::MakeXYWH(2, 2, 4, 4));
+  EXPECT_EQ(codec->getFrameInfo(1).disposal, FrameDisposal::Background);
+  EXPECT_EQ(codec->duration(), 400000);
+  EXPECT_EQ(codec->getFrameAtTime(99999), 0);
+  EXPECT_EQ(codec->getFrameAtTime(100000), 1);
+  EXPECT_EQ(codec->getFrameAtTime(350000), 2);
+  EXPECT_EQ(codec->getFrameAtTime(450000), 0);
+  EXPECT_TRUE(AnimatedCodec::MakeFrom(Data::MakeWithCopy("GIF89a", 6)) == nullptr);
+
+  auto info = ImageInfo::Make(8, 8, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  std::vector<uint8_t> pixels(info.byteSize());
+  // Seeking backward and forward must give the same composited frames with any cache size.
+  for (auto maxCachedFrames : {1, 3}) {
+    codec->setMaxCachedFrames(maxCachedFrames);
+    for (auto index : {2, 0, 1, 2, 1}) {
+      ASSERT_TRUE(codec->readFrame(index, info, pixels.data()));
+      EXPECT_TRUE(pixels == ExpectedGifFrame(index));
+    }
+  }
+
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 8, 8);
+  ASSERT_TRUE(surface != nullptr);
+  // Successive frames update the dirty region of one shared texture.
+  for (auto index : {0, 1, 2, 0}) {
+    auto image = codec->makeFrameImage(index);
+    ASSERT_TRUE(image != nullptr);
+    EXPECT_TRUE(DrawImagePixels(surface.get(), image) == ExpectedGifFrame(index));
+  }
+  context->flushAndSubmit(true);
+  auto baseUsage = context->memoryUsage();
+  EXPECT_TRUE(DrawImagePixels(surface.get(), codec->makeFrameImage(1)) == ExpectedGifFrame(1));
+  EXPECT_EQ(context->memoryUsage(), baseUsage);
+  // Two frames drawn in the same flush can not share the texture.
+  auto canvas = surface->getCanvas();
+  canvas->clear();
+  canvas->drawImage(codec->makeFrameImage(2));
+  canvas->drawImage(codec->makeFrameImage(0), 4, 0);
+  ASSERT_TRUE(surface->readPixels(info, pixels.data()));
+  auto frame0 = ExpectedGifFrame(0);
+  auto frame2 = ExpectedGifFrame(2);
+  for (size_t y = 0; y < 8; y++) {
+    auto row = y * 32;
+    EXPECT_EQ(memcmp(pixels.data() + row, frame2.data() + row, 16), 0);
+    EXPECT_EQ(memcmp(pixels.data() + row + 16, frame0.data() + row, 16), 0);
+  }
+  // Another context keeps a texture of its own, so it never reuses the proxy pending on this one.
+  canvas->clear();
+  canvas->drawImage(codec->makeFrameImage(2));
+  std::vector<uint8_t> otherPixels = {};
+  auto otherTask = Task::Run([&codec, &otherPixels] {
+    ContextScope otherScope;
+    auto otherContext = otherScope.getContext();
+    if (otherContext == nullptr) {
+      return;
+    }
+    auto otherSurface = Surface::Make(otherContext, 8, 8);
+    if (otherSurface != nullptr) {
+      otherPixels = DrawImagePixels(otherSurface.get(), codec->makeFrameImage(1));
+    }
+  });
+  otherTask->wait();
+  EXPECT_TRUE(otherPixels == ExpectedGifFrame(1));
+  ASSERT_TRUE(surface->readPixels(info, pixels.data()));
+  EXPECT_TRUE(pixels == frame2);
+
+  auto layer = ImageLayer::Make();
+  layer->setAnimatedCodec(codec);
+  auto firstImage = layer->image();
+  ASSERT_TRUE(firstImage != nullptr);
+  layer->setCurrentTime(50000);
+  EXPECT_EQ(layer->image(), firstImage);
+  layer->setCurrentTime(150000);
+  EXPECT_NE(layer->image(), firstImage);
+  layer->setImage(nullptr);
+  EXPECT_TRUE(layer->animatedCodec() == nullptr);
+}
 }  // namespace tgfx
@@ -4877,4 +4877,469 @@ TGFX_TEST(LayerTest, NestedOffscreenTiledZoom) {
                                  "LayerTest/NestedOffscreenTiledZoom");
 }
 
+static void BuildTileRecordingScene(DisplayList* displayList, int width, int height,
+                                    int layerCount) {
+  auto columns = static_cast<int>(std::sqrt(static_cast<float>(layerCount)));
+  auto cellWidth = static_cast<float>(width) / static_cast<float>(columns);
+  auto cellHeight = static_cast<float>(height) / static_cast<float>(columns);
+  for (int i = 0; i < layerCount; i++) {
+    auto shapeLayer = ShapeLayer::Make();
+    Path path = {};
+    path.addRoundRect(Rect::MakeWH(cellWidth * 0.8f, cellHeight * 0.8f), 6, 6);
+    shapeLayer->setPath(path);
+    auto hue = static_cast<uint8_t>(i * 37 % 255);
+    shapeLayer->setFillStyle(ShapeStyle::Make(Color::FromRGBA(hue, 128, 255 - hue, 255)));
+    shapeLayer->setStrokeStyle(ShapeStyle::Make(Color::Black()));
+    shapeLayer->setLineWidth(2);
+    auto x = static_cast<float>(i % columns) * cellWidth;
+    auto y = static_cast<float>(i / columns % columns) * cellHeight;
+    shapeLayer->setMatrix(Matrix::MakeTrans(x, y));
+    displayList->root()->addChild(shapeLayer);
+  }
+}
+
+TGFX_TEST(LayerTest, TiledParallelRecording) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto serialSurface = Surface::Make(context, 512, 512);
+  auto parallelSurface = Surface::Make(context, 512, 512);
+  ASSERT_TRUE(serialSurface != nullptr && parallelSurface != nullptr);
+  DisplayList serialList;
+  serialList.setRenderMode(RenderMode::Tiled);
+  serialList.setTileSize(128);
+  BuildTileRecordingScene(&serialList, 512, 512, 400);
+  DisplayList parallelList;
+  parallelList.setRenderMode(RenderMode::Tiled);
+  parallelList.setTileSize(128);
+  parallelList.setTileRecordingThreads(4);
+  EXPECT_EQ(parallelList.tileRecordingThreads(), 4);
+  BuildTileRecordingScene(&parallelList, 512, 512, 400);
+  serialList.render(serialSurface.get());
+  parallelList.render(parallelSurface.get());
+
+  Bitmap serialBitmap(512, 512);
+  Bitmap parallelBitmap(512, 512);
+  auto serialPixels = serialBitmap.lockPixels();
+  auto parallelPixels = parallelBitmap.lockPixels();
+  ASSERT_TRUE(serialSurface->readPixels(serialBitmap.info(), serialPixels));
+  ASSERT_TRUE(parallelSurface->readPixels(parallelBitmap.info(), parallelPixels));
+  EXPECT_EQ(memcmp(serialPixels, parallelPixels, serialBitmap.info().byteSize()), 0);
+  serialBitmap.unlockPixels();
+  parallelBitmap.unlockPixels();
+}
+
+static void BuildContentUpdateScene(DisplayList* displayList, const Font& font, int width,
+                                    int height, int layerCount) {
+  auto columns = static_cast<int>(std::sqrt(static_cast<float>(layerCount)));
+  auto cellWidth = static_cast<float>(width) / static_cast<float>(columns);
+  auto cellHeight = static_cast<float>(height) / static_cast<float>(columns);
+  // A fill style shared by several VectorLayers, whose contents must be updated serially.
+  auto sharedFill = FillStyle::Make(SolidColor::Make(Color::FromRGBA(40, 160, 90, 255)));
+  std::shared_ptr<Layer> row = nullptr;
+  for (int i = 0; i < layerCount; i++) {
+    if (i % columns == 0) {
+      row = Layer::Make();
+      displayList->root()->addChild(row);
+    }
+    std::shared_ptr<Layer> layer = nullptr;
+    switch (i % 3) {
+      case 0: {
+        auto vectorLayer = VectorLayer::Make();
+        auto group = VectorGroup::Make();
+        auto rect = Rectangle::Make();
+        rect->setPosition({cellWidth * 0.3f, cellHeight * 0.3f});
+        rect->setSize({cellWidth * 0.4f, cellHeight * 0.4f});
+        auto star = ShapePath::Make();
+        star->setPath(MakeStarPath());
+        auto stroke = StrokeStyle::Make(SolidColor::Make(Color::Blue()));
+        stroke->setStrokeWidth(2);
+        auto fill = i % 9 == 0 ? sharedFill : FillStyle::Make(SolidColor::Make(Color::Red()));
+        group->setElements({rect, star, fill, stroke});
+        group->setScale({cellWidth / 150.0f, cellHeight / 150.0f});
+        vectorLayer->setContents({group});
+        layer = vectorLayer;
+        break;
+      }
+      case 1: {
+        auto textLayer = TextLayer::Make();
+        textLayer->setFont(font);
+        textLayer->setTextColor(Color::Black());
+        textLayer->setText("Layer " + std::to_string(i));
+        layer = textLayer;
+        break;
+      }
+      default: {
+        auto shapeLayer = ShapeLayer::Make();
+        Path path = {};
+        path.addRoundRect(Rect::MakeWH(cellWidth * 0.8f, cellHeight * 0.8f), 6, 6);
+        shapeLayer->setPath(path);
+        auto hue = static_cast<uint8_t>(i * 37 % 255);
+        shapeLayer->setFillStyle(ShapeStyle::Make(Color::FromRGBA(hue, 128, 255 - hue, 255)));
+        shapeLayer->setStrokeStyle(ShapeStyle::Make(Color::Black()));
+        shapeLayer->setLineWidth(2);
+        shapeLayer->setLineDashPattern({4, 2});
+        layer = shapeLayer;
+        break;
+      }
+    }
+    auto x = static_cast<float>(i % columns) * cellWidth;
+    auto y = static_cast<float>(i / columns % columns) * cellHeight;
+    layer->setMatrix(Matrix::MakeTrans(x, y));
+    row->addChild(layer);
+  }
+}
+
+// Invalidates the contents of every other leaf layer in the scene.
+static void UpdateContentUpdateScene(DisplayList* displayList, int frame) {
+  for (auto& row : displayList->root()->children()) {
+    auto& children = row->children();
+    for (size_t i = static_cast<size_t>(frame % 2); i < children.size(); i += 2) {
+      auto& layer = children[i];
+      switch (layer->type()) {
+        case LayerType::Vector: {
+          auto vectorLayer = std::static_pointer_cast<VectorLayer>(layer);
+          auto group = std::static_pointer_cast<VectorGroup>(vectorLayer->contents()[0]);
+          auto rect = std::static_pointer_cast<Rectangle>(group->elements()[0]);
+          auto size = rect->size();
+          rect->setSize({size.width * 0.9f, size.height * 1.1f});
+          break;
+        }
+        case LayerType::Text: {
+          auto textLayer = std::static_pointer_cast<TextLayer>(layer);
+          textLayer->setText(textLayer->text() + std::to_string(frame));
+          break;
+        }
+        case LayerType::Shape: {
+          auto shapeLayer = std::static_pointer_cast<ShapeLayer>(layer);
+          shapeLayer->setLineWidth(shapeLayer->lineWidth() + 1);
+          break;
+        }
+        default:
+          break;
+      }
+    }
+  }
+}
+
+TGFX_TEST(LayerTest, ParallelContentUpdate) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto typeface = MakeTypeface("resources/font/NotoSansSC-Regular.otf");
+  ASSERT_TRUE(typeface != nullptr);
+  Font font(typeface, 12);
+  auto serialSurface = Surface::Make(context, 512, 512);
+  auto parallelSurface = Surface::Make(context, 512, 512);
+  ASSERT_TRUE(serialSurface != nullptr && parallelSurface != nullptr);
+  DisplayList serialList;
+  BuildContentUpdateScene(&serialList, font, 512, 512, 400);
+  DisplayList parallelList;
+  parallelList.setContentUpdateThreads(4);
+  EXPECT_EQ(parallelList.contentUpdateThreads(), 4);
+  BuildContentUpdateScene(&parallelList, font, 512, 512, 400);
+  auto firstRow = parallelList.root()->children()[0];
+  EXPECT_TRUE(firstRow->children()[0]->bitFields.sharedProperty);
+  EXPECT_FALSE(firstRow->children()[3]->bitFields.sharedProperty);
+  // Gives one row a mask so that dirty mask contents are updated along with their owners.
+  auto serialMask = SolidLayer::Make();
+  serialMask->setWidth(300);
+  serialMask->setHeight(512);
+  serialList.root()->children()[1]->setMask(serialMask);
+  serialList.root()->addChild(serialMask);
+  auto parallelMask = SolidLayer::Make();
+  parallelMask->setWidth(300);
+  parallelMask->setHeight(512);
+  parallelList.root()->children()[1]->setMask(parallelMask);
+  parallelList.root()->addChild(parallelMask);
+
+  Bitmap serialBitmap(512, 512);
+  Bitmap parallelBitmap(512, 512);
+  for (int frame = 0; frame < 3; frame++) {
+    if (frame > 0) {
+      UpdateContentUpdateScene(&serialList, frame);
+      UpdateContentUpdateScene(&parallelList, frame);
+      serialMask->setWidth(300.0f - static_cast<float>(frame) * 50.0f);
+      parallelMask->setWidth(300.0f - static_cast<float>(frame) * 50.0f);
+    }
+    serialList.render(serialSurface.get());
+    parallelList.render(parallelSurface.get());
+    EXPECT_FALSE(parallelMask->bitFields.dirtyContent);
+    auto serialPixels = serialBitmap.lockPixels();
+    auto parallelPixels = parallelBitmap.lockPixels();
+    ASSERT_TRUE(serialSurface->readPixels(serialBitmap.info(), serialPixels));
+    ASSERT_TRUE(parallelSurface->readPixels(parallelBitmap.info(), parallelPixels));
+    EXPECT_EQ(memcmp(serialPixels, parallelPixels, serialBitmap.info().byteSize()), 0);
+    serialBitmap.unlockPixels();
+    parallelBitmap.unlockPixels();
+  }
+}
+
+static std::vector<Layer*> HitTestPoints(Layer* root, const std::vector<Point>& points) {
+  std::vector<Layer*> results = {};
+  for (auto& point : points) {
+    for (auto& layer : root->getLayersUnderPoint(point.x, point.y)) {
+      results.push_back(layer.get());
+    }
+    // Separates the results of each point, and records the hitTestPoint() result as well.
+    results.push_back(root->hitTestPoint(point.x, point.y) ? root : nullptr);
+  }
+  return results;
+}
+
+TGFX_TEST(LayerTest, SpatialIndexHitTest) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 512, 512);
+  ASSERT_TRUE(surface != nullptr);
+  DisplayList displayList;
+  BuildTileRecordingScene(&displayList, 512, 512, 400);
+  auto root = displayList.root();
+  auto children = root->children();
+  children[3]->setAlpha(0.0f);
+  children[5]->setVisible(false);
+  children[7]->setScrollRect(Rect::MakeXYWH(5, 5, 10, 10));
+  auto matrix = children[11]->matrix();
+  matrix.preRotate(30);
+  children[11]->setMatrix(matrix);
+  auto nested = Layer::Make();
+  nested->setMatrix(Matrix::MakeTrans(100, 100));
+  for (int i = 0; i < 100; i++) {
+    auto solidLayer = SolidLayer::Make();
+    solidLayer->setWidth(8);
+    solidLayer->setHeight(8);
+    solidLayer->setMatrix(Matrix::MakeTrans(static_cast<float>(i % 10) * 10.0f,
+                                            static_cast<float>(i / 10) * 10.0f));
+    nested->addChild(solidLayer);
+  }
+  root->addChild(nested);
+
+  std::vector<Point> points = {};
+  for (int i = 0; i < 400; i++) {
+    points.push_back(Point::Make(static_cast<float>(i * 37 % 512) + 0.5f,
+                                 static_cast<float>(i * 53 % 512) + 0.5f));
+  }
+  points.push_back(Point::Make(-10, -10));
+  points.push_back(Point::Make(1000, 1000));
+
+  // Before the first render all bounds are dirty, so hit testing scans the children linearly.
+  auto expected = HitTestPoints(root, points);
+  displayList.render(surface.get());
+  EXPECT_EQ(HitTestPoints(root, points), expected);
+
+  children[20]->setMatrix(Matrix::MakeTrans(200, 200));
+  children[30]->setAlpha(1.0f);
+  children[3]->setAlpha(1.0f);
+  children[5]->setVisible(true);
+  nested->children()[42]->setMatrix(Matrix::MakeTrans(-50, -50));
+  root->removeChildAt(40);
+  expected = HitTestPoints(root, points);
+  displayList.render(surface.get());
+  EXPECT_EQ(HitTestPoints(root, points), expected);
+}
+
+TGFX_TEST(LayerTest, SpatialIndexHitTestManyLayers) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  const int width = 2048;
+  const int height = 2048;
+  const int layerCount = 50000;
+  const int pointCount = 1000;
+  auto surface = Surface::Make(context, width, height);
+  ASSERT_TRUE(surface != nullptr);
+  DisplayList displayList;
+  BuildTileRecordingScene(&displayList, width, height, layerCount);
+  auto root = displayList.root();
+  std::vector<Point> points = {};
+  for (int i = 0; i < pointCount; i++) {
+    points.push_back(Point::Make(static_cast<float>(i * 7919 % width),
+                                 static_cast<float>(i * 104729 % height)));
+  }
+
+  auto expected = HitTestPoints(root, points);
+  displayList.render(surface.get());
+  context->flushAndSubmit(true);
+  EXPECT_EQ(HitTestPoints(root, points), expected);
+  // Moving a few layers only refreshes their leaves on the next query.
+  auto children = root->children();
+  for (size_t i = 0; i < 100; i++) {
+    children[i * 97]->setMatrix(Matrix::MakeTrans(static_cast<float>(i * 13 % width),
+                                                  static_cast<float>(i * 29 % height)));
+  }
+  expected = HitTestPoints(root, points);
+  displayList.render(surface.get());
+  context->flushAndSubmit(true);
+  EXPECT_EQ(HitTestPoints(root, points), expected);
+}
+
+static std::string MakeTextDocument(size_t paragraphCount) {
+  const std::string latin = "The quick brown fox jumps over the lazy dog. ";
+  const std::string cjk = "天地玄黄，宇宙洪荒。日月盈昃，辰宿列张。";
+  std::string text = {};
+  for (size_t i = 0; i < paragraphCount; i++) {
+    text += i % 3 == 2 ? cjk + latin : latin + latin;
+    text += std::to_string(i) + "\n";
+  }
+  return text;
+}
+
+TGFX_TEST(LayerTest, TextLayerIncrementalShaping) {
+  auto typeface = MakeTypeface("resources/font/NotoSansSC-Regular.otf");
+  ASSERT_TRUE(typeface != nullptr);
+  Font font(typeface, 16);
+  auto text = MakeTextDocument(20);
+  auto textLayer = TextLayer::Make();
+  textLayer->setFont(font);
+  textLayer->setWidth(300);
+  textLayer->setAutoWrap(true);
+  textLayer->setText(text);
+  textLayer->getBounds();
+  // 20 paragraphs plus the empty one after the last line break.
+  ASSERT_EQ(textLayer->shapedParagraphs.size(), 21u);
+  auto firstParagraph = textLayer->shapedParagraphs[0];
+  auto lastParagraph = textLayer->shapedParagraphs[19];
+  auto editedParagraph = textLayer->shapedParagraphs[10];
+  auto position = text.find("10\n");
+  text.insert(position, "edited ");
+  textLayer->setText(text);
+  auto bounds = textLayer->getBounds();
+  ASSERT_EQ(textLayer->shapedParagraphs.size(), 21u);
+  EXPECT_EQ(textLayer->shapedParagraphs[0], firstParagraph);
+  EXPECT_EQ(textLayer->shapedParagraphs[19], lastParagraph);
+  EXPECT_NE(textLayer->shapedParagraphs[10], editedParagraph);
+  // The incremental layout must match a layout from scratch.
+  auto freshLayer = TextLayer::Make();
+  freshLayer->setFont(font);
+  freshLayer->setWidth(300);
+  freshLayer->setAutoWrap(true);
+  freshLayer->setText(text);
+  EXPECT_EQ(freshLayer->getBounds(), bounds);
+  // Changing the font shapes everything again.
+  textLayer->setFont(Font(typeface, 20));
+  textLayer->getBounds();
+  EXPECT_NE(textLayer->shapedParagraphs[0], firstParagraph);
+
+#ifdef TGFX_USE_HARFBUZZ
+  // HarfBuzz joins a ZWJ emoji sequence into a single glyph.
+  auto emojiTypeface = MakeTypeface("resources/font/NotoColorEmoji.ttf");
+  ASSERT_TRUE(emojiTypeface != nullptr);
+  auto emojiLayer = TextLayer::Make();
+  emojiLayer->setFont(Font(emojiTypeface, 20));
+  emojiLayer->setText("👨");
+  auto singleBounds = emojiLayer->getBounds();
+  emojiLayer->setText("👨‍👩‍👧");
+  auto familyBounds = emojiLayer->getBounds();
+  EXPECT_LT(familyBounds.width(), singleBounds.width() * 1.5f);
+#endif
+}
+
+TGFX_TEST(LayerTest, TextLayerShapingLargeDocument) {
+  auto typeface = MakeTypeface("resources/font/NotoSansSC-Regular.otf");
+  ASSERT_TRUE(typeface != nullptr);
+  Font font(typeface, 16);
+  auto text = MakeTextDocument(1100);
+  const int editCount = 100;
+  auto textLayer = TextLayer::Make();
+  textLayer->setFont(font);
+  textLayer->setWidth(800);
+  textLayer->setAutoWrap(true);
+  textLayer->setText(text);
+  auto expectedBounds = textLayer->getBounds();
+  // Types one character at a time into a paragraph in the middle of the document.
+  auto position = text.find("550\n");
+  ASSERT_NE(position, std::string::npos);
+  for (int i = 0; i < editCount; i++) {
+    text.insert(position++, "a");
+    textLayer->setText(text);
+    textLayer->getBounds();
+  }
+  // Relayout without shaping, for example after the layout width changes.
+  textLayer->setWidth(600);
+  textLayer->getBounds();
+  textLayer->setWidth(800);
+  auto freshLayer = TextLayer::Make();
+  freshLayer->setFont(font);
+  freshLayer->setWidth(800);
+  freshLayer->setAutoWrap(true);
+  freshLayer->setText(text);
+  EXPECT_EQ(freshLayer->getBounds(), textLayer->getBounds());
+  EXPECT_GE(textLayer->getBounds().height(), expectedBounds.height());
+}
+
+static std::vector<std::shared_ptr<SolidLayer>> AddIconGrid(DisplayList* displayList, int count) {
+  std::vector<std::shared_ptr<SolidLayer>> icons = {};
+  for (int i = 0; i < count; i++) {
+    auto icon = SolidLayer::Make();
+    icon->setWidth(12);
+    icon->setHeight(12);
+    icon->setColor(Color::Red());
+    icon->setMatrix(Matrix::MakeTrans(static_cast<float>(i % 20 * 40 + 10),
+                                      static_cast<float>(i / 20 * 40 + 10)));
+    displayList->root()->addChild(icon);
+    icons.push_back(icon);
+  }
+  return icons;
+}
+
+TGFX_TEST(LayerTest, ScatteredDirtyRegions) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  const int iconCount = 300;
+  DisplayList inspectList;
+  auto inspectIcons = AddIconGrid(&inspectList, iconCount);
+  auto root = static_cast<RootLayer*>(inspectList.root());
+  root->updateDirtyRegions();
+  // Blinking every other icon must not merge the gaps between them into large redraw rects.
+  for (size_t i = 0; i < inspectIcons.size(); i += 2) {
+    inspectIcons[i]->setColor(Color::Blue());
+  }
+  auto dirtyRegions = root->updateDirtyRegions();
+  EXPECT_EQ(dirtyRegions.size(), static_cast<size_t>(iconCount / 2));
+  float totalArea = 0;
+  for (auto& rect : dirtyRegions) {
+    totalArea += rect.area();
+  }
+  EXPECT_LE(totalArea, static_cast<float>(iconCount / 2) * 12.f * 12.f);
+
+  // Partial rendering of the scattered updates must match a full redraw.
+  auto partialSurface = Surface::Make(context, 800, 600);
+  auto directSurface = Surface::Make(context, 800, 600);
+  ASSERT_TRUE(partialSurface != nullptr && directSurface != nullptr);
+  DisplayList partialList;
+  partialList.setRenderMode(RenderMode::Partial);
+  auto partialIcons = AddIconGrid(&partialList, iconCount);
+  partialList.render(partialSurface.get());
+  DisplayList directList;
+  directList.setRenderMode(RenderMode::Direct);
+  auto directIcons = AddIconGrid(&directList, iconCount);
+  for (size_t i = 0; i < partialIcons.size(); i += 2) {
+    partialIcons[i]->setColor(Color::Blue());
+    directIcons[i]->setColor(Color::Blue());
+  }
+  partialList.render(partialSurface.get());
+  directList.render(directSurface.get());
+  Bitmap partialBitmap(800, 600);
+  Bitmap directBitmap(800, 600);
+  auto partialPixels = partialBitmap.lockPixels();
+  auto directPixels = directBitmap.lockPixels();
+  ASSERT_TRUE(partialSurface->readPixels(partialBitmap.info(), partialPixels));
+  ASSERT_TRUE(directSurface->readPixels(directBitmap.info(), directPixels));
+  EXPECT_EQ(memcmp(partialPixels, directPixels, partialBitmap.info().byteSize()), 0);
+  partialBitmap.unlockPixels();
+  directBitmap.unlockPixels();
+
+  // Each redrawn rect traverses the whole layer tree, so the scattered updates are redrawn with a
+  // bounded number of rects rather than one per icon.
+  partialList.showDirtyRegions(true);
+  for (size_t i = 1; i < partialIcons.size(); i += 2) {
+    partialIcons[i]->setColor(Color::Green());
+  }
+  partialList.render(partialSurface.get());
+  TGFX_PRIVATE_ACCESS(auto& renderRects = partialList.lastDirtyRegions.back();
+                      EXPECT_GT(renderRects.size(), 0u);
+                      EXPECT_LE(renderRects.size(), MAX_PARTIAL_RENDER_RECTS));
+}
 }  // namespace tgfx
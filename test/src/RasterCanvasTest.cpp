@@ -0,0 +1,226 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <vector>
+#include "tgfx/core/PictureRecorder.h"
+#include "tgfx/core/RasterCanvas.h"
+#include "tgfx/core/Surface.h"
+#include "tgfx/layers/DisplayList.h"
+#include "tgfx/layers/Layer.h"
+#include "tgfx/layers/ShapeLayer.h"
+#include "tgfx/layers/SolidLayer.h"
+#include "tgfx/layers/filters/BlurFilter.h"
+#include "utils/TestUtils.h"
+
+namespace tgfx {
+static void DrawRasterScene(Canvas* canvas, std::shared_ptr<Image> image) {
+  canvas->clear(Color::White());
+  Paint paint = {};
+  paint.setColor(Color::FromRGBA(220, 60, 60, 255));
+  canvas->drawRect(Rect::MakeXYWH(10, 10, 80, 60), paint);
+  paint.setColor(Color::FromRGBA(40, 120, 220, 160));
+  canvas->drawRoundRect(Rect::MakeXYWH(50, 40, 100, 70), 16, 16, paint);
+  Path path = {};
+  path.moveTo(180, 20);
+  path.lineTo(250, 110);
+  path.lineTo(170, 90);
+  path.close();
+  paint.setColor(Color::FromRGBA(30, 160, 90, 255));
+  canvas->drawPath(path, paint);
+  paint.setStyle(PaintStyle::Stroke);
+  paint.setStrokeWidth(6);
+  paint.setColor(Color::Black());
+  canvas->drawCircle(80, 180, 40, paint);
+  paint.setStyle(PaintStyle::Fill);
+  paint.setShader(Shader::MakeLinearGradient({140, 140}, {250, 240},
+                                             {Color::Red(), Color::Blue(), Color::Green()}, {}));
+  canvas->drawRect(Rect::MakeXYWH(140, 140, 110, 100), paint);
+  paint.setShader(Shader::MakeRadialGradient({200, 300}, 50, {Color::White(), Color::Black()}, {}));
+  paint.setBlendMode(BlendMode::Multiply);
+  canvas->drawCircle(200, 300, 50, paint);
+  paint.setShader(nullptr);
+  paint.setBlendMode(BlendMode::SrcOver);
+  if (image != nullptr) {
+    canvas->save();
+    canvas->translate(10, 250);
+    canvas->scale(100.0f / static_cast<float>(image->width()),
+                  100.0f / static_cast<float>(image->height()));
+    canvas->drawImage(image, SamplingOptions(FilterMode::Linear, MipmapMode::None));
+    canvas->restore();
+  }
+  canvas->save();
+  canvas->clipRect(Rect::MakeXYWH(260, 10, 100, 100));
+  paint.setColor(Color::FromRGBA(250, 180, 0, 255));
+  canvas->drawCircle(330, 60, 60, paint);
+  canvas->restore();
+  canvas->save();
+  Path clipPath = {};
+  clipPath.addOval(Rect::MakeXYWH(260, 130, 100, 100));
+  canvas->clipPath(clipPath);
+  paint.setColor(Color::FromRGBA(120, 0, 200, 255));
+  canvas->drawRect(Rect::MakeXYWH(250, 120, 60, 120), paint);
+  canvas->restore();
+  paint.setAlpha(0.5f);
+  canvas->saveLayer(&paint);
+  paint.setAlpha(1.0f);
+  paint.setColor(Color::FromRGBA(0, 200, 200, 255));
+  canvas->drawRect(Rect::MakeXYWH(270, 260, 80, 80), paint);
+  paint.setColor(Color::FromRGBA(200, 0, 200, 255));
+  canvas->drawRect(Rect::MakeXYWH(300, 290, 80, 80), paint);
+  canvas->restore();
+}
+
+// Returns the fraction of pixels whose channels all differ by no more than the tolerance.
+static float MatchedPixelRatio(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b,
+                               int tolerance) {
+  size_t matched = 0;
+  auto pixelCount = a.size() / 4;
+  for (size_t i = 0; i < pixelCount; i++) {
+    auto same = true;
+    for (size_t j = 0; j < 4; j++) {
+      if (std::abs(a[i * 4 + j] - b[i * 4 + j]) > tolerance) {
+        same = false;
+        break;
+      }
+    }
+    matched += same ? 1 : 0;
+  }
+  return pixelCount > 0 ? static_cast<float>(matched) / static_cast<float>(pixelCount) : 0.0f;
+}
+
+TGFX_TEST(RasterCanvasTest, MatchesGPUOutput) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  const int width = 400;
+  const int height = 400;
+  auto image = MakeImage("resources/apitest/imageReplacement.png");
+  ASSERT_TRUE(image != nullptr);
+  auto info = ImageInfo::Make(width, height, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  auto surface = Surface::Make(context, width, height);
+  ASSERT_TRUE(surface != nullptr);
+  DrawRasterScene(surface->getCanvas(), image);
+  std::vector<uint8_t> gpuPixels(info.byteSize());
+  ASSERT_TRUE(surface->readPixels(info, gpuPixels.data()));
+
+  std::vector<uint8_t> rasterPixels(info.byteSize());
+  auto rasterCanvas = RasterCanvas::Make(Pixmap(info, rasterPixels.data()));
+  ASSERT_TRUE(rasterCanvas != nullptr);
+  DrawRasterScene(rasterCanvas->getCanvas(), image);
+  EXPECT_GT(MatchedPixelRatio(gpuPixels, rasterPixels, 8), 0.998f);
+
+  PictureRecorder recorder = {};
+  DrawRasterScene(recorder.beginRecording(), image);
+  auto picture = recorder.finishRecordingAsPicture();
+  ASSERT_TRUE(picture != nullptr);
+  std::vector<uint8_t> picturePixels(info.byteSize());
+  rasterCanvas = RasterCanvas::Make(Pixmap(info, picturePixels.data()));
+  ASSERT_TRUE(rasterCanvas != nullptr);
+  EXPECT_TRUE(rasterCanvas->drawPicture(picture));
+  EXPECT_GT(MatchedPixelRatio(rasterPixels, picturePixels, 1), 0.9999f);
+}
+
+TGFX_TEST(RasterCanvasTest, LayerTree) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  const int width = 200;
+  const int height = 200;
+  auto root = Layer::Make();
+  auto background = SolidLayer::Make();
+  background->setWidth(static_cast<float>(width));
+  background->setHeight(static_cast<float>(height));
+  background->setColor(Color::FromRGBA(240, 240, 240, 255));
+  root->addChild(background);
+  auto shapeLayer = ShapeLayer::Make();
+  Path path = {};
+  path.addOval(Rect::MakeXYWH(0, 0, 120, 80));
+  shapeLayer->setPath(path);
+  shapeLayer->setFillStyle(ShapeStyle::Make(Color::FromRGBA(200, 60, 30, 255)));
+  shapeLayer->setMatrix(Matrix::MakeTrans(40, 60));
+  shapeLayer->setAlpha(0.8f);
+  root->addChild(shapeLayer);
+
+  auto info = ImageInfo::Make(width, height, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  auto surface = Surface::Make(context, width, height);
+  ASSERT_TRUE(surface != nullptr);
+  root->draw(surface->getCanvas());
+  std::vector<uint8_t> gpuPixels(info.byteSize());
+  ASSERT_TRUE(surface->readPixels(info, gpuPixels.data()));
+
+  std::vector<uint8_t> rasterPixels(info.byteSize());
+  auto rasterCanvas = RasterCanvas::Make(Pixmap(info, rasterPixels.data()));
+  ASSERT_TRUE(rasterCanvas != nullptr);
+  root->draw(rasterCanvas->getCanvas());
+  EXPECT_GT(MatchedPixelRatio(gpuPixels, rasterPixels, 8), 0.998f);
+}
+
+TGFX_TEST(RasterCanvasTest, DisplayList) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  const int width = 200;
+  const int height = 200;
+  DisplayList displayList;
+  displayList.setRenderMode(RenderMode::Direct);
+  displayList.setBackgroundColor(Color::FromRGBA(240, 240, 240, 255));
+  displayList.setZoomScale(1.5f);
+  displayList.setContentOffset(-20.0f, -10.0f);
+  auto shapeLayer = ShapeLayer::Make();
+  Path path = {};
+  path.addOval(Rect::MakeXYWH(0, 0, 120, 80));
+  shapeLayer->setPath(path);
+  shapeLayer->setFillStyle(ShapeStyle::Make(Color::FromRGBA(200, 60, 30, 255)));
+  shapeLayer->setMatrix(Matrix::MakeTrans(40, 60));
+  shapeLayer->setAlpha(0.8f);
+  displayList.root()->addChild(shapeLayer);
+  auto solidLayer = SolidLayer::Make();
+  solidLayer->setWidth(60);
+  solidLayer->setHeight(40);
+  solidLayer->setRadiusX(8);
+  solidLayer->setRadiusY(8);
+  solidLayer->setColor(Color::FromRGBA(30, 90, 200, 200));
+  solidLayer->setMatrix(Matrix::MakeTrans(20, 20));
+  displayList.root()->addChild(solidLayer);
+
+  auto info = ImageInfo::Make(width, height, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  auto surface = Surface::Make(context, width, height);
+  ASSERT_TRUE(surface != nullptr);
+  displayList.render(surface.get());
+  std::vector<uint8_t> gpuPixels(info.byteSize());
+  ASSERT_TRUE(surface->readPixels(info, gpuPixels.data()));
+
+  std::vector<uint8_t> rasterPixels(info.byteSize());
+  auto rasterCanvas = RasterCanvas::Make(Pixmap(info, rasterPixels.data()));
+  ASSERT_TRUE(rasterCanvas != nullptr);
+  EXPECT_TRUE(displayList.render(rasterCanvas.get()));
+  EXPECT_FALSE(displayList.hasContentChanged());
+  EXPECT_GT(MatchedPixelRatio(gpuPixels, rasterPixels, 8), 0.998f);
+
+  // Filters have no CPU implementation, so the render fails without touching the pixels.
+  shapeLayer->setFilters({BlurFilter::Make(10, 10)});
+  auto lastPixels = rasterPixels;
+  EXPECT_FALSE(displayList.render(rasterCanvas.get()));
+  EXPECT_TRUE(rasterPixels == lastPixels);
+
+  shapeLayer->setFilters({});
+  EXPECT_TRUE(displayList.render(rasterCanvas.get()));
+  EXPECT_GT(MatchedPixelRatio(gpuPixels, rasterPixels, 8), 0.998f);
+}
+}  // namespace tgfx
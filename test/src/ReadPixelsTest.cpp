@@ -589,4 +589,121 @@ TGFX_TEST(ReadPixelsTest, ReadScaleCodec) {
   EXPECT_TRUE(Baseline::Compare(Pixmap(RGBA_F16Info, pixelsC.data()),
                                 "ReadPixelsTest/read_RGBA_F16_scaled_codec"));
 }
+
+static bool CompareRegionWithFullDecode(std::shared_ptr<ImageCodec> codec, const Rect& region) {
+  auto fullInfo = ImageInfo::Make(codec->width(), codec->height(), ColorType::RGBA_8888,
+                                  AlphaType::Premultiplied);
+  Buffer fullPixels(fullInfo.byteSize());
+  if (!codec->readPixels(fullInfo, fullPixels.data())) {
+    return false;
+  }
+  auto regionInfo = ImageInfo::Make(static_cast<int>(region.width()),
+                                    static_cast<int>(region.height()), ColorType::RGBA_8888,
+                                    AlphaType::Premultiplied);
+  Buffer expected(regionInfo.byteSize());
+  Pixmap(fullInfo, fullPixels.data())
+      .readPixels(regionInfo, expected.data(), static_cast<int>(region.left),
+                  static_cast<int>(region.top));
+  Buffer actual(regionInfo.byteSize());
+  if (!codec->readPixels(region, regionInfo, actual.data())) {
+    return false;
+  }
+  return memcmp(expected.data(), actual.data(), regionInfo.byteSize()) == 0;
+}
+
+TGFX_TEST(ReadPixelsTest, RegionDecode) {
+  std::vector<std::string> paths = {"resources/apitest/imageReplacement.png",
+                                    "resources/apitest/imageReplacement.jpg",
+                                    "resources/apitest/mandrill_128.webp"};
+  for (auto& path : paths) {
+    auto codec = MakeImageCodec(path);
+    ASSERT_TRUE(codec != nullptr);
+    auto width = static_cast<float>(codec->width());
+    auto height = static_cast<float>(codec->height());
+    EXPECT_TRUE(CompareRegionWithFullDecode(codec, Rect::MakeWH(width, height))) << path;
+    EXPECT_TRUE(CompareRegionWithFullDecode(codec, Rect::MakeXYWH(0, 0, 17, 9))) << path;
+    EXPECT_TRUE(CompareRegionWithFullDecode(codec, Rect::MakeXYWH(13, 21, 37, 45))) << path;
+    EXPECT_TRUE(CompareRegionWithFullDecode(codec, Rect::MakeLTRB(width - 31, height - 7, width,
+                                                                  height)))
+        << path;
+    auto info = ImageInfo::Make(8, 8, ColorType::RGBA_8888, AlphaType::Premultiplied);
+    Buffer pixels(info.byteSize());
+    EXPECT_FALSE(codec->readPixels(Rect::MakeXYWH(-1, 0, 8, 8), info, pixels.data()));
+    auto outside = Rect::MakeXYWH(width - 4, 0.f, 8.f, 8.f);
+    EXPECT_FALSE(codec->readPixels(outside, info, pixels.data()));
+  }
+
+  auto codec = MakeImageCodec("resources/apitest/rotation.jpg");
+  ASSERT_TRUE(codec != nullptr);
+  auto region = Rect::MakeXYWH(static_cast<float>(codec->width() / 4),
+                               static_cast<float>(codec->height() / 4),
+                               static_cast<float>(codec->width() / 4),
+                               static_cast<float>(codec->height() / 4));
+  EXPECT_TRUE(CompareRegionWithFullDecode(codec, region));
+}
+
+class RegionCountingCodec : public ImageCodec {
+ public:
+  RegionCountingCodec(int width, int height) : ImageCodec(width, height) {
+  }
+
+  bool isAlphaOnly() const override {
+    return false;
+  }
+
+  mutable int regionReadCount = 0;
+
+ protected:
+  bool onReadPixels(ColorType colorType, AlphaType, size_t dstRowBytes, std::shared_ptr<ColorSpace>,
+                    void* dstPixels) const override {
+    FillRows(colorType, width(), height(), dstRowBytes, dstPixels);
+    return true;
+  }
+
+  bool onReadRegion(const Rect& srcRect, ColorType colorType, AlphaType, size_t dstRowBytes,
+                    std::shared_ptr<ColorSpace>, void* dstPixels) const override {
+    regionReadCount++;
+    FillRows(colorType, static_cast<int>(srcRect.width()), static_cast<int>(srcRect.height()),
+             dstRowBytes, dstPixels);
+    return true;
+  }
+
+ private:
+  static void FillRows(ColorType colorType, int width, int height, size_t rowBytes, void* pixels) {
+    auto bytes = static_cast<uint8_t*>(pixels);
+    auto lineBytes = static_cast<size_t>(width) * ImageInfo::GetBytesPerPixel(colorType);
+    for (int y = 0; y < height; y++) {
+      memset(bytes + static_cast<size_t>(y) * rowBytes, 0xFF, lineBytes);
+    }
+  }
+};
+
+TGFX_TEST(ReadPixelsTest, RegionDecodeCache) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto codec = std::make_shared<RegionCountingCodec>(4096, 4096);
+  auto image = Image::MakeFrom(codec);
+  ASSERT_TRUE(image != nullptr);
+  auto surface = Surface::Make(context, 200, 200);
+  ASSERT_TRUE(surface != nullptr);
+  auto canvas = surface->getCanvas();
+  canvas->drawImage(image, -1000, -1000);
+  context->flushAndSubmit();
+  EXPECT_EQ(codec->regionReadCount, 1);
+  // Redrawing the same area and scrolling by a few pixels reuse the cached region texture.
+  canvas->clear();
+  canvas->drawImage(image, -1000, -1000);
+  context->flushAndSubmit();
+  EXPECT_EQ(codec->regionReadCount, 1);
+  canvas->clear();
+  canvas->drawImage(image, -1010, -1005);
+  context->flushAndSubmit();
+  EXPECT_EQ(codec->regionReadCount, 1);
+  // A distant area decodes a new region.
+  canvas->clear();
+  canvas->drawImage(image, -3000, -3000);
+  context->flushAndSubmit();
+  EXPECT_EQ(codec->regionReadCount, 2);
+}
 }  // namespace tgfx
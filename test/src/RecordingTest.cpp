@@ -19,6 +19,7 @@
 #include "tgfx/core/Canvas.h"
 #include "tgfx/core/Paint.h"
 #include "tgfx/core/Surface.h"
+#include "tgfx/core/Trace.h"
 #include "tgfx/gpu/Context.h"
 #include "utils/TestUtils.h"
 
@@ -218,4 +219,154 @@ TGFX_TEST(RecordingTest, RecordingWithSemaphore) {
   EXPECT_TRUE(Baseline::Compare(surface, "RecordingTest/RecordingWithSemaphore"));
 }
 
+static void DrawFrameStatsScene(Surface* surface, std::shared_ptr<Image> image) {
+  auto canvas = surface->getCanvas();
+  canvas->clear();
+  Paint paint;
+  paint.setColor(Color::Red());
+  // Rects sharing the same paint are batched into a single DrawOp.
+  for (int i = 0; i < 10; i++) {
+    canvas->drawRect(Rect::MakeXYWH(static_cast<float>(i * 10), 0.0f, 8.0f, 8.0f), paint);
+  }
+  canvas->drawImage(std::move(image), 0, 20);
+}
+
+TGFX_TEST(RecordingTest, FrameStats) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 100, 100);
+  ASSERT_TRUE(surface != nullptr);
+  auto info = ImageInfo::Make(32, 32, ColorType::RGBA_8888);
+  std::vector<uint8_t> pixels(info.byteSize(), 128);
+  auto image = Image::MakeFrom(info, Data::MakeWithCopy(pixels.data(), pixels.size()));
+  ASSERT_TRUE(image != nullptr);
+  // Ends the frame left open by previous tests sharing the same context.
+  context->flushAndSubmit(true);
+
+  DrawFrameStatsScene(surface.get(), image);
+  // Flushing alone does not end the frame.
+  auto recording = context->flush();
+  ASSERT_TRUE(recording != nullptr);
+  EXPECT_EQ(context->frameStats().drawOpCount, 0u);
+  context->submit(std::move(recording), true);
+  auto stats = context->frameStats();
+  EXPECT_GE(stats.drawOpCount, 2u);
+  EXPECT_GE(stats.mergedDrawCount, 9u);
+  EXPECT_GE(stats.renderTaskCount, 1u);
+  EXPECT_GE(stats.uploadedBytes, info.byteSize());
+  EXPECT_GT(stats.resourceCacheMisses, 0u);
+  EXPECT_GE(stats.flushTime, 0);
+  EXPECT_GE(stats.submitTime, 0);
+
+  // The image texture is already uploaded, and the buffers of the first frame can be reused.
+  DrawFrameStatsScene(surface.get(), image);
+  context->flushAndSubmit(true);
+  stats = context->frameStats();
+  EXPECT_GE(stats.drawOpCount, 2u);
+  EXPECT_LT(stats.uploadedBytes, info.byteSize());
+  EXPECT_GT(stats.resourceCacheHits, 0u);
+}
+
+static void DrawListScene(Surface* surface, std::shared_ptr<Image> icon) {
+  auto canvas = surface->getCanvas();
+  canvas->clear(Color::White());
+  Paint rowPaint;
+  rowPaint.setColor(Color::FromRGBA(240, 240, 240, 255));
+  Paint badgePaint;
+  badgePaint.setColor(Color::Red());
+  // Every row interleaves a background, an icon and a badge, so the draws of the same kind are
+  // never adjacent in submission order even though the rows do not overlap each other.
+  for (int i = 0; i < 20; i++) {
+    auto top = static_cast<float>(i * 20);
+    canvas->drawRect(Rect::MakeXYWH(0.f, top + 1.f, 200.f, 18.f), rowPaint);
+    canvas->drawImage(icon, 2, top + 2);
+    canvas->drawRoundRect(Rect::MakeXYWH(170.f, top + 4.f, 24.f, 12.f), 6, 6, badgePaint);
+  }
+}
+
+TGFX_TEST(RecordingTest, ReorderBatches) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 200, 400);
+  ASSERT_TRUE(surface != nullptr);
+  auto info = ImageInfo::Make(16, 16, ColorType::RGBA_8888);
+  std::vector<uint8_t> iconPixels(info.byteSize(), 200);
+  auto icon = Image::MakeFrom(info, Data::MakeWithCopy(iconPixels.data(), iconPixels.size()));
+  ASSERT_TRUE(icon != nullptr);
+  auto defaultWindow = context->reorderWindow();
+  EXPECT_EQ(defaultWindow, 8u);
+  context->flushAndSubmit(true);
+
+  auto pixelInfo = ImageInfo::Make(200, 400, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  std::vector<uint8_t> orderedPixels(pixelInfo.byteSize());
+  std::vector<uint8_t> reorderedPixels(pixelInfo.byteSize());
+  context->setReorderWindow(0);
+  DrawListScene(surface.get(), icon);
+  context->flushAndSubmit(true);
+  auto ordered = context->frameStats();
+  ASSERT_TRUE(surface->readPixels(pixelInfo, orderedPixels.data()));
+  context->flushAndSubmit(true);
+
+  context->setReorderWindow(defaultWindow);
+  DrawListScene(surface.get(), icon);
+  context->flushAndSubmit(true);
+  auto reordered = context->frameStats();
+  ASSERT_TRUE(surface->readPixels(pixelInfo, reorderedPixels.data()));
+  context->flushAndSubmit(true);
+
+  EXPECT_EQ(ordered.reorderedDrawCount, 0u);
+  EXPECT_GT(reordered.reorderedDrawCount, 0u);
+  EXPECT_LT(reordered.drawOpCount, ordered.drawOpCount);
+  EXPECT_LT(reordered.programSwitchCount, ordered.programSwitchCount);
+  // Reordering only moves draws past the ones they do not overlap, so the output is unchanged.
+  EXPECT_TRUE(orderedPixels == reorderedPixels);
+}
+
+TGFX_TEST(RecordingTest, TraceExport) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 100, 100);
+  ASSERT_TRUE(surface != nullptr);
+  if (!Trace::IsAvailable()) {
+    Trace::Start();
+    EXPECT_FALSE(Trace::IsRecording());
+    EXPECT_TRUE(Trace::ExportJSON() == nullptr);
+    return;
+  }
+  auto info = ImageInfo::Make(32, 32, ColorType::RGBA_8888);
+  std::vector<uint8_t> pixels(info.byteSize(), 128);
+  auto image = Image::MakeFrom(info, Data::MakeWithCopy(pixels.data(), pixels.size()));
+  Trace::Start();
+  EXPECT_TRUE(Trace::IsRecording());
+  DrawFrameStatsScene(surface.get(), image);
+  context->flushAndSubmit(true);
+  Trace::Stop();
+  EXPECT_FALSE(Trace::IsRecording());
+  // Events after Stop() are not recorded.
+  DrawFrameStatsScene(surface.get(), image);
+  context->flushAndSubmit(true);
+  auto data = Trace::ExportJSON();
+  ASSERT_TRUE(data != nullptr);
+  std::string json(static_cast<const char*>(data->data()), data->size());
+  EXPECT_EQ(json.find("{\"traceEvents\":["), 0u);
+  EXPECT_NE(json.find("\"name\":\"Context::flush\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"DrawingManager::flush\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"OpsCompositor::flushPendingOps\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"RenderTask::execute\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"CommandQueue::submit\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"drawOpCount\",\"cat\":\"tgfx\""), std::string::npos);
+  size_t submitCount = 0;
+  for (auto pos = json.find("\"Context::submit\""); pos != std::string::npos;
+       pos = json.find("\"Context::submit\"", pos + 1)) {
+    submitCount++;
+  }
+  EXPECT_EQ(submitCount, 1u);
+  Trace::Start();
+  EXPECT_TRUE(Trace::ExportJSON() == nullptr);
+  Trace::Stop();
+}
+
 }  // namespace tgfx
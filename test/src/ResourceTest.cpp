@@ -17,6 +17,9 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <utility>
 #include <vector>
 #include "base/TGFXTest.h"
@@ -46,6 +49,152 @@ TGFX_TEST(ResourceTest, TaskRelease) {
                       })
 }
 
+TGFX_TEST(ResourceTest, TaskDependencies) {
+  std::atomic_int counter = 0;
+  std::vector<std::shared_ptr<Task>> stage = {};
+  for (int i = 0; i < 16; i++) {
+    stage.push_back(Task::Run([&counter] { ++counter; }));
+  }
+  std::atomic_bool ordered = true;
+  auto join = Task::Run(
+      [&] {
+        ordered = ordered && counter == 16;
+        counter += 100;
+      },
+      stage);
+  auto previous = join;
+  for (int i = 0; i < 32; i++) {
+    previous = Task::Run(
+        [&, i] {
+          ordered = ordered && counter == 116 + i;
+          ++counter;
+        },
+        {previous});
+  }
+  EXPECT_TRUE(previous->wait());
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(counter, 148);
+
+  // A canceled dependency still releases the tasks depending on it.
+  auto first = Task::Run([] { std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+  auto second = Task::Run([] {}, {first});
+  second->cancel();
+  auto third = Task::Run([] {}, {second, nullptr});
+  EXPECT_TRUE(third->wait());
+  EXPECT_EQ(second->status(), TaskStatus::Canceled);
+  EXPECT_EQ(third->status(), TaskStatus::Finished);
+}
+
+TGFX_TEST(ResourceTest, TaskWaitOnTaskThread) {
+  auto maxThreads = Task::GetMaxThreads();
+  // With a single thread, the outer tasks can only finish if waiting keeps running the queue.
+  Task::SetMaxThreads(1);
+  EXPECT_EQ(Task::GetMaxThreads(), 1);
+  std::atomic_int counter = 0;
+  std::vector<std::shared_ptr<Task>> outerTasks = {};
+  for (int i = 0; i < 8; i++) {
+    outerTasks.push_back(Task::Run([&counter] {
+      std::vector<std::shared_ptr<Task>> innerTasks = {};
+      for (int j = 0; j < 16; j++) {
+        innerTasks.push_back(Task::Run([&counter] { ++counter; }));
+      }
+      auto last = Task::Run([&counter] { ++counter; }, innerTasks);
+      last->wait();
+    }));
+  }
+  for (auto& task : outerTasks) {
+    task->wait();
+  }
+  EXPECT_EQ(counter, 8 * 17);
+  Task::SetMaxThreads(maxThreads);
+  EXPECT_EQ(Task::GetMaxThreads(), maxThreads);
+}
+
+static void SpinFor(int iterations) {
+  volatile int value = 0;
+  for (int i = 0; i < iterations; i++) {
+    value = value + i;
+  }
+}
+
+// Fans out batches of small tasks and returns how many of them ran. Submitting from the calling
+// thread goes through the global queues only, while submitting from a task thread uses its local
+// deque and lets the idle threads steal.
+static int RunFanOutStress(int batches, int tasksPerBatch, bool fromTaskThread) {
+  std::atomic_int finishedCount = 0;
+  auto spawn = [&] {
+    std::vector<std::shared_ptr<Task>> tasks = {};
+    tasks.reserve(static_cast<size_t>(tasksPerBatch));
+    for (int i = 0; i < tasksPerBatch; i++) {
+      tasks.push_back(Task::Run([&finishedCount] {
+        SpinFor(2000);
+        ++finishedCount;
+      }));
+    }
+    for (auto& task : tasks) {
+      task->wait();
+    }
+  };
+  std::vector<std::shared_ptr<Task>> roots = {};
+  for (int batch = 0; batch < batches; batch++) {
+    if (fromTaskThread) {
+      roots.push_back(Task::Run(spawn));
+    } else {
+      spawn();
+    }
+  }
+  for (auto& task : roots) {
+    task->wait();
+  }
+  return finishedCount;
+}
+
+// Runs decode -> downsample -> upload style pipelines and returns how many stages ran after the
+// previous stage of their pipeline. The blocking variant waits for the previous stage inside each
+// task, while the other one expresses the stages as dependencies.
+static int RunPipelineStress(int pipelines, int stages, bool useDependencies) {
+  std::vector<std::atomic_int> finishedStages(static_cast<size_t>(pipelines));
+  std::atomic_int orderedCount = 0;
+  std::vector<std::shared_ptr<Task>> lastStages = {};
+  for (int i = 0; i < pipelines; i++) {
+    auto pipelineStages = &finishedStages[static_cast<size_t>(i)];
+    std::shared_ptr<Task> previous = nullptr;
+    for (int stage = 0; stage < stages; stage++) {
+      auto block = [previous, useDependencies, stage, pipelineStages, &orderedCount] {
+        if (!useDependencies && previous != nullptr) {
+          previous->wait();
+        }
+        SpinFor(2000);
+        if (*pipelineStages == stage) {
+          ++orderedCount;
+        }
+        ++*pipelineStages;
+      };
+      if (useDependencies && previous != nullptr) {
+        previous = Task::Run(block, {previous});
+      } else {
+        previous = Task::Run(block);
+      }
+    }
+    lastStages.push_back(previous);
+  }
+  for (auto& task : lastStages) {
+    task->wait();
+  }
+  return orderedCount;
+}
+
+TGFX_TEST(ResourceTest, TaskSchedulerStress) {
+  const int batches = 64;
+  const int tasksPerBatch = 256;
+  const int pipelines = 2000;
+  const int stages = 3;
+  EXPECT_EQ(RunFanOutStress(batches, tasksPerBatch, false), batches * tasksPerBatch);
+  EXPECT_EQ(RunFanOutStress(batches, tasksPerBatch, true), batches * tasksPerBatch);
+  EXPECT_EQ(RunPipelineStress(pipelines, stages, false), pipelines * stages);
+  EXPECT_EQ(RunPipelineStress(pipelines, stages, true), pipelines * stages);
+}
+
 // ==================== Resource Cache Tests ====================
 
 class TestResource : public Resource {
@@ -29,6 +29,7 @@
 #include "tgfx/core/Shape.h"
 #include "tgfx/core/Stroke.h"
 #include "tgfx/core/Surface.h"
+#include "tgfx/core/Task.h"
 #include "tgfx/core/TextBlob.h"
 #include "tgfx/core/TextBlobBuilder.h"
 #include "tgfx/core/UTF.h"
@@ -1958,4 +1959,55 @@ TGFX_TEST(TextRenderTest, VerticalTextWithEmoji) {
   EXPECT_TRUE(Baseline::Compare(surface, "TextRenderTest/VerticalTextWithEmoji"));
 }
 
+TGFX_TEST(TextRenderTest, ColdGlyphRasterization) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  constexpr int LineCount = 40;
+  constexpr int GlyphsPerLine = 50;
+  std::vector<std::string> lines = {};
+  int32_t unichar = 0x4E00;
+  for (int i = 0; i < LineCount; i++) {
+    std::string line = {};
+    for (int j = 0; j < GlyphsPerLine; j++) {
+      line += UTF::ToUTF8(unichar++);
+    }
+    lines.push_back(std::move(line));
+  }
+  // Renders a dense page of distinct glyphs with a freshly loaded typeface, so that every glyph
+  // misses the strike cache and has to be rasterized before the first frame can be submitted.
+  auto renderColdPage = [&](std::vector<uint8_t>* pixels) {
+    auto typeface =
+        Typeface::MakeFromPath(ProjectPath::Absolute("resources/font/NotoSerifSC-Regular.otf"));
+    EXPECT_TRUE(typeface != nullptr);
+    Font font(typeface, 16.f);
+    auto surface = Surface::Make(context, 820, 700);
+    EXPECT_TRUE(surface != nullptr);
+    auto canvas = surface->getCanvas();
+    canvas->clear(Color::White());
+    Paint paint = {};
+    paint.setColor(Color::Black());
+    for (int i = 0; i < LineCount; i++) {
+      auto textBlob = TextBlob::MakeFrom(lines[static_cast<size_t>(i)], font);
+      canvas->drawTextBlob(textBlob, 10.f, 20.f + 17.f * static_cast<float>(i), paint);
+    }
+    context->flushAndSubmit(true);
+    auto info = ImageInfo::Make(surface->width(), surface->height(), ColorType::RGBA_8888);
+    pixels->resize(info.byteSize());
+    EXPECT_TRUE(surface->readPixels(info, pixels->data()));
+  };
+  // Limiting the task threads only serializes the glyph batches. Both runs still rasterize on the
+  // raster faces of the typeface, so this compares one worker against all of them, not the raster
+  // faces against the shared face.
+  auto maxThreads = Task::GetMaxThreads();
+  Task::SetMaxThreads(1);
+  std::vector<uint8_t> serialPixels = {};
+  renderColdPage(&serialPixels);
+  Task::SetMaxThreads(maxThreads);
+  std::vector<uint8_t> parallelPixels = {};
+  renderColdPage(&parallelPixels);
+  // The output must not depend on how the glyph batches are spread across the task threads.
+  EXPECT_TRUE(serialPixels == parallelPixels);
+}
+
 }  // namespace tgfx
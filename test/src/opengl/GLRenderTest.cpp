@@ -16,6 +16,7 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <unordered_map>
 #include <vector>
 #include "core/utils/PixelFormatUtil.h"
 #include "gpu/opengl/GLCaps.h"
@@ -27,6 +28,8 @@
 #include "tgfx/core/Paint.h"
 #include "tgfx/core/Shader.h"
 #include "tgfx/core/Surface.h"
+#include "tgfx/gpu/ProgramCache.h"
+#include "tgfx/gpu/opengl/GLDevice.h"
 #include "utils/TestUtils.h"
 
 namespace tgfx {
@@ -212,4 +215,79 @@ TGFX_TEST(GLRenderTest, rectangleTextureAsBlendDst) {
   gl->deleteTextures(1, &(glInfo.id));
 }
 
+class MemoryProgramCache : public ProgramCache {
+ public:
+  std::shared_ptr<Data> load(const std::string& key) override {
+    auto result = entries.find(key);
+    return result != entries.end() ? result->second : nullptr;
+  }
+
+  void store(const std::string& key, std::shared_ptr<Data> data) override {
+    entries[key] = std::move(data);
+  }
+
+  std::unordered_map<std::string, std::shared_ptr<Data>> entries = {};
+};
+
+static ProgramCacheStats DrawWithProgramCache(std::shared_ptr<ProgramCache> cache) {
+  auto device = GLDevice::Make();
+  if (device == nullptr) {
+    return {};
+  }
+  device->setProgramCache(std::move(cache));
+  auto context = device->lockContext();
+  if (context == nullptr) {
+    return {};
+  }
+  auto surface = Surface::Make(context, 100, 100);
+  auto canvas = surface->getCanvas();
+  Paint paint = {};
+  paint.setColor(Color::Red());
+  canvas->drawRect(Rect::MakeXYWH(10, 10, 50, 50), paint);
+  paint.setColor(Color::Blue());
+  paint.setBlendMode(BlendMode::Multiply);
+  canvas->drawCircle(50, 50, 30, paint);
+  context->flushAndSubmit(true);
+  auto stats = context->programCacheStats();
+  device->unlock();
+  return stats;
+}
+
+TGFX_TEST(GLRenderTest, ProgramBinaryCache) {
+  auto cache = std::make_shared<MemoryProgramCache>();
+  auto firstStats = DrawWithProgramCache(cache);
+  EXPECT_EQ(firstStats.hitCount, 0u);
+  EXPECT_GT(firstStats.missCount, 0u);
+  // Entries hold the binaries plus the index of stored keys, which exists only if the driver
+  // supports program binaries.
+  auto binaryCount = cache->entries.empty() ? 0 : cache->entries.size() - 1;
+  auto secondStats = DrawWithProgramCache(cache);
+  EXPECT_EQ(secondStats.hitCount, binaryCount);
+  EXPECT_EQ(secondStats.hitCount + secondStats.missCount, firstStats.missCount);
+}
+
+TGFX_TEST(GLRenderTest, AsyncShaderCompilation) {
+  auto device = GLDevice::Make();
+  ASSERT_TRUE(device != nullptr);
+  auto context = device->lockContext();
+  ASSERT_TRUE(context != nullptr);
+  EXPECT_FALSE(context->asyncShaderCompilation());
+  context->setAsyncShaderCompilation(true);
+  auto surface = Surface::Make(context, 100, 100);
+  auto canvas = surface->getCanvas();
+  Paint paint = {};
+  paint.setColor(Color::Blue());
+  paint.setBlendMode(BlendMode::Screen);
+  canvas->drawRect(Rect::MakeXYWH(10, 10, 50, 50), paint);
+  context->flushAndSubmit(true);
+  EXPECT_GT(context->deferredDrawCount(), 0u);
+  // The queued programs are compiled at the start of the following submits within a per-frame
+  // budget, so the same draw goes through after the frame is drawn again.
+  for (int i = 0; i < 10 && context->deferredDrawCount() > 0; i++) {
+    canvas->drawRect(Rect::MakeXYWH(10, 10, 50, 50), paint);
+    context->flushAndSubmit(true);
+  }
+  EXPECT_EQ(context->deferredDrawCount(), 0u);
+  device->unlock();
+}
 }  // namespace tgfx